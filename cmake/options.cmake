@@ -100,6 +100,17 @@ option(WITH_TESTS
     "Choose if PDAL unit tests should be built" TRUE)
 add_feature_info("Unit tests" WITH_TESTS "PDAL unit tests")
 
+option(WITH_BENCHMARKS
+    "Choose if PDAL microbenchmarks should be built (requires Google Benchmark)"
+    FALSE)
+add_feature_info("Benchmarks" WITH_BENCHMARKS "PDAL microbenchmarks")
+
+option(WITH_PERF_TESTS
+    "Choose if PDAL end-to-end performance regression tests should be built"
+    FALSE)
+add_feature_info("Performance tests" WITH_PERF_TESTS
+    "PDAL pipeline performance regression tests")
+
 # Enable CTest and submissions to PDAL dashboard at CDash
 # http://my.cdash.org/index.php?project=PDAL
 option(ENABLE_CTEST
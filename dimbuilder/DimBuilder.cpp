@@ -31,7 +31,10 @@
 * OF SUCH DAMAGE.
 ****************************************************************************/
 
+#include <cstdint>
 #include <iostream>
+#include <map>
+#include <set>
 
 #include "DimBuilder.hpp"
 
@@ -348,6 +351,7 @@ void DimBuilder::writeHeader(std::ostream& out)
     out << "\n";
     out << "#pragma once\n";
     out << "\n";
+    out << "#include <cstdint>\n";
     out << "#include <string>\n";
     out << "#include <vector>\n";
     out << "\n";
@@ -436,10 +440,18 @@ void DimBuilder::writeNameToId(std::ostream& out)
     out << "/// \\return  Dimension ID associated with the name.  "
         "Id::Unknown is returned\n";
     out << "///    if the name doesn't map to a predefined dimension.\n";
-    out << "inline Id id(std::string s)\n";
-    out << "{\n";
-    out << "    s = Utils::toupper(s);\n";
-    out << "\n";
+    // Gather the uppercased name and alternate names of each dimension,
+    // then search for an FNV-1a seed for which no two names share a hash
+    // slot.  The generated lookup hashes its argument and verifies the
+    // match with a single comparison rather than comparing against every
+    // name in turn.
+    struct Entry
+    {
+        std::string m_upper;
+        std::string m_dim;
+    };
+    std::vector<Entry> entries;
+    std::set<std::string> seen;
     for (auto& d : m_dims)
     {
         std::vector<std::string> names;
@@ -447,10 +459,67 @@ void DimBuilder::writeNameToId(std::ostream& out)
         names.insert(names.end(), d.m_altNames.begin(), d.m_altNames.end());
         for (std::string& s : names)
         {
-            out << "    if (s == \"" << Utils::toupper(s) << "\")\n";
-            out << "        return Id::" << d.m_name << ";\n";
+            // Some alternate names differ from the primary name only in
+            // case.  Only the first occurrence of a name matters.
+            std::string upper = Utils::toupper(s);
+            if (seen.insert(upper).second)
+                entries.push_back({ upper, d.m_name });
         }
     }
+
+    const uint64_t prime = 0x100000001B3ULL;
+    const uint64_t mask = 0xFFFF;
+    auto hash = [prime](const std::string& s, uint64_t h)
+    {
+        for (char c : s)
+        {
+            h ^= (uint64_t)(unsigned char)c;
+            h *= prime;
+        }
+        return h;
+    };
+
+    uint64_t seed = 0xCBF29CE484222325ULL;
+    std::map<uint64_t, const Entry *> slots;
+    for (;; ++seed)
+    {
+        slots.clear();
+        bool collision = false;
+        for (const Entry& e : entries)
+            if (!slots.insert({ hash(e.m_upper, seed) & mask, &e }).second)
+            {
+                collision = true;
+                break;
+            }
+        if (!collision)
+            break;
+    }
+
+    out << "inline Id id(std::string s)\n";
+    out << "{\n";
+    out << "    s = Utils::toupper(s);\n";
+    out << "\n";
+    out << "    // Perfect hash of the predefined dimension names.  The "
+        "seed was\n";
+    out << "    // chosen when this file was generated so that no two "
+        "names share\n";
+    out << "    // a slot.\n";
+    out << "    uint64_t h = " << seed << "ULL;\n";
+    out << "    for (char c : s)\n";
+    out << "    {\n";
+    out << "        h ^= (uint64_t)(unsigned char)c;\n";
+    out << "        h *= " << prime << "ULL;\n";
+    out << "    }\n";
+    out << "    switch (h & " << mask << ")\n";
+    out << "    {\n";
+    for (auto& s : slots)
+    {
+        const Entry *e = s.second;
+        out << "    case " << s.first << ":\n";
+        out << "        return (s == \"" << e->m_upper << "\") ? Id::" <<
+            e->m_dim << " : Id::Unknown;\n";
+    }
+    out << "    }\n";
     out << "    return Id::Unknown;\n";
     out << "}\n";
 }
@@ -36,11 +36,14 @@
 
 #include <pdal/KDIndex.hpp>
 #include <pdal/util/ProgramArgs.hpp>
+#include <pdal/util/ThreadPool.hpp>
 #include <pdal/private/MathUtils.hpp>
 
 #include <Eigen/Dense>
 
+#include <atomic>
 #include <string>
+#include <thread>
 
 namespace pdal
 {
@@ -81,26 +84,54 @@ void ApproximateCoplanarFilter::filter(PointView& view)
 {
     const KD3Index& kdi = view.build3dIndex();
 
-    for (PointRef p : view)
+    // Each point's label depends only on its own neighborhood, so points
+    // are processed in parallel - index queries are read-only and every
+    // worker writes to its own range of points.
+    const size_t threads = (std::min)((point_count_t)(std::max)(
+        std::thread::hardware_concurrency(), 1U), view.size());
+    std::atomic<bool> solverFailed(false);
+    ThreadPool pool(threads ? threads : 1);
+    for (size_t t = 0; t < threads; ++t)
     {
-        // find the k-nearest neighbors
-        PointIdList ids = kdi.neighbors(p, m_knn);
-
-        // compute covariance of the neighborhood
-        Matrix3d B = math::computeCovariance(view, ids);
-
-        // perform the eigen decomposition
-        Eigen::SelfAdjointEigenSolver<Matrix3d> solver(B);
-        if (solver.info() != Eigen::Success)
-            throwError("Cannot perform eigen decomposition.");
-        Vector3d ev = solver.eigenvalues();
-
-        // test eigenvalues to label points that are approximately coplanar
-        if ((ev[1] > m_thresh1 * ev[0]) && (m_thresh2 * ev[1] > ev[2]))
-            p.setField(Id::Coplanar, 1u);
-        else
-            p.setField(Id::Coplanar, 0u);
+        const PointId start = t * view.size() / threads;
+        const PointId end =
+            (t + 1 == threads) ? view.size() : (t + 1) * view.size() / threads;
+        pool.add([this, &view, &kdi, &solverFailed, start, end]()
+        {
+            for (PointId i = start; i < end; ++i)
+            {
+                PointRef p = view.point(i);
+                if (!processPoint(view, kdi, p))
+                    solverFailed = true;
+            }
+        });
     }
+    pool.join();
+    if (solverFailed)
+        throwError("Cannot perform eigen decomposition.");
+}
+
+bool ApproximateCoplanarFilter::processPoint(PointView& view,
+    const KD3Index& kdi, PointRef& p)
+{
+    // find the k-nearest neighbors
+    PointIdList ids = kdi.neighbors(p, m_knn);
+
+    // compute covariance of the neighborhood
+    Matrix3d B = math::computeCovariance(view, ids);
+
+    // perform the eigen decomposition
+    Eigen::SelfAdjointEigenSolver<Matrix3d> solver(B);
+    if (solver.info() != Eigen::Success)
+        return false;
+    Vector3d ev = solver.eigenvalues();
+
+    // test eigenvalues to label points that are approximately coplanar
+    if ((ev[1] > m_thresh1 * ev[0]) && (m_thresh2 * ev[1] > ev[2]))
+        p.setField(Id::Coplanar, 1u);
+    else
+        p.setField(Id::Coplanar, 0u);
+    return true;
 }
 
 } // namespace pdal
@@ -63,6 +63,7 @@ private:
     virtual void addDimensions(PointLayoutPtr layout);
     virtual void addArgs(ProgramArgs& args);
     virtual void filter(PointView& view);
+    bool processPoint(PointView& view, const KD3Index& kdi, PointRef& p);
 };
 
 } // namespace pdal
@@ -33,8 +33,16 @@
 
 #include "ChipperFilter.hpp"
 
+#include <array>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <limits>
+#include <thread>
+
+#include <pdal/util/ThreadPool.hpp>
+
+#include "private/ParallelSort.hpp"
 
 /**
 The objective is to split the region into non-overlapping blocks, each
@@ -102,7 +110,15 @@ PointViewSet ChipperFilter::run(PointViewPtr view)
 
     load(*view.get(), m_xvec, m_yvec, m_spare);
     partition(m_xvec.size());
-    decideSplit(m_xvec, m_yvec, m_spare, 0, m_partitions.size() - 1);
+
+    // The recursion is a fork-join: sibling subtrees touch disjoint
+    // partition ranges of the shared arrays, so give the tree a budget
+    // of fork levels sized to the hardware.
+    size_t threads = threadCount(view->size());
+    int forks = 0;
+    while (((size_t)1 << (forks + 1)) <= threads)
+        forks++;
+    decideSplit(m_xvec, m_yvec, m_spare, 0, m_partitions.size() - 1, forks);
     return m_outViews;
 }
 
@@ -110,35 +126,68 @@ PointViewSet ChipperFilter::run(PointViewPtr view)
 void ChipperFilter::load(PointView& view, ChipRefList& xvec, ChipRefList& yvec,
     ChipRefList& spare)
 {
-    for (PointId i = 0; i < view.size(); ++i)
-    {
-        ChipPtRef xref;
-
-        xref.m_pos = view.getFieldAs<double>(Dimension::Id::X, i);
-        xref.m_ptindex = i;
-        xvec.push_back(xref);
-
-        ChipPtRef yref;
-
-        yref.m_pos = view.getFieldAs<double>(Dimension::Id::Y, i);
-        yref.m_ptindex = i;
-        yvec.push_back(yref);
-    }
-
-    // Sort xvec and assign other index in yvec to sorted indices in xvec.
-    std::stable_sort(xvec.begin(), xvec.end());
-    for (size_t i = 0; i < xvec.size(); ++i)
-    {
-        point_count_t idx = xvec[i].m_ptindex;
-        yvec[idx].m_oindex = i;
-    }
-
-    // Sort yvec.
-    std::stable_sort(yvec.begin(), yvec.end());
+    point_count_t numPts = view.size();
+    size_t threads = threadCount(numPts);
+    ThreadPool pool(threads);
+    auto chunkStart = [numPts, threads](size_t t)
+        { return (PointId)(t * numPts / threads); };
+
+    // Sort each direction by radix on order-preserving bit keys instead
+    // of comparing doubles - O(n) per direction and parallel.
+    std::vector<std::pair<uint64_t, PointId>> xkeys(numPts);
+    std::vector<std::pair<uint64_t, PointId>> ykeys(numPts);
+    for (size_t t = 0; t < threads; ++t)
+        pool.add([&, t]()
+        {
+            for (PointId i = chunkStart(t); i < chunkStart(t + 1); ++i)
+            {
+                xkeys[i] = { sortableKey(
+                    view.getFieldAs<double>(Dimension::Id::X, i)), i };
+                ykeys[i] = { sortableKey(
+                    view.getFieldAs<double>(Dimension::Id::Y, i)), i };
+            }
+        });
+    pool.await();
+
+    radixSort(xkeys, pool, threads);
+    radixSort(ykeys, pool, threads);
+
+    // Invert the two sort permutations so each ref can point at the
+    // other coordinate's sorted position.
+    std::vector<size_t> xpos(numPts);
+    std::vector<size_t> ypos(numPts);
+    for (size_t t = 0; t < threads; ++t)
+        pool.add([&, t]()
+        {
+            for (PointId i = chunkStart(t); i < chunkStart(t + 1); ++i)
+            {
+                xpos[xkeys[i].second] = i;
+                ypos[ykeys[i].second] = i;
+            }
+        });
+    pool.await();
 
-    // Iterate through the yvector, setting the xvector appropriately.
-    for (size_t i = 0; i < yvec.size(); ++i)
-        xvec[yvec[i].m_oindex].m_oindex = i;
+    xvec.resize(numPts);
+    yvec.resize(numPts);
+    for (size_t t = 0; t < threads; ++t)
+        pool.add([&, t]()
+        {
+            for (PointId i = chunkStart(t); i < chunkStart(t + 1); ++i)
+            {
+                PointId xpt = xkeys[i].second;
+                xvec[i].m_pos =
+                    view.getFieldAs<double>(Dimension::Id::X, xpt);
+                xvec[i].m_ptindex = xpt;
+                xvec[i].m_oindex = ypos[xpt];
+
+                PointId ypt = ykeys[i].second;
+                yvec[i].m_pos =
+                    view.getFieldAs<double>(Dimension::Id::Y, ypt);
+                yvec[i].m_ptindex = ypt;
+                yvec[i].m_oindex = xpos[ypt];
+            }
+        });
+    pool.await();
 }
 
 
@@ -182,7 +231,7 @@ void ChipperFilter::partition(point_count_t size)
 
 
 void ChipperFilter::decideSplit(ChipRefList& v1, ChipRefList& v2,
-    ChipRefList& spare, PointId pleft, PointId pright)
+    ChipRefList& spare, PointId pleft, PointId pright, int forks)
 {
     double v1range;
     double v2range;
@@ -194,13 +243,13 @@ void ChipperFilter::decideSplit(ChipRefList& v1, ChipRefList& v2,
     v1range = v1[right].m_pos - v1[left].m_pos;
     v2range = v2[right].m_pos - v2[left].m_pos;
     if (v1range > v2range)
-        split(v1, v2, spare, pleft, pright);
+        split(v1, v2, spare, pleft, pright, forks);
     else
-        split(v2, v1, spare, pleft, pright);
+        split(v2, v1, spare, pleft, pright, forks);
 }
 
 void ChipperFilter::split(ChipRefList& wide, ChipRefList& narrow,
-    ChipRefList& spare, PointId pleft, PointId pright)
+    ChipRefList& spare, PointId pleft, PointId pright, int forks)
 {
     PointId lstart;
     PointId rstart;
@@ -252,17 +301,34 @@ void ChipperFilter::split(ChipRefList& wide, ChipRefList& narrow,
             }
         }
 
-        decideSplit(wide, spare, narrow, pleft, pcenter);
-        decideSplit(wide, spare, narrow, pcenter, pright);
+        // Sibling subtrees read and write disjoint [left, right) ranges
+        // of the shared arrays, so they can run concurrently.  Each fork
+        // level doubles the worker count until the budget is spent.
+        if (forks > 0)
+        {
+            std::thread task([this, &wide, &spare, &narrow, pleft, pcenter,
+                forks]()
+                { decideSplit(wide, spare, narrow, pleft, pcenter,
+                    forks - 1); });
+            decideSplit(wide, spare, narrow, pcenter, pright, forks - 1);
+            task.join();
+        }
+        else
+        {
+            decideSplit(wide, spare, narrow, pleft, pcenter, 0);
+            decideSplit(wide, spare, narrow, pcenter, pright, 0);
+        }
     }
 }
 
 void ChipperFilter::emit(ChipRefList& wide, PointId widemin, PointId widemax)
 {
     PointViewPtr view = m_inView->makeNew();
+    view->reserve(widemax - widemin + 1);
     for (size_t idx = widemin; idx <= widemax; ++idx)
         view->appendPoint(*m_inView.get(), wide[idx].m_ptindex);
 
+    std::lock_guard<std::mutex> lock(m_outViewsMutex);
     m_outViews.insert(view);
 }
 
@@ -43,6 +43,7 @@
 
 #include <pdal/Filter.hpp>
 #include <pdal/PointView.hpp>
+#include <mutex>
 #include <vector>
 
 namespace pdal
@@ -123,13 +124,14 @@ private:
         ChipRefList& yvec, ChipRefList& spare);
     void partition(point_count_t size);
     void decideSplit(ChipRefList& v1, ChipRefList& v2,
-        ChipRefList& spare, PointId left, PointId right);
+        ChipRefList& spare, PointId left, PointId right, int forks);
     void split(ChipRefList& wide, ChipRefList& narrow,
-        ChipRefList& spare, PointId left, PointId right);
+        ChipRefList& spare, PointId left, PointId right, int forks);
     void emit(ChipRefList& wide, PointId widemin, PointId widemax);
 
     PointId m_threshold;
     PointViewPtr m_inView;
+    std::mutex m_outViewsMutex;
     PointViewSet m_outViews;
     PointIdList m_partitions;
     ChipRefList m_xvec;
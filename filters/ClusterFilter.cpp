@@ -65,6 +65,8 @@ void ClusterFilter::addArgs(ProgramArgs& args)
         (std::numeric_limits<uint64_t>::max)());
     args.add("tolerance", "Radius", m_tolerance, 1.0);
     args.add("is3d", "Perform cluster extraction in 3D?", m_is3d, true);
+    args.add("threads", "Number of threads used to run this filter",
+        m_threads, 1);
 }
 
 void ClusterFilter::addDimensions(PointLayoutPtr layout)
@@ -75,7 +77,10 @@ void ClusterFilter::addDimensions(PointLayoutPtr layout)
 void ClusterFilter::filter(PointView& view)
 {
     std::deque<PointIdList> clusters;
-    if (m_is3d)
+    if (m_threads > 1)
+        clusters = Segmentation::extractClustersGrid(view, m_minPoints,
+            m_maxPoints, m_tolerance, m_is3d, m_threads);
+    else if (m_is3d)
         clusters = Segmentation::extractClusters<KD3Index>(view, m_minPoints,
             m_maxPoints, m_tolerance);
     else
@@ -58,6 +58,7 @@ private:
     uint64_t m_maxPoints;
     double m_tolerance;
     bool m_is3d;
+    int m_threads;
 
     virtual void addArgs(ProgramArgs& args);
     virtual void addDimensions(PointLayoutPtr layout);
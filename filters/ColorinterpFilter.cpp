@@ -36,6 +36,7 @@
 
 #include <pdal/PointView.hpp>
 #include <pdal/util/ProgramArgs.hpp>
+#include <pdal/util/ThreadPool.hpp>
 #include <pdal/util/Utils.hpp>
 #include <pdal/private/gdal/GDALUtils.hpp>
 #include <pdal/private/gdal/Raster.hpp>
@@ -128,6 +129,8 @@ void ColorinterpFilter::addArgs(ProgramArgs& args)
         m_madMultiplier, 1.4862);
     args.add("k", "Number of deviations to compute minimum/maximum ",
         m_stdDevThreshold, 0.0);
+    args.add("threads", "Number of threads used to run this filter",
+        m_threads, 1);
 }
 
 void ColorinterpFilter::addDimensions(PointLayoutPtr layout)
@@ -169,6 +172,34 @@ void ColorinterpFilter::ready(PointTableRef table)
     m_raster->readBand(m_redBand, 1);
     m_raster->readBand(m_greenBand, 2);
     m_raster->readBand(m_blueBand, 3);
+
+    // In stream mode the bounds are fixed up front, so the lookup table
+    // can be built now.  In standard mode filter() builds it once the
+    // bounds are known.
+    if (!std::isnan(m_min) && !std::isnan(m_max))
+        buildLut();
+}
+
+
+/**
+  Resample the ramp into a fixed-size RGB lookup table so each point costs
+  one quantization and one table read instead of three band samples.
+*/
+void ColorinterpFilter::buildLut()
+{
+    const size_t lutSize = 65536;
+    size_t imgWidth = m_redBand.size();
+
+    m_lut.resize(lutSize);
+    for (size_t i = 0; i < lutSize; ++i)
+    {
+        size_t position = (std::min)((i * imgWidth) / lutSize, imgWidth - 1);
+        if (m_invertRamp)
+            position = (imgWidth - 1) - position;
+        m_lut[i] = { m_redBand[position], m_greenBand[position],
+            m_blueBand[position] };
+    }
+    m_lutScale = (m_max > m_min) ? (double)lutSize / (m_max - m_min) : 0.0;
 }
 
 
@@ -256,12 +287,40 @@ void ColorinterpFilter::filter(PointView& view)
             m_max = summary.maximum();
     }
 
-    PointRef point(view, 0);
-    for (PointId idx = 0; idx < view.size(); ++idx)
+    buildLut();
+
+    point_count_t numPts = view.size();
+    size_t threads = (size_t)(std::min)(
+        (point_count_t)(std::max)(m_threads, 1), numPts);
+    if (threads <= 1)
     {
-        point.setPointId(idx);
-        processOne(point);
+        PointRef point(view, 0);
+        for (PointId idx = 0; idx < numPts; ++idx)
+        {
+            point.setPointId(idx);
+            processOne(point);
+        }
+        return;
     }
+
+    // Each chunk colors a disjoint range of points, so the workers never
+    // write the same point.
+    auto chunkStart = [numPts, threads](size_t t)
+        { return (PointId)(t * numPts / threads); };
+    ThreadPool pool(threads);
+    for (size_t t = 0; t < threads; ++t)
+    {
+        pool.add([this, &view, &chunkStart, t]()
+        {
+            PointRef point(view, 0);
+            for (PointId idx = chunkStart(t); idx < chunkStart(t + 1); ++idx)
+            {
+                point.setPointId(idx);
+                processOne(point);
+            }
+        });
+    }
+    pool.await();
 }
 
 
@@ -292,20 +351,15 @@ bool ColorinterpFilter::processOne(PointRef& point)
         return true;
     }
 
-    double factor = (v - m_min) / (m_max - m_min);
-    size_t img_width = m_redBand.size();
-    size_t position = size_t(std::floor(factor * img_width));
-
-    // Handle the case that v == m_max (position == img_width) by clamping
-    // position to img_width - 1
-    position = (std::min)(position, img_width - 1);
-
-    if (m_invertRamp)
-        position = (img_width - 1) - position;
+    // Handle the case that v == m_max by clamping the index to the last
+    // table entry.
+    size_t idx = (std::min)((size_t)((v - m_min) * m_lutScale),
+        m_lut.size() - 1);
 
-    point.setField(Dimension::Id::Red, m_redBand[position]);
-    point.setField(Dimension::Id::Blue, m_blueBand[position]);
-    point.setField(Dimension::Id::Green, m_greenBand[position]);
+    const std::array<uint8_t, 3>& color = m_lut[idx];
+    point.setField(Dimension::Id::Red, color[0]);
+    point.setField(Dimension::Id::Green, color[1]);
+    point.setField(Dimension::Id::Blue, color[2]);
 
     return true;
 }
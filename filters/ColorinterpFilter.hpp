@@ -38,6 +38,7 @@
 #include <pdal/Streamable.hpp>
 #include <filters/StatsFilter.hpp>
 
+#include <array>
 #include <map>
 
 namespace pdal
@@ -64,6 +65,7 @@ public:
         , m_stdDevThreshold(0.0)
         , m_useMAD(false)
         , m_madMultiplier(1.4862)
+        , m_lutScale(0.0)
     {}
     ColorinterpFilter& operator=(const ColorinterpFilter&) = delete;
     ColorinterpFilter(const ColorinterpFilter&) = delete;
@@ -77,6 +79,7 @@ private:
     virtual void ready(PointTableRef table);
     virtual void addDimensions(PointLayoutPtr layout);
     virtual bool processOne(PointRef& point);
+    void buildLut();
 
     Dimension::Id m_interpDim;
     std::string m_interpDimString;
@@ -93,6 +96,10 @@ private:
     double m_stdDevThreshold;
     bool m_useMAD;
     double m_madMultiplier;
+    int m_threads;
+    // Ramp resampled to a fixed-size RGB lookup table over [m_min, m_max].
+    std::vector<std::array<uint8_t, 3>> m_lut;
+    double m_lutScale;
 };
 
 } // namespace pdal
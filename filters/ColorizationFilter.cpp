@@ -36,10 +36,13 @@
 
 #include <pdal/PointView.hpp>
 #include <pdal/util/ProgramArgs.hpp>
+#include <pdal/private/gdal/DatasetPool.hpp>
 #include <pdal/private/gdal/Raster.hpp>
 
 #include <array>
 
+#include "private/RasterProbe.hpp"
+
 namespace pdal
 {
 
@@ -136,14 +139,17 @@ void ColorizationFilter::addArgs(ProgramArgs& args)
 {
     args.add("raster", "Raster filename", m_rasterFilename);
     args.add("dimensions", "Dimensions to use for colorization", m_dimSpec);
+    args.add("threads", "Number of threads used to run this filter",
+        m_threads, 1);
 }
 
 
 void ColorizationFilter::initialize()
 {
-    m_raster.reset(new gdal::Raster(m_rasterFilename));
+    m_raster = gdal::DatasetPool::instance().raster(m_rasterFilename);
     auto bandTypes = m_raster->getPDALDimensionTypes();
-    m_raster->close();
+    // Back to the pool; the dataset stays open for ready().
+    m_raster.reset();
 
     if (m_dimSpec.empty())
         m_dimSpec = { "Red", "Green", "Blue" };
@@ -180,7 +186,8 @@ void ColorizationFilter::ready(PointTableRef table)
 {
     using namespace gdal;
 
-    m_raster.reset(new gdal::Raster(m_rasterFilename));
+    m_raster.reset();
+    m_raster = gdal::DatasetPool::instance().raster(m_rasterFilename);
 
     GDALError error = m_raster->open();
     if (error != GDALError::None)
@@ -206,7 +213,7 @@ bool ColorizationFilter::processOne(PointRef& point)
     double x = point.getFieldAs<double>(Dimension::Id::X);
     double y = point.getFieldAs<double>(Dimension::Id::Y);
 
-    if (m_raster->read(x, y, data) == gdal::GDALError::None)
+    if (m_raster->readCached(x, y, data) == gdal::GDALError::None)
     {
         int i(0);
         for (auto bi = m_bands.begin(); bi != m_bands.end(); ++bi)
@@ -225,6 +232,12 @@ bool ColorizationFilter::processOne(PointRef& point)
 
 void ColorizationFilter::filter(PointView& view)
 {
+    if (m_threads > 1)
+    {
+        colorizeParallel(view);
+        return;
+    }
+
     PointRef point = view.point(0);
     for (PointId idx = 0; idx < view.size(); ++idx)
     {
@@ -233,4 +246,28 @@ void ColorizationFilter::filter(PointView& view)
     }
 }
 
+
+void ColorizationFilter::colorizeParallel(PointView& view)
+{
+    // Points outside the raster are retained unmodified, just as in the
+    // serial path.
+    std::string error = RasterProbe::probe(view, *m_raster,
+        m_rasterFilename, m_threads,
+        [this](PointRef& point, const std::vector<double>& data, bool ok)
+        {
+            if (!ok)
+                return;
+
+            int i(0);
+            for (auto bi = m_bands.begin(); bi != m_bands.end(); ++bi)
+            {
+                BandInfo& b = *bi;
+                point.setField(b.m_dim, data[i] * b.m_scale);
+                ++i;
+            }
+        });
+    if (error.size())
+        throwError(error);
+}
+
 } // namespace pdal
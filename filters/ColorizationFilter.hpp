@@ -83,11 +83,14 @@ private:
     virtual bool processOne(PointRef& point);
     virtual void filter(PointView& view);
 
+    void colorizeParallel(PointView& view);
+
     StringList m_dimSpec;
     std::string m_rasterFilename;
+    int m_threads;
     std::vector<BandInfo> m_bands;
 
-    std::unique_ptr<gdal::Raster> m_raster;
+    std::shared_ptr<gdal::Raster> m_raster;
 };
 
 } // namespace pdal
@@ -41,11 +41,14 @@
 #include <pdal/util/ProgramArgs.hpp>
 #include <pdal/private/gdal/GDALUtils.hpp>
 
+#include "private/BoxIndex.hpp"
 #include "private/Point.hpp"
 #include "private/pnp/GridPnp.hpp"
 
+#include <cmath>
 #include <sstream>
 #include <cstdarg>
+#include <thread>
 
 namespace pdal
 {
@@ -67,8 +70,10 @@ struct CropArgs
     std::vector<filter::Point> m_centers;
     double m_distance;
     std::vector<Polygon> m_polys;
+    int m_threads;
 };
 
+
 CropFilter::ViewGeom::ViewGeom(const Polygon& poly) : m_poly(poly)
 {}
 
@@ -102,6 +107,8 @@ void CropFilter::addArgs(ProgramArgs& args)
     args.add("polygon", "Bounding polying for cropped points", m_args->m_polys).
         setErrorText("Invalid polygon specification.  "
             "Must be valid GeoJSON/WKT");
+    args.add("threads", "Number of threads used to run this filter",
+        m_args->m_threads, 1);
 }
 
 
@@ -127,6 +134,40 @@ void CropFilter::initialize()
 }
 
 
+bool CropFilter::spatialPredicate(Bounds& bounds) const
+{
+    // Only advertise a predicate when cropping to simple boxes:
+    // polygons, circles and inverted crops aren't expressible as a
+    // prunable box, and bounds assigned an explicit SRS may not match
+    // the reader's coordinates.
+    if (m_args->m_bounds.empty() || m_args->m_cropOutside ||
+        !m_args->m_assignedSrs.empty() || m_args->m_polys.size() ||
+        m_args->m_centers.size())
+        return false;
+
+    bool is3d = true;
+    for (const Bounds& b : m_args->m_bounds)
+        if (b.is2d())
+            is3d = false;
+    if (is3d)
+    {
+        BOX3D box;
+        for (const Bounds& b : m_args->m_bounds)
+            box.grow(b.to3d());
+        bounds = Bounds(box);
+    }
+    else
+    {
+        // Mixed 2D/3D boxes devolve to an XY predicate.
+        BOX2D box;
+        for (const Bounds& b : m_args->m_bounds)
+            box.grow(b.to2d());
+        bounds = Bounds(box);
+    }
+    return true;
+}
+
+
 void CropFilter::ready(PointTableRef table)
 {
     // If the user didn't provide an SRS, take one from the table.
@@ -228,12 +269,22 @@ PointViewSet CropFilter::run(PointViewPtr view)
     PointViewSet viewSet;
 
     transform(view->spatialReference());
-    for (auto& geom : m_geoms)
+    if (m_geoms.size() && m_args->m_threads > 1)
     {
-        PointViewPtr outView = view->makeNew();
-        crop(geom, *view, *outView);
-        viewSet.insert(outView);
+        std::vector<PointViewPtr> outViews;
+        for (size_t i = 0; i < m_geoms.size(); ++i)
+            outViews.push_back(view->makeNew());
+        cropParallel(*view, outViews);
+        for (PointViewPtr& outView : outViews)
+            viewSet.insert(outView);
     }
+    else
+        for (auto& geom : m_geoms)
+        {
+            PointViewPtr outView = view->makeNew();
+            crop(geom, *view, *outView);
+            viewSet.insert(outView);
+        }
 
     for (auto& box : m_boxes)
     {
@@ -312,6 +363,103 @@ bool CropFilter::crop(const PointRef& point, GridPnp& g)
 }
 
 
+// Test points against all crop geometries on several threads at once,
+// producing the same output views, in the same order, as the serial
+// geometry loop.
+void CropFilter::cropParallel(PointView& input,
+    std::vector<PointViewPtr>& outViews)
+{
+    if (input.empty())
+        return;
+
+    // One work item per point-in-poly structure; a multipolygon
+    // contributes several items to the same output view.
+    struct Item
+    {
+        size_t m_view;
+        GridPnp *m_pnp;
+    };
+    std::vector<Item> items;
+    for (size_t i = 0; i < m_geoms.size(); ++i)
+        for (auto& pnp : m_geoms[i].m_gridPnps)
+        {
+            // Compute all grid cells now so the grids are read-only
+            // when shared by the threads below.
+            pnp->precompute();
+            items.push_back({ i, pnp.get() });
+        }
+
+    // For inside crops over many geometries, index the geometry
+    // bounding boxes so a point tests only candidates.  Outside crops
+    // keep points that miss a geometry, so every geometry must be
+    // visited for every point.
+    std::unique_ptr<BoxIndex> index;
+    if (!m_args->m_cropOutside && items.size() > 4)
+    {
+        std::vector<BoxIndex::Box> boxes;
+        for (Item& item : items)
+        {
+            BoxIndex::Box b;
+            item.m_pnp->extent(b.first, b.second);
+            boxes.push_back(b);
+        }
+        index.reset(new BoxIndex(boxes));
+    }
+
+    point_count_t nloops = input.size();
+    int threads = (int)(std::min)((point_count_t)m_args->m_threads, nloops);
+
+    // Matching point ids, gathered per thread and per item so that the
+    // merge below can preserve point order.
+    std::vector<std::vector<std::vector<PointId>>> hits(threads,
+        std::vector<std::vector<PointId>>(items.size()));
+
+    std::vector<std::thread> threadList(threads);
+    for (int t = 0; t < threads; t++)
+    {
+        PointId start = t * nloops / threads;
+        PointId end = (t + 1) == threads ? nloops : (t + 1) * nloops / threads;
+        threadList[t] = std::thread([&, t, start, end]()
+        {
+            PointRef point = input.point(0);
+            for (PointId idx = start; idx < end; ++idx)
+            {
+                point.setPointId(idx);
+                double x = point.getFieldAs<double>(Dimension::Id::X);
+                double y = point.getFieldAs<double>(Dimension::Id::Y);
+                if (index)
+                {
+                    for (size_t e : index->candidates(x, y))
+                        if (items[e].m_pnp->inside(x, y))
+                            hits[t][e].push_back(idx);
+                }
+                else
+                {
+                    for (size_t e = 0; e < items.size(); ++e)
+                        if (m_args->m_cropOutside !=
+                                items[e].m_pnp->inside(x, y))
+                            hits[t][e].push_back(idx);
+                }
+            }
+        });
+    }
+    for (auto& t : threadList)
+        t.join();
+
+    // Appending in item-then-thread order reproduces the serial output
+    // order.
+    for (size_t e = 0; e < items.size(); ++e)
+    {
+        PointView& outView = *outViews[items[e].m_view];
+        for (int t = 0; t < threads; t++)
+        {
+            std::vector<PointId>& ids = hits[t][e];
+            outView.appendPoints(input, ids.data(), ids.size());
+        }
+    }
+}
+
+
 void CropFilter::crop(const ViewGeom& g, PointView& input, PointView& output)
 {
     PointRef point = input.point(0);
@@ -80,6 +80,7 @@ private:
 
     void addArgs(ProgramArgs& args);
     virtual void initialize();
+    virtual bool spatialPredicate(Bounds& bounds) const;
 
     virtual void ready(PointTableRef table);
     virtual void spatialReferenceChanged(const SpatialReference& srs);
@@ -92,6 +93,7 @@ private:
     void crop(const Bounds& box, PointView& input, PointView& output);
     bool crop(const PointRef& point, GridPnp& g);
     void crop(const ViewGeom& g, PointView& input, PointView& output);
+    void cropParallel(PointView& input, std::vector<PointViewPtr>& outViews);
     bool crop(const PointRef& point, const filter::Point& center);
     void crop(const filter::Point& center, PointView& input,
         PointView& output);
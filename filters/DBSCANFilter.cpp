@@ -38,9 +38,12 @@
 #include "DBSCANFilter.hpp"
 
 #include <pdal/KDIndex.hpp>
+#include <pdal/util/ThreadPool.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <string>
-#include <unordered_set>
+#include <vector>
 
 namespace pdal
 {
@@ -53,6 +56,46 @@ static StaticPluginInfo const s_info{
 
 CREATE_STATIC_STAGE(DBSCANFilter, s_info)
 
+namespace
+{
+
+// Find the root of a point's component, splitting paths as we walk.  Safe
+// to call concurrently with unite().
+PointId findRoot(std::vector<std::atomic<PointId>>& parent, PointId i)
+{
+    while (true)
+    {
+        PointId p = parent[i].load(std::memory_order_relaxed);
+        if (p == i)
+            return i;
+        PointId gp = parent[p].load(std::memory_order_relaxed);
+        parent[i].compare_exchange_weak(p, gp, std::memory_order_relaxed);
+        i = p;
+    }
+}
+
+// Merge the components containing points a and b.  Roots always point at
+// lower-numbered roots, so a successful CAS on the larger root is the only
+// way a root stops being a root and the merge is lock-free.
+void unite(std::vector<std::atomic<PointId>>& parent, PointId a, PointId b)
+{
+    while (true)
+    {
+        a = findRoot(parent, a);
+        b = findRoot(parent, b);
+        if (a == b)
+            return;
+        if (a < b)
+            std::swap(a, b);
+        PointId expected = a;
+        if (parent[a].compare_exchange_strong(expected, b,
+            std::memory_order_relaxed))
+            return;
+    }
+}
+
+} // unnamed namespace
+
 std::string DBSCANFilter::getName() const
 {
     return s_info.name;
@@ -69,6 +112,8 @@ void DBSCANFilter::addArgs(ProgramArgs& args)
     args.add("eps", "Epsilon", m_eps, 1.0);
     args.add("dimensions", "Dimensions to cluster", m_dimStringList,
              {"X", "Y", "Z"});
+    args.add("threads", "Number of threads used to run this filter",
+             m_threads, 1);
 }
 
 void DBSCANFilter::addDimensions(PointLayoutPtr layout)
@@ -100,75 +145,86 @@ void DBSCANFilter::filter(PointView& view)
     KDFlexIndex kdfi(view, m_dimIdList);
     kdfi.build();
 
-    // First pass through point cloud precomputes neighbor indices and
-    // initializes ClusterID to -2.
-    std::vector<PointIdList> neighbors(view.size());
-    for (PointId idx = 0; idx < view.size(); ++idx)
-    {
-        neighbors[idx] = kdfi.radius(idx, m_eps);
-        view.setField(Id::ClusterID, idx, -2);
-    }
+    const point_count_t numPts = view.size();
+    if (!numPts)
+        return;
+
+    const size_t threads = (size_t)(std::min)(
+        (point_count_t)(std::max)(m_threads, 1), numPts);
+    ThreadPool pool(threads);
+    auto chunkStart = [numPts, threads](size_t t)
+        { return t * numPts / threads; };
+
+    // First pass through point cloud precomputes neighbor indices; the
+    // searches only read the index, so points chunk across threads.
+    std::vector<PointIdList> neighbors(numPts);
+    for (size_t t = 0; t < threads; ++t)
+        pool.add([&, t]()
+        {
+            for (PointId idx = chunkStart(t); idx < chunkStart(t + 1); ++idx)
+                neighbors[idx] = kdfi.radius(idx, m_eps);
+        });
+    pool.await();
+
+    // Core points have dense-enough neighborhoods, and clusters are the
+    // connected components of core points within eps of one another.
+    // Merging components with a lock-free union-find replaces the serial
+    // queue expansion and parallelizes over the same neighbor lists.
+    auto core = [this, &neighbors](PointId idx)
+        { return neighbors[idx].size() >= m_minPoints; };
+
+    std::vector<std::atomic<PointId>> parent(numPts);
+    for (PointId idx = 0; idx < numPts; ++idx)
+        parent[idx] = idx;
+    for (size_t t = 0; t < threads; ++t)
+        pool.add([&, t]()
+        {
+            for (PointId idx = chunkStart(t); idx < chunkStart(t + 1); ++idx)
+            {
+                if (!core(idx))
+                    continue;
+                for (PointId q : neighbors[idx])
+                    if (q != idx && core(q))
+                        unite(parent, idx, q);
+            }
+        });
+    pool.await();
 
-    // Second pass through point cloud performs DBSCAN clustering.
+    // Number clusters in point-id order.  Roots are the lowest core point
+    // of each component, so labels match the serial expansion, which
+    // seeded clusters from the first unlabeled core point.
+    std::vector<int64_t> labels(numPts, -1);
     int64_t cluster_label = 0;
-    for (PointId idx = 0; idx < view.size(); ++idx)
+    for (PointId idx = 0; idx < numPts; ++idx)
     {
-        // Point has already been labeled, so move on to next.
-        if (view.getFieldAs<int64_t>(Id::ClusterID, idx) != -2)
-            continue;
-
-        // Density of the neighborhood does not meet minimum number of points
-        // constraint, label as noise.
-        if (neighbors[idx].size() < m_minPoints)
-        {
-            view.setField(Id::ClusterID, idx, -1);
+        if (!core(idx))
             continue;
-        }
-
-        // Initialize some bookkeeping to track which neighbors have been
-        // considered for addition to the current cluster.
-        std::unordered_set<PointId> neighbors_next(neighbors[idx].begin(),
-                                                   neighbors[idx].end());
-        std::unordered_set<PointId> neighbors_visited;
-        neighbors_visited.insert(idx);
-
-        // Unlabeled point encountered; assign cluster label.
-        view.setField(Id::ClusterID, idx, cluster_label);
+        PointId root = findRoot(parent, idx);
+        if (labels[root] == -1)
+            labels[root] = cluster_label++;
+        labels[idx] = labels[root];
+    }
 
-        // Consider all neighbors.
-        while (!neighbors_next.empty())
+    // Border points adopt the smallest label among their core neighbors -
+    // the first cluster whose expansion would have reached them.  Points
+    // with no core neighbor remain noise.
+    for (size_t t = 0; t < threads; ++t)
+        pool.add([&, t]()
         {
-            // Select first neighbor and move it to the visited set.
-            PointId p = *neighbors_next.begin();
-            neighbors_next.erase(neighbors_next.begin());
-            neighbors_visited.insert(p);
-
-            // Reassign cluster label to neighbor previously marked as noise.
-            if (view.getFieldAs<int64_t>(Id::ClusterID, p) == -1)
-                view.setField(Id::ClusterID, p, cluster_label);
-
-            // Neighbor has already been labeled, so move on to next.
-            if (view.getFieldAs<int64_t>(Id::ClusterID, p) != -2)
-                continue;
-
-            // Assign cluster label to neighbor.
-            view.setField(Id::ClusterID, p, cluster_label);
-
-            // If density of neighbor's neighborhood is sufficient, add it's
-            // neighbors to the set of neighbors to consider if they are not
-            // already.
-            if (neighbors[p].size() >= m_minPoints)
+            for (PointId idx = chunkStart(t); idx < chunkStart(t + 1); ++idx)
             {
-                for (PointId q : neighbors[p])
-                {
-                    if (neighbors_visited.count(q) == 0)
-                        neighbors_next.insert(q);
-                }
+                if (core(idx))
+                    continue;
+                for (PointId q : neighbors[idx])
+                    if (core(q) && (labels[idx] == -1 ||
+                        labels[q] < labels[idx]))
+                        labels[idx] = labels[q];
             }
-        }
+        });
+    pool.await();
 
-        cluster_label++;
-    }
+    for (PointId idx = 0; idx < numPts; ++idx)
+        view.setField(Id::ClusterID, idx, labels[idx]);
 }
 
 } // namespace pdal
@@ -39,6 +39,7 @@
 
 #include <pdal/private/gdal/Raster.hpp>
 #include "private/DimRange.hpp"
+#include "private/RasterProbe.hpp"
 
 namespace pdal
 {
@@ -59,6 +60,7 @@ struct DEMArgs
     DimRange m_range;
     std::string m_raster;
     int32_t m_band;
+    int m_threads;
 };
 
 
@@ -83,6 +85,8 @@ void DEMFilter::addArgs(ProgramArgs& args)
     args.add("limits", "Dimension limits for filtering", m_args->m_range).setPositional();
     args.add("raster", "GDAL-readable raster to use for DEM", m_args->m_raster).setPositional();
     args.add("band", "Band number to filter (count from 1)", m_args->m_band, 1);
+    args.add("threads", "Number of threads used to probe the raster",
+        m_args->m_threads, 1);
 
 }
 
@@ -116,7 +120,7 @@ bool DEMFilter::processOne(PointRef& point)
 
     bool passes(false);
 
-    if (m_raster->read(x, y, data) == gdal::GDALError::None)
+    if (m_raster->readCached(x, y, data) == gdal::GDALError::None)
     {
         double v = data[m_args->m_band-1];
         double lb = v - m_args->m_range.m_lower_bound;
@@ -135,14 +139,33 @@ PointViewSet DEMFilter::run(PointViewPtr inView)
     if (!inView->size())
         return viewSet;
 
-    PointViewPtr outView = inView->makeNew();
+    // Probe the raster in tile-ordered batches (on several threads when
+    // requested), record which points pass, then build the output view
+    // serially so point order is preserved.
+    std::vector<char> keep(inView->size(), 0);
+    std::string error = RasterProbe::probe(*inView, *m_raster,
+        m_args->m_raster, m_args->m_threads,
+        [this, &keep](PointRef& point, const std::vector<double>& data,
+            bool ok)
+        {
+            if (!ok)
+                return;
+
+            double z = point.getFieldAs<double>(m_args->m_dim);
+            double v = data[m_args->m_band - 1];
+            double lb = v - m_args->m_range.m_lower_bound;
+            double ub = v + m_args->m_range.m_upper_bound;
+
+            if (z >= lb && z <= ub)
+                keep[point.pointId()] = 1;
+        });
+    if (error.size())
+        throwError(error);
 
+    PointViewPtr outView = inView->makeNew();
     for (PointId i = 0; i < inView->size(); ++i)
-    {
-        PointRef point = inView->point(i);
-        if (processOne(point))
+        if (keep[i])
             outView->appendPoint(*inView, i);
-    }
 
     viewSet.insert(outView);
     return viewSet;
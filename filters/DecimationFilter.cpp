@@ -34,6 +34,12 @@
 
 #include "DecimationFilter.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <numeric>
+#include <random>
+
 #include <pdal/PointView.hpp>
 #include <pdal/util/ProgramArgs.hpp>
 
@@ -49,8 +55,114 @@ static StaticPluginInfo const s_info
 
 CREATE_STATIC_STAGE(DecimationFilter, s_info)
 
+namespace
+{
+
+// Distribute 'count' samples among the strata proportionally to their
+// populations, assigning leftover samples by largest remainder.  No
+// stratum is ever allocated more than its population.
+std::vector<point_count_t> allocateStrata(
+    const std::vector<point_count_t>& sizes, point_count_t count)
+{
+    point_count_t total =
+        std::accumulate(sizes.begin(), sizes.end(), point_count_t(0));
+    std::vector<point_count_t> alloc(sizes.size(), 0);
+    if (!total)
+        return alloc;
+    if (count >= total)
+        return sizes;
+
+    std::vector<std::pair<uint64_t, size_t>> remainders;
+    point_count_t assigned = 0;
+    for (size_t i = 0; i < sizes.size(); ++i)
+    {
+        uint64_t scaled = (uint64_t)count * sizes[i];
+        alloc[i] = (point_count_t)(scaled / total);
+        assigned += alloc[i];
+        remainders.push_back({ scaled % total, i });
+    }
+    std::sort(remainders.begin(), remainders.end(),
+        [](const std::pair<uint64_t, size_t>& a,
+           const std::pair<uint64_t, size_t>& b)
+        {
+            return a.first > b.first ||
+                (a.first == b.first && a.second < b.second);
+        });
+    for (size_t i = 0; assigned < count; ++i, ++assigned)
+        alloc[remainders[i].second]++;
+    return alloc;
+}
+
+} // unnamed namespace
+
+// State for the stream-mode sampling paths.  Every incoming point is
+// withheld; the sample is emitted through drainOne once the input is
+// exhausted.
+struct DecimationFilter::SampleState
+{
+    // Reservoir of packed point records, capacity m_count.
+    struct Reservoir
+    {
+        std::vector<char> buf;
+        point_count_t seen = 0;
+    };
+
+    DimTypeList dimTypes;
+    size_t packedSize = 0;
+    std::mt19937 rng;
+
+    // One reservoir per Classification value; plain reservoir mode uses
+    // only stratum 0.
+    std::map<int, Reservoir> strata;
+
+    // Drain state.
+    bool draining = false;
+    std::vector<char> out;
+    size_t outPos = 0;
+};
+
+DecimationFilter::DecimationFilter()
+{}
+
+DecimationFilter::~DecimationFilter()
+{}
+
 std::string DecimationFilter::getName() const { return s_info.name; }
 
+std::istream& operator>>(std::istream& in, DecimationFilter::Mode& mode)
+{
+    std::string s;
+    in >> s;
+
+    s = Utils::tolower(s);
+    if (s == "step")
+        mode = DecimationFilter::Mode::Step;
+    else if (s == "reservoir")
+        mode = DecimationFilter::Mode::Reservoir;
+    else if (s == "stratified")
+        mode = DecimationFilter::Mode::Stratified;
+    else
+        in.setstate(std::ios_base::failbit);
+    return in;
+}
+
+std::ostream& operator<<(std::ostream& out, const DecimationFilter::Mode& mode)
+{
+    switch (mode)
+    {
+    case DecimationFilter::Mode::Step:
+        out << "step";
+        break;
+    case DecimationFilter::Mode::Reservoir:
+        out << "reservoir";
+        break;
+    case DecimationFilter::Mode::Stratified:
+        out << "stratified";
+        break;
+    }
+    return out;
+}
+
 void DecimationFilter::addArgs(ProgramArgs& args)
 {
     args.add("step", "Points to delete between each kept point", m_step, 1U);
@@ -58,13 +170,59 @@ void DecimationFilter::addArgs(ProgramArgs& args)
         m_offset);
     args.add("limit", "Index of last point to consider including in output",
         m_limit, (std::numeric_limits<point_count_t>::max)());
+    args.add("mode", "Decimation mode: 'step', 'reservoir' (uniform sample "
+        "of 'count' points) or 'stratified' (per-Classification sample of "
+        "'count' points)", m_mode, Mode::Step);
+    m_countArg = &args.add("count", "Number of points to sample in "
+        "'reservoir' and 'stratified' modes", m_count);
+    m_seedArg = &args.add("seed", "Seed for the sampling random number "
+        "generator", m_seed);
+}
+
+void DecimationFilter::prepared(PointTableRef table)
+{
+    if (m_mode != Mode::Step)
+    {
+        if (!m_countArg->set() || m_count == 0)
+            throwError("Option 'count' must be set to a positive value in "
+                "'reservoir' and 'stratified' modes.");
+        if (m_mode == Mode::Stratified &&
+            !table.layout()->hasDim(Dimension::Id::Classification))
+            log()->get(LogLevel::Warning) << "Could not find Classification. "
+                "Stratified sampling will use a single stratum.\n";
+    }
+}
+
+void DecimationFilter::ready(PointTableRef table)
+{
+    m_index = 0;
+    if (!m_seedArg->set())
+        m_seed = (unsigned)std::chrono::system_clock::now().
+            time_since_epoch().count();
+    if (m_mode != Mode::Step)
+    {
+        m_state.reset(new SampleState);
+        m_state->dimTypes = table.layout()->dimTypes();
+        m_state->packedSize = 0;
+        for (const DimType& d : m_state->dimTypes)
+            m_state->packedSize += Dimension::size(d.m_type);
+        m_state->rng.seed(m_seed);
+    }
+}
+
+void DecimationFilter::done(PointTableRef)
+{
+    m_state.reset();
 }
 
 PointViewSet DecimationFilter::run(PointViewPtr inView)
 {
     PointViewSet viewSet;
     PointViewPtr outView = inView->makeNew();
-    decimate(*inView.get(), *outView.get());
+    if (m_mode == Mode::Step)
+        decimate(*inView.get(), *outView.get());
+    else
+        sample(*inView.get(), *outView.get());
     viewSet.insert(outView);
     return viewSet;
 }
@@ -72,13 +230,115 @@ PointViewSet DecimationFilter::run(PointViewPtr inView)
 
 bool DecimationFilter::processOne(PointRef& point)
 {
-    bool keep = true;
-    if (m_index < m_offset || m_index >= m_limit)
-        keep = false;
-    else if ((m_index - m_offset) % m_step != 0)
-        keep = false;
-    m_index++;
-    return keep;
+    if (m_mode == Mode::Step)
+    {
+        bool keep = true;
+        if (m_index < m_offset || m_index >= m_limit)
+            keep = false;
+        else if ((m_index - m_offset) % m_step != 0)
+            keep = false;
+        m_index++;
+        return keep;
+    }
+
+    // Sampling modes: offer the point to its stratum's reservoir
+    // (algorithm R) and withhold it.  Memory use is bounded by the
+    // reservoir capacity regardless of input size.
+    int stratum = (m_mode == Mode::Stratified) ?
+        point.getFieldAs<int>(Dimension::Id::Classification) : 0;
+    SampleState::Reservoir& r = m_state->strata[stratum];
+    size_t packedSize = m_state->packedSize;
+    if (r.seen < m_count)
+    {
+        r.buf.resize(r.buf.size() + packedSize);
+        point.getPackedData(m_state->dimTypes,
+            r.buf.data() + r.seen * packedSize);
+    }
+    else
+    {
+        std::uniform_int_distribution<point_count_t> dist(0, r.seen);
+        point_count_t j = dist(m_state->rng);
+        if (j < m_count)
+            point.getPackedData(m_state->dimTypes,
+                r.buf.data() + j * packedSize);
+    }
+    r.seen++;
+    return false;
+}
+
+
+bool DecimationFilter::drainOne(PointRef& point)
+{
+    if (!m_state->draining)
+    {
+        size_t packedSize = m_state->packedSize;
+        if (m_mode == Mode::Reservoir)
+        {
+            if (m_state->strata.size())
+                m_state->out = std::move(m_state->strata[0].buf);
+        }
+        else
+        {
+            // Allocate the sample proportionally from the final
+            // Classification histogram, then subsample each stratum's
+            // reservoir; a uniform subsample of a uniform sample is
+            // itself uniform.
+            std::vector<point_count_t> sizes;
+            std::vector<SampleState::Reservoir *> reservoirs;
+            for (auto& s : m_state->strata)
+            {
+                sizes.push_back(s.second.seen);
+                reservoirs.push_back(&s.second);
+            }
+            std::vector<point_count_t> alloc =
+                allocateStrata(sizes, m_count);
+            for (size_t i = 0; i < reservoirs.size(); ++i)
+            {
+                SampleState::Reservoir& r = *reservoirs[i];
+                point_count_t stored =
+                    (point_count_t)(r.buf.size() / packedSize);
+                point_count_t want = (std::min)(alloc[i], stored);
+
+                // Partial Fisher-Yates on the stored slots.
+                std::vector<point_count_t> slots(stored);
+                std::iota(slots.begin(), slots.end(), 0);
+                for (point_count_t j = 0; j < want; ++j)
+                {
+                    std::uniform_int_distribution<point_count_t>
+                        dist(j, stored - 1);
+                    std::swap(slots[j], slots[dist(m_state->rng)]);
+                    m_state->out.insert(m_state->out.end(),
+                        r.buf.begin() + slots[j] * packedSize,
+                        r.buf.begin() + (slots[j] + 1) * packedSize);
+                }
+            }
+        }
+        m_state->draining = true;
+        m_state->outPos = 0;
+    }
+
+    if (m_state->outPos >= m_state->out.size())
+        return false;
+    point.setPackedData(m_state->dimTypes,
+        m_state->out.data() + m_state->outPos);
+    m_state->outPos += m_state->packedSize;
+    return true;
+}
+
+
+// Report how far away the next kept point is so that the source can seek
+// over the intervening points instead of decoding them.  The sampling
+// modes must see every point, so they never skip.
+point_count_t DecimationFilter::skipAhead() const
+{
+    if (m_mode != Mode::Step)
+        return 0;
+    if (m_index < m_offset)
+        return m_offset - m_index;
+    if (m_index >= m_limit)
+        return (std::numeric_limits<point_count_t>::max)();
+    point_count_t rem = (m_index - m_offset) % m_step;
+    return rem ? m_step - rem : 0;
 }
 
 
@@ -89,4 +349,53 @@ void DecimationFilter::decimate(PointView& input, PointView& output)
         output.appendPoint(input, idx);
 }
 
+
+// Reservoir and stratified sampling over a full view.  Selection works
+// on point IDs (algorithm R per stratum); the chosen IDs are appended in
+// view order.
+void DecimationFilter::sample(PointView& input, PointView& output)
+{
+    std::mt19937 rng(m_seed);
+
+    // Group the points by stratum.
+    std::map<int, PointIdList> strata;
+    for (PointId idx = 0; idx < input.size(); ++idx)
+    {
+        int stratum = (m_mode == Mode::Stratified) ?
+            input.getFieldAs<int>(Dimension::Id::Classification, idx) : 0;
+        strata[stratum].push_back(idx);
+    }
+
+    std::vector<point_count_t> sizes;
+    for (const auto& s : strata)
+        sizes.push_back(s.second.size());
+    std::vector<point_count_t> alloc = (m_mode == Mode::Stratified) ?
+        allocateStrata(sizes, m_count) :
+        std::vector<point_count_t>{ (std::min)(m_count,
+            (point_count_t)input.size()) };
+
+    PointIdList keep;
+    size_t i = 0;
+    for (const auto& s : strata)
+    {
+        const PointIdList& ids = s.second;
+        point_count_t want = alloc[i++];
+
+        // Algorithm R over this stratum's IDs.
+        PointIdList reservoir(ids.begin(), ids.begin() + want);
+        for (point_count_t j = want; j < ids.size(); ++j)
+        {
+            std::uniform_int_distribution<point_count_t> dist(0, j);
+            point_count_t pos = dist(rng);
+            if (pos < want)
+                reservoir[pos] = ids[j];
+        }
+        keep.insert(keep.end(), reservoir.begin(), reservoir.end());
+    }
+
+    std::sort(keep.begin(), keep.end());
+    for (PointId idx : keep)
+        output.appendPoint(input, idx);
+}
+
 } // pdal
@@ -34,6 +34,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include <pdal/Filter.hpp>
 #include <pdal/Streamable.hpp>
 
@@ -44,23 +46,51 @@ namespace pdal
 class PDAL_DLL DecimationFilter : public Filter, public Streamable
 {
 public:
-    DecimationFilter()
-        {}
+    enum class Mode
+    {
+        Step,
+        Reservoir,
+        Stratified
+    };
+
+    DecimationFilter();
+    ~DecimationFilter();
 
     std::string getName() const;
 
 private:
+    struct SampleState;
+
     uint32_t m_step;
     uint32_t m_offset;
     point_count_t m_limit;
     PointId m_index;
+    Mode m_mode;
+    point_count_t m_count;
+    Arg *m_countArg;
+    Arg *m_seedArg;
+    unsigned m_seed;
+    std::unique_ptr<SampleState> m_state;
 
     virtual void addArgs(ProgramArgs& args);
-    void ready(PointTableRef table)
-        { m_index = 0; }
+    virtual void prepared(PointTableRef table);
+    virtual void ready(PointTableRef table);
+    virtual void done(PointTableRef table);
     bool processOne(PointRef& point);
+    virtual bool deferred() const
+        { return m_mode != Mode::Step; }
+    virtual bool drainOne(PointRef& point);
+    virtual point_count_t skipAhead() const;
+    virtual void skippedAhead(point_count_t count)
+        { m_index += count; }
     PointViewSet run(PointViewPtr view);
     void decimate(PointView& input, PointView& output);
+    void sample(PointView& input, PointView& output);
+
+    friend std::istream& operator>>(std::istream& in,
+        DecimationFilter::Mode& mode);
+    friend std::ostream& operator<<(std::ostream& out,
+        const DecimationFilter::Mode& mode);
 
     DecimationFilter& operator=(const DecimationFilter&); // not implemented
     DecimationFilter(const DecimationFilter&); // not implemented
@@ -33,6 +33,10 @@
 ****************************************************************************/
 
 #include <cstddef> // NULL
+#include <thread>
+
+#include <pdal/util/ProgramArgs.hpp>
+
 #include "DelaunayFilter.hpp"
 #include "private/delaunator.hpp"
 
@@ -62,6 +66,13 @@ DelaunayFilter::~DelaunayFilter()
 {}
 
 
+void DelaunayFilter::addArgs(ProgramArgs& args)
+{
+    args.add("threads", "Number of threads used to run this filter",
+        m_threads, 1);
+}
+
+
 void DelaunayFilter::filter(PointView& pointView)
 {
     // Returns NULL if the mesh already exists
@@ -76,17 +87,44 @@ void DelaunayFilter::filter(PointView& pointView)
         return;
     }
 
-    std::vector<double> delaunayPoints;
-    for (PointId i = 0; i < pointView.size(); i++)
+    std::vector<double> delaunayPoints(pointView.size() * 2);
+    if (m_threads > 1)
+    {
+        point_count_t nloops = pointView.size();
+        int threads = (int)(std::min)((point_count_t)m_threads, nloops);
+        std::vector<std::thread> threadList(threads);
+        for (int t = 0; t < threads; t++)
+        {
+            threadList[t] = std::thread([&, t]()
+            {
+                PointId start = t * nloops / threads;
+                PointId end = (t + 1) == threads ?
+                    nloops : (t + 1) * nloops / threads;
+                for (PointId i = start; i < end; i++)
+                {
+                    delaunayPoints[2 * i] =
+                        pointView.getFieldAs<double>(Dimension::Id::X, i);
+                    delaunayPoints[2 * i + 1] =
+                        pointView.getFieldAs<double>(Dimension::Id::Y, i);
+                }
+            });
+        }
+        for (auto& t : threadList)
+            t.join();
+    }
+    else
     {
-        delaunayPoints.push_back(
-            pointView.getFieldAs<double>(Dimension::Id::X, i));
-        delaunayPoints.push_back(
-            pointView.getFieldAs<double>(Dimension::Id::Y, i));
+        for (PointId i = 0; i < pointView.size(); i++)
+        {
+            delaunayPoints[2 * i] =
+                pointView.getFieldAs<double>(Dimension::Id::X, i);
+            delaunayPoints[2 * i + 1] =
+                pointView.getFieldAs<double>(Dimension::Id::Y, i);
+        }
     }
 
     // Actually perform the triangulation
-    delaunator::Delaunator triangulation(delaunayPoints);
+    delaunator::Delaunator triangulation(delaunayPoints, m_threads);
 
     for (std::size_t i = 0; i < triangulation.triangles.size(); i += 3)
         mesh->add(triangulation.triangles[i+2], triangulation.triangles[i+1],
@@ -50,6 +50,9 @@ public:
     std::string getName() const;
 
 private:
+    int m_threads;
+
+    virtual void addArgs(ProgramArgs& args);
     virtual void filter(PointView& view);
 };
 
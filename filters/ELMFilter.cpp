@@ -39,8 +39,15 @@
 
 #include "ELMFilter.hpp"
 
-#include <map>
+#include <algorithm>
+#include <numeric>
 #include <string>
+#include <thread>
+#include <vector>
+
+#include <pdal/util/ThreadPool.hpp>
+
+#include "private/ParallelSort.hpp"
 
 namespace pdal
 {
@@ -79,56 +86,95 @@ void ELMFilter::filter(PointView& view)
     BOX2D bounds;
     view.calculateBounds(bounds);
 
-    size_t cols =
-        static_cast<size_t>(((bounds.maxx - bounds.minx) / m_cell) + 1);
     size_t rows =
         static_cast<size_t>(((bounds.maxy - bounds.miny) / m_cell) + 1);
 
-    // Make an initial pass through the input PointView to index elevation
-    // values and PointIds by row and column.
-    std::map<uint32_t, std::multimap<double, PointId>> hash;
-    for (PointId id = 0; id < view.size(); ++id)
+    // Make an initial pass through the input PointView to assign each
+    // point its cell.  Cells are laid out flat (CSR): per-cell offsets
+    // into one packed entry array instead of a map of multimaps.
+    point_count_t numPts = view.size();
+    std::vector<size_t> cellOf(numPts);
+    size_t maxKey = 0;
+    for (PointId id = 0; id < numPts; ++id)
     {
         double x = view.getFieldAs<double>(Dimension::Id::X, id);
         double y = view.getFieldAs<double>(Dimension::Id::Y, id);
-        double z = view.getFieldAs<double>(Dimension::Id::Z, id);
 
         size_t c = static_cast<size_t>(std::floor(x - bounds.minx) / m_cell);
         size_t r = static_cast<size_t>(std::floor(y - bounds.miny) / m_cell);
 
-        hash[c * rows + r].emplace(z, id);
+        cellOf[id] = c * rows + r;
+        maxKey = (std::max)(maxKey, cellOf[id]);
     }
 
-    // Count the number of points we classify as noise.
-    point_count_t num(0);
-
-    // Make a second pass through the now rasterized PointView to compute the
-    // extended local minimum.
-    for (size_t c = 0; c < cols; ++c)
+    struct Entry
     {
-        for (size_t r = 0; r < rows; ++r)
-        {
-            std::multimap<double, PointId> ids(hash[c * rows + r]);
+        double z;
+        PointId id;
+    };
+
+    size_t numCells = maxKey + 1;
+    std::vector<size_t> starts(numCells + 1, 0);
+    for (PointId id = 0; id < numPts; ++id)
+        starts[cellOf[id] + 1]++;
+    std::partial_sum(starts.begin(), starts.end(), starts.begin());
 
-            if (ids.size() <= 1)
-                continue;
+    std::vector<Entry> entries(numPts);
+    {
+        std::vector<size_t> fill(starts.begin(), starts.end() - 1);
+        for (PointId id = 0; id < numPts; ++id)
+            entries[fill[cellOf[id]]++] =
+                { view.getFieldAs<double>(Dimension::Id::Z, id), id };
+    }
 
-            for (auto it = ids.begin(); it != std::prev(ids.end()); ++it)
+    // Cells don't interact, so workers process disjoint cell ranges in
+    // parallel: sort a cell's elevations (point order breaks ties, as the
+    // multimap did) and walk up from the minimum.
+    size_t threads = threadCount(numPts);
+    ThreadPool pool(threads);
+    auto cellStart = [numCells, threads](size_t t)
+        { return t * numCells / threads; };
+
+    std::vector<point_count_t> nums(threads, 0);
+    for (size_t t = 0; t < threads; ++t)
+        pool.add([&, t]()
+        {
+            for (size_t cell = cellStart(t); cell < cellStart(t + 1); ++cell)
             {
-                // Where the current value is sufficiently close to the next, we
-                // consider that this is not a low outlier and break the current
-                // loop.
-                if (std::fabs(it->first - std::next(it)->first) < m_threshold)
-                    break;
-
-                // Otherwise this point is classified as noise, and we proceed
-                // to the next lowest value.
-                view.setField(Dimension::Id::Classification, it->second,
-                              m_class);
-                ++num;
+                size_t lo = starts[cell];
+                size_t hi = starts[cell + 1];
+                if (hi - lo <= 1)
+                    continue;
+
+                std::sort(entries.begin() + lo, entries.begin() + hi,
+                    [](const Entry& a, const Entry& b)
+                    {
+                        return a.z < b.z ||
+                            (a.z == b.z && a.id < b.id);
+                    });
+
+                for (size_t i = lo; i < hi - 1; ++i)
+                {
+                    // Where the current value is sufficiently close to the
+                    // next, we consider that this is not a low outlier and
+                    // break the current loop.
+                    if (std::fabs(entries[i].z - entries[i + 1].z) <
+                        m_threshold)
+                        break;
+
+                    // Otherwise this point is classified as noise, and we
+                    // proceed to the next lowest value.
+                    view.setField(Dimension::Id::Classification,
+                        entries[i].id, m_class);
+                    ++nums[t];
+                }
             }
-        }
-    }
+        });
+    pool.await();
+
+    // Count the number of points we classify as noise.
+    point_count_t num =
+        std::accumulate(nums.begin(), nums.end(), point_count_t(0));
 
     log()->get(LogLevel::Info)
         << "Classified " << num
@@ -36,11 +36,14 @@
 
 #include <pdal/KDIndex.hpp>
 #include <pdal/util/ProgramArgs.hpp>
+#include <pdal/util/ThreadPool.hpp>
 #include <pdal/private/MathUtils.hpp>
 
 #include <Eigen/Dense>
 
+#include <atomic>
 #include <string>
+#include <thread>
 
 namespace pdal
 {
@@ -116,44 +119,72 @@ void EigenvaluesFilter::filter(PointView& view)
 {
     const KD3Index& kdi = view.build3dIndex();
 
-    for (PointRef p : view)
+    // Each point's eigenvalues depend only on its own neighborhood, so
+    // points are processed in parallel - index queries are read-only and
+    // every worker writes to its own range of points.
+    const size_t threads = (std::min)((point_count_t)(std::max)(
+        std::thread::hardware_concurrency(), 1U), view.size());
+    std::atomic<bool> solverFailed(false);
+    ThreadPool pool(threads ? threads : 1);
+    for (size_t t = 0; t < threads; ++t)
     {
-        // find neighbors, either by radius or k nearest neighbors
-        PointIdList ids;
-        if (m_args->m_radiusArg->set())
+        const PointId start = t * view.size() / threads;
+        const PointId end =
+            (t + 1 == threads) ? view.size() : (t + 1) * view.size() / threads;
+        pool.add([this, &view, &kdi, &solverFailed, start, end]()
         {
-            ids = kdi.radius(p, m_args->m_radius);
-
-            // if insufficient number of neighbors, eigen solver will fail
-            // anyway, it may be okay to silently return without setting any of
-            // the computed features?
-            if (ids.size() < (size_t)m_args->m_minK)
-                continue;
-        }
-        else
-        {
-            ids = kdi.neighbors(p, m_args->m_knn + 1, m_args->m_stride);
-        }
+            for (PointId i = start; i < end; ++i)
+            {
+                PointRef p = view.point(i);
+                if (!processPoint(view, kdi, p))
+                    solverFailed = true;
+            }
+        });
+    }
+    pool.join();
+    if (solverFailed)
+        throwError("Cannot perform eigen decomposition.");
+}
+
+bool EigenvaluesFilter::processPoint(PointView& view, const KD3Index& kdi,
+    PointRef& p)
+{
+    // find neighbors, either by radius or k nearest neighbors
+    PointIdList ids;
+    if (m_args->m_radiusArg->set())
+    {
+        ids = kdi.radius(p, m_args->m_radius);
 
-        // compute covariance of the neighborhood
-        Matrix3d B = math::computeCovariance(view, ids);
+        // if insufficient number of neighbors, eigen solver will fail
+        // anyway, it may be okay to silently return without setting any of
+        // the computed features?
+        if (ids.size() < (size_t)m_args->m_minK)
+            return true;
+    }
+    else
+    {
+        ids = kdi.neighbors(p, m_args->m_knn + 1, m_args->m_stride);
+    }
 
-        // perform the eigen decomposition
-        Eigen::SelfAdjointEigenSolver<Matrix3d> solver(B);
-        if (solver.info() != Eigen::Success)
-            throwError("Cannot perform eigen decomposition.");
-        Vector3d ev = solver.eigenvalues();
+    // compute covariance of the neighborhood
+    Matrix3d B = math::computeCovariance(view, ids);
 
-        if (m_args->m_normalize)
-        {
-            double sum = ev[0] + ev[1] + ev[2];
-            ev /= sum;
-        }
+    // perform the eigen decomposition
+    Eigen::SelfAdjointEigenSolver<Matrix3d> solver(B);
+    if (solver.info() != Eigen::Success)
+        return false;
+    Vector3d ev = solver.eigenvalues();
 
-        p.setField(Id::Eigenvalue0, ev[0]);
-        p.setField(Id::Eigenvalue1, ev[1]);
-        p.setField(Id::Eigenvalue2, ev[2]);
+    if (m_args->m_normalize)
+    {
+        double sum = ev[0] + ev[1] + ev[2];
+        ev /= sum;
     }
+
+    p.setField(Id::Eigenvalue0, ev[0]);
+    p.setField(Id::Eigenvalue1, ev[1]);
+    p.setField(Id::Eigenvalue2, ev[2]);
+    return true;
 }
 
 } // namespace pdal
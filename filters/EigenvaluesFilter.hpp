@@ -61,6 +61,7 @@ private:
     virtual void addArgs(ProgramArgs& args);
     virtual void prepared(PointTableRef table);
     virtual void filter(PointView& view);
+    bool processPoint(PointView& view, const KD3Index& kdi, PointRef& p);
 };
 
 } // namespace pdal
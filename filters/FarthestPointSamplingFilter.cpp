@@ -66,6 +66,8 @@ void FarthestPointSamplingFilter::addArgs(ProgramArgs& args)
 {
     args.add("count", "Target number of points after sampling", m_count,
              point_count_t(1000));
+    args.add("threads", "Number of threads used to run this filter",
+             m_threads, 1);
 }
 
 PointViewSet FarthestPointSamplingFilter::run(PointViewPtr inView)
@@ -82,7 +84,8 @@ PointViewSet FarthestPointSamplingFilter::run(PointViewPtr inView)
         return viewSet;
     }
 
-    PointIdList ids = Segmentation::farthestPointSampling(*inView, m_count);
+    PointIdList ids =
+        Segmentation::farthestPointSamplingGrid(*inView, m_count, m_threads);
 
     PointViewPtr outView = inView->makeNew();
     for (auto const& id : ids)
@@ -52,6 +52,7 @@ public:
 
 private:
     point_count_t m_count;
+    int m_threads;
 
     virtual void addArgs(ProgramArgs& args);
     virtual PointViewSet run(PointViewPtr view);
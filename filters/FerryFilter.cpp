@@ -49,6 +49,23 @@ static StaticPluginInfo const s_info
 
 CREATE_STATIC_STAGE(FerryFilter, s_info)
 
+namespace
+{
+
+// Copy one dimension to another of the same stored type.  Instantiated
+// at the storage type, the accessors reduce to raw loads and stores -
+// no round trip through double and no per-point conversion.
+template <typename T>
+void copySame(PointView& view, Dimension::Id fromId, Dimension::Id toId)
+{
+    TypedField<T> from(view, fromId);
+    TypedField<T> to(view, toId);
+    for (PointId id = 0; id < view.size(); ++id)
+        to.set(id, from.get(id));
+}
+
+} // unnamed namespace
+
 std::string FerryFilter::getName() const { return s_info.name; }
 
 void FerryFilter::addArgs(ProgramArgs& args)
@@ -129,11 +146,61 @@ bool FerryFilter::processOne(PointRef& point)
 
 void FerryFilter::filter(PointView& view)
 {
-    PointRef point(view, 0);
-    for (PointId id = 0; id < view.size(); ++id)
+    // Resolve the source and destination types once per view rather
+    // than on every field access.  When both dimensions store the same
+    // type - the common case, since the destination defaults to the
+    // source's type - move the values directly instead of converting
+    // each through double.
+    const PointLayoutPtr layout = view.layout();
+    for (const auto& info : m_dims)
     {
-        point.setPointId(id);
-        processOne(point);
+        if (info.m_fromId == Dimension::Id::Unknown)
+            continue;
+
+        Dimension::Type fromType = layout->dimType(info.m_fromId);
+        if (fromType == layout->dimType(info.m_toId))
+        {
+            switch (fromType)
+            {
+            case Dimension::Type::Float:
+                copySame<float>(view, info.m_fromId, info.m_toId);
+                continue;
+            case Dimension::Type::Double:
+                copySame<double>(view, info.m_fromId, info.m_toId);
+                continue;
+            case Dimension::Type::Signed8:
+                copySame<int8_t>(view, info.m_fromId, info.m_toId);
+                continue;
+            case Dimension::Type::Signed16:
+                copySame<int16_t>(view, info.m_fromId, info.m_toId);
+                continue;
+            case Dimension::Type::Signed32:
+                copySame<int32_t>(view, info.m_fromId, info.m_toId);
+                continue;
+            case Dimension::Type::Signed64:
+                copySame<int64_t>(view, info.m_fromId, info.m_toId);
+                continue;
+            case Dimension::Type::Unsigned8:
+                copySame<uint8_t>(view, info.m_fromId, info.m_toId);
+                continue;
+            case Dimension::Type::Unsigned16:
+                copySame<uint16_t>(view, info.m_fromId, info.m_toId);
+                continue;
+            case Dimension::Type::Unsigned32:
+                copySame<uint32_t>(view, info.m_fromId, info.m_toId);
+                continue;
+            case Dimension::Type::Unsigned64:
+                copySame<uint64_t>(view, info.m_fromId, info.m_toId);
+                continue;
+            case Dimension::Type::None:
+                break;
+            }
+        }
+
+        TypedField<double> from(view, info.m_fromId);
+        TypedField<double> to(view, info.m_toId);
+        for (PointId id = 0; id < view.size(); ++id)
+            to.set(id, from.get(id));
     }
 }
 
@@ -71,6 +71,10 @@ private:
     virtual void prepared(PointTableRef table);
     virtual bool processOne(PointRef& point);
     virtual void filter(PointView& view);
+    // filter() only reads m_dims and writes the passed view's points,
+    // so views can be processed concurrently.
+    virtual bool viewThreadSafe() const
+    { return true; }
 
     FerryFilter& operator=(const FerryFilter&) = delete;
     FerryFilter(const FerryFilter&) = delete;
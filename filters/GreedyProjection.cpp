@@ -74,6 +74,8 @@ void GreedyProjection::addArgs(ProgramArgs& args)
         maximum_angle_, 2 * M_PI / 3);  // 120 degrees default
     args.add("eps_angle", "Max normal difference angle for triangulation "
         "consideration", eps_angle_, M_PI / 4);
+    args.add("threads", "Number of threads used to precompute point "
+        "neighborhoods", threads_, 1);
 }
 
 
@@ -141,6 +143,30 @@ void GreedyProjection::filter(PointView& view)
     PointIdList nnIdx(nnn_);
     std::vector<double> sqrDists(nnn_);
 
+    // When threads are requested, all neighborhoods are computed up front
+    // through the bulk KD API and the growth loop reads its queries from
+    // the preallocated arenas.  The serial front advance is untouched --
+    // the triangulation state machine is order dependent -- so the mesh
+    // is identical either way.  Costs nnn_ ids and distances per point.
+    PointIdList allNbrs;
+    std::vector<double> allNbrDists;
+    if (threads_ > 1)
+        tree.knnSearchAll(nnn_, allNbrs, allNbrDists, threads_);
+
+    auto findNeighbors = [&](PointId idx)
+    {
+        if (threads_ > 1)
+        {
+            size_t pos = (size_t)idx * nnn_;
+            std::copy(allNbrs.begin() + pos, allNbrs.begin() + pos + nnn_,
+                nnIdx.begin());
+            std::copy(allNbrDists.begin() + pos,
+                allNbrDists.begin() + pos + nnn_, sqrDists.begin());
+        }
+        else
+            tree.knnSearch(idx, nnn_, &nnIdx, &sqrDists);
+    };
+
     // current number of connected components
     int part_index = 0;
 
@@ -213,7 +239,7 @@ void GreedyProjection::filter(PointView& view)
       part_[R_] = part_index++;
 
       // creating starting triangle
-      tree.knnSearch(R_, nnn_, &nnIdx, &sqrDists);
+      findNeighbors(R_);
 
       double sqr_dist_threshold =
           (std::min)(sqr_max_edge, sqr_mu * sqrDists[1]);
@@ -387,7 +413,7 @@ void GreedyProjection::filter(PointView& view)
         state_[R_] = GP3Type::COMPLETED;
         continue;
       }
-      tree.knnSearch(R_, nnn_, &nnIdx, &sqrDists);
+      findNeighbors(R_);
 
 /**
       // Search tree returns indices into the original cloud, but we are working with indices TODO: make that optional!
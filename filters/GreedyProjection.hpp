@@ -150,6 +150,7 @@ namespace pdal
         mu_ (0),
         search_radius_ (0), // must be set by user
         nnn_ (100),
+        threads_ (1),
         minimum_angle_ (M_PI/18), // 10 degrees
         maximum_angle_ (2*M_PI/3), // 120 degrees
         eps_angle_(M_PI/4), //45 degrees,
@@ -242,6 +243,9 @@ namespace pdal
       /** \brief  Maximum number of nearest neighbors accepted by searching. */
       int nnn_;
 
+      /** \brief Number of threads used to precompute neighborhoods. */
+      int threads_;
+
       /** \brief The preferred minimum angle for the triangles. */
       double minimum_angle_;
 
@@ -34,7 +34,12 @@
 
 #include "GroupByFilter.hpp"
 
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
 #include <pdal/util/ProgramArgs.hpp>
+#include <pdal/util/ThreadPool.hpp>
 
 namespace pdal
 {
@@ -69,19 +74,95 @@ void GroupByFilter::prepared(PointTableRef table)
     // also need to check that we have a dimension with discrete values
 }
 
+namespace
+{
+// Don't spin up workers for small views; reading a key and scattering
+// an index are each only a few operations.
+const point_count_t minParallelSize = 100000;
+}
+
 PointViewSet GroupByFilter::run(PointViewPtr inView)
 {
     PointViewSet viewSet;
     if (!inView->size())
         return viewSet;
 
-    for (PointId idx = 0; idx < inView->size(); idx++)
+    // Gather each point's key once and form the groups as contiguous
+    // runs of an order array - a counting pass with per-chunk histograms
+    // and a bucket-offset scatter - instead of a map insert per point.
+    const point_count_t size = inView->size();
+    size_t threads = (std::min)((size_t)(std::max)(
+        std::thread::hardware_concurrency(), 1U),
+        (size_t)(size / minParallelSize));
+    threads = (std::max)(threads, (size_t)1);
+
+    auto chunk = [size, threads](size_t t)
+        { return (PointId)(t * size / threads); };
+
+    std::vector<int64_t> keys(size);
+    std::vector<std::unordered_map<int64_t, point_count_t>> counts(threads);
+
+    ThreadPool pool(threads);
+    for (size_t t = 0; t < threads; ++t)
+        pool.add([&, t]()
+        {
+            auto& c = counts[t];
+            for (PointId idx = chunk(t); idx < chunk(t + 1); ++idx)
+            {
+                keys[idx] = inView->getFieldAs<int64_t>(m_dimId, idx);
+                c[keys[idx]]++;
+            }
+        });
+    pool.await();
+
+    // Group sizes across chunks, in ascending key order as before.
+    std::map<int64_t, point_count_t> groups;
+    for (const auto& c : counts)
+        for (const auto& kv : c)
+            groups[kv.first] += kv.second;
+
+    // Assign each group a contiguous region and rewrite the per-chunk
+    // counts into scatter offsets, chunks in order within each region,
+    // so the scatter keeps points in arrival order.
+    point_count_t offset = 0;
+    for (auto& g : groups)
     {
-        int64_t val = inView->getFieldAs<int64_t>(m_dimId, idx);
-        PointViewPtr& outView = m_viewMap[val];
+        g.second = offset;
+        for (size_t t = 0; t < threads; ++t)
+        {
+            auto it = counts[t].find(g.first);
+            if (it != counts[t].end())
+            {
+                point_count_t n = it->second;
+                it->second = offset;
+                offset += n;
+            }
+        }
+    }
+
+    std::vector<PointId> order(size);
+    for (size_t t = 0; t < threads; ++t)
+        pool.add([&, t]()
+        {
+            auto& c = counts[t];
+            for (PointId idx = chunk(t); idx < chunk(t + 1); ++idx)
+                order[c[keys[idx]]++] = idx;
+        });
+    pool.await();
+
+    // Append each group's points to its view; regions are contiguous and
+    // in ascending key order, so each region ends where the next begins.
+    for (auto gi = groups.begin(); gi != groups.end(); ++gi)
+    {
+        point_count_t start = gi->second;
+        auto next = std::next(gi);
+        point_count_t end = (next == groups.end()) ? size : next->second;
+
+        PointViewPtr& outView = m_viewMap[gi->first];
         if (!outView)
             outView = inView->makeNew();
-        outView->appendPoint(*inView.get(), idx);
+        for (point_count_t i = start; i < end; ++i)
+            outView->appendPoint(*inView.get(), order[i]);
     }
 
     // Pull the buffers out of the map and stick them in the standard
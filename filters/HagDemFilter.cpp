@@ -34,8 +34,11 @@
 
 #include "HagDemFilter.hpp"
 
+#include <pdal/private/gdal/DatasetPool.hpp>
 #include <pdal/private/gdal/Raster.hpp>
 
+#include "private/RasterProbe.hpp"
+
 namespace pdal
 {
 
@@ -66,6 +69,8 @@ void HagDemFilter::addArgs(ProgramArgs& args)
     args.add("zero_ground", "If true, set HAG of ground-classified points "
         "to 0 rather than comparing Z value to raster DEM",
         m_zeroGround, true);
+    args.add("threads", "Number of threads used to probe the raster",
+        m_threads, 1);
 }
 
 
@@ -77,7 +82,8 @@ void HagDemFilter::addDimensions(PointLayoutPtr layout)
 
 void HagDemFilter::ready(PointTableRef table)
 {
-    m_raster.reset(new gdal::Raster(m_rasterName));
+    m_raster.reset();
+    m_raster = gdal::DatasetPool::instance().raster(m_rasterName);
     m_raster->open();
 }
 
@@ -89,12 +95,31 @@ void HagDemFilter::prepared(PointTableRef table)
 
 void HagDemFilter::filter(PointView& view)
 {
-    PointRef point(view, 0);
-    for (PointId i = 0; i < view.size(); ++i)
-    {
-        point.setPointId(i);
-        processOne(point);
-    }
+    using namespace pdal::Dimension;
+
+    if (!view.size())
+        return;
+
+    std::string error = RasterProbe::probe(view, *m_raster, m_rasterName,
+        m_threads,
+        [this](PointRef& point, const std::vector<double>& data, bool ok)
+        {
+            // If "zero_ground" option is set, all ground points get HAG of 0
+            if (m_zeroGround && point.getFieldAs<uint8_t>(Id::Classification)
+                == ClassLabel::Ground)
+            {
+                point.setField(Id::HeightAboveGround, 0);
+            }
+            else if (ok)
+            {
+                // If raster has a point at X, Y of pointcloud point, use it.
+                // Otherwise the HAG value is not set.
+                double z = point.getFieldAs<double>(Id::Z);
+                point.setField(Id::HeightAboveGround, z - data[m_band - 1]);
+            }
+        });
+    if (error.size())
+        throwError(error);
 }
 
 bool HagDemFilter::processOne(PointRef& point)
@@ -115,7 +140,7 @@ bool HagDemFilter::processOne(PointRef& point)
 
         // If raster has a point at X, Y of pointcloud point, use it.
         // Otherwise the HAG value is not set.
-        if (m_raster->read(x, y, data) == gdal::GDALError::None)
+        if (m_raster->readCached(x, y, data) == gdal::GDALError::None)
         {
             double z = point.getFieldAs<double>(Id::Z);
             double hag = z - data[m_band - 1];
@@ -66,10 +66,11 @@ private:
     virtual void filter(PointView& view);
     virtual bool processOne(PointRef& point);
 
-    std::unique_ptr<gdal::Raster> m_raster;
+    std::shared_ptr<gdal::Raster> m_raster;
     std::string m_rasterName;
     bool m_zeroGround;
     int32_t m_band;
+    int m_threads;
 };
 
 } // namespace pdal
@@ -35,6 +35,7 @@
 #include "HagNnFilter.hpp"
 
 #include <pdal/KDIndex.hpp>
+#include <pdal/private/Raster.hpp>
 
 #include <string>
 #include <vector>
@@ -102,6 +103,10 @@ void HagNnFilter::addArgs(ProgramArgs& args)
         "[Default: None]", m_maxDistance);
     args.add("allow_extrapolation", "If true and count > 1, allow "
         "extrapolation [Default: true].", m_allowExtrapolation, true);
+    m_resolutionArg = &args.add("resolution", "If set, grid the mean ground "
+        "elevation at this cell size and compute heights by bilinear "
+        "interpolation on the grid instead of per-point neighbor searches. "
+        "[Default: None]", m_resolution);
 }
 
 
@@ -116,6 +121,9 @@ void HagNnFilter::prepared(PointTableRef table)
     if (m_count == 0)
         throwError("Option 'count' must be a positive integer.");
 
+    if (m_resolutionArg->set() && m_resolution <= 0.0)
+        throwError("Option 'resolution' must be positive.");
+
     const PointLayoutPtr layout(table.layout());
     if (!layout->hasDim(Dimension::Id::Classification))
         throwError("Missing Classification dimension in input PointView.");
@@ -151,6 +159,12 @@ void HagNnFilter::filter(PointView& view)
         return;
     }
 
+    if (m_resolutionArg->set())
+    {
+        rasterHag(gView, ngView, gBounds);
+        return;
+    }
+
     // Build the 2D KD-tree.
     const KD2Index& kdi = gView->build2dIndex();
 
@@ -167,34 +181,138 @@ void HagNnFilter::filter(PointView& view)
         double y0 = point.getFieldAs<double>(Id::Y);
         double z0 = point.getFieldAs<double>(Id::Z);
 
-        PointIdList ids(m_count);
-        std::vector<double> sqr_dists(m_count);
-        kdi.knnSearch(x0, y0, m_count, &ids, &sqr_dists);
+        double z1 = interpGround(gView, kdi, gBounds, maxDistance2,
+            x0, y0, z0);
+        ngView->setField(Dimension::Id::HeightAboveGround, i, z0 - z1);
+    }
+}
 
-        // Closest ground point.
-        double x = gView->getFieldAs<double>(Id::X, ids[0]);
-        double y = gView->getFieldAs<double>(Id::Y, ids[0]);
-        double z = gView->getFieldAs<double>(Id::Z, ids[0]);
 
-        double z1;
-        // If the close ground point is at the same X/Y as the non-ground
-        // point, we're done.  Also, if there's only one ground point, we
-        // just use that.
-        if ((x0 == x && y0 == y) || ids.size() == 1)
+// Interpolate the ground elevation under a point from its nearest ground
+// neighbors.
+double HagNnFilter::interpGround(PointViewPtr gView, const KD2Index& kdi,
+    const BOX2D& gBounds, double maxDistance2, double x0, double y0, double z0)
+{
+    using namespace pdal::Dimension;
+
+    PointIdList ids(m_count);
+    std::vector<double> sqr_dists(m_count);
+    kdi.knnSearch(x0, y0, m_count, &ids, &sqr_dists);
+
+    // Closest ground point.
+    double x = gView->getFieldAs<double>(Id::X, ids[0]);
+    double y = gView->getFieldAs<double>(Id::Y, ids[0]);
+    double z = gView->getFieldAs<double>(Id::Z, ids[0]);
+
+    // If the close ground point is at the same X/Y as the non-ground
+    // point, we're done.  Also, if there's only one ground point, we
+    // just use that.
+    if ((x0 == x && y0 == y) || ids.size() == 1)
+        return z;
+
+    // If the non-ground point is outside the bounds of all the
+    // ground points and we're not doing extrapolation, just return
+    // its current Z, which will give a HAG of 0.
+    if (!gBounds.contains(x0, y0) && !m_allowExtrapolation)
+        return z0;
+
+    return neighbor_interp_ground(gView, ids, sqr_dists, maxDistance2, z0);
+}
+
+
+// Grid the mean ground elevation at the requested resolution and answer
+// height above ground with a bilinear lookup on the grid.  Points whose
+// surrounding cells aren't all populated fall back to the neighbor-search
+// path, so coarsening the resolution trades accuracy, not coverage.
+void HagNnFilter::rasterHag(PointViewPtr gView, PointViewPtr ngView,
+    const BOX2D& gBounds)
+{
+    using namespace pdal::Dimension;
+
+    RasterLimits limits;
+    limits.xOrigin = gBounds.minx;
+    limits.yOrigin = gBounds.miny;
+    limits.edgeLength = m_resolution;
+    limits.width = (int)std::floor(
+        (gBounds.maxx - gBounds.minx) / m_resolution) + 1;
+    limits.height = (int)std::floor(
+        (gBounds.maxy - gBounds.miny) / m_resolution) + 1;
+
+    Rasterd means(limits, 0.0);
+    Raster<int> counts(limits, 0);
+    for (PointId i = 0; i < gView->size(); ++i)
+    {
+        double x = gView->getFieldAs<double>(Id::X, i);
+        double y = gView->getFieldAs<double>(Id::Y, i);
+        double z = gView->getFieldAs<double>(Id::Z, i);
+
+        int xi = Utils::clamp(means.xCell(x), 0, limits.width - 1);
+        int yi = Utils::clamp(means.yCell(y), 0, limits.height - 1);
+        means.at(xi, yi) += z;
+        counts.at(xi, yi)++;
+    }
+    for (size_t i = 0; i < means.size(); ++i)
+        if (counts[i])
+            means[i] /= counts[i];
+
+    // The KD-tree is only built if some point's surrounding cells aren't
+    // all populated.
+    const KD2Index *kdi = nullptr;
+    double maxDistance2 = std::pow(m_maxDistance, 2.0);
+    for (PointId i = 0; i < ngView->size(); ++i)
+    {
+        PointRef point = ngView->point(i);
+
+        double x0 = point.getFieldAs<double>(Id::X);
+        double y0 = point.getFieldAs<double>(Id::Y);
+        double z0 = point.getFieldAs<double>(Id::Z);
+
+        // Position relative to the centers of the surrounding cells.
+        double gx = (x0 - limits.xOrigin) / m_resolution - .5;
+        double gy = (y0 - limits.yOrigin) / m_resolution - .5;
+        int xa = (int)std::floor(gx);
+        int ya = (int)std::floor(gy);
+        double fx = gx - xa;
+        double fy = gy - ya;
+        int xb = xa + 1;
+        int yb = ya + 1;
+
+        // Clamp to the grid, interpolating from the border cell value
+        // outward.
+        if (xa < 0)
+        {
+            xa = 0;
+            fx = 0;
+        }
+        if (xb > limits.width - 1)
+        {
+            xb = limits.width - 1;
+            fx = 1;
+        }
+        if (ya < 0)
+        {
+            ya = 0;
+            fy = 0;
+        }
+        if (yb > limits.height - 1)
         {
-            z1 = z;
+            yb = limits.height - 1;
+            fy = 1;
         }
-        // If the non-ground point is outside the bounds of all the
-        // ground points and we're not doing extrapolation, just return
-        // its current Z, which will give a HAG of 0.
-        else if (!gBounds.contains(x0, y0) && !m_allowExtrapolation)
+
+        double z1;
+        if (counts.at(xa, ya) && counts.at(xb, ya) &&
+            counts.at(xa, yb) && counts.at(xb, yb))
         {
-            z1 = z0;
+            z1 = (1 - fy) * ((1 - fx) * means.at(xa, ya) +
+                    fx * means.at(xb, ya)) +
+                fy * ((1 - fx) * means.at(xa, yb) + fx * means.at(xb, yb));
         }
         else
         {
-            z1 = neighbor_interp_ground(gView, ids, sqr_dists,
-                maxDistance2, z0);
+            if (!kdi)
+                kdi = &gView->build2dIndex();
+            z1 = interpGround(gView, *kdi, gBounds, maxDistance2, x0, y0, z0);
         }
         ngView->setField(Dimension::Id::HeightAboveGround, i, z0 - z1);
     }
@@ -35,6 +35,7 @@
 #pragma once
 
 #include <pdal/Filter.hpp>
+#include <pdal/util/Bounds.hpp>
 
 #include <cstdint>
 #include <memory>
@@ -43,6 +44,7 @@
 namespace pdal
 {
 
+class KD2Index;
 class Options;
 class PointLayout;
 class PointView;
@@ -62,9 +64,17 @@ private:
     virtual void prepared(PointTableRef table);
     virtual void filter(PointView& view);
 
+    double interpGround(PointViewPtr gView, const KD2Index& kdi,
+        const BOX2D& gBounds, double maxDistance2, double x0, double y0,
+        double z0);
+    void rasterHag(PointViewPtr gView, PointViewPtr ngView,
+        const BOX2D& gBounds);
+
     bool m_allowExtrapolation;
     double m_maxDistance;
     point_count_t m_count;
+    double m_resolution;
+    Arg *m_resolutionArg;
 };
 
 } // namespace pdal
@@ -79,6 +79,14 @@ bool HeadFilter::processOne(PointRef& point)
 
 }
 
+bool HeadFilter::saturated() const
+{
+    // Once 'count' points have passed, everything else is discarded, so
+    // the streaming executor may stop its source.  An inverted head
+    // passes the remainder of the input and never saturates.
+    return !m_invert && m_index >= m_count;
+}
+
 PointViewSet HeadFilter::run(PointViewPtr inView)
 {
     m_index = 0;
@@ -57,6 +57,7 @@ private:
 
     virtual void addArgs(ProgramArgs& args);
     virtual bool processOne(PointRef& point);
+    virtual bool saturated() const;
     virtual PointViewSet run(PointViewPtr view);
     virtual void ready(PointTableRef table);
 
@@ -38,6 +38,9 @@
 #include "private/hexer/HexIter.hpp"
 #include <pdal/Polygon.hpp>
 
+#include <thread>
+#include <unordered_map>
+
 using namespace hexer;
 
 namespace pdal
@@ -85,6 +88,8 @@ void HexBin::addArgs(ProgramArgs& args)
     args.add("smooth", "Smooth boundary output", m_doSmooth, true);
     args.add("preserve_topology", "Preserve topology when smoothing",
         m_preserve_topology, true);
+    args.add("threads", "Number of threads used to run this filter",
+        m_threads, 1);
 }
 
 
@@ -103,6 +108,12 @@ void HexBin::ready(PointTableRef table)
 
 void HexBin::filter(PointView& view)
 {
+    if (m_threads > 1)
+    {
+        binParallel(view);
+        return;
+    }
+
     PointRef p(view, 0);
     for (PointId idx = 0; idx < view.size(); ++idx)
     {
@@ -112,6 +123,68 @@ void HexBin::filter(PointView& view)
 }
 
 
+// Bin points on several threads, each accumulating partial counts in a
+// sparse hash map that's merged into the grid afterward.  Hexagon counts
+// and density marking depend only on totals, so the result matches a
+// serial run.
+void HexBin::binParallel(PointView& view)
+{
+    // Sampling for the edge length and placement of the grid origin
+    // depend on point order, so feed points serially until both are
+    // established.
+    PointRef p(view, 0);
+    PointId first = 0;
+    while (first < view.size() && !m_grid->canBin())
+    {
+        p.setPointId(first++);
+        processOne(p);
+    }
+
+    point_count_t nloops = view.size() - first;
+    int threads = (int)(std::min)((point_count_t)m_threads, nloops);
+    if (threads == 0)
+        return;
+
+    struct HexCount
+    {
+        hexer::Coord m_coord;
+        int m_count = 0;
+    };
+    std::vector<std::unordered_map<uint64_t, HexCount>> counts(threads);
+    std::vector<std::thread> threadList(threads);
+    for (int t = 0; t < threads; t++)
+    {
+        threadList[t] = std::thread([&, t]()
+        {
+            PointId start = first + t * nloops / threads;
+            PointId end = (t + 1) == threads ?
+                view.size() : first + (t + 1) * nloops / threads;
+
+            auto& partial = counts[t];
+            PointRef point(view, 0);
+            for (PointId id = start; id < end; ++id)
+            {
+                point.setPointId(id);
+                double x = point.getFieldAs<double>(Dimension::Id::X);
+                double y = point.getFieldAs<double>(Dimension::Id::Y);
+
+                hexer::Coord c = m_grid->findHexCoord(hexer::Point(x, y));
+                HexCount& hc = partial[Hexagon::key(c.m_x, c.m_y)];
+                hc.m_coord = c;
+                hc.m_count++;
+            }
+        });
+    }
+    for (auto& t : threadList)
+        t.join();
+
+    for (auto& partial : counts)
+        for (auto& cp : partial)
+            m_grid->addCount(cp.second.m_coord, cp.second.m_count);
+    m_count += nloops;
+}
+
+
 bool HexBin::processOne(PointRef& point)
 {
     double x = point.getFieldAs<double>(Dimension::Id::X);
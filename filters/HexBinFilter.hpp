@@ -72,12 +72,15 @@ private:
     bool m_doSmooth;
     point_count_t m_count;
     bool m_preserve_topology;
+    int m_threads;
 
     virtual void addArgs(ProgramArgs& args);
     virtual void ready(PointTableRef table);
     virtual void filter(PointView& view);
     virtual bool processOne(PointRef& point);
     virtual void done(PointTableRef table);
+
+    void binParallel(PointView& view);
 };
 
 } // namespace pdal
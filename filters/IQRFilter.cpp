@@ -34,6 +34,8 @@
 
 #include "IQRFilter.hpp"
 
+#include "private/Quantile.hpp"
+
 #include <string>
 #include <vector>
 
@@ -59,6 +61,8 @@ void IQRFilter::addArgs(ProgramArgs& args)
     args.add("k", "Number of deviations", m_multiplier, 1.5);
     args.add("dimension", "Dimension on which to calculate statistics",
         m_dimName);
+    args.add("approximate", "Estimate quartiles with a constant-memory "
+        "streaming sketch instead of exact selection", m_approximate);
 }
 
 void IQRFilter::prepared(PointTableRef table)
@@ -75,23 +79,32 @@ PointViewSet IQRFilter::run(PointViewPtr view)
 
     PointViewPtr output = view->makeNew();
 
-    auto quartile = [](std::vector<double> vals, double percent)
+    double pc25, pc75;
+    if (m_approximate)
     {
-        std::nth_element(vals.begin(),
-            vals.begin() + int(vals.size() * percent), vals.end());
-
-        return *(vals.begin() + int(vals.size() * percent));
-    };
-
-    std::vector<double> z(view->size());
-    for (PointId j = 0; j < view->size(); ++j)
-        z[j] = view->getFieldAs<double>(m_dimId, j);
-
+        // Streaming sketches track the quartiles without allocating a
+        // value per point.
+        Quantile::P2Estimator q25(0.25);
+        Quantile::P2Estimator q75(0.75);
+        for (PointId j = 0; j < view->size(); ++j)
+        {
+            double val = view->getFieldAs<double>(m_dimId, j);
+            q25.add(val);
+            q75.add(val);
+        }
+        pc25 = q25.value();
+        pc75 = q75.value();
+    }
+    else
+    {
+        std::vector<double> z(view->size());
+        for (PointId j = 0; j < view->size(); ++j)
+            z[j] = view->getFieldAs<double>(m_dimId, j);
 
-    double pc25 = quartile(z, 0.25);
+        pc25 = Quantile::exact(z, 0.25);
+        pc75 = Quantile::exact(z, 0.75);
+    }
     log()->get(LogLevel::Debug) << "25th percentile: " << pc25 << std::endl;
-
-    double pc75 = quartile(z, 0.75);
     log()->get(LogLevel::Debug) << "75th percentile: " << pc75 << std::endl;
 
     double iqr = pc75-pc25;
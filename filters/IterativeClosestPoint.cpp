@@ -38,9 +38,13 @@
 #include <pdal/private/MathUtils.hpp>
 #include <pdal/util/Utils.hpp>
 
+#include "private/VoxelSet.hpp"
+
 #include <Eigen/Dense>
 
+#include <cmath>
 #include <numeric>
+#include <thread>
 
 namespace pdal
 {
@@ -77,6 +81,10 @@ void IterativeClosestPoint::addArgs(ProgramArgs& args)
         &args.add("max_dist", "Maximum correspondence distance", m_maxdist);
     m_matrixArg =
         &args.add("init", "Initial transformation matrix", m_matrixStr);
+    m_cellArg = &args.add("subsample_cell", "Starting cell size for "
+        "coarse-to-fine alignment", m_cell);
+    args.add("threads", "Number of threads used to run this filter",
+        m_threads, 1);
 }
 
 void IterativeClosestPoint::prepared(PointTableRef table)
@@ -93,6 +101,10 @@ void IterativeClosestPoint::prepared(PointTableRef table)
             throwError("Expecting exactly 16 values in 'init' got " +
                 std::to_string(m_vec.size()));
     }
+    if (m_cellArg->set() && m_cell <= 0.0)
+        throwError("Option 'subsample_cell' must be positive.");
+    if (m_threads < 1)
+        throwError("Option 'threads' must be positive.");
 }
 
 PointViewSet IterativeClosestPoint::run(PointViewPtr view)
@@ -144,6 +156,142 @@ PointViewPtr IterativeClosestPoint::icp(PointViewPtr fixed,
     else
         final_transformation = Matrix4d::Identity();
 
+    // When coarse-to-fine alignment was requested, refine the initial
+    // transformation against progressively denser subsets of the moving
+    // PointView before the full-density alignment below.  Each stage leaves
+    // the transformation close enough that the next needs only a few
+    // iterations.
+    if (m_cellArg->set())
+    {
+        double cell = m_cell;
+        while (true)
+        {
+            PointViewPtr sub = subsample(tempMoving, cell);
+
+            // Once a subset holds most of the points, thinning no longer
+            // saves anything - move on to the full view.
+            if (sub->size() * 2 > tempMoving->size())
+                break;
+            log()->get(LogLevel::Debug2) << "Aligning " << sub->size() <<
+                " of " << tempMoving->size() << " points at cell size " <<
+                cell << "\n";
+            align(tempFixed, sub, final_transformation.data());
+            cell /= 4;
+        }
+    }
+
+    // Align the full-density moving PointView.
+    bool converged = align(tempFixed, tempMoving,
+        final_transformation.data());
+
+    // Apply the final_transformation to the moving PointView.
+    for (PointRef p : *moving)
+    {
+        double x = p.getFieldAs<double>(Id::X) - centroid.x();
+        double y = p.getFieldAs<double>(Id::Y) - centroid.y();
+        double z = p.getFieldAs<double>(Id::Z) - centroid.z();
+        p.setField(Id::X, x * final_transformation.coeff(0, 0) +
+                              y * final_transformation.coeff(0, 1) +
+                              z * final_transformation.coeff(0, 2) +
+                              final_transformation.coeff(0, 3) + centroid.x());
+        p.setField(Id::Y, x * final_transformation.coeff(1, 0) +
+                              y * final_transformation.coeff(1, 1) +
+                              z * final_transformation.coeff(1, 2) +
+                              final_transformation.coeff(1, 3) + centroid.y());
+        p.setField(Id::Z, x * final_transformation.coeff(2, 0) +
+                              y * final_transformation.coeff(2, 1) +
+                              z * final_transformation.coeff(2, 2) +
+                              final_transformation.coeff(2, 3) + centroid.z());
+    }
+
+
+    // Compute the MSE one last time, using the unaltered, fixed PointView and
+    // the transformed, moving PointView.
+    double mse(0.0);
+    KD3Index& kd_fixed_orig = fixed->build3dIndex();
+    for (PointRef p : *moving)
+    {
+        PointIdList indices(1);
+        std::vector<double> sqr_dists(1);
+        kd_fixed_orig.knnSearch(p, 1, &indices, &sqr_dists);
+        mse += std::sqrt(sqr_dists[0]);
+    }
+    mse /= moving->size();
+    log()->get(LogLevel::Debug2) << "MSE: " << mse << std::endl;
+
+    // Transformation to demean coords
+    Matrix4d pretrans = Matrix4d::Identity();
+    pretrans.block<3, 1>(0, 3) = -centroid;
+
+    // Transformation to return to global coords
+    Matrix4d posttrans = Matrix4d::Identity();
+    posttrans.block<3, 1>(0, 3) = centroid;
+
+    // The composed transformation is built from right to left in order of
+    // operations.
+    Matrix4d composed_transformation =
+        posttrans * final_transformation * pretrans;
+
+    // Populate metadata nodes to capture the final transformation, convergence
+    // status, and MSE.
+    Eigen::IOFormat MetadataFmt(Eigen::FullPrecision, Eigen::DontAlignCols, " ",
+                                "\n", "", "", "", "");
+    MetadataNode root = getMetadata();
+    std::stringstream ss;
+    ss << final_transformation.format(MetadataFmt);
+    root.add("transform", ss.str());
+    ss.str("");
+    ss << composed_transformation.format(MetadataFmt);
+    root.add("composed", ss.str());
+    ss.str("");
+    ss << centroid.format(MetadataFmt);
+    root.add("centroid", ss.str());
+    root.add("converged", converged);
+    root.add("fitness", mse);
+
+    return moving;
+}
+
+
+// Build a view containing one point per occupied voxel at the given cell
+// size, providing a thinned stand-in for the moving PointView during the
+// coarse alignment stages.
+PointViewPtr IterativeClosestPoint::subsample(PointViewPtr view,
+    double cell) const
+{
+    VoxelSet voxels;
+    PointIdList ids;
+
+    PointRef first = view->point(0);
+    double originX = first.getFieldAs<double>(Id::X);
+    double originY = first.getFieldAs<double>(Id::Y);
+    double originZ = first.getFieldAs<double>(Id::Z);
+    for (PointRef p : *view)
+    {
+        int xv = (int)(std::floor(
+            (p.getFieldAs<double>(Id::X) - originX) / cell));
+        int yv = (int)(std::floor(
+            (p.getFieldAs<double>(Id::Y) - originY) / cell));
+        int zv = (int)(std::floor(
+            (p.getFieldAs<double>(Id::Z) - originZ) / cell));
+        if (voxels.insert(xv, yv, zv))
+            ids.push_back(p.pointId());
+    }
+
+    PointViewPtr sub = view->makeNew();
+    sub->appendPoints(*view, ids.data(), ids.size());
+    return sub;
+}
+
+
+// Iteratively align the centered, moving PointView to the centered, fixed
+// PointView, updating the 4x4 column-major transformation in place.
+// Returns whether the iteration converged.
+bool IterativeClosestPoint::align(PointViewPtr tempFixed,
+    PointViewPtr tempMoving, double *transform) const
+{
+    Eigen::Map<Matrix4d> final_transformation(transform);
+
     // Construct 3D KD-tree of the centered, fixed PointView to facilitate
     // nearest neighbor searches in each iteration.
     KD3Index& kd_fixed = tempFixed->build3dIndex();
@@ -159,41 +307,12 @@ PointViewPtr IterativeClosestPoint::icp(PointViewPtr fixed,
         PointViewPtr tempMovingTransformed =
             math::transform(*tempMoving, final_transformation.data());
 
-        // Create empty lists to hold point correspondences, and initialize MSE
-        // to zero.
-        PointIdList fixed_idx, moving_idx;
-        fixed_idx.reserve(tempMovingTransformed->size());
-        moving_idx.reserve(tempMovingTransformed->size());
-        double mse(0.0);
-        double sqr_maxdist = m_maxdist * m_maxdist;
-
         // For every point in the centered, moving PointView, find the nearest
-        // neighbor in the centered fixed PointView. Record the indices of each
-        // and update the MSE.
-        for (PointRef p : *tempMovingTransformed)
-        {
-            // Find the index of the nearest neighbor, and the square distance
-            // between each point.
-            PointIdList indices(1);
-            std::vector<double> sqr_dists(1);
-            kd_fixed.knnSearch(p, 1, &indices, &sqr_dists);
-
-            // In the PCL code, there would've been a check that the square
-            // distance did not exceed a threshold value.
-            if (m_maxdistArg->set())
-            {
-                if (sqr_dists[0] > sqr_maxdist)
-                    continue;
-            }
-
-            // Store the indices of the correspondence and update the MSE.
-            moving_idx.push_back(p.pointId());
-            fixed_idx.push_back(indices[0]);
-            mse += std::sqrt(sqr_dists[0]);
-        }
-
-        // Finalize and log the MSE.
-        mse /= moving_idx.size();
+        // neighbor in the centered fixed PointView. Record the indices of
+        // each and compute the MSE.
+        PointIdList fixed_idx, moving_idx;
+        double mse = correspondences(kd_fixed, tempMovingTransformed,
+            fixed_idx, moving_idx);
         log()->get(LogLevel::Debug2) << "MSE: " << mse << std::endl;
 
         // Estimate rigid transformation using Umeyama method, logging the
@@ -257,72 +376,88 @@ PointViewPtr IterativeClosestPoint::icp(PointViewPtr fixed,
 
         prev_mse = mse;
     }
+    return converged;
+}
 
-    // Apply the final_transformation to the moving PointView.
-    for (PointRef p : *moving)
-    {
-        double x = p.getFieldAs<double>(Id::X) - centroid.x();
-        double y = p.getFieldAs<double>(Id::Y) - centroid.y();
-        double z = p.getFieldAs<double>(Id::Z) - centroid.z();
-        p.setField(Id::X, x * final_transformation.coeff(0, 0) +
-                              y * final_transformation.coeff(0, 1) +
-                              z * final_transformation.coeff(0, 2) +
-                              final_transformation.coeff(0, 3) + centroid.x());
-        p.setField(Id::Y, x * final_transformation.coeff(1, 0) +
-                              y * final_transformation.coeff(1, 1) +
-                              z * final_transformation.coeff(1, 2) +
-                              final_transformation.coeff(1, 3) + centroid.y());
-        p.setField(Id::Z, x * final_transformation.coeff(2, 0) +
-                              y * final_transformation.coeff(2, 1) +
-                              z * final_transformation.coeff(2, 2) +
-                              final_transformation.coeff(2, 3) + centroid.z());
-    }
 
-    // Compute the MSE one last time, using the unaltered, fixed PointView and
-    // the transformed, moving PointView.
-    double mse(0.0);
-    KD3Index& kd_fixed_orig = fixed->build3dIndex();
-    for (PointRef p : *moving)
-    {
-        PointIdList indices(1);
-        std::vector<double> sqr_dists(1);
-        kd_fixed_orig.knnSearch(p, 1, &indices, &sqr_dists);
-        mse += std::sqrt(sqr_dists[0]);
-    }
-    mse /= moving->size();
-    log()->get(LogLevel::Debug2) << "MSE: " << mse << std::endl;
+// Find the nearest fixed-view neighbor of each moving-view point, filling
+// the correspondence index lists and returning the MSE.  With more than one
+// thread the queries are chunked and the per-thread lists concatenated in
+// chunk order, so the correspondences match the serial ones.
+double IterativeClosestPoint::correspondences(const KD3Index& kd_fixed,
+    PointViewPtr moving, PointIdList& fixed_idx, PointIdList& moving_idx) const
+{
+    double sqr_maxdist = m_maxdist * m_maxdist;
+    PointId nloops = moving->size();
+    size_t threads = (std::min)((size_t)m_threads, (size_t)nloops);
 
-    // Transformation to demean coords
-    Matrix4d pretrans = Matrix4d::Identity();
-    pretrans.block<3, 1>(0, 3) = -centroid;
+    fixed_idx.reserve(nloops);
+    moving_idx.reserve(nloops);
 
-    // Transformation to return to global coords
-    Matrix4d posttrans = Matrix4d::Identity();
-    posttrans.block<3, 1>(0, 3) = centroid;
+    if (threads <= 1)
+    {
+        double mse(0.0);
+        for (PointRef p : *moving)
+        {
+            // Find the index of the nearest neighbor, and the square distance
+            // between each point.
+            PointIdList indices(1);
+            std::vector<double> sqr_dists(1);
+            kd_fixed.knnSearch(p, 1, &indices, &sqr_dists);
 
-    // The composed transformation is built from right to left in order of
-    // operations.
-    Matrix4d composed_transformation =
-        posttrans * final_transformation * pretrans;
+            // In the PCL code, there would've been a check that the square
+            // distance did not exceed a threshold value.
+            if (m_maxdistArg->set())
+            {
+                if (sqr_dists[0] > sqr_maxdist)
+                    continue;
+            }
 
-    // Populate metadata nodes to capture the final transformation, convergence
-    // status, and MSE.
-    Eigen::IOFormat MetadataFmt(Eigen::FullPrecision, Eigen::DontAlignCols, " ",
-                                "\n", "", "", "", "");
-    MetadataNode root = getMetadata();
-    std::stringstream ss;
-    ss << final_transformation.format(MetadataFmt);
-    root.add("transform", ss.str());
-    ss.str("");
-    ss << composed_transformation.format(MetadataFmt);
-    root.add("composed", ss.str());
-    ss.str("");
-    ss << centroid.format(MetadataFmt);
-    root.add("centroid", ss.str());
-    root.add("converged", converged);
-    root.add("fitness", mse);
+            // Store the indices of the correspondence and update the MSE.
+            moving_idx.push_back(p.pointId());
+            fixed_idx.push_back(indices[0]);
+            mse += std::sqrt(sqr_dists[0]);
+        }
+        return mse / moving_idx.size();
+    }
 
-    return moving;
+    std::vector<PointIdList> threadFixed(threads), threadMoving(threads);
+    std::vector<double> threadMse(threads, 0.0);
+    std::vector<std::thread> threadPool;
+    for (size_t t = 0; t < threads; ++t)
+    {
+        PointId start = t * nloops / threads;
+        PointId end = (t + 1 == threads) ? nloops : (t + 1) * nloops / threads;
+        threadPool.emplace_back(
+            [this, &kd_fixed, &moving, &threadFixed, &threadMoving,
+                &threadMse, sqr_maxdist, start, end, t]()
+            {
+                PointIdList indices(1);
+                std::vector<double> sqr_dists(1);
+                for (PointId i = start; i < end; ++i)
+                {
+                    PointRef p = moving->point(i);
+                    kd_fixed.knnSearch(p, 1, &indices, &sqr_dists);
+                    if (m_maxdistArg->set() && sqr_dists[0] > sqr_maxdist)
+                        continue;
+                    threadMoving[t].push_back(i);
+                    threadFixed[t].push_back(indices[0]);
+                    threadMse[t] += std::sqrt(sqr_dists[0]);
+                }
+            });
+    }
+
+    double mse(0.0);
+    for (size_t t = 0; t < threads; ++t)
+    {
+        threadPool[t].join();
+        moving_idx.insert(moving_idx.end(), threadMoving[t].begin(),
+            threadMoving[t].end());
+        fixed_idx.insert(fixed_idx.end(), threadFixed[t].begin(),
+            threadFixed[t].end());
+        mse += threadMse[t];
+    }
+    return mse / moving_idx.size();
 }
 
 } // namespace pdal
@@ -39,6 +39,8 @@
 namespace pdal
 {
 
+class KD3Index;
+
 class PDAL_DLL IterativeClosestPoint : public Filter
 {
 public:
@@ -50,6 +52,7 @@ public:
 private:
     int m_max_iters;
     int m_max_similar;
+    int m_threads;
     double m_rotation_threshold;
     double m_translation_threshold;
     double m_mse_abs;
@@ -58,12 +61,19 @@ private:
     Arg *m_matrixArg;
     std::string m_matrixStr;
     std::vector<double> m_vec;
+    Arg *m_cellArg;
+    double m_cell;
 
     virtual void addArgs(ProgramArgs& args);
     virtual void prepared(PointTableRef table);
     virtual PointViewSet run(PointViewPtr view);
     virtual void done(PointTableRef _);
     PointViewPtr icp(PointViewPtr fixed, PointViewPtr moving) const;
+    PointViewPtr subsample(PointViewPtr view, double cell) const;
+    bool align(PointViewPtr tempFixed, PointViewPtr tempMoving,
+        double *transform) const;
+    double correspondences(const KD3Index& kd_fixed, PointViewPtr moving,
+        PointIdList& fixed_idx, PointIdList& moving_idx) const;
 
     PointViewPtr m_fixed;
     bool m_complete;
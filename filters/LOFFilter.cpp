@@ -82,22 +82,17 @@ void LOFFilter::filter(PointView& view)
     // The k-distance is the Euclidean distance to k-th nearest neighbor.
     log()->get(LogLevel::Debug) << "Computing k-distances...\n";
 
-    typedef std::pair<PointId, size_t> PointIdKPair;
-    typedef std::pair<PointId, double> PointIdDistPair;
-    typedef std::map<PointIdKPair, PointIdDistPair> AdjacencyMap;
-    AdjacencyMap mat;
+    // Query the neighborhood of every point up front; the queries run
+    // across a thread pool and the flat arenas are shared by the passes
+    // below.
+    PointIdList neighbors;
+    std::vector<double> sqr_dists;
+    const point_count_t k =
+        index.knnSearchAll(m_minpts, neighbors, sqr_dists);
 
     for (PointId i = 0; i < view.size(); ++i)
-    {
-        PointIdList indices(m_minpts);
-        std::vector<double> sqr_dists(m_minpts);
-        index.knnSearch(i, m_minpts, &indices, &sqr_dists);
-
-        for (size_t j = 0; j < m_minpts; ++j)
-            mat[std::make_pair(i, j)] = std::make_pair(indices[j], std::sqrt(sqr_dists[j]));
-
-        view.setField(Id::NNDistance, i, std::sqrt(sqr_dists[m_minpts - 1]));
-    }
+        view.setField(Id::NNDistance, i,
+            std::sqrt(sqr_dists[(size_t)i * k + k - 1]));
 
     // Second pass: Compute the local reachability distance for each point.
     // For each neighbor point, the reachability distance is the maximum value
@@ -109,11 +104,12 @@ void LOFFilter::filter(PointView& view)
     {
         double M1 = 0.0;
         point_count_t n = 0;
-        for (size_t j = 0; j < m_minpts; ++j)
+        for (size_t j = 0; j < k; ++j)
         {
-            auto val = mat[std::make_pair(i, j)];
-            double k = view.getFieldAs<double>(Id::NNDistance, val.first);
-            double reachdist = (std::max)(k, val.second);
+            PointId nbr = neighbors[(size_t)i * k + j];
+            double dist = std::sqrt(sqr_dists[(size_t)i * k + j]);
+            double kdist = view.getFieldAs<double>(Id::NNDistance, nbr);
+            double reachdist = (std::max)(kdist, dist);
             M1 += (reachdist - M1) / ++n;
         }
         view.setField(Id::LocalReachabilityDistance, i, 1.0 / M1);
@@ -127,10 +123,9 @@ void LOFFilter::filter(PointView& view)
         double lrdp = view.getFieldAs<double>(Id::LocalReachabilityDistance, i);
         double M1 = 0.0;
         point_count_t n = 0;
-        for (size_t j = 0; j < m_minpts; ++j)
+        for (size_t j = 0; j < k; ++j)
         {
-            auto val = mat[std::make_pair(i, j)];
-            PointRef p = view.point(val.first);
+            PointRef p = view.point(neighbors[(size_t)i * k + j]);
             double ratio =
                 p.getFieldAs<double>(Id::LocalReachabilityDistance) / lrdp;
             M1 += (ratio - M1) / ++n;
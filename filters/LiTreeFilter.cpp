@@ -39,7 +39,9 @@
 #include "LiTreeFilter.hpp"
 
 #include <pdal/KDIndex.hpp>
+#include <pdal/util/ThreadPool.hpp>
 
+#include <algorithm>
 #include <numeric>
 
 namespace pdal
@@ -66,6 +68,8 @@ void LiTreeFilter::addArgs(ProgramArgs& args)
              3.0);
     args.add("radius", "Dummy point located outside this approximate radius",
              m_dummyRadius, 100.0);
+    args.add("threads", "Number of threads used to run this filter", m_threads,
+             1);
 }
 
 void LiTreeFilter::addDimensions(PointLayoutPtr layout)
@@ -125,10 +129,13 @@ void LiTreeFilter::computeLocalMax(PointView& view)
 
     // Each point in the view will be marked as a local max or not.
     m_localMax.resize(view.size());
-    for (PointRef p : view)
+
+    auto testPoint = [this, &view, &kdi](PointId i)
     {
+        PointRef p = view.point(i);
+
         // Points are assumed to be locally maximal.
-        m_localMax[p.pointId()] = 1;
+        m_localMax[i] = 1;
 
         // Test this assumption considering neighbors within radius of 2m.
         PointIdList neighbors = kdi.radius(p, 2.0);
@@ -142,11 +149,34 @@ void LiTreeFilter::computeLocalMax(PointView& view)
             // iterating.
             if (hag_n > hag_p)
             {
-                m_localMax[p.pointId()] = 0;
+                m_localMax[i] = 0;
                 break;
             }
         }
+    };
+
+    // Points are tested independently against a read-only index, so the
+    // radius searches can be spread across threads.
+    const point_count_t numPts = view.size();
+    const size_t threads = (size_t)(std::min)(
+        (point_count_t)(std::max)(m_threads, 1), numPts);
+    if (threads <= 1)
+    {
+        for (PointId i = 0; i < numPts; ++i)
+            testPoint(i);
+        return;
     }
+
+    ThreadPool pool(threads);
+    auto chunkStart = [numPts, threads](size_t t)
+        { return t * numPts / threads; };
+    for (size_t t = 0; t < threads; ++t)
+        pool.add([&testPoint, &chunkStart, t]()
+        {
+            for (PointId i = chunkStart(t); i < chunkStart(t + 1); ++i)
+                testPoint(i);
+        });
+    pool.await();
 }
 
 void LiTreeFilter::classifyPoint(PointId ui, PointView& view, PointIdList& Ni,
@@ -53,6 +53,7 @@ private:
     point_count_t m_minSize;
     double m_minHag;
     double m_dummyRadius;
+    int m_threads;
 
     virtual void addArgs(ProgramArgs& args);
     virtual void addDimensions(PointLayoutPtr layout);
@@ -36,7 +36,14 @@
 
 #include "private/Segmentation.hpp"
 
-#include <pdal/KDIndex.hpp>
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <vector>
 
 namespace pdal
 {
@@ -64,6 +71,13 @@ void LloydKMeansFilter::addArgs(ProgramArgs& args)
              {"X", "Y", "Z"});
     args.add("maxiters", "Maximum number of iterations", m_maxiters,
              static_cast<uint16_t>(10));
+    args.add("batch_size", "Number of points sampled per iteration "
+             "(0 uses all points)", m_batchSize, point_count_t(0));
+    args.add("tolerance", "Stop iterating when no cluster center moves "
+             "farther than this distance", m_tolerance, 0.0);
+    args.add("threads", "Number of threads used to run this filter",
+             m_threads, 1);
+    m_seedArg = &args.add("seed", "Random number generator seed", m_seed);
 }
 
 void LloydKMeansFilter::addDimensions(PointLayoutPtr layout)
@@ -94,72 +108,157 @@ void LloydKMeansFilter::filter(PointView& view)
     if (!view.size() || (view.size() < m_k))
         return;
 
+    size_t ndims = m_dimIdList.size();
+    point_count_t n = view.size();
+
+    // Pack the clustering dimensions so the assignment loops below stream
+    // over contiguous doubles and vectorize.
+    std::vector<double> data(n * ndims);
+    for (PointId i = 0; i < n; ++i)
+        for (size_t d = 0; d < ndims; ++d)
+            data[i * ndims + d] = view.getFieldAs<double>(m_dimIdList[d], i);
+
     // come up with k random samples for initial cluster centers (based on
     // spatial farthest point sampling)
-    PointIdList ids = Segmentation::farthestPointSampling(view, m_k);
-
-    // setup table with at least XYZ as required by KDIndex, plus any
-    // additional dimensions as specified via filter options
-    ColumnPointTable table;
-    table.layout()->registerDims({Id::X, Id::Y, Id::Z});
-    table.layout()->registerDims(m_dimIdList);
-    table.finalize();
-
-    // create view of initial cluster centers
-    PointViewPtr centers(new PointView(table));
-    PointId i(0);
-    for (auto const& id : ids)
+    PointIdList seeds = Segmentation::farthestPointSampling(view, m_k);
+    std::vector<double> centers(m_k * ndims);
+    for (uint16_t c = 0; c < m_k; ++c)
+        for (size_t d = 0; d < ndims; ++d)
+            centers[c * ndims + d] = data[seeds[c] * ndims + d];
+
+    auto nearest = [&](const double *pt)
     {
-        centers->setField(Id::X, i, view.getFieldAs<double>(Id::X, id));
-        centers->setField(Id::Y, i, view.getFieldAs<double>(Id::Y, id));
-        centers->setField(Id::Z, i, view.getFieldAs<double>(Id::Z, id));
-        for (auto const& dimid : m_dimIdList)
+        uint16_t best = 0;
+        double bestDist = (std::numeric_limits<double>::max)();
+        for (uint16_t c = 0; c < m_k; ++c)
         {
-            centers->setField(dimid, i, view.getFieldAs<double>(dimid, id));
+            const double *center = centers.data() + c * ndims;
+            double dist = 0.0;
+            for (size_t d = 0; d < ndims; ++d)
+            {
+                double delta = pt[d] - center[d];
+                dist += delta * delta;
+            }
+            if (dist < bestDist)
+            {
+                bestDist = dist;
+                best = c;
+            }
         }
-        i++;
-    }
+        return best;
+    };
 
-    // construct KDFlexIndex for nearest neighbor search
-    KDFlexIndex kdi(*centers, m_dimIdList);
-    kdi.build();
+    // Assign a list of points to their nearest centers, accumulating
+    // per-cluster sums and counts.  Each thread folds a partial sum so the
+    // only shared work is the merge under the lock.
+    size_t nthreads = Utils::clamp((size_t)m_threads, (size_t)1, (size_t)n);
+    std::vector<double> sums(m_k * ndims);
+    std::vector<point_count_t> counts(m_k);
+    auto accumulate = [&](const PointIdList& batch)
+    {
+        std::fill(sums.begin(), sums.end(), 0.0);
+        std::fill(counts.begin(), counts.end(), 0);
+        std::mutex mutex;
+        std::vector<std::thread> pool;
+        for (size_t t = 0; t < nthreads; ++t)
+        {
+            size_t start = t * batch.size() / nthreads;
+            size_t end = (t + 1) * batch.size() / nthreads;
+            pool.emplace_back([&, start, end]()
+            {
+                std::vector<double> s(m_k * ndims, 0.0);
+                std::vector<point_count_t> cnt(m_k, 0);
+                for (size_t i = start; i < end; ++i)
+                {
+                    const double *pt = data.data() + batch[i] * ndims;
+                    uint16_t q = nearest(pt);
+                    cnt[q]++;
+                    for (size_t d = 0; d < ndims; ++d)
+                        s[q * ndims + d] += pt[d];
+                }
+                std::lock_guard<std::mutex> lock(mutex);
+                for (size_t j = 0; j < s.size(); ++j)
+                    sums[j] += s[j];
+                for (uint16_t q = 0; q < m_k; ++q)
+                    counts[q] += cnt[q];
+            });
+        }
+        for (auto& t : pool)
+            t.join();
+    };
+
+    point_count_t batchSize(0);
+    if (m_batchSize)
+        batchSize = Utils::clamp(m_batchSize, (point_count_t)m_k, n);
+    if (!m_seedArg->set())
+        m_seed = (unsigned)
+            std::chrono::system_clock::now().time_since_epoch().count();
+    std::mt19937 rng(m_seed);
+    std::uniform_int_distribution<PointId> pick(0, n - 1);
+
+    PointIdList batch;
+    if (!batchSize)
+    {
+        batch.resize(n);
+        std::iota(batch.begin(), batch.end(), 0);
+    }
+    else
+        batch.resize(batchSize);
 
     // update cluster centers through specified number of iterations
+    std::vector<point_count_t> seen(m_k, 0);
+    double sqrTolerance = m_tolerance * m_tolerance;
     for (int iter = 0; iter < m_maxiters; ++iter)
     {
-        // initialize mean and count for each cluster
-        std::vector<std::vector<double>> M1(m_dimIdList.size(),
-                                            std::vector<double>(m_k, 0.0));
-        std::vector<point_count_t> cnt(m_k, 0);
+        if (batchSize)
+            for (point_count_t i = 0; i < batchSize; ++i)
+                batch[i] = pick(rng);
+        accumulate(batch);
 
-        // for every point, find closest cluster center and assign ClusterID
-        for (PointRef p : view)
+        // Move each center toward the mean of its assigned points - all
+        // the way for full batches, with a per-cluster learning rate of
+        // batch count over cumulative count for mini-batches.  Empty
+        // clusters keep their centers.
+        double moved = 0.0;
+        for (uint16_t c = 0; c < m_k; ++c)
         {
-            PointId q = kdi.neighbor(p);
-            p.setField(Id::ClusterID, q);
-
-            // update cluster size and mean
-            cnt[q]++;
-            point_count_t n(cnt[q]);
-            for (size_t i = 0; i < m_dimIdList.size(); ++i)
+            if (!counts[c])
+                continue;
+            seen[c] += counts[c];
+            double eta = batchSize ? (double)counts[c] / seen[c] : 1.0;
+            double *center = centers.data() + c * ndims;
+            double shift = 0.0;
+            for (size_t d = 0; d < ndims; ++d)
             {
-                double delta = p.getFieldAs<double>(m_dimIdList[i]) - M1[i][q];
-                double delta_n = delta / n;
-                M1[i][q] += delta_n;
+                double delta =
+                    eta * (sums[c * ndims + d] / counts[c] - center[d]);
+                center[d] += delta;
+                shift += delta * delta;
             }
+            moved = (std::max)(moved, shift);
         }
 
-        // adjust clusters based on newly added points
-        for (PointId id = 0; id < m_k; ++id)
+        // With the default tolerance of zero this exits once the centers
+        // stop moving entirely.
+        if (moved <= sqrTolerance)
+            break;
+    }
+
+    // label every point with its final cluster
+    std::vector<std::thread> pool;
+    for (size_t t = 0; t < nthreads; ++t)
+    {
+        PointId start = t * n / nthreads;
+        PointId end = (t + 1) * n / nthreads;
+        pool.emplace_back([&, start, end]()
         {
-            for (size_t i = 0; i < m_dimIdList.size(); ++i)
-            {
-                centers->setField(m_dimIdList[i], id, M1[i][id]);
-            }
-        }
-        centers->invalidateProducts();
-        centers->build3dIndex();
+            for (PointId i = start; i < end; ++i)
+                view.setField(Id::ClusterID, i,
+                    nearest(data.data() + i * ndims));
+        });
     }
+    for (auto& t : pool)
+        t.join();
 }
 
 } // namespace pdal
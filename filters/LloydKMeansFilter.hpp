@@ -56,6 +56,11 @@ public:
 private:
     uint16_t m_k;
     uint16_t m_maxiters;
+    point_count_t m_batchSize;
+    double m_tolerance;
+    int m_threads;
+    Arg* m_seedArg;
+    unsigned m_seed;
     StringList m_dimStringList;
     Dimension::IdList m_dimIdList;
 
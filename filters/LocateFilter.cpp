@@ -35,8 +35,13 @@
 #include "LocateFilter.hpp"
 
 #include <pdal/util/ProgramArgs.hpp>
+#include <pdal/util/ThreadPool.hpp>
 #include <pdal/util/Utils.hpp>
 
+#include <algorithm>
+#include <limits>
+#include <vector>
+
 namespace pdal
 {
 
@@ -56,50 +61,121 @@ std::string LocateFilter::getName() const
 
 void LocateFilter::addArgs(ProgramArgs& args)
 {
-    args.add("dimension", "Dimension in which to locate max", m_dimName);
+    args.add("dimension", "Dimension(s) in which to locate max", m_dimNames);
     args.add("minmax", "Whether to search for the minimum or maximum value",
         m_minmax, "max");
+    args.add("threads", "Number of threads used to run this filter",
+        m_threads, 1);
 }
 
 void LocateFilter::prepared(PointTableRef table)
 {
     PointLayoutPtr layout(table.layout());
-    m_dimId = layout->findDim(m_dimName);
-    if (m_dimId == Dimension::Id::Unknown)
-        throwError("Invalid dimension '" + m_dimName + "'.");
+    for (const std::string& name : m_dimNames)
+    {
+        Dimension::Id id = layout->findDim(name);
+        if (id == Dimension::Id::Unknown)
+            throwError("Invalid dimension '" + name + "'.");
+        m_dimIds.push_back(id);
+    }
+    if (m_dimIds.empty())
+        throwError("No 'dimension' option specified.");
 }
 
+namespace
+{
+
+struct Extreme
+{
+    double minval = (std::numeric_limits<double>::max)();
+    PointId minidx = 0;
+    double maxval = std::numeric_limits<double>::lowest();
+    PointId maxidx = 0;
+};
+
+} // unnamed namespace
+
 PointViewSet LocateFilter::run(PointViewPtr inView)
 {
     PointViewSet viewSet;
     if (!inView->size())
         return viewSet;
 
-    PointId minidx, maxidx;
-    double minval = (std::numeric_limits<double>::max)();
-    double maxval = std::numeric_limits<double>::lowest();
+    point_count_t numPts = inView->size();
+    size_t numDims = m_dimIds.size();
+    size_t threads = (size_t)(std::min)(
+        (point_count_t)(std::max)(m_threads, 1), numPts);
+    auto chunkStart = [numPts, threads](size_t t)
+        { return (PointId)(t * numPts / threads); };
 
-    for (PointId idx = 0; idx < inView->size(); idx++)
+    // Strict comparisons keep the first occurrence within a chunk, and
+    // merging the partials in ascending chunk order keeps the first
+    // occurrence overall, matching the serial scan.
+    auto scan = [this, &inView, numDims](PointId begin, PointId end,
+        std::vector<Extreme>& extremes)
     {
-        double val = inView->getFieldAs<double>(m_dimId, idx);
-        if (val > maxval)
+        for (PointId idx = begin; idx < end; idx++)
         {
-            maxval = val;
-            maxidx = idx;
+            for (size_t d = 0; d < numDims; ++d)
+            {
+                double val = inView->getFieldAs<double>(m_dimIds[d], idx);
+                Extreme& e = extremes[d];
+                if (val > e.maxval)
+                {
+                    e.maxval = val;
+                    e.maxidx = idx;
+                }
+                if (val < e.minval)
+                {
+                    e.minval = val;
+                    e.minidx = idx;
+                }
+            }
         }
-        if (val < minval)
+    };
+
+    std::vector<Extreme> extremes(numDims);
+    if (threads <= 1)
+        scan(0, numPts, extremes);
+    else
+    {
+        std::vector<std::vector<Extreme>> partials(threads,
+            std::vector<Extreme>(numDims));
+        ThreadPool pool(threads);
+        for (size_t t = 0; t < threads; ++t)
+            pool.add([&scan, &partials, &chunkStart, t]()
+                { scan(chunkStart(t), chunkStart(t + 1), partials[t]); });
+        pool.await();
+
+        for (size_t t = 0; t < threads; ++t)
         {
-            minval = val;
-            minidx = idx;
+            for (size_t d = 0; d < numDims; ++d)
+            {
+                const Extreme& p = partials[t][d];
+                Extreme& e = extremes[d];
+                if (p.maxval > e.maxval)
+                {
+                    e.maxval = p.maxval;
+                    e.maxidx = p.maxidx;
+                }
+                if (p.minval < e.minval)
+                {
+                    e.minval = p.minval;
+                    e.minidx = p.minidx;
+                }
+            }
         }
     }
 
     PointViewPtr outView = inView->makeNew();
 
-    if (Utils::iequals("min", m_minmax))
-        outView->appendPoint(*inView.get(), minidx);
-    if (Utils::iequals("max", m_minmax))
-        outView->appendPoint(*inView.get(), maxidx);
+    for (const Extreme& e : extremes)
+    {
+        if (Utils::iequals("min", m_minmax))
+            outView->appendPoint(*inView.get(), e.minidx);
+        if (Utils::iequals("max", m_minmax))
+            outView->appendPoint(*inView.get(), e.maxidx);
+    }
 
     viewSet.insert(outView);
     return viewSet;
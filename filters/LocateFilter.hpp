@@ -54,9 +54,10 @@ public:
     std::string getName() const;
 
 private:
-    std::string m_dimName;
-    Dimension::Id m_dimId;
+    StringList m_dimNames;
+    Dimension::IdList m_dimIds;
     std::string m_minmax;
+    int m_threads;
 
     virtual void addArgs(ProgramArgs& args);
     virtual void prepared(PointTableRef table);
@@ -34,6 +34,8 @@
 
 #include "MADFilter.hpp"
 
+#include "private/Quantile.hpp"
+
 #include <string>
 #include <vector>
 
@@ -60,6 +62,8 @@ void MADFilter::addArgs(ProgramArgs& args)
     args.add("dimension", "Dimension on which to calculate statistics",
         m_dimName);
     args.add("mad_multiplier", "MAD threshold multiplier", m_madMultiplier, 1.4862);
+    args.add("approximate", "Estimate medians with a constant-memory "
+        "streaming sketch instead of exact selection", m_approximate);
 }
 
 void MADFilter::prepared(PointTableRef table)
@@ -76,28 +80,43 @@ PointViewSet MADFilter::run(PointViewPtr view)
 
     PointViewPtr output = view->makeNew();
 
-    auto estimate_median = [](std::vector<double> vals)
+    double median, mad;
+    if (m_approximate)
     {
-        std::nth_element(vals.begin(), vals.begin()+vals.size()/2, vals.end());
-        return *(vals.begin()+vals.size()/2);
-    };
-
-    std::vector<double> z(view->size());
-    for (PointId j = 0; j < view->size(); ++j)
-        z[j] = view->getFieldAs<double>(m_dimId, j);
-
-    double median = estimate_median(z);
+        // Streaming sketches track the two medians without allocating a
+        // value per point; the deviation median needs a second pass since
+        // it depends on the first result.
+        Quantile::P2Estimator med(0.5);
+        for (PointId j = 0; j < view->size(); ++j)
+            med.add(view->getFieldAs<double>(m_dimId, j));
+        median = med.value();
+
+        Quantile::P2Estimator dev(0.5);
+        for (PointId j = 0; j < view->size(); ++j)
+            dev.add(std::fabs(view->getFieldAs<double>(m_dimId, j) - median));
+        mad = dev.value() * m_madMultiplier;
+    }
+    else
+    {
+        std::vector<double> z(view->size());
+        for (PointId j = 0; j < view->size(); ++j)
+            z[j] = view->getFieldAs<double>(m_dimId, j);
+
+        // Selection reorders z, but the deviations depend only on the
+        // values, so the reordered vector feeds the second selection.
+        median = Quantile::exact(z, 0.5);
+        std::transform(z.begin(), z.end(), z.begin(),
+           [median](double v) { return std::fabs(v - median); });
+        mad = Quantile::exact(z, 0.5) * m_madMultiplier;
+    }
     log()->get(LogLevel::Debug) << getName() <<
         " estimated median value: " << median << std::endl;
-
-    std::transform(z.begin(), z.end(), z.begin(),
-       [median](double v) { return std::fabs(v - median); });
-    double mad = estimate_median(z)*m_madMultiplier;
     log()->get(LogLevel::Debug) << getName() << " mad " << mad << std::endl;
 
     for (PointId j = 0; j < view->size(); ++j)
     {
-        if (z[j]/mad < m_multiplier)
+        double dev = std::fabs(view->getFieldAs<double>(m_dimId, j) - median);
+        if (dev/mad < m_multiplier)
             output->appendPoint(*view, j);
     }
 
@@ -54,6 +54,7 @@ public:
 
 private:
     double m_multiplier;
+    bool m_approximate;
     std::string m_dimName;
     Dimension::Id m_dimId;
     double m_madMultiplier;
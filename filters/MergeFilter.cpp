@@ -34,6 +34,8 @@
 
 #include "MergeFilter.hpp"
 
+#include <algorithm>
+
 namespace pdal
 {
 
@@ -48,6 +50,35 @@ CREATE_STATIC_STAGE(MergeFilter, s_info)
 
 std::string MergeFilter::getName() const { return s_info.name; }
 
+void MergeFilter::addArgs(ProgramArgs& args)
+{
+    args.add("sort_dimension", "Dimension on which the input views are "
+        "already sorted.  When set, the inputs are k-way merged so the "
+        "output stays ordered.", m_sortDimName);
+}
+
+
+void MergeFilter::prepared(PointTableRef table)
+{
+    if (m_sortDimName.empty())
+        return;
+    m_sortDim = table.layout()->findDim(m_sortDimName);
+    if (m_sortDim == Dimension::Id::Unknown)
+        throwError("Dimension '" + m_sortDimName + "' not found.");
+}
+
+
+bool MergeFilter::processOne(PointRef& point)
+{
+    // In stream mode upstream stages execute one after another, so
+    // there's no way to interleave their points.
+    if (m_sortDim != Dimension::Id::Unknown)
+        throwError("Option 'sort_dimension' isn't supported in stream "
+            "mode.");
+    return true;
+}
+
+
 void MergeFilter::ready(PointTableRef table)
 {
     SpatialReference srs = getSpatialReference();
@@ -68,10 +99,61 @@ PointViewSet MergeFilter::run(PointViewPtr in)
       (in->spatialReference() != m_view->spatialReference()))
         log()->get(LogLevel::Warning) << getName() << ": merging points "
             "with inconsistent spatial references." << std::endl;
-    m_view->append(*in.get());
+    // In merge-sort mode the inputs are held until done(), when all of
+    // them are known; otherwise they're concatenated as they arrive.
+    if (m_sortDim != Dimension::Id::Unknown)
+        m_inViews.push_back(in);
+    else
+        m_view->append(*in.get());
     viewSet.insert(m_view);
     return viewSet;
 }
 
+
+void MergeFilter::done(PointTableRef)
+{
+    if (m_sortDim == Dimension::Id::Unknown || m_inViews.empty())
+        return;
+
+    // K-way merge of the sorted inputs.  A binary heap keyed on each
+    // input's next value pulls the smallest across inputs; the output
+    // grows by shared point references, so the only extra storage is
+    // the heap itself.
+    struct Source
+    {
+        PointViewPtr m_view;
+        PointId m_pos;
+        double m_val;
+    };
+    auto greater = [](const Source& a, const Source& b)
+        { return a.m_val > b.m_val; };
+
+    point_count_t total = 0;
+    for (PointViewPtr& v : m_inViews)
+        total += v->size();
+    m_view->reserve(total);
+
+    std::vector<Source> heap;
+    for (PointViewPtr& v : m_inViews)
+        if (v->size())
+            heap.push_back({v, 0, v->getFieldAs<double>(m_sortDim, 0)});
+    std::make_heap(heap.begin(), heap.end(), greater);
+
+    while (heap.size())
+    {
+        std::pop_heap(heap.begin(), heap.end(), greater);
+        Source& s = heap.back();
+        m_view->appendPoint(*s.m_view, s.m_pos);
+        if (++s.m_pos < s.m_view->size())
+        {
+            s.m_val = s.m_view->getFieldAs<double>(m_sortDim, s.m_pos);
+            std::push_heap(heap.begin(), heap.end(), greater);
+        }
+        else
+            heap.pop_back();
+    }
+    m_inViews.clear();
+}
+
 } // namespace pdal
 
@@ -34,6 +34,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include <pdal/Filter.hpp>
 #include <pdal/Streamable.hpp>
 
@@ -49,12 +51,17 @@ public:
     std::string getName() const;
 
 private:
+    std::string m_sortDimName;
+    Dimension::Id m_sortDim = Dimension::Id::Unknown;
     PointViewPtr m_view;
+    std::vector<PointViewPtr> m_inViews;
 
+    virtual void addArgs(ProgramArgs& args);
+    virtual void prepared(PointTableRef table);
     virtual void ready(PointTableRef table);
-    virtual bool processOne(PointRef& point)
-        { return true; }
+    virtual bool processOne(PointRef& point);
     virtual PointViewSet run(PointViewPtr in);
+    virtual void done(PointTableRef table);
 
     MergeFilter& operator=(const MergeFilter&); // not implemented
     MergeFilter(const MergeFilter&); // not implemented
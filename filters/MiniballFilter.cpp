@@ -41,12 +41,13 @@
 
 #include <pdal/KDIndex.hpp>
 #include <pdal/util/ProgramArgs.hpp>
+#include <pdal/util/ThreadPool.hpp>
 
 #include "private/miniball/Seb.h"
 
+#include <array>
 #include <cmath>
 #include <string>
-#include <thread>
 #include <vector>
 
 namespace pdal
@@ -81,68 +82,83 @@ void MiniballFilter::addDimensions(PointLayoutPtr layout)
 }
 
 void MiniballFilter::filter(PointView& view)
-{
-    point_count_t nloops = view.size();
-    std::vector<std::thread> threadList(m_threads);
-    for (int t = 0; t < m_threads; t++)
-    {
-        threadList[t] = std::thread(std::bind(
-            [&](const PointId start, const PointId end) {
-                for (PointId i = start; i < end; i++)
-                    setMiniball(view, i);
-            },
-            t * nloops / m_threads,
-            (t + 1) == m_threads ? nloops : (t + 1) * nloops / m_threads));
-    }
-    for (auto& t : threadList)
-        t.join();
-}
-
-void MiniballFilter::setMiniball(PointView& view, const PointId& i)
 {
     typedef double FT;
     typedef Seb::Point<FT> Point;
     typedef std::vector<Point> PointVector;
     typedef Seb::Smallest_enclosing_ball<FT> Miniball;
 
-    double X = view.getFieldAs<double>(Dimension::Id::X, i);
-    double Y = view.getFieldAs<double>(Dimension::Id::Y, i);
-    double Z = view.getFieldAs<double>(Dimension::Id::Z, i);
-
-    // Find k-nearest neighbors of i.
-    const KD3Index& kdi = view.build3dIndex();
-    PointIdList ni = kdi.neighbors(i, m_knn + 1);
-
-    PointVector S;
-    std::vector<double> coords(3);
-    for (PointId const& j : ni)
+    point_count_t numPts = view.size();
+    if (!numPts)
+        return;
+    size_t threads = (size_t)(std::min)(
+        (point_count_t)(std::max)(m_threads, 1), numPts);
+
+    // All neighborhoods come from one bulk query into a flat arena;
+    // the workers then read their slices instead of querying per point.
+    KD3Index& kdi = view.build3dIndex();
+    PointIdList nbrs;
+    std::vector<double> sqrDists;
+    point_count_t k = kdi.knnSearchAll(m_knn + 1, nbrs, sqrDists, threads);
+
+    auto chunkStart = [numPts, threads](size_t t)
+        { return (PointId)(t * numPts / threads); };
+    auto miniballs = [&](size_t t)
     {
-        if (j == i)
-            continue;
-        coords[0] = view.getFieldAs<double>(Dimension::Id::X, j);
-        coords[1] = view.getFieldAs<double>(Dimension::Id::Y, j);
-        coords[2] = view.getFieldAs<double>(Dimension::Id::Z, j);
-        S.push_back(Point(3, coords.begin()));
+        // The coordinate staging buffer and the working set are allocated
+        // once per worker and reused across points.
+        std::array<double, 3> coords;
+        PointVector S;
+        S.reserve(k);
+        for (PointId i = chunkStart(t); i < chunkStart(t + 1); ++i)
+        {
+            double X = view.getFieldAs<double>(Dimension::Id::X, i);
+            double Y = view.getFieldAs<double>(Dimension::Id::Y, i);
+            double Z = view.getFieldAs<double>(Dimension::Id::Z, i);
+
+            S.clear();
+            const PointId *ni = nbrs.data() + (size_t)i * k;
+            for (point_count_t n = 0; n < k; ++n)
+            {
+                PointId j = ni[n];
+                if (j == i)
+                    continue;
+                coords[0] = view.getFieldAs<double>(Dimension::Id::X, j);
+                coords[1] = view.getFieldAs<double>(Dimension::Id::Y, j);
+                coords[2] = view.getFieldAs<double>(Dimension::Id::Z, j);
+                S.push_back(Point(3, coords.begin()));
+            }
+
+            // add neighbors to Miniball mb(3, S)
+            Miniball mb(3, S);
+
+            // obtain radius r = mb.radius();
+            FT radius = mb.radius();
+
+            // obtain center = mb.center_begin()
+            Miniball::Coordinate_iterator center_it = mb.center_begin();
+            double x = center_it[0];
+            double y = center_it[1];
+            double z = center_it[2];
+
+            // compute distance d from p to center
+            double d = std::sqrt((X - x) * (X - x) + (Y - y) * (Y - y) +
+                (Z - z) * (Z - z));
+
+            double miniball = d / (d + 2 * radius / (std::sqrt(3)));
+            view.setField(Id::Miniball, i, miniball);
+        }
+    };
+
+    if (threads <= 1)
+        miniballs(0);
+    else
+    {
+        ThreadPool pool(threads);
+        for (size_t t = 0; t < threads; ++t)
+            pool.add([&miniballs, t]() { miniballs(t); });
+        pool.await();
     }
-
-    // add neighbors to Miniball mb(3, S)
-    Miniball mb(3, S);
-
-    // obtain radius r = mb.radius();
-    FT radius = mb.radius();
-
-    // obtain center = mb.center_begin()
-    Miniball::Coordinate_iterator center_it = mb.center_begin();
-    double x = center_it[0];
-    double y = center_it[1];
-    double z = center_it[2];
-
-    // compute distance d from p to center
-    double d =
-        std::sqrt((X - x) * (X - x) + (Y - y) * (Y - y) + (Z - z) * (Z - z));
-
-    double miniball = d / (d + 2 * radius / (std::sqrt(3)));
-    view.setField(Id::Miniball, i, miniball);
 }
 
 } // namespace pdal
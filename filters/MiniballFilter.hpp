@@ -58,8 +58,6 @@ private:
     virtual void addArgs(ProgramArgs& args);
     virtual void addDimensions(PointLayoutPtr layout);
     virtual void filter(PointView& view);
-
-    void setMiniball(PointView& view, const PointId& i);
 };
 
 } // namespace pdal
@@ -33,10 +33,16 @@
 
 #include "MortonOrderFilter.hpp"
 
-#include <climits>
-#include <iostream>
+#include <array>
+#include <cmath>
+#include <cstdint>
 #include <limits>
-#include <map>
+#include <thread>
+#include <vector>
+
+#include <pdal/util/ThreadPool.hpp>
+
+#include "private/ParallelSort.hpp"
 
 namespace pdal
 {
@@ -56,42 +62,36 @@ std::string MortonOrderFilter::getName() const { return s_info.name; }
 void MortonOrderFilter::addArgs(ProgramArgs& args)
 {
     args.add("reverse", "Reverse Morton", m_reverse, false);
+    args.add("cluster", "Physically reorder table storage to match the "
+        "Morton order", m_cluster, false);
 }
 
-//This used to be a lambda, but the VS compiler exploded, I guess.
-typedef std::pair<double, double> Coord;
 namespace
 {
-bool less_msb(const int& x, const int& y)
+
+// Spread the low 32 bits of 'x' so that a bit of the other coordinate
+// can be interleaved between each pair.
+uint64_t part1By1(uint64_t x)
 {
-    return x < y && x < (x ^ y);
+    x &= 0xffffffff;
+    x = (x ^ (x << 16)) & 0x0000ffff0000ffffULL;
+    x = (x ^ (x << 8)) & 0x00ff00ff00ff00ffULL;
+    x = (x ^ (x << 4)) & 0x0f0f0f0f0f0f0f0fULL;
+    x = (x ^ (x << 2)) & 0x3333333333333333ULL;
+    x = (x ^ (x << 1)) & 0x5555555555555555ULL;
+    return x;
 }
 
-class CmpZOrder
+// Interleave two 32-bit coordinates into a 64-bit Morton key, with Y
+// supplying the more significant bit of each pair as the old
+// comparison-based ordering did.
+uint64_t encodeMorton64(uint32_t x, uint32_t y)
 {
-public:
-    bool operator()(const Coord& c1, const Coord& c2) const
-    {
-        int a[2] = {(int)(c1.first * INT_MAX), (int)(c1.second * INT_MAX)};
-        int b[2] = {(int)(c2.first * INT_MAX), (int)(c2.second * INT_MAX)};
-
-        int j = 0;
-        int x = 0;
-
-        for (int k = 0; k < 2; k++)
-        {
-            int y = a[k] ^ b[k];
-            if (less_msb(x, y))
-            {
-                j = k;
-                x = y;
-            }
-        }
-        return (a[j] - b[j]) < 0;
-    };
-};
+    return (part1By1(y) << 1) | part1By1(x);
 }
 
+} // unnamed namespace
+
 class ReverseZOrder
 {
 public:
@@ -146,32 +146,46 @@ PointViewSet MortonOrderFilter::reverseMorton(PointViewPtr inView)
     const double cell_height = yrange / cell;
 
     // compute reverse morton code for each point
-    std::multimap<uint32_t, PointId> codes;
-    for (PointId idx = 0; idx < inView->size(); idx++)
-    {
-        const double x = inView->getFieldAs<double>(Dimension::Id::X, idx);
-        const int32_t xpos =
-            static_cast<int32_t>(std::floor((x - buffer_bounds.minx) /
-                cell_width));
-
-        const double y = inView->getFieldAs<double>(Dimension::Id::Y, idx);
-        const int32_t ypos =
-            static_cast<int32_t>(std::floor((y - buffer_bounds.miny) /
-                cell_height));
+    const size_t threads = threadCount(inView->size());
+    ThreadPool pool(threads);
 
-        const uint32_t code = ReverseZOrder::encode_morton(xpos, ypos);
-        const uint32_t reverse = ReverseZOrder::reverse_morton( code );
-
-        codes.insert( std::pair<uint32_t, PointId>(reverse, idx) );
+    std::vector<std::pair<uint64_t, PointId>> codes(inView->size());
+    for (size_t t = 0; t < threads; ++t)
+    {
+        const PointId start = t * inView->size() / threads;
+        const PointId end = (t + 1 == threads) ? inView->size() :
+            (t + 1) * inView->size() / threads;
+        pool.add([&, start, end]()
+        {
+            for (PointId idx = start; idx < end; ++idx)
+            {
+                const double x =
+                    inView->getFieldAs<double>(Dimension::Id::X, idx);
+                const int32_t xpos =
+                    static_cast<int32_t>(std::floor((x - buffer_bounds.minx) /
+                        cell_width));
+
+                const double y =
+                    inView->getFieldAs<double>(Dimension::Id::Y, idx);
+                const int32_t ypos =
+                    static_cast<int32_t>(std::floor((y - buffer_bounds.miny) /
+                        cell_height));
+
+                const uint32_t code = ReverseZOrder::encode_morton(xpos, ypos);
+                codes[idx] =
+                    { ReverseZOrder::reverse_morton(code), idx };
+            }
+        });
     }
+    pool.await();
+
+    // points are ordered by reversed code so they're naturally ordered
+    // by lod
+    radixSort(codes, pool, threads);
 
-    // a map is yet order by key so its naturally ordered by lod
-    std::multimap<uint32_t, PointId>::iterator it;
     PointViewPtr outView = inView->makeNew();
-    for (it = codes.begin(); it != codes.end(); ++it)
-    {
-        outView->appendPoint(*inView, it->second);
-    }
+    for (const auto& c : codes)
+        outView->appendPoint(*inView, c.second);
 
     // build output view
     PointViewSet viewSet;
@@ -185,30 +199,48 @@ PointViewSet MortonOrderFilter::morton(PointViewPtr inView)
     PointViewSet viewSet;
     if (!inView->size())
         return viewSet;
-    CmpZOrder compare;
-    std::multimap<Coord, PointId, CmpZOrder> sorted(compare);
 
     BOX2D buffer_bounds;
     inView->calculateBounds(buffer_bounds);
     double xrange = buffer_bounds.maxx - buffer_bounds.minx;
     double yrange = buffer_bounds.maxy - buffer_bounds.miny;
 
-    for (PointId idx = 0; idx < inView->size(); idx++)
+    // Precompute a 64-bit Morton key per point rather than quantizing
+    // coordinates inside a comparator on every comparison.
+    const size_t threads = threadCount(inView->size());
+    ThreadPool pool(threads);
+
+    std::vector<std::pair<uint64_t, PointId>> keys(inView->size());
+    for (size_t t = 0; t < threads; ++t)
     {
-        double xpos = (inView->getFieldAs<double>(Dimension::Id::X, idx) -
-            buffer_bounds.minx) / xrange;
-        double ypos = (inView->getFieldAs<double>(Dimension::Id::Y, idx) -
-            buffer_bounds.miny) / yrange;
-        Coord loc(xpos, ypos);
-        sorted.insert(std::make_pair(loc, idx));
+        const PointId start = t * inView->size() / threads;
+        const PointId end = (t + 1 == threads) ? inView->size() :
+            (t + 1) * inView->size() / threads;
+        pool.add([&, start, end]()
+        {
+            for (PointId idx = start; idx < end; ++idx)
+            {
+                double xpos = xrange ?
+                    (inView->getFieldAs<double>(Dimension::Id::X, idx) -
+                        buffer_bounds.minx) / xrange : 0.0;
+                double ypos = yrange ?
+                    (inView->getFieldAs<double>(Dimension::Id::Y, idx) -
+                        buffer_bounds.miny) / yrange : 0.0;
+                uint32_t xi = (uint32_t)(std::min)(xpos * 4294967296.0,
+                    4294967295.0);
+                uint32_t yi = (uint32_t)(std::min)(ypos * 4294967296.0,
+                    4294967295.0);
+                keys[idx] = { encodeMorton64(xi, yi), idx };
+            }
+        });
     }
+    pool.await();
+
+    radixSort(keys, pool, threads);
 
     PointViewPtr outView = inView->makeNew();
-    std::multimap<Coord, PointId, CmpZOrder>::iterator pos;
-    for (pos = sorted.begin(); pos != sorted.end(); ++pos)
-    {
-        outView->appendPoint(*inView, pos->second);
-    }
+    for (const auto& k : keys)
+        outView->appendPoint(*inView, k.second);
     viewSet.insert(outView);
 
     return viewSet;
@@ -216,14 +248,23 @@ PointViewSet MortonOrderFilter::morton(PointViewPtr inView)
 
 PointViewSet MortonOrderFilter::run(PointViewPtr inView)
 {
+    PointViewSet viewSet;
     if ( m_reverse )
     {
-        return reverseMorton( inView );
+        viewSet = reverseMorton( inView );
     }
     else
     {
-        return morton( inView );
+        viewSet = morton( inView );
     }
+
+    // Turn the sorted order into storage locality, so downstream spatial
+    // work (cropping, splitting, KD construction) walks table memory
+    // sequentially instead of through a shuffled indirection.
+    if (m_cluster)
+        for (const PointViewPtr& view : viewSet)
+            view->reorderStorage();
+    return viewSet;
 }
 
 } // pdal
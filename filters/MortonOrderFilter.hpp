@@ -57,6 +57,7 @@ private:
     PointViewSet morton(PointViewPtr view);
 
     bool m_reverse = false;
+    bool m_cluster = false;
 };
 
 } // namespace pdal
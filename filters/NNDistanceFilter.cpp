@@ -33,7 +33,11 @@
 ****************************************************************************/
 
 #include "NNDistanceFilter.hpp"
+#include "private/PointSpool.hpp"
+#include "private/SlidingWindow.hpp"
 
+#include <algorithm>
+#include <deque>
 #include <string>
 #include <vector>
 
@@ -57,7 +61,29 @@ std::string NNDistanceFilter::getName() const
 }
 
 
-NNDistanceFilter::NNDistanceFilter() : Filter()
+// State for stream-mode operation.  Points are withheld while their
+// neighborhoods complete against the sliding window and re-emitted with
+// their computed distances during the drain phase.
+struct NNDistanceFilter::Private
+{
+    DimTypeList dimTypes;
+    size_t packedSize = 0;
+    Dimension::Id windowDim = Dimension::Id::Unknown;
+    std::unique_ptr<SlidingWindow> window;
+    std::unique_ptr<PointSpool> spool;
+    // Packed records of points whose neighborhoods are incomplete.
+    std::deque<std::vector<char>> pending;
+    std::vector<double> sqrDists;
+    std::vector<char> record;
+    bool draining = false;
+};
+
+
+NNDistanceFilter::NNDistanceFilter() : Filter(), m_p(new Private)
+{}
+
+
+NNDistanceFilter::~NNDistanceFilter()
 {}
 
 
@@ -94,6 +120,10 @@ void NNDistanceFilter::addArgs(ProgramArgs& args)
 {
     args.add("mode", "Distance computation mode (kth, avg)", m_mode, Mode::Kth);
     args.add("k", "k neighbors", m_k, size_t(10));
+    args.add("window", "Radius limiting neighborhoods in stream mode",
+        m_window, 0.0);
+    args.add("window_dim", "Dimension on which streaming input is sorted",
+        m_windowDimName, "X");
 }
 
 
@@ -138,4 +168,124 @@ void NNDistanceFilter::filter(PointView& view)
     }
 }
 
+
+void NNDistanceFilter::ready(PointTableRef table)
+{
+    if (table.supportsView())
+        return;
+
+    // Stream mode runs neighborhood queries against a sliding window over
+    // input sorted along one coordinate, so an interaction radius is
+    // required to bound the window.
+    if (m_window <= 0.0)
+        throwError("Stream mode requires a positive 'window' radius.");
+    m_p->windowDim = table.layout()->findDim(m_windowDimName);
+    if (m_p->windowDim == Dimension::Id::Unknown)
+        throwError("Dimension '" + m_windowDimName + "' not found.");
+
+    m_p->dimTypes = table.layout()->dimTypes();
+    m_p->packedSize = 0;
+    for (const DimType& d : m_p->dimTypes)
+        m_p->packedSize += Dimension::size(d.m_type);
+    m_p->window.reset(new SlidingWindow(m_window));
+    m_p->spool.reset(new PointSpool("nndistance", m_p->packedSize));
+    m_p->record.resize(m_p->packedSize);
+    m_p->draining = false;
+}
+
+
+// Withhold the point until its neighborhood is complete.  Points are
+// re-emitted through drainOne once the input is exhausted.
+bool NNDistanceFilter::processOne(PointRef& point)
+{
+    std::vector<char> record(m_p->packedSize);
+    point.getPackedData(m_p->dimTypes, record.data());
+    m_p->pending.push_back(std::move(record));
+
+    if (!m_p->window->add(point.getFieldAs<double>(Dimension::Id::X),
+            point.getFieldAs<double>(Dimension::Id::Y),
+            point.getFieldAs<double>(Dimension::Id::Z),
+            point.getFieldAs<double>(m_p->windowDim)))
+        throwError("Stream mode requires input sorted in ascending order "
+            "on dimension '" + m_windowDimName + "'.");
+    while (m_p->window->pop(m_p->sqrDists))
+        finalizeOne();
+    return false;
+}
+
+
+// Compute the distance for the next completed point and move its record
+// to the spool.
+void NNDistanceFilter::finalizeOne()
+{
+    std::vector<double>& dists = m_p->sqrDists;
+    size_t k = (std::min)(m_k, dists.size());
+
+    // The window truncates each neighborhood at the 'window' radius.  A
+    // point with fewer than k neighbors in the window takes the radius
+    // itself - a lower bound on the true distance.
+    double val;
+    if (m_mode == Mode::Kth)
+    {
+        if (dists.size() < m_k)
+            val = m_window;
+        else
+        {
+            std::nth_element(dists.begin(), dists.begin() + (k - 1),
+                dists.end());
+            val = std::sqrt(dists[k - 1]);
+        }
+    }
+    else // m_mode == Mode::Average
+    {
+        if (k == 0)
+            val = m_window;
+        else
+        {
+            std::partial_sort(dists.begin(), dists.begin() + k, dists.end());
+            val = 0;
+            for (size_t i = 0; i < k; ++i)
+                val += std::sqrt(dists[i]);
+            val /= k;
+        }
+    }
+    m_p->spool->write(val, m_p->pending.front().data());
+    m_p->pending.pop_front();
+}
+
+
+// Emit the withheld points.  Called repeatedly by the streaming engine
+// once the input is exhausted.
+bool NNDistanceFilter::drainOne(PointRef& point)
+{
+    if (!m_p->draining)
+    {
+        m_p->window->flush();
+        while (m_p->window->pop(m_p->sqrDists))
+            finalizeOne();
+        if (!m_p->spool->rewind())
+            throwError("Couldn't write spool to '" + m_p->spool->path() +
+                "'.");
+        m_p->draining = true;
+    }
+
+    double val;
+    if (!m_p->spool->read(val, m_p->record.data()))
+        return false;
+    point.setPackedData(m_p->dimTypes, m_p->record.data());
+    point.setField(Dimension::Id::NNDistance, val);
+    return true;
+}
+
+
+void NNDistanceFilter::done(PointTableRef)
+{
+    if (m_p->spool)
+        m_p->spool->clear();
+    m_p->window.reset();
+    m_p->spool.reset();
+    m_p->pending.clear();
+    m_p->draining = false;
+}
+
 } // namespace pdal
@@ -35,6 +35,9 @@
 #pragma once
 
 #include <pdal/Filter.hpp>
+#include <pdal/Streamable.hpp>
+
+#include <memory>
 
 namespace pdal
 {
@@ -43,11 +46,12 @@ class PointLayout;
 class PointView;
 class ProgramArgs;
 
-class PDAL_DLL NNDistanceFilter : public Filter
+class PDAL_DLL NNDistanceFilter : public Filter, public Streamable
 {
 public:
     NNDistanceFilter();
-    
+    ~NNDistanceFilter();
+
     NNDistanceFilter& operator=(const NNDistanceFilter&) = delete;
     NNDistanceFilter(const NNDistanceFilter&) = delete;
 
@@ -62,10 +66,23 @@ private:
 
     size_t m_k;
     Mode m_mode;
+    double m_window;
+    std::string m_windowDimName;
+
+    struct Private;
+    std::unique_ptr<Private> m_p;
 
     virtual void addArgs(ProgramArgs& args);
     virtual void addDimensions(PointLayoutPtr layout);
     virtual void filter(PointView& view);
+    virtual void ready(PointTableRef table);
+    virtual bool processOne(PointRef& point);
+    virtual bool deferred() const
+        { return true; }
+    virtual bool drainOne(PointRef& point);
+    virtual void done(PointTableRef table);
+
+    void finalizeOne();
 
     friend std::istream& operator>>(std::istream& in,
         NNDistanceFilter::Mode& mode);
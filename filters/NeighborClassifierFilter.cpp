@@ -37,10 +37,14 @@
 #include <pdal/PipelineManager.hpp>
 #include <pdal/StageFactory.hpp>
 #include <pdal/util/ProgramArgs.hpp>
+#include <pdal/util/ThreadPool.hpp>
 
 #include "private/DimRange.hpp"
 
+#include <algorithm>
 #include <iostream>
+#include <limits>
+#include <map>
 #include <utility>
 namespace pdal
 {
@@ -52,6 +56,12 @@ static PluginInfo const s_info = PluginInfo(
 
 CREATE_STATIC_STAGE(NeighborClassifierFilter, s_info)
 
+namespace
+{
+    // Slot value marking points whose classification is unchanged.
+    const int noChange = (std::numeric_limits<int>::lowest)();
+}
+
 NeighborClassifierFilter::NeighborClassifierFilter() :
     m_dim(Dimension::Id::Classification)
 {}
@@ -68,6 +78,8 @@ void NeighborClassifierFilter::addArgs(ProgramArgs& args)
     args.add("k", "Number of nearest neighbors to consult",
         m_k).setPositional();
     args.add("candidate", "candidate file name", m_candidateFile);
+    args.add("threads", "Number of threads used to run this filter",
+        m_threads, 1);
 }
 
 void NeighborClassifierFilter::initialize()
@@ -112,8 +124,8 @@ void NeighborClassifierFilter::ready(PointTableRef)
 }
 
 
-void NeighborClassifierFilter::doOneNoDomain(PointRef &point, PointRef &temp,
-    KD3Index &kdi)
+void NeighborClassifierFilter::doOneNoDomain(PointRef &point,
+    const std::vector<int>& classes, KD3Index &kdi)
 {
     PointIdList iSrc = kdi.neighbors(point, m_k);
     double thresh = iSrc.size()/2.0;
@@ -121,12 +133,8 @@ void NeighborClassifierFilter::doOneNoDomain(PointRef &point, PointRef &temp,
     // vote NNs
     using CountMap = std::map<int, unsigned int>;
     CountMap counts;
-    //std::map<int, unsigned int> counts;
     for (PointId id : iSrc)
-    {
-        temp.setPointId(id);
-        counts[temp.getFieldAs<int>(m_dim)]++;
-    }
+        counts[classes[id]]++;
 
     // pick winner of the vote
     auto pr = *std::max_element(counts.begin(), counts.end(),
@@ -140,18 +148,18 @@ void NeighborClassifierFilter::doOneNoDomain(PointRef &point, PointRef &temp,
         m_newClass[point.pointId()] = newclass;
 }
 
-// update point.  kdi and temp both reference the NN point cloud
-bool NeighborClassifierFilter::doOne(PointRef& point, PointRef &temp,
-    KD3Index &kdi)
+// update point.  kdi and classes both reference the NN point cloud
+bool NeighborClassifierFilter::doOne(PointRef& point,
+    const std::vector<int>& classes, KD3Index &kdi)
 {
     if (m_domain.empty())  // No domain, process all points
-        doOneNoDomain(point, temp, kdi);
+        doOneNoDomain(point, classes, kdi);
 
     for (DimRange& r : m_domain)
     {   // process only points that satisfy a domain condition
         if (r.valuePasses(point.getFieldAs<double>(r.m_id)))
         {
-            doOneNoDomain(point, temp, kdi);
+            doOneNoDomain(point, classes, kdi);
             break;
         }
     }
@@ -173,32 +181,62 @@ PointViewPtr NeighborClassifierFilter::loadSet(const std::string& filename,
 
 void NeighborClassifierFilter::filter(PointView& view)
 {
-    PointRef point_src(view, 0);
-    if (m_candidateFile.empty())
-    {   // No candidate file so NN comes from src file
-        KD3Index& kdiSrc = view.build3dIndex();
-        PointRef point_nn(view, 0);
-        for (PointId id = 0; id < view.size(); ++id)
+    // Pull the classification column of the NN point cloud up front so
+    // votes are tallied from a flat array instead of per-neighbor field
+    // reads.
+    auto extractClasses = [this](PointView& v)
+    {
+        std::vector<int> classes(v.size());
+        for (PointId id = 0; id < v.size(); ++id)
+            classes[id] = v.getFieldAs<int>(m_dim, id);
+        return classes;
+    };
+
+    // Candidate file, if given, provides the NN point cloud.
+    ColumnPointTable candTable;
+    PointViewPtr candView;
+    if (m_candidateFile.size())
+        candView = loadSet(m_candidateFile, candTable);
+    KD3Index& kdi = candView ? candView->build3dIndex() :
+        view.build3dIndex();
+    std::vector<int> classes = extractClasses(candView ? *candView : view);
+
+    // Neighbor searches and voting only read the views, and each point
+    // writes its own deferred slot, so points chunk across threads.
+    m_newClass.assign(view.size(), noChange);
+    const point_count_t numPts = view.size();
+    const size_t threads = (size_t)(std::min)(
+        (point_count_t)(std::max)(m_threads, 1), numPts);
+    if (threads <= 1)
+    {
+        PointRef point_src(view, 0);
+        for (PointId id = 0; id < numPts; ++id)
         {
             point_src.setPointId(id);
-            doOne(point_src, point_nn, kdiSrc);
+            doOne(point_src, classes, kdi);
         }
     }
     else
-    {   // NN comes from candidate file
-        ColumnPointTable candTable;
-        PointViewPtr candView = loadSet(m_candidateFile, candTable);
-        KD3Index& kdiCand = candView->build3dIndex();
-        PointRef point_nn(*candView, 0);
-        for (PointId id = 0; id < view.size(); ++id)
-        {
-            point_src.setPointId(id);
-            doOne(point_src, point_nn, kdiCand);
-        }
+    {
+        ThreadPool pool(threads);
+        auto chunkStart = [numPts, threads](size_t t)
+            { return t * numPts / threads; };
+        for (size_t t = 0; t < threads; ++t)
+            pool.add([&, t]()
+            {
+                PointRef point_src(view, 0);
+                for (PointId id = chunkStart(t); id < chunkStart(t + 1); ++id)
+                {
+                    point_src.setPointId(id);
+                    doOne(point_src, classes, kdi);
+                }
+            });
+        pool.await();
     }
 
-    for (auto& p : m_newClass)
-        view.setField(m_dim, p.first, p.second);
+    for (PointId id = 0; id < numPts; ++id)
+        if (m_newClass[id] != noChange)
+            view.setField(m_dim, id, m_newClass[id]);
 }
 
 } // namespace pdal
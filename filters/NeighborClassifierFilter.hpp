@@ -36,7 +36,7 @@
 
 #include <pdal/Filter.hpp>
 #include <pdal/KDIndex.hpp>
-#include <unordered_map>
+#include <vector>
 
 extern "C" int32_t NeighborClassifierFilter_ExitFunc();
 extern "C" PF_ExitFunc NeighborClassifierFilter_InitPlugin();
@@ -59,11 +59,13 @@ public:
 private:
     virtual void addArgs(ProgramArgs& args);
     virtual void prepared(PointTableRef table);
-    bool doOne(PointRef& point, PointRef& temp, KD3Index &kdi);
+    bool doOne(PointRef& point, const std::vector<int>& classes,
+        KD3Index &kdi);
     virtual void filter(PointView& view);
     virtual void initialize();
     virtual void ready(PointTableRef);
-    void doOneNoDomain(PointRef &point, PointRef& temp, KD3Index &kdi);
+    void doOneNoDomain(PointRef &point, const std::vector<int>& classes,
+        KD3Index &kdi);
     PointViewPtr loadSet(const std::string &candFileName, PointTableRef table);
     NeighborClassifierFilter& operator=(
         const NeighborClassifierFilter&) = delete;
@@ -71,10 +73,14 @@ private:
     StringList m_domainSpec;
     std::vector<DimRange> m_domain;
     int m_k;
+    int m_threads;
     Dimension::Id m_dim;
     std::string m_dimName;
     std::string m_candidateFile;
-    std::unordered_map<PointId, int> m_newClass;
+
+    // Deferred updates, one slot per point, so classifications aren't
+    // rewritten while neighbors are still being consulted.
+    std::vector<int> m_newClass;
 };
 
 } // namespace pdal
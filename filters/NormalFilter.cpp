@@ -45,11 +45,14 @@
 
 #include <pdal/KDIndex.hpp>
 #include <pdal/util/ProgramArgs.hpp>
+#include <pdal/util/ThreadPool.hpp>
 #include <pdal/private/MathUtils.hpp>
 
 #include <Eigen/Dense>
 
+#include <atomic>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace pdal
@@ -127,7 +130,36 @@ void NormalFilter::prepared(PointTableRef table)
 void NormalFilter::compute(PointView& view, KD3Index& kdi)
 {
     log()->get(LogLevel::Debug) << "Computing normal vectors\n";
-    for (auto&& p : view)
+
+    // Each point's normal depends only on its neighborhood, so points can
+    // be processed in parallel - index queries are read-only and every
+    // worker writes to its own range of points.
+    const size_t threads = (std::min)((point_count_t)(std::max)(
+        std::thread::hardware_concurrency(), 1U), view.size());
+    std::atomic<bool> solverFailed(false);
+    ThreadPool pool(threads ? threads : 1);
+    for (size_t t = 0; t < threads; ++t)
+    {
+        const PointId start = t * view.size() / threads;
+        const PointId end =
+            (t + 1 == threads) ? view.size() : (t + 1) * view.size() / threads;
+        pool.add([this, &view, &kdi, &solverFailed, start, end]()
+        {
+            for (PointId i = start; i < end; ++i)
+            {
+                PointRef p = view.point(i);
+                if (!computeSingle(view, kdi, p))
+                    solverFailed = true;
+            }
+        });
+    }
+    pool.join();
+    if (solverFailed)
+        throwError("Cannot perform eigen decomposition.");
+}
+
+bool NormalFilter::computeSingle(PointView& view, KD3Index& kdi, PointRef& p)
+{
     {
         // Perform eigen decomposition of covariance matrix computed from
         // neighborhood composed of k-nearest neighbors.
@@ -135,7 +167,7 @@ void NormalFilter::compute(PointView& view, KD3Index& kdi)
         auto B = math::computeCovariance(view, neighbors);
         SelfAdjointEigenSolver<Matrix3d> solver(B);
         if (solver.info() != Success)
-            throwError("Cannot perform eigen decomposition.");
+            return false;
 
         // The curvature is computed as the ratio of the first (smallest)
         // eigenvalue to the sum of all eigenvalues.
@@ -174,6 +206,7 @@ void NormalFilter::compute(PointView& view, KD3Index& kdi)
         p.setField(Id::NormalZ, normal[2]);
         p.setField(Id::Curvature, curvature);
     }
+    return true;
 }
 
 void NormalFilter::update(
@@ -89,6 +89,7 @@ private:
     Arg* m_viewpointArg;
 
     void compute(PointView& view, KD3Index& kdi);
+    bool computeSingle(PointView& view, KD3Index& kdi, PointRef& p);
     void refine(PointView& view, KD3Index& kdi);
     void
     update(PointView& view, KD3Index& kdi, std::vector<bool> inMST,
@@ -51,10 +51,14 @@ public:
 
 private:
     point_count_t m_kMin, m_kMax;
+    int m_threads;
 
     virtual void addDimensions(PointLayoutPtr layout);
     virtual void addArgs(ProgramArgs& args);
     virtual void filter(PointView& view);
+
+    bool processPoint(PointView& view, const KD3Index& index, PointId idx,
+        PointIdList& ids, std::vector<double>& dists);
 };
 
 } // namespace pdal
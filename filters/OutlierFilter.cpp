@@ -33,12 +33,18 @@
  ****************************************************************************/
 
 #include "OutlierFilter.hpp"
+#include "private/PointSpool.hpp"
+#include "private/SlidingWindow.hpp"
 
 #include <pdal/KDIndex.hpp>
 #include <pdal/util/ProgramArgs.hpp>
 #include <pdal/util/Utils.hpp>
 
+#include <algorithm>
+#include <deque>
+#include <limits>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace pdal
@@ -53,6 +59,37 @@ static StaticPluginInfo const s_info
 
 CREATE_STATIC_STAGE(OutlierFilter, s_info)
 
+// State for stream-mode operation.  Points are withheld while their
+// neighborhoods complete against the sliding window and re-emitted,
+// labeled, during the drain phase.
+struct OutlierFilter::Private
+{
+    DimTypeList dimTypes;
+    size_t packedSize = 0;
+    Dimension::Id windowDim = Dimension::Id::Unknown;
+    bool statistical = false;
+    std::unique_ptr<SlidingWindow> window;
+    std::unique_ptr<PointSpool> spool;
+    // Packed records of points whose neighborhoods are incomplete.
+    std::deque<std::vector<char>> pending;
+    std::vector<double> sqrDists;
+    std::vector<char> record;
+
+    // Welford accumulation of the mean neighbor distances for the
+    // statistical threshold.
+    size_t n = 0;
+    double M1 = 0.0;
+    double M2 = 0.0;
+    double threshold = 0.0;
+    bool draining = false;
+};
+
+OutlierFilter::OutlierFilter() : m_p(new Private)
+{}
+
+OutlierFilter::~OutlierFilter()
+{}
+
 std::string OutlierFilter::getName() const
 {
     return s_info.name;
@@ -67,6 +104,10 @@ void OutlierFilter::addArgs(ProgramArgs& args)
     args.add("mean_k", "Mean number of neighbors", m_meanK, 8);
     args.add("multiplier", "Standard deviation threshold", m_multiplier, 2.0);
     args.add("class", "Class to use for noise points", m_class, ClassLabel::LowPoint);
+    args.add("window", "Radius limiting neighborhoods in stream mode "
+        "(statistical method)", m_window, 0.0);
+    args.add("window_dim", "Dimension on which streaming input is sorted",
+        m_windowDimName, "X");
 }
 
 void OutlierFilter::addDimensions(PointLayoutPtr layout)
@@ -76,8 +117,9 @@ void OutlierFilter::addDimensions(PointLayoutPtr layout)
 
 Indices OutlierFilter::processRadius(PointViewPtr inView)
 {
-    KD3Index index(*inView);
-    index.build();
+    // Use the view's cached index so a tree built by an earlier stage
+    // (filters.normal, for example) is reused rather than rebuilt.
+    const KD3Index& index = inView->build3dIndex();
 
     point_count_t np = inView->size();
 
@@ -97,8 +139,9 @@ Indices OutlierFilter::processRadius(PointViewPtr inView)
 
 Indices OutlierFilter::processStatistical(PointViewPtr inView)
 {
-    KD3Index index(*inView);
-    index.build();
+    // Use the view's cached index so a tree built by an earlier stage
+    // (filters.normal, for example) is reused rather than rebuilt.
+    const KD3Index& index = inView->build3dIndex();
 
     point_count_t np = inView->size();
 
@@ -108,34 +151,71 @@ Indices OutlierFilter::processStatistical(PointViewPtr inView)
 
     // we increase the count by one because the query point itself will
     // be included with a distance of 0
-    point_count_t count = m_meanK + 1;
-    PointIdList indices(count);
-    std::vector<double> sqr_dists(count);
-    for (PointId i = 0; i < np; ++i)
+    const point_count_t count = (std::min)((point_count_t)m_meanK + 1, np);
+
+    size_t threads = (std::max)(std::thread::hardware_concurrency(), 1U);
+    threads = (std::min)((point_count_t)threads, np);
+
+    // Queries don't modify the tree, so they run concurrently.  Each
+    // thread reuses a single preallocated result buffer for its whole
+    // range and accumulates its own Welford moments alongside the
+    // distance pass, so no separate sweep over the distances is needed.
+    std::vector<size_t> ns(threads, 0);
+    std::vector<double> M1s(threads, 0.0);
+    std::vector<double> M2s(threads, 0.0);
+    std::vector<std::thread> threadList(threads);
+    for (size_t t = 0; t < threads; ++t)
     {
-
-        index.knnSearch(i, count, &indices, &sqr_dists);
-
-        for (size_t j = 1; j < count; ++j)
+        PointId start = t * np / threads;
+        PointId end = (t + 1) == threads ? np : (t + 1) * np / threads;
+        threadList[t] = std::thread([&, t, start, end]()
         {
-            double delta = std::sqrt(sqr_dists[j]) - distances[i];
-            distances[i] += (delta / j);
-        }
-        indices.clear(); indices.resize(count);
-        sqr_dists.clear(); sqr_dists.resize(count);
+            PointIdList indices(count);
+            std::vector<double> sqr_dists(count);
+
+            size_t tn(0);
+            double tM1(0.0);
+            double tM2(0.0);
+            for (PointId i = start; i < end; ++i)
+            {
+                index.knnSearch(i, count, &indices, &sqr_dists);
+
+                double d = 0.0;
+                for (size_t j = 1; j < count; ++j)
+                {
+                    double delta = std::sqrt(sqr_dists[j]) - d;
+                    d += (delta / j);
+                }
+                distances[i] = d;
+
+                size_t n1(tn);
+                tn++;
+                double delta = d - tM1;
+                double delta_n = delta / tn;
+                tM1 += delta_n;
+                tM2 += delta * delta_n * n1;
+            }
+            ns[t] = tn;
+            M1s[t] = tM1;
+            M2s[t] = tM2;
+        });
     }
+    for (auto& t : threadList)
+        t.join();
 
+    // Merge the per-thread moments pairwise.
     size_t n(0);
     double M1(0.0);
     double M2(0.0);
-    for (auto const& d : distances)
+    for (size_t t = 0; t < threads; ++t)
     {
-        size_t n1(n);
-        n++;
-        double delta = d - M1;
-        double delta_n = delta / n;
-        M1 += delta_n;
-        M2 += delta * delta_n * n1;
+        if (!ns[t])
+            continue;
+        size_t total = n + ns[t];
+        double delta = M1s[t] - M1;
+        M2 += M2s[t] + delta * delta * (double)n * ns[t] / total;
+        M1 = (n * M1 + ns[t] * M1s[t]) / total;
+        n = total;
     }
     double mean = M1;
     double variance = M2 / (n - 1.0);
@@ -211,4 +291,148 @@ PointViewSet OutlierFilter::run(PointViewPtr inView)
     return viewSet;
 }
 
+void OutlierFilter::ready(PointTableRef table)
+{
+    if (table.supportsView())
+        return;
+
+    if (Utils::iequals(m_method, "statistical"))
+        m_p->statistical = true;
+    else if (Utils::iequals(m_method, "radius"))
+        m_p->statistical = false;
+    else
+        throwError("Requested method is unrecognized. Please choose from "
+            "\"statistical\" or \"radius\".");
+
+    // The radius method's interaction range is the search radius itself.
+    // The statistical method has no intrinsic bound, so one must be
+    // supplied to bound the sliding window.
+    if (m_p->statistical && m_window <= 0.0)
+        throwError("Stream mode requires a positive 'window' radius with "
+            "the statistical method.");
+    double radius = m_p->statistical ? m_window : m_radius;
+
+    m_p->windowDim = table.layout()->findDim(m_windowDimName);
+    if (m_p->windowDim == Dimension::Id::Unknown)
+        throwError("Dimension '" + m_windowDimName + "' not found.");
+
+    m_p->dimTypes = table.layout()->dimTypes();
+    m_p->packedSize = 0;
+    for (const DimType& d : m_p->dimTypes)
+        m_p->packedSize += Dimension::size(d.m_type);
+    m_p->window.reset(new SlidingWindow(radius));
+    m_p->spool.reset(new PointSpool("outlier", m_p->packedSize));
+    m_p->record.resize(m_p->packedSize);
+    m_p->n = 0;
+    m_p->M1 = 0.0;
+    m_p->M2 = 0.0;
+    m_p->draining = false;
+}
+
+// Withhold the point until its neighborhood is complete.  Points are
+// re-emitted through drainOne once the input is exhausted.
+bool OutlierFilter::processOne(PointRef& point)
+{
+    std::vector<char> record(m_p->packedSize);
+    point.getPackedData(m_p->dimTypes, record.data());
+    m_p->pending.push_back(std::move(record));
+
+    if (!m_p->window->add(point.getFieldAs<double>(Dimension::Id::X),
+            point.getFieldAs<double>(Dimension::Id::Y),
+            point.getFieldAs<double>(Dimension::Id::Z),
+            point.getFieldAs<double>(m_p->windowDim)))
+        throwError("Stream mode requires input sorted in ascending order "
+            "on dimension '" + m_windowDimName + "'.");
+    while (m_p->window->pop(m_p->sqrDists))
+        finalizeOne();
+    return false;
+}
+
+// Compute the next completed point's statistic and move its record to the
+// spool.  For the statistical method this is the mean distance to the
+// mean_k nearest neighbors; for the radius method, the neighbor count.
+void OutlierFilter::finalizeOne()
+{
+    std::vector<double>& dists = m_p->sqrDists;
+
+    double val;
+    if (m_p->statistical)
+    {
+        // Neighborhoods are truncated at the 'window' radius; a point
+        // with no neighbor in the window takes the radius as a lower
+        // bound on its mean distance.
+        size_t k = (std::min)((size_t)m_meanK, dists.size());
+        if (k == 0)
+            val = m_window;
+        else
+        {
+            std::partial_sort(dists.begin(), dists.begin() + k, dists.end());
+            val = 0.0;
+            for (size_t i = 0; i < k; ++i)
+                val += std::sqrt(dists[i]);
+            val /= k;
+        }
+
+        size_t n1(m_p->n);
+        m_p->n++;
+        double delta = val - m_p->M1;
+        double delta_n = delta / m_p->n;
+        m_p->M1 += delta_n;
+        m_p->M2 += delta * delta_n * n1;
+    }
+    else
+        val = (double)dists.size();
+
+    m_p->spool->write(val, m_p->pending.front().data());
+    m_p->pending.pop_front();
+}
+
+// Emit the withheld points, labeling the outliers.  Called repeatedly by
+// the streaming engine once the input is exhausted.
+bool OutlierFilter::drainOne(PointRef& point)
+{
+    if (!m_p->draining)
+    {
+        m_p->window->flush();
+        while (m_p->window->pop(m_p->sqrDists))
+            finalizeOne();
+        if (!m_p->spool->rewind())
+            throwError("Couldn't write spool to '" + m_p->spool->path() +
+                "'.");
+
+        if (m_p->statistical && m_p->n > 1)
+        {
+            double stdev = std::sqrt(m_p->M2 / (m_p->n - 1.0));
+            m_p->threshold = m_p->M1 + m_multiplier * stdev;
+        }
+        else
+            m_p->threshold = (std::numeric_limits<double>::max)();
+        m_p->draining = true;
+    }
+
+    double val;
+    if (!m_p->spool->read(val, m_p->record.data()))
+        return false;
+    point.setPackedData(m_p->dimTypes, m_p->record.data());
+
+    // With the radius method a point is an outlier when it has fewer than
+    // min_k neighbors; with the statistical method, when its mean
+    // neighbor distance is at or beyond the threshold.
+    bool outlier = m_p->statistical ?
+        (val >= m_p->threshold) : (val < m_minK);
+    if (outlier)
+        point.setField(Dimension::Id::Classification, m_class);
+    return true;
+}
+
+void OutlierFilter::done(PointTableRef)
+{
+    if (m_p->spool)
+        m_p->spool->clear();
+    m_p->window.reset();
+    m_p->spool.reset();
+    m_p->pending.clear();
+    m_p->draining = false;
+}
+
 } // namespace pdal
@@ -35,6 +35,7 @@
 #pragma once
 
 #include <pdal/Filter.hpp>
+#include <pdal/Streamable.hpp>
 
 #include <map>
 #include <memory>
@@ -51,12 +52,11 @@ struct Indices
     PointIdList outliers;
 };
 
-class PDAL_DLL OutlierFilter : public pdal::Filter
+class PDAL_DLL OutlierFilter : public pdal::Filter, public pdal::Streamable
 {
 public:
-    OutlierFilter() : Filter()
-    {
-    }
+    OutlierFilter();
+    ~OutlierFilter();
 
     std::string getName() const;
 
@@ -67,12 +67,25 @@ private:
     int m_meanK;
     double m_multiplier;
     uint8_t m_class;
+    double m_window;
+    std::string m_windowDimName;
+
+    struct Private;
+    std::unique_ptr<Private> m_p;
 
     virtual void addDimensions(PointLayoutPtr layout);
     virtual void addArgs(ProgramArgs& args);
     Indices processRadius(PointViewPtr inView);
     Indices processStatistical(PointViewPtr inView);
     virtual PointViewSet run(PointViewPtr view);
+    virtual void ready(PointTableRef table);
+    virtual bool processOne(PointRef& point);
+    virtual bool deferred() const
+        { return true; }
+    virtual bool drainOne(PointRef& point);
+    virtual void done(PointTableRef table);
+
+    void finalizeOne();
 
     OutlierFilter& operator=(const OutlierFilter&); // not implemented
     OutlierFilter(const OutlierFilter&);            // not implemented
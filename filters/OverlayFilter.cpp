@@ -39,8 +39,11 @@
 #include <ogr_api.h>
 
 #include <pdal/util/ProgramArgs.hpp>
+#include <pdal/private/gdal/DatasetPool.hpp>
 #include <pdal/private/gdal/GDALUtils.hpp>
 
+#include "private/BoxIndex.hpp"
+
 namespace pdal
 {
 
@@ -55,6 +58,14 @@ static StaticPluginInfo const s_info
 CREATE_STATIC_STAGE(OverlayFilter, s_info)
 
 
+OverlayFilter::OverlayFilter() : m_ds(0), m_lyr(0)
+{}
+
+
+OverlayFilter::~OverlayFilter()
+{}
+
+
 void OverlayFilter::addArgs(ProgramArgs& args)
 {
     args.add("dimension", "Dimension on which to filter", m_dimName).
@@ -85,8 +96,7 @@ void OverlayFilter::prepared(PointTableRef table)
 
 void OverlayFilter::ready(PointTableRef table)
 {
-    m_ds = OGRDSPtr(OGROpen(m_datasource.c_str(), 0, 0),
-            [](void *p){ if (p) ::OGR_DS_Destroy(p); });
+    m_ds = gdal::DatasetPool::instance().vector(m_datasource);
     if (!m_ds)
         throwError("Unable to open data source '" + m_datasource + "'");
 
@@ -100,6 +110,9 @@ void OverlayFilter::ready(PointTableRef table)
     if (!m_lyr)
         throwError("Unable to select layer '" + m_layer + "'");
 
+    // Pooled handles may have been read before.
+    OGR_L_ResetReading(m_lyr);
+
     auto featureDeleter = [](void *p)
     {
         if (p)
@@ -127,6 +140,24 @@ void OverlayFilter::ready(PointTableRef table)
         feature = OGRFeaturePtr(OGR_L_GetNextFeature(m_lyr), featureDeleter);
     }
     while (feature);
+
+    buildIndex();
+}
+
+
+void OverlayFilter::buildIndex()
+{
+    m_index.reset();
+    if (m_polygons.size() <= 4)
+        return;
+
+    std::vector<BoxIndex::Box> boxes;
+    for (const PolyVal& poly : m_polygons)
+    {
+        BOX3D b = poly.geom.bounds();
+        boxes.push_back({ { b.minx, b.miny }, { b.maxx, b.maxy } });
+    }
+    m_index.reset(new BoxIndex(boxes));
 }
 
 
@@ -140,15 +171,33 @@ void OverlayFilter::spatialReferenceChanged(const SpatialReference& srs)
         if (!ok)
             throwError(ok.what());
     }
+    // Transformed polygons have new bounds.
+    buildIndex();
 }
 
 
 bool OverlayFilter::processOne(PointRef& point)
 {
+    double x = point.getFieldAs<double>(Dimension::Id::X);
+    double y = point.getFieldAs<double>(Dimension::Id::Y);
+
+    // Candidate lists hold polygon positions in load order, so the first
+    // match is the same polygon the full scan would have found.
+    if (m_index)
+    {
+        for (size_t i : m_index->candidates(x, y))
+        {
+            if (m_polygons[i].geom.contains(x, y))
+            {
+                point.setField(m_dim, m_polygons[i].val);
+                break;
+            }
+        }
+        return true;
+    }
+
     for (const auto& poly : m_polygons)
     {
-        double x = point.getFieldAs<double>(Dimension::Id::X);
-        double y = point.getFieldAs<double>(Dimension::Id::Y);
         if (poly.geom.contains(x, y))
         {
             point.setField(m_dim, poly.val);
@@ -47,6 +47,8 @@ typedef void *OGRLayerH;
 namespace pdal
 {
 
+class BoxIndex;
+
 namespace gdal
 {
     class ErrorHandler;
@@ -67,8 +69,8 @@ class PDAL_DLL OverlayFilter : public Filter, public Streamable
     };
 
 public:
-    OverlayFilter() : m_ds(0), m_lyr(0)
-    {}
+    OverlayFilter();
+    ~OverlayFilter();
 
     std::string getName() const { return "filters.overlay"; }
 
@@ -80,6 +82,7 @@ private:
     virtual void prepared(PointTableRef table);
     virtual void ready(PointTableRef table);
     virtual void filter(PointView& view);
+    void buildIndex();
 
     OverlayFilter& operator=(const OverlayFilter&) = delete;
     OverlayFilter(const OverlayFilter&) = delete;
@@ -95,6 +98,9 @@ private:
     std::string m_layer;
     Dimension::Id m_dim;
     std::vector<PolyVal> m_polygons;
+    // Index over the polygon bounding boxes so a point tests only
+    // candidate polygons.
+    std::unique_ptr<BoxIndex> m_index;
 };
 
 } // namespace pdal
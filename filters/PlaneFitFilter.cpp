@@ -84,19 +84,38 @@ void PlaneFitFilter::addDimensions(PointLayoutPtr layout)
 void PlaneFitFilter::filter(PointView& view)
 {
     point_count_t nloops = view.size();
+    if (!nloops)
+        return;
+
+    // Build the index up front so worker threads only issue queries.
+    const KD3Index& kdi = view.build3dIndex();
+
+    // Fits are staged per point and written once all threads finish, so
+    // the view isn't mutated while neighborhoods are still being queried.
+    std::vector<double> fits(nloops);
+
     std::vector<std::thread> threadList(m_threads);
     for (int t = 0; t < m_threads; t++)
     {
         threadList[t] = std::thread(std::bind(
             [&](const PointId start, const PointId end) {
+                // Query buffers, reused across fits to avoid per-point
+                // allocations.
+                PointIdList ids(m_knn + 1);
+                std::vector<double> sqr_dists(m_knn + 1);
+                PointIdList neighbors;
                 for (PointId i = start; i < end; i++)
-                    setPlaneFit(view, i);
+                    fits[i] = planeFit(view, i, kdi, ids, sqr_dists,
+                        neighbors);
             },
             t * nloops / m_threads,
             (t + 1) == m_threads ? nloops : (t + 1) * nloops / m_threads));
     }
     for (auto& t : threadList)
         t.join();
+
+    for (PointId i = 0; i < nloops; ++i)
+        view.setField(Id::PlaneFit, i, fits[i]);
 }
 
 double PlaneFitFilter::absDistance(PointView& view, const PointId& i,
@@ -112,14 +131,15 @@ double PlaneFitFilter::absDistance(PointView& view, const PointId& i,
     return std::fabs(d);
 }
 
-void PlaneFitFilter::setPlaneFit(PointView& view, const PointId& i)
+double PlaneFitFilter::planeFit(PointView& view, const PointId& i,
+    const KD3Index& kdi, PointIdList& ids, std::vector<double>& sqr_dists,
+    PointIdList& neighbors)
 {
     // Find k-nearest neighbors of i.
-    const KD3Index& kdi = view.build3dIndex();
-    PointIdList ni = kdi.neighbors(i, m_knn + 1);
+    kdi.knnSearch(i, m_knn + 1, &ids, &sqr_dists);
 
     // Normal based only on neighbors, so exclude first point.
-    PointIdList neighbors(ni.begin() + 1, ni.end());
+    neighbors.assign(ids.begin() + 1, ids.end());
 
     // Covariance and normal are based off demeaned coordinates, so we record
     // the centroid to properly offset the coordinates when computing point to
@@ -147,8 +167,8 @@ void PlaneFitFilter::setPlaneFit(PointView& view, const PointId& i)
     }
     double d_bar(d_sum / m_knn);
 
-    // Compute and set the plane fit criterion.
-    view.setField(Id::PlaneFit, i, d / (d + d_bar));
+    // Compute the plane fit criterion.
+    return d / (d + d_bar);
 }
 
 } // namespace pdal
@@ -43,6 +43,8 @@
 namespace pdal
 {
 
+class KD3Index;
+
 using namespace Eigen;
 
 class PDAL_DLL PlaneFitFilter : public Filter
@@ -63,7 +65,9 @@ private:
     virtual void addDimensions(PointLayoutPtr layout);
     virtual void filter(PointView& view);
 
-    void setPlaneFit(PointView& view, const PointId& i);
+    double planeFit(PointView& view, const PointId& i, const KD3Index& kdi,
+                    PointIdList& ids, std::vector<double>& sqr_dists,
+                    PointIdList& neighbors);
     double absDistance(PointView& view, const PointId& i,
                        Vector3d& centroid, Vector3d& normal);
 };
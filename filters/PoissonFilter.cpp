@@ -265,6 +265,8 @@ void PoissonFilter::addArgs(ProgramArgs& args)
     args.add("density", "Output density estimates", m_density);
     args.add("depth", "Maximum depth of the octree used for reconstruction",
         m_depth, 8);
+    args.add("threads", "Number of threads used for octree construction "
+        "and the multigrid solve", m_threads, 1);
 }
 
 
@@ -289,6 +291,9 @@ PointViewSet PoissonFilter::run(PointViewPtr view)
     opts.m_density = m_density;
     opts.m_solveDepth = m_depth;
     opts.m_kernelDepth = m_depth - 2;
+    // The reconstruction code parallelizes with OpenMP; without OpenMP in
+    // the build the pragmas are ignored and this is a no-op.
+    opts.m_threads = (std::max)(m_threads, 1);
     if (m_doColor)
     {
         opts.m_color = 16;
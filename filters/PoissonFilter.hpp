@@ -52,6 +52,7 @@ public:
 private:
     bool m_density;
     int m_depth;
+    int m_threads;
     bool m_normalsProvided;
     bool m_doColor;
 
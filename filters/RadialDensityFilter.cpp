@@ -35,6 +35,7 @@
 #include "RadialDensityFilter.hpp"
 
 #include <pdal/KDIndex.hpp>
+#include <pdal/util/ThreadPool.hpp>
 
 #include <string>
 
@@ -60,6 +61,8 @@ std::string RadialDensityFilter::getName() const
 void RadialDensityFilter::addArgs(ProgramArgs& args)
 {
     args.add("radius", "Radius", m_rad, 1.0);
+    args.add("threads", "Number of threads used to run this filter",
+        m_threads, 1);
 }
 
 void RadialDensityFilter::addDimensions(PointLayoutPtr layout)
@@ -74,13 +77,40 @@ void RadialDensityFilter::filter(PointView& view)
 
     // Search for neighboring points within the specified radius. The number of
     // neighbors (which includes the query point) is normalized by the volume
-    // of the search sphere and recorded as the density.
+    // of the search sphere and recorded as the density.  The counting query
+    // avoids materializing a neighbor list per point, and the index is
+    // read-only during the search, so chunks of points run in parallel.
     log()->get(LogLevel::Debug) << "Computing densities...\n";
     double factor = 1.0 / ((4.0 / 3.0) * 3.14159 * (m_rad * m_rad * m_rad));
-    for (PointRef p : view)
+
+    point_count_t numPts = view.size();
+    size_t threads = (size_t)(std::min)(
+        (point_count_t)(std::max)(m_threads, 1), numPts);
+
+    auto chunkStart = [numPts, threads](size_t t)
+        { return (PointId)(t * numPts / threads); };
+    auto densities = [&](size_t t)
+    {
+        PointRef p(view, 0);
+        for (PointId idx = chunkStart(t); idx < chunkStart(t + 1); ++idx)
+        {
+            p.setPointId(idx);
+            p.setField(Id::RadialDensity, index.radiusCount(p, m_rad) *
+                factor);
+        }
+    };
+
+    if (threads <= 1)
+    {
+        if (numPts)
+            densities(0);
+    }
+    else
     {
-        PointIdList pts = index.radius(p, m_rad);
-        p.setField(Id::RadialDensity, pts.size() * factor);
+        ThreadPool pool(threads);
+        for (size_t t = 0; t < threads; ++t)
+            pool.add([&densities, t]() { densities(t); });
+        pool.await();
     }
 }
 
@@ -55,6 +55,7 @@ public:
 
 private:
     double m_rad;
+    int m_threads;
 
     virtual void addArgs(ProgramArgs& args);
     virtual void addDimensions(PointLayoutPtr layout);
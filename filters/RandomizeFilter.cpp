@@ -34,6 +34,12 @@
 
 #include "RandomizeFilter.hpp"
 
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include <pdal/util/ThreadPool.hpp>
+
 namespace pdal
 {
 
@@ -53,4 +59,136 @@ void RandomizeFilter::addArgs(ProgramArgs& args)
     m_seedArg = &args.add("seed", "Random number generator seed", m_seed, 0u);
 }
 
+namespace
+{
+
+// Don't spin up workers for small views; a shuffle step is only a few
+// operations per point.
+const point_count_t minParallelSize = 100000;
+
+// Serves single random bits, drawing a word from the generator only
+// when the cache runs dry.  Coin flips dominate the merge step, so one
+// generator call per 32 flips matters.
+class BitSource
+{
+public:
+    BitSource(uint32_t seed) : m_rng(seed), m_bits(0), m_avail(0)
+    {}
+
+    bool flip()
+    {
+        if (!m_avail)
+        {
+            m_bits = m_rng();
+            m_avail = 32;
+        }
+        bool bit = m_bits & 1;
+        m_bits >>= 1;
+        m_avail--;
+        return bit;
+    }
+
+    std::mt19937& rng()
+        { return m_rng; }
+
+private:
+    std::mt19937 m_rng;
+    uint32_t m_bits;
+    int m_avail;
+};
+
+// Merge two independently shuffled runs [lo, mid) and [mid, hi) into a
+// uniform shuffle of [lo, hi) in place (MergeShuffle).  While both runs
+// are live a coin flip decides which run contributes the next element;
+// once one run is exhausted the remainder is absorbed with Fisher-Yates
+// steps.  Uses O(1) auxiliary memory over the view's index.
+void mergeShuffle(PointView& view, PointId lo, PointId mid, PointId hi,
+    uint32_t seed)
+{
+    BitSource bits(seed);
+    auto it = view.begin();
+
+    PointId i = lo;
+    PointId j = mid;
+    while (true)
+    {
+        if (bits.flip())
+        {
+            if (i == j)
+                break;
+        }
+        else
+        {
+            if (j == hi)
+                break;
+            std::iter_swap(it + i, it + j);
+            j++;
+        }
+        i++;
+    }
+    while (i < hi)
+    {
+        std::uniform_int_distribution<PointId> dist(lo, i);
+        std::iter_swap(it + i, it + dist(bits.rng()));
+        i++;
+    }
+}
+
+} // unnamed namespace
+
+void RandomizeFilter::filter(PointView& view)
+{
+    if (!m_seedArg->set())
+    {
+        std::random_device rng;
+        m_seed = rng();
+    }
+
+    const size_t threads = (std::min)((size_t)(std::max)(
+        std::thread::hardware_concurrency(), 1U),
+        (size_t)(view.size() / minParallelSize));
+    if (threads <= 1)
+    {
+        std::mt19937 mt(m_seed);
+        std::shuffle(view.begin(), view.end(), mt);
+        return;
+    }
+
+    // Round the block count up to a power of two so that each merge
+    // round pairs whole blocks.
+    size_t blocks = 1;
+    while (blocks < threads)
+        blocks *= 2;
+
+    auto bound = [&view, blocks](size_t b)
+        { return (PointId)(b * view.size() / blocks); };
+
+    // Drawing every task's seed from one master generator keeps the
+    // result reproducible for a given 'seed' option.
+    std::mt19937 seeder(m_seed);
+    ThreadPool pool(threads);
+
+    // Shuffle each block independently, then merge pairs of shuffled
+    // runs in doubling rounds until one run spans the view.
+    for (size_t b = 0; b < blocks; ++b)
+        pool.add([&view, &bound, b, seed = (uint32_t)seeder()]()
+        {
+            std::mt19937 mt(seed);
+            std::shuffle(view.begin() + bound(b),
+                view.begin() + bound(b + 1), mt);
+        });
+    pool.await();
+
+    for (size_t width = 1; width < blocks; width *= 2)
+    {
+        for (size_t b = 0; b < blocks; b += 2 * width)
+            pool.add([&view, &bound, b, width, seed = (uint32_t)seeder()]()
+            {
+                mergeShuffle(view, bound(b), bound(b + width),
+                    bound(b + 2 * width), seed);
+            });
+        pool.await();
+    }
+}
+
 } // namespace pdal
@@ -39,7 +39,9 @@
 
 #include "private/DimRange.hpp"
 
+#include <algorithm>
 #include <cctype>
+#include <cstdint>
 #include <limits>
 #include <map>
 #include <string>
@@ -110,11 +112,58 @@ PointViewSet RangeFilter::run(PointViewPtr inView)
 
     PointViewPtr outView = inView->makeNew();
 
-    for (PointId i = 0; i < inView->size(); ++i)
+    // Ranges are sorted, so ranges of one dimension are contiguous: OR
+    // within a dimension and AND across dimensions, as processOne
+    // evaluates.  Each block gathers a dimension's values once and runs
+    // every range over the array branchlessly; the survivor mask drives
+    // the final compaction, keeping predicate evaluation out of the
+    // per-point dispatch path.
+    const size_t BlockSize = 1024;
+    double vals[BlockSize];
+    uint8_t dimPass[BlockSize];
+    uint8_t pass[BlockSize];
+
+    PointId idx = 0;
+    while (idx < inView->size())
     {
-        PointRef point = inView->point(i);
-        if (processOne(point))
-            outView->appendPoint(*inView, i);
+        size_t n = (std::min)((size_t)(inView->size() - idx), BlockSize);
+
+        std::fill(pass, pass + n, (uint8_t)1);
+        size_t ri = 0;
+        while (ri < m_ranges.size())
+        {
+            Dimension::Id id = m_ranges[ri].m_id;
+            for (size_t i = 0; i < n; ++i)
+                vals[i] = inView->getFieldAs<double>(id, idx + i);
+
+            std::fill(dimPass, dimPass + n, (uint8_t)0);
+            for (; ri < m_ranges.size() && m_ranges[ri].m_id == id; ++ri)
+            {
+                const DimRange& r = m_ranges[ri];
+                const double lo = r.m_lower_bound;
+                const double hi = r.m_upper_bound;
+                const bool exLo = !r.m_inclusive_lower_bound;
+                const bool exHi = !r.m_inclusive_upper_bound;
+                const bool neg = r.m_negate;
+                for (size_t i = 0; i < n; ++i)
+                {
+                    double v = vals[i];
+                    // v != v catches NaN, which never passes a
+                    // non-negated range.
+                    bool fail = (v != v) |
+                        (exLo ? v <= lo : v < lo) |
+                        (exHi ? v >= hi : v > hi);
+                    dimPass[i] |= (uint8_t)(neg ? fail : !fail);
+                }
+            }
+            for (size_t i = 0; i < n; ++i)
+                pass[i] &= dimPass[i];
+        }
+
+        for (size_t i = 0; i < n; ++i)
+            if (pass[i])
+                outView->appendPoint(*inView, idx + i);
+        idx += n;
     }
 
     viewSet.insert(outView);
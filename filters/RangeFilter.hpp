@@ -61,6 +61,9 @@ private:
     virtual void prepared(PointTableRef table);
     virtual bool processOne(PointRef& point);
     virtual PointViewSet run(PointViewPtr view);
+    // run() only reads m_ranges, so views can be processed concurrently.
+    virtual bool viewThreadSafe() const
+    { return true; }
 
     RangeFilter& operator=(const RangeFilter&) = delete;
     RangeFilter(const RangeFilter&) = delete;
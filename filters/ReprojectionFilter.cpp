@@ -34,6 +34,8 @@
 
 #include "ReprojectionFilter.hpp"
 
+#include <numeric>
+
 #include <pdal/PointView.hpp>
 #include <pdal/private/SrsTransform.hpp>
 #include <pdal/util/ProgramArgs.hpp>
@@ -162,6 +164,15 @@ void ReprojectionFilter::createTransform(const SpatialReference& srsSRS)
 }
 
 
+namespace
+{
+    // Number of points gathered per call into the coordinate transform.
+    // Large enough to amortize per-call overhead, small enough to keep the
+    // scratch buffers cache-resident.
+    const point_count_t batchSize = 10000;
+}
+
+
 PointViewSet ReprojectionFilter::run(PointViewPtr view)
 {
     PointViewSet viewSet;
@@ -169,19 +180,102 @@ PointViewSet ReprojectionFilter::run(PointViewPtr view)
 
     createTransform(view->spatialReference());
 
-    PointRef point(*view, 0);
-    for (PointId id = 0; id < view->size(); ++id)
+    m_ids.resize((std::min)(batchSize, (point_count_t)view->size()));
+    for (PointId first = 0; first < view->size(); first += batchSize)
     {
-        point.setPointId(id);
-        if (processOne(point))
-            outView->appendPoint(*view, id);
+        point_count_t count =
+            (std::min)(batchSize, (point_count_t)view->size() - first);
+        m_ids.resize(count);
+        std::iota(m_ids.begin(), m_ids.end(), first);
+        transformBatch(*view, m_ids.data(), count, m_ok);
+        for (point_count_t i = 0; i < count; ++i)
+            if (m_ok[i])
+                outView->appendPoint(*view, first + i);
     }
 
+    // The source view's coordinates changed, so any spatial index built
+    // on it is stale.
+    view->invalidateProducts();
+
     viewSet.insert(outView);
     return viewSet;
 }
 
 
+// Gather the coordinates of the identified points, push them through the
+// transform as one contiguous batch and scatter the results back.  'ok'
+// receives per-point success.
+void ReprojectionFilter::transformBatch(PointContainer& container,
+    const PointId *ids, point_count_t count, std::vector<bool>& ok)
+{
+    m_x.resize(count);
+    m_y.resize(count);
+    m_z.resize(count);
+    m_status.resize(count);
+    ok.resize(count);
+
+    PointRef point(container, 0);
+    for (point_count_t i = 0; i < count; ++i)
+    {
+        point.setPointId(ids[i]);
+        m_x[i] = point.getFieldAs<double>(Dimension::Id::X);
+        m_y[i] = point.getFieldAs<double>(Dimension::Id::Y);
+        m_z[i] = point.getFieldAs<double>(Dimension::Id::Z);
+    }
+
+    // The return value only indicates whether every point succeeded;
+    // per-point status is what we act on.
+    m_transform->transform(count, m_x.data(), m_y.data(), m_z.data(),
+        m_status.data());
+
+    for (point_count_t i = 0; i < count; ++i)
+    {
+        if (m_status[i])
+        {
+            point.setPointId(ids[i]);
+            point.setField(Dimension::Id::X, m_x[i]);
+            point.setField(Dimension::Id::Y, m_y[i]);
+            point.setField(Dimension::Id::Z, m_z[i]);
+            ok[i] = true;
+        }
+        else if (m_errorOnFailure)
+        {
+            point.setPointId(ids[i]);
+            throwError("Couldn't reproject point with X/Y/Z coordinates "
+                "of (" +
+                std::to_string(point.getFieldAs<double>(Dimension::Id::X)) +
+                ", " +
+                std::to_string(point.getFieldAs<double>(Dimension::Id::Y)) +
+                ", " +
+                std::to_string(point.getFieldAs<double>(Dimension::Id::Z)) +
+                ").");
+        }
+        else
+            ok[i] = false;
+    }
+}
+
+
+void ReprojectionFilter::processBatch(StreamPointTable& table,
+    point_count_t count)
+{
+    m_ids.clear();
+    for (PointId idx = 0; idx < count; ++idx)
+        if (!table.skip(idx))
+            m_ids.push_back(idx);
+
+    for (point_count_t first = 0; first < m_ids.size(); first += batchSize)
+    {
+        point_count_t n =
+            (std::min)(batchSize, (point_count_t)m_ids.size() - first);
+        transformBatch(table, m_ids.data() + first, n, m_ok);
+        for (point_count_t i = 0; i < n; ++i)
+            if (!m_ok[i])
+                table.setSkip(m_ids[first + i]);
+    }
+}
+
+
 bool ReprojectionFilter::processOne(PointRef& point)
 {
     double x(point.getFieldAs<double>(Dimension::Id::X));
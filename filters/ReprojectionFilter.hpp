@@ -60,10 +60,15 @@ private:
     virtual void initialize();
     virtual PointViewSet run(PointViewPtr view);
     virtual bool processOne(PointRef& point);
+    virtual bool batchMode() const
+        { return true; }
+    virtual void processBatch(StreamPointTable& table, point_count_t count);
     virtual void spatialReferenceChanged(const SpatialReference& srs);
     virtual void prepared(PointTableRef table);
 
     void createTransform(const SpatialReference& srs);
+    void transformBatch(PointContainer& container, const PointId *ids,
+        point_count_t count, std::vector<bool>& ok);
 
     SpatialReference m_inSRS;
     SpatialReference m_outSRS;
@@ -74,6 +79,14 @@ private:
     std::vector<int> m_inAxisOrdering;
     std::vector<int> m_outAxisOrdering;
     bool m_errorOnFailure;
+
+    // Scratch buffers for batched coordinate transformation.
+    std::vector<double> m_x;
+    std::vector<double> m_y;
+    std::vector<double> m_z;
+    std::vector<int> m_status;
+    std::vector<PointId> m_ids;
+    std::vector<bool> m_ok;
 };
 
 } // namespace pdal
@@ -35,6 +35,12 @@
 #include "ReturnsFilter.hpp"
 
 #include <pdal/util/ProgramArgs.hpp>
+#include <pdal/util/ThreadPool.hpp>
+
+#include <array>
+#include <thread>
+
+#include "private/ParallelSort.hpp"
 
 namespace pdal
 {
@@ -97,22 +103,85 @@ PointViewSet ReturnsFilter::run(PointViewPtr inView)
     PointViewPtr lastView = inView->makeNew();
     PointViewPtr onlyView = inView->makeNew();
 
-    for (PointId idx = 0; idx < inView->size(); idx++)
+    // The groups are mutually exclusive, so each point gets one label.
+    const int8_t numGroups = 4;
+    auto classify = [this](uint8_t rn, uint8_t nr) -> int8_t
     {
-        PointRef p = inView->point(idx);
-        uint8_t rn = p.getFieldAs<uint8_t>(Dimension::Id::ReturnNumber);
-        uint8_t nr = p.getFieldAs<uint8_t>(Dimension::Id::NumberOfReturns);
         if ((m_outputTypes & returnFirst) && (rn == 1) && (nr > 1))
-            firstView->appendPoint(*inView.get(), idx);
+            return 0;
         if ((m_outputTypes & returnIntermediate) && (rn > 1) && (rn < nr) &&
             (nr > 2))
-            intermediateView->appendPoint(*inView.get(), idx);
+            return 1;
         if ((m_outputTypes & returnLast) && (rn == nr) && (nr > 1))
-            lastView->appendPoint(*inView.get(), idx);
+            return 2;
         if ((m_outputTypes & returnOnly) && (nr == 1))
-            onlyView->appendPoint(*inView.get(), idx);
+            return 3;
+        return -1;
+    };
+
+    // Two passes: count each chunk's group populations, then scatter the
+    // point IDs to precomputed offsets.  Chunk-major offsets within each
+    // group keep the scatter stable, so output ordering matches the old
+    // point-by-point append.
+    point_count_t numPts = inView->size();
+    size_t threads = threadCount(numPts);
+    ThreadPool pool(threads);
+    auto chunkStart = [numPts, threads](size_t t)
+        { return (PointId)(t * numPts / threads); };
+
+    std::vector<int8_t> labels(numPts);
+    std::vector<std::array<point_count_t, numGroups>> counts(threads);
+    for (size_t t = 0; t < threads; ++t)
+        pool.add([&, t]()
+        {
+            auto& c = counts[t];
+            c.fill(0);
+            for (PointId idx = chunkStart(t); idx < chunkStart(t + 1); ++idx)
+            {
+                uint8_t rn = inView->getFieldAs<uint8_t>(
+                    Dimension::Id::ReturnNumber, idx);
+                uint8_t nr = inView->getFieldAs<uint8_t>(
+                    Dimension::Id::NumberOfReturns, idx);
+                int8_t label = classify(rn, nr);
+                labels[idx] = label;
+                if (label >= 0)
+                    c[label]++;
+            }
+        });
+    pool.await();
+
+    std::array<std::vector<PointId>, numGroups> groupIds;
+    for (int8_t g = 0; g < numGroups; ++g)
+    {
+        point_count_t total = 0;
+        for (size_t t = 0; t < threads; ++t)
+        {
+            point_count_t n = counts[t][g];
+            counts[t][g] = total;
+            total += n;
+        }
+        groupIds[g].resize(total);
     }
 
+    for (size_t t = 0; t < threads; ++t)
+        pool.add([&, t]()
+        {
+            auto c = counts[t];
+            for (PointId idx = chunkStart(t); idx < chunkStart(t + 1); ++idx)
+            {
+                int8_t label = labels[idx];
+                if (label >= 0)
+                    groupIds[label][c[label]++] = idx;
+            }
+        });
+    pool.await();
+
+    firstView->appendPoints(*inView, groupIds[0].data(), groupIds[0].size());
+    intermediateView->appendPoints(*inView, groupIds[1].data(),
+        groupIds[1].size());
+    lastView->appendPoints(*inView, groupIds[2].data(), groupIds[2].size());
+    onlyView->appendPoints(*inView, groupIds[3].data(), groupIds[3].size());
+
     if (m_outputTypes & returnFirst)
     {
         if (firstView->size())
@@ -36,7 +36,9 @@
 
 #include <pdal/util/ProgramArgs.hpp>
 
+#include <cmath>
 #include <string>
+#include <thread>
 
 namespace pdal
 {
@@ -58,6 +60,8 @@ void SampleFilter::addArgs(ProgramArgs& args)
 {
     m_cellArg = &args.add("cell", "Cell size", m_cell);
     m_radiusArg = &args.add("radius", "Minimum radius", m_radius);
+    args.add("threads", "Number of threads used to run this filter",
+        m_threads, 1);
 }
 
 void SampleFilter::prepared(PointTableRef table)
@@ -71,7 +75,8 @@ void SampleFilter::prepared(PointTableRef table)
 
 void SampleFilter::ready(PointTableRef)
 {
-    m_populatedVoxels.clear();
+    m_populatedVoxels.reset();
+    m_originSet = false;
 
     if (m_cellArg->set())
         m_radius = m_cell / 2.0 * std::sqrt(3.0);
@@ -88,17 +93,68 @@ void SampleFilter::ready(PointTableRef)
 PointViewSet SampleFilter::run(PointViewPtr view)
 {
     PointViewPtr output = view->makeNew();
-    for (PointRef point : *view)
-    {
-        if (voxelize(point))
-            output->appendPoint(*view, point.pointId());
-    }
+    if (m_threads > 1)
+        sampleParallel(*view, *output);
+    else
+        for (PointRef point : *view)
+        {
+            if (voxelize(point))
+                output->appendPoint(*view, point.pointId());
+        }
 
     PointViewSet viewSet;
     viewSet.insert(output);
     return viewSet;
 }
 
+// Determine whether any committed sample within the voxel containing
+// the position or one of its immediate neighbors violates the minimum
+// distance criterion.
+bool SampleFilter::conflicts(double x, double y, double z, int xv, int yv,
+    int zv) const
+{
+    auto tooClose = [&](const CoordList& coords)
+    {
+        for (VoxelCoordMap::Coord const& coord : coords)
+        {
+            // Compute Euclidean distance between current point and
+            // candidate sample.
+            double distSqr = (coord.m_x - x) * (coord.m_x - x) +
+                (coord.m_y - y) * (coord.m_y - y) +
+                (coord.m_z - z) * (coord.m_z - z);
+
+            // If any point is closer than the minimum radius, the
+            // minimum distance criterion is violated.
+            if (distSqr < m_radiusSqr)
+                return true;
+        }
+        return false;
+    };
+
+    // Check current voxel before any of the neighbors. We will most often
+    // have points that are too close in the point's enclosing voxel, thus
+    // saving cycles.
+    const CoordList *coords = m_populatedVoxels.find(xv, yv, zv);
+    if (coords && tooClose(*coords))
+        return true;
+
+    // Iterate over immediate neighbors of current voxel, computing minimum
+    // distance between any already added point and the current point.
+    for (int xi = xv - 1; xi < xv + 2; ++xi)
+        for (int yi = yv - 1; yi < yv + 2; ++yi)
+            for (int zi = zv - 1; zi < zv + 2; ++zi)
+            {
+                // We have already visited the center voxel, and can skip it.
+                if (xi == xv && yi == yv && zi == zv)
+                    continue;
+
+                coords = m_populatedVoxels.find(xi, yi, zi);
+                if (coords && tooClose(*coords))
+                    return true;
+            }
+    return false;
+}
+
 bool SampleFilter::voxelize(PointRef& point)
 {
     double x = point.getFieldAs<double>(Id::X);
@@ -107,96 +163,98 @@ bool SampleFilter::voxelize(PointRef& point)
 
     // Use the coordinates of the first point as origin to offset data and
     // derive integer voxel indices.
-    if (m_populatedVoxels.empty())
+    if (!m_originSet)
     {
-	m_originX = x;
+        m_originX = x;
         m_originY = y;
         m_originZ = z;
+        m_originSet = true;
     }
 
     // Get voxel indices for current point.
-    Voxel v = std::make_tuple((int)(std::floor((x - m_originX) / m_cell)),
-                              (int)(std::floor((y - m_originY) / m_cell)),
-                              (int)(std::floor((z - m_originZ) / m_cell)));
-
-    // Check current voxel before any of the neighbors. We will most often have
-    // points that are too close in the point's enclosing voxel, thus saving
-    // cycles.
-    if (m_populatedVoxels.find(v) != m_populatedVoxels.end())
+    int xv = (int)(std::floor((x - m_originX) / m_cell));
+    int yv = (int)(std::floor((y - m_originY) / m_cell));
+    int zv = (int)(std::floor((z - m_originZ) / m_cell));
+
+    if (conflicts(x, y, z, xv, yv, zv))
+        return false;
+
+    m_populatedVoxels.at(xv, yv, zv).push_back({ x, y, z });
+    return true;
+}
+
+// Process the input in blocks.  Within a block, points are tested
+// against the committed samples on several threads; survivors are then
+// committed serially in input order, rechecking against the samples
+// committed earlier in the same block.  Conflicts only ever grow, so
+// this reproduces the serial greedy result exactly.
+void SampleFilter::sampleParallel(PointView& input, PointView& output)
+{
+    if (input.empty())
+        return;
+
+    if (!m_originSet)
     {
-        // Get list of coordinates in candidate voxel.
-        CoordList coords = m_populatedVoxels[v];
-        for (Coord const& coord : coords)
-        {
-            // Compute Euclidean distance between current point and
-            // candidate voxel.
-            double xv = std::get<0>(coord);
-            double yv = std::get<1>(coord);
-            double zv = std::get<2>(coord);
-            double distSqr =
-                (xv - x) * (xv - x) + (yv - y) * (yv - y) + (zv - z) * (zv - z);
-
-            // If any point is closer than the minimum radius, we can
-            // immediately return false, as the minimum distance
-            // criterion is violated.
-            if (distSqr < m_radiusSqr)
-                return false;
-        }
+        PointRef first = input.point(0);
+        m_originX = first.getFieldAs<double>(Id::X);
+        m_originY = first.getFieldAs<double>(Id::Y);
+        m_originZ = first.getFieldAs<double>(Id::Z);
+        m_originSet = true;
     }
 
-    // Iterate over immediate neighbors of current voxel, computing minimum
-    // distance between any already added point and the current point.
-    for (int xi = std::get<0>(v) - 1; xi < std::get<0>(v) + 2; ++xi)
+    const PointId BlockSize = 1024 * 1024;
+
+    std::vector<PointId> kept;
+    std::vector<char> pass(BlockSize);
+    for (PointId start = 0; start < input.size(); start += BlockSize)
     {
-        for (int yi = std::get<1>(v) - 1; yi < std::get<1>(v) + 2; ++yi)
+        PointId end = (std::min)((PointId)(start + BlockSize), input.size());
+        point_count_t count = end - start;
+
+        // Parallel phase: test against the samples committed before
+        // this block.  The voxel map is read-only here.
+        int threads = (int)(std::min)((point_count_t)m_threads, count);
+        std::vector<std::thread> threadList(threads);
+        for (int t = 0; t < threads; t++)
         {
-            for (int zi = std::get<2>(v) - 1; zi < std::get<2>(v) + 2; ++zi)
+            PointId tStart = start + t * count / threads;
+            PointId tEnd = (t + 1) == threads ?
+                end : start + (t + 1) * count / threads;
+            threadList[t] = std::thread([&, tStart, tEnd]()
             {
-                Voxel candidate = std::make_tuple(xi, yi, zi);
-
-                // We have already visited the center voxel, and can skip it.
-                if (v == candidate)
-                    continue;
-
-                // Check that candidate voxel is occupied.
-                if (m_populatedVoxels.find(candidate) ==
-                    m_populatedVoxels.end())
-                    continue;
-
-                // Get list of coordinates in candidate voxel.
-                CoordList coords = m_populatedVoxels[candidate];
-                for (Coord const& coord : coords)
+                PointRef point = input.point(0);
+                for (PointId id = tStart; id < tEnd; ++id)
                 {
-                    // Compute Euclidean distance between current point and
-                    // candidate voxel.
-                    double xv = std::get<0>(coord);
-                    double yv = std::get<1>(coord);
-                    double zv = std::get<2>(coord);
-                    double distSqr = (xv - x) * (xv - x) + (yv - y) * (yv - y) +
-                                     (zv - z) * (zv - z);
-
-                    // If any point is closer than the minimum radius, we can
-                    // immediately return false, as the minimum distance
-                    // criterion is violated.
-                    if (distSqr < m_radiusSqr)
-                        return false;
+                    point.setPointId(id);
+                    double x = point.getFieldAs<double>(Id::X);
+                    double y = point.getFieldAs<double>(Id::Y);
+                    double z = point.getFieldAs<double>(Id::Z);
+
+                    int xv = (int)(std::floor((x - m_originX) / m_cell));
+                    int yv = (int)(std::floor((y - m_originY) / m_cell));
+                    int zv = (int)(std::floor((z - m_originZ) / m_cell));
+                    pass[id - start] = !conflicts(x, y, z, xv, yv, zv);
                 }
-            }
+            });
         }
-    }
+        for (auto& t : threadList)
+            t.join();
 
-    Coord coord = std::make_tuple(x, y, z);
-    if (m_populatedVoxels.find(v) != m_populatedVoxels.end())
-    {
-        m_populatedVoxels[v].push_back(coord);
-    }
-    else
-    {
-        CoordList coords;
-        coords.push_back(coord);
-        m_populatedVoxels.emplace(v, coords);
+        // Commit phase: survivors may still conflict with samples
+        // committed earlier in this block, so they're rechecked in
+        // order.  Survivors are few, so this part stays small.
+        PointRef point = input.point(0);
+        for (PointId id = start; id < end; ++id)
+        {
+            if (!pass[id - start])
+                continue;
+            point.setPointId(id);
+            if (voxelize(point))
+                kept.push_back(id);
+        }
     }
-    return true;
+
+    output.appendPoints(input, kept.data(), kept.size());
 }
 
 bool SampleFilter::processOne(PointRef& point)
@@ -37,14 +37,14 @@
 #include <pdal/Filter.hpp>
 #include <pdal/Streamable.hpp>
 
+#include "private/VoxelSet.hpp"
+
 namespace pdal
 {
 
 class PDAL_DLL SampleFilter : public Filter, public Streamable
 {
-    using Voxel = std::tuple<int, int, int>;
-    using Coord = std::tuple<double, double, double>;
-    using CoordList = std::vector<Coord>;
+    using CoordList = VoxelCoordMap::CoordList;
 
 public:
     SampleFilter() : Filter() {}
@@ -62,7 +62,9 @@ private:
     double m_originX;
     double m_originY;
     double m_originZ;
-    std::map<Voxel, CoordList> m_populatedVoxels;
+    bool m_originSet;
+    int m_threads;
+    VoxelCoordMap m_populatedVoxels;
 
     virtual void addArgs(ProgramArgs& args);
     virtual void prepared(PointTableRef table);
@@ -71,6 +73,9 @@ private:
     virtual PointViewSet run(PointViewPtr view);
 
     bool voxelize(PointRef& point);
+    bool conflicts(double x, double y, double z, int xv, int yv,
+        int zv) const;
+    void sampleParallel(PointView& input, PointView& output);
 };
 
 } // namespace pdal
@@ -60,6 +60,12 @@ void SeparateScanLineFilter::addArgs(ProgramArgs& args)
     args.add("groupby", "Number of lines to be grouped by", m_groupBy, (uint64_t) 1u);
 }
 
+void SeparateScanLineFilter::addDimensions(PointLayoutPtr layout)
+{
+    m_scanLineDim = layout->registerOrAssignDim("ScanLine",
+        Dimension::Type::Unsigned64);
+}
+
 void SeparateScanLineFilter::prepared(PointTableRef table)
 {
     PointLayoutPtr layout(table.layout());
@@ -67,30 +73,49 @@ void SeparateScanLineFilter::prepared(PointTableRef table)
         throwError("Layout does not contains EdgeOfFlightLine dimension.");
 }
 
+void SeparateScanLineFilter::ready(PointTableRef)
+{
+    m_group = 1;
+    m_lineNum = 1;
+}
+
+bool SeparateScanLineFilter::processOne(PointRef& point)
+{
+    point.setField(m_scanLineDim, m_group);
+    if (point.getFieldAs<uint8_t>(Dimension::Id::EdgeOfFlightLine))
+    {
+        if (++m_lineNum > m_groupBy)
+        {
+            m_group++;
+            m_lineNum = 1;
+        }
+    }
+    return true;
+}
+
 PointViewSet SeparateScanLineFilter::run(PointViewPtr inView)
 {
     PointViewSet result;
     PointViewPtr v(inView->makeNew());
     result.insert(v);
-    
-    uint64_t lineNum = 1;
+
     for (PointId i = 0; i < inView->size();++i)
     {
+        // Tag before appending so the copy picks up the group number.
+        PointRef point = inView->point(i);
+        uint64_t group = m_group;
+        processOne(point);
         v->appendPoint(*inView, i);
-        if (inView->getFieldAs<uint8_t>(Dimension::Id::EdgeOfFlightLine, i))
+        if (m_group != group)
         {
-            if (++lineNum > m_groupBy)
-            {
-                v = inView->makeNew();
-                result.insert(v);
-                lineNum = 1;
-            }
+            v = inView->makeNew();
+            result.insert(v);
         }
     }
     //if last point was an edge of flight line
     if (v->empty())
         result.erase(v);
-    
+
     return result;
 }
 
@@ -35,6 +35,7 @@
 #pragma once
 
 #include <pdal/Filter.hpp>
+#include <pdal/Streamable.hpp>
 
 namespace pdal
 {
@@ -42,7 +43,7 @@ namespace pdal
 class PointView;
 class ProgramArgs;
 
-class PDAL_DLL SeparateScanLineFilter : public Filter
+class PDAL_DLL SeparateScanLineFilter : public Filter, public Streamable
 {
 public:
     SeparateScanLineFilter();
@@ -53,9 +54,16 @@ public:
 
 private:
     uint64_t m_groupBy;
+    Dimension::Id m_scanLineDim;
+    // Current scan line group (1-based) and line count within it.
+    uint64_t m_group;
+    uint64_t m_lineNum;
 
     virtual void addArgs(ProgramArgs& args);
+    virtual void addDimensions(PointLayoutPtr layout);
     virtual void prepared(PointTableRef table);
+    virtual void ready(PointTableRef table);
+    virtual bool processOne(PointRef& point);
     virtual PointViewSet run(PointViewPtr view);
 };
 
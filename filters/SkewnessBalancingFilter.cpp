@@ -34,7 +34,17 @@
 
 #include "SkewnessBalancingFilter.hpp"
 
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <utility>
+#include <vector>
+
 #include <pdal/util/ProgramArgs.hpp>
+#include <pdal/util/ThreadPool.hpp>
+
+#include "private/ParallelSort.hpp"
 
 namespace pdal
 {
@@ -58,10 +68,39 @@ void SkewnessBalancingFilter::addDimensions(PointLayoutPtr layout)
 
 void SkewnessBalancingFilter::processGround(PointViewPtr view)
 {
-    auto cmp = [](const PointRef& p1, const PointRef& p2) {
-        return p1.compare(Dimension::Id::Z, p2);
-    };
-    std::sort(view->begin(), view->end(), cmp);
+    // Sort by Z with a parallel radix sort on bit-exact keys in place of
+    // the old comparison sort.  The skewness pass that follows already
+    // maintains the moment sums incrementally, so the sort is the only
+    // superlinear piece of the filter.
+    point_count_t numPts = view->size();
+    size_t threads = threadCount(numPts);
+    ThreadPool pool(threads);
+    auto chunkStart = [numPts, threads](size_t t)
+        { return t * numPts / threads; };
+
+    std::vector<std::pair<uint64_t, PointId>> keys(numPts);
+    for (size_t t = 0; t < threads; ++t)
+        pool.add([&, t]()
+        {
+            for (PointId i = chunkStart(t); i < chunkStart(t + 1); ++i)
+                keys[i] = { sortableKey(
+                    view->getFieldAs<double>(Dimension::Id::Z, i)), i };
+        });
+    pool.await();
+    radixSort(keys, pool, threads);
+
+    // Reorder the view to match, walking each permutation cycle.  'inv'
+    // maps a point's current position to its sorted position.
+    std::vector<PointId> inv(numPts);
+    for (PointId i = 0; i < numPts; ++i)
+        inv[keys[i].second] = i;
+    for (PointId i = 0; i < numPts; ++i)
+        while (inv[i] != i)
+        {
+            PointId j = inv[i];
+            swap(view->point(i), view->point(j));
+            std::swap(inv[i], inv[j]);
+        }
 
     auto setClass = [&view](PointId first, PointId last, int cl)
     {
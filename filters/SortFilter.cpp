@@ -34,6 +34,18 @@
 
 #include "SortFilter.hpp"
 
+#include <algorithm>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <queue>
+#include <random>
+
+#include <arbiter/arbiter.hpp>
+
+#include <pdal/util/FileUtils.hpp>
+#include <pdal/util/ThreadPool.hpp>
+
 namespace pdal
 {
 
@@ -46,6 +58,48 @@ static StaticPluginInfo const s_info
 
 CREATE_STATIC_STAGE(SortFilter, s_info)
 
+// State for stream-mode external merge sorting.  Incoming points are
+// packed into fixed-size runs, each run is sorted on a worker thread and
+// spilled to a temporary file, and the runs are merge-streamed downstream
+// once the input is exhausted.
+struct SortFilter::Private
+{
+    // A spilled run being merged.  Records are [key][packed point].
+    struct Run
+    {
+        std::ifstream stream;
+        uint64_t remaining = 0;
+        double key = 0;
+        std::vector<char> record;
+    };
+
+    DimTypeList dimTypes;
+    size_t packedSize = 0;
+    unsigned token = 0;
+
+    // Run being accumulated.  'keys' pairs each point's sort key with its
+    // arrival order so that the sort is stable.
+    std::vector<char> runBuf;
+    std::vector<std::pair<double, uint32_t>> keys;
+
+    std::vector<std::string> runFiles;
+    std::unique_ptr<ThreadPool> pool;
+    std::mutex mutex;
+    std::condition_variable cv;
+    size_t inFlight = 0;
+    std::string error;
+
+    // Merge state.
+    bool draining = false;
+    std::vector<Run> runs;
+};
+
+SortFilter::SortFilter() : m_p(new Private)
+{}
+
+SortFilter::~SortFilter()
+{}
+
 std::string SortFilter::getName() const { return s_info.name; }
 
 void SortFilter::addArgs(ProgramArgs& args)
@@ -54,6 +108,11 @@ void SortFilter::addArgs(ProgramArgs& args)
         setPositional();
     args.add("order", "Sort order ASC(ending) or DESC(ending)", m_order,
         SortOrder::ASC);
+    args.add("run_points", "Number of points per sorted run spilled to "
+        "temporary storage (stream mode only)", m_runPoints,
+        (point_count_t)10000000);
+    args.add("threads", "Number of threads used to sort in-memory "
+        "(non-stream) views", m_threads, 1);
 }
 
 void SortFilter::prepared(PointTableRef table)
@@ -61,17 +120,258 @@ void SortFilter::prepared(PointTableRef table)
     m_dim = table.layout()->findDim(m_dimName);
     if (m_dim == Dimension::Id::Unknown)
         throwError("Dimension '" + m_dimName + "' not found.");
+    if (m_runPoints == 0)
+        throwError("Option 'run_points' must be positive.");
 }
 
 void SortFilter::filter(PointView& view)
 {
-    auto cmp = [this](const PointRef& p1, const PointRef& p2)
+    point_count_t n = view.size();
+    if (n < 2)
+        return;
+
+    // Pull each point's key once into a scratch array rather than
+    // fetching fields in every comparison.  Pairing the key with the
+    // original position keeps the sort stable.
+    std::vector<std::pair<double, PointId>> keys(n);
+
+    bool asc = (m_order == SortOrder::ASC);
+    auto cmp = [asc](const std::pair<double, PointId>& a,
+        const std::pair<double, PointId>& b)
     {
-        bool result = p1.compare(m_dim, p2);
-        return (m_order == SortOrder::ASC) ? result : !result;
+        if (a.first != b.first)
+            return asc ? a.first < b.first : a.first > b.first;
+        return a.second < b.second;
     };
 
-    std::stable_sort(view.begin(), view.end(), cmp);
+    // Chunks smaller than this don't pay for their thread.
+    const point_count_t minChunk = 65536;
+    size_t threads = (std::max)(m_threads, 1);
+    threads = (std::min)(threads, (size_t)(n / minChunk) + 1);
+
+    if (threads == 1)
+    {
+        for (PointId i = 0; i < n; ++i)
+            keys[i] = { view.getFieldAs<double>(m_dim, i), i };
+        std::sort(keys.begin(), keys.end(), cmp);
+    }
+    else
+    {
+        // Extract and sort equal chunks concurrently, then merge
+        // adjacent chunk pairs, halving the chunk count each round.
+        std::vector<size_t> bounds;
+        for (size_t i = 0; i <= threads; ++i)
+            bounds.push_back((size_t)(n * i / threads));
+
+        ThreadPool pool(threads);
+        for (size_t c = 0; c < threads; ++c)
+            pool.add([this, &view, &keys, &cmp, &bounds, c]()
+            {
+                for (size_t i = bounds[c]; i < bounds[c + 1]; ++i)
+                    keys[i] =
+                        { view.getFieldAs<double>(m_dim, i), (PointId)i };
+                std::sort(keys.begin() + bounds[c],
+                    keys.begin() + bounds[c + 1], cmp);
+            });
+        pool.await();
+
+        while (bounds.size() > 2)
+        {
+            std::vector<size_t> merged { bounds.front() };
+            for (size_t i = 0; i + 2 < bounds.size(); i += 2)
+            {
+                pool.add([&keys, &cmp, &bounds, i]()
+                {
+                    std::inplace_merge(keys.begin() + bounds[i],
+                        keys.begin() + bounds[i + 1],
+                        keys.begin() + bounds[i + 2], cmp);
+                });
+                merged.push_back(bounds[i + 2]);
+            }
+            // An odd chunk count leaves the last chunk unpaired.
+            if (bounds.size() % 2 == 0)
+                merged.push_back(bounds.back());
+            pool.await();
+            bounds = std::move(merged);
+        }
+    }
+
+    // Apply the resulting permutation to the view's index by walking
+    // its cycles.  dest[i] is where the point at position i belongs.
+    std::vector<PointId> dest(n);
+    for (PointId i = 0; i < n; ++i)
+        dest[keys[i].second] = i;
+    for (PointId i = 0; i < n; ++i)
+        while (dest[i] != i)
+        {
+            PointId d = dest[i];
+            std::iter_swap(view.begin() + i, view.begin() + d);
+            std::swap(dest[i], dest[d]);
+        }
+}
+
+void SortFilter::ready(PointTableRef table)
+{
+    m_p->dimTypes = table.layout()->dimTypes();
+    m_p->packedSize = 0;
+    for (const DimType& d : m_p->dimTypes)
+        m_p->packedSize += Dimension::size(d.m_type);
+    m_p->token = std::random_device()();
+
+    // Two workers sorting/spilling while another run accumulates bounds
+    // resident memory to about three runs.
+    m_p->pool.reset(new ThreadPool(2));
+    m_p->draining = false;
+}
+
+// Accumulate the point into the current run and withhold it.  Points are
+// emitted in sorted order through drainOne once the input is exhausted.
+bool SortFilter::processOne(PointRef& point)
+{
+    size_t pos = m_p->runBuf.size();
+    m_p->runBuf.resize(pos + m_p->packedSize);
+    point.getPackedData(m_p->dimTypes, m_p->runBuf.data() + pos);
+    m_p->keys.push_back(
+        { point.getFieldAs<double>(m_dim), (uint32_t)m_p->keys.size() });
+
+    if (m_p->keys.size() >= m_runPoints)
+        spillRun();
+    return false;
+}
+
+// Hand the current run to a worker thread to be sorted and written to a
+// temporary file.
+void SortFilter::spillRun()
+{
+    if (m_p->keys.empty())
+        return;
+
+    // Limit the number of runs being sorted or waiting to be sorted.
+    std::unique_lock<std::mutex> l(m_p->mutex);
+    m_p->cv.wait(l, [this]()
+        { return m_p->inFlight < m_p->pool->numThreads(); });
+    m_p->inFlight++;
+    l.unlock();
+
+    std::string path = arbiter::join(arbiter::getTempPath(),
+        "pdal-sort-" + std::to_string(m_p->token) + "-" +
+        std::to_string(m_p->runFiles.size()) + ".tmp");
+    m_p->runFiles.push_back(path);
+
+    auto buf = std::make_shared<std::vector<char>>(std::move(m_p->runBuf));
+    auto keys = std::make_shared<std::vector<std::pair<double, uint32_t>>>(
+        std::move(m_p->keys));
+    m_p->runBuf.clear();
+    m_p->keys.clear();
+
+    bool asc = (m_order == SortOrder::ASC);
+    size_t packedSize = m_p->packedSize;
+    m_p->pool->add([this, buf, keys, path, asc, packedSize]()
+    {
+        std::sort(keys->begin(), keys->end(),
+            [asc](const std::pair<double, uint32_t>& a,
+                const std::pair<double, uint32_t>& b)
+            {
+                if (a.first != b.first)
+                    return asc ? a.first < b.first : a.first > b.first;
+                return a.second < b.second;
+            });
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        for (const auto& k : *keys)
+        {
+            out.write(reinterpret_cast<const char *>(&k.first),
+                sizeof(k.first));
+            out.write(buf->data() + (size_t)k.second * packedSize,
+                packedSize);
+        }
+        out.close();
+
+        std::unique_lock<std::mutex> l(m_p->mutex);
+        if (!out)
+            m_p->error = "Couldn't write sort run to '" + path + "'.";
+        m_p->inFlight--;
+        l.unlock();
+        m_p->cv.notify_one();
+    });
+}
+
+// Merge-stream the spilled runs.  Called repeatedly by the streaming
+// engine once the input is exhausted.
+bool SortFilter::drainOne(PointRef& point)
+{
+    if (!m_p->draining)
+    {
+        // Spill whatever remains of the last run, wait for the sorters
+        // and open the runs for merging.
+        spillRun();
+        m_p->pool->await();
+        if (m_p->error.size())
+            throwError(m_p->error);
+
+        m_p->runs.resize(m_p->runFiles.size());
+        for (size_t i = 0; i < m_p->runFiles.size(); ++i)
+        {
+            Private::Run& run = m_p->runs[i];
+            run.stream.open(m_p->runFiles[i], std::ios::binary);
+            if (!run.stream)
+                throwError("Couldn't read sort run from '" +
+                    m_p->runFiles[i] + "'.");
+            run.stream.seekg(0, std::ios::end);
+            run.remaining =
+                run.stream.tellg() / (sizeof(double) + m_p->packedSize);
+            run.stream.seekg(0);
+            run.record.resize(m_p->packedSize);
+            if (run.remaining)
+            {
+                run.stream.read(reinterpret_cast<char *>(&run.key),
+                    sizeof(run.key));
+                run.stream.read(run.record.data(), m_p->packedSize);
+            }
+        }
+        m_p->draining = true;
+    }
+
+    // Find the run whose head comes first.  Ties go to the earlier run,
+    // keeping the merge stable.
+    Private::Run *best = nullptr;
+    for (Private::Run& run : m_p->runs)
+    {
+        if (!run.remaining)
+            continue;
+        if (!best || (m_order == SortOrder::ASC ?
+                run.key < best->key : run.key > best->key))
+            best = &run;
+    }
+    if (!best)
+        return false;
+
+    point.setPackedData(m_p->dimTypes, best->record.data());
+
+    // Advance the winning run.
+    best->remaining--;
+    if (best->remaining)
+    {
+        best->stream.read(reinterpret_cast<char *>(&best->key),
+            sizeof(best->key));
+        best->stream.read(best->record.data(), m_p->packedSize);
+        if (!best->stream)
+            throwError("Unexpected end of sort run.");
+    }
+    return true;
+}
+
+void SortFilter::done(PointTableRef)
+{
+    if (m_p->pool)
+        m_p->pool->await();
+    m_p->runs.clear();
+    for (const std::string& path : m_p->runFiles)
+        FileUtils::deleteFile(path);
+    m_p->runFiles.clear();
+    m_p->runBuf = std::vector<char>();
+    m_p->keys = std::vector<std::pair<double, uint32_t>>();
+    m_p->draining = false;
 }
 
 std::istream& operator >> (std::istream& in, SortOrder& order)
@@ -102,4 +402,3 @@ std::ostream& operator<<(std::ostream& out, const SortOrder& order)
 }
 
 } // namespace pdal
-
@@ -34,7 +34,10 @@
 
 #pragma once
 
+#include <memory>
+
 #include <pdal/Filter.hpp>
+#include <pdal/Streamable.hpp>
 #include <pdal/util/ProgramArgs.hpp>
 
 namespace pdal
@@ -50,11 +53,11 @@ std::istream& operator >> (std::istream& in, SortOrder& order);
 std::ostream& operator << (std::ostream& in, const SortOrder& order);
 
 
-class PDAL_DLL SortFilter : public Filter
+class PDAL_DLL SortFilter : public Filter, public Streamable
 {
 public:
-    SortFilter()
-    {}
+    SortFilter();
+    ~SortFilter();
 
     std::string getName() const;
 
@@ -67,9 +70,26 @@ private:
     // Sort order.
     SortOrder m_order;
 
+    // Points per sorted run spilled to temporary storage in stream mode.
+    point_count_t m_runPoints;
+
+    // Threads used to sort in-memory views.
+    int m_threads;
+
     virtual void addArgs(ProgramArgs& args);
     virtual void prepared(PointTableRef table);
     virtual void filter(PointView& view);
+    virtual void ready(PointTableRef table);
+    virtual bool processOne(PointRef& point);
+    virtual bool deferred() const
+    { return true; }
+    virtual bool drainOne(PointRef& point);
+    virtual void done(PointTableRef table);
+
+    void spillRun();
+
+    struct Private;
+    std::unique_ptr<Private> m_p;
 
     SortFilter& operator=(const SortFilter&) = delete;
     SortFilter(const SortFilter&) = delete;
@@ -34,9 +34,12 @@
 
 #include "SplitterFilter.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <limits>
+#include <utility>
+#include <vector>
 
 #include <pdal/util/ProgramArgs.hpp>
 
@@ -145,12 +148,15 @@ PointViewSet SplitterFilter::run(PointViewPtr inView)
     if (!inView->size())
         return viewSet;
 
-    auto addPoint = [this, &inView](PointRef& point, int xpos, int ypos) {
-        Coord loc(xpos, ypos);
-        PointViewPtr& outView = m_viewMap[loc];
-        if (!outView)
-            outView = inView->makeNew();
-        outView->appendPoint(*inView.get(), point.pointId());
+    // Collect tile assignments instead of appending points to per-tile
+    // views as we go.  A single sort of the assignments groups each tile's
+    // points into a contiguous run that can be moved into its view in one
+    // shot, which avoids incrementally growing what may be many thousands
+    // of per-tile indexes.
+    std::vector<std::pair<Coord, PointId>> assignments;
+    assignments.reserve(inView->size());
+    auto addPoint = [&assignments](PointRef& point, int xpos, int ypos) {
+        assignments.emplace_back(Coord(xpos, ypos), point.pointId());
     };
 
     // Use the location of the first point as the origin, unless specified.
@@ -169,6 +175,33 @@ PointViewSet SplitterFilter::run(PointViewPtr inView)
         processPoint(point, addPoint);
     }
 
+    // Stable sort keeps points within a tile in input order, matching the
+    // order in which they would have been appended.
+    CoordCompare compare;
+    std::stable_sort(assignments.begin(), assignments.end(),
+        [&compare](const std::pair<Coord, PointId>& a1,
+            const std::pair<Coord, PointId>& a2)
+        { return compare(a1.first, a2.first); });
+
+    // Each tile is now a contiguous run of assignments.  Build its view
+    // with a single exactly-sized append.
+    std::vector<PointId> ids;
+    auto ai = assignments.begin();
+    while (ai != assignments.end())
+    {
+        const Coord loc = ai->first;
+        ids.clear();
+        do
+        {
+            ids.push_back(ai->second);
+            ++ai;
+        } while (ai != assignments.end() && ai->first == loc);
+
+        PointViewPtr outView = inView->makeNew();
+        outView->appendPoints(*inView.get(), ids.data(), ids.size());
+        m_viewMap[loc] = outView;
+    }
+
     // Pull the buffers out of the map and stick them in the standard
     // output set.
     for (auto bi = m_viewMap.begin(); bi != m_viewMap.end(); ++bi)
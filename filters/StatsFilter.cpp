@@ -35,12 +35,14 @@
 #include "StatsFilter.hpp"
 
 #include <cmath>
+#include <thread>
 #include <unordered_map>
 
 #include <pdal/Options.hpp>
 #include <pdal/Polygon.hpp>
 #include <pdal/PDALUtils.hpp>
 #include <pdal/util/ProgramArgs.hpp>
+#include <pdal/util/ThreadPool.hpp>
 
 namespace pdal
 {
@@ -184,14 +186,63 @@ bool StatsFilter::processOne(PointRef& point)
 }
 
 
+namespace
+{
+    // Views smaller than this are accumulated serially - the threading
+    // overhead isn't worth it and the serial path keeps results
+    // bit-identical for small data.
+    const point_count_t minParallelSize = 100000;
+}
+
+
 void StatsFilter::filter(PointView& view)
 {
-    PointRef point(view, 0);
-    for (PointId idx = 0; idx < view.size(); ++idx)
+    const size_t threads = (std::min)((size_t)(std::max)(
+        std::thread::hardware_concurrency(), 1U),
+        (size_t)(view.size() / minParallelSize));
+    if (threads <= 1)
     {
-        point.setPointId(idx);
-        processOne(point);
+        PointRef point(view, 0);
+        for (PointId idx = 0; idx < view.size(); ++idx)
+        {
+            point.setPointId(idx);
+            processOne(point);
+        }
+        return;
     }
+
+    // Accumulate per-thread partial summaries over chunks of the view and
+    // combine them with Summary::merge, which joins the moment sums
+    // exactly.  Merging in chunk order keeps the result independent of
+    // scheduling.
+    std::vector<std::map<Dimension::Id, Summary>> partials(threads);
+    for (size_t t = 0; t < threads; ++t)
+        for (auto& p : m_stats)
+            partials[t].insert(std::make_pair(p.first, p.second.partial()));
+
+    ThreadPool pool(threads);
+    for (size_t t = 0; t < threads; ++t)
+    {
+        std::map<Dimension::Id, Summary>& stats = partials[t];
+        const PointId start = t * view.size() / threads;
+        const PointId end =
+            (t + 1 == threads) ? view.size() : (t + 1) * view.size() / threads;
+        pool.add([&view, &stats, start, end]()
+        {
+            PointRef point(view, 0);
+            for (PointId idx = start; idx < end; ++idx)
+            {
+                point.setPointId(idx);
+                for (auto& p : stats)
+                    p.second.insert(point.getFieldAs<double>(p.first));
+            }
+        });
+    }
+    pool.join();
+
+    for (auto& partial : partials)
+        for (auto& p : partial)
+            m_stats.find(p.first)->second.merge(p.second);
 }
 
 
@@ -64,6 +64,10 @@ public:
     // Merge another summary with this one. 'name', 'enumerate' and 'advanced' must match
     // or false is returned and no merge occurs.
     bool merge(const Summary& s);
+    // Return an empty summary with the same configuration, suitable as a
+    // partial to be accumulated separately and combined with merge().
+    Summary partial() const
+        { return Summary(m_name, m_enumerate, m_advanced); }
     double minimum() const
         { return m_min; }
     double maximum() const
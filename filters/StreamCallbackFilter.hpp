@@ -55,6 +55,17 @@ public:
     void setCallback(CallbackFunc cb)
         { m_callback = cb; }
 
+    // Invoked once per table's worth of points in stream mode with the
+    // stream table (which provides the layout and point data) and the
+    // number of points it holds, so hosts pay one type-erased call per
+    // chunk instead of one per point.  The callback must honor
+    // table.skip() and may drop points with table.setSkip().  Takes
+    // precedence over the per-point callback when both are set.
+    typedef std::function<void(StreamPointTable&, point_count_t)>
+        BatchCallbackFunc;
+    void setBatchCallback(BatchCallbackFunc cb)
+        { m_batchCallback = cb; }
+
 private:
     virtual void filter(PointView& view)
     {
@@ -73,7 +84,21 @@ private:
         return false;
     }
 
+    virtual bool batchMode() const
+    {
+        return (bool)m_batchCallback;
+    }
+
+    virtual void processBatch(StreamPointTable& table, point_count_t count)
+    {
+        if (m_batchCallback)
+            m_batchCallback(table, count);
+        else
+            Streamable::processBatch(table, count);
+    }
+
     CallbackFunc m_callback;
+    BatchCallbackFunc m_batchCallback;
 
     StreamCallbackFilter&
         operator=(const StreamCallbackFilter&); // not implemented
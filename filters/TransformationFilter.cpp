@@ -33,10 +33,12 @@
 ****************************************************************************/
 
 #include "TransformationFilter.hpp"
+#include <pdal/private/MathUtils.hpp>
 #include <pdal/util/FileUtils.hpp>
 
 #include <Eigen/Dense>
 
+#include <algorithm>
 #include <sstream>
 
 namespace pdal
@@ -216,11 +218,41 @@ void TransformationFilter::filter(PointView& view)
         log()->get(LogLevel::Warning) << getName() <<
             ": overriding input spatial reference." << std::endl;
 
-    PointRef point(view, 0);
-    for (PointId idx = 0; idx < view.size(); ++idx)
+    // Only the upper three rows of the (affine) matrix contribute, so
+    // stage coordinates through the shared 3x4 block kernel instead of
+    // dispatching fields per point.
+    Transform& matrix = *m_matrix;
+    double m[12];
+    for (size_t i = 0; i < 12; ++i)
+        m[i] = matrix[i];
+
+    const size_t BlockSize = 1024;
+    double x[BlockSize];
+    double y[BlockSize];
+    double z[BlockSize];
+
+    TypedField<double> xf(view, Dimension::Id::X);
+    TypedField<double> yf(view, Dimension::Id::Y);
+    TypedField<double> zf(view, Dimension::Id::Z);
+
+    PointId idx = 0;
+    while (idx < view.size())
     {
-        point.setPointId(idx);
-        processOne(point);
+        size_t n = (std::min)((size_t)(view.size() - idx), BlockSize);
+        for (size_t i = 0; i < n; ++i)
+        {
+            x[i] = xf.get(idx + i);
+            y[i] = yf.get(idx + i);
+            z[i] = zf.get(idx + i);
+        }
+        math::transformCoords(n, x, y, z, m);
+        for (size_t i = 0; i < n; ++i)
+        {
+            xf.set(idx + i, x[i]);
+            yf.set(idx + i, y[i]);
+            zf.set(idx + i, z[i]);
+        }
+        idx += n;
     }
     view.invalidateProducts();
 }
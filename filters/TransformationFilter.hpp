@@ -63,6 +63,10 @@ private:
     virtual bool processOne(PointRef& point) override;
     virtual void filter(PointView& view) override;
     virtual void spatialReferenceChanged(const SpatialReference& srs) override;
+    // filter() only reads m_matrix and writes the passed view's points,
+    // so views can be processed concurrently.
+    virtual bool viewThreadSafe() const override
+    { return true; }
 
     std::unique_ptr<Transform> m_matrix;
     SpatialReference m_overrideSrs;
@@ -34,6 +34,8 @@
 
 #include "VoxelCentroidNearestNeighborFilter.hpp"
 
+#include <cmath>
+#include <deque>
 #include <map>
 #include <string>
 #include <tuple>
@@ -55,6 +57,90 @@ static StaticPluginInfo const s_info
 
 CREATE_STATIC_STAGE(VoxelCentroidNearestNeighborFilter, s_info)
 
+// Stream-mode state.  Incoming points are withheld in their voxel; a
+// voxel is finalized once the input hasn't landed in it for
+// 'stream_window' points, and its representative is relayed downstream
+// in place of a later incoming point (or during the drain phase).
+// Resident memory is bounded by the points arriving within the window
+// rather than the whole cloud.
+struct VoxelCentroidNearestNeighborFilter::Private
+{
+    using Key = std::tuple<int64_t, int64_t, int64_t>;
+
+    struct Voxel
+    {
+        double sx = 0;
+        double sy = 0;
+        double sz = 0;
+        uint64_t lastTouch = 0;
+        std::vector<char> records;  // packed points
+        std::vector<double> coords; // x, y, z per point
+    };
+
+    DimTypeList dimTypes;
+    size_t packedSize = 0;
+
+    bool haveOrigin = false;
+    double x0 = 0;
+    double y0 = 0;
+    double z0 = 0;
+    uint64_t seen = 0;
+
+    std::map<Key, Voxel> voxels;
+    std::deque<std::vector<char>> ready;
+    bool drained = false;
+
+    // Index of the voxel point nearest the given query position.
+    size_t closest(const Voxel& v, double cx, double cy, double cz) const
+    {
+        size_t n = v.coords.size() / 3;
+        size_t best = 0;
+        double dmin = (std::numeric_limits<double>::max)();
+        for (size_t i = 0; i < n; ++i)
+        {
+            double dx = cx - v.coords[3 * i];
+            double dy = cy - v.coords[3 * i + 1];
+            double dz = cz - v.coords[3 * i + 2];
+            double d = dx * dx + dy * dy + dz * dz;
+            if (d < dmin)
+            {
+                dmin = d;
+                best = i;
+            }
+        }
+        return best;
+    }
+
+    // Pick the voxel's representative - same ruleset as the whole-view
+    // path - and queue its packed record for emission.
+    void finalize(const Key& key, Voxel& v, double cell)
+    {
+        size_t n = v.coords.size() / 3;
+        size_t best = 0;
+        if (n == 2)
+        {
+            // Two points are equidistant from their centroid, so use
+            // the voxel center.
+            best = closest(v,
+                x0 + (std::get<1>(key) + 0.5) * cell,
+                y0 + (std::get<0>(key) + 0.5) * cell,
+                z0 + (std::get<2>(key) + 0.5) * cell);
+        }
+        else if (n > 2)
+            best = closest(v, v.sx / n, v.sy / n, v.sz / n);
+        ready.push_back(std::vector<char>(
+            v.records.begin() + best * packedSize,
+            v.records.begin() + (best + 1) * packedSize));
+    }
+};
+
+VoxelCentroidNearestNeighborFilter::VoxelCentroidNearestNeighborFilter() :
+    m_p(new Private)
+{}
+
+VoxelCentroidNearestNeighborFilter::~VoxelCentroidNearestNeighborFilter()
+{}
+
 std::string VoxelCentroidNearestNeighborFilter::getName() const
 {
     return s_info.name;
@@ -63,6 +149,113 @@ std::string VoxelCentroidNearestNeighborFilter::getName() const
 void VoxelCentroidNearestNeighborFilter::addArgs(ProgramArgs& args)
 {
     args.add("cell", "Cell size", m_cell, 1.0);
+    args.add("stream_window", "Points a voxel may go untouched before "
+        "it's finalized (stream mode only)", m_streamWindow,
+        (point_count_t)1000000);
+}
+
+void VoxelCentroidNearestNeighborFilter::prepared(PointTableRef table)
+{
+    if (m_streamWindow == 0)
+        throwError("Option 'stream_window' must be positive.");
+}
+
+void VoxelCentroidNearestNeighborFilter::ready(PointTableRef table)
+{
+    m_p->dimTypes = table.layout()->dimTypes();
+    m_p->packedSize = 0;
+    for (const DimType& d : m_p->dimTypes)
+        m_p->packedSize += Dimension::size(d.m_type);
+    m_p->haveOrigin = false;
+    m_p->seen = 0;
+    m_p->voxels.clear();
+    m_p->ready.clear();
+    m_p->drained = false;
+}
+
+// Withhold the point in its voxel and relay a finalized voxel's
+// representative in its place when one is pending.
+bool VoxelCentroidNearestNeighborFilter::processOne(PointRef& point)
+{
+    Private& s = *m_p;
+
+    double x = point.getFieldAs<double>(Dimension::Id::X);
+    double y = point.getFieldAs<double>(Dimension::Id::Y);
+    double z = point.getFieldAs<double>(Dimension::Id::Z);
+    if (!s.haveOrigin)
+    {
+        s.x0 = x;
+        s.y0 = y;
+        s.z0 = z;
+        s.haveOrigin = true;
+    }
+
+    Private::Key key(
+        (int64_t)std::floor((y - s.y0) / m_cell),
+        (int64_t)std::floor((x - s.x0) / m_cell),
+        (int64_t)std::floor((z - s.z0) / m_cell));
+
+    Private::Voxel& v = s.voxels[key];
+    size_t pos = v.records.size();
+    v.records.resize(pos + s.packedSize);
+    point.getPackedData(s.dimTypes, v.records.data() + pos);
+    v.coords.push_back(x);
+    v.coords.push_back(y);
+    v.coords.push_back(z);
+    v.sx += x;
+    v.sy += y;
+    v.sz += z;
+    v.lastTouch = ++s.seen;
+
+    // Sweep periodically for voxels the input has moved past.
+    if ((s.seen & 0xFFF) == 0)
+    {
+        for (auto it = s.voxels.begin(); it != s.voxels.end();)
+        {
+            if (s.seen - it->second.lastTouch > m_streamWindow)
+            {
+                s.finalize(it->first, it->second, m_cell);
+                it = s.voxels.erase(it);
+            }
+            else
+                ++it;
+        }
+    }
+
+    if (s.ready.size())
+    {
+        point.setPackedData(s.dimTypes, s.ready.front().data());
+        s.ready.pop_front();
+        return true;
+    }
+    return false;
+}
+
+// Emit whatever remains once the input is exhausted.
+bool VoxelCentroidNearestNeighborFilter::drainOne(PointRef& point)
+{
+    Private& s = *m_p;
+
+    if (!s.drained)
+    {
+        for (auto& kv : s.voxels)
+            s.finalize(kv.first, kv.second, m_cell);
+        s.voxels.clear();
+        s.drained = true;
+    }
+
+    if (s.ready.empty())
+        return false;
+    point.setPackedData(s.dimTypes, s.ready.front().data());
+    s.ready.pop_front();
+    return true;
+}
+
+void VoxelCentroidNearestNeighborFilter::done(PointTableRef)
+{
+    m_p->voxels.clear();
+    m_p->ready.clear();
+    m_p->drained = false;
 }
 
 PointViewSet VoxelCentroidNearestNeighborFilter::run(PointViewPtr view)
@@ -35,8 +35,10 @@
 #pragma once
 
 #include <pdal/Filter.hpp>
+#include <pdal/Streamable.hpp>
 
 #include <cstdint>
+#include <memory>
 #include <string>
 
 namespace pdal
@@ -45,20 +47,31 @@ namespace pdal
 class PointLayout;
 class PointView;
 
-class PDAL_DLL VoxelCentroidNearestNeighborFilter : public Filter
+class PDAL_DLL VoxelCentroidNearestNeighborFilter : public Filter,
+    public Streamable
 {
 public:
-    VoxelCentroidNearestNeighborFilter() : Filter()
-    {
-    }
+    VoxelCentroidNearestNeighborFilter();
+    ~VoxelCentroidNearestNeighborFilter();
 
     std::string getName() const;
 
 private:
     double m_cell;
+    point_count_t m_streamWindow;
 
     virtual void addArgs(ProgramArgs& args);
+    virtual void prepared(PointTableRef table);
     virtual PointViewSet run(PointViewPtr view);
+    virtual void ready(PointTableRef table);
+    virtual bool processOne(PointRef& point);
+    virtual bool deferred() const
+    { return true; }
+    virtual bool drainOne(PointRef& point);
+    virtual void done(PointTableRef table);
+
+    struct Private;
+    std::unique_ptr<Private> m_p;
 
     VoxelCentroidNearestNeighborFilter&
     operator=(const VoxelCentroidNearestNeighborFilter&); // not implemented
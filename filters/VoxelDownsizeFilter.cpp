@@ -36,6 +36,10 @@
 
 #include "VoxelDownsizeFilter.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
 namespace pdal
 {
 
@@ -95,22 +99,33 @@ void VoxelDownsizeFilter::addArgs(ProgramArgs& args)
     args.add("cell", "Cell size", m_cell, 0.001);
     args.add("mode", "Method for downsizing : center / first",
         m_mode, Mode::Center);
+    args.add("threads", "Number of threads used to run this filter",
+        m_threads, 1);
 }
 
 
 void VoxelDownsizeFilter::ready(PointTableRef)
-{ m_populatedVoxels.clear(); }
+{
+    m_populatedVoxels.reset();
+    m_shards.clear();
+    m_originSet = false;
+}
 
 
 PointViewSet VoxelDownsizeFilter::run(PointViewPtr view)
 {
     PointViewPtr output = view->makeNew();
-    PointRef point(*view);
-    for (PointId id = 0; id < view->size(); ++id)
+    if (m_threads > 1)
+        voxelizeParallel(*view, *output);
+    else
     {
-        point.setPointId(id);
-        if (voxelize(point))
-            output->appendPoint(*view, id);
+        PointRef point(*view);
+        for (PointId id = 0; id < view->size(); ++id)
+        {
+            point.setPointId(id);
+            if (voxelize(point))
+                output->appendPoint(*view, id);
+        }
     }
 
     PointViewSet viewSet;
@@ -128,34 +143,112 @@ bool VoxelDownsizeFilter::voxelize(PointRef& point)
     double x = point.getFieldAs<double>(Dimension::Id::X);
     double y = point.getFieldAs<double>(Dimension::Id::Y);
     double z = point.getFieldAs<double>(Dimension::Id::Z);
-    if (m_populatedVoxels.empty())
+    if (!m_originSet)
     {
         m_originX = x - (m_cell / 2);
         m_originY = y - (m_cell / 2);
         m_originZ = z - (m_cell / 2);
+        m_originSet = true;
     }
 
     // Offset by origin.
-    x -= m_originX;
-    y -= m_originY;
-    z -= m_originZ;
+    int xi = (int)(std::floor((x - m_originX) / m_cell));
+    int yi = (int)(std::floor((y - m_originY) / m_cell));
+    int zi = (int)(std::floor((z - m_originZ) / m_cell));
 
-    Voxel v = std::make_tuple((int)(std::floor(x / m_cell)),
-        (int)(std::floor(y / m_cell)), (int)(std::floor(z / m_cell)));
-
-    auto inserted = m_populatedVoxels.insert(v).second;
+    bool inserted = m_populatedVoxels.insert(xi, yi, zi);
     if ((m_mode == Mode::Center) && inserted)
     {
-        point.setField(Dimension::Id::X,
-            (std::get<0>(v) + 0.5) * m_cell + m_originX);
-        point.setField(Dimension::Id::Y,
-            (std::get<1>(v) + 0.5) * m_cell + m_originY);
-        point.setField(Dimension::Id::Z,
-            (std::get<2>(v) + 0.5) * m_cell + m_originZ);
+        point.setField(Dimension::Id::X, (xi + 0.5) * m_cell + m_originX);
+        point.setField(Dimension::Id::Y, (yi + 0.5) * m_cell + m_originY);
+        point.setField(Dimension::Id::Z, (zi + 0.5) * m_cell + m_originZ);
     }
     return inserted;
 }
 
+
+// Each thread owns a slice of voxel space.  All threads scan every
+// point, but a voxel is tested and recorded only by its owner, so the
+// shard sets need no synchronization.  The merge restores input order,
+// making the output identical to a serial run.
+void VoxelDownsizeFilter::voxelizeParallel(PointView& input,
+    PointView& output)
+{
+    if (input.empty())
+        return;
+
+    if (m_shards.empty())
+        m_shards.resize(m_threads);
+    size_t numShards = m_shards.size();
+
+    if (!m_originSet)
+    {
+        PointRef first = input.point(0);
+        m_originX = first.getFieldAs<double>(Dimension::Id::X) - (m_cell / 2);
+        m_originY = first.getFieldAs<double>(Dimension::Id::Y) - (m_cell / 2);
+        m_originZ = first.getFieldAs<double>(Dimension::Id::Z) - (m_cell / 2);
+        m_originSet = true;
+    }
+
+    std::vector<std::vector<PointId>> kept(numShards);
+    std::vector<std::thread> threadList(numShards);
+    for (size_t t = 0; t < numShards; ++t)
+    {
+        threadList[t] = std::thread([&, t]()
+        {
+            VoxelSet& shard = m_shards[t];
+            PointRef point = input.point(0);
+            for (PointId id = 0; id < input.size(); ++id)
+            {
+                point.setPointId(id);
+                double x = point.getFieldAs<double>(Dimension::Id::X);
+                double y = point.getFieldAs<double>(Dimension::Id::Y);
+                double z = point.getFieldAs<double>(Dimension::Id::Z);
+
+                int xi = (int)(std::floor((x - m_originX) / m_cell));
+                int yi = (int)(std::floor((y - m_originY) / m_cell));
+                int zi = (int)(std::floor((z - m_originZ) / m_cell));
+
+                if (VoxelSet::code(xi, yi, zi) % numShards != t)
+                    continue;
+                if (shard.insert(xi, yi, zi))
+                    kept[t].push_back(id);
+            }
+        });
+    }
+    for (auto& t : threadList)
+        t.join();
+
+    // The first point in each voxel has the smallest id of the voxel's
+    // points, so sorting the kept ids reproduces first-entry order.
+    std::vector<PointId> ids;
+    for (std::vector<PointId>& k : kept)
+        ids.insert(ids.end(), k.begin(), k.end());
+    std::sort(ids.begin(), ids.end());
+
+    if (m_mode == Mode::Center)
+    {
+        PointRef point = input.point(0);
+        for (PointId id : ids)
+        {
+            point.setPointId(id);
+            double x = point.getFieldAs<double>(Dimension::Id::X);
+            double y = point.getFieldAs<double>(Dimension::Id::Y);
+            double z = point.getFieldAs<double>(Dimension::Id::Z);
+
+            int xi = (int)(std::floor((x - m_originX) / m_cell));
+            int yi = (int)(std::floor((y - m_originY) / m_cell));
+            int zi = (int)(std::floor((z - m_originZ) / m_cell));
+
+            point.setField(Dimension::Id::X, (xi + 0.5) * m_cell + m_originX);
+            point.setField(Dimension::Id::Y, (yi + 0.5) * m_cell + m_originY);
+            point.setField(Dimension::Id::Z, (zi + 0.5) * m_cell + m_originZ);
+        }
+    }
+
+    output.appendPoints(input, ids.data(), ids.size());
+}
+
 bool VoxelDownsizeFilter::processOne(PointRef& point)
 {
     return voxelize(point);
@@ -39,6 +39,8 @@
 #include <pdal/Filter.hpp>
 #include <pdal/Streamable.hpp>
 
+#include "private/VoxelSet.hpp"
+
 namespace pdal
 {
 
@@ -47,7 +49,6 @@ class PointView;
 
 class PDAL_DLL VoxelDownsizeFilter : public Filter, public Streamable
 {
-    using Voxel = std::tuple<int, int, int>;
     enum class Mode
     {
         First,
@@ -67,12 +68,17 @@ private:
     virtual bool processOne(PointRef& point) override;
 
     bool voxelize(PointRef& point);
+    void voxelizeParallel(PointView& input, PointView& output);
 
     double m_cell;
     double m_originX;
     double m_originY;
     double m_originZ;
-    std::set<Voxel> m_populatedVoxels;
+    bool m_originSet;
+    VoxelSet m_populatedVoxels;
+    // Per-thread slices of voxel space for the parallel path.
+    std::vector<VoxelSet> m_shards;
+    int m_threads;
     Mode m_mode;
 
     friend std::istream& operator>>(std::istream& in,
@@ -28,10 +28,18 @@
  * OF SUCH DAMAGE.
  ****************************************************************************/
 
-#include <pdal/KDIndex.hpp>
-
 #include "ZsmoothFilter.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include <pdal/util/ThreadPool.hpp>
+
+#include "private/ParallelSort.hpp"
+
 namespace pdal
 {
 
@@ -92,42 +100,153 @@ void ZsmoothFilter::prepared(PointTableRef)
 
 void ZsmoothFilter::filter(PointView& view)
 {
-    const KD2Index& kdi = view.build2dIndex();
-
-    for (PointId idx = 0; idx < view.size(); ++idx)
+    point_count_t numPts = view.size();
+    if (!numPts)
+        return;
+
+    double radius = m_p->radius;
+
+    // Bucket the points into a grid with cells at least one radius on a
+    // side: every neighbor within 'radius' of a point then lies in the
+    // 3x3 cell block around it, so neighbor sets come from a handful of
+    // contiguous arrays instead of per-point KD radius queries.
+    BOX2D bounds;
+    view.calculateBounds(bounds);
+
+    // Larger cells stay correct - the 3x3 block still covers the search
+    // disk - so cap the axis cell counts to keep the grid from exploding
+    // when the radius is tiny relative to the extent.
+    double cell = radius > 0 ? radius : 1.0;
+    size_t maxCells = (size_t)std::sqrt((double)numPts) + 1;
+    cell = (std::max)(cell, (bounds.maxx - bounds.minx) / maxCells);
+    cell = (std::max)(cell, (bounds.maxy - bounds.miny) / maxCells);
+
+    size_t xsize = (size_t)((bounds.maxx - bounds.minx) / cell) + 1;
+    size_t ysize = (size_t)((bounds.maxy - bounds.miny) / cell) + 1;
+
+    struct Entry
+    {
+        double x;
+        double y;
+        double z;
+        PointId id;
+    };
+
+    // CSR layout: per-cell offsets into one flat entry array.
+    std::vector<size_t> cellOf(numPts);
+    std::vector<size_t> starts(xsize * ysize + 1, 0);
+    for (PointId i = 0; i < numPts; ++i)
     {
-        double d = view.getFieldAs<double>(Dimension::Id::Z, idx);
+        double x = view.getFieldAs<double>(Dimension::Id::X, i);
+        double y = view.getFieldAs<double>(Dimension::Id::Y, i);
+        size_t cx = (std::min)((size_t)((x - bounds.minx) / cell), xsize - 1);
+        size_t cy = (std::min)((size_t)((y - bounds.miny) / cell), ysize - 1);
+        cellOf[i] = cy * xsize + cx;
+        starts[cellOf[i] + 1]++;
+    }
+    std::partial_sum(starts.begin(), starts.end(), starts.begin());
 
-        std::vector<double> valList;
-        PointIdList nears = kdi.radius(idx, m_p->radius);
-        for (PointId n = 1; n < nears.size(); ++n)
-        {
-            double z = view.getFieldAs<double>(Dimension::Id::Z, nears[n]);
-            valList.push_back(z);
-        }
-        std::sort(valList.begin(), valList.end());
-
-        double val;
-        if (valList.empty())
-            val = view.getFieldAs<double>(Dimension::Id::Z, idx);
-        else if (valList.size() == 1)
-            val = valList[0];
-        else if (m_p->pos == 0.0)
-            val = valList[0];
-        else if (m_p->pos == 1.0)
-            val = valList[valList.size() - 1];
-        else
+    std::vector<Entry> entries(numPts);
+    {
+        std::vector<size_t> fill(starts.begin(), starts.end() - 1);
+        for (PointId i = 0; i < numPts; ++i)
         {
-            double pos = m_p->pos * (valList.size() - 1);
-            size_t low = (size_t)std::floor(pos);
-            size_t high = low + 1;
-            double highfrac = pos - low;
-            double lowfrac = 1 - highfrac;
-            val = valList[low] * lowfrac + valList[high] * highfrac;
-
+            Entry& e = entries[fill[cellOf[i]]++];
+            e.x = view.getFieldAs<double>(Dimension::Id::X, i);
+            e.y = view.getFieldAs<double>(Dimension::Id::Y, i);
+            e.z = view.getFieldAs<double>(Dimension::Id::Z, i);
+            e.id = i;
         }
-        view.setField(m_p->statDim, idx, val);
     }
+
+    size_t threads = threadCount(numPts);
+    ThreadPool pool(threads);
+    auto rowStart = [ysize, threads](size_t t)
+        { return t * ysize / threads; };
+
+    // Sort each cell's entries by Y so a gather can binary-search down to
+    // the candidate span.  Workers own disjoint bands of grid rows.
+    for (size_t t = 0; t < threads; ++t)
+        pool.add([&, t]()
+        {
+            for (size_t row = rowStart(t); row < rowStart(t + 1); ++row)
+                for (size_t c = row * xsize; c < (row + 1) * xsize; ++c)
+                    std::sort(entries.begin() + starts[c],
+                        entries.begin() + starts[c + 1],
+                        [](const Entry& a, const Entry& b)
+                            { return a.y < b.y; });
+        });
+    pool.await();
+
+    // Process band-parallel: each worker walks its band's cells and
+    // computes the percentile for the points they contain.  The strict
+    // 'distance squared < radius squared' test matches the KD search this
+    // replaces.
+    double rr = radius * radius;
+    for (size_t t = 0; t < threads; ++t)
+        pool.add([&, t]()
+        {
+            std::vector<double> valList;
+            for (size_t row = rowStart(t); row < rowStart(t + 1); ++row)
+                for (size_t cx = 0; cx < xsize; ++cx)
+                {
+                    size_t c = row * xsize + cx;
+                    for (size_t ei = starts[c]; ei < starts[c + 1]; ++ei)
+                    {
+                        const Entry& p = entries[ei];
+
+                        valList.clear();
+                        size_t gy0 = row ? row - 1 : 0;
+                        size_t gy1 = (std::min)(row + 1, ysize - 1);
+                        size_t gx0 = cx ? cx - 1 : 0;
+                        size_t gx1 = (std::min)(cx + 1, xsize - 1);
+                        for (size_t gy = gy0; gy <= gy1; ++gy)
+                            for (size_t gx = gx0; gx <= gx1; ++gx)
+                            {
+                                size_t n = gy * xsize + gx;
+                                auto end = entries.begin() + starts[n + 1];
+                                auto it = std::lower_bound(
+                                    entries.begin() + starts[n], end,
+                                    p.y - radius,
+                                    [](const Entry& e, double v)
+                                        { return e.y < v; });
+                                for (; it != end; ++it)
+                                {
+                                    if (it->y > p.y + radius)
+                                        break;
+                                    double dx = it->x - p.x;
+                                    double dy = it->y - p.y;
+                                    if (dx * dx + dy * dy < rr &&
+                                        it->id != p.id)
+                                        valList.push_back(it->z);
+                                }
+                            }
+                        std::sort(valList.begin(), valList.end());
+
+                        double val;
+                        if (valList.empty())
+                            val = p.z;
+                        else if (valList.size() == 1)
+                            val = valList[0];
+                        else if (m_p->pos == 0.0)
+                            val = valList[0];
+                        else if (m_p->pos == 1.0)
+                            val = valList[valList.size() - 1];
+                        else
+                        {
+                            double pos = m_p->pos * (valList.size() - 1);
+                            size_t low = (size_t)std::floor(pos);
+                            size_t high = low + 1;
+                            double highfrac = pos - low;
+                            double lowfrac = 1 - highfrac;
+                            val = valList[low] * lowfrac +
+                                valList[high] * highfrac;
+                        }
+                        view.setField(m_p->statDim, p.id, val);
+                    }
+                }
+        });
+    pool.await();
 }
 
 } // namespace pdal
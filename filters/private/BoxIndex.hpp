@@ -0,0 +1,122 @@
+/******************************************************************************
+* Copyright (c) 2026, Hobu Inc., info@hobu.co
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+*       names of its contributors may be used to endorse or promote
+*       products derived from this software without specific prior
+*       written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace pdal
+{
+
+// Uniform grid over the bounding boxes of 2D geometries.  Each cell
+// lists the geometries whose boxes overlap it, so a point tests only
+// those candidates rather than every geometry.  Geometry sets fed to
+// point-in-polygon filters (tiles, footprints, administrative areas)
+// are typically of similar size, where a simple grid does about as
+// well as an R-tree.
+class BoxIndex
+{
+public:
+    using Point = std::pair<double, double>;
+    using Box = std::pair<Point, Point>;
+
+    BoxIndex(const std::vector<Box>& boxes)
+    {
+        for (const Box& b : boxes)
+        {
+            m_xMin = (std::min)(m_xMin, b.first.first);
+            m_yMin = (std::min)(m_yMin, b.first.second);
+            m_xMax = (std::max)(m_xMax, b.second.first);
+            m_yMax = (std::max)(m_yMax, b.second.second);
+        }
+
+        size_t dim = (size_t)std::ceil(std::sqrt((double)boxes.size()));
+        m_width = m_height = (std::max)(dim, (size_t)1);
+        m_cellWidth = (std::max)((m_xMax - m_xMin) / m_width,
+            std::numeric_limits<double>::min());
+        m_cellHeight = (std::max)((m_yMax - m_yMin) / m_height,
+            std::numeric_limits<double>::min());
+        m_cells.resize(m_width * m_height);
+
+        for (size_t i = 0; i < boxes.size(); ++i)
+        {
+            const Box& b = boxes[i];
+            size_t x1 = cellCol(b.first.first);
+            size_t x2 = cellCol(b.second.first);
+            size_t y1 = cellRow(b.first.second);
+            size_t y2 = cellRow(b.second.second);
+            for (size_t y = y1; y <= y2; ++y)
+                for (size_t x = x1; x <= x2; ++x)
+                    m_cells[y * m_width + x].push_back(i);
+        }
+    }
+
+    // Return the geometries whose bounding boxes may contain the point.
+    const std::vector<size_t>& candidates(double x, double y) const
+    {
+        if (x < m_xMin || x > m_xMax || y < m_yMin || y > m_yMax)
+            return m_empty;
+        return m_cells[cellRow(y) * m_width + cellCol(x)];
+    }
+
+private:
+    size_t cellCol(double x) const
+    {
+        return (std::min)((size_t)((x - m_xMin) / m_cellWidth),
+            m_width - 1);
+    }
+    size_t cellRow(double y) const
+    {
+        return (std::min)((size_t)((y - m_yMin) / m_cellHeight),
+            m_height - 1);
+    }
+
+    double m_xMin = (std::numeric_limits<double>::max)();
+    double m_yMin = (std::numeric_limits<double>::max)();
+    double m_xMax = std::numeric_limits<double>::lowest();
+    double m_yMax = std::numeric_limits<double>::lowest();
+    size_t m_width;
+    size_t m_height;
+    double m_cellWidth;
+    double m_cellHeight;
+    std::vector<std::vector<size_t>> m_cells;
+    std::vector<size_t> m_empty;
+};
+
+} // namespace pdal
@@ -0,0 +1,142 @@
+/******************************************************************************
+* Copyright (c) 2026, Hobu Inc.
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+*       names of its contributors may be used to endorse or promote
+*       products derived from this software without specific prior
+*       written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <pdal/pdal_types.hpp>
+#include <pdal/util/ThreadPool.hpp>
+
+// Worker sizing and parallel sorting helpers shared by the filters that
+// chunk a view's points across a thread pool.
+
+namespace pdal
+{
+
+// Don't spin up workers for small workloads; the per-item work in these
+// filters - computing a key, a few compares, moving an entry through a
+// radix pass - is only a handful of operations.
+const point_count_t minParallelSize = 100000;
+
+// How many workers for 'size' work items: one per 'grain' items, up to
+// the hardware thread count and never less than one.
+inline size_t threadCount(point_count_t size,
+    point_count_t grain = minParallelSize)
+{
+    size_t threads = (std::min)((size_t)(std::max)(
+        std::thread::hardware_concurrency(), 1U),
+        (size_t)(size / grain));
+    return (std::max)(threads, (size_t)1);
+}
+
+// Map a double to a 64-bit key whose unsigned ordering matches the
+// double's ordering, so a radix sort on the key reproduces a comparison
+// sort exactly - no quantization involved.
+inline uint64_t sortableKey(double d)
+{
+    uint64_t u;
+    std::memcpy(&u, &d, sizeof(u));
+    return (u & 0x8000000000000000ULL) ? ~u : u | 0x8000000000000000ULL;
+}
+
+// Stable LSD radix sort of (key, index) pairs on the key, one byte per
+// pass.  Each worker histograms and then scatters its own chunk;
+// bucket-major offsets with chunks in order inside each bucket keep the
+// pass stable, so ties stay in point order just as with stable_sort.
+// Passes where every key shares the same byte are skipped, so 32-bit
+// keys cost four passes instead of eight.
+inline void radixSort(std::vector<std::pair<uint64_t, PointId>>& items,
+    ThreadPool& pool, size_t threads)
+{
+    const size_t Buckets = 256;
+    std::vector<std::pair<uint64_t, PointId>> scratch(items.size());
+    std::vector<std::array<size_t, Buckets>> counts(threads);
+
+    auto chunkStart = [&items, threads](size_t t)
+        { return t * items.size() / threads; };
+
+    auto src = &items;
+    auto dst = &scratch;
+    for (int pass = 0; pass < 8; ++pass)
+    {
+        const unsigned shift = pass * 8;
+
+        for (size_t t = 0; t < threads; ++t)
+            pool.add([&, t]()
+            {
+                auto& c = counts[t];
+                c.fill(0);
+                for (size_t i = chunkStart(t); i < chunkStart(t + 1); ++i)
+                    c[((*src)[i].first >> shift) & 0xff]++;
+            });
+        pool.await();
+
+        size_t total = 0;
+        bool singleBucket = false;
+        for (size_t b = 0; b < Buckets; ++b)
+            for (size_t t = 0; t < threads; ++t)
+            {
+                size_t n = counts[t][b];
+                counts[t][b] = total;
+                total += n;
+                if (n == items.size())
+                    singleBucket = true;
+            }
+        // Every key has the same byte - nothing to move this pass.
+        if (singleBucket)
+            continue;
+
+        for (size_t t = 0; t < threads; ++t)
+            pool.add([&, t]()
+            {
+                auto& c = counts[t];
+                for (size_t i = chunkStart(t); i < chunkStart(t + 1); ++i)
+                    (*dst)[c[((*src)[i].first >> shift) & 0xff]++] =
+                        (*src)[i];
+            });
+        pool.await();
+        std::swap(src, dst);
+    }
+    if (src != &items)
+        items = std::move(scratch);
+}
+
+} // namespace pdal
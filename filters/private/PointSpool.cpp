@@ -0,0 +1,98 @@
+/******************************************************************************
+ * Copyright (c) 2021, Hobu Inc. (info@hobu.co)
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following
+ * conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided
+ *       with the distribution.
+ *     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+ *       names of its contributors may be used to endorse or promote
+ *       products derived from this software without specific prior
+ *       written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+#include "PointSpool.hpp"
+
+#include <random>
+
+#include <arbiter/arbiter.hpp>
+
+#include <pdal/util/FileUtils.hpp>
+
+namespace pdal
+{
+
+PointSpool::PointSpool(const std::string& tag, size_t recordSize) :
+    m_recordSize(recordSize)
+{
+    m_path = arbiter::join(arbiter::getTempPath(), "pdal-" + tag + "-" +
+        std::to_string(std::random_device()()) + ".tmp");
+}
+
+PointSpool::~PointSpool()
+{
+    clear();
+}
+
+void PointSpool::write(double value, const char *record)
+{
+    if (!m_out.is_open())
+        m_out.open(m_path, std::ios::binary | std::ios::trunc);
+    m_out.write(reinterpret_cast<const char *>(&value), sizeof(value));
+    m_out.write(record, m_recordSize);
+}
+
+bool PointSpool::rewind()
+{
+    bool ok = true;
+    if (m_out.is_open())
+    {
+        m_out.close();
+        ok = !m_out.fail();
+        m_in.open(m_path, std::ios::binary);
+        ok = ok && !m_in.fail();
+    }
+    return ok;
+}
+
+bool PointSpool::read(double& value, char *record)
+{
+    if (!m_in.is_open())
+        return false;
+    if (!m_in.read(reinterpret_cast<char *>(&value), sizeof(value)))
+        return false;
+    m_in.read(record, m_recordSize);
+    return !m_in.fail();
+}
+
+void PointSpool::clear()
+{
+    if (m_out.is_open())
+        m_out.close();
+    if (m_in.is_open())
+        m_in.close();
+    FileUtils::deleteFile(m_path);
+}
+
+} // namespace pdal
@@ -0,0 +1,76 @@
+/******************************************************************************
+ * Copyright (c) 2021, Hobu Inc. (info@hobu.co)
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following
+ * conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided
+ *       with the distribution.
+ *     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+ *       names of its contributors may be used to endorse or promote
+ *       products derived from this software without specific prior
+ *       written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <fstream>
+#include <string>
+
+namespace pdal
+{
+
+// Sequential temporary-file spool of [value][packed point] records used by
+// stream-mode filters that must withhold points and re-emit them during
+// the drain phase.  The backing file is created lazily on the first write
+// and removed by clear() or the destructor.
+class PointSpool
+{
+public:
+    PointSpool(const std::string& tag, size_t recordSize);
+    ~PointSpool();
+
+    // Append a record.
+    void write(double value, const char *record);
+
+    // Finish writing and position at the first record.  Returns false if
+    // writing failed.
+    bool rewind();
+
+    // Fetch the next record.  Returns false at end of spool.
+    bool read(double& value, char *record);
+
+    // Remove the backing file.
+    void clear();
+
+    std::string path() const
+        { return m_path; }
+
+private:
+    std::string m_path;
+    size_t m_recordSize;
+    std::ofstream m_out;
+    std::ifstream m_in;
+};
+
+} // namespace pdal
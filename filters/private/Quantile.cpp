@@ -0,0 +1,149 @@
+/******************************************************************************
+ * Copyright (c) 2026, Hobu Inc. (info@hobu.co)
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following
+ * conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided
+ *       with the distribution.
+ *     * Neither the name of Hobu, Inc. nor the names of its contributors
+ *       may be used to endorse or promote products derived from this
+ *       software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+#include "Quantile.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace pdal
+{
+namespace Quantile
+{
+
+double exact(std::vector<double>& vals, double percent)
+{
+    std::nth_element(vals.begin(),
+        vals.begin() + int(vals.size() * percent), vals.end());
+
+    return *(vals.begin() + int(vals.size() * percent));
+}
+
+P2Estimator::P2Estimator(double quantile)
+    : m_quantile(quantile)
+    , m_count(0)
+{
+    m_increments = { 0, quantile / 2, quantile, (1 + quantile) / 2, 1 };
+}
+
+void P2Estimator::add(double value)
+{
+    // The first five observations seed the markers directly.
+    if (m_count < 5)
+    {
+        m_heights[m_count++] = value;
+        if (m_count == 5)
+        {
+            std::sort(m_heights.begin(), m_heights.end());
+            for (size_t i = 0; i < 5; ++i)
+            {
+                m_positions[i] = (double)(i + 1);
+                m_desired[i] = 1 + 4 * m_increments[i];
+            }
+        }
+        return;
+    }
+    m_count++;
+
+    // Find the marker cell holding the new observation, extending the
+    // extremes when it falls outside them.
+    size_t k;
+    if (value < m_heights[0])
+    {
+        m_heights[0] = value;
+        k = 0;
+    }
+    else if (value >= m_heights[4])
+    {
+        m_heights[4] = value;
+        k = 3;
+    }
+    else
+    {
+        for (k = 0; k < 3; ++k)
+            if (value < m_heights[k + 1])
+                break;
+    }
+
+    for (size_t i = k + 1; i < 5; ++i)
+        m_positions[i]++;
+    for (size_t i = 0; i < 5; ++i)
+        m_desired[i] += m_increments[i];
+
+    // Nudge the interior markers toward their desired positions, moving
+    // their heights along a parabola through the neighboring markers, or
+    // linearly when the parabolic step would cross a neighbor.
+    for (size_t i = 1; i < 4; ++i)
+    {
+        double d = m_desired[i] - m_positions[i];
+        double before = m_positions[i] - m_positions[i - 1];
+        double after = m_positions[i + 1] - m_positions[i];
+        if ((d >= 1 && after > 1) || (d <= -1 && before > 1))
+        {
+            double sign = (d >= 0) ? 1 : -1;
+            double qp = m_heights[i] + sign / (after + before) *
+                ((before + sign) *
+                    (m_heights[i + 1] - m_heights[i]) / after +
+                 (after - sign) *
+                    (m_heights[i] - m_heights[i - 1]) / before);
+
+            if (m_heights[i - 1] < qp && qp < m_heights[i + 1])
+                m_heights[i] = qp;
+            else if (sign > 0)
+                m_heights[i] += (m_heights[i + 1] - m_heights[i]) / after;
+            else
+                m_heights[i] -= (m_heights[i] - m_heights[i - 1]) / before;
+            m_positions[i] += sign;
+        }
+    }
+}
+
+double P2Estimator::value() const
+{
+    if (m_count == 0)
+        return 0;
+
+    // Not enough observations to seed the markers; select exactly from
+    // what we have.
+    if (m_count < 5)
+    {
+        std::array<double, 5> sample = m_heights;
+        std::sort(sample.begin(), sample.begin() + m_count);
+        return sample[(size_t)(m_count * m_quantile)];
+    }
+
+    return m_heights[2];
+}
+
+} // namespace Quantile
+} // namespace pdal
@@ -0,0 +1,95 @@
+/******************************************************************************
+ * Copyright (c) 2026, Hobu Inc. (info@hobu.co)
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following
+ * conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided
+ *       with the distribution.
+ *     * Neither the name of Hobu, Inc. nor the names of its contributors
+ *       may be used to endorse or promote products derived from this
+ *       software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <pdal/pdal_export.hpp>
+#include <pdal/pdal_types.hpp>
+
+#include <array>
+#include <vector>
+
+namespace pdal
+{
+namespace Quantile
+{
+
+/**
+  Return the value at the given quantile of 'vals' by in-place selection.
+
+  The vector is partially reordered, matching the index convention the
+  quantile filters have always used (element at floor(size * percent) of
+  the sorted order).
+
+  \param[in,out] vals the sample, reordered in place.
+  \param[in] percent the quantile to select, in [0, 1).
+  \returns the selected value.
+*/
+PDAL_DLL double exact(std::vector<double>& vals, double percent);
+
+/**
+  Streaming quantile estimate in constant memory.
+
+  Implements the P-square algorithm of Jain & Chlamtac: five markers track
+  the running quantile without storing the sample, so a dimension can be
+  scanned without allocating a value per point.  The estimate is
+  approximate; use exact() when the sample fits in memory and exact
+  results are required.
+*/
+class PDAL_DLL P2Estimator
+{
+public:
+    /// Construct an estimator for the given quantile in (0, 1).
+    P2Estimator(double quantile);
+
+    /// Fold one observation into the estimate.
+    void add(double value);
+
+    /// Return the current quantile estimate.
+    double value() const;
+
+    /// Return the number of observations added.
+    point_count_t count() const
+    { return m_count; }
+
+private:
+    double m_quantile;
+    point_count_t m_count;
+    std::array<double, 5> m_heights;
+    std::array<double, 5> m_positions;
+    std::array<double, 5> m_desired;
+    std::array<double, 5> m_increments;
+};
+
+} // namespace Quantile
+} // namespace pdal
@@ -0,0 +1,135 @@
+/******************************************************************************
+* Copyright (c) 2026, Hobu Inc.
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. nor the names of its contributors
+*       may be used to endorse or promote products derived from this
+*       software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#include "RasterProbe.hpp"
+
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+#include <pdal/PointRef.hpp>
+#include <pdal/PointView.hpp>
+#include <pdal/private/gdal/Raster.hpp>
+
+namespace pdal
+{
+namespace RasterProbe
+{
+
+namespace
+{
+
+// Probe one chunk of the view.  Points outside the raster get their
+// callback immediately; the rest are sorted by cache tile number before
+// lookup so each tile is read once.
+void probeChunk(PointView& view, gdal::Raster& raster, PointId start,
+    PointId end, const Callback& cb)
+{
+    std::vector<std::pair<uint64_t, PointId>> order;
+    order.reserve(end - start);
+    std::vector<double> noData;
+    PointRef point = view.point(0);
+    for (PointId id = start; id < end; ++id)
+    {
+        point.setPointId(id);
+        double x = point.getFieldAs<double>(Dimension::Id::X);
+        double y = point.getFieldAs<double>(Dimension::Id::Y);
+
+        uint64_t num;
+        if (raster.tileNum(x, y, num))
+            order.push_back({num, id});
+        else
+            cb(point, noData, false);
+    }
+    std::sort(order.begin(), order.end());
+
+    std::vector<double> data;
+    for (auto& o : order)
+    {
+        point.setPointId(o.second);
+        double x = point.getFieldAs<double>(Dimension::Id::X);
+        double y = point.getFieldAs<double>(Dimension::Id::Y);
+
+        bool ok = (raster.readCached(x, y, data) == gdal::GDALError::None);
+        cb(point, data, ok);
+    }
+}
+
+} // unnamed namespace
+
+std::string probe(PointView& view, gdal::Raster& raster,
+    const std::string& filename, int threads, const Callback& cb)
+{
+    point_count_t nloops = view.size();
+    threads = (int)(std::min)((point_count_t)(std::max)(threads, 1), nloops);
+    if (threads == 0)
+        return std::string();
+
+    if (threads == 1)
+    {
+        probeChunk(view, raster, 0, nloops, cb);
+        return std::string();
+    }
+
+    std::vector<std::string> errors(threads);
+    std::vector<std::thread> threadList(threads);
+    for (int t = 0; t < threads; ++t)
+    {
+        threadList[t] = std::thread([&, t, threads]()
+        {
+            gdal::Raster r(filename);
+            gdal::GDALError error = r.open();
+            if (error != gdal::GDALError::None &&
+                error != gdal::GDALError::NoTransform &&
+                error != gdal::GDALError::NotInvertible)
+            {
+                errors[t] = r.errorMsg();
+                return;
+            }
+
+            PointId start = t * nloops / threads;
+            PointId end = (t + 1) == threads ?
+                nloops : (t + 1) * nloops / threads;
+            probeChunk(view, r, start, end, cb);
+        });
+    }
+    for (auto& t : threadList)
+        t.join();
+    for (std::string& e : errors)
+        if (e.size())
+            return e;
+    return std::string();
+}
+
+} // namespace RasterProbe
+} // namespace pdal
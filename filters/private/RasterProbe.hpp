@@ -0,0 +1,84 @@
+/******************************************************************************
+* Copyright (c) 2026, Hobu Inc.
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. nor the names of its contributors
+*       may be used to endorse or promote products derived from this
+*       software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <pdal/pdal_export.hpp>
+#include <pdal/pdal_types.hpp>
+
+namespace pdal
+{
+
+class PointRef;
+class PointView;
+
+namespace gdal { class Raster; }
+
+namespace RasterProbe
+{
+
+// Called once for every point of the view.  'data' holds the band values
+// at the point's (X, Y) and 'ok' says whether the raster had data there;
+// when 'ok' is false, 'data' must not be read.  The callback runs
+// concurrently on multiple points, so it may only touch the point it was
+// handed (and per-point slots of caller state).
+using Callback =
+    std::function<void(PointRef& point, const std::vector<double>& data,
+        bool ok)>;
+
+/**
+  Probe a raster at the (X, Y) location of every point of a view.
+
+  Within each worker's chunk, lookups are batched in tile order so that
+  each cache tile is fetched once even when the input has no spatial
+  ordering.  When more than one worker runs, each opens its own dataset
+  from \a filename, since a GDAL dataset handle can't be shared between
+  threads; with a single worker the caller's already-open \a raster is
+  used instead.
+
+  \param view  View whose points are probed.
+  \param raster  Open raster belonging to the calling stage.
+  \param filename  Raster filename, used to open per-thread datasets.
+  \param threads  Requested number of workers.
+  \param cb  Callback invoked for each point.
+  \return  An error message, or an empty string on success.
+*/
+PDAL_DLL std::string probe(PointView& view, gdal::Raster& raster,
+    const std::string& filename, int threads, const Callback& cb);
+
+} // namespace RasterProbe
+} // namespace pdal
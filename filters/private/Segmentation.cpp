@@ -42,6 +42,14 @@
 #include "DimRange.hpp"
 #include "Segmentation.hpp"
 
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
 #include <vector>
 
 namespace pdal
@@ -250,5 +258,440 @@ PointIdList farthestPointSampling(PointView& view, point_count_t count)
     return ids;
 }
 
+namespace
+{
+
+// Cells of the clustering grid, keyed by integer voxel coordinates.
+struct CellKey
+{
+    int m_x;
+    int m_y;
+    int m_z;
+
+    bool operator==(const CellKey& other) const
+    {
+        return m_x == other.m_x && m_y == other.m_y && m_z == other.m_z;
+    }
+};
+
+struct CellKeyHash
+{
+    size_t operator()(const CellKey& k) const
+    {
+        // Knuth multiplicative spreading of each coordinate.
+        uint64_t h = (uint32_t)k.m_x * 2654435761ULL;
+        h = (h ^ ((uint32_t)k.m_y * 2654435761ULL)) * 2654435761ULL;
+        h = (h ^ ((uint32_t)k.m_z * 2654435761ULL)) * 2654435761ULL;
+        return (size_t)h;
+    }
+};
+
+// Find the root of a cell's component, splitting paths as we walk.  Safe
+// to call concurrently with unite().
+uint32_t findRoot(std::vector<std::atomic<uint32_t>>& parent, uint32_t i)
+{
+    while (true)
+    {
+        uint32_t p = parent[i].load(std::memory_order_relaxed);
+        if (p == i)
+            return i;
+        uint32_t gp = parent[p].load(std::memory_order_relaxed);
+        parent[i].compare_exchange_weak(p, gp, std::memory_order_relaxed);
+        i = p;
+    }
+}
+
+// Merge the components containing cells a and b.  Roots always point at
+// lower-numbered roots, so a successful CAS on the larger root is the only
+// way a root stops being a root and the merge is lock-free.
+void unite(std::vector<std::atomic<uint32_t>>& parent, uint32_t a, uint32_t b)
+{
+    while (true)
+    {
+        a = findRoot(parent, a);
+        b = findRoot(parent, b);
+        if (a == b)
+            return;
+        if (a < b)
+            std::swap(a, b);
+        uint32_t expected = a;
+        if (parent[a].compare_exchange_strong(expected, b,
+            std::memory_order_relaxed))
+            return;
+    }
+}
+
+} // unnamed namespace
+
+std::deque<PointIdList> extractClustersGrid(PointView& view,
+    uint64_t min_points, uint64_t max_points, double tolerance, bool is3d,
+    int threads)
+{
+    using namespace Dimension;
+
+    std::deque<PointIdList> clusters;
+    if (view.empty())
+        return clusters;
+
+    // Choose the cell size so that the cell diagonal is the tolerance - any
+    // two points sharing a cell are then connected without a distance test.
+    double cell = tolerance / std::sqrt(is3d ? 3.0 : 2.0);
+
+    PointRef first = view.point(0);
+    double originX = first.getFieldAs<double>(Id::X);
+    double originY = first.getFieldAs<double>(Id::Y);
+    double originZ = first.getFieldAs<double>(Id::Z);
+
+    // Bucket points into cells.  Each cell holds its point IDs and a
+    // packed copy of their coordinates for the pair tests below.
+    std::vector<PointIdList> cellPoints;
+    std::vector<std::vector<double>> cellCoords;
+    std::vector<CellKey> cellKeys;
+    std::unordered_map<CellKey, uint32_t, CellKeyHash> cellIndex;
+    std::vector<uint32_t> pointCell(view.size());
+    for (PointId i = 0; i < view.size(); ++i)
+    {
+        PointRef p = view.point(i);
+        double x = p.getFieldAs<double>(Id::X);
+        double y = p.getFieldAs<double>(Id::Y);
+        double z = is3d ? p.getFieldAs<double>(Id::Z) : 0;
+
+        CellKey key { (int)std::floor((x - originX) / cell),
+            (int)std::floor((y - originY) / cell),
+            is3d ? (int)std::floor((z - originZ) / cell) : 0 };
+        auto it = cellIndex.find(key);
+        if (it == cellIndex.end())
+        {
+            it = cellIndex.insert({ key, (uint32_t)cellPoints.size() }).first;
+            cellPoints.emplace_back();
+            cellCoords.emplace_back();
+            cellKeys.push_back(key);
+        }
+        cellPoints[it->second].push_back(i);
+        cellCoords[it->second].insert(cellCoords[it->second].end(),
+            { x, y, z });
+        pointCell[i] = it->second;
+    }
+
+    // Offsets to neighboring cells that could hold a point within the
+    // tolerance.  Only the lexicographically positive half is kept since
+    // linking is symmetric.
+    int reach = (int)std::ceil(tolerance / cell);
+    std::vector<CellKey> offsets;
+    for (int dx = -reach; dx <= reach; ++dx)
+        for (int dy = -reach; dy <= reach; ++dy)
+            for (int dz = -reach; dz <= reach; ++dz)
+            {
+                if (std::make_tuple(dx, dy, dz) <= std::make_tuple(0, 0, 0))
+                    continue;
+                if (!is3d && dz)
+                    continue;
+                double gx = (std::max)(std::abs(dx) - 1, 0) * cell;
+                double gy = (std::max)(std::abs(dy) - 1, 0) * cell;
+                double gz = (std::max)(std::abs(dz) - 1, 0) * cell;
+                if (gx * gx + gy * gy + gz * gz <= tolerance * tolerance)
+                    offsets.push_back({ dx, dy, dz });
+            }
+
+    // Link neighboring cells across threads with a lock-free union-find.
+    // Cells are merged when any cross-cell point pair lies within the
+    // tolerance; one linking pair suffices since cells are internally
+    // connected.
+    uint32_t ncells = (uint32_t)cellPoints.size();
+    std::vector<std::atomic<uint32_t>> parent(ncells);
+    for (uint32_t i = 0; i < ncells; ++i)
+        parent[i] = i;
+
+    double sqrTolerance = tolerance * tolerance;
+    size_t nthreads = Utils::clamp((size_t)threads, (size_t)1,
+        (size_t)ncells);
+    std::vector<std::thread> threadPool;
+    for (size_t t = 0; t < nthreads; ++t)
+    {
+        uint32_t start = (uint32_t)(t * ncells / nthreads);
+        uint32_t end = (t + 1 == nthreads) ?
+            ncells : (uint32_t)((t + 1) * ncells / nthreads);
+        threadPool.emplace_back([&, start, end]()
+        {
+            for (uint32_t c = start; c < end; ++c)
+            {
+                const CellKey& key = cellKeys[c];
+                for (const CellKey& off : offsets)
+                {
+                    CellKey nkey { key.m_x + off.m_x, key.m_y + off.m_y,
+                        key.m_z + off.m_z };
+                    auto it = cellIndex.find(nkey);
+                    if (it == cellIndex.end())
+                        continue;
+                    uint32_t n = it->second;
+                    if (findRoot(parent, c) == findRoot(parent, n))
+                        continue;
+
+                    const std::vector<double>& ca = cellCoords[c];
+                    const std::vector<double>& cb = cellCoords[n];
+                    bool linked = false;
+                    for (size_t i = 0; i < ca.size() && !linked; i += 3)
+                        for (size_t j = 0; j < cb.size(); j += 3)
+                        {
+                            double ddx = ca[i] - cb[j];
+                            double ddy = ca[i + 1] - cb[j + 1];
+                            double ddz = ca[i + 2] - cb[j + 2];
+                            if (ddx * ddx + ddy * ddy + ddz * ddz <=
+                                sqrTolerance)
+                            {
+                                unite(parent, c, n);
+                                linked = true;
+                                break;
+                            }
+                        }
+                }
+            }
+        });
+    }
+    for (auto& t : threadPool)
+        t.join();
+
+    // Gather components in order of their first point so cluster numbering
+    // matches the serial extraction, then apply the size filter.
+    std::unordered_map<uint32_t, size_t> clusterOf;
+    std::deque<PointIdList> components;
+    for (PointId i = 0; i < view.size(); ++i)
+    {
+        uint32_t root = findRoot(parent, pointCell[i]);
+        auto it = clusterOf.find(root);
+        if (it == clusterOf.end())
+        {
+            it = clusterOf.insert({ root, components.size() }).first;
+            components.emplace_back();
+        }
+        components[it->second].push_back(i);
+    }
+    for (auto& c : components)
+        if (c.size() >= min_points && c.size() <= max_points)
+            clusters.push_back(std::move(c));
+
+    return clusters;
+}
+
+PointIdList farthestPointSamplingGrid(PointView& view, point_count_t count,
+    int threads)
+{
+    using namespace Dimension;
+
+    count = (std::min)(count, (point_count_t)view.size());
+    PointIdList ids(count);
+    if (!count)
+        return ids;
+
+    // Size cells on the order of the final sample spacing so that late
+    // updates touch only a handful of cells.  Degenerate extents contribute
+    // no dimension; a fully degenerate cloud gets the serial treatment.
+    BOX3D bounds;
+    view.calculateBounds(bounds);
+    double volume = 1.0;
+    int dims = 0;
+    for (double e : { bounds.maxx - bounds.minx, bounds.maxy - bounds.miny,
+        bounds.maxz - bounds.minz })
+    {
+        if (e > 0.0)
+        {
+            volume *= e;
+            ++dims;
+        }
+    }
+    if (!dims)
+        return farthestPointSampling(view, count);
+    double cell = std::pow(volume / count, 1.0 / dims);
+    if (!std::isfinite(cell) || cell <= 0.0)
+        return farthestPointSampling(view, count);
+
+    // Bucket points into cells.  Each cell holds its point IDs and a packed
+    // copy of their coordinates for the distance updates below.
+    std::vector<PointIdList> cellPoints;
+    std::vector<std::vector<double>> cellCoords;
+    std::vector<CellKey> cellKeys;
+    std::unordered_map<CellKey, uint32_t, CellKeyHash> cellIndex;
+    CellKey lo { 0, 0, 0 };
+    CellKey hi { 0, 0, 0 };
+    for (PointId i = 0; i < view.size(); ++i)
+    {
+        PointRef p = view.point(i);
+        double x = p.getFieldAs<double>(Id::X);
+        double y = p.getFieldAs<double>(Id::Y);
+        double z = p.getFieldAs<double>(Id::Z);
+
+        CellKey key { (int)std::floor((x - bounds.minx) / cell),
+            (int)std::floor((y - bounds.miny) / cell),
+            (int)std::floor((z - bounds.minz) / cell) };
+        auto it = cellIndex.find(key);
+        if (it == cellIndex.end())
+        {
+            it = cellIndex.insert({ key, (uint32_t)cellPoints.size() }).first;
+            cellPoints.emplace_back();
+            cellCoords.emplace_back();
+            cellKeys.push_back(key);
+            lo = { (std::min)(lo.m_x, key.m_x), (std::min)(lo.m_y, key.m_y),
+                (std::min)(lo.m_z, key.m_z) };
+            hi = { (std::max)(hi.m_x, key.m_x), (std::max)(hi.m_y, key.m_y),
+                (std::max)(hi.m_z, key.m_z) };
+        }
+        cellPoints[it->second].push_back(i);
+        cellCoords[it->second].insert(cellCoords[it->second].end(),
+            { x, y, z });
+    }
+    uint32_t ncells = (uint32_t)cellPoints.size();
+
+    // Squared distance from each point to its nearest selected sample,
+    // and each cell's farthest point from the sample set.
+    std::vector<double> minDists(view.size(),
+        (std::numeric_limits<double>::max)());
+    std::vector<double> cellMax(ncells);
+    std::vector<PointId> cellArg(ncells);
+
+    // Fold a new sample into one cell's distances and refresh the cell
+    // maximum.  Returns true when the maximum moved.
+    auto updateCell = [&](uint32_t c, double px, double py, double pz)
+    {
+        const PointIdList& pts = cellPoints[c];
+        const std::vector<double>& coords = cellCoords[c];
+        double best = -1.0;
+        PointId bestId = 0;
+        for (size_t k = 0; k < pts.size(); ++k)
+        {
+            double dx = coords[3 * k] - px;
+            double dy = coords[3 * k + 1] - py;
+            double dz = coords[3 * k + 2] - pz;
+            double d2 = dx * dx + dy * dy + dz * dz;
+            double& md = minDists[pts[k]];
+            if (d2 < md)
+                md = d2;
+            if (md > best)
+            {
+                best = md;
+                bestId = pts[k];
+            }
+        }
+        bool moved = (best != cellMax[c]) || (bestId != cellArg[c]);
+        cellMax[c] = best;
+        cellArg[c] = bestId;
+        return moved;
+    };
+
+    // Cells are disjoint, so updates parallelize over them with no
+    // synchronization beyond the join.
+    size_t nthreads = Utils::clamp((size_t)threads, (size_t)1,
+        (size_t)ncells);
+    auto updateCells = [&](const std::vector<uint32_t>& cells, double px,
+        double py, double pz, std::vector<uint8_t>& moved)
+    {
+        // Spawning threads costs more than a small update saves.
+        size_t npts = 0;
+        for (uint32_t c : cells)
+            npts += cellPoints[c].size();
+        if (nthreads == 1 || cells.size() == 1 || npts < 4096)
+        {
+            for (size_t k = 0; k < cells.size(); ++k)
+                moved[k] = updateCell(cells[k], px, py, pz);
+            return;
+        }
+        std::vector<std::thread> pool;
+        for (size_t t = 0; t < nthreads; ++t)
+        {
+            size_t start = t * cells.size() / nthreads;
+            size_t end = (t + 1) * cells.size() / nthreads;
+            pool.emplace_back([&, start, end]()
+            {
+                for (size_t k = start; k < end; ++k)
+                    moved[k] = updateCell(cells[k], px, py, pz);
+            });
+        }
+        for (auto& t : pool)
+            t.join();
+    };
+
+    // Seed with the first point in the current sorting, as the serial
+    // version does, and prime every cell against it.
+    PointId seedId(0);
+    ids[0] = seedId;
+    PointRef seed = view.point(seedId);
+    double sx = seed.getFieldAs<double>(Id::X);
+    double sy = seed.getFieldAs<double>(Id::Y);
+    double sz = seed.getFieldAs<double>(Id::Z);
+
+    std::vector<uint32_t> allCells(ncells);
+    std::iota(allCells.begin(), allCells.end(), 0);
+    std::vector<uint8_t> moved(ncells);
+    updateCells(allCells, sx, sy, sz, moved);
+
+    // Lazy priority queue of cell maxima.  Stale entries are left in place
+    // and discarded when popped; every cell always has one entry carrying
+    // its current maximum.
+    using Entry = std::pair<double, uint32_t>;
+    std::priority_queue<Entry> queue;
+    for (uint32_t c = 0; c < ncells; ++c)
+        queue.push({ cellMax[c], c });
+
+    std::vector<uint32_t> touched;
+    for (point_count_t i = 1; i < count; ++i)
+    {
+        // The farthest point overall sits in the cell whose current
+        // maximum tops the queue.
+        uint32_t c;
+        double r2;
+        while (true)
+        {
+            Entry e = queue.top();
+            queue.pop();
+            if (e.first == cellMax[e.second])
+            {
+                c = e.second;
+                r2 = e.first;
+                break;
+            }
+        }
+        PointId idx = cellArg[c];
+        ids[i] = idx;
+
+        PointRef p = view.point(idx);
+        sx = p.getFieldAs<double>(Id::X);
+        sy = p.getFieldAs<double>(Id::Y);
+        sz = p.getFieldAs<double>(Id::Z);
+
+        // A point's distance can only drop if the new sample is nearer
+        // than its current nearest, and no distance exceeds r2 - so only
+        // cells within radius r of the sample can change.
+        double r = std::sqrt(r2);
+        int reach = (int)std::ceil(r / cell);
+        CellKey key = cellKeys[c];
+        touched.clear();
+        for (int dx = (std::max)(key.m_x - reach, lo.m_x);
+            dx <= (std::min)(key.m_x + reach, hi.m_x); ++dx)
+            for (int dy = (std::max)(key.m_y - reach, lo.m_y);
+                dy <= (std::min)(key.m_y + reach, hi.m_y); ++dy)
+                for (int dz = (std::max)(key.m_z - reach, lo.m_z);
+                    dz <= (std::min)(key.m_z + reach, hi.m_z); ++dz)
+                {
+                    double gx = (std::max)(std::abs(dx - key.m_x) - 1, 0) *
+                        cell;
+                    double gy = (std::max)(std::abs(dy - key.m_y) - 1, 0) *
+                        cell;
+                    double gz = (std::max)(std::abs(dz - key.m_z) - 1, 0) *
+                        cell;
+                    if (gx * gx + gy * gy + gz * gz > r2)
+                        continue;
+                    auto it = cellIndex.find({ dx, dy, dz });
+                    if (it != cellIndex.end())
+                        touched.push_back(it->second);
+                }
+
+        updateCells(touched, sx, sy, sz, moved);
+        for (size_t k = 0; k < touched.size(); ++k)
+            if (moved[k])
+                queue.push({ cellMax[touched[k]], touched[k] });
+    }
+
+    return ids;
+}
+
 } // namespace Segmentation
 } // namespace pdal
@@ -154,6 +154,27 @@ PDAL_DLL std::deque<PointIdList> extractClusters(PointView& view, uint64_t min_p
     return clusters;
 }
 
+/**
+  Extract clusters of points using a grid-bucketed union-find.
+
+  Produces the same clusters as extractClusters().  Points are bucketed into
+  cells small enough that all points sharing a cell are within the tolerance
+  of one another, so only links between nearby cells need distance tests.
+  Cells are processed across the given number of threads with a lock-free
+  union-find merging components.
+
+  \param[in] view the input PointView.
+  \param[in] min_points the minimum number of points in a cluster.
+  \param[in] max_points the maximum number of points in a cluster.
+  \param[in] tolerance the tolerance for adding points to a cluster.
+  \param[in] is3d whether connectivity is computed in 3D or in XY only.
+  \param[in] threads the number of threads used to link cells.
+  \returns a deque of clusters (themselves vectors of PointIds).
+*/
+PDAL_DLL std::deque<PointIdList> extractClustersGrid(PointView& view,
+    uint64_t min_points, uint64_t max_points, double tolerance, bool is3d,
+    int threads);
+
 PDAL_DLL void ignoreDimRange(DimRange dr, PointViewPtr input, PointViewPtr keep,
                              PointViewPtr ignore);
 PDAL_DLL void ignoreDimRanges(std::vector<DimRange>& ranges,
@@ -171,5 +192,22 @@ PDAL_DLL void segmentReturns(PointViewPtr input, PointViewPtr first,
 
 PDAL_DLL PointIdList farthestPointSampling(PointView& view, point_count_t count);
 
+/**
+  Farthest point sampling accelerated with a grid and a priority queue.
+
+  Selects the same greedy farthest-point sequence as farthestPointSampling()
+  but buckets points into cells sized near the final sample spacing.  Each
+  cell tracks its farthest point in a lazy priority queue, and adding a
+  sample updates only the cells within the current sampling radius, spread
+  across the given number of threads.
+
+  \param[in] view the input PointView.
+  \param[in] count the number of samples to select.
+  \param[in] threads the number of threads used to update cells.
+  \returns the selected PointIds in selection order.
+*/
+PDAL_DLL PointIdList farthestPointSamplingGrid(PointView& view,
+    point_count_t count, int threads);
+
 } // namespace Segmentation
 } // namespace pdal
@@ -0,0 +1,109 @@
+/******************************************************************************
+ * Copyright (c) 2021, Hobu Inc. (info@hobu.co)
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following
+ * conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided
+ *       with the distribution.
+ *     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+ *       names of its contributors may be used to endorse or promote
+ *       products derived from this software without specific prior
+ *       written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+#include "SlidingWindow.hpp"
+
+#include <limits>
+
+namespace pdal
+{
+
+SlidingWindow::SlidingWindow(double radius) : m_radius(radius),
+    m_maxSort(std::numeric_limits<double>::lowest()), m_flushed(false),
+    m_head(0)
+{}
+
+bool SlidingWindow::add(double x, double y, double z, double sort)
+{
+    if (sort < m_maxSort)
+        return false;
+    m_maxSort = sort;
+    m_window.push_back({x, y, z, sort});
+    return true;
+}
+
+void SlidingWindow::flush()
+{
+    m_flushed = true;
+}
+
+bool SlidingWindow::pop(std::vector<double>& sqrDists)
+{
+    if (m_head >= m_window.size())
+        return false;
+    const Entry p = m_window[m_head];
+
+    // A point at exactly 'radius' along the sorted coordinate can still
+    // be a neighbor, so completion requires the stream to have strictly
+    // passed that bound.
+    if (!m_flushed && p.sort >= m_maxSort - m_radius)
+        return false;
+
+    sqrDists.clear();
+    for (std::size_t i = 0; i < m_window.size(); ++i)
+    {
+        const Entry& q = m_window[i];
+        if (q.sort < p.sort - m_radius)
+            continue;
+        if (q.sort > p.sort + m_radius)
+            break;
+        if (i == m_head)
+            continue;
+        double dx = q.x - p.x;
+        double dy = q.y - p.y;
+        double dz = q.z - p.z;
+        double d = dx * dx + dy * dy + dz * dz;
+        if (d <= m_radius * m_radius)
+            sqrDists.push_back(d);
+    }
+    m_head++;
+    evict();
+    return true;
+}
+
+// Drop completed points no longer within 'radius' of the next point to
+// complete.
+void SlidingWindow::evict()
+{
+    double bound = (m_head < m_window.size()) ?
+        m_window[m_head].sort - m_radius :
+        (std::numeric_limits<double>::max)();
+    while (m_head && m_window.front().sort < bound)
+    {
+        m_window.pop_front();
+        m_head--;
+    }
+}
+
+} // namespace pdal
@@ -0,0 +1,85 @@
+/******************************************************************************
+ * Copyright (c) 2021, Hobu Inc. (info@hobu.co)
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following
+ * conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided
+ *       with the distribution.
+ *     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+ *       names of its contributors may be used to endorse or promote
+ *       products derived from this software without specific prior
+ *       written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+namespace pdal
+{
+
+// Sliding spatial window over a stream of points arriving in ascending
+// order along one coordinate.  A point's neighborhood is complete once the
+// stream has advanced past it by 'radius' along the sorted coordinate,
+// since any later arrival must then be farther away than 'radius'.  Only
+// points within 'radius' of an incomplete point are retained, so memory is
+// bounded by the local point density rather than the stream length.
+class SlidingWindow
+{
+public:
+    SlidingWindow(double radius);
+
+    // Add the next point.  'sort' is the point's coordinate along the
+    // sorted dimension.  Returns false if 'sort' regresses, indicating
+    // unsorted input.
+    bool add(double x, double y, double z, double sort);
+
+    // Mark the input as exhausted, completing the points still waiting.
+    void flush();
+
+    // Fetch the squared distances to the neighbors (the point itself
+    // excluded) of the next completed point.  Points complete in arrival
+    // order.  Returns false if no point is complete.
+    bool pop(std::vector<double>& sqrDists);
+
+private:
+    struct Entry
+    {
+        double x, y, z, sort;
+    };
+
+    void evict();
+
+    double m_radius;
+    double m_maxSort;
+    bool m_flushed;
+    // Completed-but-retained points occupy [0, m_head); the point at
+    // m_head is the next to complete.
+    std::size_t m_head;
+    std::deque<Entry> m_window;
+};
+
+} // namespace pdal
@@ -0,0 +1,256 @@
+/******************************************************************************
+ * Copyright (c) 2019, Helix.re
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following
+ * conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided
+ *       with the distribution.
+ *     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+ *       names of its contributors may be used to endorse or promote
+ *       products derived from this software without specific prior
+ *       written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace pdal
+{
+
+// Flat open-addressing set of voxel coordinates.  The voxel filters
+// test set membership once per point, where the node allocation and
+// pointer chasing of std::set dominate the run time.  Probing starts
+// at a slot derived from the Morton code of the coordinates, so the
+// probe sequences of points in the same neighborhood share cache
+// lines.
+class VoxelSet
+{
+public:
+    VoxelSet()
+    { reset(); }
+
+    // Remove all entries.
+    void reset()
+    {
+        m_slots.assign(MinSlots, Slot());
+        m_size = 0;
+    }
+
+    size_t size() const
+    { return m_size; }
+
+    bool empty() const
+    { return m_size == 0; }
+
+    // Insert a voxel.  Returns true if it wasn't already present.
+    bool insert(int32_t x, int32_t y, int32_t z)
+    {
+        // Grow at 70% load.
+        if (m_size * 10 >= m_slots.size() * 7)
+            grow();
+
+        size_t mask = m_slots.size() - 1;
+        size_t pos = (size_t)code(x, y, z) & mask;
+        while (true)
+        {
+            Slot& s = m_slots[pos];
+            if (!s.m_occupied)
+            {
+                s.m_x = x;
+                s.m_y = y;
+                s.m_z = z;
+                s.m_occupied = true;
+                m_size++;
+                return true;
+            }
+            if (s.m_x == x && s.m_y == y && s.m_z == z)
+                return false;
+            pos = (pos + 1) & mask;
+        }
+    }
+
+    // Morton code (bit interleave) of the low 21 bits of each
+    // coordinate.  Used for hashing and for partitioning voxel space
+    // across threads -- truncation only makes hash collisions, since
+    // full coordinates are compared on insertion.
+    static uint64_t code(int32_t x, int32_t y, int32_t z)
+    {
+        return spread((uint32_t)x) | (spread((uint32_t)y) << 1) |
+            (spread((uint32_t)z) << 2);
+    }
+
+private:
+    struct Slot
+    {
+        int32_t m_x = 0;
+        int32_t m_y = 0;
+        int32_t m_z = 0;
+        bool m_occupied = false;
+    };
+
+    static const size_t MinSlots = 1024;  // Must be a power of 2.
+
+    // Space the low 21 bits of v three positions apart.
+    static uint64_t spread(uint32_t v)
+    {
+        uint64_t x = v & 0x1fffff;
+        x = (x | (x << 32)) & 0x1f00000000ffff;
+        x = (x | (x << 16)) & 0x1f0000ff0000ff;
+        x = (x | (x << 8)) & 0x100f00f00f00f00f;
+        x = (x | (x << 4)) & 0x10c30c30c30c30c3;
+        x = (x | (x << 2)) & 0x1249249249249249;
+        return x;
+    }
+
+    void grow()
+    {
+        std::vector<Slot> old;
+        old.swap(m_slots);
+        m_slots.assign(old.size() * 2, Slot());
+
+        size_t mask = m_slots.size() - 1;
+        for (Slot& s : old)
+        {
+            if (!s.m_occupied)
+                continue;
+            size_t pos = (size_t)code(s.m_x, s.m_y, s.m_z) & mask;
+            while (m_slots[pos].m_occupied)
+                pos = (pos + 1) & mask;
+            m_slots[pos] = s;
+        }
+    }
+
+    std::vector<Slot> m_slots;
+    size_t m_size;
+};
+
+
+// Companion map from voxel coordinates to the point coordinates
+// committed in the voxel.  Same open-addressing scheme as VoxelSet.
+class VoxelCoordMap
+{
+public:
+    struct Coord
+    {
+        double m_x;
+        double m_y;
+        double m_z;
+    };
+    using CoordList = std::vector<Coord>;
+
+    VoxelCoordMap()
+    { reset(); }
+
+    // Remove all entries.
+    void reset()
+    {
+        m_slots.assign(MinSlots, Slot());
+        m_size = 0;
+    }
+
+    bool empty() const
+    { return m_size == 0; }
+
+    // Return the coordinate list of a voxel, or nullptr if the voxel
+    // is unpopulated.
+    const CoordList *find(int32_t x, int32_t y, int32_t z) const
+    {
+        size_t mask = m_slots.size() - 1;
+        size_t pos = (size_t)VoxelSet::code(x, y, z) & mask;
+        while (true)
+        {
+            const Slot& s = m_slots[pos];
+            if (!s.m_occupied)
+                return nullptr;
+            if (s.m_x == x && s.m_y == y && s.m_z == z)
+                return &s.m_coords;
+            pos = (pos + 1) & mask;
+        }
+    }
+
+    // Return the coordinate list of a voxel, creating it if necessary.
+    CoordList& at(int32_t x, int32_t y, int32_t z)
+    {
+        // Grow at 70% load.
+        if (m_size * 10 >= m_slots.size() * 7)
+            grow();
+
+        size_t mask = m_slots.size() - 1;
+        size_t pos = (size_t)VoxelSet::code(x, y, z) & mask;
+        while (true)
+        {
+            Slot& s = m_slots[pos];
+            if (!s.m_occupied)
+            {
+                s.m_x = x;
+                s.m_y = y;
+                s.m_z = z;
+                s.m_occupied = true;
+                m_size++;
+                return s.m_coords;
+            }
+            if (s.m_x == x && s.m_y == y && s.m_z == z)
+                return s.m_coords;
+            pos = (pos + 1) & mask;
+        }
+    }
+
+private:
+    struct Slot
+    {
+        int32_t m_x = 0;
+        int32_t m_y = 0;
+        int32_t m_z = 0;
+        bool m_occupied = false;
+        CoordList m_coords;
+    };
+
+    static const size_t MinSlots = 1024;  // Must be a power of 2.
+
+    void grow()
+    {
+        std::vector<Slot> old;
+        old.swap(m_slots);
+        m_slots.assign(old.size() * 2, Slot());
+
+        size_t mask = m_slots.size() - 1;
+        for (Slot& s : old)
+        {
+            if (!s.m_occupied)
+                continue;
+            size_t pos = (size_t)VoxelSet::code(s.m_x, s.m_y, s.m_z) & mask;
+            while (m_slots[pos].m_occupied)
+                pos = (pos + 1) & mask;
+            m_slots[pos] = std::move(s);
+        }
+    }
+
+    std::vector<Slot> m_slots;
+    size_t m_size;
+};
+
+} // namespace pdal
@@ -16,7 +16,21 @@
 // ======================================================================================
 
 #include "Cloth.h"
+#include <algorithm>
 #include <fstream>
+#include <limits>
+#include <thread>
+
+namespace
+{
+// Matches the convergence test in CSF::do_filtering(): a tile whose
+// neighborhood moved less than this in the last step is considered
+// settled and skipped until a neighbor wakes it up.
+const double earlyOutThreshold = 0.005;
+
+// Don't spin up workers for small cloths.
+const size_t minParallelSize = 100000;
+}
 
 
 Cloth::Cloth(const Vec3& _origin_pos,
@@ -57,7 +71,17 @@ Cloth::Cloth(const Vec3& _origin_pos,
         }
     }
 
-    saveToFile("initial-nodes.txt");
+    tiles_x = (num_particles_width + tileSize - 1) / tileSize;
+    tiles_y = (num_particles_height + tileSize - 1) / tileSize;
+    tileDiff.assign(tiles_x * tiles_y, (std::numeric_limits<double>::max)());
+    tileActive.assign(tiles_x * tiles_y, 1);
+
+    poolThreads = (std::min)(
+        (size_t)(std::max)(std::thread::hardware_concurrency(), 1U),
+        particles.size() / minParallelSize);
+    poolThreads = (std::max)(poolThreads, (size_t)1);
+    if (poolThreads > 1)
+        pool.reset(new pdal::ThreadPool(poolThreads));
 
     // Connecting immediate neighbor particles with constraints
     // (distance 1 and sqrt(2) in the grid)
@@ -95,22 +119,72 @@ Cloth::Cloth(const Vec3& _origin_pos,
     }
 }
 
+void Cloth::refreshActiveTiles() {
+    for (int ty = 0; ty < tiles_y; ty++) {
+        for (int tx = 0; tx < tiles_x; tx++) {
+            char active = 0;
+
+            for (int ny = (std::max)(ty - 1, 0);
+                 ny <= (std::min)(ty + 1, tiles_y - 1) && !active; ny++) {
+                for (int nx = (std::max)(tx - 1, 0);
+                     nx <= (std::min)(tx + 1, tiles_x - 1); nx++) {
+                    if (tileDiff[ny * tiles_x + nx] >= earlyOutThreshold) {
+                        active = 1;
+                        break;
+                    }
+                }
+            }
+            tileActive[ty * tiles_x + tx] = active;
+        }
+    }
+}
+
 double Cloth::timeStep() {
     int particleCount = static_cast<int>(particles.size());
-    #pragma omp parallel for
-    for (int i = 0; i < particleCount; i++) {
-        particles[i].timeStep();
+
+    refreshActiveTiles();
+
+    // Verlet displacement; updates are independent per particle.
+    if (pool) {
+        for (size_t t = 0; t < poolThreads; t++) {
+            int begin = static_cast<int>(t * particleCount / poolThreads);
+            int end   = static_cast<int>((t + 1) * particleCount / poolThreads);
+            pool->add([this, begin, end]() {
+                for (int i = begin; i < end; i++) {
+                    if (tileActive[tileIndex(i)])
+                        particles[i].timeStep();
+                }
+            });
+        }
+        pool->await();
+    } else {
+        for (int i = 0; i < particleCount; i++) {
+            if (tileActive[tileIndex(i)])
+                particles[i].timeStep();
+        }
     }
-    #pragma omp parallel for
+
+    // Constraint satisfaction moves neighboring particles as well, so it
+    // stays serial to keep the relaxation order deterministic.
     for (int j = 0; j < particleCount; j++) {
-        particles[j].satisfyConstraintSelf(constraint_iterations);
+        if (tileActive[tileIndex(j)])
+            particles[j].satisfyConstraintSelf(constraint_iterations);
     }
+
+    // Measure each active tile's movement; settled tiles report zero and
+    // drop out of the next step unless a neighbor wakes them up.
     double maxDiff = 0;
 
+    std::fill(tileDiff.begin(), tileDiff.end(), 0.0);
     for (int i = 0; i < particleCount; i++) {
-        if (particles[i].isMovable()) {
+        int tile = tileIndex(i);
+
+        if (tileActive[tile] && particles[i].isMovable()) {
             double diff = fabs(particles[i].old_pos.f[1] - particles[i].pos.f[1]);
 
+            if (diff > tileDiff[tile])
+                tileDiff[tile] = diff;
+
             if (diff > maxDiff)
                 maxDiff = diff;
         }
@@ -123,21 +197,36 @@ void Cloth::addForce(const Vec3 direction) {
     for (std::size_t i = 0; i < particles.size(); i++) {
         particles[i].addForce(direction);
     }
-    saveToFile("force-nodes.txt");
 }
 
 void Cloth::terrCollision() {
     int particleCount = static_cast<int>(particles.size());
-    #pragma omp parallel for
-    for (int i = 0; i < particleCount; i++) {
-        Vec3 v = particles[i].getPos();
 
-        if (v.f[1] < heightvals[i]) {
-            particles[i].offsetPos(Vec3(0, heightvals[i] - v.f[1], 0));
-            particles[i].makeUnmovable();
+    // Each particle only tests against its own terrain cell, so the
+    // collision step parallelizes cleanly.
+    auto collide = [this](int begin, int end) {
+        for (int i = begin; i < end; i++) {
+            Vec3 v = particles[i].getPos();
+
+            if (v.f[1] < heightvals[i]) {
+                particles[i].offsetPos(Vec3(0, heightvals[i] - v.f[1], 0));
+                particles[i].makeUnmovable();
+            }
+        }
+    };
+
+    if (pool) {
+        for (size_t t = 0; t < poolThreads; t++) {
+            int begin = static_cast<int>(t * particleCount / poolThreads);
+            int end   = static_cast<int>((t + 1) * particleCount / poolThreads);
+            pool->add([collide, begin, end]() {
+                collide(begin, end);
+            });
         }
+        pool->await();
+    } else {
+        collide(0, particleCount);
     }
-    saveToFile("collision-notes.txt");
 }
 
 void Cloth::movableFilter() {
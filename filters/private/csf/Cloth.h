@@ -59,6 +59,10 @@
 #include <list>
 using namespace std;
 
+#include <memory>
+
+#include <pdal/util/ThreadPool.hpp>
+
 #include "Vec3.h"
 #include "Particle.h"
 // #include <boost/progress.hpp>
@@ -86,6 +90,29 @@ private:
     double smoothThreshold;
     double heightThreshold;
 
+    // Coarse grid for the early-out: particles are grouped into square
+    // tiles and a tile is only simulated while it or a neighboring tile
+    // moved more than the convergence threshold in the previous step, so
+    // settled (flat) regions drop out of the iteration early.
+    static const int tileSize = 16;
+    int tiles_x;
+    int tiles_y;
+    std::vector<double> tileDiff;   // max displacement per tile, last step
+    std::vector<char>   tileActive;
+
+    // Worker pool shared by the displacement and collision steps; null
+    // when the cloth is too small to bother.
+    std::unique_ptr<pdal::ThreadPool> pool;
+    size_t poolThreads;
+
+    int tileIndex(int index) {
+        int x = index % num_particles_width;
+        int y = index / num_particles_width;
+        return (y / tileSize) * tiles_x + (x / tileSize);
+    }
+
+    void refreshActiveTiles();
+
 public:
 
     Vec3 origin_pos;
@@ -5,6 +5,7 @@
 #include <cmath>
 #include <limits>
 #include <stdexcept>
+#include <thread>
 #include <tuple>
 
 namespace delaunator {
@@ -145,7 +146,7 @@ struct DelaunatorPoint {
     bool removed;
 };
 
-Delaunator::Delaunator(std::vector<double> const& in_coords)
+Delaunator::Delaunator(std::vector<double> const& in_coords, int threads)
     : coords(in_coords),
       triangles(),
       halfedges(),
@@ -158,6 +159,11 @@ Delaunator::Delaunator(std::vector<double> const& in_coords)
       m_edge_stack() {
     std::size_t n = coords.size() >> 1;
 
+    if (threads < 1)
+        threads = 1;
+    if (static_cast<std::size_t>(threads) > n)
+        threads = static_cast<int>((std::max)(n, (std::size_t)1));
+
     double max_x = (std::numeric_limits<double>::min)();
     double max_y = (std::numeric_limits<double>::min)();
     double min_x = (std::numeric_limits<double>::max)();
@@ -246,19 +252,73 @@ Delaunator::Delaunator(std::vector<double> const& in_coords)
     // but GCC 7.5+ would copy the comparator to iterators used in the
     // sort, and this was excruciatingly slow when there were many points
     // because you had to copy the vector of distances.
-    std::vector<double> dists;
-    dists.reserve(n);
-    for (size_t i = 0; i < n; i++)
-    {    
-        const double& x = coords[2 * i];
-        const double& y = coords[2 * i + 1];
-        dists.push_back(dist(x, y, m_center.x(), m_center.y()));
+    std::vector<double> dists(n);
+    if (threads > 1) {
+        std::vector<std::thread> pool;
+        for (int t = 0; t < threads; t++) {
+            pool.emplace_back([&, t]() {
+                const std::size_t begin = t * n / threads;
+                const std::size_t end =
+                    (t + 1 == threads) ? n : (t + 1) * n / threads;
+                for (std::size_t i = begin; i < end; i++)
+                    dists[i] = dist(coords[2 * i], coords[2 * i + 1],
+                        m_center.x(), m_center.y());
+            });
+        }
+        for (auto& t : pool)
+            t.join();
+    } else {
+        for (size_t i = 0; i < n; i++)
+        {
+            const double& x = coords[2 * i];
+            const double& y = coords[2 * i + 1];
+            dists[i] = dist(x, y, m_center.x(), m_center.y());
+        }
     }
 
     // sort the points by distance from the seed triangle circumcenter
-    std::sort(ids.begin(), ids.end(),
-        [&dists](std::size_t i, std::size_t j)
-            { return dists[i] < dists[j]; });
+    if (threads > 1) {
+        // Sort chunks concurrently, then merge sorted runs pairwise.
+        // Ties are broken by index so the result doesn't depend on the
+        // chunking.
+        auto cmp = [&dists](std::size_t i, std::size_t j)
+            { return dists[i] < dists[j] ||
+                (dists[i] == dists[j] && i < j); };
+
+        std::vector<std::size_t> bounds;
+        for (int t = 0; t <= threads; t++)
+            bounds.push_back(t * n / threads);
+
+        std::vector<std::thread> pool;
+        for (int t = 0; t < threads; t++) {
+            pool.emplace_back([&, t]() {
+                std::sort(ids.begin() + bounds[t],
+                    ids.begin() + bounds[t + 1], cmp);
+            });
+        }
+        for (auto& t : pool)
+            t.join();
+
+        const std::size_t runs = bounds.size() - 1;
+        for (std::size_t width = 1; width < runs; width *= 2) {
+            std::vector<std::thread> mergers;
+            for (std::size_t lo = 0; lo + width < runs; lo += 2 * width) {
+                const std::size_t mid = lo + width;
+                const std::size_t hi = (std::min)(lo + 2 * width, runs);
+                mergers.emplace_back([&, lo, mid, hi]() {
+                    std::inplace_merge(ids.begin() + bounds[lo],
+                        ids.begin() + bounds[mid], ids.begin() + bounds[hi],
+                        cmp);
+                });
+            }
+            for (auto& t : mergers)
+                t.join();
+        }
+    } else {
+        std::sort(ids.begin(), ids.end(),
+            [&dists](std::size_t i, std::size_t j)
+                { return dists[i] < dists[j]; });
+    }
 
     // initialize a hash table for storing edges of the advancing convex hull
     m_hash_size = static_cast<std::size_t>(std::llround(std::ceil(std::sqrt(n))));
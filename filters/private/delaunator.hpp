@@ -49,7 +49,10 @@ public:
     std::vector<std::size_t> hull_tri;
     std::size_t hull_start;
 
-    INLINE Delaunator(std::vector<double> const& in_coords);
+    // With threads > 1, the circumcenter distance computation and the
+    // distance sort run on that many threads.  The point insertion loop
+    // is order-dependent and stays serial.
+    INLINE Delaunator(std::vector<double> const& in_coords, int threads = 1);
     INLINE double get_hull_area();
 
 private:
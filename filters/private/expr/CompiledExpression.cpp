@@ -0,0 +1,265 @@
+#include "CompiledExpression.hpp"
+#include "Expression.hpp"
+
+namespace pdal
+{
+namespace expr
+{
+
+bool CompiledExpression::compile(const Node *top)
+{
+    clear();
+    if (!top || !top->emit(*this) || m_maxDepth > MaxStack)
+    {
+        clear();
+        return false;
+    }
+    return true;
+}
+
+
+void CompiledExpression::clear()
+{
+    m_ops.clear();
+    m_depth = 0;
+    m_maxDepth = 0;
+}
+
+
+void CompiledExpression::push(OpCode code)
+{
+    // All plain opcodes are unary or binary; binary ops consume one
+    // stack slot on net.
+    switch (code)
+    {
+    case OpCode::Not:
+    case OpCode::Negative:
+        break;
+    default:
+        m_depth--;
+        break;
+    }
+    m_ops.push_back({code, 0, Dimension::Id::Unknown});
+}
+
+
+void CompiledExpression::pushConst(double val)
+{
+    m_depth++;
+    m_maxDepth = (std::max)(m_maxDepth, m_depth);
+    m_ops.push_back({OpCode::PushConst, val, Dimension::Id::Unknown});
+}
+
+
+void CompiledExpression::pushDim(Dimension::Id dim)
+{
+    m_depth++;
+    m_maxDepth = (std::max)(m_maxDepth, m_depth);
+    m_ops.push_back({OpCode::PushDim, 0, dim});
+}
+
+
+double CompiledExpression::eval(PointRef& p) const
+{
+    double stk[MaxStack];
+    int sp = -1;
+
+    for (const Op& op : m_ops)
+    {
+        switch (op.code)
+        {
+        case OpCode::PushConst:
+            stk[++sp] = op.val;
+            break;
+        case OpCode::PushDim:
+            stk[++sp] = p.getFieldAs<double>(op.dim);
+            break;
+        case OpCode::Add:
+            sp--;
+            stk[sp] += stk[sp + 1];
+            break;
+        case OpCode::Subtract:
+            sp--;
+            stk[sp] -= stk[sp + 1];
+            break;
+        case OpCode::Multiply:
+            sp--;
+            stk[sp] *= stk[sp + 1];
+            break;
+        case OpCode::Divide:
+            sp--;
+            stk[sp] = (stk[sp + 1] == 0) ?
+                std::numeric_limits<double>::quiet_NaN() :
+                stk[sp] / stk[sp + 1];
+            break;
+        case OpCode::Negative:
+            stk[sp] = -stk[sp];
+            break;
+        case OpCode::Not:
+            stk[sp] = (stk[sp] == 0) ? 1.0 : 0.0;
+            break;
+        case OpCode::And:
+            sp--;
+            stk[sp] = (stk[sp] != 0 && stk[sp + 1] != 0) ? 1.0 : 0.0;
+            break;
+        case OpCode::Or:
+            sp--;
+            stk[sp] = (stk[sp] != 0 || stk[sp + 1] != 0) ? 1.0 : 0.0;
+            break;
+        case OpCode::Equal:
+            sp--;
+            stk[sp] = (stk[sp] == stk[sp + 1]) ? 1.0 : 0.0;
+            break;
+        case OpCode::NotEqual:
+            sp--;
+            stk[sp] = (stk[sp] != stk[sp + 1]) ? 1.0 : 0.0;
+            break;
+        case OpCode::Greater:
+            sp--;
+            stk[sp] = (stk[sp] > stk[sp + 1]) ? 1.0 : 0.0;
+            break;
+        case OpCode::GreaterEqual:
+            sp--;
+            stk[sp] = (stk[sp] >= stk[sp + 1]) ? 1.0 : 0.0;
+            break;
+        case OpCode::Less:
+            sp--;
+            stk[sp] = (stk[sp] < stk[sp + 1]) ? 1.0 : 0.0;
+            break;
+        case OpCode::LessEqual:
+            sp--;
+            stk[sp] = (stk[sp] <= stk[sp + 1]) ? 1.0 : 0.0;
+            break;
+        }
+    }
+    return sp >= 0 ? stk[sp] : 0;
+}
+
+void CompiledExpression::evalBlock(PointRef& p, PointId begin,
+    point_count_t count, uint8_t* out) const
+{
+    if (m_maxDepth > MaxLaneDepth)
+    {
+        for (point_count_t i = 0; i < count; ++i)
+        {
+            p.setPointId(begin + i);
+            out[i] = (eval(p) != 0);
+        }
+        return;
+    }
+
+    const point_count_t Lanes = 256;
+    double stk[MaxLaneDepth][Lanes];
+
+    point_count_t done = 0;
+    while (done < count)
+    {
+        point_count_t n = (std::min)(count - done, Lanes);
+        int sp = -1;
+
+        for (const Op& op : m_ops)
+        {
+            switch (op.code)
+            {
+            case OpCode::PushConst:
+                ++sp;
+                for (point_count_t i = 0; i < n; ++i)
+                    stk[sp][i] = op.val;
+                break;
+            case OpCode::PushDim:
+                ++sp;
+                for (point_count_t i = 0; i < n; ++i)
+                {
+                    p.setPointId(begin + done + i);
+                    stk[sp][i] = p.getFieldAs<double>(op.dim);
+                }
+                break;
+            case OpCode::Add:
+                sp--;
+                for (point_count_t i = 0; i < n; ++i)
+                    stk[sp][i] += stk[sp + 1][i];
+                break;
+            case OpCode::Subtract:
+                sp--;
+                for (point_count_t i = 0; i < n; ++i)
+                    stk[sp][i] -= stk[sp + 1][i];
+                break;
+            case OpCode::Multiply:
+                sp--;
+                for (point_count_t i = 0; i < n; ++i)
+                    stk[sp][i] *= stk[sp + 1][i];
+                break;
+            case OpCode::Divide:
+                sp--;
+                for (point_count_t i = 0; i < n; ++i)
+                    stk[sp][i] = (stk[sp + 1][i] == 0) ?
+                        std::numeric_limits<double>::quiet_NaN() :
+                        stk[sp][i] / stk[sp + 1][i];
+                break;
+            case OpCode::Negative:
+                for (point_count_t i = 0; i < n; ++i)
+                    stk[sp][i] = -stk[sp][i];
+                break;
+            case OpCode::Not:
+                for (point_count_t i = 0; i < n; ++i)
+                    stk[sp][i] = (stk[sp][i] == 0) ? 1.0 : 0.0;
+                break;
+            case OpCode::And:
+                sp--;
+                for (point_count_t i = 0; i < n; ++i)
+                    stk[sp][i] =
+                        (stk[sp][i] != 0 && stk[sp + 1][i] != 0) ? 1.0 : 0.0;
+                break;
+            case OpCode::Or:
+                sp--;
+                for (point_count_t i = 0; i < n; ++i)
+                    stk[sp][i] =
+                        (stk[sp][i] != 0 || stk[sp + 1][i] != 0) ? 1.0 : 0.0;
+                break;
+            case OpCode::Equal:
+                sp--;
+                for (point_count_t i = 0; i < n; ++i)
+                    stk[sp][i] =
+                        (stk[sp][i] == stk[sp + 1][i]) ? 1.0 : 0.0;
+                break;
+            case OpCode::NotEqual:
+                sp--;
+                for (point_count_t i = 0; i < n; ++i)
+                    stk[sp][i] =
+                        (stk[sp][i] != stk[sp + 1][i]) ? 1.0 : 0.0;
+                break;
+            case OpCode::Greater:
+                sp--;
+                for (point_count_t i = 0; i < n; ++i)
+                    stk[sp][i] =
+                        (stk[sp][i] > stk[sp + 1][i]) ? 1.0 : 0.0;
+                break;
+            case OpCode::GreaterEqual:
+                sp--;
+                for (point_count_t i = 0; i < n; ++i)
+                    stk[sp][i] =
+                        (stk[sp][i] >= stk[sp + 1][i]) ? 1.0 : 0.0;
+                break;
+            case OpCode::Less:
+                sp--;
+                for (point_count_t i = 0; i < n; ++i)
+                    stk[sp][i] =
+                        (stk[sp][i] < stk[sp + 1][i]) ? 1.0 : 0.0;
+                break;
+            case OpCode::LessEqual:
+                sp--;
+                for (point_count_t i = 0; i < n; ++i)
+                    stk[sp][i] =
+                        (stk[sp][i] <= stk[sp + 1][i]) ? 1.0 : 0.0;
+                break;
+            }
+        }
+
+        for (point_count_t i = 0; i < n; ++i)
+            out[done + i] = (sp >= 0 && stk[sp][i] != 0);
+        done += n;
+    }
+}
+
+} // namespace expr
+} // namespace pdal
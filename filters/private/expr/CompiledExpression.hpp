@@ -0,0 +1,86 @@
+#pragma once
+
+#include <vector>
+
+#include <pdal/Dimension.hpp>
+#include <pdal/PointRef.hpp>
+
+namespace pdal
+{
+namespace expr
+{
+
+class Node;
+
+// Flat postfix program compiled from an expression tree.  Evaluation runs
+// a small stack machine over the opcodes rather than recursing through
+// virtual Node::eval() calls, which matters when an expression is applied
+// to every point.  Booleans are represented as 1 and 0, matching the
+// value/boolean separation that the parsers enforce.
+class CompiledExpression
+{
+public:
+    enum class OpCode
+    {
+        PushConst,
+        PushDim,
+        And,
+        Or,
+        Not,
+        Add,
+        Subtract,
+        Multiply,
+        Divide,
+        Negative,
+        Equal,
+        NotEqual,
+        Greater,
+        GreaterEqual,
+        Less,
+        LessEqual
+    };
+
+    struct Op
+    {
+        OpCode code;
+        double val;         // PushConst only.
+        Dimension::Id dim;  // PushDim only.
+    };
+
+    // Build the program for the tree rooted at 'top'.  Returns false and
+    // clears the program if the tree contains something we can't compile,
+    // in which case the caller should fall back to tree evaluation.
+    bool compile(const Node *top);
+    void clear();
+    bool valid() const
+        { return m_ops.size(); }
+    double eval(PointRef& p) const;
+
+    // Evaluate the program over 'count' consecutive points starting at
+    // 'begin', rebinding 'p' to each.  Writes 1/0 into out[0..count).
+    // Running each opcode across a block of lanes amortizes the
+    // dispatch that eval() pays per point.
+    void evalBlock(PointRef& p, PointId begin, point_count_t count,
+        uint8_t* out) const;
+
+    // Emission interface used by Node::emit() implementations.
+    void push(OpCode code);
+    void pushConst(double val);
+    void pushDim(Dimension::Id dim);
+
+private:
+    // Evaluation uses a fixed stack; compile() fails on the (absurd)
+    // expression that would need more.
+    static const int MaxStack = 64;
+
+    // evalBlock() keeps a stack of lanes; expressions deeper than this
+    // (none in practice) fall back to per-point evaluation.
+    static const int MaxLaneDepth = 8;
+
+    std::vector<Op> m_ops;
+    int m_depth = 0;
+    int m_maxDepth = 0;
+};
+
+} // namespace expr
+} // namespace pdal
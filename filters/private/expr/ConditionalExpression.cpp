@@ -28,6 +28,10 @@ Utils::StatusWithReason ConditionalExpression::prepare(PointLayoutPtr layout)
                 }
             }
         }
+        // Compile to a flat program for evaluation.  On failure we
+        // fall back to walking the node tree.
+        if (status)
+            m_program.compile(top);
         return status;
     }
     return true;
@@ -35,10 +39,29 @@ Utils::StatusWithReason ConditionalExpression::prepare(PointLayoutPtr layout)
 
 bool ConditionalExpression::eval(PointRef& p) const
 {
+    if (m_program.valid())
+        return m_program.eval(p) != 0;
     const Node *n = topNode();
     return n ? n->eval(p).m_bval : true;
 }
 
+
+void ConditionalExpression::evalBlock(PointRef& p, PointId begin,
+    point_count_t count, uint8_t* out) const
+{
+    if (m_program.valid())
+    {
+        m_program.evalBlock(p, begin, count, out);
+        return;
+    }
+    const Node *n = topNode();
+    for (point_count_t i = 0; i < count; ++i)
+    {
+        p.setPointId(begin + i);
+        out[i] = n ? n->eval(p).m_bval : true;
+    }
+}
+
 } // namespace expr
 } // namespace pdal
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "CompiledExpression.hpp"
 #include "Expression.hpp"
 #include "Lexer.hpp"
 #include "ConditionalParser.hpp"
@@ -14,6 +15,11 @@ class ConditionalExpression : public Expression
 public:
     Utils::StatusWithReason prepare(PointLayoutPtr layout);
     bool eval(PointRef& p) const;
+    void evalBlock(PointRef& p, PointId begin, point_count_t count,
+        uint8_t* out) const;
+
+private:
+    CompiledExpression m_program;
 };
 
 } // namespace expr
@@ -1,4 +1,5 @@
 #include "Expression.hpp"
+#include "CompiledExpression.hpp"
 
 namespace pdal
 {
@@ -38,6 +39,15 @@ Result NotNode::eval(PointRef& p) const
 }
 
 
+bool NotNode::emit(CompiledExpression& prog) const
+{
+    if (!m_sub->emit(prog))
+        return false;
+    prog.push(CompiledExpression::OpCode::Not);
+    return true;
+}
+
+
 //
 // UnMathNode
 //
@@ -61,6 +71,15 @@ Result UnMathNode::eval(PointRef& p) const
 }
 
 
+bool UnMathNode::emit(CompiledExpression& prog) const
+{
+    if (!m_sub->emit(prog))
+        return false;
+    prog.push(CompiledExpression::OpCode::Negative);
+    return true;
+}
+
+
 //
 // BinMathNode
 //
@@ -125,6 +144,31 @@ Result BinMathNode::eval(PointRef& p) const
     return 0.0;
 }
 
+
+bool BinMathNode::emit(CompiledExpression& prog) const
+{
+    if (!m_left->emit(prog) || !m_right->emit(prog))
+        return false;
+    switch (type())
+    {
+    case NodeType::Add:
+        prog.push(CompiledExpression::OpCode::Add);
+        break;
+    case NodeType::Subtract:
+        prog.push(CompiledExpression::OpCode::Subtract);
+        break;
+    case NodeType::Multiply:
+        prog.push(CompiledExpression::OpCode::Multiply);
+        break;
+    case NodeType::Divide:
+        prog.push(CompiledExpression::OpCode::Divide);
+        break;
+    default:
+        return false;
+    }
+    return true;
+}
+
 //
 // Bool node
 //
@@ -176,6 +220,25 @@ Result BoolNode::eval(PointRef& p) const
 
 }
 
+
+bool BoolNode::emit(CompiledExpression& prog) const
+{
+    if (!m_left->emit(prog) || !m_right->emit(prog))
+        return false;
+    switch (type())
+    {
+    case NodeType::And:
+        prog.push(CompiledExpression::OpCode::And);
+        break;
+    case NodeType::Or:
+        prog.push(CompiledExpression::OpCode::Or);
+        break;
+    default:
+        return false;
+    }
+    return true;
+}
+
 //
 // CompareNode
 //
@@ -245,6 +308,37 @@ Result CompareNode::eval(PointRef& p) const
     return false;
 }
 
+
+bool CompareNode::emit(CompiledExpression& prog) const
+{
+    if (!m_left->emit(prog) || !m_right->emit(prog))
+        return false;
+    switch (type())
+    {
+    case NodeType::Equal:
+        prog.push(CompiledExpression::OpCode::Equal);
+        break;
+    case NodeType::NotEqual:
+        prog.push(CompiledExpression::OpCode::NotEqual);
+        break;
+    case NodeType::Less:
+        prog.push(CompiledExpression::OpCode::Less);
+        break;
+    case NodeType::LessEqual:
+        prog.push(CompiledExpression::OpCode::LessEqual);
+        break;
+    case NodeType::Greater:
+        prog.push(CompiledExpression::OpCode::Greater);
+        break;
+    case NodeType::GreaterEqual:
+        prog.push(CompiledExpression::OpCode::GreaterEqual);
+        break;
+    default:
+        return false;
+    }
+    return true;
+}
+
 //
 // ConstValueNode
 //
@@ -267,6 +361,13 @@ Result ConstValueNode::eval(PointRef&) const
     return m_val;
 }
 
+
+bool ConstValueNode::emit(CompiledExpression& prog) const
+{
+    prog.pushConst(m_val);
+    return true;
+}
+
 double ConstValueNode::value() const
 {
     return m_val;
@@ -295,6 +396,13 @@ Result ConstLogicalNode::eval(PointRef&) const
     return m_val;
 }
 
+
+bool ConstLogicalNode::emit(CompiledExpression& prog) const
+{
+    prog.pushConst(m_val ? 1 : 0);
+    return true;
+}
+
 bool ConstLogicalNode::value() const
 {
     return m_val;
@@ -317,6 +425,15 @@ Result VarNode::eval(PointRef& p) const
     return p.getFieldAs<double>(m_id);
 }
 
+
+bool VarNode::emit(CompiledExpression& prog) const
+{
+    if (m_id == Dimension::Id::Unknown)
+        return false;
+    prog.pushDim(m_id);
+    return true;
+}
+
 Dimension::Id VarNode::eval() const
 {
     return m_id;
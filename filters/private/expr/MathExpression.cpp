@@ -16,6 +16,10 @@ Utils::StatusWithReason MathExpression::prepare(PointLayoutPtr layout)
             if (!top->isValue())
                 status = { -1, "Expression doesn't evaluate to a value." };
         }
+        // Compile to a flat program for evaluation.  On failure we
+        // fall back to walking the node tree.
+        if (status)
+            m_program.compile(top);
         return status;
     }
     return true;
@@ -23,6 +27,8 @@ Utils::StatusWithReason MathExpression::prepare(PointLayoutPtr layout)
 
 double MathExpression::eval(PointRef& p) const
 {
+    if (m_program.valid())
+        return m_program.eval(p);
     const Node *n = topNode();
     return n ? n->eval(p).m_dval : 0;
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "CompiledExpression.hpp"
 #include "Expression.hpp"
 
 namespace pdal
@@ -12,6 +13,9 @@ class MathExpression : public Expression
 public:
     Utils::StatusWithReason prepare(PointLayoutPtr layout);
     double eval(PointRef& p) const;
+
+private:
+    CompiledExpression m_program;
 };
 
 } // namespace expr
@@ -180,8 +180,6 @@ void HexGrid::markNeighborBelow(Hexagon *h)
 //
 Hexagon *HexGrid::findHexagon(Point p)
 {
-    int x, y;
-
     if (m_hexes.empty())
     {
         m_origin = p;
@@ -191,6 +189,12 @@ Hexagon *HexGrid::findHexagon(Point p)
         HexMap::iterator it = m_hexes.insert(hexpair).first;
         return &it->second;
     }
+    return getHexagon(findHexCoord(p));
+}
+
+Coord HexGrid::findHexCoord(Point p) const
+{
+    int x, y;
 
     // Offset by the origin.
     p -= m_origin;
@@ -250,7 +254,24 @@ Hexagon *HexGrid::findHexagon(Point p)
             }
         }
     }
-    return getHexagon(x, y);
+    return Coord(x, y);
+}
+
+// Add a pre-binned count of points to the hexagon at a position.  Density
+// handling matches addPoint() -- the hexagon is marked dense when its
+// total count crosses the limit.
+void HexGrid::addCount(const Coord& c, int count)
+{
+    Hexagon *h = getHexagon(c);
+    h->setCount(h->count() + count);
+    if (!h->dense() && dense(h))
+    {
+        h->setDense();
+        m_miny = std::min(m_miny, h->y() - 1);
+        if (h->possibleRoot())
+            m_pos_roots.insert(h);
+        markNeighborBelow(h);
+    }
 }
 
 // Get the hexagon at position x, y.  If it doesn't exist, create it.
@@ -76,6 +76,16 @@ public:
     void addPoint(double x, double y)
         { addPoint(Point(x, y)); }
     void addPoint(Point p);
+    /// Add a pre-binned count of points to the hexagon at a position.
+    /// Used to merge partial counts accumulated elsewhere.
+    void addCount(const Coord& c, int count);
+    /// Whether the edge size and origin are established, allowing
+    /// findHexCoord() to be called.
+    bool canBin() const
+        { return m_width > 0 && !m_hexes.empty(); }
+    /// Compute the coordinates of the hexagon containing a point without
+    /// modifying the grid.
+    Coord findHexCoord(Point p) const;
     void processSample();
 
     void extractShapes();
@@ -64,6 +64,16 @@ public:
     */
     Point origin() const
         { return { m_xOrigin, m_yOrigin }; }
+    /**
+      Return the number of cells in the X direction.
+    */
+    size_t width() const
+        { return m_width; }
+    /**
+      Return the number of cells in the Y direction.
+    */
+    size_t height() const
+        { return m_height; }
     /**
       Return the cell width.
     */
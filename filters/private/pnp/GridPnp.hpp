@@ -56,6 +56,30 @@ public:
     bool inside(const Point& p) const
     { return inside(p.first, p.second); }
 
+    // Compute the state of every grid cell up front.  Afterwards
+    // inside() queries don't modify the grid, so they can be issued
+    // from several threads at once.
+    void precompute() const
+    {
+        for (size_t y = 0; y < m_grid->height(); ++y)
+            for (size_t x = 0; x < m_grid->width(); ++x)
+            {
+                XYIndex idx(x, y);
+                Cell& cell = m_grid->cell(idx);
+                if (!cell.computed())
+                    computeCell(cell, idx);
+            }
+    }
+
+    // Return the extent of the grid, which covers the bounding box of
+    // the polygon.
+    void extent(Point& low, Point& high) const
+    {
+        low = m_grid->origin();
+        high = { low.first + m_grid->cellWidth() * m_grid->width(),
+            low.second + m_grid->cellHeight() * m_grid->height() };
+    }
+
     // Determine if a point is inside the polygon attached to this class.
     bool inside(double x, double y) const
     {
@@ -34,10 +34,13 @@
 
 #include "BpfReader.hpp"
 
+#include <atomic>
 #include <climits>
 
 #include <pdal/Options.hpp>
 #include <pdal/pdal_features.hpp>
+#include <pdal/util/Extractor.hpp>
+#include <pdal/util/ThreadPool.hpp>
 
 #ifdef PDAL_HAVE_ZLIB
 #include <zlib.h>
@@ -61,6 +64,7 @@ CREATE_STATIC_STAGE(BpfReader, s_info)
 struct BpfReader::Args
 {
     bool m_fixNames;
+    int m_threads;
 };
 
 std::string BpfReader::getName() const { return s_info.name; }
@@ -87,6 +91,8 @@ void BpfReader::addArgs(ProgramArgs& args)
 {
     args.add("fix_dims", "Make invalid dimension names valid by changing "
         "invalid characters to '_'", m_args->m_fixNames, true);
+    args.add("threads", "Number of threads used to decompress point data",
+        m_args->m_threads, 1);
 }
 
 
@@ -139,6 +145,8 @@ void BpfReader::initialize()
 {
     if (m_filename.empty())
         throwError("Can't read BPF file without filename.");
+    if (m_args->m_threads < 1)
+        throwError("Option 'threads' must be positive.");
 
     // Logfile doesn't get set until options are processed.
     m_header.setLog(log());
@@ -293,6 +301,9 @@ bool BpfReader::readPolarData()
 
 void BpfReader::ready(PointTableRef)
 {
+    // The whole file gets consumed from here on; ask the OS to start
+    // pulling the point data into its cache.
+    IStream::readAhead(m_filename, m_header.m_len);
     m_istreamPtr = Utils::openFile(m_filename);
     m_stream = ILeStream(m_istreamPtr);
     m_stream.seek(m_header.m_len);
@@ -302,13 +313,7 @@ void BpfReader::ready(PointTableRef)
     if (m_header.m_compression)
     {
         m_deflateBuf.resize(numPoints() * m_dims.size() * sizeof(float));
-        size_t index = 0;
-        size_t bytesRead = 0;
-        do
-        {
-            bytesRead = readBlock(m_deflateBuf, index);
-            index += bytesRead;
-        } while (bytesRead > 0 && index < m_deflateBuf.size());
+        readCompressedData();
         m_charbuf.initialize(m_deflateBuf.data(), m_deflateBuf.size(), m_start);
         m_stream.pushStream(new std::istream(&m_charbuf));
     }
@@ -316,6 +321,69 @@ void BpfReader::ready(PointTableRef)
 }
 
 
+#ifdef PDAL_HAVE_ZLIB
+// Each compressed segment is an independent zlib stream, so segments are
+// pulled off the file serially and inflated in parallel.
+void BpfReader::readCompressedData()
+{
+    struct Segment
+    {
+        std::vector<char> m_in;
+        size_t m_outPos;
+        uint32_t m_outSize;
+    };
+
+    std::vector<Segment> segments;
+    size_t index = 0;
+    while (index < m_deflateBuf.size())
+    {
+        uint32_t finalBytes;
+        uint32_t compressBytes;
+
+        m_stream >> finalBytes;
+        m_stream >> compressBytes;
+        if (!m_stream || finalBytes == 0 ||
+            index + finalBytes > m_deflateBuf.size())
+            break;
+
+        Segment seg;
+        seg.m_in.resize(compressBytes);
+        m_stream.get(seg.m_in);
+        if (!m_stream)
+            break;
+        seg.m_outPos = index;
+        seg.m_outSize = finalBytes;
+        index += finalBytes;
+        segments.push_back(std::move(seg));
+    }
+
+    std::atomic<bool> ok(true);
+    auto decode = [this, &ok](Segment& seg)
+    {
+        if (inflate(seg.m_in.data(), (uint32_t)seg.m_in.size(),
+                m_deflateBuf.data() + seg.m_outPos, seg.m_outSize))
+            ok = false;
+    };
+
+    if (m_args->m_threads > 1 && segments.size() > 1)
+    {
+        ThreadPool pool((std::min)((size_t)m_args->m_threads,
+            segments.size()));
+        for (Segment& seg : segments)
+            pool.add([&decode, &seg]()
+                { decode(seg); });
+        pool.join();
+    }
+    else
+        for (Segment& seg : segments)
+            decode(seg);
+
+    if (!ok)
+        throwError("Error decompressing BPF point data.");
+}
+#endif // PDAL_HAVE_ZLIB
+
+
 void BpfReader::done(PointTableRef)
 {
     if (auto s = m_stream.popStream())
@@ -488,24 +556,27 @@ void BpfReader::readDimMajor(PointRef& point)
 
 point_count_t BpfReader::readDimMajor(PointViewPtr data, point_count_t count)
 {
-    PointId idx(0);
     PointId startId = data->size();
-    point_count_t numRead = 0;
+    point_count_t numRead = (std::min)(count, numPoints() - m_index);
+
+    // Each dimension's values are contiguous, so pull each column in a
+    // single read rather than extracting a float at a time.
+    std::vector<char> colBuf(numRead * sizeof(float));
     for (size_t d = 0; d < m_dims.size(); ++d)
     {
-        idx = m_index;
+        seekDimMajor(d, m_index);
+        m_stream.get(colBuf);
+        LeExtractor in(colBuf.data(), colBuf.size());
         PointId nextId = startId;
-        numRead = 0;
-        seekDimMajor(d, idx);
-        for (; numRead < count && idx < numPoints(); idx++, numRead++, nextId++)
+        for (point_count_t i = 0; i < numRead; ++i, ++nextId)
         {
             float f;
 
-            m_stream >> f;
+            in >> f;
             data->setField(m_dims[d].m_id, nextId, f + m_dims[d].m_offset);
         }
     }
-    m_index = idx;
+    m_index += numRead;
 
     // Transformation only applies to X, Y and Z
     for (PointId idx = startId; idx < data->size(); idx++)
@@ -655,24 +726,6 @@ void BpfReader::seekByteMajor(size_t dimIdx, size_t byteIdx, PointId ptIdx)
 
 
 #ifdef PDAL_HAVE_ZLIB
-size_t BpfReader::readBlock(std::vector<char>& outBuf, size_t index)
-{
-    uint32_t finalBytes;
-    uint32_t compressBytes;
-
-    m_stream >> finalBytes;
-    m_stream >> compressBytes;
-
-    std::vector<char> in(compressBytes);
-
-    // Fill the input bytes from the stream.
-    m_stream.get(in);
-    int ret = inflate(in.data(), compressBytes,
-        outBuf.data() + index, finalBytes);
-    return (ret ? 0 : finalBytes);
-}
-
-
 int BpfReader::inflate(char *buf, uint32_t insize,
     char *outbuf, uint32_t outsize)
 {
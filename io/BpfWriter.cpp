@@ -152,7 +152,9 @@ void BpfWriter::readyFile(const std::string& filename,
     const SpatialReference& srs)
 {
     m_curFilename = filename;
-    m_stream.open(filename);
+    // Stage output through the async double buffer so encoding isn't
+    // stalled by device latency.
+    m_stream.open(filename, true);
     m_header.m_version = 3;
     m_header.m_numDim = m_dims.size();
     m_header.m_numPts = 0;
@@ -37,11 +37,12 @@
 #include <pdal/pdal_export.hpp>
 #include <pdal/PointView.hpp>
 #include <pdal/Reader.hpp>
+#include <pdal/Streamable.hpp>
 
 namespace pdal
 {
 
-class PDAL_DLL BufferReader : public pdal::Reader
+class PDAL_DLL BufferReader : public pdal::Reader, public pdal::Streamable
 {
 public:
     BufferReader() : Reader()
@@ -52,6 +53,49 @@ public:
 
 private:
     PointViewSet m_views;
+    PointViewSet::const_iterator m_curView;
+    PointId m_curIdx;
+    DimTypeList m_dims;
+    std::vector<char> m_buf;
+
+    virtual void addDimensions(PointLayoutPtr layout)
+    {
+        for (const PointViewPtr& v : m_views)
+            for (const DimType& dt : v->dimTypes())
+                layout->registerDim(dt.m_id, dt.m_type);
+    }
+
+    virtual void ready(PointTableRef /*table*/)
+    {
+        m_curView = m_views.begin();
+        m_curIdx = 0;
+    }
+
+    virtual bool processOne(PointRef& point)
+    {
+        // Move past exhausted views.
+        while (m_curView != m_views.end() && m_curIdx >= (*m_curView)->size())
+        {
+            ++m_curView;
+            m_curIdx = 0;
+        }
+        if (m_curView == m_views.end())
+            return false;
+
+        const PointViewPtr& v = *m_curView;
+        if (m_curIdx == 0)
+        {
+            m_dims = v->dimTypes();
+            size_t size = 0;
+            for (const DimType& dt : m_dims)
+                size += Dimension::size(dt.m_type);
+            m_buf.resize(size);
+        }
+        v->getPackedPoint(m_dims, m_curIdx, m_buf.data());
+        point.setPackedData(m_dims, m_buf.data());
+        m_curIdx++;
+        return true;
+    }
 
     virtual PointViewSet run(PointViewPtr /*view*/)
         { return m_views; }
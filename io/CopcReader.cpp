@@ -0,0 +1,1064 @@
+/******************************************************************************
+* Copyright (c) 2021, Hobu Inc.
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+*       names of its contributors may be used to endorse or promote
+*       products derived from this software without specific prior
+*       written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#include "CopcReader.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include <pdal/PDALUtils.hpp>
+#include <pdal/PointView.hpp>
+#include <pdal/Polygon.hpp>
+#include <pdal/QuickInfo.hpp>
+#include <pdal/SrsBounds.hpp>
+#include <pdal/pdal_features.hpp>
+#include <pdal/util/Extractor.hpp>
+#include <pdal/util/ProgramArgs.hpp>
+#include <pdal/util/ThreadPool.hpp>
+#include <pdal/private/SrsTransform.hpp>
+
+#include "LasUtils.hpp"
+#include "LasVLR.hpp"
+#include "private/ept/Connector.hpp"
+
+#ifdef PDAL_HAVE_LAZPERF
+#include <lazperf/lazperf.hpp>
+#endif
+
+namespace pdal
+{
+
+namespace
+{
+
+const StaticPluginInfo s_info
+{
+    "readers.copc",
+    "COPC Reader",
+    "http://pdal.io/stages/readers.copc.html",
+    { "copc" }
+};
+
+// Sizes fixed by the LAS 1.4 and COPC specifications.
+const uint64_t lasHeaderSize = 375;
+const uint64_t vlrHeaderSize = 54;
+const uint64_t copcVlrSize = 160;
+const uint64_t hierarchyEntrySize = 32;
+
+const uint16_t WktRecordId = 2112;
+const uint16_t ExtraBytesRecordId = 4;
+
+struct PolyXform
+{
+    Polygon poly;
+    SrsTransform xform;
+};
+
+struct BoxXform
+{
+    BOX3D box;
+    SrsTransform xform;
+};
+
+} // unnamed namespace
+
+CREATE_STATIC_STAGE(CopcReader, s_info);
+
+// One entry in the COPC hierarchy: an octree voxel and the byte range of
+// the LAZ chunk holding its points.  A point count of -1 means the entry
+// refers to a child hierarchy page rather than point data.
+struct CopcNode
+{
+    int32_t d = 0;
+    int32_t x = 0;
+    int32_t y = 0;
+    int32_t z = 0;
+    uint64_t offset = 0;
+    int32_t byteSize = 0;
+    int32_t pointCount = 0;
+
+    // Octree-key ordering, matching ept::Key.
+    bool operator<(const CopcNode& other) const
+    {
+        if (d != other.d)
+            return d < other.d;
+        if (x != other.x)
+            return x < other.x;
+        if (y != other.y)
+            return y < other.y;
+        return z < other.z;
+    }
+
+    std::string toString() const
+    {
+        return std::to_string(d) + "-" + std::to_string(x) + "-" +
+            std::to_string(y) + "-" + std::to_string(z);
+    }
+};
+
+// A node's chunk, fetched and decompressed to raw LAS point records.
+struct CopcTile
+{
+    CopcNode node;
+    std::vector<char> buf;
+    std::string error;
+
+    point_count_t size() const
+    { return (point_count_t)node.pointCount; }
+};
+
+struct CopcReader::Args
+{
+    SrsBounds bounds;
+    std::vector<Polygon> polys;
+    std::size_t threads = 0;
+    double resolution = 0;
+    NL::json headers;
+    NL::json query;
+    std::size_t prefetchMb = 2048;
+};
+
+struct CopcReader::Private
+{
+    std::unique_ptr<Connector> connector;
+    std::unique_ptr<TaskGroup> tasks;
+
+    // Fields parsed from the LAS header.
+    int pdrf = 0;
+    uint16_t pointLen = 0;
+    uint16_t ebCount = 0;
+    uint32_t pointOffset = 0;
+    uint64_t pointCount = 0;
+    uint8_t versionMajor = 0;
+    uint8_t versionMinor = 0;
+    bool compressed = false;
+    double scale[3] { 1, 1, 1 };
+    double offset[3] { 0, 0, 0 };
+    BOX3D headerBounds;
+
+    // Fields parsed from the COPC info VLR.
+    double center[3] { 0, 0, 0 };
+    double halfsize = 0;
+    double spacing = 0;
+    uint64_t rootHierOffset = 0;
+    uint64_t rootHierSize = 0;
+
+    std::vector<ExtraDim> extraDims;
+
+    // Spatial/resolution query state.
+    std::vector<PolyXform> polys;
+    BoxXform queryBounds;
+    uint32_t depthEnd = 0;
+
+    // Overlapping octree nodes in key order and the tile pipeline.
+    std::vector<CopcNode> nodes;
+    std::map<uint64_t, CopcTile> contents;
+    std::unique_ptr<CopcTile> currentTile;
+    std::string hierarchyError;
+    size_t nextSubmit = 0;
+    uint64_t nextConsume = 0;
+    uint64_t queuedBytes = 0;
+    size_t tileCount = 0;
+    PointId pointId = 0;
+    std::mutex mutex;
+    std::condition_variable contentsCv;
+
+    bool hasColor() const
+    { return pdrf == 7 || pdrf == 8; }
+    bool hasInfrared() const
+    { return pdrf == 8; }
+};
+
+namespace
+{
+
+#ifdef PDAL_HAVE_LAZPERF
+// Decompress a complete LAZ chunk fetched into memory.  COPC chunks are
+// independently compressed, so each can be decoded without any other
+// file state.
+std::vector<char> decompressChunk(const std::vector<char>& in, int format,
+    int ebCount, uint16_t pointLen, point_count_t count)
+{
+    std::vector<char> out(count * pointLen);
+
+    const unsigned char *pos =
+        reinterpret_cast<const unsigned char *>(in.data());
+    const unsigned char *end = pos + in.size();
+    auto cb = [&pos, end](unsigned char *buf, size_t len)
+    {
+        if (len > (size_t)(end - pos))
+            throw pdal_error("Read past end of COPC chunk data.");
+        std::copy(pos, pos + len, buf);
+        pos += len;
+    };
+
+    lazperf::las_decompressor::ptr decompressor =
+        lazperf::build_las_decompressor(cb, format, ebCount);
+    char *o = out.data();
+    for (point_count_t i = 0; i < count; ++i)
+    {
+        decompressor->decompress(o);
+        o += pointLen;
+    }
+    return out;
+}
+#endif
+
+} // unnamed namespace
+
+
+CopcReader::CopcReader() : m_args(new CopcReader::Args),
+    m_p(new CopcReader::Private)
+{}
+
+
+CopcReader::~CopcReader()
+{}
+
+
+std::string CopcReader::getName() const
+{
+    return s_info.name;
+}
+
+
+void CopcReader::addArgs(ProgramArgs& args)
+{
+    args.add("bounds", "Bounds to fetch", m_args->bounds);
+    args.add("requests", "Number of worker threads", m_args->threads,
+        (size_t)15);
+    args.addSynonym("requests", "threads");
+    args.add("resolution", "Resolution limit", m_args->resolution);
+    args.add("polygon", "Bounding polygon(s) to crop requests",
+        m_args->polys).setErrorText("Invalid polygon specification. "
+            "Must be valid GeoJSON/WKT");
+    args.add("header", "Header fields to forward with HTTP requests",
+        m_args->headers);
+    args.add("query", "Query parameters to forward with HTTP requests",
+        m_args->query);
+    args.add("prefetch_mb", "Approximate maximum megabytes of decoded tiles "
+        "buffered ahead of processing", m_args->prefetchMb, (size_t)2048);
+}
+
+
+bool CopcReader::pushSpatialPredicate(const Bounds& bounds)
+{
+    // The pushed bounds are in the file's native coordinate system, the
+    // same system in which a user-supplied 'bounds' option is
+    // interpreted.  A user-supplied option wins.
+    m_options.addConditional(Option("bounds", Utils::toString(bounds)));
+    return true;
+}
+
+
+void CopcReader::setForwards(StringMap& headers, StringMap& query)
+{
+    try
+    {
+        if (!m_args->headers.is_null())
+            headers = m_args->headers.get<StringMap>();
+    }
+    catch (const std::exception& err)
+    {
+        throwError(std::string("Error parsing 'header': ") + err.what());
+    }
+
+    try
+    {
+        if (!m_args->query.is_null())
+            query = m_args->query.get<StringMap>();
+    }
+    catch (const std::exception& err)
+    {
+        throwError(std::string("Error parsing 'query': ") + err.what());
+    }
+}
+
+
+void CopcReader::initialize(PointTableRef table)
+{
+    const std::size_t threads((std::max)(m_args->threads, size_t(4)));
+    if (threads > 100)
+        log()->get(LogLevel::Warning) << "Using a large thread count: " <<
+            threads << " threads" << std::endl;
+    // Tasks run on the process-wide shared pool; the thread count caps
+    // this stage's tasks in flight so concurrent stages don't
+    // oversubscribe the machine with competing pools.
+    m_p->tasks.reset(new TaskGroup(ThreadPool::shared(), threads));
+
+    StringMap headers;
+    StringMap query;
+    setForwards(headers, query);
+    m_p->connector.reset(new Connector(headers, query));
+
+    try
+    {
+        fetchHeader();
+    }
+    catch (const arbiter::ArbiterError& err)
+    {
+        throwError(err.what());
+    }
+
+    // Create transformation from the source SRS to the bounds SRS.
+    if (m_args->bounds.valid())
+    {
+        if (m_args->bounds.is2d())
+        {
+            m_p->queryBounds.box = BOX3D(m_args->bounds.to2d());
+            m_p->queryBounds.box.minz =
+                (std::numeric_limits<double>::lowest)();
+            m_p->queryBounds.box.maxz = (std::numeric_limits<double>::max)();
+        }
+        else
+            m_p->queryBounds.box = m_args->bounds.to3d();
+        const SpatialReference& boundsSrs = m_args->bounds.spatialReference();
+        if (!getSpatialReference().valid() && boundsSrs.valid())
+            throwError("Can't use bounds with SRS with data source that "
+                "has no SRS.");
+        if (boundsSrs.valid())
+            m_p->queryBounds.xform =
+                SrsTransform(getSpatialReference(), boundsSrs);
+    }
+
+    // Create transforms from the source SRS to each poly SRS.
+    for (Polygon& poly : m_args->polys)
+    {
+        if (!poly.valid())
+            throwError("Geometrically invalid polygon in option 'polygon'.");
+
+        // Get the sub-polygons from a multi-polygon.
+        std::vector<Polygon> exploded = poly.polygons();
+        SrsTransform xform;
+        if (poly.srsValid())
+            xform.set(getSpatialReference(), poly.getSpatialReference());
+        for (Polygon& p : exploded)
+        {
+            PolyXform ps { std::move(p), xform };
+            m_p->polys.push_back(ps);
+        }
+    }
+
+    // Figure out our max depth.  The root node's points are spaced at
+    // 'spacing'; each level down halves it.
+    const double queryResolution(m_args->resolution);
+    m_p->depthEnd = 0;
+    if (queryResolution)
+    {
+        double currentResolution = m_p->spacing;
+
+        // To select the current resolution level, we need depthEnd to be
+        // one beyond it - this is a non-inclusive parameter.
+        ++m_p->depthEnd;
+        while (currentResolution > queryResolution)
+        {
+            currentResolution /= 2;
+            ++m_p->depthEnd;
+        }
+
+        log()->get(LogLevel::Debug) << "Depth end: " << m_p->depthEnd << "\n";
+    }
+}
+
+
+// Fetch the LAS header and the COPC info VLR, which the specification
+// requires to be the first VLR, with a single ranged read.
+void CopcReader::fetchHeader()
+{
+    const uint64_t size = lasHeaderSize + vlrHeaderSize + copcVlrSize;
+    std::vector<char> buf =
+        m_p->connector->getBinary(m_filename, 0, size);
+
+    LeExtractor in(buf.data(), buf.size());
+
+    std::string magic;
+    in.get(magic, 4);
+    if (magic != "LASF")
+        throwError("Invalid COPC file - file signature is not 'LASF'.");
+    in.skip(20);
+    in >> m_p->versionMajor >> m_p->versionMinor;
+    in.skip(70);
+
+    uint32_t vlrCount;
+    uint8_t rawFormat;
+    in >> m_p->pointOffset >> vlrCount;
+    in >> rawFormat >> m_p->pointLen;
+    m_p->compressed = rawFormat & 0x80;
+    m_p->pdrf = rawFormat & 0x3f;
+    in.skip(4 + 5 * 4);  // Legacy point counts.
+
+    in >> m_p->scale[0] >> m_p->scale[1] >> m_p->scale[2];
+    in >> m_p->offset[0] >> m_p->offset[1] >> m_p->offset[2];
+
+    double maxx, minx, maxy, miny, maxz, minz;
+    in >> maxx >> minx >> maxy >> miny >> maxz >> minz;
+    m_p->headerBounds = BOX3D(minx, miny, minz, maxx, maxy, maxz);
+
+    in.skip(8);  // Wave packet offset.
+    in.skip(8 + 4);  // EVLR offset/count.
+    in >> m_p->pointCount;
+    in.skip(15 * 8);  // Point counts by return.
+
+    // COPC info VLR header.
+    uint16_t reserved, recordId, recordLen;
+    std::string userId, description;
+    in >> reserved;
+    in.get(userId, 16);
+    in >> recordId >> recordLen;
+    in.get(description, 32);
+    if (userId != "copc" || recordId != 1)
+        throwError("Invalid COPC file - COPC info VLR is not the "
+            "first VLR.");
+    if (recordLen != copcVlrSize)
+        throwError("Invalid COPC file - bad COPC info VLR size.");
+
+    in >> m_p->center[0] >> m_p->center[1] >> m_p->center[2];
+    in >> m_p->halfsize >> m_p->spacing;
+    in >> m_p->rootHierOffset >> m_p->rootHierSize;
+
+    validateHeader();
+
+    // Fetch the remaining VLRs, which sit between the COPC info VLR and
+    // the point data.
+    const uint64_t vlrOffset = lasHeaderSize + vlrHeaderSize + copcVlrSize;
+    if (m_p->pointOffset > vlrOffset)
+        parseVlrs(m_p->connector->getBinary(m_filename, vlrOffset,
+            m_p->pointOffset - vlrOffset));
+}
+
+
+void CopcReader::validateHeader()
+{
+    if (m_p->versionMajor != 1 || m_p->versionMinor != 4)
+        throwError("Invalid COPC file - must be LAS version 1.4, not " +
+            std::to_string(m_p->versionMajor) + "." +
+            std::to_string(m_p->versionMinor) + ".");
+    if (!m_p->compressed)
+        throwError("Invalid COPC file - point data is not compressed.");
+    if (m_p->pdrf < 6 || m_p->pdrf > 8)
+        throwError("Invalid COPC file - point format must be 6, 7 or 8, "
+            "not " + std::to_string(m_p->pdrf) + ".");
+
+    const uint16_t baseLen = m_p->pdrf == 6 ? 30 : (m_p->pdrf == 7 ? 36 : 38);
+    if (m_p->pointLen < baseLen)
+        throwError("Invalid COPC file - point length is smaller than its "
+            "point format allows.");
+    m_p->ebCount = m_p->pointLen - baseLen;
+}
+
+
+// Walk the VLRs that follow the COPC info VLR, looking for the SRS and
+// any extra bytes specification.
+void CopcReader::parseVlrs(const std::vector<char>& vlrData)
+{
+    LeExtractor in(vlrData.data(), vlrData.size());
+    uint64_t remaining = vlrData.size();
+
+    while (remaining >= vlrHeaderSize)
+    {
+        uint16_t reserved, recordId, recordLen;
+        std::string userId, description;
+        in >> reserved;
+        in.get(userId, 16);
+        in >> recordId >> recordLen;
+        in.get(description, 32);
+        remaining -= vlrHeaderSize;
+        if (recordLen > remaining)
+            break;
+
+        if (userId == TRANSFORM_USER_ID && recordId == WktRecordId)
+        {
+            std::string wkt;
+            in.get(wkt, recordLen);
+            setSpatialReference(SpatialReference(wkt));
+        }
+        else if (userId == SPEC_USER_ID && recordId == ExtraBytesRecordId &&
+            recordLen % sizeof(ExtraBytesSpec) == 0)
+        {
+            const char *pos = vlrData.data() + (vlrData.size() - remaining);
+            size_t count = recordLen / sizeof(ExtraBytesSpec);
+            while (count--)
+            {
+                ExtraBytesIf eb;
+                eb.readFrom(pos);
+                for (auto& ed : eb.toExtraDims())
+                    m_p->extraDims.push_back(std::move(ed));
+                pos += sizeof(ExtraBytesSpec);
+            }
+            in.skip(recordLen);
+        }
+        else
+            in.skip(recordLen);
+        remaining -= recordLen;
+    }
+}
+
+
+QuickInfo CopcReader::inspect()
+{
+    QuickInfo qi;
+    std::unique_ptr<PointLayout> layout(new PointLayout());
+
+    RowPointTable table;
+    initialize(table);
+    addDimensions(layout.get());
+
+    Dimension::IdList dims = layout->dims();
+    for (auto di = dims.begin(); di != dims.end(); ++di)
+        qi.m_dimNames.push_back(layout->dimName(*di));
+    if (!Utils::numericCast(m_p->pointCount, qi.m_pointCount))
+        qi.m_pointCount = (std::numeric_limits<point_count_t>::max)();
+    qi.m_bounds = m_p->headerBounds;
+    qi.m_srs = getSpatialReference();
+    qi.m_valid = true;
+
+    return qi;
+}
+
+
+void CopcReader::addDimensions(PointLayoutPtr layout)
+{
+    using namespace Dimension;
+
+    layout->registerDim(Id::X, Type::Double);
+    layout->registerDim(Id::Y, Type::Double);
+    layout->registerDim(Id::Z, Type::Double);
+    layout->registerDim(Id::Intensity, Type::Unsigned16);
+    layout->registerDim(Id::ReturnNumber, Type::Unsigned8);
+    layout->registerDim(Id::NumberOfReturns, Type::Unsigned8);
+    layout->registerDim(Id::ScanDirectionFlag, Type::Unsigned8);
+    layout->registerDim(Id::EdgeOfFlightLine, Type::Unsigned8);
+    layout->registerDim(Id::Classification, Type::Unsigned8);
+    layout->registerDim(Id::ScanAngleRank, Type::Float);
+    layout->registerDim(Id::UserData, Type::Unsigned8);
+    layout->registerDim(Id::PointSourceId, Type::Unsigned16);
+    layout->registerDim(Id::GpsTime, Type::Double);
+    layout->registerDim(Id::ScanChannel);
+    layout->registerDim(Id::ClassFlags);
+    if (m_p->hasColor())
+    {
+        layout->registerDim(Id::Red, Type::Unsigned16);
+        layout->registerDim(Id::Green, Type::Unsigned16);
+        layout->registerDim(Id::Blue, Type::Unsigned16);
+    }
+    if (m_p->hasInfrared())
+        layout->registerDim(Id::Infrared);
+
+    size_t ebLen = m_p->ebCount;
+    for (auto& dim : m_p->extraDims)
+    {
+        if (dim.m_size > ebLen)
+            throwError("Extra byte specification exceeds point length "
+                "beyond base format length.");
+        ebLen -= dim.m_size;
+
+        Dimension::Type type = dim.m_dimType.m_type;
+        if (type == Dimension::Type::None)
+            continue;
+        if (dim.m_dimType.m_xform.nonstandard())
+            type = Dimension::Type::Double;
+        dim.m_dimType.m_id = layout->registerOrAssignDim(dim.m_name, type);
+    }
+}
+
+
+// Compute the bounds of an octree voxel from the COPC info cube.
+BOX3D CopcReader::nodeBounds(const CopcNode& node) const
+{
+    const double size = (m_p->halfsize * 2) / (double)((uint64_t)1 << node.d);
+    const double minx = m_p->center[0] - m_p->halfsize + node.x * size;
+    const double miny = m_p->center[1] - m_p->halfsize + node.y * size;
+    const double minz = m_p->center[2] - m_p->halfsize + node.z * size;
+    return BOX3D(minx, miny, minz, minx + size, miny + size, minz + size);
+}
+
+
+bool CopcReader::hasSpatialFilter() const
+{
+    return !m_p->polys.empty() || m_p->queryBounds.box.valid();
+}
+
+
+// Determine if an octree node overlaps our query boundary.
+bool CopcReader::passesSpatialFilter(const BOX3D& tileBounds) const
+{
+    // Reproject the tile bounds to the largest rect. solid that contains
+    // all the corners.
+    auto reproject = [](BOX3D src, SrsTransform& xform) -> BOX3D
+    {
+        if (!xform.valid())
+            return src;
+
+        BOX3D b;
+        auto reprogrow = [&b, &xform](double x, double y, double z)
+        {
+            xform.transform(x, y, z);
+            b.grow(x, y, z);
+        };
+
+        reprogrow(src.minx, src.miny, src.minz);
+        reprogrow(src.maxx, src.miny, src.minz);
+        reprogrow(src.minx, src.maxy, src.minz);
+        reprogrow(src.maxx, src.maxy, src.minz);
+        reprogrow(src.minx, src.miny, src.maxz);
+        reprogrow(src.maxx, src.miny, src.maxz);
+        reprogrow(src.minx, src.maxy, src.maxz);
+        reprogrow(src.maxx, src.maxy, src.maxz);
+        return b;
+    };
+
+    auto boxOverlaps = [this, &reproject, &tileBounds]() -> bool
+    {
+        if (!m_p->queryBounds.box.valid())
+            return false;
+
+        return reproject(tileBounds,
+            m_p->queryBounds.xform).overlaps(m_p->queryBounds.box);
+    };
+
+    auto polysOverlap = [this, &reproject, &tileBounds]() -> bool
+    {
+        for (auto& ps : m_p->polys)
+            if (!ps.poly.disjoint(reproject(tileBounds, ps.xform)))
+                return true;
+        return false;
+    };
+
+    // If there's no spatial filter, we always overlap.
+    if (!hasSpatialFilter())
+        return true;
+
+    // Hierarchy pages are processed in the thread pool, so transform use
+    // must be serialized.
+    std::lock_guard<std::mutex> lock(m_p->mutex);
+    return boxOverlaps() || polysOverlap();
+}
+
+
+// Parse a hierarchy page, pruning nodes that fail the spatial or
+// resolution query and fetching child pages in the thread pool.
+void CopcReader::loadHierarchyPage(uint64_t offset, uint64_t size)
+{
+    if (size % hierarchyEntrySize)
+        throw pdal_error("Invalid COPC file - bad hierarchy page size.");
+
+    std::vector<char> page = m_p->connector->getBinary(m_filename,
+        offset, size);
+    LeExtractor in(page.data(), page.size());
+
+    for (uint64_t i = 0; i < size / hierarchyEntrySize; ++i)
+    {
+        CopcNode node;
+        in >> node.d >> node.x >> node.y >> node.z;
+        in >> node.offset >> node.byteSize >> node.pointCount;
+
+        if (m_p->depthEnd && (uint32_t)node.d >= m_p->depthEnd)
+            continue;
+        if (!passesSpatialFilter(nodeBounds(node)))
+            continue;
+
+        if (node.pointCount < 0)
+        {
+            // A child hierarchy page.  Fetch and parse it in the pool.
+            // Hierarchy fetches gate the query, so they jump ahead of any
+            // queued chunk loads.
+            m_p->tasks->add([this, node]()
+            {
+                try
+                {
+                    loadHierarchyPage(node.offset, node.byteSize);
+                }
+                catch (const std::exception& ex)
+                {
+                    std::lock_guard<std::mutex> lock(m_p->mutex);
+                    if (m_p->hierarchyError.empty())
+                        m_p->hierarchyError = ex.what();
+                }
+            }, ThreadPool::Priority::High);
+        }
+        else if (node.pointCount > 0)
+        {
+            std::lock_guard<std::mutex> lock(m_p->mutex);
+            m_p->nodes.push_back(node);
+        }
+    }
+}
+
+
+void CopcReader::ready(PointTableRef table)
+{
+#ifndef PDAL_HAVE_LAZPERF
+    throwError("Can't read COPC data: PDAL not built with LAZperf.");
+#endif
+
+    // Traverse the hierarchy, starting from the root page, to find the
+    // nodes that overlap the query.
+    m_p->tasks->cancel();
+    m_p->nodes.clear();
+    m_p->hierarchyError.clear();
+    try
+    {
+        loadHierarchyPage(m_p->rootHierOffset, m_p->rootHierSize);
+    }
+    catch (const std::exception& ex)
+    {
+        throwError(ex.what());
+    }
+    m_p->tasks->await();
+    if (m_p->hierarchyError.size())
+        throwError("Error reading hierarchy: " + m_p->hierarchyError);
+
+    std::sort(m_p->nodes.begin(), m_p->nodes.end());
+
+    point_count_t overlapPoints(0);
+    for (const CopcNode& node : m_p->nodes)
+        overlapPoints += node.pointCount;
+    log()->get(LogLevel::Debug) << "Overlapping nodes: " <<
+        m_p->nodes.size() << " with " << overlapPoints << " points\n";
+
+    m_p->pointId = 0;
+    m_p->tileCount = m_p->nodes.size();
+
+    // Queue up chunk requests in octree-key order, limited by the
+    // prefetch budget.  Further requests are submitted as tiles are
+    // consumed.
+    m_p->nextSubmit = 0;
+    m_p->nextConsume = 0;
+    m_p->queuedBytes = 0;
+    m_p->contents.clear();
+    fillLoadQueue();
+}
+
+
+// Start a thread to fetch and decompress a node's chunk.  When done,
+// stick the tile on the queue and notify the main thread.
+void CopcReader::load(const CopcNode& node, uint64_t seq)
+{
+    m_p->tasks->add([this, node, seq]()
+    {
+        CopcTile tile;
+        tile.node = node;
+        try
+        {
+            std::vector<char> comp = m_p->connector->getBinary(m_filename,
+                node.offset, node.byteSize);
+#ifdef PDAL_HAVE_LAZPERF
+            tile.buf = decompressChunk(comp, m_p->pdrf, m_p->ebCount,
+                m_p->pointLen, node.pointCount);
+#endif
+        }
+        catch (const std::exception& ex)
+        {
+            tile.error = ex.what();
+        }
+
+        std::unique_lock<std::mutex> l(m_p->mutex);
+        m_p->contents.emplace(seq, std::move(tile));
+        l.unlock();
+        m_p->contentsCv.notify_one();
+    });
+}
+
+
+// Submit fetches, in octree-key order, until the estimated size of
+// fetched-but-unconsumed tiles reaches the prefetch budget.  At least one
+// tile beyond the next to be consumed is always in flight so the consumer
+// can make progress.
+void CopcReader::fillLoadQueue()
+{
+    uint64_t budget = (uint64_t)m_args->prefetchMb * 1024 * 1024;
+
+    // Decide what to submit under the lock, but submit after releasing
+    // it: load() blocks at the task group's in-flight cap, and the tile
+    // tasks it would wait on need the mutex to finish.
+    std::vector<uint64_t> submit;
+    std::unique_lock<std::mutex> lock(m_p->mutex);
+    while (m_p->nextSubmit < m_p->nodes.size() &&
+        (m_p->queuedBytes < budget ||
+         m_p->nextSubmit == m_p->nextConsume))
+    {
+        const CopcNode& node = m_p->nodes[m_p->nextSubmit];
+        m_p->queuedBytes += (uint64_t)node.pointCount * m_p->pointLen;
+        submit.push_back(m_p->nextSubmit);
+        m_p->nextSubmit++;
+    }
+    lock.unlock();
+
+    for (uint64_t seq : submit)
+        load(m_p->nodes[seq], seq);
+}
+
+
+// Block until the next tile in key order has been decoded and hand it to
+// the caller, then top off the fetch queue.
+CopcTile CopcReader::nextTile()
+{
+    std::unique_lock<std::mutex> l(m_p->mutex);
+    m_p->contentsCv.wait(l, [this]()
+    {
+        auto it = m_p->contents.begin();
+        return it != m_p->contents.end() && it->first == m_p->nextConsume;
+    });
+
+    auto it = m_p->contents.begin();
+    CopcTile tile = std::move(it->second);
+    m_p->contents.erase(it);
+    uint64_t bytes = (uint64_t)tile.size() * m_p->pointLen;
+    m_p->queuedBytes -= (std::min)(m_p->queuedBytes, bytes);
+    m_p->nextConsume++;
+    l.unlock();
+
+    fillLoadQueue();
+    return tile;
+}
+
+
+void CopcReader::checkTile(const CopcTile& tile)
+{
+    if (tile.error.size())
+    {
+        m_p->tasks->cancel();
+        throwError("Error reading tile '" + tile.node.toString() + "': " +
+            tile.error);
+    }
+}
+
+
+// This code runs in a single thread, so doesn't need locking.
+bool CopcReader::processPoint(PointRef& dst, const char *buf)
+{
+    using namespace Dimension;
+
+    LeExtractor istream(buf, m_p->pointLen);
+
+    int32_t xi, yi, zi;
+    istream >> xi >> yi >> zi;
+
+    double x = xi * m_p->scale[0] + m_p->offset[0];
+    double y = yi * m_p->scale[1] + m_p->offset[1];
+    double z = zi * m_p->scale[2] + m_p->offset[2];
+
+    auto passesBoundsFilter = [this](double x, double y, double z)
+    {
+        if (!m_p->queryBounds.box.valid())
+            return false;
+        m_p->queryBounds.xform.transform(x, y, z);
+        return m_p->queryBounds.box.contains(x, y, z);
+    };
+
+    auto passesPolyFilter = [this](double xo, double yo, double zo)
+    {
+        for (PolyXform& ps : m_p->polys)
+        {
+            double x = xo;
+            double y = yo;
+            double z = zo;
+
+            ps.xform.transform(x, y, z);
+            if (ps.poly.contains(x, y))
+                return true;
+        }
+        return false;
+    };
+
+    // If there is a spatial filter, make sure it passes.
+    if (hasSpatialFilter())
+        if (!passesBoundsFilter(x, y, z) && !passesPolyFilter(x, y, z))
+            return false;
+
+    uint16_t intensity;
+    uint8_t returnInfo;
+    uint8_t flags;
+    uint8_t classification;
+    uint8_t user;
+    int16_t scanAngle;
+    uint16_t pointSourceId;
+    double gpsTime;
+
+    istream >> intensity >> returnInfo >> flags >> classification >> user >>
+        scanAngle >> pointSourceId >> gpsTime;
+
+    uint8_t returnNum = returnInfo & 0x0F;
+    uint8_t numReturns = (returnInfo >> 4) & 0x0F;
+    uint8_t classFlags = flags & 0x0F;
+    uint8_t scanChannel = (flags >> 4) & 0x03;
+    uint8_t scanDirFlag = (flags >> 6) & 0x01;
+    uint8_t flight = (flags >> 7) & 0x01;
+
+    dst.setField(Id::X, x);
+    dst.setField(Id::Y, y);
+    dst.setField(Id::Z, z);
+    dst.setField(Id::Intensity, intensity);
+    dst.setField(Id::ReturnNumber, returnNum);
+    dst.setField(Id::NumberOfReturns, numReturns);
+    dst.setField(Id::ClassFlags, classFlags);
+    dst.setField(Id::ScanChannel, scanChannel);
+    dst.setField(Id::ScanDirectionFlag, scanDirFlag);
+    dst.setField(Id::EdgeOfFlightLine, flight);
+    dst.setField(Id::Classification, classification);
+    dst.setField(Id::ScanAngleRank, scanAngle * .006);
+    dst.setField(Id::UserData, user);
+    dst.setField(Id::PointSourceId, pointSourceId);
+    dst.setField(Id::GpsTime, gpsTime);
+
+    if (m_p->hasColor())
+    {
+        uint16_t red, green, blue;
+        istream >> red >> green >> blue;
+        dst.setField(Id::Red, red);
+        dst.setField(Id::Green, green);
+        dst.setField(Id::Blue, blue);
+    }
+
+    if (m_p->hasInfrared())
+    {
+        uint16_t nearInfraRed;
+        istream >> nearInfraRed;
+        dst.setField(Id::Infrared, nearInfraRed);
+    }
+
+    for (auto& dim : m_p->extraDims)
+    {
+        // Dimension type of None is undefined and unprocessed
+        if (dim.m_dimType.m_type == Dimension::Type::None)
+        {
+            istream.skip(dim.m_size);
+            continue;
+        }
+
+        Everything e = Utils::extractDim(istream, dim.m_dimType.m_type);
+        if (dim.m_dimType.m_xform.nonstandard())
+        {
+            double d = Utils::toDouble(e, dim.m_dimType.m_type);
+            d = d * dim.m_dimType.m_xform.m_scale.m_val +
+                dim.m_dimType.m_xform.m_offset.m_val;
+            dst.setField(dim.m_dimType.m_id, d);
+        }
+        else
+            dst.setField(dim.m_dimType.m_id, dim.m_dimType.m_type, &e);
+    }
+
+    return true;
+}
+
+
+point_count_t CopcReader::read(PointViewPtr view, point_count_t count)
+{
+    point_count_t numRead = 0;
+
+    if (m_p->nodes.size())
+    {
+        // Pop tiles in key order, waiting for them to appear as needed.
+        // Exit when we've handled all the tiles or we've read enough points.
+        do
+        {
+            CopcTile tile = nextTile();
+            checkTile(tile);
+            process(view, tile, count - numRead);
+            numRead += tile.size();
+            m_p->tileCount--;
+        } while (m_p->tileCount && numRead <= count);
+    }
+
+    // Wait for any running threads to finish and don't start any others.
+    // Only relevant if we hit the count limit before reading all the tiles.
+    m_p->tasks->cancel();
+
+    return numRead;
+}
+
+
+// Put the contents of a tile into the destination point view.
+void CopcReader::process(PointViewPtr dstView, const CopcTile& tile,
+    point_count_t count)
+{
+    PointRef dstPoint(*dstView);
+    const char *pos = tile.buf.data();
+    for (PointId idx = 0; idx < tile.size(); ++idx, pos += m_p->pointLen)
+    {
+        if (count-- == 0)
+            return;
+        dstPoint.setPointId(dstView->size());
+        processPoint(dstPoint, pos);
+    }
+}
+
+
+bool CopcReader::processOne(PointRef& point)
+{
+top:
+    if (m_p->tileCount == 0)
+        return false;
+
+    // If there is no active tile, grab one off the queue.  If none are
+    // available, wait.
+    if (!m_p->currentTile)
+    {
+        m_p->currentTile.reset(new CopcTile(nextTile()));
+        checkTile(*m_p->currentTile);
+        m_p->pointId = 0;
+    }
+
+    bool ok = processPoint(point,
+        m_p->currentTile->buf.data() + m_p->pointId * m_p->pointLen);
+    m_p->pointId++;
+
+    // If we've processed all the points in the current tile, pop it.
+    if (m_p->pointId == m_p->currentTile->size())
+    {
+        m_p->pointId = 0;
+        m_p->currentTile.reset();
+        --m_p->tileCount;
+    }
+
+    // If we didn't pass a point, try again.
+    if (!ok)
+        goto top;
+
+    return true;
+}
+
+
+void CopcReader::done(PointTableRef)
+{
+    if (m_p->tasks)
+        m_p->tasks->cancel();
+}
+
+} // namespace pdal
@@ -0,0 +1,100 @@
+/******************************************************************************
+* Copyright (c) 2021, Hobu Inc.
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+*       names of its contributors may be used to endorse or promote
+*       products derived from this software without specific prior
+*       written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include <pdal/Reader.hpp>
+#include <pdal/Streamable.hpp>
+#include <pdal/util/Bounds.hpp>
+
+namespace pdal
+{
+
+class BOX3D;
+struct CopcNode;
+struct CopcTile;
+
+using StringMap = std::map<std::string, std::string>;
+
+// Reader for Cloud Optimized Point Cloud (COPC) files.  The COPC VLR
+// hierarchy is traversed and pruned against any 'bounds'/'polygon' query
+// before any point data is fetched, and the LAZ chunks for the selected
+// octree nodes are fetched and decompressed in parallel.
+class PDAL_DLL CopcReader : public Reader, public Streamable
+{
+public:
+    CopcReader();
+    virtual ~CopcReader();
+
+    std::string getName() const override;
+
+private:
+    virtual void addArgs(ProgramArgs& args) override;
+    virtual bool pushSpatialPredicate(const Bounds& bounds) override;
+    virtual void initialize(PointTableRef table) override;
+    virtual QuickInfo inspect() override;
+    virtual void addDimensions(PointLayoutPtr layout) override;
+    virtual void ready(PointTableRef table) override;
+    virtual point_count_t read(PointViewPtr view, point_count_t count) override;
+    virtual bool processOne(PointRef& point) override;
+    virtual void done(PointTableRef table) override;
+
+    void setForwards(StringMap& headers, StringMap& query);
+    void fetchHeader();
+    void validateHeader();
+    void parseVlrs(const std::vector<char>& vlrData);
+    void loadHierarchyPage(uint64_t offset, uint64_t size);
+    BOX3D nodeBounds(const CopcNode& node) const;
+    bool hasSpatialFilter() const;
+    bool passesSpatialFilter(const BOX3D& nodeBounds) const;
+    void load(const CopcNode& node, uint64_t seq);
+    void fillLoadQueue();
+    CopcTile nextTile();
+    void checkTile(const CopcTile& tile);
+    void process(PointViewPtr dstView, const CopcTile& tile,
+        point_count_t count);
+    bool processPoint(PointRef& dst, const char *buf);
+
+    struct Args;
+    struct Private;
+
+    std::unique_ptr<Args> m_args;
+    std::unique_ptr<Private> m_p;
+};
+
+} // namespace pdal
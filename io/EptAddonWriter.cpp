@@ -131,21 +131,28 @@ void EptAddonWriter::write(const PointViewPtr view)
             addon.name() << " to " << addon.filename() << std::endl;
 
         writeOne(view, addon);
-
-        log()->get(LogLevel::Debug) << "\tWritten" << std::endl;
     }
+
+    // All node data, hierarchy and metadata writes for every addon are
+    // queued on the pool - drain it once so the small-object I/O for all
+    // addons runs concurrently with no barrier between the phases.
+    m_pool->await();
+
+    log()->get(LogLevel::Debug) << "\tWritten" << std::endl;
 }
 
 void EptAddonWriter::writeOne(const PointViewPtr view, const Addon& addon) const
 {
-    std::vector<std::vector<char>> buffers(m_hierarchy->size());
-
-    // Create an addon buffer for each node we're going to write.
+    // Create an addon buffer for each node we're going to write.  The
+    // buffers are shared with the queued I/O tasks, which outlive this
+    // function.
+    auto buffers = std::make_shared<std::vector<std::vector<char>>>(
+        m_hierarchy->size());
 
     size_t itemSize = Dimension::size(addon.type());
     for (const Overlap& overlap : *m_hierarchy)
     {
-        std::vector<char>& b = buffers[overlap.m_nodeId - 1];
+        std::vector<char>& b = (*buffers)[overlap.m_nodeId - 1];
         b.resize(overlap.m_count * itemSize);
     }
 
@@ -165,7 +172,7 @@ void EptAddonWriter::writeOne(const PointViewPtr view, const Addon& addon) const
 
         pointId = pr.getFieldAs<uint64_t>(m_pointIdDim);
 
-        auto& buffer(buffers.at(nodeId - 1));
+        auto& buffer(buffers->at(nodeId - 1));
         assert(pointId * itemSize + itemSize <= buffer.size());
         char* dst = buffer.data() + pointId * itemSize;
         pr.getField(dst, addon.externalId(), addon.type());
@@ -178,16 +185,14 @@ void EptAddonWriter::writeOne(const PointViewPtr view, const Addon& addon) const
     // Write the binary dimension data for the addon.
     for (const Overlap& overlap : *m_hierarchy)
     {
-        std::vector<char>& buffer = buffers.at(overlap.m_nodeId - 1);
         std::string filename = dataDir + overlap.m_key.toString() + ".bin";
-        m_pool->add([this, filename, &buffer]()
+        uint64_t nodeId = overlap.m_nodeId;
+        m_pool->add([this, filename, buffers, nodeId]()
         {
-            m_connector->put(filename, buffer);
+            m_connector->put(filename, (*buffers)[nodeId - 1]);
         });
     }
 
-    m_pool->await();
-
     // Write the addon hierarchy data.
     NL::json h;
     Key key;
@@ -198,9 +203,11 @@ void EptAddonWriter::writeOne(const PointViewPtr view, const Addon& addon) const
 
     writeHierarchy(hierarchyDir, h, key);
     std::string filename = hierarchyDir + key.toString() + ".json";
-    m_connector->put(filename, h.dump());
-
-    m_pool->await();
+    std::string data = h.dump();
+    m_pool->add([this, filename, data]()
+    {
+        m_connector->put(filename, data);
+    });
 
     // Write the top-level addon metadata.
     NL::json meta;
@@ -209,7 +216,11 @@ void EptAddonWriter::writeOne(const PointViewPtr view, const Addon& addon) const
     meta["version"] = "1.0.0";
     meta["dataType"] = "binary";
 
-    m_connector->put("ept-addon.json", meta.dump());
+    std::string metaData = meta.dump();
+    m_pool->add([this, metaData]()
+    {
+        m_connector->put("ept-addon.json", metaData);
+    });
 }
 
 void EptAddonWriter::writeHierarchy(const std::string& directory,
@@ -94,6 +94,7 @@ public:
     NL::json m_query;
     NL::json m_headers;
     NL::json m_ogr;
+    std::size_t m_prefetchMb = 2048;
 };
 
 struct EptReader::Private
@@ -101,10 +102,19 @@ struct EptReader::Private
 public:
     std::unique_ptr<Connector> connector;
     std::unique_ptr<EptInfo> info;
-    std::unique_ptr<ThreadPool> pool;
+    std::unique_ptr<TaskGroup> tasks;
     std::unique_ptr<TileContents> currentTile;
     std::unique_ptr<Hierarchy> hierarchy;
-    std::queue<TileContents> contents;
+    // Decoded tiles, keyed by submission sequence so they're consumed in
+    // octree-key order.
+    std::map<uint64_t, TileContents> contents;
+    // Overlaps ordered by octree key; tiles are fetched in this order.
+    std::vector<Overlap> overlapOrder;
+    size_t nextSubmit = 0;
+    uint64_t nextConsume = 0;
+    // Estimated bytes of tiles fetched but not yet consumed.
+    uint64_t queuedBytes = 0;
+    size_t bytesPerPoint = 1;
     AddonList addons;
     std::mutex mutex;
     std::condition_variable contentsCv;
@@ -135,6 +145,18 @@ void EptReader::addArgs(ProgramArgs& args)
     args.add("header", "Header fields to forward with HTTP requests", m_args->m_headers);
     args.add("query", "Query parameters to forward with HTTP requests", m_args->m_query);
     args.add("ogr", "OGR filter geometries", m_args->m_ogr);
+    args.add("prefetch_mb", "Approximate maximum megabytes of decoded tiles "
+        "buffered ahead of processing", m_args->m_prefetchMb, (size_t)2048);
+}
+
+
+bool EptReader::pushSpatialPredicate(const Bounds& bounds)
+{
+    // The pushed bounds are in the EPT's native coordinate system, the
+    // same system in which a user-supplied 'bounds' option is
+    // interpreted.  A user-supplied option wins.
+    m_options.addConditional(Option("bounds", Utils::toString(bounds)));
+    return true;
 }
 
 
@@ -169,7 +191,10 @@ void EptReader::initialize()
     if (threads > 100)
         log()->get(LogLevel::Warning) << "Using a large thread count: " <<
             threads << " threads" << std::endl;
-    m_p->pool.reset(new ThreadPool(threads));
+    // Tasks run on the process-wide shared pool; the thread count caps
+    // this stage's tasks in flight so concurrent stages don't
+    // oversubscribe the machine with competing pools.
+    m_p->tasks.reset(new TaskGroup(ThreadPool::shared(), threads));
 
     StringMap headers;
     StringMap query;
@@ -266,7 +291,7 @@ void EptReader::initialize()
     }
 
     debug << "Query bounds: " << m_p->bounds.box << "\n";
-    debug << "Threads: " << m_p->pool->size() << std::endl;
+    debug << "Threads: " << m_p->tasks->maxPending() << std::endl;
 }
 
 
@@ -427,9 +452,9 @@ void EptReader::addDimensions(PointLayoutPtr layout)
 
 // Start a thread to read an overlap.  When the data has been read,
 // stick the tile on the queue and notify the main thread.
-void EptReader::load(const Overlap& overlap)
+void EptReader::load(const Overlap& overlap, uint64_t seq)
 {
-    m_p->pool->add([this, overlap]()
+    m_p->tasks->add([this, overlap, seq]()
         {
             // Read the tile.
             TileContents tile(overlap, *m_p->info, *m_p->connector, m_p->addons);
@@ -437,7 +462,7 @@ void EptReader::load(const Overlap& overlap)
 
             // Put the tile on the output queue.
             std::unique_lock<std::mutex> l(m_p->mutex);
-            m_p->contents.push(std::move(tile));
+            m_p->contents.emplace(seq, std::move(tile));
             l.unlock();
             m_p->contentsCv.notify_one();
         }
@@ -445,6 +470,59 @@ void EptReader::load(const Overlap& overlap)
 }
 
 
+// Submit fetches, in octree-key order, until the estimated size of
+// fetched-but-unconsumed tiles reaches the prefetch budget.  At least one
+// tile beyond the next to be consumed is always in flight so the consumer
+// can make progress.
+void EptReader::fillLoadQueue()
+{
+    uint64_t budget = (uint64_t)m_args->m_prefetchMb * 1024 * 1024;
+
+    // Decide what to submit under the lock, but submit after releasing
+    // it: load() blocks at the task group's in-flight cap, and the tile
+    // tasks it would wait on need the mutex to finish.
+    std::vector<uint64_t> submit;
+    std::unique_lock<std::mutex> lock(m_p->mutex);
+    while (m_p->nextSubmit < m_p->overlapOrder.size() &&
+        (m_p->queuedBytes < budget ||
+         m_p->nextSubmit == m_p->nextConsume))
+    {
+        const Overlap& overlap = m_p->overlapOrder[m_p->nextSubmit];
+        m_p->queuedBytes += overlap.m_count * m_p->bytesPerPoint;
+        submit.push_back(m_p->nextSubmit);
+        m_p->nextSubmit++;
+    }
+    lock.unlock();
+
+    for (uint64_t seq : submit)
+        load(m_p->overlapOrder[seq], seq);
+}
+
+
+// Block until the next tile in key order has been decoded and hand it to
+// the caller, then top off the fetch queue.
+TileContents EptReader::nextTile()
+{
+    std::unique_lock<std::mutex> l(m_p->mutex);
+    m_p->contentsCv.wait(l, [this]()
+    {
+        auto it = m_p->contents.begin();
+        return it != m_p->contents.end() && it->first == m_p->nextConsume;
+    });
+
+    auto it = m_p->contents.begin();
+    TileContents tile = std::move(it->second);
+    m_p->contents.erase(it);
+    uint64_t bytes = tile.size() * m_p->bytesPerPoint;
+    m_p->queuedBytes -= (std::min)(m_p->queuedBytes, bytes);
+    m_p->nextConsume++;
+    l.unlock();
+
+    fillLoadQueue();
+    return tile;
+}
+
+
 void EptReader::ready(PointTableRef table)
 {
     // These may not exist, in general they are only needed to track point
@@ -477,13 +555,21 @@ void EptReader::ready(PointTableRef table)
     m_pointId = 0;
     m_tileCount = m_p->hierarchy->size();
 
-    // If we're running in standard mode, queue up all the requests for data.
-    // In streaming mode, queue up at most 4 to avoid having a ton of data
-    // show up at once. Others requests will be queued as the results
-    // are handled.
-    m_p->pool.reset(new ThreadPool(m_p->pool->numThreads()));
-    for (const Overlap& overlap : *m_p->hierarchy)
-        load(overlap);
+    // Queue up requests for data in octree-key order, limited by the
+    // prefetch budget.  Further requests are submitted as tiles are
+    // consumed.
+    m_p->tasks->cancel();
+    m_p->overlapOrder.assign(m_p->hierarchy->begin(), m_p->hierarchy->end());
+    std::sort(m_p->overlapOrder.begin(), m_p->overlapOrder.end(),
+        [](const Overlap& a, const Overlap& b)
+        { return a.m_key < b.m_key; });
+    m_p->nextSubmit = 0;
+    m_p->nextConsume = 0;
+    m_p->queuedBytes = 0;
+    m_p->bytesPerPoint =
+        (std::max)((size_t)table.layout()->pointSize(), (size_t)1);
+    m_p->contents.clear();
+    fillLoadQueue();
     if (table.supportsView())
         m_artifactMgr = &table.artifactManager();
 }
@@ -507,7 +593,7 @@ void EptReader::overlaps()
         // First, determine the overlapping nodes from the EPT resource.
         overlaps(*m_p->hierarchy, m_p->connector->getJson(filename), key);
     }
-    m_p->pool->await();
+    m_p->tasks->await();
 
     // Determine the addons that exist to correspond to tiles.
     for (auto& addon : m_p->addons)
@@ -515,7 +601,7 @@ void EptReader::overlaps()
         m_nodeId = 1;
         std::string filename = addon.hierarchyDir() + key.toString() + ".json";
         overlaps(addon.hierarchy(), m_p->connector->getJson(filename), key);
-        m_p->pool->await();
+        m_p->tasks->await();
     }
 }
 
@@ -613,7 +699,9 @@ void EptReader::overlaps(Hierarchy& target, const NL::json& hier, const Key& key
 
         // If the hierarchy points value here is -1, then we need to fetch the
         // hierarchy subtree corresponding to this root.
-        m_p->pool->add([this, &target, key]()
+        // Hierarchy fetches gate the query, so they jump ahead of any
+        // queued tile loads.
+        m_p->tasks->add([this, &target, key]()
         {
             try
             {
@@ -625,7 +713,7 @@ void EptReader::overlaps(Hierarchy& target, const NL::json& hier, const Key& key
             {
                 throwError(err.what());
             }
-        });
+        }, ThreadPool::Priority::High);
     }
     else if (numPoints < 0)
     {
@@ -650,7 +738,7 @@ void EptReader::checkTile(const TileContents& tile)
 {
     if (tile.error().size())
     {
-        m_p->pool->stop();
+        m_p->tasks->cancel();
         throwError("Error reading tile: " + tile.error());
     }
 }
@@ -749,29 +837,21 @@ point_count_t EptReader::read(PointViewPtr view, point_count_t count)
 
     if (m_p->hierarchy->size())
     {
-        // Pop tiles until there are no more, or wait for them to appear.
+        // Pop tiles in key order, waiting for them to appear as needed.
         // Exit when we've handled all the tiles or we've read enough points.
         do
         {
-            std::unique_lock<std::mutex> l(m_p->mutex);
-            if (m_p->contents.size())
-            {
-                TileContents tile = std::move(m_p->contents.front());
-                m_p->contents.pop();
-                l.unlock();
-                checkTile(tile);
-                process(view, tile, count - numRead);
-                numRead += tile.size();
-                m_tileCount--;
-            }
-            else
-                m_p->contentsCv.wait(l);
+            TileContents tile = nextTile();
+            checkTile(tile);
+            process(view, tile, count - numRead);
+            numRead += tile.size();
+            m_tileCount--;
         } while (m_tileCount && numRead <= count);
     }
 
     // Wait for any running threads to finish and don't start any others.
     // Only relevant if we hit the count limit before reading all the tiles.
-    m_p->pool->stop();
+    m_p->tasks->cancel();
 
     // If we're using the addon writer, transfer the info and hierarchy
     // to that stage.
@@ -803,6 +883,17 @@ void EptReader::process(PointViewPtr dstView, const TileContents& tile,
 }
 
 
+void EptReader::done(PointTableRef)
+{
+    // If streaming terminated before all tiles were consumed -- a
+    // saturated downstream stage, for instance -- abandon the fetch
+    // queue.  Fetches already running finish; queued ones never start.
+    m_p->tasks->cancel();
+    m_p->currentTile.reset();
+    m_p->contents.clear();
+}
+
+
 bool EptReader::processOne(PointRef& point)
 {
 top:
@@ -813,18 +904,7 @@ top:
     // another if there are more.  If none are available, wait.
     if (!m_p->currentTile)
     {
-        do
-        {
-            std::unique_lock<std::mutex> l(m_p->mutex);
-            if (m_p->contents.size())
-            {
-                m_p->currentTile.reset(new TileContents(std::move(m_p->contents.front())));
-                m_p->contents.pop();
-                break;
-            }
-            else
-                m_p->contentsCv.wait(l);
-        } while (true);
+        m_p->currentTile.reset(new TileContents(nextTile()));
         checkTile(*m_p->currentTile);
     }
 
@@ -67,12 +67,14 @@ public:
 
 private:
     virtual void addArgs(ProgramArgs& args) override;
+    virtual bool pushSpatialPredicate(const Bounds& bounds) override;
     virtual void initialize() override;
     virtual QuickInfo inspect() override;
     virtual void addDimensions(PointLayoutPtr layout) override;
     virtual void ready(PointTableRef table) override;
     virtual point_count_t read(PointViewPtr view, point_count_t count) override;
     virtual bool processOne(PointRef& point) override;
+    virtual void done(PointTableRef table) override;
 
     // If argument "origin" is specified, this function will clip the query
     // bounds to the bounds of the specified origin and set m_queryOriginId to
@@ -89,7 +91,9 @@ private:
     bool passesSpatialFilter(const BOX3D& tileBounds) const;
     void process(PointViewPtr dstView, const TileContents& tile, point_count_t count);
     bool processPoint(PointRef& dst, const TileContents& tile);
-    void load(const Overlap& overlap);
+    void load(const Overlap& overlap, uint64_t seq);
+    void fillLoadQueue();
+    TileContents nextTile();
     void checkTile(const TileContents& tile);
 
     struct Args;
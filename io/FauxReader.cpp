@@ -38,11 +38,47 @@
 #include <pdal/PointView.hpp>
 #include <pdal/util/ProgramArgs.hpp>
 
+#include <cmath>
 #include <ctime>
 
 namespace pdal
 {
 
+namespace
+{
+
+// SplitMix64 mix function.  Hashing the point index rather than drawing
+// from a stateful distribution keeps per-point cost to a few integer ops
+// and makes generation independent of point order.
+uint64_t mix64(uint64_t x)
+{
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// Deterministic value in [0, 1) for dimension 'dim' of point 'idx'.
+double unitRand(uint64_t idx, uint64_t seed, uint64_t dim)
+{
+    return (mix64(seed ^ (idx * 3 + dim)) >> 11) *
+        (1.0 / 9007199254740992.0);   // 2^-53
+}
+
+// Gather the even bits of a Morton code into the low bits.
+uint32_t compactBits(uint64_t v)
+{
+    v &= 0x5555555555555555ULL;
+    v = (v | (v >> 1)) & 0x3333333333333333ULL;
+    v = (v | (v >> 2)) & 0x0F0F0F0F0F0F0F0FULL;
+    v = (v | (v >> 4)) & 0x00FF00FF00FF00FFULL;
+    v = (v | (v >> 8)) & 0x0000FFFF0000FFFFULL;
+    v = (v | (v >> 16)) & 0x00000000FFFFFFFFULL;
+    return (uint32_t)v;
+}
+
+} // unnamed namespace
+
 static StaticPluginInfo const s_info
 {
     "readers.faux",
@@ -76,7 +112,8 @@ void FauxReader::prepared(PointTableRef table)
     if (m_numReturns > 10)
         throwError("Option 'number_of_returns' must be in the range [0,10].");
 
-    if (!(m_mode == Mode::Normal || m_mode == Mode::Uniform))
+    if (!(m_mode == Mode::Normal || m_mode == Mode::Uniform ||
+          m_mode == Mode::Morton || m_mode == Mode::Flightline))
     {
         if (m_seedArg->set())
         {
@@ -148,6 +185,29 @@ void FauxReader::initialize()
         m_uniformY.reset(new urd(m_bounds.miny, m_bounds.maxy));
         m_uniformZ.reset(new urd(m_bounds.minz, m_bounds.maxz));
     }
+    else if (m_mode == Mode::Morton)
+    {
+        // Unseeded output is deterministic so that benchmark runs are
+        // repeatable.
+        m_hashSeed = m_seedArg->set() ? m_seed : 0;
+        // Size the Morton grid so the curve covers the bounds for the
+        // requested count.
+        m_mortonBits = 1;
+        while ((1ULL << (2 * m_mortonBits)) < m_count && m_mortonBits < 31)
+            m_mortonBits++;
+    }
+    else if (m_mode == Mode::Flightline)
+    {
+        m_hashSeed = m_seedArg->set() ? m_seed : 0;
+        // Strips run along X; make each line about 100 times longer than
+        // the number of lines, as in a typical acquisition.
+        point_count_t lines = (std::max)((point_count_t)1,
+            (point_count_t)std::round(std::sqrt((double)m_count / 100.0)));
+        m_pointsPerLine = (m_count + lines - 1) / lines;
+        m_lineSpacing = (m_bounds.maxy - m_bounds.miny) / lines;
+        // Slightly wider than the line spacing so adjacent strips overlap.
+        m_swath = 1.2 * m_lineSpacing;
+    }
     else
     {
         if (m_count > 1)
@@ -246,6 +306,46 @@ bool FauxReader::processOne(PointRef& point)
         }
         break;
     }
+    case Mode::Morton:
+    {
+        // De-interleave the index to get the cell on the Z-order curve,
+        // then jitter within the cell so points don't sit on a lattice.
+        double side = (double)(1ULL << m_mortonBits);
+        uint32_t xi = compactBits(m_index);
+        uint32_t yi = compactBits(m_index >> 1);
+        x = m_bounds.minx + (m_bounds.maxx - m_bounds.minx) *
+            ((xi + unitRand(m_index, m_hashSeed, 0)) / side);
+        y = m_bounds.miny + (m_bounds.maxy - m_bounds.miny) *
+            ((yi + unitRand(m_index, m_hashSeed, 1)) / side);
+        z = m_bounds.minz + (m_bounds.maxz - m_bounds.minz) *
+            unitRand(m_index, m_hashSeed, 2);
+        break;
+    }
+    case Mode::Flightline:
+    {
+        const point_count_t ScanPeriod = 128;
+
+        point_count_t line = m_index / m_pointsPerLine;
+        point_count_t pos = m_index % m_pointsPerLine;
+
+        double t = m_pointsPerLine > 1 ?
+            (double)pos / (m_pointsPerLine - 1) : 0.0;
+        // Alternate direction on successive lines.
+        if (line % 2)
+            t = 1.0 - t;
+        x = m_bounds.minx + (m_bounds.maxx - m_bounds.minx) * t;
+
+        // Triangular cross-track sweep about the line's center.  The
+        // swath is wider than the line spacing, so edge lines can push
+        // slightly past the Y bounds, as overlapping strips do.
+        double phase = (double)(pos % ScanPeriod) / ScanPeriod;
+        double sweep = std::abs(2.0 * phase - 1.0) - 0.5;
+        y = m_bounds.miny + (line + 0.5) * m_lineSpacing + sweep * m_swath;
+
+        z = m_bounds.minz + (m_bounds.maxz - m_bounds.minz) *
+            unitRand(m_index, m_hashSeed, 2);
+        break;
+    }
     }
 
     point.setField(Dimension::Id::X, x);
@@ -261,6 +361,22 @@ bool FauxReader::processOne(PointRef& point)
     m_index++;
     return true;
 }
+
+
+point_count_t FauxReader::streamSkip(point_count_t count)
+{
+    // Normal and uniform points come from a stateful generator and can't
+    // be skipped without disturbing the points that follow.
+    if (m_mode == Mode::Normal || m_mode == Mode::Uniform)
+        return 0;
+
+    count = (std::min)(count, m_count - m_index);
+    m_index += count;
+    m_time += count;
+    if (m_numReturns > 0)
+        m_returnNum = (int)(m_index % m_numReturns) + 1;
+    return count;
+}
 #pragma warning (pop)
 
 
@@ -48,7 +48,9 @@ enum class Mode
     Ramp,
     Uniform,
     Normal,
-    Grid
+    Grid,
+    Morton,
+    Flightline
 };
 
 inline std::istream& operator>>(std::istream& in, Mode& m)
@@ -67,6 +69,10 @@ inline std::istream& operator>>(std::istream& in, Mode& m)
         m = Mode::Normal;
     else if (s == "grid")
         m = Mode::Grid;
+    else if (s == "morton")
+        m = Mode::Morton;
+    else if (s == "flightline")
+        m = Mode::Flightline;
     else
         in.setstate(std::ios::failbit);
     return in;
@@ -86,6 +92,10 @@ inline std::ostream& operator<<(std::ostream& out, const Mode& m)
         out << "Normal";
     case Mode::Grid:
         out << "Grid";
+    case Mode::Morton:
+        out << "Morton";
+    case Mode::Flightline:
+        out << "Flightline";
     }
     return out;
 }
@@ -111,6 +121,12 @@ inline std::ostream& operator<<(std::ostream& out, const Mode& m)
 //     given bounding box
 //   - "normal" generates points that are normally distributed with a given
 //     mean and standard deviation in each of the XYZ dimensions
+//   - "morton" generates deterministic points that follow a Z-order
+//     (Morton) curve through the bounding box, so that consecutive points
+//     are spatially clustered
+//   - "flightline" generates deterministic points resembling an airborne
+//     acquisition: parallel overlapping strips with a zigzag cross-track
+//     scan
 // In all these modes, however, the Time field is always set to the point
 // number.
 //
@@ -147,6 +163,11 @@ private:
     point_count_t m_index;
     Arg *m_seedArg;
     uint32_t m_seed;
+    uint64_t m_hashSeed;
+    int m_mortonBits;
+    point_count_t m_pointsPerLine;
+    double m_lineSpacing;
+    double m_swath;
     std::mt19937 m_generator;
     std::unique_ptr<nd> m_normalX;
     std::unique_ptr<nd> m_normalY;
@@ -161,6 +182,7 @@ private:
     virtual void addDimensions(PointLayoutPtr layout);
     virtual void ready(PointTableRef table);
     virtual bool processOne(PointRef& point);
+    virtual point_count_t streamSkip(point_count_t count);
     virtual point_count_t read(PointViewPtr view, point_count_t count);
     virtual bool eof()
         { return false; }
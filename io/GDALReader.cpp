@@ -37,6 +37,7 @@
 #include <sstream>
 
 #include <pdal/PointView.hpp>
+#include <pdal/private/gdal/DatasetPool.hpp>
 #include <pdal/private/gdal/Raster.hpp>
 
 namespace pdal
@@ -72,7 +73,8 @@ GDALReader::~GDALReader()
 
 void GDALReader::initialize()
 {
-    m_raster.reset(new gdal::Raster(m_filename));
+    m_raster.reset();
+    m_raster = gdal::DatasetPool::instance().raster(m_filename);
     if (m_raster->open() == gdal::GDALError::CantOpen)
         throwError("Couldn't open raster file '" + m_filename + "'.");
 
@@ -148,12 +150,15 @@ void GDALReader::addArgs(ProgramArgs& args)
         "raster bands to dimension id", m_header);
     args.add("memorycopy", "Load the given raster file "
         "entirely to memory", m_useMemoryCopy, false).setHidden();
+    args.add("bounds", "Only emit points for cells whose position falls "
+        "within this 2D bounds", m_emitBounds);
 }
 
 
 void GDALReader::ready(PointTableRef table)
 {
-    m_raster.reset(new gdal::Raster(m_filename));
+    m_raster.reset();
+    m_raster = gdal::DatasetPool::instance().raster(m_filename);
     if (m_raster->open() == gdal::GDALError::CantOpen)
         throwError("Couldn't open raster file '" + m_filename + "'.");
 
@@ -170,6 +175,17 @@ void GDALReader::ready(PointTableRef table)
     m_index = 0;
     m_row = 0;
     m_col = 0;
+
+    // Read whole rows in windows of about a million cells - one GDAL call
+    // per band per window instead of one per band per cell.
+    m_windowRows = (int)Utils::clamp((1 << 20) / (std::max)(m_width, 1),
+        1, m_height);
+    m_windowStart = 0;
+    m_windowEnd = 0;
+
+    m_clip = m_emitBounds.valid();
+    if (m_clip)
+        m_emitBox = m_emitBounds.to2d();
 }
 
 
@@ -193,39 +209,55 @@ point_count_t GDALReader::read(PointViewPtr view, point_count_t numPts)
 bool GDALReader::processOne(PointRef& point)
 {
     std::array<double, 2> coords;
-    if (m_row == m_height)
-        return false; // done
+    size_t numBands = m_bandIds.size();
 
-    m_raster->pixelToCoord(m_col, m_row, coords);
-    double x = coords[0];
-    double y = coords[1];
-    point.setField(Dimension::Id::X, x);
-    point.setField(Dimension::Id::Y, y);
+    while (m_row < m_height)
+    {
+        if (m_row >= m_windowEnd && !fillWindow())
+            return false;
 
-    std::vector<double> data;
-    if (m_raster->read(x, y, data) != gdal::GDALError::None)
-        return false;
+        m_raster->pixelToCoord(m_col, m_row, coords);
+        double x = coords[0];
+        double y = coords[1];
+        size_t pos =
+            ((size_t)(m_row - m_windowStart) * m_width + m_col) * numBands;
 
-    for (int b = 0; b < m_raster->bandCount(); ++b)
-    {
-        Dimension::Id id = m_bandIds[b];
-        double v = data[b];
-        point.setField(id, v);
-    }
-    m_col++;
-    if (m_col == m_width)
-    {
-        m_col = 0;
-        m_row++;
+        m_col++;
+        if (m_col == m_width)
+        {
+            m_col = 0;
+            m_row++;
+        }
+
+        if (m_clip && !m_emitBox.contains(x, y))
+            continue;
+
+        point.setField(Dimension::Id::X, x);
+        point.setField(Dimension::Id::Y, y);
+        for (size_t b = 0; b < numBands; ++b)
+            point.setField(m_bandIds[b], m_windowBuf[pos + b]);
+        return true;
     }
+    return false; // done
+}
 
+
+bool GDALReader::fillWindow()
+{
+    m_windowStart = m_row;
+    int rows = (std::min)(m_windowRows, m_height - m_windowStart);
+    if (m_raster->readWindow(0, m_windowStart, m_width, rows, m_windowBuf) !=
+            gdal::GDALError::None)
+        return false;
+    m_windowEnd = m_windowStart + rows;
     return true;
 }
 
 
 void GDALReader::done(PointTableRef table)
 {
-    m_raster->close();
+    // Back to the pool open; a non-pooled memory copy just closes.
+    m_raster.reset();
 }
 
 } // namespace pdal
@@ -41,6 +41,7 @@
 #include <pdal/Reader.hpp>
 #include <pdal/StageFactory.hpp>
 #include <pdal/Streamable.hpp>
+#include <pdal/util/Bounds.hpp>
 
 namespace pdal
 {
@@ -66,8 +67,9 @@ private:
     virtual bool processOne(PointRef& point);
     virtual QuickInfo inspect();
     virtual void addArgs(ProgramArgs& args);
+    bool fillWindow();
 
-    std::unique_ptr<gdal::Raster> m_raster;
+    std::shared_ptr<gdal::Raster> m_raster;
     std::vector<Dimension::Type> m_bandTypes;
     std::vector<Dimension::Id> m_bandIds;
     std::string m_header;
@@ -78,6 +80,16 @@ private:
     int m_row;
     int m_col;
 
+    /// Band-interleaved buffer holding a window of whole raster rows.
+    std::vector<double> m_windowBuf;
+    int m_windowRows;   /// Rows read per window.
+    int m_windowStart;  /// First row held in the window buffer.
+    int m_windowEnd;    /// First row past the window buffer.
+
+    Bounds m_emitBounds;
+    BOX2D m_emitBox;
+    bool m_clip;
+
     BOX3D m_bounds;
     StringList m_dimNames;
 };
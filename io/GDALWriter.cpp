@@ -33,10 +33,12 @@
 
 #include "GDALWriter.hpp"
 
+#include <cmath>
 #include <sstream>
 
 #include <pdal/PointView.hpp>
 #include <pdal/private/gdal/Raster.hpp>
+#include <pdal/util/FileUtils.hpp>
 
 #include "private/GDALGrid.hpp"
 
@@ -95,6 +97,15 @@ void GDALWriter::addArgs(ProgramArgs& args)
 
     args.add("default_srs", "Spatial reference to apply to data if one cannot be inferred",
         m_defaultSrs);
+
+    args.add("tile_size", "Number of cells along each edge of an output "
+        "tile.  When set, output is written as one raster per tile instead "
+        "of a single raster, keeping only recently touched tiles in memory.",
+        m_tileSize);
+    args.add("max_active_tiles", "Maximum number of tile grids kept in "
+        "memory when 'tile_size' is set.  The least recently touched tile "
+        "is written and discarded when the limit is exceeded.",
+        m_maxActiveTiles, (size_t)16);
 }
 
 
@@ -161,6 +172,21 @@ void GDALWriter::initialize()
     // don't expand by point if we're running in standard mode.  That's
     // set later in writeView.
     m_expandByPoint = !m_fixedGrid;
+
+    if (m_tileSize)
+    {
+        if (m_fixedGrid)
+            throwError("Can't specify 'bounds' or 'origin_x'/'origin_y'/"
+                "'width'/'height' with 'tile_size'.");
+        if (m_radius >= m_tileSize * m_edgeLength)
+            throwError("'radius' must be less than the tile edge length "
+                "('tile_size' * 'resolution').");
+        if (m_maxActiveTiles < 4)
+            throwError("'max_active_tiles' must be at least 4.");
+        // Tiles have fixed extents -- each tile ignores cells outside
+        // its own bounds.
+        m_expandByPoint = false;
+    }
 }
 
 
@@ -183,6 +209,10 @@ void GDALWriter::readyFile(const std::string& filename,
     if (m_srs.empty())
         m_srs = m_defaultSrs;
     m_grid.reset();
+    m_tiles.clear();
+    m_flushedTiles.clear();
+    m_tileOriginSet = false;
+    m_tileClock = 0;
     if (m_fixedGrid)
         createGrid(m_bounds.to2d());
 }
@@ -230,7 +260,7 @@ void GDALWriter::writeView(const PointViewPtr view)
     // When we're running in standard mode, it's better to get the bounds and
     // expand once, rather than have to do this for every point, since an
     // expansion causes data to move.
-    if (!m_fixedGrid)
+    if (!m_fixedGrid && !m_tileSize)
     {
         BOX2D bounds;
         view->calculateBounds(bounds);
@@ -258,6 +288,12 @@ bool GDALWriter::processOne(PointRef& point)
     double y = point.getFieldAs<double>(Dimension::Id::Y);
     double z = point.getFieldAs<double>(m_interpDim);
 
+    if (m_tileSize)
+    {
+        addToTiles(x, y, z);
+        return true;
+    }
+
     if (m_expandByPoint)
     {
         if (!m_grid)
@@ -271,26 +307,133 @@ bool GDALWriter::processOne(PointRef& point)
 }
 
 
+void GDALWriter::addToTiles(double x, double y, double z)
+{
+    // Tiles are aligned to the position of the first point unless an
+    // origin was provided.
+    if (!m_tileOriginSet)
+    {
+        m_tileXOrigin = x;
+        m_tileYOrigin = y;
+        m_tileOriginSet = true;
+    }
+
+    // A point can influence cells within 'radius' of its position, so add
+    // it to each tile whose extent is within that distance.  A grid ignores
+    // points that can't contribute to its own cells.
+    double tileLength = m_tileSize * m_edgeLength;
+    long txStart = (long)std::floor((x - m_radius - m_tileXOrigin) /
+        tileLength);
+    long txEnd = (long)std::floor((x + m_radius - m_tileXOrigin) /
+        tileLength);
+    long tyStart = (long)std::floor((y - m_radius - m_tileYOrigin) /
+        tileLength);
+    long tyEnd = (long)std::floor((y + m_radius - m_tileYOrigin) /
+        tileLength);
+    for (long tx = txStart; tx <= txEnd; ++tx)
+        for (long ty = tyStart; ty <= tyEnd; ++ty)
+        {
+            TileKey key(tx, ty);
+            if (m_flushedTiles.count(key))
+            {
+                std::ostringstream oss;
+                oss << "Point at (" << x << ", " << y << ") maps to a tile "
+                    "that has already been written.  Increase "
+                    "'max_active_tiles' or provide input with better "
+                    "spatial ordering.";
+                throwError(oss.str());
+            }
+            Tile& tile = m_tiles[key];
+            if (!tile.grid)
+            {
+                try
+                {
+                    tile.grid.reset(new GDALGrid(
+                        m_tileXOrigin + tx * tileLength,
+                        m_tileYOrigin + ty * tileLength,
+                        m_tileSize, m_tileSize, m_edgeLength, m_radius,
+                        m_outputTypes, m_windowSize, m_power));
+                }
+                catch (GDALGrid::error& err)
+                {
+                    throwError(err.what());
+                }
+            }
+            tile.grid->addPoint(x, y, z);
+            tile.lastUse = ++m_tileClock;
+        }
+
+    // Write out least recently touched tiles until we're under the limit.
+    while (m_tiles.size() > m_maxActiveTiles)
+    {
+        auto oldest = m_tiles.begin();
+        for (auto ti = m_tiles.begin(); ti != m_tiles.end(); ++ti)
+            if (ti->second.lastUse < oldest->second.lastUse)
+                oldest = ti;
+        flushTile(oldest);
+    }
+}
+
+
+void GDALWriter::flushTile(TileMap::iterator ti)
+{
+    std::string filename = tileFilename(ti->first);
+    writeFile(filename, *ti->second.grid);
+    getMetadata().addList("filename", filename);
+    m_flushedTiles.insert(ti->first);
+    m_tiles.erase(ti);
+}
+
+
+std::string GDALWriter::tileFilename(const TileKey& key) const
+{
+    std::string ext = FileUtils::extension(m_outputFilename);
+    std::string base =
+        m_outputFilename.substr(0, m_outputFilename.size() - ext.size());
+
+    std::ostringstream oss;
+    oss << base << "_" << key.first << "_" << key.second << ext;
+    return oss.str();
+}
+
+
 void GDALWriter::doneFile()
 {
+    if (m_tileSize)
+    {
+        if (m_tiles.empty() && m_flushedTiles.empty())
+            throw pdal_error("Unable to write GDAL data with no points "
+                "for output.");
+        while (m_tiles.size())
+            flushTile(m_tiles.begin());
+        return;
+    }
+
     if (!m_grid)
         throw pdal_error("Unable to write GDAL data with no points "
             "for output.");
 
+    writeFile(m_outputFilename, *m_grid);
+    getMetadata().addList("filename", m_filename);
+}
+
+
+void GDALWriter::writeFile(const std::string& filename, GDALGrid& grid)
+{
     std::array<double, 6> pixelToPos;
 
-    pixelToPos[0] = m_grid->xOrigin();
+    pixelToPos[0] = grid.xOrigin();
     pixelToPos[1] = m_edgeLength;
     pixelToPos[2] = 0;
-    pixelToPos[3] = m_grid->yOrigin() + (m_edgeLength * m_grid->height());
+    pixelToPos[3] = grid.yOrigin() + (m_edgeLength * grid.height());
     pixelToPos[4] = 0;
     pixelToPos[5] = -m_edgeLength;
-    gdal::Raster raster(m_outputFilename, m_drivername, m_srs, pixelToPos);
+    gdal::Raster raster(filename, m_drivername, m_srs, pixelToPos);
 
-    m_grid->finalize();
+    grid.finalize();
 
-    gdal::GDALError err = raster.open(m_grid->width(), m_grid->height(),
-        m_grid->numBands(), m_dataType, m_noData, m_options);
+    gdal::GDALError err = raster.open(grid.width(), grid.height(),
+        grid.numBands(), m_dataType, m_noData, m_options);
 
     if (err != gdal::GDALError::None)
         throwError(raster.errorMsg());
@@ -298,29 +441,27 @@ void GDALWriter::doneFile()
 
     // Perhaps the grid should return an iterator, which would work as well.
     double *src;
-    src = m_grid->data("min");
+    src = grid.data("min");
     double srcNoData = std::numeric_limits<double>::quiet_NaN();
     if (src && err == gdal::GDALError::None)
         err = raster.writeBand(src, srcNoData, bandNum++, "min");
-    src = m_grid->data("max");
+    src = grid.data("max");
     if (src && err == gdal::GDALError::None)
         err = raster.writeBand(src, srcNoData, bandNum++, "max");
-    src = m_grid->data("mean");
+    src = grid.data("mean");
     if (src && err == gdal::GDALError::None)
         err = raster.writeBand(src, srcNoData, bandNum++, "mean");
-    src = m_grid->data("idw");
+    src = grid.data("idw");
     if (src && err == gdal::GDALError::None)
         err = raster.writeBand(src, srcNoData, bandNum++, "idw");
-    src = m_grid->data("count");
+    src = grid.data("count");
     if (src && err == gdal::GDALError::None)
         err = raster.writeBand(src, srcNoData, bandNum++, "count");
-    src = m_grid->data("stdev");
+    src = grid.data("stdev");
     if (src && err == gdal::GDALError::None)
         err = raster.writeBand(src, srcNoData, bandNum++, "stdev");
     if (err != gdal::GDALError::None)
         throwError(raster.errorMsg());
-
-    getMetadata().addList("filename", m_filename);
 }
 
 } // namespace pdal
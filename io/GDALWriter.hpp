@@ -33,6 +33,9 @@
 ****************************************************************************/
 
 #include <algorithm>
+#include <cstdint>
+#include <map>
+#include <set>
 
 #include <pdal/FlexWriter.hpp>
 #include <pdal/PointView.hpp>
@@ -57,6 +60,14 @@ class PDAL_DLL GDALWriter : public FlexWriter, public Streamable
         double x;
         double y;
     };
+    // Index of a tile in the tiled output mode.
+    typedef std::pair<long, long> TileKey;
+    struct Tile
+    {
+        std::unique_ptr<GDALGrid> grid;
+        uint64_t lastUse;
+    };
+    typedef std::map<TileKey, Tile> TileMap;
 
 public:
     std::string getName() const;
@@ -77,6 +88,14 @@ private:
     void expandGrid(BOX2D bounds);
     int width() const;
     int height() const;
+    // Write a completed grid as a raster file.
+    void writeFile(const std::string& filename, GDALGrid& grid);
+    // Add a point to the tiles it can influence, creating tiles as
+    // necessary and flushing tiles beyond the active limit.
+    void addToTiles(double x, double y, double z);
+    // Finalize a tile, write its raster and discard its grid.
+    void flushTile(TileMap::iterator ti);
+    std::string tileFilename(const TileKey& key) const;
 
     std::string m_outputFilename;
     std::string m_drivername;
@@ -105,6 +124,14 @@ private:
     Dimension::Type m_dataType;
     bool m_expandByPoint;
     bool m_fixedGrid;
+    size_t m_tileSize;
+    size_t m_maxActiveTiles;
+    double m_tileXOrigin;
+    double m_tileYOrigin;
+    bool m_tileOriginSet;
+    uint64_t m_tileClock;
+    TileMap m_tiles;
+    std::set<TileKey> m_flushedTiles;
     SpatialReference m_defaultSrs;
     SpatialReference m_overrideSrs;
 };
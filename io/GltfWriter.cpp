@@ -34,6 +34,7 @@
 
 #include "GltfWriter.hpp"
 
+#include <cmath>
 #include <iostream>
 #include <nlohmann/json.hpp>
 #include <pdal/PointView.hpp>
@@ -48,6 +49,28 @@ namespace
 const size_t HeaderSize = 12;
 const size_t JsonChunkDataSize = 5000;
 const size_t ChunkHeaderSize = 8;
+
+// Quantize a position into 16 bits over the view's extent.
+uint16_t quantizePosition(double val, double minimum, double extent)
+{
+    if (extent <= 0)
+        return 0;
+    double q = std::round((val - minimum) / extent * 65535.0);
+    return (uint16_t)Utils::clamp(q, 0.0, 65535.0);
+}
+
+// Quantize a unit-range value ([-1, 1]) into a normalized signed 16-bit
+// value.
+int16_t quantizeNormal(double val)
+{
+    return (int16_t)std::round(Utils::clamp(val, -1.0, 1.0) * 32767.0);
+}
+
+// Quantize a [0, 1] value into a normalized unsigned 16-bit value.
+uint16_t quantizeColor(double val)
+{
+    return (uint16_t)std::round(Utils::clamp(val, 0.0, 1.0) * 65535.0);
+}
 }
 
 static StaticPluginInfo const s_info
@@ -85,6 +108,9 @@ void GltfWriter::addArgs(ProgramArgs& args)
              "it to the output vertices. Note that most renderers will "
              "interpolate the color of each vertex across a face, so this may "
              "look odd.", m_colorVertices, false);
+    args.add("quantize", "Write vertex attributes as 16-bit values using the "
+             "KHR_mesh_quantization extension instead of 32-bit floats, "
+             "roughly halving the payload.", m_quantize, false);
 }
 
 
@@ -140,25 +166,36 @@ void GltfWriter::write(const PointViewPtr v)
 
     OLeStream& out = *m_stream;
 
+    // Quantized attributes are three 16-bit values padded to 8 bytes to
+    // keep accessors 4-byte aligned.
+    const size_t attrSize =
+        m_quantize ? 4 * sizeof(uint16_t) : 3 * sizeof(float);
+
     ViewData vd;
     vd.m_indexCount = mesh->size() * 3;
     vd.m_vertexCount = v->size();
     vd.m_indexOffset = m_binSize;
     vd.m_indexByteLength = vd.m_indexCount * sizeof(uint32_t);
     vd.m_vertexOffset = vd.m_indexOffset + vd.m_indexByteLength;
-    vd.m_vertexByteLength = v->size() * sizeof(float) * 3;  // 3 for X,Y,Z
-
+    vd.m_vertexByteLength = v->size() * attrSize;   // X,Y,Z
 
     if (m_writeNormals) {
         // Add the length of 3 normals to the vertex byte length
-        vd.m_vertexByteLength += v->size() * sizeof(float) * 3; // 3 for X,Y,Z
+        vd.m_vertexByteLength += v->size() * attrSize; // 3 for X,Y,Z
     }
 
     if (m_colorVertices) {
         // Add the length of 3 colors to the vertex byte length
-        vd.m_vertexByteLength += v->size() * sizeof(float) * 3; // 3 for R,G,B
+        vd.m_vertexByteLength += v->size() * attrSize; // 3 for R,G,B
     }
 
+    // Quantization needs the view's extent before any position is written.
+    if (m_quantize)
+        for (PointId i = 0; i < v->size(); ++i)
+            vd.m_bounds.grow(v->getFieldAs<float>(Dimension::Id::X, i),
+                v->getFieldAs<float>(Dimension::Id::Y, i),
+                v->getFieldAs<float>(Dimension::Id::Z, i));
+
     m_binSize += vd.m_indexByteLength + vd.m_vertexByteLength;
     m_totalSize = static_cast<size_t>(out.position()) + m_binSize;
     if (m_totalSize > (std::numeric_limits<uint32_t>::max)())
@@ -167,6 +204,7 @@ void GltfWriter::write(const PointViewPtr v)
     for (const Triangle& t : *mesh)
         out << (uint32_t)t.m_a << (uint32_t)t.m_b << (uint32_t)t.m_c;
 
+    const BOX3D& b = vd.m_bounds;
     for (PointId i = 0; i < v->size(); ++i)
     {
         float x = v->getFieldAs<float>(Dimension::Id::X, i);
@@ -174,14 +212,24 @@ void GltfWriter::write(const PointViewPtr v)
         float z = v->getFieldAs<float>(Dimension::Id::Z, i);
 
         vd.m_bounds.grow(x, y, z);
-        out << x << y << z;
+        if (m_quantize)
+            out << quantizePosition(x, b.minx, b.maxx - b.minx)
+                << quantizePosition(y, b.miny, b.maxy - b.miny)
+                << quantizePosition(z, b.minz, b.maxz - b.minz)
+                << (uint16_t)0;
+        else
+            out << x << y << z;
 
         if (m_writeNormals) {
             float normalX = v->getFieldAs<float>(Dimension::Id::NormalX, i);
             float normalY = v->getFieldAs<float>(Dimension::Id::NormalY, i);
             float normalZ = v->getFieldAs<float>(Dimension::Id::NormalZ, i);
 
-            out << normalX << normalY << normalZ;
+            if (m_quantize)
+                out << quantizeNormal(normalX) << quantizeNormal(normalY)
+                    << quantizeNormal(normalZ) << (int16_t)0;
+            else
+                out << normalX << normalY << normalZ;
         }
 
         if (m_colorVertices) {
@@ -192,7 +240,11 @@ void GltfWriter::write(const PointViewPtr v)
             float colorB =
                 v->getFieldAs<float>(Dimension::Id::Blue, i) / 255.0f;
 
-            out << colorR << colorG << colorB;
+            if (m_quantize)
+                out << quantizeColor(colorR) << quantizeColor(colorG)
+                    << quantizeColor(colorB) << (uint16_t)0;
+            else
+                out << colorR << colorG << colorB;
         }
 
     }
@@ -235,12 +287,22 @@ void GltfWriter::writeJsonChunk()
     }
     );
 
-    uint16_t elementSize =  sizeof(float) * 3; // X, Y, Z
+    // Quantized attributes are three 16-bit values padded to 8 bytes.
+    const uint16_t attrSize = m_quantize ?
+        4 * sizeof(uint16_t) : 3 * sizeof(float);
+
+    uint16_t elementSize = attrSize; // X, Y, Z
     if ( m_writeNormals ) {
-        elementSize += sizeof(float) * 3; // NormalX, NormalY, NormalZ
+        elementSize += attrSize; // NormalX, NormalY, NormalZ
     }
     if ( m_colorVertices ) {
-        elementSize += sizeof(float) * 3; // R, G, B
+        elementSize += attrSize; // R, G, B
+    }
+
+    if (m_quantize)
+    {
+        j["extensionsUsed"] = { "KHR_mesh_quantization" };
+        j["extensionsRequired"] = { "KHR_mesh_quantization" };
     }
 
     NL::json mesh;
@@ -290,48 +352,71 @@ void GltfWriter::writeJsonChunk()
 
         // Vertex position accessor
         positionAccessorIndex = nextAccessorIndex++;
-        j["accessors"].push_back(
-            {
-                { "bufferView", vertexAttributeBufferViewIndex },
-                { "componentType", 5126 },      // float code
-                { "type", "VEC3" },
-                { "count", vd.m_vertexCount },
-                { "byteOffset", byteOffset },
-                { "min", { b.minx, b.miny, b.minz } },
-                { "max", { b.maxx, b.maxy, b.maxz } }
-            }
-        );
+        if (m_quantize)
+            // Quantized positions span the extent of the view; the node's
+            // dequantization matrix maps them back to model space.
+            j["accessors"].push_back(
+                {
+                    { "bufferView", vertexAttributeBufferViewIndex },
+                    { "componentType", 5123 },      // unsigned short code
+                    { "type", "VEC3" },
+                    { "count", vd.m_vertexCount },
+                    { "byteOffset", byteOffset },
+                    { "min", { 0, 0, 0 } },
+                    { "max", { b.maxx > b.minx ? 65535 : 0,
+                               b.maxy > b.miny ? 65535 : 0,
+                               b.maxz > b.minz ? 65535 : 0 } }
+                }
+            );
+        else
+            j["accessors"].push_back(
+                {
+                    { "bufferView", vertexAttributeBufferViewIndex },
+                    { "componentType", 5126 },      // float code
+                    { "type", "VEC3" },
+                    { "count", vd.m_vertexCount },
+                    { "byteOffset", byteOffset },
+                    { "min", { b.minx, b.miny, b.minz } },
+                    { "max", { b.maxx, b.maxy, b.maxz } }
+                }
+            );
         meshAttributes["POSITION"] = positionAccessorIndex;
 
         if (m_writeNormals) {
-            byteOffset += sizeof(float) * 3;
+            byteOffset += attrSize;
             // Vertex normal accessor
             normalAccessorIndex = nextAccessorIndex++;
-            j["accessors"].push_back(
+            NL::json accessor(
                 {
                     { "bufferView", vertexAttributeBufferViewIndex },
-                    { "componentType", 5126 },      // float code
+                    { "componentType", m_quantize ? 5122 : 5126 },
                     { "type", "VEC3" },
                     { "byteOffset", byteOffset },
                     { "count", vd.m_vertexCount },
                 }
             );
+            if (m_quantize)
+                accessor["normalized"] = true;
+            j["accessors"].push_back(accessor);
             meshAttributes["NORMAL"] = normalAccessorIndex;
         }
 
         if (m_colorVertices) {
-            byteOffset += sizeof(float) * 3;
+            byteOffset += attrSize;
             // Vertex color accessor
             colorAccessorIndex = nextAccessorIndex++;
-            j["accessors"].push_back(
+            NL::json accessor(
                 {
                     { "bufferView", vertexAttributeBufferViewIndex },
-                    { "componentType", 5126 },      // float code
+                    { "componentType", m_quantize ? 5123 : 5126 },
                     { "type", "VEC3" },
                     { "byteOffset", byteOffset },
                     { "count", vd.m_vertexCount },
                 }
             );
+            if (m_quantize)
+                accessor["normalized"] = true;
+            j["accessors"].push_back(accessor);
             meshAttributes["COLOR_0"] = colorAccessorIndex;
         }
 
@@ -344,21 +429,63 @@ void GltfWriter::writeJsonChunk()
         );
     }
 
-    j["meshes"].push_back(mesh);
     j["scene"] = 0;
-
-    j["nodes"].push_back(
+    if (m_quantize)
+    {
+        // Each view has its own dequantization transform, so each gets its
+        // own mesh and node.  The node matrix folds the dequantization
+        // (scale/translate over the view's extent) into the Y-up rotation
+        // used in the unquantized case.
+        NL::json sceneNodes;
+        for (size_t i = 0; i < m_viewData.size(); ++i)
         {
-            { "mesh", 0 },
-            { "matrix", { 1, 0, 0, 0, 0, 0, -1, 0, 0, 1, 0, 0, 0, 0, 0, 1 } }
+            const BOX3D& b = m_viewData[i].m_bounds;
+            auto scale = [](double extent)
+                { return extent > 0 ? extent / 65535.0 : 1.0; };
+            double sx = scale(b.maxx - b.minx);
+            double sy = scale(b.maxy - b.miny);
+            double sz = scale(b.maxz - b.minz);
+
+            j["meshes"].push_back(
+                {
+                    { "primitives", { mesh["primitives"][i] } }
+                }
+            );
+            j["nodes"].push_back(
+                {
+                    { "mesh", i },
+                    { "matrix", { sx, 0, 0, 0,
+                                  0, 0, -sy, 0,
+                                  0, sz, 0, 0,
+                                  b.minx, b.minz, -b.miny, 1 } }
+                }
+            );
+            sceneNodes.push_back(i);
         }
-    );
+        j["scenes"].push_back(
+            {
+                { "nodes", sceneNodes }
+            }
+        );
+    }
+    else
+    {
+        j["meshes"].push_back(mesh);
 
-    j["scenes"].push_back(
-        {
-            { "nodes", { 0 } }
-        }
-    );
+        j["nodes"].push_back(
+            {
+                { "mesh", 0 },
+                { "matrix",
+                    { 1, 0, 0, 0, 0, 0, -1, 0, 0, 1, 0, 0, 0, 0, 0, 1 } }
+            }
+        );
+
+        j["scenes"].push_back(
+            {
+                { "nodes", { 0 } }
+            }
+        );
+    }
 
     // This seems very crude.  But I'm not sure we can do much else at this
     // point.
@@ -80,6 +80,7 @@ private:
     double m_alpha;
     bool m_doubleSided;
     bool m_colorVertices;
+    bool m_quantize;
 };
 
 
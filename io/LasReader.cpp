@@ -43,12 +43,14 @@
 
 #include <pdal/pdal_features.hpp>
 #include <pdal/Metadata.hpp>
+#include <pdal/PDALUtils.hpp>
 #include <pdal/PointView.hpp>
 #include <pdal/QuickInfo.hpp>
 #include <pdal/util/Extractor.hpp>
 #include <pdal/util/FileUtils.hpp>
 #include <pdal/util/IStream.hpp>
 #include <pdal/util/ProgramArgs.hpp>
+#include <pdal/util/portable_endian.hpp>
 
 #include "LasHeader.hpp"
 #include "LasVLR.hpp"
@@ -85,6 +87,7 @@ public:
     bool fixNames;
     PointId start;
     bool nosrs;
+    size_t threads;
 };
 
 struct LasReader::Private
@@ -99,8 +102,11 @@ struct LasReader::Private
     point_count_t index;
     IgnoreVLRList ignoreVLRs;
     std::vector<ExtraDim> extraDims;
+    // Memory map of the file when reading uncompressed local files.
+    FileUtils::MapContext mapCtx;
+    const char *pointMap;
 
-    Private() : decompressor(nullptr), index(0)
+    Private() : decompressor(nullptr), index(0), pointMap(nullptr)
     {}
 };
 
@@ -127,6 +133,8 @@ void LasReader::addArgs(ProgramArgs& args)
     args.add("fix_dims", "Make invalid dimension names valid by changing "
         "invalid characters to '_'", m_args->fixNames, true);
     args.add("nosrs", "Skip reading/processing file SRS", m_args->nosrs);
+    args.add("threads", "Number of threads used to decompress LAZ chunks "
+        "(LAZperf decompressor only)", m_args->threads, (size_t)1);
 }
 
 
@@ -218,6 +226,7 @@ void LasReader::createStream()
 {
     if (m_streamIf)
         std::cerr << "Attempt to create stream twice!\n";
+    IStream::readAhead(m_filename);
     m_streamIf.reset(new LasStreamIf(m_filename));
     if (!m_streamIf->m_istream)
     {
@@ -362,6 +371,29 @@ void LasReader::ready(PointTableRef table)
         std::istream::pos_type start = m_p->header.pointOffset() +
             (m_args->start * m_p->header.pointLen());
         stream->seekg(start);
+
+        // Map local files and load point records straight from the mapped
+        // pages, avoiding stream reads and the intermediate copy.  Fall
+        // back to stream I/O if the file can't be mapped or is truncated.
+        m_p->pointMap = nullptr;
+        if (mappable() && !Utils::isRemote(m_filename))
+        {
+            uintmax_t need = mapOffset() + m_p->header.pointOffset() +
+                (uintmax_t)m_p->header.pointCount() * m_p->header.pointLen();
+            if (FileUtils::fileExists(m_filename) &&
+                FileUtils::fileSize(m_filename) >= need)
+            {
+                m_p->mapCtx = FileUtils::mapFile(m_filename);
+                if (m_p->mapCtx.addr())
+                    m_p->pointMap =
+                        reinterpret_cast<const char *>(m_p->mapCtx.addr()) +
+                        mapOffset();
+                else
+                    log()->get(LogLevel::Debug) << "Couldn't map '" <<
+                        m_filename << "': " << m_p->mapCtx.what() <<
+                        "  Using stream I/O." << std::endl;
+            }
+        }
     }
 }
 
@@ -593,8 +625,15 @@ void LasReader::extractVlrMetadata(MetadataNode& forward, MetadataNode& m)
         name << "vlr_" << i++;
         MetadataNode vlrNode(name.str());
 
-        vlrNode.addEncoded("data",
-            (const uint8_t *)vlr.data(), vlr.dataLen(), vlr.description());
+        // Defer the base64 encoding -- VLR payloads can be large and the
+        // metadata often isn't output at all.
+        vlrNode.addLazy("data",
+            [vlr]()
+            {
+                return Utils::base64_encode((const uint8_t *)vlr.data(),
+                    (size_t)vlr.dataLen());
+            },
+            "base64Binary", vlr.description());
         vlrNode.add("user_id", vlr.userId(),
             "User ID of the record or pre-defined value from the "
             "specification.");
@@ -696,6 +735,12 @@ bool LasReader::processOne(PointRef& point)
             "LAZperf decompression library.");
 #endif
     } // compression
+    else if (m_p->pointMap)
+    {
+        const char *pos = m_p->pointMap + m_p->header.pointOffset() +
+            (m_args->start + m_p->index) * pointLen;
+        loadPoint(point, pos, pointLen);
+    }
     else
     {
         std::vector<char> buf(m_p->header.pointLen());
@@ -708,6 +753,96 @@ bool LasReader::processOne(PointRef& point)
 }
 
 
+point_count_t LasReader::streamSkip(point_count_t count)
+{
+    count = (std::min)(count, getNumPoints() - m_p->index);
+    if (!count)
+        return 0;
+
+    if (m_p->header.compressed())
+    {
+        point_count_t target = m_args->start + m_p->index + count;
+#ifdef PDAL_HAVE_LASZIP
+        if (m_args->compression == "LASZIP")
+            handleLaszip(laszip_seek_point(m_p->laszip, target));
+#endif
+
+#ifdef PDAL_HAVE_LAZPERF
+        if (m_args->compression == "LAZPERF")
+        {
+            // Seeking re-decodes the target chunk from its start, so only
+            // seek when the skip is long enough to jump whole chunks.
+            if (count < m_p->decompressor->chunkSize())
+                return 0;
+            if (!m_p->decompressor->seek(target))
+                return 0;
+        }
+#endif
+
+#if !defined(PDAL_HAVE_LAZPERF) && !defined(PDAL_HAVE_LASZIP)
+        (void)target;
+        return 0;
+#endif
+    }
+    else if (!m_p->pointMap)
+        m_streamIf->m_istream->seekg(
+            (std::streamoff)(count * m_p->header.pointLen()), std::ios::cur);
+    // Mapped files address point records by index, so only the index
+    // advances.
+    m_p->index += count;
+    return count;
+}
+
+
+bool LasReader::seek(PointId idx)
+{
+    if (idx > getNumPoints())
+        return false;
+
+    PointId target = m_args->start + idx;
+    if (m_p->header.compressed())
+    {
+#ifdef PDAL_HAVE_LASZIP
+        if (m_args->compression == "LASZIP")
+        {
+            handleLaszip(laszip_seek_point(m_p->laszip, target));
+            m_p->index = idx;
+            return true;
+        }
+#endif
+
+#ifdef PDAL_HAVE_LAZPERF
+        if (m_args->compression == "LAZPERF")
+        {
+            if (!m_p->decompressor->seek(target))
+                return false;
+            m_p->index = idx;
+            return true;
+        }
+#endif
+        return false;
+    }
+    if (!m_p->pointMap)
+        m_streamIf->m_istream->seekg(m_p->header.pointOffset() +
+            (std::streamoff)(target * m_p->header.pointLen()));
+    // Mapped files address point records by index, so only the index
+    // changes.
+    m_p->index = idx;
+    return true;
+}
+
+
+point_count_t LasReader::chunkSize() const
+{
+#ifdef PDAL_HAVE_LAZPERF
+    if (m_p->header.compressed() && m_args->compression == "LAZPERF" &&
+            m_p->decompressor)
+        return m_p->decompressor->chunkSize();
+#endif
+    return 1;
+}
+
+
 point_count_t LasReader::read(PointViewPtr view, point_count_t count)
 {
     size_t pointLen = m_p->header.pointLen();
@@ -717,6 +852,31 @@ point_count_t LasReader::read(PointViewPtr view, point_count_t count)
     if (m_p->header.compressed())
     {
 #if defined(PDAL_HAVE_LAZPERF) || defined(PDAL_HAVE_LASZIP)
+#ifdef PDAL_HAVE_LAZPERF
+        if (m_args->compression == "LAZPERF" && m_args->threads > 1)
+        {
+            // Decompress a batch of chunks across worker threads, then
+            // load the decoded records into the view.
+            point_count_t remaining = count;
+            point_count_t batch = (point_count_t)m_args->threads *
+                m_p->decompressor->chunkSize();
+            std::vector<char> buf(batch * pointLen);
+            while (remaining)
+            {
+                point_count_t blockPoints = (std::min)(batch, remaining);
+                m_p->decompressor->decompressBlock(buf.data(), blockPoints,
+                    m_args->threads);
+                PointId startId = view->size();
+                loadPoints(view, buf.data(), blockPoints, pointLen);
+                if (m_cb)
+                    for (point_count_t k = 0; k < blockPoints; ++k)
+                        m_cb(*view, startId + k);
+                remaining -= blockPoints;
+                i += blockPoints;
+            }
+        }
+        else
+#endif // PDAL_HAVE_LAZPERF
         if (m_args->compression == "LASZIP" || m_args->compression == "LAZPERF")
         {
             for (i = 0; i < count; i++)
@@ -733,6 +893,17 @@ point_count_t LasReader::read(PointViewPtr view, point_count_t count)
             "LAZperf decompression library.");
 #endif
     }
+    else if (m_p->pointMap)
+    {
+        const char *pos = m_p->pointMap + m_p->header.pointOffset() +
+            (m_args->start + m_p->index) * pointLen;
+        PointId startId = view->size();
+        loadPoints(view, pos, count, pointLen);
+        if (m_cb)
+            for (point_count_t k = 0; k < count; ++k)
+                m_cb(*view, startId + k);
+        i = count;
+    }
     else
     {
         point_count_t remaining = count;
@@ -746,17 +917,12 @@ point_count_t LasReader::read(PointViewPtr view, point_count_t count)
             {
                 point_count_t blockPoints = readFileBlock(buf, remaining);
                 remaining -= blockPoints;
-                char *pos = buf.data();
-                while (blockPoints--)
-                {
-                    PointId id = view->size();
-                    PointRef point = view->point(id);
-                    loadPoint(point, pos, pointLen);
-                    if (m_cb)
-                        m_cb(*view, id);
-                    pos += pointLen;
-                    i++;
-                }
+                PointId startId = view->size();
+                loadPoints(view, buf.data(), blockPoints, pointLen);
+                if (m_cb)
+                    for (point_count_t k = 0; k < blockPoints; ++k)
+                        m_cb(*view, startId + k);
+                i += blockPoints;
             } while (remaining);
         }
         catch (std::out_of_range&)
@@ -804,7 +970,7 @@ void LasReader::loadPoint(PointRef& point)
 #endif // PDAL_HAVE_LASZIP
 
 
-void LasReader::loadPoint(PointRef& point, char *buf, size_t bufsize)
+void LasReader::loadPoint(PointRef& point, const char *buf, size_t bufsize)
 {
     if (m_p->header.has14PointFormat())
         loadPointV14(point, buf, bufsize);
@@ -813,6 +979,250 @@ void LasReader::loadPoint(PointRef& point, char *buf, size_t bufsize)
 }
 
 
+// Decode a block of raw point records into the view, one pass per
+// dimension.  Field offsets are fixed for a given point format, so each
+// pass is a branch-free strided loop over the block with the scale/
+// offset transform applied in place, and the optional blocks (GPS time,
+// RGB, NIR) are decided once per block rather than once per point.
+void LasReader::loadPoints(PointViewPtr view, const char *buf,
+    point_count_t count, size_t pointLen)
+{
+    if (m_p->header.has14PointFormat())
+        loadPointsV14(view, buf, count, pointLen);
+    else
+        loadPointsV10(view, buf, count, pointLen);
+}
+
+
+namespace
+{
+
+// Strided little-endian field access over a block of raw point records.
+struct RecordBlock
+{
+    const char *m_buf;
+    size_t m_recordLen;
+
+    const char *field(PointId i, size_t off) const
+        { return m_buf + i * m_recordLen + off; }
+
+    uint8_t u8(PointId i, size_t off) const
+        { return (uint8_t)*field(i, off); }
+
+    int8_t i8(PointId i, size_t off) const
+        { return (int8_t)*field(i, off); }
+
+    uint16_t u16(PointId i, size_t off) const
+    {
+        uint16_t v;
+        memcpy(&v, field(i, off), sizeof(v));
+        return le16toh(v);
+    }
+
+    int16_t i16(PointId i, size_t off) const
+        { return (int16_t)u16(i, off); }
+
+    int32_t i32(PointId i, size_t off) const
+    {
+        uint32_t v;
+        memcpy(&v, field(i, off), sizeof(v));
+        return (int32_t)le32toh(v);
+    }
+
+    double f64(PointId i, size_t off) const
+    {
+        uint64_t v;
+        memcpy(&v, field(i, off), sizeof(v));
+        v = le64toh(v);
+        double d;
+        memcpy(&d, &v, sizeof(d));
+        return d;
+    }
+};
+
+} // unnamed namespace
+
+
+void LasReader::loadPointsV10(PointViewPtr view, const char *buf,
+    point_count_t count, size_t pointLen)
+{
+    using namespace Dimension;
+
+    const LasHeader& h = m_p->header;
+    RecordBlock rec { buf, pointLen };
+    PointId startId = view->size();
+
+    // The X pass runs first and grows the view; the remaining passes
+    // write into existing points.
+    TypedField<double> x(*view, Id::X);
+    for (PointId i = 0; i < count; ++i)
+        x.set(startId + i, rec.i32(i, 0) * h.scaleX() + h.offsetX());
+    TypedField<double> y(*view, Id::Y);
+    for (PointId i = 0; i < count; ++i)
+        y.set(startId + i, rec.i32(i, 4) * h.scaleY() + h.offsetY());
+    TypedField<double> z(*view, Id::Z);
+    for (PointId i = 0; i < count; ++i)
+        z.set(startId + i, rec.i32(i, 8) * h.scaleZ() + h.offsetZ());
+
+    TypedField<uint16_t> intensity(*view, Id::Intensity);
+    for (PointId i = 0; i < count; ++i)
+        intensity.set(startId + i, rec.u16(i, 12));
+
+    TypedField<uint8_t> returnNum(*view, Id::ReturnNumber);
+    for (PointId i = 0; i < count; ++i)
+        returnNum.set(startId + i, rec.u8(i, 14) & 0x07);
+    TypedField<uint8_t> numReturns(*view, Id::NumberOfReturns);
+    for (PointId i = 0; i < count; ++i)
+        numReturns.set(startId + i, (rec.u8(i, 14) >> 3) & 0x07);
+    TypedField<uint8_t> scanDirFlag(*view, Id::ScanDirectionFlag);
+    for (PointId i = 0; i < count; ++i)
+        scanDirFlag.set(startId + i, (rec.u8(i, 14) >> 6) & 0x01);
+    TypedField<uint8_t> flight(*view, Id::EdgeOfFlightLine);
+    for (PointId i = 0; i < count; ++i)
+        flight.set(startId + i, (rec.u8(i, 14) >> 7) & 0x01);
+
+    TypedField<uint8_t> classification(*view, Id::Classification);
+    for (PointId i = 0; i < count; ++i)
+        classification.set(startId + i, rec.u8(i, 15));
+    TypedField<float> scanAngle(*view, Id::ScanAngleRank);
+    for (PointId i = 0; i < count; ++i)
+        scanAngle.set(startId + i, rec.i8(i, 16));
+    TypedField<uint8_t> user(*view, Id::UserData);
+    for (PointId i = 0; i < count; ++i)
+        user.set(startId + i, rec.u8(i, 17));
+    TypedField<uint16_t> pointSourceId(*view, Id::PointSourceId);
+    for (PointId i = 0; i < count; ++i)
+        pointSourceId.set(startId + i, rec.u16(i, 18));
+
+    size_t off = 20;
+    if (h.hasTime())
+    {
+        TypedField<double> time(*view, Id::GpsTime);
+        for (PointId i = 0; i < count; ++i)
+            time.set(startId + i, rec.f64(i, off));
+        off += 8;
+    }
+    if (h.hasColor())
+    {
+        TypedField<uint16_t> red(*view, Id::Red);
+        for (PointId i = 0; i < count; ++i)
+            red.set(startId + i, rec.u16(i, off));
+        TypedField<uint16_t> green(*view, Id::Green);
+        for (PointId i = 0; i < count; ++i)
+            green.set(startId + i, rec.u16(i, off + 2));
+        TypedField<uint16_t> blue(*view, Id::Blue);
+        for (PointId i = 0; i < count; ++i)
+            blue.set(startId + i, rec.u16(i, off + 4));
+    }
+
+    if (m_p->extraDims.size())
+        loadExtraDimsBlock(view, startId, buf, count, pointLen);
+}
+
+
+void LasReader::loadPointsV14(PointViewPtr view, const char *buf,
+    point_count_t count, size_t pointLen)
+{
+    using namespace Dimension;
+
+    const LasHeader& h = m_p->header;
+    RecordBlock rec { buf, pointLen };
+    PointId startId = view->size();
+
+    // The X pass runs first and grows the view; the remaining passes
+    // write into existing points.
+    TypedField<double> x(*view, Id::X);
+    for (PointId i = 0; i < count; ++i)
+        x.set(startId + i, rec.i32(i, 0) * h.scaleX() + h.offsetX());
+    TypedField<double> y(*view, Id::Y);
+    for (PointId i = 0; i < count; ++i)
+        y.set(startId + i, rec.i32(i, 4) * h.scaleY() + h.offsetY());
+    TypedField<double> z(*view, Id::Z);
+    for (PointId i = 0; i < count; ++i)
+        z.set(startId + i, rec.i32(i, 8) * h.scaleZ() + h.offsetZ());
+
+    TypedField<uint16_t> intensity(*view, Id::Intensity);
+    for (PointId i = 0; i < count; ++i)
+        intensity.set(startId + i, rec.u16(i, 12));
+
+    TypedField<uint8_t> returnNum(*view, Id::ReturnNumber);
+    for (PointId i = 0; i < count; ++i)
+        returnNum.set(startId + i, rec.u8(i, 14) & 0x0F);
+    TypedField<uint8_t> numReturns(*view, Id::NumberOfReturns);
+    for (PointId i = 0; i < count; ++i)
+        numReturns.set(startId + i, (rec.u8(i, 14) >> 4) & 0x0F);
+
+    TypedField<uint8_t> classFlags(*view, Id::ClassFlags);
+    for (PointId i = 0; i < count; ++i)
+        classFlags.set(startId + i, rec.u8(i, 15) & 0x0F);
+    TypedField<uint8_t> scanChannel(*view, Id::ScanChannel);
+    for (PointId i = 0; i < count; ++i)
+        scanChannel.set(startId + i, (rec.u8(i, 15) >> 4) & 0x03);
+    TypedField<uint8_t> scanDirFlag(*view, Id::ScanDirectionFlag);
+    for (PointId i = 0; i < count; ++i)
+        scanDirFlag.set(startId + i, (rec.u8(i, 15) >> 6) & 0x01);
+    TypedField<uint8_t> flight(*view, Id::EdgeOfFlightLine);
+    for (PointId i = 0; i < count; ++i)
+        flight.set(startId + i, (rec.u8(i, 15) >> 7) & 0x01);
+
+    TypedField<uint8_t> classification(*view, Id::Classification);
+    for (PointId i = 0; i < count; ++i)
+        classification.set(startId + i, rec.u8(i, 16));
+    TypedField<uint8_t> user(*view, Id::UserData);
+    for (PointId i = 0; i < count; ++i)
+        user.set(startId + i, rec.u8(i, 17));
+    TypedField<float> scanAngle(*view, Id::ScanAngleRank);
+    for (PointId i = 0; i < count; ++i)
+        scanAngle.set(startId + i, (float)(rec.i16(i, 18) * .006));
+    TypedField<uint16_t> pointSourceId(*view, Id::PointSourceId);
+    for (PointId i = 0; i < count; ++i)
+        pointSourceId.set(startId + i, rec.u16(i, 20));
+    TypedField<double> time(*view, Id::GpsTime);
+    for (PointId i = 0; i < count; ++i)
+        time.set(startId + i, rec.f64(i, 22));
+
+    size_t off = 30;
+    if (h.hasColor())
+    {
+        TypedField<uint16_t> red(*view, Id::Red);
+        for (PointId i = 0; i < count; ++i)
+            red.set(startId + i, rec.u16(i, off));
+        TypedField<uint16_t> green(*view, Id::Green);
+        for (PointId i = 0; i < count; ++i)
+            green.set(startId + i, rec.u16(i, off + 2));
+        TypedField<uint16_t> blue(*view, Id::Blue);
+        for (PointId i = 0; i < count; ++i)
+            blue.set(startId + i, rec.u16(i, off + 4));
+        off += 6;
+    }
+    if (h.hasInfrared())
+    {
+        TypedField<uint16_t> nir(*view, Id::Infrared);
+        for (PointId i = 0; i < count; ++i)
+            nir.set(startId + i, rec.u16(i, off));
+    }
+
+    if (m_p->extraDims.size())
+        loadExtraDimsBlock(view, startId, buf, count, pointLen);
+}
+
+
+// Extra-byte dimensions are type-dispatched per value, so they keep the
+// per-point extractor path; the block loop just strides over the records.
+void LasReader::loadExtraDimsBlock(PointViewPtr view, PointId startId,
+    const char *buf, point_count_t count, size_t pointLen)
+{
+    size_t ebOff = m_p->header.basePointLen();
+
+    for (PointId i = 0; i < count; ++i)
+    {
+        PointRef point = view->point(startId + i);
+        LeExtractor istream(buf + i * pointLen + ebOff, pointLen - ebOff);
+        loadExtraDims(istream, point);
+    }
+}
+
+
 #ifdef PDAL_HAVE_LASZIP
 void LasReader::loadPointV10(PointRef& point)
 {
@@ -858,7 +1268,7 @@ void LasReader::loadPointV10(PointRef& point)
 }
 #endif // PDAL_HAVE_LASZIP
 
-void LasReader::loadPointV10(PointRef& point, char *buf, size_t bufsize)
+void LasReader::loadPointV10(PointRef& point, const char *buf, size_t bufsize)
 {
     LeExtractor istream(buf, bufsize);
 
@@ -970,7 +1380,7 @@ void LasReader::loadPointV14(PointRef& point)
 #endif  // PDAL_HAVE_LASZIP
 
 
-void LasReader::loadPointV14(PointRef& point, char *buf, size_t bufsize)
+void LasReader::loadPointV14(PointRef& point, const char *buf, size_t bufsize)
 {
     LeExtractor istream(buf, bufsize);
 
@@ -1074,6 +1484,11 @@ void LasReader::done(PointTableRef)
         handleLaszip(laszip_destroy(m_p->laszip));
     }
 #endif
+    if (m_p->pointMap)
+    {
+        m_p->mapCtx = FileUtils::unmapFile(m_p->mapCtx);
+        m_p->pointMap = nullptr;
+    }
     m_streamIf.reset();
 }
 
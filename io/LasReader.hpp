@@ -87,9 +87,35 @@ public:
     const LasHeader& header() const;
     point_count_t getNumPoints() const;
 
+    /// Position the next sequential read at the given point, counted
+    /// from the point selected by the 'start' option.  For LAZ input
+    /// the chunk table is used to jump to the containing chunk, so at
+    /// most one chunk's worth of leading points is decoded and
+    /// discarded.  Valid once the reader is ready.
+    /// \param idx  Point at which the next read should begin.
+    /// \return  Whether the seek succeeded.
+    bool seek(PointId idx);
+
+    /// Number of points in a compression chunk for chunked LAZ input,
+    /// or 1 when point records are independently addressable.  Ranges
+    /// aligned to this granularity can be read in parallel by separate
+    /// readers without decoding discarded points.
+    point_count_t chunkSize() const;
+
 protected:
     virtual void createStream();
 
+    /// Whether point data may be read via a memory map of m_filename.
+    virtual bool mappable() const
+    { return true; }
+
+    /// Byte offset of the LAS data within m_filename.  Subclasses that
+    /// embed LAS data in a container (e.g. NITF) return the position of
+    /// the embedded data; the file is mapped in place and reads are
+    /// shifted by this amount.
+    virtual uintmax_t mapOffset() const
+    { return 0; }
+
     std::unique_ptr<LasStreamIf> m_streamIf;
 
 private:
@@ -101,6 +127,7 @@ private:
     virtual void ready(PointTableRef table);
     virtual point_count_t read(PointViewPtr view, point_count_t count);
     virtual bool processOne(PointRef& point);
+    virtual point_count_t streamSkip(point_count_t count);
     virtual void done(PointTableRef table);
     virtual bool eof();
 
@@ -112,10 +139,18 @@ private:
     void loadPoint(PointRef& point);
     void loadPointV10(PointRef& point);
     void loadPointV14(PointRef& point);
-    void loadPoint(PointRef& point, char *buf, size_t bufsize);
-    void loadPointV10(PointRef& point, char *buf, size_t bufsize);
-    void loadPointV14(PointRef& point, char *buf, size_t bufsize);
+    void loadPoint(PointRef& point, const char *buf, size_t bufsize);
+    void loadPointV10(PointRef& point, const char *buf, size_t bufsize);
+    void loadPointV14(PointRef& point, const char *buf, size_t bufsize);
+    void loadPoints(PointViewPtr view, const char *buf, point_count_t count,
+        size_t pointLen);
+    void loadPointsV10(PointViewPtr view, const char *buf, point_count_t count,
+        size_t pointLen);
+    void loadPointsV14(PointViewPtr view, const char *buf, point_count_t count,
+        size_t pointLen);
     void loadExtraDims(LeExtractor& istream, PointRef& data);
+    void loadExtraDimsBlock(PointViewPtr view, PointId startId,
+        const char *buf, point_count_t count, size_t pointLen);
     point_count_t readFileBlock(std::vector<char>& buf,
         point_count_t maxPoints);
     void handleLaszip(int result);
@@ -43,7 +43,24 @@
 namespace pdal
 {
 
+namespace
+{
+
+// Payloads of these records are consumed while a file is being opened
+// (SRS, compression parameters, extra dimensions, PDAL metadata), so
+// they can't be deferred.
+bool payloadNeededOnLoad(const std::string& userId, uint16_t recordId)
+{
+    if (userId == TRANSFORM_USER_ID || userId == LIBLAS_USER_ID ||
+        userId == LASZIP_USER_ID || userId == PDAL_USER_ID)
+        return true;
+    return userId == SPEC_USER_ID && recordId == EXTRA_BYTES_RECORD_ID;
+}
+
+} // unnamed namespace
+
 const uint16_t LasVLR::MAX_DATA_SIZE = 65535;
+const uint64_t LasVLR::LAZY_DATA_SIZE = 1048576;
 
 bool LasVLR::read(ILeStream& in, size_t limit)
 {
@@ -64,6 +81,22 @@ bool LasVLR::read(ILeStream& in, size_t limit)
 }
 
 
+void LasVLR::loadData(ILeStream& in)
+{
+    if (!m_lazy)
+        return;
+
+    std::streampos pos = in.position();
+    in.seek(m_dataOffset);
+    m_data.resize((size_t)m_lazyLen);
+    if (m_data.size() > 0)
+        in.get(m_data);
+    m_lazy = false;
+    m_lazyLen = 0;
+    in.seek(pos);
+}
+
+
 std::istream& operator>>(std::istream& in, LasVLR& v)
 {
     NL::json j;
@@ -219,6 +252,17 @@ bool ExtLasVLR::read(ILeStream& in, uintmax_t limit)
     if (uintmax_t(in.position()) + dataLen > limit)
         return false;
     in.get(m_description, 32);
+    if (dataLen > LAZY_DATA_SIZE && !payloadNeededOnLoad(m_userId, m_recordId))
+    {
+        // Bulk payloads (waveform data and the like) can run to hundreds
+        // of megabytes.  Remember where the payload lives and skip past
+        // it; the bytes are fetched by loadData() if anything asks.
+        m_lazy = true;
+        m_lazyLen = dataLen;
+        m_dataOffset = (uint64_t)in.position();
+        in.seek(m_dataOffset + dataLen);
+        return true;
+    }
     m_data.resize(dataLen);
     if (m_data.size() > 0)
         in.get(m_data);
@@ -67,13 +67,16 @@ class PDAL_DLL LasVLR
 {
 public:
     static const uint16_t MAX_DATA_SIZE;
+    static const uint64_t LAZY_DATA_SIZE;
 
     LasVLR(const std::string& userId, uint16_t recordId,
             const std::string& description, std::vector<uint8_t>& data) :
         m_userId(userId), m_recordId(recordId), m_description(description),
-        m_data(std::move(data)), m_recordSig(0)
+        m_data(std::move(data)), m_recordSig(0), m_dataOffset(0),
+        m_lazyLen(0), m_lazy(false)
     {}
-    LasVLR() : m_recordId(0), m_recordSig(0)
+    LasVLR() : m_recordId(0), m_recordSig(0), m_dataOffset(0), m_lazyLen(0),
+        m_lazy(false)
     {}
 
     std::string userId() const
@@ -88,16 +91,21 @@ public:
     bool matches(const std::string& userId, uint16_t recordId) const
         { return matches(userId) && (recordId == m_recordId); }
 
+    // The returned pointer is invalid for a lazy VLR until loadData()
+    // has been called.
     const char* data() const
         { return (const char *)m_data.data(); }
     char* data()
         { return (char *)m_data.data(); }
     bool isEmpty() const
-        { return m_data.size() == 0; }
+        { return dataLen() == 0; }
     uint64_t dataLen() const
-        { return m_data.size(); }
+        { return m_lazy ? m_lazyLen : m_data.size(); }
     void setDataLen(uint64_t size)
         { m_data.resize((size_t)size); }
+    bool dataLoaded() const
+        { return !m_lazy; }
+    void loadData(ILeStream& in);
     void write(OLeStream& out, uint16_t recordSig);
     bool read(ILeStream& in, size_t limit);
 
@@ -111,6 +119,11 @@ protected:
     std::string m_description;
     std::vector<uint8_t> m_data;
     uint16_t m_recordSig;
+    // Where a deferred payload lives in the file and how long it is.
+    // Valid only while m_lazy is set.
+    uint64_t m_dataOffset;
+    uint64_t m_lazyLen;
+    bool m_lazy;
 };
 
 class ExtLasVLR : public LasVLR
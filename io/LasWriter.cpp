@@ -71,13 +71,15 @@ CREATE_STATIC_STAGE(LasWriter, s_info)
 
 std::string LasWriter::getName() const { return s_info.name; }
 
-LasWriter::LasWriter() : m_compressor(nullptr), m_ostream(NULL),
+LasWriter::LasWriter() : m_compressor(nullptr), m_ostream(NULL), m_fileStream(NULL),
     m_compression(LasCompression::None), m_srsCnt(0)
 {}
 
 
 LasWriter::~LasWriter()
 {
+    if (m_mapped)
+        FileUtils::unmapFile(m_mapCtx);
 #ifdef PDAL_HAVE_LAZPERF
     delete m_compressor;
 #endif
@@ -94,6 +96,9 @@ void LasWriter::addArgs(ProgramArgs& args)
 
     args.add("filename", "Output filename", m_filename).setPositional();
     args.add("a_srs", "Spatial reference to use to write output", m_aSrs);
+    args.add("compression_threads", "Number of threads used to compress "
+        "LAZ chunks (LAZperf compressor only)", m_compressionThreads,
+        (size_t)1);
     args.add("compression", "Compression to use for output ('LASZIP' or "
         "'LAZPERF')", m_compression, LasCompression::None);
     args.add("discard_high_return_numbers", "Discard points with out-of-spec "
@@ -303,7 +308,13 @@ void LasWriter::readyFile(const std::string& filename,
         throwError("Couldn't open file '" + filename + "' for output.");
     m_curFilename = filename;
     Utils::writeProgress(m_progressFd, "READYFILE", filename);
-    prepOutput(out, srs);
+
+    // Stage output through the async double buffer so encoding isn't
+    // stalled by device latency.
+    m_fileStream = out;
+    m_asyncBuf.reset(new AsyncDoubleBuf(*out));
+    m_asyncOut.reset(new std::ostream(m_asyncBuf.get()));
+    prepOutput(m_asyncOut.get(), srs);
 }
 
 
@@ -702,7 +713,8 @@ void LasWriter::readyLazPerfCompression()
 {
 #ifdef PDAL_HAVE_LAZPERF
     int ebCount = m_lasHeader.pointLen() - m_lasHeader.basePointLen();
-    m_compressor = new LazPerfVlrCompressor(*m_ostream, m_lasHeader.pointFormat(), ebCount);
+    m_compressor = new LazPerfVlrCompressor(*m_ostream, m_lasHeader.pointFormat(), ebCount,
+        m_compressionThreads);
     std::vector<char> lazVlrData = m_compressor->vlrData();
     std::vector<uint8_t> vlrdata(lazVlrData.begin(), lazVlrData.end());
     addVlr(LASZIP_USER_ID, LASZIP_RECORD_ID, "http://laszip.org", vlrdata);
@@ -792,6 +804,37 @@ bool LasWriter::processPoint(PointRef& point)
 void LasWriter::prerunFile(const PointViewSet& pvSet)
 {
     m_scaling.setAutoXForm(pvSet);
+
+    // For uncompressed local output the final file size is known up
+    // front, so preallocate the file and map it writable.  writeView()
+    // then builds point records directly in the page cache instead of
+    // staging them through m_pointBuf.  Points pitched by
+    // discard_high_return_numbers would leave holes in a preallocated
+    // file, so that option keeps the buffered path.
+    if (m_fileStream && m_compression == LasCompression::None &&
+        !m_discardHighReturnNumbers && !Utils::isRemote(m_curFilename))
+    {
+        uintmax_t total = 0;
+        for (const PointViewPtr& v : pvSet)
+            total += v->size();
+        if (!total)
+            return;
+
+        // Get the header and VLRs out of the stream buffers before the
+        // file is resized.
+        m_ostream->flush();
+        m_mapCtx = FileUtils::mapFile(m_curFilename, false, 0,
+            m_lasHeader.pointOffset() + total * m_lasHeader.pointLen());
+        if (m_mapCtx.addr())
+        {
+            m_mapPos = m_lasHeader.pointOffset();
+            m_mapped = true;
+        }
+        else
+            log()->get(LogLevel::Debug) << "Couldn't map '" <<
+                m_curFilename << "' for output (" << m_mapCtx.what() <<
+                "): using buffered writes." << std::endl;
+    }
 }
 
 
@@ -813,6 +856,20 @@ void LasWriter::writeView(const PointViewPtr view)
             processPoint(point);
         }
     }
+    else if (m_mapped)
+    {
+        // Build the point records directly in the mapped file.
+        LeInserter ostream(
+            reinterpret_cast<char *>(m_mapCtx.addr()) + m_mapPos,
+            m_mapCtx.m_size - m_mapPos);
+        PointRef point(*view, 0);
+        for (PointId idx = 0; idx < view->size(); ++idx)
+        {
+            point.setPointId(idx);
+            fillPointBuf(point, ostream);
+        }
+        m_mapPos += pointLen * view->size();
+    }
     else
     {
         // Make a buffer of at most a meg.
@@ -1132,10 +1189,28 @@ point_count_t LasWriter::fillWriteBuf(const PointView& view,
 
 void LasWriter::doneFile()
 {
+    if (m_mapped)
+    {
+        m_mapCtx = FileUtils::unmapFile(m_mapCtx);
+        m_mapped = false;
+        // Put the stream where the mapped writes left off so the EVLRs
+        // land after the point data.
+        m_ostream->seekp((std::streamoff)m_mapPos);
+    }
     finishOutput();
     Utils::writeProgress(m_progressFd, "DONEFILE", m_curFilename);
     getMetadata().addList("filename", m_curFilename);
-    delete m_ostream;
+    if (m_asyncOut)
+    {
+        // Drain the async buffer before the file stream goes away.
+        m_asyncOut->flush();
+        m_asyncOut.reset();
+        m_asyncBuf.reset();
+        delete m_fileStream;
+        m_fileStream = NULL;
+    }
+    else
+        delete m_ostream;
     m_ostream = NULL;
 }
 
@@ -37,6 +37,8 @@
 #include <pdal/pdal_features.hpp>
 #include <pdal/FlexWriter.hpp>
 #include <pdal/Streamable.hpp>
+#include <pdal/util/AsyncDoubleBuf.hpp>
+#include <pdal/util/FileUtils.hpp>
 
 #include "HeaderVal.hpp"
 #include "LasError.hpp"
@@ -90,6 +92,17 @@ private:
     std::map<std::string, std::string> m_headerVals;
     std::vector<VlrOptionInfo> m_optionInfos;
     std::ostream *m_ostream;
+    // File stream and async buffer backing m_ostream when we open the
+    // output file ourselves.
+    std::ostream *m_fileStream;
+    std::unique_ptr<AsyncDoubleBuf> m_asyncBuf;
+    std::unique_ptr<std::ostream> m_asyncOut;
+    // Writable mapping of the output file used for uncompressed local
+    // output - point records are built in place instead of being staged
+    // through m_pointBuf.
+    FileUtils::MapContext m_mapCtx;
+    bool m_mapped = false;
+    uintmax_t m_mapPos = 0;
     std::vector<LasVLR> m_vlrs;
     std::vector<ExtLasVLR> m_eVlrs;
     StringList m_extraDimSpec;
@@ -101,6 +114,7 @@ private:
     std::set<std::string> m_forwards;
     bool m_forwardVlrs = false;
     LasCompression m_compression;
+    size_t m_compressionThreads;
     std::vector<char> m_pointBuf;
     SpatialReference m_aSrs;
     int m_srsCnt;
@@ -49,7 +49,7 @@ CREATE_STATIC_STAGE(MemoryViewReader, s_info)
 
 std::string MemoryViewReader::getName() const { return s_info.name; }
 
-MemoryViewReader::MemoryViewReader() : m_prepared(false)
+MemoryViewReader::MemoryViewReader() : m_count(0), m_prepared(false)
 {}
 
 
@@ -94,6 +94,8 @@ void MemoryViewReader::pushField(const Field& f)
 {
     if (m_prepared)
         throwError("Can't pushField() after MemoryViewReader is prepared.");
+    if (m_arrays.size())
+        throwError("Can't mix pushField() and pushArray().");
 
     for (auto& tempField : m_fields)
         if (tempField.m_name == f.m_name)
@@ -104,10 +106,32 @@ void MemoryViewReader::pushField(const Field& f)
 }
 
 
+void MemoryViewReader::pushArray(const Array& a)
+{
+    if (m_prepared)
+        throwError("Can't pushArray() after MemoryViewReader is prepared.");
+    if (m_fields.size())
+        throwError("Can't mix pushField() and pushArray().");
+    if (!a.m_data)
+        throwError("Array '" + a.m_name + "' has no data pointer.");
+
+    for (auto& tempArray : m_arrays)
+        if (tempArray.m_name == a.m_name)
+            throwError("Attempt to push duplicate array with name '" +
+                a.m_name + ".'");
+
+    m_arrays.emplace_back(a);
+    if (m_arrays.back().m_stride == 0)
+        m_arrays.back().m_stride = Dimension::size(a.m_type);
+}
+
+
 void MemoryViewReader::addDimensions(PointLayoutPtr layout)
 {
     for (auto& f : m_fields)
         f.m_id = layout->registerOrAssignDim(f.m_name, f.m_type);
+    for (auto& a : m_arrays)
+        a.m_id = layout->registerOrAssignDim(a.m_name, a.m_type);
 }
 
 
@@ -120,14 +144,27 @@ void MemoryViewReader::initialize()
 void MemoryViewReader::prepared(PointTableRef)
 {
     int xyz = 0;
-    for (const FullField& f : m_fields)
+    auto markXyz = [&xyz](const std::string& name)
     {
-        if (f.m_name == "X")
+        if (name == "X")
             xyz |= 1;
-        else if (f.m_name == "Y")
+        else if (name == "Y")
             xyz |= 2;
-        else if (f.m_name == "Z")
+        else if (name == "Z")
             xyz |= 4;
+    };
+    for (const FullField& f : m_fields)
+        markXyz(f.m_name);
+    for (const FullArray& a : m_arrays)
+        markXyz(a.m_name);
+
+    if (m_arrays.size())
+    {
+        m_count = m_arrays.front().m_count;
+        for (const FullArray& a : m_arrays)
+            if (a.m_count != m_count)
+                throwError("All arrays must contain the same number "
+                    "of values.");
     }
     if (xyz != 0 && xyz != 7)
         throwError("Fields must contain all or none of X, Y and Z.");
@@ -166,7 +203,7 @@ void MemoryViewReader::prepared(PointTableRef)
 
 void MemoryViewReader::ready(PointTableRef)
 {
-    if (!m_incrementer)
+    if (!m_incrementer && m_arrays.empty())
         throwError("Points cannot be read without calling setIncrementer().");
     m_index = 0;
 }
@@ -174,6 +211,9 @@ void MemoryViewReader::ready(PointTableRef)
 
 point_count_t MemoryViewReader::read(PointViewPtr v, point_count_t numPts)
 {
+    if (m_arrays.size())
+        return readArrays(v, numPts);
+
     PointId idx = v->size();
     point_count_t cnt = 0;
 
@@ -190,14 +230,63 @@ point_count_t MemoryViewReader::read(PointViewPtr v, point_count_t numPts)
 }
 
 
+// Copy one registered array at a time - the source values are contiguous
+// in memory, so column order avoids a point's worth of pointer chasing
+// per value.
+point_count_t MemoryViewReader::readArrays(PointViewPtr v, point_count_t numPts)
+{
+    if (m_index >= m_count)
+        return 0;
+    point_count_t cnt = (std::min)(numPts, m_count - m_index);
+    PointId startId = v->size();
+
+    PointRef point(*v);
+    for (const FullArray& a : m_arrays)
+    {
+        const char *src = a.m_data + m_index * a.m_stride;
+        for (point_count_t i = 0; i < cnt; ++i)
+        {
+            point.setPointId(startId + i);
+            point.setField(a.m_id, a.m_type, (void *)src);
+            src += a.m_stride;
+        }
+    }
+
+    if (m_shape.valid())
+        for (point_count_t i = 0; i < cnt; ++i)
+        {
+            PointId index = m_index + i;
+
+            point.setPointId(startId + i);
+            point.setField(Dimension::Id::X, (index % m_xIter) / m_xDiv);
+            point.setField(Dimension::Id::Y, (index % m_yIter) / m_yDiv);
+            point.setField(Dimension::Id::Z, (index % m_zIter) / m_zDiv);
+        }
+
+    m_index += cnt;
+    return cnt;
+}
+
+
 bool MemoryViewReader::processOne(PointRef& point)
 {
-    char *base = m_incrementer(m_index);
-    if (!base)
-        return false;
+    if (m_arrays.size())
+    {
+        if (m_index >= m_count)
+            return false;
+        for (const FullArray& a : m_arrays)
+            point.setField(a.m_id, a.m_type,
+                (void *)(a.m_data + m_index * a.m_stride));
+    }
+    else
+    {
+        char *base = m_incrementer(m_index);
+        if (!base)
+            return false;
 
-    for (const FullField& f : m_fields)
-        point.setField(f.m_id, f.m_type, (void *)(base + f.m_offset));
+        for (const FullField& f : m_fields)
+            point.setField(f.m_id, f.m_type, (void *)(base + f.m_offset));
+    }
 
     if (m_shape.valid())
     {
@@ -96,7 +96,16 @@ public:
         Dimension::Type m_type;
         size_t m_offset;
     };
-    using PointIncrementer = std::function<char *(PointId)>; 
+
+    struct Array
+    {
+        std::string m_name;
+        Dimension::Type m_type;
+        const char *m_data;
+        size_t m_stride;    // Bytes between values.  0 means packed.
+        size_t m_count;
+    };
+    using PointIncrementer = std::function<char *(PointId)>;
 
 private:
     struct FullField : public Field
@@ -107,6 +116,14 @@ private:
         Dimension::Id m_id;
     };
 
+    struct FullArray : public Array
+    {
+        FullArray(const Array& a) : Array(a), m_id(Dimension::Id::Unknown)
+        {}
+
+        Dimension::Id m_id;
+    };
+
 
 public:
     std::string getName() const;
@@ -120,6 +137,16 @@ public:
     */
     void pushField(const Field& f);
 
+    /**
+      Register a whole external array for a dimension.  The array is read
+      in place - values are never staged through a per-point callback.
+      Arrays can't be mixed with fields and all arrays must hold the same
+      number of values.  The data must stay valid until reading completes.
+
+      \param a  Array to register.
+    */
+    void pushArray(const Array& a);
+
     /**
       Set a function that handles modifying the memory location of
       subsequent points.
@@ -174,6 +201,16 @@ private:
     */
     virtual point_count_t read(PointViewPtr view, point_count_t numPts);
 
+    /**
+      Read up to numPts points from registered arrays into the \ref view,
+      copying a whole array at a time.
+
+      \param view  PointView in which to insert point data.
+      \param numPts  Maximum number of points to read.
+      \return  Number of points read.
+    */
+    point_count_t readArrays(PointViewPtr view, point_count_t numPts);
+
     /**
       Read a single point from the input.
 
@@ -185,6 +222,8 @@ private:
 private:
     PointIncrementer m_incrementer;
     std::vector<FullField> m_fields;
+    std::vector<FullArray> m_arrays;
+    point_count_t m_count;
     bool m_prepared;
     PointId m_index;
     Shape m_shape;
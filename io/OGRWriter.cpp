@@ -60,7 +60,7 @@ static StaticPluginInfo const s_info
 CREATE_STATIC_STAGE(OGRWriter, s_info)
 
 OGRWriter::OGRWriter() : m_driver(nullptr), m_ds(nullptr), m_layer(nullptr),
-    m_feature(nullptr)
+    m_feature(nullptr), m_inTxn(false)
 {}
 
 
@@ -78,6 +78,8 @@ void OGRWriter::addArgs(ProgramArgs& args)
     args.add("measure_dim", "Use dimensions as a measure value",
         m_measureDimName);
     args.add("ogrdriver", "OGR writer driver name", m_driverName, m_driverName);
+    args.add("batch_size", "Number of features to write per transaction. "
+        "0 disables transactions", m_batchSize, (size_t)10000);
 }
 
 
@@ -135,6 +137,32 @@ void OGRWriter::readyFile(const std::string& filename,
         m_ds->SetProjection(srs.getWKT().data());
     }
     m_feature = OGRFeature::CreateFeature(m_layer->GetLayerDefn());
+    m_batchCount = 0;
+    startBatch();
+}
+
+
+// Open a transaction on the datasource if batching was requested.
+// Drivers without transaction support (shapefile, GeoJSON) just decline -
+// features are then written as before.
+void OGRWriter::startBatch()
+{
+    if (!m_batchSize)
+        return;
+
+    gdal::ErrorHandlerSuspender devnull;
+
+    m_inTxn = (m_ds->StartTransaction() == OGRERR_NONE);
+}
+
+
+void OGRWriter::commitBatch()
+{
+    if (!m_inTxn)
+        return;
+    m_inTxn = false;
+    if (m_ds->CommitTransaction() != OGRERR_NONE)
+        throwError("Couldn't commit feature transaction.");
 }
 
 void OGRWriter::writeView(const PointViewPtr view)
@@ -175,6 +203,12 @@ bool OGRWriter::processOne(PointRef& point)
         if (m_layer->CreateFeature(m_feature))
             throwError("Couldn't create feature.");
         m_curCount = 0;
+        if (m_inTxn && ++m_batchCount >= m_batchSize)
+        {
+            commitBatch();
+            m_batchCount = 0;
+            startBatch();
+        }
     }
     return true;
 }
@@ -185,6 +219,7 @@ void OGRWriter::doneFile()
     if (m_curCount)
         if (m_layer->CreateFeature(m_feature))
             throwError("Couldn't create feature.");
+    commitBatch();
     OGRFeature::DestroyFeature(m_feature);
     GDALClose(m_ds);
     m_layer = nullptr;
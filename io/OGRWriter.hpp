@@ -60,6 +60,8 @@ private:
     virtual void writeView(const PointViewPtr view);
     virtual bool processOne(PointRef& point);
     virtual void doneFile();
+    void startBatch();
+    void commitBatch();
 
     // I don't think this needs to be deleted.
     GDALDriver *m_driver;
@@ -74,6 +76,10 @@ private:
     size_t m_curCount;
     std::string m_measureDimName;
     Dimension::Id m_measureDim;
+    size_t m_batchSize;
+    size_t m_batchCount;
+    /// Whether a transaction is open on the datasource.
+    bool m_inTxn;
 };
 
 }
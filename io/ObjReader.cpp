@@ -34,9 +34,43 @@
 
 #include "ObjReader.hpp"
 
+#include <cctype>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <istream>
+
 namespace pdal
 {
 
+namespace
+{
+
+// Return the next whitespace-delimited token in [pos, end), advancing
+// pos past it, or an empty view when the line is exhausted.
+std::string_view nextToken(const char *& pos, const char *end)
+{
+    while (pos < end && std::isspace((unsigned char)*pos))
+        ++pos;
+    const char *start = pos;
+    while (pos < end && !std::isspace((unsigned char)*pos))
+        ++pos;
+    return std::string_view(start, pos - start);
+}
+
+// The token points into the NUL-terminated parse buffer and ends at
+// whitespace or the buffer end, so strtod can't run past it.
+bool parseDouble(std::string_view t, double& d)
+{
+    if (t.empty())
+        return false;
+    char *end;
+    d = std::strtod(t.data(), &end);
+    return end == t.data() + t.size();
+}
+
+} // unnamed namespace
+
 static StaticPluginInfo const s_info
 {
     "readers.obj",
@@ -67,15 +101,27 @@ void ObjReader::addDimensions(PointLayoutPtr layout)
 
 void ObjReader::ready(PointTableRef)
 {
-    m_istream = Utils::openFile(m_filename, false);
-    if (!m_istream)
+    std::istream *in = Utils::openFile(m_filename, true);
+    if (!in)
         throwError("Couldn't open '" + m_filename + "'.");
+
+    // Parse out of a single in-memory buffer rather than pulling lines
+    // off the stream; the whole file has to be read anyway to build the
+    // vertex lists.
+    m_buffer.assign(std::istreambuf_iterator<char>(*in),
+        std::istreambuf_iterator<char>());
+    Utils::closeFile(in);
+
+    m_pos = m_buffer.data();
+    m_end = m_buffer.data() + m_buffer.size();
+    m_lineNum = 0;
     m_index = 0;
 }
 
 void ObjReader::done(PointTableRef)
 {
-    Utils::closeFile(m_istream);
+    m_buffer.clear();
+    m_buffer.shrink_to_fit();
 }
 
 point_count_t ObjReader::read(PointViewPtr view, point_count_t cnt)
@@ -197,122 +243,125 @@ void ObjReader::newNormalVertex(double x, double y, double z)
 
 bool ObjReader::readFace(FACE& face, PointViewPtr view)
 {
-    long long lineOfFile = 0;
-    while(true) {
-        if(m_istream->peek() == EOF)
-            return false;
-
-        std::string line;
-        std::getline(*m_istream, line);
-        lineOfFile++;
-        Utils::trim(line);
-        if (line.length() == 0)
+    while (m_pos < m_end)
+    {
+        const char *lineStart = m_pos;
+        const char *eol = static_cast<const char *>(
+            std::memchr(m_pos, '\n', m_end - m_pos));
+        const char *lineEnd = eol ? eol : m_end;
+        const char *p = lineStart;
+        m_pos = eol ? eol + 1 : m_end;
+        m_lineNum++;
+
+        std::string_view key = nextToken(p, lineEnd);
+        if (key.empty() || key == "#")
+        {
+            // Blank line or comment: Do nothing
             continue;
+        }
 
-        StringList fields = Utils::split2(line, ' ');
-        std::string key = fields[0];
-        if (key == "#")
+        // The line text is only materialized when reporting an error.
+        auto lineText = [lineStart, lineEnd]()
         {
-            // Comment: Do nothing
-        }
-        else if (key == "v")
+            std::string s(lineStart, lineEnd);
+            Utils::trim(s);
+            return s;
+        };
+
+        if (key == "v")
         {
             // Vertex
-            size_t numDims = fields.size() - 1;
-
-            auto throwVertexError = [this, line, lineOfFile]()
+            auto throwVertexError = [this, &lineText]()
             {
                 std::stringstream errorMessage;
                 errorMessage << "Could not convert vertex specification to double on line #"
-                    << lineOfFile << ": '" << line << "'" << std::endl;
-                throwError(errorMessage.str()); 
+                    << m_lineNum << ": '" << lineText() << "'" << std::endl;
+                throwError(errorMessage.str());
             };
 
-            if(numDims < 3) {
-                throwVertexError();
-            }
-            else if(numDims == 3) {
-                double x, y, z;
-                if (Utils::fromString(fields[1], x) && Utils::fromString(fields[2], y) &&
-                    Utils::fromString(fields[3], z))
-                    newVertex(x, y, z);
-                else
-                    throwVertexError();
-            }
-            else if(numDims > 3) {
-                double x, y, z, w;
-                if (Utils::fromString(fields[1], x) && Utils::fromString(fields[2], y) &&
-                    Utils::fromString(fields[3], z) && Utils::fromString(fields[4], w))
-                    newVertex(x, y, z, w);
-                else
+            double c[4];
+            size_t n = 0;
+            std::string_view t;
+            while (n < 4 && !(t = nextToken(p, lineEnd)).empty())
+            {
+                if (!parseDouble(t, c[n]))
                     throwVertexError();
+                n++;
             }
+            if (n < 3)
+                throwVertexError();
+            else if (n == 3)
+                newVertex(c[0], c[1], c[2]);
+            else
+                newVertex(c[0], c[1], c[2], c[3]);
         }
         else if (key == "vt")
         {
-            auto throwTextureError = [this, line, lineOfFile]()
+            auto throwTextureError = [this, &lineText]()
             {
                 std::stringstream ss;
                 ss << "Could not convert texture vertex specification to double on line #"
-                    << lineOfFile << ": '" << line << "'" << std::endl;
+                    << m_lineNum << ": '" << lineText() << "'" << std::endl;
                 throwError(ss.str());
             };
+
             // Vertex texture
-            if(fields.size() == 4) {
-                double x, y, z;
-                if (Utils::fromString(fields[1], x) && Utils::fromString(fields[2], y) &&
-                    Utils::fromString(fields[3], z))
-                    newTextureVertex( x, y, z );
-                else
-                    throwTextureError();
-            }
-            else if(fields.size() == 3) {
-                double x, y;
-                if (Utils::fromString(fields[1], x) && Utils::fromString(fields[2], y))
-                    newTextureVertex( x, y );
-                else
-                    throwTextureError();
+            std::string_view toks[3];
+            size_t n = 0;
+            std::string_view t;
+            while (!(t = nextToken(p, lineEnd)).empty())
+            {
+                if (n < 3)
+                    toks[n] = t;
+                n++;
             }
-            else if(fields.size() == 2) {
-                double x;
-                if (Utils::fromString(fields[1], x))
-                    newTextureVertex( x );
+            if (n >= 1 && n <= 3)
+            {
+                double c[3];
+                for (size_t i = 0; i < n; ++i)
+                    if (!parseDouble(toks[i], c[i]))
+                        throwTextureError();
+                if (n == 3)
+                    newTextureVertex( c[0], c[1], c[2] );
+                else if (n == 2)
+                    newTextureVertex( c[0], c[1] );
                 else
-                    throwTextureError();
+                    newTextureVertex( c[0] );
             }
-
         }
         else if (key == "vn")
         {
             // Vertex normal
             double x, y, z;
-            if (fields.size() >= 4 && Utils::fromString(fields[1], x) &&
-                Utils::fromString(fields[2], y) && Utils::fromString(fields[3], z))
+            std::string_view t1 = nextToken(p, lineEnd);
+            std::string_view t2 = nextToken(p, lineEnd);
+            std::string_view t3 = nextToken(p, lineEnd);
+            if (parseDouble(t1, x) && parseDouble(t2, y) &&
+                parseDouble(t3, z))
                 newNormalVertex( x, y, z );
             else
             {
                 std::stringstream ss;
                 ss << "Could not convert normal vertex specification to double on line #"
-                    << lineOfFile << ": '" << line << "'" << std::endl;
+                    << m_lineNum << ": '" << lineText() << "'" << std::endl;
                 throwError(ss.str());
             }
         }
         else if (key == "f")
         {
             // Face
-            if (fields.size() < 4)
+            std::vector<std::string_view> vertices;
+            std::string_view t;
+            while (!(t = nextToken(p, lineEnd)).empty())
+                vertices.push_back(t);
+            if (vertices.size() < 3)
                 throwError("Not enough vertices in face specification.");
-            StringList vertices(fields.begin() + 1, fields.end());
-            extractFace(vertices, face);
+            for (std::string_view v : vertices)
+                face.push_back(extractVertex(v));
             return true;
         }
     }
-}
-
-void ObjReader::extractFace(StringList fields, ObjReader::FACE& face)
-{
-    for (const std::string& field : fields)
-        face.push_back(extractVertex(field));
+    return false;
 }
 
 std::vector<ObjReader::TRI> ObjReader::triangulate(FACE face)
@@ -331,54 +380,44 @@ std::vector<ObjReader::TRI> ObjReader::triangulate(FACE face)
     return triangles;
 }
 
-ObjReader::VTN ObjReader::extractVertex(const std::string& vstring)
+ObjReader::VTN ObjReader::extractVertex(std::string_view vstring)
 {
     VTN vtn{ -1, -1, -1 };
-    std::string s(vstring);
-    Utils::trim(s);
-    StringList parts = Utils::split(s, '/');
-    for(auto& part : parts)
-        Utils::trim(part);
-
-    if (parts.size() > 3)
-        throwError("Too many items in vertex specification.");
-
-    char* p;
-    long index = std::strtol(parts[0].c_str(), &p, 10);
-    if (index == 0 || p != parts[0].c_str() + parts[0].size())
-        throwError("Invalid index in face specification.");
-    else if (index < 0)
-        std::get<0>(vtn) = m_vertices.size() - index;
-    else
-        std::get<0>(vtn) = index;
-
-    if (parts.size() > 1)
+
+    // Split on '/', keeping empty parts: "1//2" skips the texture index.
+    std::string_view parts[3];
+    size_t numParts = 0;
+    size_t start = 0;
+    for (size_t i = 0; i <= vstring.size(); ++i)
     {
-        if (parts[1].length() > 0)
+        if (i == vstring.size() || vstring[i] == '/')
         {
-            index = std::strtol(parts[1].c_str(), &p, 10);
-            if (index == 0 || p != parts[1].c_str() + parts[1].size())
-                throwError("Invalid index in face specification.");
-            else if(index < 0)
-                std::get<1>(vtn) = m_vertices.size() - index;
-            else
-                std::get<1>(vtn) = index;
+            if (numParts == 3)
+                throwError("Too many items in vertex specification.");
+            parts[numParts++] = vstring.substr(start, i - start);
+            start = i + 1;
         }
     }
 
-    if (parts.size() > 2)
+    auto parseIndex = [this](std::string_view part, int64_t& out)
     {
-        if (parts[2].length() > 0)
-        {
-            index = std::strtol(parts[2].c_str(), &p, 10);
-            if (index == 0 || p != parts[2].c_str() + parts[2].size())
-                throwError("Invalid index in face specification.");
-            else if(index < 0)
-                std::get<2>(vtn) = m_vertices.size() - index;
-            else
-                std::get<2>(vtn) = index;
-        }
-    }
+        long long index;
+        auto result =
+            std::from_chars(part.data(), part.data() + part.size(), index);
+        if (result.ec != std::errc() ||
+            result.ptr != part.data() + part.size() || index == 0)
+            throwError("Invalid index in face specification.");
+        else if (index < 0)
+            out = m_vertices.size() - index;
+        else
+            out = index;
+    };
+
+    parseIndex(parts[0], std::get<0>(vtn));
+    if (numParts > 1 && !parts[1].empty())
+        parseIndex(parts[1], std::get<1>(vtn));
+    if (numParts > 2 && !parts[2].empty())
+        parseIndex(parts[2], std::get<2>(vtn));
     return vtn;
 }
 
@@ -34,9 +34,10 @@
 
 #pragma once
 
-#include <istream>
-#include <map>
+#include <string>
+#include <string_view>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
 #include <pdal/Reader.hpp>
@@ -74,8 +75,29 @@ private:
     std::vector<XYZW> m_normalVertices;
     TriangularMesh *m_mesh;
     using VTN = std::tuple<int64_t, int64_t, int64_t>;
-    std::map<VTN, PointId> m_points;
-    std::istream *m_istream;
+
+    // The triplet-to-point lookup is the hot path when deduplicating
+    // face corners on large meshes, so use a flat hash of the indices
+    // rather than an ordered map.
+    struct VTNHash
+    {
+        std::size_t operator()(const VTN& vtn) const
+        {
+            uint64_t h = 0xcbf29ce484222325ULL;
+            for (uint64_t v : { (uint64_t)std::get<0>(vtn),
+                (uint64_t)std::get<1>(vtn), (uint64_t)std::get<2>(vtn) })
+            {
+                h ^= v;
+                h *= 0x100000001b3ULL;
+            }
+            return (std::size_t)h;
+        }
+    };
+    std::unordered_map<VTN, PointId, VTNHash> m_points;
+    std::string m_buffer;
+    const char *m_pos;
+    const char *m_end;
+    long long m_lineNum;
     point_count_t m_index;
 
     using TRI = std::array<VTN, 3>;
@@ -89,8 +111,7 @@ private:
     void newNormalVertex(double x, double y, double z);
     void newTriangle(PointViewPtr view, TRI tri);
     bool readFace(FACE& vertices, PointViewPtr view);
-    void extractFace(StringList fields, FACE& face);
-    VTN extractVertex(const std::string& vstring);
+    VTN extractVertex(std::string_view vstring);
     std::vector<TRI> triangulate(FACE face);
     PointId addPoint(PointViewPtr view, VTN vertex);
 };
@@ -142,7 +142,10 @@ void OptechReader::addDimensions(PointLayoutPtr layout)
 
 void OptechReader::ready(PointTableRef)
 {
-    m_istream.reset(new IStream(m_filename));
+    // Records are read in bulk, so use a large stream buffer and let the
+    // OS know the file will be read front to back.
+    IStream::readAhead(m_filename, m_header.headerSize);
+    m_istream.reset(new IStream(m_filename, 1024 * 1024));
     if (!*m_istream)
         throwError("Unable to open " + m_filename + " for reading.");
 
@@ -437,7 +437,7 @@ OLeStream& operator<<(OLeStream& out, PcdHeader& header)
         out.put("binary", 6);
         break;
     case PcdDataStorage::COMPRESSED:
-        out.put("compressed", 10);
+        out.put("binary_compressed", 17);
         break;
     case PcdDataStorage::unknown:
     default:
@@ -34,6 +34,9 @@
 
 #include <pdal/PDALUtils.hpp>
 #include <pdal/util/Algorithm.hpp>
+#include <pdal/util/Extractor.hpp>
+
+#include <cstring>
 
 #include "PcdHeader.hpp"
 #include "PcdReader.hpp"
@@ -41,6 +44,80 @@
 namespace pdal
 {
 
+namespace
+{
+
+// Size of a block of binary point data read at once.
+const size_t readBufSize = 1024 * 1024;
+
+bool hostIsLittleEndian()
+{
+    uint16_t probe = 1;
+    return *(reinterpret_cast<const char *>(&probe)) == 1;
+}
+
+// Map a PCD field to the type it's stored as in the file.
+Dimension::Type fieldType(const PcdField& field)
+{
+    Dimension::BaseType base = Dimension::BaseType::None;
+    if (field.m_type == PcdFieldType::U)
+        base = Dimension::BaseType::Unsigned;
+    else if (field.m_type == PcdFieldType::I)
+        base = Dimension::BaseType::Signed;
+    else if (field.m_type == PcdFieldType::F)
+        base = Dimension::BaseType::Floating;
+    return static_cast<Dimension::Type>(unsigned(base) | field.m_size);
+}
+
+// Decompress an LZF-encoded block as used by PCD binary_compressed data.
+// Returns the number of bytes decoded, or 0 on malformed input.
+size_t lzfDecompress(const char *in, size_t inLen, char *out, size_t outLen)
+{
+    const unsigned char *ip = reinterpret_cast<const unsigned char *>(in);
+    const unsigned char *const ipEnd = ip + inLen;
+    unsigned char *op = reinterpret_cast<unsigned char *>(out);
+    unsigned char *const opBegin = op;
+    unsigned char *const opEnd = op + outLen;
+
+    while (ip < ipEnd)
+    {
+        unsigned ctrl = *ip++;
+        if (ctrl < (1 << 5))
+        {
+            // Literal run of ctrl + 1 bytes.
+            ctrl++;
+            if (ip + ctrl > ipEnd || op + ctrl > opEnd)
+                return 0;
+            std::memcpy(op, ip, ctrl);
+            op += ctrl;
+            ip += ctrl;
+        }
+        else
+        {
+            // Back reference.
+            unsigned len = ctrl >> 5;
+            unsigned char *ref = op - ((ctrl & 0x1f) << 8) - 1;
+            if (len == 7)
+            {
+                if (ip >= ipEnd)
+                    return 0;
+                len += *ip++;
+            }
+            if (ip >= ipEnd)
+                return 0;
+            ref -= *ip++;
+            len += 2;
+            if (ref < opBegin || op + len > opEnd)
+                return 0;
+            while (len--)
+                *op++ = *ref++;
+        }
+    }
+    return op - opBegin;
+}
+
+} // unnamed namespace
+
 static StaticPluginInfo const s_info
 {
     "readers.pcd",
@@ -76,6 +153,7 @@ QuickInfo PcdReader::inspect()
 void PcdReader::ready(PointTableRef table)
 {
     m_index = 0;
+    m_fastBinary = false;
     switch (m_header.m_dataStorage)
     {
     case PcdDataStorage::ASCII:
@@ -90,9 +168,40 @@ void PcdReader::ready(PointTableRef table)
             throwError("Unable to open binary PCD file '" + m_filename + "'.");
         m_stream = ILeStream(m_istreamPtr);
         m_stream.seek(m_header.m_dataOffset);
+
+        // Single-value fields make each point a fixed-size row that can
+        // be read in blocks and transferred as packed dimension data.
+        {
+            m_rowDims.clear();
+            m_rowSize = 0;
+            bool simple = true;
+            size_t j = 0;
+            for (auto const& f : m_header.m_fields)
+            {
+                if (f.m_count != 1)
+                {
+                    simple = false;
+                    break;
+                }
+                m_rowDims.push_back(DimType(m_dims[j++], fieldType(f)));
+                m_rowSize += f.m_size;
+            }
+            if (simple && m_rowSize)
+            {
+                m_fastBinary = true;
+                size_t rows = (std::max)((size_t)1, readBufSize / m_rowSize);
+                m_readBuf.resize(rows * m_rowSize);
+                m_readPos = 0;
+                m_readEnd = 0;
+            }
+        }
         break;
     case PcdDataStorage::COMPRESSED:
-        throwError("Binary compressed PCD is not supported at this time.");
+        m_istreamPtr = Utils::openFile(m_filename, true);
+        if (!m_istreamPtr)
+            throwError("Unable to open binary_compressed PCD file '" +
+                m_filename + "'.");
+        readCompressedData();
         break;
     case PcdDataStorage::unknown:
     default:
@@ -100,6 +209,66 @@ void PcdReader::ready(PointTableRef table)
     }
 }
 
+
+// binary_compressed data is a compressed-size/decompressed-size pair
+// followed by an LZF-compressed block holding the data field-major -
+// all values for the first field, then all values for the second.
+void PcdReader::readCompressedData()
+{
+    ILeStream in(m_istreamPtr);
+    in.seek(m_header.m_dataOffset);
+
+    uint32_t compressedSize;
+    uint32_t decompressedSize;
+    in >> compressedSize >> decompressedSize;
+    if (!in.good())
+        throwError("Couldn't read binary_compressed sizes from '" +
+            m_filename + "'.");
+
+    std::vector<char> compressed(compressedSize);
+    in.get(compressed);
+    if (!in.good())
+        throwError("Couldn't read binary_compressed data from '" +
+            m_filename + "'.");
+
+    m_decoded.resize(decompressedSize);
+    if (lzfDecompress(compressed.data(), compressed.size(),
+        m_decoded.data(), m_decoded.size()) != decompressedSize)
+        throwError("Error decompressing binary_compressed data in '" +
+            m_filename + "'.");
+
+    m_fieldInfo.clear();
+    size_t offset = 0;
+    size_t j = 0;
+    for (auto const& f : m_header.m_fields)
+    {
+        FieldInfo fi;
+        fi.m_id = m_dims[j++];
+        fi.m_type = fieldType(f);
+        fi.m_stride = (size_t)f.m_size * f.m_count;
+        fi.m_offset = offset;
+        offset += fi.m_stride * (size_t)m_header.m_pointCount;
+        m_fieldInfo.push_back(fi);
+    }
+    if (offset > m_decoded.size())
+        throwError("binary_compressed data in '" + m_filename +
+            "' is smaller than the header implies.");
+}
+
+
+bool PcdReader::fillReadBuf()
+{
+    size_t rowsLeft = (size_t)m_header.m_pointCount - (size_t)m_index;
+    size_t rows = (std::min)(rowsLeft, m_readBuf.size() / m_rowSize);
+
+    m_istreamPtr->read(m_readBuf.data(), rows * m_rowSize);
+    size_t cnt = (size_t)m_istreamPtr->gcount();
+    m_readPos = 0;
+    // A partial trailing row indicates a truncated file - don't use it.
+    m_readEnd = cnt - (cnt % m_rowSize);
+    return m_readEnd != 0;
+}
+
 void PcdReader::addDimensions(PointLayoutPtr layout)
 {
     m_dims.clear();
@@ -179,42 +348,78 @@ bool PcdReader::processOne(PointRef& point)
         }
         return true;
     case PcdDataStorage::BINARY:
-        if (!m_stream.good())
-            return false;
-
         if ((m_index >= m_count) ||
             (m_index >= (point_count_t)m_header.m_pointCount))
             return false;
 
-        for (auto const& i : m_header.m_fields)
+        if (m_fastBinary)
+        {
+            if (m_readPos == m_readEnd && !fillReadBuf())
+                return false;
+            const char *row = m_readBuf.data() + m_readPos;
+            m_readPos += m_rowSize;
+
+            // A little-endian row on a little-endian host is already
+            // packed dimension data.
+            if (hostIsLittleEndian())
+                point.setPackedData(m_rowDims, row);
+            else
+            {
+                LeExtractor in(row, m_rowSize);
+                for (const DimType& dt : m_rowDims)
+                {
+                    Everything e = Utils::extractDim(in, dt.m_type);
+                    point.setField(dt.m_id, dt.m_type, &e);
+                }
+            }
+        }
+        else
         {
-            switch (i.m_type)
+            if (!m_stream.good())
+                return false;
+
+            for (auto const& i : m_header.m_fields)
             {
-            case PcdFieldType::I:
-                int32_t ival;
-                m_stream >> ival;
-                point.setField(i.m_id, ival);
-                break;
-            case PcdFieldType::F:
-                float fval;
-                m_stream >> fval;
-                point.setField(i.m_id, fval);
-                break;
-            case PcdFieldType::U:
-                uint32_t uval;
-                m_stream >> uval;
-                point.setField(i.m_id, uval);
-                break;
-            case PcdFieldType::unknown:
-            default:
-                throwError("Unsupported field type.");
+                switch (i.m_type)
+                {
+                case PcdFieldType::I:
+                    int32_t ival;
+                    m_stream >> ival;
+                    point.setField(i.m_id, ival);
+                    break;
+                case PcdFieldType::F:
+                    float fval;
+                    m_stream >> fval;
+                    point.setField(i.m_id, fval);
+                    break;
+                case PcdFieldType::U:
+                    uint32_t uval;
+                    m_stream >> uval;
+                    point.setField(i.m_id, uval);
+                    break;
+                case PcdFieldType::unknown:
+                default:
+                    throwError("Unsupported field type.");
+                }
             }
         }
         m_index++;
         return true;
     case PcdDataStorage::COMPRESSED:
-        throwError("Binary compressed PCD is not supported at this time.");
-        return false;
+        if ((m_index >= m_count) ||
+            (m_index >= (point_count_t)m_header.m_pointCount))
+            return false;
+
+        for (const FieldInfo& fi : m_fieldInfo)
+        {
+            const char *p = m_decoded.data() + fi.m_offset +
+                (size_t)m_index * fi.m_stride;
+            LeExtractor in(p, fi.m_stride);
+            Everything e = Utils::extractDim(in, fi.m_type);
+            point.setField(fi.m_id, fi.m_type, &e);
+        }
+        m_index++;
+        return true;
     case PcdDataStorage::unknown:
     default:
         throwError("Unrecognized data storage.");
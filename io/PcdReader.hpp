@@ -34,6 +34,7 @@
 
 #pragma once
 
+#include <pdal/DimType.hpp>
 #include <pdal/Reader.hpp>
 #include <pdal/Streamable.hpp>
 #include <pdal/util/IStream.hpp>
@@ -59,6 +60,17 @@ private:
     virtual void done(PointTableRef table);
     virtual bool processOne(PointRef& point);
     bool fillFields();
+    bool fillReadBuf();
+    void readCompressedData();
+
+    // Per-field file layout, computed in ready().
+    struct FieldInfo
+    {
+        Dimension::Id m_id;
+        Dimension::Type m_type;
+        size_t m_stride;    // Bytes per point for this field.
+        size_t m_offset;    // Byte offset of this field's column.
+    };
 
     PcdHeader m_header;
     std::istream* m_istreamPtr;
@@ -67,6 +79,18 @@ private:
     StringList m_fields;
     point_count_t m_index;
     size_t m_line;
+
+    // Binary fast path - valid when every field holds a single value.
+    bool m_fastBinary;
+    DimTypeList m_rowDims;
+    size_t m_rowSize;
+    std::vector<char> m_readBuf;
+    size_t m_readPos;
+    size_t m_readEnd;
+
+    // binary_compressed support - whole file decoded up front.
+    std::vector<FieldInfo> m_fieldInfo;
+    std::vector<char> m_decoded;
 };
 
 } // namespace pdal
@@ -44,6 +44,99 @@ namespace pdal
 
 using namespace Dimension;
 
+namespace
+{
+
+// Compress a block with LZF as used by PCD binary_compressed data,
+// matching the decoder in PcdReader.  Returns the number of bytes
+// written, or 0 if the output buffer is too small.
+size_t lzfCompress(const char *inp, size_t inLen, char *outp, size_t outLen)
+{
+    const unsigned char *in = reinterpret_cast<const unsigned char *>(inp);
+    unsigned char *out = reinterpret_cast<unsigned char *>(outp);
+    unsigned char *const outBegin = out;
+    unsigned char *const outEnd = out + outLen;
+
+    const size_t hashBits = 14;
+    std::vector<size_t> htab(size_t(1) << hashBits, SIZE_MAX);
+    auto hash = [&](size_t i)
+    {
+        unsigned v = (in[i] << 16) | (in[i + 1] << 8) | in[i + 2];
+        return ((v >> (24 - hashBits)) - v * 5) & ((1 << hashBits) - 1);
+    };
+
+    size_t i = 0;
+    size_t lit = 0;  // Start of the pending literal run.
+
+    auto flushLiterals = [&](size_t end) -> bool
+    {
+        while (lit < end)
+        {
+            size_t run = (std::min)(end - lit, (size_t)32);
+            if (out + 1 + run > outEnd)
+                return false;
+            *out++ = (unsigned char)(run - 1);
+            std::memcpy(out, in + lit, run);
+            out += run;
+            lit += run;
+        }
+        return true;
+    };
+
+    while (i + 2 < inLen)
+    {
+        size_t h = hash(i);
+        size_t ref = htab[h];
+        htab[h] = i;
+
+        if (ref != SIZE_MAX && i - ref <= (size_t(1) << 13) &&
+            in[ref] == in[i] && in[ref + 1] == in[i + 1] &&
+            in[ref + 2] == in[i + 2])
+        {
+            // Extend the match as far as the format allows.
+            size_t maxLen = (std::min)(inLen - i, (size_t)264);
+            size_t len = 3;
+            while (len < maxLen && in[ref + len] == in[i + len])
+                len++;
+
+            if (!flushLiterals(i))
+                return 0;
+
+            size_t off = i - ref - 1;
+            size_t encLen = len - 2;
+            if (encLen < 7)
+            {
+                if (out + 2 > outEnd)
+                    return 0;
+                *out++ = (unsigned char)((encLen << 5) | (off >> 8));
+            }
+            else
+            {
+                if (out + 3 > outEnd)
+                    return 0;
+                *out++ = (unsigned char)((7 << 5) | (off >> 8));
+                *out++ = (unsigned char)(encLen - 7);
+            }
+            *out++ = (unsigned char)(off & 0xff);
+
+            // Hash positions inside the match so later data can refer
+            // back into it.
+            size_t stop = (std::min)(i + len, inLen - 2);
+            for (size_t j = i + 1; j < stop; ++j)
+                htab[hash(j)] = j;
+            i += len;
+            lit = i;
+        }
+        else
+            i++;
+    }
+    if (!flushLiterals(inLen))
+        return 0;
+    return out - outBegin;
+}
+
+} // unnamed namespace
+
 static StaticPluginInfo const s_info
 {
     "writers.pcd",
@@ -250,16 +343,141 @@ void PcdWriter::ready(PointTableRef table)
     }
 }
 
+// binary_compressed data is a single LZF block of field-major data for
+// the whole cloud, so views are buffered columnar here and the file is
+// written in done().
+void PcdWriter::appendCompressed(const PointViewPtr view)
+{
+    if (m_fieldBufs.empty())
+        m_fieldBufs.resize(m_dims.size());
+
+    PointRef point(*view, 0);
+    for (size_t d = 0; d < m_dims.size(); ++d)
+    {
+        const DimSpec& di = m_dims[d];
+        std::vector<char>& buf = m_fieldBufs[d];
+        auto put = [&buf](const void *p, size_t size)
+        {
+            const char *c = reinterpret_cast<const char *>(p);
+            buf.insert(buf.end(), c, c + size);
+        };
+
+        for (PointId idx = 0; idx < view->size(); ++idx)
+        {
+            point.setPointId(idx);
+            if (di.m_field.m_type == PcdFieldType::F &&
+                di.m_field.m_size == 8)
+            {
+                double v = point.getFieldAs<double>(di.m_field.m_id);
+                put(&v, sizeof(v));
+            }
+            else if (di.m_field.m_type == PcdFieldType::F &&
+                di.m_field.m_size == 4)
+            {
+                float v = point.getFieldAs<float>(di.m_field.m_id);
+                put(&v, sizeof(v));
+            }
+            else if (di.m_field.m_type == PcdFieldType::U &&
+                di.m_field.m_size == 8)
+            {
+                uint64_t v = point.getFieldAs<uint64_t>(di.m_field.m_id);
+                put(&v, sizeof(v));
+            }
+            else if (di.m_field.m_type == PcdFieldType::U &&
+                di.m_field.m_size == 4)
+            {
+                uint32_t v = point.getFieldAs<uint32_t>(di.m_field.m_id);
+                put(&v, sizeof(v));
+            }
+            else if (di.m_field.m_type == PcdFieldType::U &&
+                di.m_field.m_size == 2)
+            {
+                uint16_t v = point.getFieldAs<uint16_t>(di.m_field.m_id);
+                put(&v, sizeof(v));
+            }
+            else if (di.m_field.m_type == PcdFieldType::U &&
+                di.m_field.m_size == 1)
+            {
+                uint8_t v = point.getFieldAs<uint8_t>(di.m_field.m_id);
+                put(&v, sizeof(v));
+            }
+            else if (di.m_field.m_type == PcdFieldType::I &&
+                di.m_field.m_size == 8)
+            {
+                int64_t v = point.getFieldAs<int64_t>(di.m_field.m_id);
+                put(&v, sizeof(v));
+            }
+            else if (di.m_field.m_type == PcdFieldType::I &&
+                di.m_field.m_size == 4)
+            {
+                int32_t v = point.getFieldAs<int32_t>(di.m_field.m_id);
+                put(&v, sizeof(v));
+            }
+            else if (di.m_field.m_type == PcdFieldType::I &&
+                di.m_field.m_size == 2)
+            {
+                int16_t v = point.getFieldAs<int16_t>(di.m_field.m_id);
+                put(&v, sizeof(v));
+            }
+            else if (di.m_field.m_type == PcdFieldType::I &&
+                di.m_field.m_size == 1)
+            {
+                int8_t v = point.getFieldAs<int8_t>(di.m_field.m_id);
+                put(&v, sizeof(v));
+            }
+        }
+    }
+    m_compressedPoints += view->size();
+}
+
+
+void PcdWriter::writeCompressed()
+{
+    m_header.m_version = PcdVersion::PCD_V7;
+    m_header.m_height = 1;
+    m_header.m_dataStorage = PcdDataStorage::COMPRESSED;
+    for (auto di = m_dims.begin(); di != m_dims.end(); ++di)
+        m_header.m_fields.push_back(di->m_field);
+    m_header.m_width = m_compressedPoints;
+    m_header.m_pointCount = m_compressedPoints;
+    *m_ostream << m_header;
+
+    size_t raw = 0;
+    for (const std::vector<char>& buf : m_fieldBufs)
+        raw += buf.size();
+    std::vector<char> data;
+    data.reserve(raw);
+    for (const std::vector<char>& buf : m_fieldBufs)
+        data.insert(data.end(), buf.begin(), buf.end());
+
+    // Worst-case LZF growth is one control byte per 32 literals.
+    std::vector<char> compressed(raw + raw / 32 + 64);
+    size_t size = raw ?
+        lzfCompress(data.data(), raw, compressed.data(),
+            compressed.size()) : 0;
+    if (raw && size == 0)
+        throwError("Couldn't compress binary_compressed data.");
+
+    OLeStream out(m_ostream);
+    out << (uint32_t)size << (uint32_t)raw;
+    m_ostream->write(compressed.data(), size);
+}
+
+
 void PcdWriter::write(const PointViewPtr view)
 {
+    if (m_compression_string == "compressed")
+    {
+        appendCompressed(view);
+        return;
+    }
+
     m_header.m_version = PcdVersion::PCD_V7;
     m_header.m_height = 1;
     if (m_compression_string == "ascii")
         m_header.m_dataStorage = PcdDataStorage::ASCII;
     else if (m_compression_string == "binary")
         m_header.m_dataStorage = PcdDataStorage::BINARY;
-    else if (m_compression_string == "compressed")
-        m_header.m_dataStorage = PcdDataStorage::COMPRESSED;
     else
         throwError("Unrecognized compression string");
 
@@ -378,6 +596,8 @@ void PcdWriter::write(const PointViewPtr view)
 
 void PcdWriter::done(PointTableRef table)
 {
+    if (m_compression_string == "compressed")
+        writeCompressed();
     Utils::closeFile(m_ostream);
     m_ostream = nullptr;
     getMetadata().addList("filename", m_filename);
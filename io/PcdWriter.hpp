@@ -74,6 +74,8 @@ private:
 
     DimSpec extractDim(std::string dim, PointTableRef table);
     bool findDim(Dimension::Id id, DimSpec& ds);
+    void appendCompressed(const PointViewPtr view);
+    void writeCompressed();
 
     PcdHeader m_header;
     std::ostream* m_ostream;
@@ -84,6 +86,9 @@ private:
     uint32_t m_precision;
 
     std::vector<DimSpec> m_dims;
+    // Field-major data buffered for binary_compressed output.
+    std::vector<std::vector<char>> m_fieldBufs;
+    point_count_t m_compressedPoints = 0;
     DimSpec m_xDim;
     DimSpec m_yDim;
     DimSpec m_zDim;
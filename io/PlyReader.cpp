@@ -38,11 +38,24 @@
 
 #include <pdal/PDALUtils.hpp>
 #include <pdal/PointView.hpp>
+#include <pdal/util/Extractor.hpp>
 #include <pdal/util/IStream.hpp>
 
 namespace pdal
 {
 
+namespace
+{
+    // Size of a block of binary vertex data read at once.
+    const size_t readBufSize = 1024 * 1024;
+
+    bool hostIsLittleEndian()
+    {
+        uint16_t probe = 1;
+        return *(reinterpret_cast<const char *>(&probe)) == 1;
+    }
+}
+
 static StaticPluginInfo const s_info
 {
         "readers.ply",
@@ -58,6 +71,26 @@ PlyReader::PlyReader() : m_vertexElt(nullptr)
 {}
 
 
+// Only the header is read - the vertex element carries the point count and
+// the property list, but PLY stores no bounds.
+QuickInfo PlyReader::inspect()
+{
+    QuickInfo qi;
+
+    initialize();
+
+    for (const Element& elt : m_elements)
+        if (elt.m_name == "vertex")
+        {
+            qi.m_pointCount = elt.m_count;
+            for (auto& prop : elt.m_properties)
+                qi.m_dimNames.push_back(prop->m_name);
+        }
+    qi.m_valid = true;
+    return qi;
+}
+
+
 std::string PlyReader::readLine()
 {
     m_line.clear();
@@ -432,18 +465,96 @@ void PlyReader::ready(PointTableRef table)
             readElement(elt, point);
     }
     m_index = 0;
+
+    // Binary vertex data with only simple properties is a sequence of
+    // fixed-size rows that can be read in blocks and transferred as
+    // packed dimension data rather than value by value.
+    m_fastPath = false;
+    m_rawRows = false;
+    if (m_format != Format::Ascii)
+    {
+        m_vertexDims.clear();
+        m_vertexSize = 0;
+        bool simple = true;
+        for (auto& prop : m_vertexElt->m_properties)
+        {
+            auto sp = dynamic_cast<SimpleProperty *>(prop.get());
+            if (!sp)
+            {
+                simple = false;
+                break;
+            }
+            m_vertexDims.push_back(DimType(sp->m_dim, sp->m_type));
+            m_vertexSize += Dimension::size(sp->m_type);
+        }
+        if (simple && m_vertexSize)
+        {
+            m_fastPath = true;
+            // A little-endian file on a little-endian host needs no
+            // conversion at all - rows are already packed dimension data.
+            m_rawRows = (m_format == Format::BinaryLe) &&
+                hostIsLittleEndian();
+            size_t rows = (std::max)((size_t)1, readBufSize / m_vertexSize);
+            m_readBuf.resize(rows * m_vertexSize);
+            m_readPos = 0;
+            m_readEnd = 0;
+        }
+    }
+}
+
+
+bool PlyReader::fillReadBuf()
+{
+    size_t rowsLeft = m_vertexElt->m_count - m_index;
+    size_t rows = (std::min)(rowsLeft, m_readBuf.size() / m_vertexSize);
+
+    m_stream->read(m_readBuf.data(), rows * m_vertexSize);
+    size_t cnt = (size_t)m_stream->gcount();
+    m_readPos = 0;
+    // A partial trailing row indicates a truncated file - don't use it.
+    m_readEnd = cnt - (cnt % m_vertexSize);
+    return m_readEnd != 0;
 }
 
 
 bool PlyReader::processOne(PointRef& point)
 {
-    if (m_index < m_vertexElt->m_count)
+    if (m_index >= m_vertexElt->m_count)
+        return false;
+
+    if (m_fastPath)
     {
-        readElement(*m_vertexElt, point);
-        m_index++;
-        return true;
+        if (m_readPos == m_readEnd && !fillReadBuf())
+            throwError("Error reading data for point/element " +
+                std::to_string(point.pointId()) + ".");
+        const char *row = m_readBuf.data() + m_readPos;
+        m_readPos += m_vertexSize;
+
+        if (m_rawRows)
+            point.setPackedData(m_vertexDims, row);
+        else if (m_format == Format::BinaryLe)
+        {
+            LeExtractor in(row, m_vertexSize);
+            for (const DimType& dt : m_vertexDims)
+            {
+                Everything e = Utils::extractDim(in, dt.m_type);
+                point.setField(dt.m_id, dt.m_type, &e);
+            }
+        }
+        else
+        {
+            BeExtractor in(row, m_vertexSize);
+            for (const DimType& dt : m_vertexDims)
+            {
+                Everything e = Utils::extractDim(in, dt.m_type);
+                point.setField(dt.m_id, dt.m_type, &e);
+            }
+        }
     }
-    return false;
+    else
+        readElement(*m_vertexElt, point);
+    m_index++;
+    return true;
 }
 
 
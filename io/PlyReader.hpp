@@ -38,6 +38,7 @@
 #include <stack>
 
 #include <pdal/Dimension.hpp>
+#include <pdal/DimType.hpp>
 #include <pdal/Reader.hpp>
 #include <pdal/StageFactory.hpp>
 #include <pdal/Streamable.hpp>
@@ -127,6 +128,16 @@ private:
     PointId m_index;
     Element *m_vertexElt;
 
+    // Binary fast path - valid when every vertex property is simple.
+    bool m_fastPath;
+    bool m_rawRows;
+    DimTypeList m_vertexDims;
+    size_t m_vertexSize;
+    std::vector<char> m_readBuf;
+    size_t m_readPos;
+    size_t m_readEnd;
+
+    virtual QuickInfo inspect();
     virtual void initialize();
     virtual void addDimensions(PointLayoutPtr layout);
     virtual void ready(PointTableRef table);
@@ -147,6 +158,7 @@ private:
     void extractHeader();
     void readElement(Element& elt, PointRef& point);
     bool readProperty(Property *prop, PointRef& point);
+    bool fillReadBuf();
 };
 
 } // namespace pdal
@@ -37,12 +37,25 @@
 #include <limits>
 #include <sstream>
 
+#include <pdal/util/Inserter.hpp>
 #include <pdal/util/OStream.hpp>
 #include <pdal/util/ProgramArgs.hpp>
 
 namespace pdal
 {
 
+namespace
+{
+    // Size of a block of binary vertex data written at once.
+    const size_t writeBufSize = 1024 * 1024;
+
+    bool hostIsLittleEndian()
+    {
+        uint16_t probe = 1;
+        return *(reinterpret_cast<const char *>(&probe)) == 1;
+    }
+}
+
 static StaticPluginInfo const s_info
 {
         "writers.ply",
@@ -314,6 +327,62 @@ void PlyWriter::writePoint(PointRef& point, PointLayoutPtr layout)
 }
 
 
+// Binary vertex data is a sequence of fixed-size rows - assemble them in
+// a block buffer and write the block at once.  On a little-endian host a
+// little-endian row is just packed dimension data; otherwise each value
+// is placed through an endian-converting inserter.
+void PlyWriter::writeBinaryPoints(const PointViewPtr& v)
+{
+    size_t rowSize = 0;
+    for (const DimType& dt : m_dims)
+        rowSize += Dimension::size(dt.m_type);
+    if (rowSize == 0)
+        return;
+
+    bool rawRows = (m_format == Format::BinaryLe) && hostIsLittleEndian();
+    size_t rows = (std::max)((size_t)1, writeBufSize / rowSize);
+    std::vector<char> buf(rows * rowSize);
+
+    PointRef point(*v, 0);
+    size_t pos = 0;
+    for (PointId idx = 0; idx < v->size(); ++idx)
+    {
+        point.setPointId(idx);
+        char *row = buf.data() + pos;
+        if (rawRows)
+            point.getPackedData(m_dims, row);
+        else if (m_format == Format::BinaryLe)
+        {
+            LeInserter ins(row, rowSize);
+            for (const DimType& dt : m_dims)
+            {
+                Everything e;
+                point.getField((char *)&e, dt.m_id, dt.m_type);
+                Utils::insertDim(ins, dt.m_type, e);
+            }
+        }
+        else
+        {
+            BeInserter ins(row, rowSize);
+            for (const DimType& dt : m_dims)
+            {
+                Everything e;
+                point.getField((char *)&e, dt.m_id, dt.m_type);
+                Utils::insertDim(ins, dt.m_type, e);
+            }
+        }
+        pos += rowSize;
+        if (pos == buf.size())
+        {
+            m_stream->write(buf.data(), pos);
+            pos = 0;
+        }
+    }
+    if (pos)
+        m_stream->write(buf.data(), pos);
+}
+
+
 void PlyWriter::writeTriangle(const Triangle& t, size_t offset)
 {
     if (m_format == Format::Ascii)
@@ -348,11 +417,16 @@ void PlyWriter::done(PointTableRef table)
 {
     for (auto& v : m_views)
     {
-        PointRef point(*v, 0);
-        for (PointId idx = 0; idx < v->size(); ++idx)
+        if (m_format != Format::Ascii)
+            writeBinaryPoints(v);
+        else
         {
-            point.setPointId(idx);
-            writePoint(point, table.layout());
+            PointRef point(*v, 0);
+            for (PointId idx = 0; idx < v->size(); ++idx)
+            {
+                point.setPointId(idx);
+                writePoint(point, table.layout());
+            }
         }
     }
     if (m_faces)
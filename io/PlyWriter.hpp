@@ -65,6 +65,7 @@ private:
     void writeHeader(PointLayoutPtr layout) const;
     void writeValue(PointRef& point, Dimension::Id dim, Dimension::Type type);
     void writePoint(PointRef& point, PointLayoutPtr layout);
+    void writeBinaryPoints(const PointViewPtr& v);
     void writeTriangle(const Triangle& t, size_t offset);
 
     std::ostream *m_stream;
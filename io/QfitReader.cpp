@@ -167,7 +167,6 @@ Word #       Content
 #include "QfitReader.hpp"
 
 #include <pdal/PointView.hpp>
-#include <pdal/util/Extractor.hpp>
 #include <pdal/util/portable_endian.hpp>
 #include <pdal/util/ProgramArgs.hpp>
 
@@ -328,75 +327,100 @@ point_count_t QfitReader::read(PointViewPtr data, point_count_t count)
         throwError("End of file detected.");
 
     count = (std::min)(m_numPoints - m_index, count);
-    std::vector<char> buf(m_size);
+
+    // Records are all 32-bit words, so they're decoded in blocks: one
+    // stream read per block, one byte-swapping pass when the file is
+    // big-endian and then one strided pass per dimension over the block.
+    // The last word of each record (packed GPS time-of-day) is dropped,
+    // as it was in the record-at-a-time decode.
+    const point_count_t BlockPoints = 65536;
+    const size_t words = m_size / sizeof(int32_t);
+
+    std::vector<int32_t> buf;
     PointId nextId = data->size();
-    point_count_t numRead = 0;
-    while (count--)
+    point_count_t remaining = count;
+    while (remaining)
     {
-        m_istream->get(buf);
-        SwitchableExtractor extractor(buf.data(), m_size, m_littleEndian);
-
-        // always read the base fields
+        point_count_t n = (std::min)(remaining, BlockPoints);
+        buf.resize(n * words);
+        m_istream->get(reinterpret_cast<char *>(buf.data()), n * m_size);
+
+        if (!m_littleEndian)
+            for (size_t i = 0; i < n * words; ++i)
+                buf[i] = (int32_t)be32toh((uint32_t)buf[i]);
+
+        auto word = [&buf, words](point_count_t i, size_t field)
+        { return buf[i * words + field]; };
+
+        for (point_count_t i = 0; i < n; ++i)
+            data->setField(Dimension::Id::OffsetTime, nextId + i, word(i, 0));
+        for (point_count_t i = 0; i < n; ++i)
+            data->setField(Dimension::Id::Y, nextId + i,
+                word(i, 1) / 1000000.0);
+        for (point_count_t i = 0; i < n; ++i)
         {
-            int32_t time, y, xi, z, start_pulse, reflected_pulse, scan_angle,
-                pitch, roll;
-            extractor >> time >> y >> xi >> z >> start_pulse >>
-                reflected_pulse >> scan_angle >> pitch >> roll;
-            double x = xi / 1000000.0;
+            double x = word(i, 2) / 1000000.0;
             if (m_flip_x && x > 180)
                 x -= 360;
-
-            data->setField(Dimension::Id::OffsetTime, nextId, time);
-            data->setField(Dimension::Id::Y, nextId, y / 1000000.0);
-            data->setField(Dimension::Id::X, nextId, x);
-            data->setField(Dimension::Id::Z, nextId, z * m_scale_z);
-            data->setField(Dimension::Id::StartPulse, nextId, start_pulse);
-            data->setField(Dimension::Id::ReflectedPulse, nextId,
-                reflected_pulse);
-            data->setField(Dimension::Id::Azimuth, nextId,
-                scan_angle / 1000.0);
-            data->setField(Dimension::Id::Pitch, nextId, pitch / 1000.0);
-            data->setField(Dimension::Id::Roll, nextId, roll / 1000.0);
+            data->setField(Dimension::Id::X, nextId + i, x);
         }
+        for (point_count_t i = 0; i < n; ++i)
+            data->setField(Dimension::Id::Z, nextId + i,
+                word(i, 3) * m_scale_z);
+        for (point_count_t i = 0; i < n; ++i)
+            data->setField(Dimension::Id::StartPulse, nextId + i, word(i, 4));
+        for (point_count_t i = 0; i < n; ++i)
+            data->setField(Dimension::Id::ReflectedPulse, nextId + i,
+                word(i, 5));
+        for (point_count_t i = 0; i < n; ++i)
+            data->setField(Dimension::Id::Azimuth, nextId + i,
+                word(i, 6) / 1000.0);
+        for (point_count_t i = 0; i < n; ++i)
+            data->setField(Dimension::Id::Pitch, nextId + i,
+                word(i, 7) / 1000.0);
+        for (point_count_t i = 0; i < n; ++i)
+            data->setField(Dimension::Id::Roll, nextId + i,
+                word(i, 8) / 1000.0);
 
         if (m_format == QFIT_Format_12)
         {
-            int32_t pdop, pulse_width;
-            extractor >> pdop >> pulse_width;
-            data->setField(Dimension::Id::Pdop, nextId, pdop / 10.0);
-            data->setField(Dimension::Id::PulseWidth, nextId, pulse_width);
+            for (point_count_t i = 0; i < n; ++i)
+                data->setField(Dimension::Id::Pdop, nextId + i,
+                    word(i, 9) / 10.0);
+            for (point_count_t i = 0; i < n; ++i)
+                data->setField(Dimension::Id::PulseWidth, nextId + i,
+                    word(i, 10));
         }
         else if (m_format == QFIT_Format_14)
         {
-            int32_t passive_signal, passive_y, passive_x, passive_z;
-            extractor >> passive_signal >> passive_y >> passive_x >> passive_z;
-            double x = passive_x / 1000000.0;
-            if (m_flip_x && x > 180)
-                x -= 360;
-            data->setField(Dimension::Id::PassiveSignal, nextId, passive_signal);
-            data->setField(Dimension::Id::PassiveY, nextId,
-                passive_y / 1000000.0);
-            data->setField(Dimension::Id::PassiveX, nextId, x);
-            data->setField(Dimension::Id::PassiveZ, nextId,
-                passive_z * m_scale_z);
+            for (point_count_t i = 0; i < n; ++i)
+                data->setField(Dimension::Id::PassiveSignal, nextId + i,
+                    word(i, 9));
+            for (point_count_t i = 0; i < n; ++i)
+                data->setField(Dimension::Id::PassiveY, nextId + i,
+                    word(i, 10) / 1000000.0);
+            for (point_count_t i = 0; i < n; ++i)
+            {
+                double x = word(i, 11) / 1000000.0;
+                if (m_flip_x && x > 180)
+                    x -= 360;
+                data->setField(Dimension::Id::PassiveX, nextId + i, x);
+            }
+            for (point_count_t i = 0; i < n; ++i)
+                data->setField(Dimension::Id::PassiveZ, nextId + i,
+                    word(i, 12) * m_scale_z);
         }
-        // GPS time is really a GPS offset from the start of the GPS day
-        // encoded in this odd way: 153320100 = 15 hours 33 minutes
-        // 20 seconds 100 milliseconds.
-        // Not sure why we have that AND the other offset time.  For now
-        // we'll just extract this time and drop it.
-        int32_t gpstime;
-        extractor >> gpstime;
 
         if (m_cb)
-            m_cb(*data, nextId);
+            for (point_count_t i = 0; i < n; ++i)
+                m_cb(*data, nextId + i);
 
-        numRead++;
-        nextId++;
+        nextId += n;
+        remaining -= n;
     }
-    m_index += numRead;
+    m_index += count;
 
-    return numRead;
+    return count;
 }
 
 
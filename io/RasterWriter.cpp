@@ -138,8 +138,26 @@ void RasterWriter::done(PointTableRef table)
     pixelToPos[5] = -limits.edgeLength;
     gdal::Raster rasterFile(m_filename, m_drivername, table.anySpatialReference(), pixelToPos);
 
+    // Default GeoTIFF output to tiled, compressed rasters.  Options the
+    // user provides through 'gdalopts' take precedence.
+    StringList options = m_options;
+    if (Utils::iequals(m_drivername, "GTiff"))
+    {
+        auto hasOption = [&options](const std::string& key)
+        {
+            for (const std::string& o : options)
+                if (Utils::iequals(o.substr(0, o.find('=')), key))
+                    return true;
+            return false;
+        };
+        if (!hasOption("TILED"))
+            options.push_back("TILED=YES");
+        if (!hasOption("COMPRESS"))
+            options.push_back("COMPRESS=DEFLATE");
+    }
+
     gdal::GDALError err = rasterFile.open(limits.width, limits.height,
-        rasters.size(), m_dataType, m_noData, m_options);
+        rasters.size(), m_dataType, m_noData, options);
 
     if (err != gdal::GDALError::None)
         throwError(rasterFile.errorMsg());
@@ -150,6 +168,10 @@ void RasterWriter::done(PointTableRef table)
         err = rasterFile.writeBand(r->begin(), r->initializer(), bandNum++, r->name());
         if (err != gdal::GDALError::None)
             throwError(rasterFile.errorMsg());
+        // Flushed bands aren't needed again; dropping each one as it's
+        // written keeps peak memory to one band's staging instead of the
+        // whole stack when writing multi-statistic products.
+        r->release();
     }
 
     getMetadata().addList("filename", m_filename);
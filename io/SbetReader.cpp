@@ -41,9 +41,20 @@
 #define _USE_MATH_DEFINES
 #include <math.h>
 
+#include <algorithm>
+#include <cstring>
+
 namespace pdal
 {
 
+namespace
+{
+
+// Number of records fetched per bulk read.
+const size_t bufferRecords = 4096;
+
+} // unnamed namespace
+
 static StaticPluginInfo const s_info
 {
     "readers.sbet",
@@ -59,6 +70,10 @@ std::string SbetReader::getName() const { return s_info.name; }
 void SbetReader::addArgs(ProgramArgs& args)
 {
     args.add("angles_as_degrees", "Convert all angles to degrees", m_anglesAsDegrees, true);
+    m_startTimeArg = &args.add("start_time", "Only read records with a time "
+        "greater than or equal to this value", m_startTime);
+    m_endTimeArg = &args.add("end_time", "Only read records with a time "
+        "less than or equal to this value", m_endTime);
 }
 
 void SbetReader::addDimensions(PointLayoutPtr layout)
@@ -74,63 +89,143 @@ void SbetReader::ready(PointTableRef)
     if ((fileSize == 0)|| (fileSize % pointSize != 0))
         throwError("Invalid file size.");
     m_numPts = fileSize / pointSize;
-    m_index = 0;
     m_stream.reset(new ILeStream(m_filename));
     m_dims = sbet::fileDimensions();
+
+    // Time is the first field of each record and increases monotonically,
+    // so a time window maps to a record range by binary search and only
+    // that range is read.
+    m_index = 0;
+    m_endPts = m_numPts;
+    if (m_startTimeArg->set() && m_endTimeArg->set() &&
+        m_startTime > m_endTime)
+        throwError("'start_time' must not be greater than 'end_time'.");
+    if (m_startTimeArg->set())
+    {
+        PointId lo = 0;
+        PointId hi = m_numPts;
+        while (lo < hi)
+        {
+            PointId mid = lo + (hi - lo) / 2;
+            if (timeAt(mid) < m_startTime)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        m_index = lo;
+    }
+    if (m_endTimeArg->set())
+    {
+        PointId lo = m_index;
+        PointId hi = m_numPts;
+        while (lo < hi)
+        {
+            PointId mid = lo + (hi - lo) / 2;
+            if (timeAt(mid) <= m_endTime)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        m_endPts = lo;
+    }
+
+    m_buffer.resize(bufferRecords * pointSize);
+    IStream::readAhead(m_filename, m_index * pointSize,
+        (m_endPts - m_index) * pointSize);
     seek(m_index);
 }
 
 
 bool SbetReader::processOne(PointRef& point)
 {
+    if (m_index >= m_endPts)
+        return false;
+    const char *record = nextRecord();
+    if (!record)
+        return false;
+
     auto radiansToDegrees = [](double radians) {
         return radians * 180.0 / M_PI;
     };
-    for (auto di = m_dims.begin(); di != m_dims.end(); ++di)
+    for (size_t i = 0; i < m_dims.size(); ++i)
     {
+        uint64_t raw;
+        std::memcpy(&raw, record + i * sizeof(double), sizeof(raw));
+        raw = le64toh(raw);
         double d;
-        *m_stream >> d;
-        Dimension::Id dim = *di;
+        std::memcpy(&d, &raw, sizeof(d));
+        Dimension::Id dim = m_dims[i];
         if (m_anglesAsDegrees && sbet::isAngularDimension(dim)) {
             d = radiansToDegrees(d);
         }
         point.setField(dim, d);
     }
-    return (m_stream->good());
+    m_index++;
+    return true;
 }
 
 
 point_count_t SbetReader::read(PointViewPtr view, point_count_t count)
 {
     PointId nextId = view->size();
-    PointId idx = m_index;
     point_count_t numRead = 0;
-    seek(idx);
-    while (numRead < count && idx < m_numPts)
+    seek(m_index);
+    while (numRead < count && m_index < m_endPts)
     {
         PointRef point = view->point(nextId);
-        processOne(point);
+        if (!processOne(point))
+            break;
         if (m_cb)
             m_cb(*view, nextId);
 
-        idx++;
         nextId++;
         numRead++;
     }
-    m_index = idx;
     return numRead;
 }
 
 
 bool SbetReader::eof()
 {
-    return m_index >= m_numPts;
+    return m_index >= m_endPts;
 }
 
 
 void SbetReader::seek(PointId idx)
 {
     m_stream->seek(idx * sizeof(double) * sbet::fileDimensions().size());
+    // Discard buffered records; the next read refills at the new position.
+    m_bufFill = 0;
+    m_bufPos = 0;
+}
+
+
+// Read the time field of the record at the given index.
+double SbetReader::timeAt(PointId idx)
+{
+    m_stream->seek(idx * sizeof(double) * sbet::fileDimensions().size());
+    double t;
+    *m_stream >> t;
+    return t;
+}
+
+
+// Return a pointer to the next raw record, fetching a block of records
+// from the file when the buffer runs dry.
+const char *SbetReader::nextRecord()
+{
+    size_t pointSize = m_dims.size() * sizeof(double);
+    if (m_bufPos == m_bufFill)
+    {
+        size_t recs = (size_t)(std::min)((point_count_t)bufferRecords,
+            m_endPts - m_index);
+        m_stream->get(m_buffer.data(), recs * pointSize);
+        if (!m_stream->good())
+            return nullptr;
+        m_bufFill = recs;
+        m_bufPos = 0;
+    }
+    return m_buffer.data() + pointSize * m_bufPos++;
 }
 
 } // namespace pdal
@@ -56,8 +56,18 @@ private:
     // Number of points in the file.
     point_count_t m_numPts;
     point_count_t m_index;
+    // One past the last record to read (clipped by 'end_time').
+    point_count_t m_endPts;
     Dimension::IdList m_dims;
     bool m_anglesAsDegrees;
+    double m_startTime;
+    double m_endTime;
+    Arg *m_startTimeArg;
+    Arg *m_endTimeArg;
+    // Raw record buffer for bulk reads.
+    std::vector<char> m_buffer;
+    size_t m_bufFill;
+    size_t m_bufPos;
 
     virtual bool processOne(PointRef& point);
     virtual void addArgs(ProgramArgs& args);
@@ -67,6 +77,8 @@ private:
     virtual bool eof();
 
     void seek(PointId idx);
+    double timeAt(PointId idx);
+    const char *nextRecord();
 };
 
 } // namespace pdal
@@ -34,6 +34,10 @@
 
 #include "TIndexReader.hpp"
 
+#include <atomic>
+#include <mutex>
+#include <thread>
+
 #include <ogr_api.h>
 
 #include <pdal/Polygon.hpp>
@@ -132,6 +136,7 @@ void TIndexReader::addArgs(ProgramArgs& args)
         "with lyr_name", m_attributeFilter);
     args.add("dialect", "OGR SQL dialect to use when querying tile "
         "index layer", m_dialect, "OGRSQL");
+    args.add("threads", "Number of threads used to read files", m_threads, 1);
 }
 
 
@@ -143,8 +148,41 @@ void TIndexReader::addDimensions(PointLayoutPtr layout)
 }
 
 
+// Compare the file header's extent with the query geometry.  The tile
+// geometry in the index may be stale or approximate; the header extent is
+// authoritative and checking it here avoids opening point data at
+// execution time for files the query can't touch.
+bool TIndexReader::skipFile(Stage *reader, const FileInfo& f,
+    const Polygon& query)
+{
+    QuickInfo qi;
+    try
+    {
+        qi = reader->preview();
+    }
+    catch (const pdal_error&)
+    {
+        return false;
+    }
+    if (!qi.valid() || !qi.m_bounds.to2d().valid())
+        return false;
+
+    Polygon extent(qi.m_bounds.to2d());
+    std::string srs = f.m_srs.size() ? f.m_srs : qi.m_srs.getWKT();
+    if (srs.size())
+    {
+        extent = Polygon(extent.wkt(), SpatialReference(srs));
+        if (!extent.transform(m_out_ref->wkt()))
+            return false;
+    }
+    return query.disjoint(extent);
+}
+
+
 void TIndexReader::initialize()
 {
+    if (m_threads < 1)
+        throwError("Option 'threads' must be positive.");
     if (!m_bounds.empty())
         m_wkt = m_bounds.toWKT();
     m_out_ref.reset(new gdal::SpatialRef());
@@ -226,6 +264,13 @@ void TIndexReader::initialize()
         Options readerOptions;
         readerOptions.add("filename", f.m_filename);
         reader->setOptions(readerOptions);
+
+        if (m_wkt.size() && skipFile(reader, f, poly))
+        {
+            log()->get(LogLevel::Debug) << "Skipping file " << f.m_filename <<
+                " - header bounds don't intersect query" << std::endl;
+            continue;
+        }
         Stage *premerge = reader;
 
         if (m_tgtSrsString.size() )
@@ -257,6 +302,7 @@ void TIndexReader::initialize()
             premerge = crop;
         }
 
+        m_premerges.push_back(premerge);
         m_merge.setInput(*premerge);
     }
 
@@ -276,12 +322,107 @@ void TIndexReader::initialize()
 
 void TIndexReader::prepared(PointTableRef table)
 {
-    m_merge.prepare(table);
+    if (m_threads <= 1)
+    {
+        m_merge.prepare(table);
+        return;
+    }
+
+    // Each file's subpipeline gets its own table so the pipelines can
+    // execute concurrently.  The union of their dimensions is registered
+    // in the output table.
+    for (Stage *s : m_premerges)
+    {
+        m_tables.emplace_back(new ColumnPointTable);
+        s->prepare(*m_tables.back());
+
+        PointLayoutPtr layout = m_tables.back()->layout();
+        for (Dimension::Id id : layout->dims())
+            table.layout()->registerOrAssignDim(layout->dimName(id),
+                layout->dimType(id));
+    }
 }
 
 void TIndexReader::ready(PointTableRef table)
 {
-    m_pvSet = m_merge.execute(table);
+    if (m_threads <= 1)
+    {
+        m_pvSet = m_merge.execute(table);
+        return;
+    }
+
+    // Execute the per-file subpipelines concurrently, pulling files off
+    // a shared counter, then merge the results in tile order.
+    std::vector<PointViewSet> subViews(m_premerges.size());
+    std::atomic<size_t> next(0);
+    std::mutex mutex;
+    std::string error;
+
+    auto run = [this, &subViews, &next, &mutex, &error]()
+    {
+        while (true)
+        {
+            size_t i = next++;
+            if (i >= m_premerges.size())
+                break;
+            try
+            {
+                subViews[i] = m_premerges[i]->execute(*m_tables[i]);
+            }
+            catch (const pdal_error& err)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (error.empty())
+                    error = err.what();
+            }
+        }
+    };
+
+    size_t threads = (std::min)((size_t)m_threads, m_premerges.size());
+    std::vector<std::thread> pool;
+    for (size_t t = 0; t < threads; ++t)
+        pool.emplace_back(run);
+    for (auto& t : pool)
+        t.join();
+    if (error.size())
+        throwError(error);
+
+    // Copy the subpipeline results into a single view on the output
+    // table.  Dimension IDs can differ between layouts, so dimensions
+    // are matched by name.
+    PointViewPtr outView(new PointView(table));
+    PointLayoutPtr outLayout = table.layout();
+    for (PointViewSet& views : subViews)
+        for (const PointViewPtr& v : views)
+        {
+            PointLayoutPtr inLayout = v->layout();
+            std::vector<std::pair<DimType, Dimension::Id>> dims;
+            for (Dimension::Id id : inLayout->dims())
+            {
+                Dimension::Id outId = outLayout->findDim(inLayout->dimName(id));
+                if (outId != Dimension::Id::Unknown)
+                    dims.push_back(
+                        { DimType(id, inLayout->dimType(id)), outId });
+            }
+
+            PointRef src(*v);
+            PointRef dst(*outView);
+            for (PointId i = 0; i < v->size(); ++i)
+            {
+                src.setPointId(i);
+                dst.setPointId(outView->size());
+                for (const auto& d : dims)
+                {
+                    Everything e;
+                    src.getField((char *)&e, d.first.m_id, d.first.m_type);
+                    dst.setField(d.second, d.first.m_type, &e);
+                }
+            }
+        }
+
+    subViews.clear();
+    m_tables.clear();
+    m_pvSet.insert(outView);
 }
 
 
@@ -34,6 +34,7 @@
 
 #pragma once
 
+#include <pdal/PointTable.hpp>
 #include <pdal/PointView.hpp>
 #include <pdal/Reader.hpp>
 #include <pdal/StageFactory.hpp>
@@ -44,6 +45,8 @@ namespace pdal
 
 namespace gdal { class SpatialRef; }
 
+class Polygon;
+
 class PDAL_DLL TIndexReader : public Reader
 {
     struct FileInfo
@@ -88,6 +91,7 @@ private:
     std::string m_dialect;
     BOX2D m_bounds;
     std::string m_sql;
+    int m_threads;
 
     std::unique_ptr<gdal::SpatialRef> m_out_ref;
     void *m_dataset;
@@ -97,8 +101,14 @@ private:
     MergeFilter m_merge;
     PointViewSet m_pvSet;
 
+    /// Per-file subpipelines in tile order, used when reading in parallel.
+    std::vector<Stage *> m_premerges;
+    /// Per-file tables backing the parallel subpipelines.
+    std::vector<std::unique_ptr<ColumnPointTable>> m_tables;
+
     std::vector<FileInfo> getFiles();
     FieldIndexes getFields();
+    bool skipFile(Stage *reader, const FileInfo& f, const Polygon& query);
 };
 
 
@@ -35,8 +35,9 @@
 #include "TerrasolidReader.hpp"
 
 #include <pdal/PointView.hpp>
-#include <pdal/util/Extractor.hpp>
+#include <pdal/util/portable_endian.hpp>
 
+#include <cstring>
 #include <map>
 
 namespace pdal
@@ -146,7 +147,6 @@ point_count_t TerrasolidReader::read(PointViewPtr view, point_count_t count)
 
     std::vector<char> buf(m_size * count);
     m_istream->get(buf);
-    LeExtractor extractor(buf.data(), buf.size());
 
     // See https://www.terrasolid.com/download/tscan.pdf
     // This spec is awful, but it's something.
@@ -155,106 +155,144 @@ point_count_t TerrasolidReader::read(PointViewPtr view, point_count_t count)
     // says.
     // Also modified the fetch of time/color based on header flag (rather
     // than just not write the data into the buffer).
+    //
+    // Records are decoded in one strided pass per dimension rather than
+    // field-by-field through an extractor.  The stride is the number of
+    // bytes the sequential decode consumed - for format 1 that's smaller
+    // than the nominal record size, which matches the historical decode.
+    size_t stride = (m_format == TERRASOLID_Format_1) ? 6 : 20;
+    size_t timeOff = stride;
+    if (m_haveTime)
+        stride += 4;
+    size_t colorOff = stride;
+    if (m_haveColor)
+        stride += 4;
+
+    const char *base = buf.data();
+    auto u8 = [base, stride](point_count_t i, size_t off)
+    { return (uint8_t)base[i * stride + off]; };
+    auto u16 = [base, stride](point_count_t i, size_t off)
+    {
+        uint16_t v;
+        std::memcpy(&v, base + i * stride + off, sizeof(v));
+        return (uint16_t)le16toh(v);
+    };
+    auto u32 = [base, stride](point_count_t i, size_t off)
+    {
+        uint32_t v;
+        std::memcpy(&v, base + i * stride + off, sizeof(v));
+        return (uint32_t)le32toh(v);
+    };
+
     PointId nextId = view->size();
-    while (!eof())
+    if (m_format == TERRASOLID_Format_1)
     {
-        if (m_format == TERRASOLID_Format_1)
+        for (point_count_t i = 0; i < count; ++i)
+            view->setField(Dimension::Id::Classification, nextId + i,
+                u8(i, 0));
+        for (point_count_t i = 0; i < count; ++i)
+            view->setField(Dimension::Id::PointSourceId, nextId + i,
+                u8(i, 1));
+        for (point_count_t i = 0; i < count; ++i)
         {
-            uint8_t classification, flight_line, echo_int, x, y, z;
-
-            extractor >> classification >> flight_line >> echo_int >> x >> y >>
-                z;
-
-            view->setField(Dimension::Id::Classification, nextId,
-                          classification);
-            view->setField(Dimension::Id::PointSourceId, nextId, flight_line);
-            switch (echo_int)
+            switch (u8(i, 2))
             {
             case 0: // only echo
-                view->setField(Dimension::Id::ReturnNumber, nextId, 1);
-                view->setField(Dimension::Id::NumberOfReturns, nextId, 1);
+                view->setField(Dimension::Id::ReturnNumber, nextId + i, 1);
+                view->setField(Dimension::Id::NumberOfReturns, nextId + i, 1);
                 break;
             case 1: // first of many echos
-                view->setField(Dimension::Id::ReturnNumber, nextId, 1);
+                view->setField(Dimension::Id::ReturnNumber, nextId + i, 1);
                 break;
             default: // intermediate echo or last of many echos
                 break;
             }
-            view->setField(Dimension::Id::X, nextId,
-                          (x - m_header->OrgX) / m_header->Units);
-            view->setField(Dimension::Id::Y, nextId,
-                          (y - m_header->OrgY) / m_header->Units);
-            view->setField(Dimension::Id::Z, nextId,
-                          (z - m_header->OrgZ) / m_header->Units);
         }
+        for (point_count_t i = 0; i < count; ++i)
+            view->setField(Dimension::Id::X, nextId + i,
+                (u8(i, 3) - m_header->OrgX) / m_header->Units);
+        for (point_count_t i = 0; i < count; ++i)
+            view->setField(Dimension::Id::Y, nextId + i,
+                (u8(i, 4) - m_header->OrgY) / m_header->Units);
+        for (point_count_t i = 0; i < count; ++i)
+            view->setField(Dimension::Id::Z, nextId + i,
+                (u8(i, 5) - m_header->OrgZ) / m_header->Units);
+    }
 
-        if (m_format == TERRASOLID_Format_2)
+    if (m_format == TERRASOLID_Format_2)
+    {
+        for (point_count_t i = 0; i < count; ++i)
+            view->setField(Dimension::Id::X, nextId + i,
+                ((int32_t)u32(i, 0) - m_header->OrgX) / m_header->Units);
+        for (point_count_t i = 0; i < count; ++i)
+            view->setField(Dimension::Id::Y, nextId + i,
+                ((int32_t)u32(i, 4) - m_header->OrgY) / m_header->Units);
+        for (point_count_t i = 0; i < count; ++i)
+            view->setField(Dimension::Id::Z, nextId + i,
+                ((int32_t)u32(i, 8) - m_header->OrgZ) / m_header->Units);
+        for (point_count_t i = 0; i < count; ++i)
+            view->setField(Dimension::Id::Classification, nextId + i,
+                u8(i, 12));
+        for (point_count_t i = 0; i < count; ++i)
         {
-            int32_t x, y, z;
-            uint8_t classification, echo_int, flag, mark;
-            uint16_t flight_line, intensity;
-
-            extractor >> x >> y >> z >> classification >> echo_int >> flag >>
-                mark >> flight_line >> intensity;
-
-            view->setField(Dimension::Id::X, nextId,
-                          (x - m_header->OrgX) / m_header->Units);
-            view->setField(Dimension::Id::Y, nextId,
-                          (y - m_header->OrgY) / m_header->Units);
-            view->setField(Dimension::Id::Z, nextId,
-                          (z - m_header->OrgZ) / m_header->Units);
-            view->setField(Dimension::Id::Classification, nextId,
-                          classification);
-            switch (echo_int)
+            switch (u8(i, 13))
             {
             case 0: // only echo
-                view->setField(Dimension::Id::ReturnNumber, nextId, 1);
-                view->setField(Dimension::Id::NumberOfReturns, nextId, 1);
+                view->setField(Dimension::Id::ReturnNumber, nextId + i, 1);
+                view->setField(Dimension::Id::NumberOfReturns, nextId + i, 1);
                 break;
             case 1: // first of many echos
-                view->setField(Dimension::Id::ReturnNumber, nextId, 1);
+                view->setField(Dimension::Id::ReturnNumber, nextId + i, 1);
                 break;
             default: // intermediate echo or last of many echos
                 break;
             }
-            view->setField(Dimension::Id::Flag, nextId, flag);
-            view->setField(Dimension::Id::Mark, nextId, mark);
-            view->setField(Dimension::Id::PointSourceId, nextId, flight_line);
-            view->setField(Dimension::Id::Intensity, nextId, intensity);
         }
+        for (point_count_t i = 0; i < count; ++i)
+            view->setField(Dimension::Id::Flag, nextId + i, u8(i, 14));
+        for (point_count_t i = 0; i < count; ++i)
+            view->setField(Dimension::Id::Mark, nextId + i, u8(i, 15));
+        for (point_count_t i = 0; i < count; ++i)
+            view->setField(Dimension::Id::PointSourceId, nextId + i,
+                u16(i, 16));
+        for (point_count_t i = 0; i < count; ++i)
+            view->setField(Dimension::Id::Intensity, nextId + i,
+                u16(i, 18));
+    }
 
-        if (m_haveTime)
+    if (m_haveTime)
+    {
+        if (m_index == 0 && count > 0)
+            m_baseTime = u32(0, timeOff);
+        for (point_count_t i = 0; i < count; ++i)
         {
-            uint32_t t;
-
-            extractor >> t;
-
-            if (m_index == 0)
-                m_baseTime = t;
+            uint32_t t = u32(i, timeOff);
             t -= m_baseTime; // Offset from the beginning of the read.
             // instead of GPS week.
             t /= 5; // 5000ths of a second to milliseconds
-            view->setField(Dimension::Id::OffsetTime, nextId, t);
+            view->setField(Dimension::Id::OffsetTime, nextId + i, t);
         }
+    }
 
-        if (m_haveColor)
+    if (m_haveColor)
+    {
+        for (point_count_t i = 0; i < count; ++i)
         {
-            uint8_t red, green, blue, alpha;
-
-            extractor >> red >> green >> blue >> alpha;
-
-            view->setField(Dimension::Id::Red, nextId, red);
-            view->setField(Dimension::Id::Green, nextId, green);
-            view->setField(Dimension::Id::Blue, nextId, blue);
-            view->setField(Dimension::Id::Alpha, nextId, alpha);
+            view->setField(Dimension::Id::Red, nextId + i, u8(i, colorOff));
+            view->setField(Dimension::Id::Green, nextId + i,
+                u8(i, colorOff + 1));
+            view->setField(Dimension::Id::Blue, nextId + i,
+                u8(i, colorOff + 2));
+            view->setField(Dimension::Id::Alpha, nextId + i,
+                u8(i, colorOff + 3));
         }
+    }
 
-        if (m_cb)
-            m_cb(*view, nextId);
+    if (m_cb)
+        for (point_count_t i = 0; i < count; ++i)
+            m_cb(*view, nextId + i);
 
-        nextId++;
-        m_index++;
-    }
+    m_index += count;
 
     return count;
 }
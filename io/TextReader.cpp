@@ -35,12 +35,23 @@
 #include <pdal/PDALUtils.hpp>
 #include <pdal/util/Algorithm.hpp>
 
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+
 #include "TextReader.hpp"
-#include "../filters/StatsFilter.hpp"
 
 namespace pdal
 {
 
+namespace
+{
+    // Size of a block of input read at once.
+    const size_t bufSize = 1024 * 1024;
+}
+
 static StaticPluginInfo const s_info
 {
     "readers.text",
@@ -53,37 +64,22 @@ CREATE_STATIC_STAGE(TextReader, s_info)
 
 std::string TextReader::getName() const { return s_info.name; }
 
-// NOTE: - Forces reading of the entire file.
+// Only the header line is read.  The point count and bounds aren't stored
+// in a text file header, so they're left unset rather than forcing a scan
+// of the entire file.
 QuickInfo TextReader::inspect()
 {
     QuickInfo qi;
-    FixedPointTable t(100);
 
-    StatsFilter f;
-    f.setInput(*this);
+    PointTable table;
+    initialize(table);
 
-    f.prepare(t);
-    PointLayoutPtr layout = t.layout();
-    for (Dimension::Id id : layout->dims())
-        qi.m_dimNames.push_back(layout->dimName(id));
-    f.execute(t);
-
-    try
+    for (std::string name : m_dimNames)
     {
-        stats::Summary xSummary = f.getStats(Dimension::Id::X);
-        qi.m_pointCount = xSummary.count();
-        qi.m_bounds.minx = xSummary.minimum();
-        qi.m_bounds.maxx = xSummary.maximum();
-        stats::Summary ySummary = f.getStats(Dimension::Id::Y);
-        qi.m_bounds.miny = ySummary.minimum();
-        qi.m_bounds.maxy = ySummary.maximum();
-        stats::Summary zSummary = f.getStats(Dimension::Id::Z);
-        qi.m_bounds.minz = zSummary.minimum();
-        qi.m_bounds.maxz = zSummary.maximum();
-        qi.m_valid = true;
+        Utils::trim(name);
+        qi.m_dimNames.push_back(name);
     }
-    catch (pdal_error&)
-    {}
+    qi.m_valid = true;
     return qi;
 }
 
@@ -254,6 +250,11 @@ void TextReader::ready(PointTableRef table)
     std::string dummy;
     for (size_t i = 0; i < m_line; ++i)
 	std::getline(*m_istream, dummy);
+
+    m_buf.resize(bufSize);
+    m_bufPos = 0;
+    m_bufEnd = 0;
+    m_bufEof = false;
 }
 
 
@@ -282,10 +283,12 @@ bool TextReader::processOne(PointRef& point)
     double d;
     for (size_t i = 0; i < m_fields.size(); ++i)
     {
-        if (!Utils::fromString(m_fields[i], d))
+        if (!parseField(m_fields[i].first, m_fields[i].second, d))
         {
             log()->get(LogLevel::Error) << "Can't convert "
-                "field '" << m_fields[i] << "' to numeric value on line " <<
+                "field '" <<
+                std::string(m_fields[i].first, m_fields[i].second) <<
+                "' to numeric value on line " <<
                 m_line << " in '" << m_filename << "'.  Setting to 0." <<
                 std::endl;
             d = 0;
@@ -296,26 +299,135 @@ bool TextReader::processOne(PointRef& point)
 }
 
 
-bool TextReader::fillFields()
+bool TextReader::fillBuffer()
 {
-    while (true)
+    // Retain any partial line at the front of the buffer.
+    size_t left = m_bufEnd - m_bufPos;
+    if (left)
+        std::memmove(m_buf.data(), m_buf.data() + m_bufPos, left);
+    m_bufPos = 0;
+    m_bufEnd = left;
+
+    if (m_bufEof)
+        return false;
+
+    // Grow the buffer if a single line fills it completely.
+    if (m_bufEnd == m_buf.size())
+        m_buf.resize(m_buf.size() * 2);
+
+    m_istream->read(m_buf.data() + m_bufEnd, m_buf.size() - m_bufEnd);
+    size_t cnt = (size_t)m_istream->gcount();
+    m_bufEnd += cnt;
+    if (cnt == 0)
     {
-        if (!m_istream->good())
-            return false;
+        m_bufEof = true;
+        return false;
+    }
+    return true;
+}
 
-        std::string buf;
 
-        std::getline(*m_istream, buf);
+bool TextReader::nextLine(const char *&begin, const char *&end)
+{
+    while (true)
+    {
+        const char *base = m_buf.data();
+        const char *nl = (const char *)std::memchr(base + m_bufPos, '\n',
+            m_bufEnd - m_bufPos);
+        if (nl)
+        {
+            begin = base + m_bufPos;
+            end = nl;
+            m_bufPos = (nl - base) + 1;
+        }
+        else if (!m_bufEof)
+        {
+            fillBuffer();
+            continue;
+        }
+        else
+        {
+            // Last line without a trailing newline.
+            if (m_bufPos == m_bufEnd)
+                return false;
+            begin = base + m_bufPos;
+            end = base + m_bufEnd;
+            m_bufPos = m_bufEnd;
+        }
         m_line++;
-        if (buf.empty())
+        return true;
+    }
+}
+
+
+bool TextReader::parseField(const char *begin, const char *end, double& d)
+{
+    // Mirror stream extraction - skip leading whitespace and ignore
+    // anything following the number.
+    while (begin < end && std::isspace((unsigned char)*begin))
+        begin++;
+    if (begin < end && *begin == '+')
+        begin++;
+#if defined(__cpp_lib_to_chars)
+    auto result = std::from_chars(begin, end, d);
+    return result.ec == std::errc();
+#else
+    // No floating-point from_chars() - strtod() needs a terminated string.
+    m_fieldBuf.assign(begin, end);
+    char *pos;
+    d = std::strtod(m_fieldBuf.c_str(), &pos);
+    return pos != m_fieldBuf.c_str();
+#endif
+}
+
+
+bool TextReader::fillFields()
+{
+    const char *begin;
+    const char *end;
+
+    while (true)
+    {
+        if (!nextLine(begin, end))
+            return false;
+        if (begin == end)
             continue;
+
+        m_fields.clear();
         if (m_separator != ' ')
         {
-            Utils::remove(buf, ' ');
-            m_fields = Utils::split(buf, m_separator);
+            // Spaces are ignored, so a line of only spaces has no fields.
+            auto nonspace = [](char c){ return c != ' '; };
+            if (std::any_of(begin, end, nonspace))
+            {
+                const char *fieldStart = begin;
+                for (const char *p = begin; ; ++p)
+                {
+                    if (p == end || *p == m_separator)
+                    {
+                        m_fields.push_back(std::make_pair(fieldStart, p));
+                        fieldStart = p + 1;
+                        if (p == end)
+                            break;
+                    }
+                }
+            }
         }
         else
-            m_fields = Utils::split2(buf, m_separator);
+        {
+            const char *p = begin;
+            while (p != end)
+            {
+                while (p != end && *p == ' ')
+                    ++p;
+                if (p == end)
+                    break;
+                const char *fieldStart = p;
+                while (p != end && *p != ' ')
+                    ++p;
+                m_fields.push_back(std::make_pair(fieldStart, p));
+            }
+        }
         if (m_fields.size() != m_dims.size())
         {
             log()->get(LogLevel::Error) << "Line " << m_line <<
@@ -35,6 +35,8 @@
 #pragma once
 
 #include <istream>
+#include <utility>
+#include <vector>
 
 #include <pdal/Reader.hpp>
 #include <pdal/Streamable.hpp>
@@ -111,8 +113,42 @@ private:
     */
     virtual bool processOne(PointRef& point);
 
+    /**
+      Locate the fields of the next input line.  Skips blank lines and
+      lines with the wrong number of fields.  The field positions refer
+      to the input buffer and are valid until the next call.
+
+      \return  False if no line with fields could be read.
+    */
     bool fillFields();
 
+    /**
+      Fetch the next line from the buffered input.  The returned range
+      doesn't include the line terminator and is valid until the next call.
+
+      \param begin  Set to the first character of the line.
+      \param end  Set to one past the last character of the line.
+      \return  False if no line could be read.
+    */
+    bool nextLine(const char *&begin, const char *&end);
+
+    /**
+      Refill the input buffer, retaining any partial line already read.
+
+      \return  False if no more data could be read.
+    */
+    bool fillBuffer();
+
+    /**
+      Parse a numeric field in place.
+
+      \param begin  First character of the field.
+      \param end  One past the last character of the field.
+      \param d  Value to fill.
+      \return  False if the field couldn't be parsed.
+    */
+    bool parseField(const char *begin, const char *end, double& d);
+
     /**
       Parse a header line into a list of dimension names.
 
@@ -148,7 +184,12 @@ private:
     std::istream *m_istream;
     StringList m_dimNames;
     Dimension::IdList m_dims;
-    StringList m_fields;
+    std::vector<std::pair<const char *, const char *>> m_fields;
+    std::vector<char> m_buf;
+    size_t m_bufPos;
+    size_t m_bufEnd;
+    bool m_bufEof;
+    std::string m_fieldBuf;
     size_t m_line;
     std::string m_header;
     size_t m_skip;
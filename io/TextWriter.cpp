@@ -40,11 +40,21 @@
 #include <pdal/util/Algorithm.hpp>
 #include <pdal/util/ProgramArgs.hpp>
 
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
 #include <iostream>
 
 namespace pdal
 {
 
+namespace
+{
+    // Flush the output buffer to the stream once it holds this much.
+    const size_t flushSize = 1024 * 1024;
+}
+
 static StaticPluginInfo const s_info
 {
     "writers.text",
@@ -205,6 +215,19 @@ void TextWriter::ready(PointTableRef table)
         }
     }
 
+    // Precompute what precedes each dimension's value on an output line.
+    for (auto di = m_dims.begin(); di != m_dims.end(); ++di)
+    {
+        if (m_outputType == OutputType::CSV)
+            di->prefix = (di == m_dims.begin()) ? "" : m_delimiter;
+        else
+            di->prefix = std::string(di == m_dims.begin() ? "" : ",") +
+                "\"" + di->name + "\":\"";
+    }
+
+    m_outBuf.resize(flushSize + 65536);
+    m_outPos = 0;
+
     if (!m_writeHeader)
         log()->get(LogLevel::Debug) << "Not writing header" << std::endl;
     else
@@ -224,8 +247,55 @@ void TextWriter::writeHeader(PointTableRef table)
 }
 
 
+void TextWriter::ensure(size_t size)
+{
+    if (m_outPos + size > m_outBuf.size())
+        m_outBuf.resize((std::max)(m_outBuf.size() * 2, m_outPos + size));
+}
+
+
+void TextWriter::put(const std::string& s)
+{
+    ensure(s.size());
+    std::memcpy(m_outBuf.data() + m_outPos, s.data(), s.size());
+    m_outPos += s.size();
+}
+
+
+void TextWriter::putDouble(double d, size_t precision)
+{
+    ensure(precision + 400);
+#if defined(__cpp_lib_to_chars)
+    auto result = std::to_chars(m_outBuf.data() + m_outPos,
+        m_outBuf.data() + m_outBuf.size(), d, std::chars_format::fixed,
+        (int)precision);
+    if (result.ec == std::errc())
+    {
+        m_outPos = result.ptr - m_outBuf.data();
+        return;
+    }
+#endif
+    // No floating-point to_chars() support or insufficient room.
+    int cnt = std::snprintf(m_outBuf.data() + m_outPos,
+        m_outBuf.size() - m_outPos, "%.*f", (int)precision, d);
+    if (cnt > 0)
+        m_outPos += (std::min)((size_t)cnt, m_outBuf.size() - m_outPos - 1);
+}
+
+
+void TextWriter::flushBuffer()
+{
+    if (m_outPos)
+    {
+        m_stream->write(m_outBuf.data(), m_outPos);
+        m_outPos = 0;
+    }
+}
+
+
 void TextWriter::writeFooter()
 {
+    flushBuffer();
     if (m_outputType == OutputType::GEOJSON)
     {
         *m_stream << "]}";
@@ -265,43 +335,43 @@ void TextWriter::processOneCSV(PointRef& point)
 {
     for (auto di = m_dims.begin(); di != m_dims.end(); ++di)
     {
-        if (di != m_dims.begin())
-            *m_stream << m_delimiter;
-        m_stream->precision(di->precision);
-        *m_stream << point.getFieldAs<double>(di->id);
+        put(di->prefix);
+        putDouble(point.getFieldAs<double>(di->id), di->precision);
     }
-    *m_stream << m_newline;
+    put(m_newline);
+    if (m_outPos >= flushSize)
+        flushBuffer();
 }
 
 void TextWriter::processOneGeoJSON(PointRef& point)
 {
+    static const std::string featureStart(
+        "{ \"type\":\"Feature\",\"geometry\": "
+        "{ \"type\": \"Point\", \"coordinates\": [");
+
     if (m_idx > 0)
-        *m_stream << ",";
-    *m_stream << "{ \"type\":\"Feature\",\"geometry\": "
-        "{ \"type\": \"Point\", \"coordinates\": [";
+        put(",");
+    put(featureStart);
 
-    m_stream->precision(m_xDim.precision);
-    *m_stream << point.getFieldAs<double>(Dimension::Id::X) << ",";
-    m_stream->precision(m_yDim.precision);
-    *m_stream << point.getFieldAs<double>(Dimension::Id::Y) << ",";
-    m_stream->precision(m_zDim.precision);
-    *m_stream << point.getFieldAs<double>(Dimension::Id::Z) << "]},";
+    putDouble(point.getFieldAs<double>(Dimension::Id::X), m_xDim.precision);
+    put(",");
+    putDouble(point.getFieldAs<double>(Dimension::Id::Y), m_yDim.precision);
+    put(",");
+    putDouble(point.getFieldAs<double>(Dimension::Id::Z), m_zDim.precision);
+    put("]},");
 
-    *m_stream << "\"properties\": {";
+    put("\"properties\": {");
 
     for (auto di = m_dims.begin(); di != m_dims.end(); ++di)
     {
-        if (di != m_dims.begin())
-            *m_stream << ",";
-
-        *m_stream << "\"" << di->name << "\":";
-        *m_stream << "\"";
-        m_stream->precision(di->precision);
-        *m_stream << point.getFieldAs<double>(di->id);
-        *m_stream <<"\"";
+        put(di->prefix);
+        putDouble(point.getFieldAs<double>(di->id), di->precision);
+        put("\"");
     }
-    *m_stream << "}"; // end properties
-    *m_stream << "}"; // end feature
+    put("}"); // end properties
+    put("}"); // end feature
+    if (m_outPos >= flushSize)
+        flushBuffer();
 }
 
 
@@ -49,6 +49,9 @@ class PDAL_DLL TextWriter : public Writer, public Streamable
         Dimension::Id id;
         size_t precision;
         std::string name;
+        // Formatting plan - everything that precedes this dimension's
+        // value on an output line, precomputed in ready().
+        std::string prefix;
     };
 
     enum class OutputType
@@ -85,6 +88,29 @@ private:
     DimSpec extractDim(std::string dim, PointTableRef table);
     bool findDim(Dimension::Id id, DimSpec& ds);
 
+    /**
+      Make sure the output buffer has room for \c size more bytes.
+    */
+    void ensure(size_t size);
+
+    /**
+      Append a string to the output buffer.
+    */
+    void put(const std::string& s);
+
+    /**
+      Append a value to the output buffer in fixed notation.
+
+      \param d  Value to format.
+      \param precision  Number of digits after the decimal point.
+    */
+    void putDouble(double d, size_t precision);
+
+    /**
+      Write the contents of the output buffer to the output stream.
+    */
+    void flushBuffer();
+
     std::string m_filename;
     OutputType m_outputType;
     std::string m_callback;
@@ -99,6 +125,8 @@ private:
     PointId m_idx;
 
     FileStreamPtr m_stream;
+    std::vector<char> m_outBuf;
+    size_t m_outPos;
     std::vector<DimSpec> m_dims;
     DimSpec m_xDim;
     DimSpec m_yDim;
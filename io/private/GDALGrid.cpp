@@ -38,7 +38,10 @@
 #include <cmath>
 #include <limits>
 #include <iostream>
+#include <thread>
+
 #include <pdal/pdal_types.hpp>
+#include <pdal/util/ThreadPool.hpp>
 
 namespace pdal
 {
@@ -110,12 +113,34 @@ double GDALGrid::distance(int i, int j, double x, double y) const
     return std::sqrt(std::pow(x1 - x, 2) + std::pow(y1 - y, 2));
 }
 
-void GDALGrid::windowFill()
+void GDALGrid::fillEmptyCells()
 {
-    for (int i = 0; i < width(); ++i)
-        for (int j = 0; j < height(); ++j)
-            if (empty(i, j))
-                windowFill(i, j);
+    // Filling an empty cell reads only non-empty cells and writes only the
+    // cell being filled, and the count raster that determines emptiness
+    // isn't modified, so empty cells can be filled independently.  Hand
+    // each thread a contiguous block of columns.
+    const size_t threads = (std::min)(
+        (size_t)(std::max)(std::thread::hardware_concurrency(), 1U),
+        (size_t)width());
+    ThreadPool pool(threads ? threads : 1);
+    for (size_t t = 0; t < threads; ++t)
+    {
+        const int colStart = (int)(t * width() / threads);
+        const int colEnd = (int)((t + 1) * width() / threads);
+        pool.add([this, colStart, colEnd]()
+        {
+            for (int i = colStart; i < colEnd; ++i)
+                for (int j = 0; j < height(); ++j)
+                    if (empty(i, j))
+                    {
+                        if (m_windowSize > 0)
+                            windowFill(i, j);
+                        else
+                            fillNodata(i, j);
+                    }
+        });
+    }
+    pool.join();
 }
 
 /**
@@ -448,15 +473,7 @@ void GDALGrid::finalize()
                     (*m_idw)[i] /= distSum;
             }
 
-    if (m_windowSize > 0)
-        windowFill();
-    else
-    {
-        for (int i = 0; i < m_count->width(); ++i)
-            for (int j = 0; j < m_count->height(); ++j)
-                if (empty(i, j))
-                    fillNodata(i, j);
-    }
+    fillEmptyCells();
 }
 
 
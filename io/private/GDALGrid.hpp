@@ -128,9 +128,10 @@ private:
     // \j  J coordinate.
     void fillNodata(int i, int j);
 
-    // Fill an empty cell with a value inverse-distance averaged from
-    // surrounding cells.
-    void windowFill();
+    // Fill all empty cells, either with values inverse-distance averaged
+    // from surrounding cells (when a window size is set) or with the
+    // nodata value.  Cells are processed in parallel.
+    void fillEmptyCells();
 
     // Fill empty cell at dstI, dstJ with inverse-distance weighted values
     // from neighboring cells.
@@ -32,9 +32,14 @@
  * OF SUCH DAMAGE.
  ****************************************************************************/
 
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+
 #include "Connector.hpp"
 
 #include <pdal/pdal_types.hpp>
+#include <pdal/private/RemoteCache.hpp>
 
 namespace pdal
 {
@@ -50,8 +55,14 @@ std::string Connector::get(const std::string& path) const
 {
     if (m_arbiter->isLocal(path))
         return m_arbiter->get(path);
-    else
-        return m_arbiter->get(path, m_headers, m_query);
+
+    RemoteCache& cache = RemoteCache::instance();
+    std::vector<char> data;
+    if (cache.get(path, 0, 0, data))
+        return std::string(data.begin(), data.end());
+    std::string s = m_arbiter->get(path, m_headers, m_query);
+    cache.put(path, 0, 0, std::vector<char>(s.begin(), s.end()));
+    return s;
 }
 
 NL::json Connector::getJson(const std::string& path) const
@@ -71,8 +82,101 @@ std::vector<char> Connector::getBinary(const std::string& path) const
 {
     if (m_arbiter->isLocal(path))
         return m_arbiter->getBinary(path);
-    else
-        return m_arbiter->getBinary(path, m_headers, m_query);
+
+    RemoteCache& cache = RemoteCache::instance();
+    std::vector<char> data;
+    if (cache.get(path, 0, 0, data))
+        return data;
+    data = m_arbiter->getBinary(path, m_headers, m_query);
+    cache.put(path, 0, 0, data);
+    return data;
+}
+
+
+std::vector<char> Connector::getBinary(const std::string& path,
+    uint64_t offset, uint64_t size) const
+{
+    if (m_arbiter->isLocal(path))
+    {
+        std::ifstream in(path, std::ios::binary);
+        if (!in)
+            throw pdal_error("Couldn't open '" + path + "'.");
+        std::vector<char> data(size);
+        in.seekg(offset);
+        in.read(data.data(), size);
+        if (in.gcount() != (std::streamsize)size)
+            throw pdal_error("Short read of byte range from '" + path + "'.");
+        return data;
+    }
+
+    RemoteCache& cache = RemoteCache::instance();
+    std::vector<char> cached;
+    if (cache.get(path, offset, size, cached))
+        return cached;
+
+    // Ranged GET.  The range is inclusive of its endpoints.
+    StringMap headers(m_headers);
+    headers["Range"] = "bytes=" + std::to_string(offset) + "-" +
+        std::to_string(offset + size - 1);
+    std::vector<char> data = m_arbiter->getBinary(path, headers, m_query);
+    if (data.size() < size)
+        throw pdal_error("Short read of byte range from '" + path + "'.");
+    // A server that ignores the Range header returns the whole resource.
+    if (data.size() > size)
+    {
+        std::copy(data.begin() + offset, data.begin() + offset + size,
+            data.begin());
+        data.resize(size);
+    }
+    cache.put(path, offset, size, data);
+    return data;
+}
+
+
+std::vector<std::vector<char>> Connector::getRanges(const std::string& path,
+    const std::vector<Range>& ranges) const
+{
+    // Neighboring ranges separated by no more than this many bytes are
+    // fetched with a single request - the gap is cheaper to transfer than
+    // another round trip.
+    const uint64_t maxGap = 32768;
+
+    std::vector<std::vector<char>> out(ranges.size());
+    if (ranges.empty())
+        return out;
+
+    // Visit the ranges in offset order, coalescing while they remain
+    // within the gap limit.
+    std::vector<size_t> order(ranges.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+        [&ranges](size_t a, size_t b)
+        { return ranges[a].offset < ranges[b].offset; });
+
+    size_t pos = 0;
+    while (pos < order.size())
+    {
+        uint64_t start = ranges[order[pos]].offset;
+        uint64_t end = start + ranges[order[pos]].size;
+        size_t last = pos;
+        while (last + 1 < order.size() &&
+            ranges[order[last + 1]].offset <= end + maxGap)
+        {
+            last++;
+            end = (std::max)(end,
+                ranges[order[last]].offset + ranges[order[last]].size);
+        }
+
+        std::vector<char> span = getBinary(path, start, end - start);
+        for (size_t i = pos; i <= last; ++i)
+        {
+            const Range& r = ranges[order[i]];
+            auto begin = span.begin() + (r.offset - start);
+            out[order[i]].assign(begin, begin + r.size);
+        }
+        pos = last + 1;
+    }
+    return out;
 }
 
 
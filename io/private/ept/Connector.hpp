@@ -48,12 +48,23 @@ class Connector
     StringMap m_query;
 
 public:
+    // A byte range within a resource.
+    struct Range
+    {
+        uint64_t offset;
+        uint64_t size;
+    };
+
     Connector();
     Connector(const StringMap& headers, const StringMap& query);
 
     std::string get(const std::string& path) const;
     NL::json getJson(const std::string& path) const;
     std::vector<char> getBinary(const std::string& path) const;
+    std::vector<char> getBinary(const std::string& path, uint64_t offset,
+        uint64_t size) const;
+    std::vector<std::vector<char>> getRanges(const std::string& path,
+        const std::vector<Range>& ranges) const;
     arbiter::LocalHandle getLocalHandle(const std::string& path) const;
     void put(const std::string& path, const std::vector<char>& data) const;
     void put(const std::string& path, const std::string& data) const;
@@ -60,6 +60,14 @@ void ChamferKernel::addSwitches(ProgramArgs& args)
     Arg& candidate =
         args.add("candidate", "Candidate filename", m_candidateFile);
     candidate.setPositional();
+    args.add("threads", "Number of threads used to query the indices",
+        m_threads, 1);
+}
+
+void ChamferKernel::validateSwitches(ProgramArgs& args)
+{
+    if (m_threads < 1)
+        throw pdal_error("Option 'threads' must be positive.");
 }
 
 PointViewPtr ChamferKernel::loadSet(const std::string& filename,
@@ -80,7 +88,7 @@ int ChamferKernel::execute()
     ColumnPointTable candTable;
     PointViewPtr candView = loadSet(m_candidateFile, candTable);
 
-    double chamfer = Utils::computeChamfer(srcView, candView);
+    double chamfer = Utils::computeChamfer(srcView, candView, m_threads);
 
     MetadataNode root;
     root.add("filenames", m_sourceFile);
@@ -51,10 +51,12 @@ public:
 
 private:
     virtual void addSwitches(ProgramArgs& args);
+    virtual void validateSwitches(ProgramArgs& args);
     PointViewPtr loadSet(const std::string& filename, PointTableRef table);
 
     std::string m_sourceFile;
     std::string m_candidateFile;
+    int m_threads;
 };
 
 } // namespace pdal
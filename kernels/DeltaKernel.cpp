@@ -36,10 +36,18 @@
 
 #include <pdal/Stage.hpp>
 #include <pdal/PDALUtils.hpp>
+#include <pdal/util/ThreadPool.hpp>
 
 namespace pdal
 {
 
+namespace
+{
+// Points per computation chunk.  Chunking keeps delta buffers bounded
+// while output stays in point order.
+const PointId chunkSize = 1024 * 1024;
+}
+
 static StaticPluginInfo const s_info
 {
     "kernels.delta",
@@ -51,7 +59,7 @@ CREATE_STATIC_KERNEL(DeltaKernel, s_info)
 
 std::string DeltaKernel::getName() const { return s_info.name; }
 
-DeltaKernel::DeltaKernel() : m_detail(false), m_allDims(false)
+DeltaKernel::DeltaKernel() : m_detail(false), m_allDims(false), m_csv(false)
 {}
 
 
@@ -65,6 +73,17 @@ void DeltaKernel::addSwitches(ProgramArgs& args)
     args.add("detail", "Output deltas per-point", m_detail);
     args.add("alldims", "Compute diffs for all dimensions (not just X,Y,Z)",
         m_allDims);
+    args.add("csv", "Write per-point deltas as CSV rows to standard output "
+        "as they're computed instead of building a JSON document", m_csv);
+    args.add("threads", "Number of threads used to query the candidate "
+        "index", m_threads, 1);
+}
+
+
+void DeltaKernel::validateSwitches(ProgramArgs& args)
+{
+    if (m_threads < 1)
+        throw pdal_error("Option 'threads' must be positive.");
 }
 
 
@@ -128,6 +147,12 @@ int DeltaKernel::execute()
     KD3Index index(*candView);
     index.build();
 
+    if (m_csv)
+    {
+        dumpCsv(srcView, candView, index, dims);
+        return 0;
+    }
+
     MetadataNode root;
 
     if (m_detail)
@@ -140,26 +165,73 @@ int DeltaKernel::execute()
 }
 
 
+// Compute nearest-neighbor deltas for source points [begin, end), filling
+// one row of dims.size() values per point.  The index queries are
+// read-only, so they run on a pool of threads over disjoint point ranges.
+void DeltaKernel::computeChunk(PointViewPtr& srcView, PointViewPtr& candView,
+    KD3Index& index, DimIndexMap& dims, PointId begin, PointId end,
+    std::vector<double>& deltas)
+{
+    size_t ndims = dims.size();
+    point_count_t numPts = end - begin;
+    deltas.resize(numPts * ndims);
+
+    auto scan = [&](PointId b, PointId e)
+    {
+        PointRef point = srcView->point(0);
+        for (PointId id = b; id < e; ++id)
+        {
+            point.setPointId(id);
+            PointId candId = index.neighbor(point);
+
+            // It may be faster to put in a special case to avoid having to
+            // fetch X, Y and Z, more than once but this is simpler and
+            // I'm thinking in most cases it will make no practical
+            // difference.
+            size_t k = (id - begin) * ndims;
+            for (auto di = dims.begin(); di != dims.end(); ++di, ++k)
+            {
+                DimIndex& d = di->second;
+                deltas[k] = srcView->getFieldAs<double>(d.m_srcId, id) -
+                    candView->getFieldAs<double>(d.m_candId, candId);
+            }
+        }
+    };
+
+    size_t threads = (size_t)(std::min)((point_count_t)m_threads, numPts);
+    if (threads <= 1)
+    {
+        scan(begin, end);
+        return;
+    }
+
+    auto chunkStart = [begin, numPts, threads](size_t t)
+        { return begin + (PointId)(t * numPts / threads); };
+    ThreadPool pool(threads);
+    for (size_t t = 0; t < threads; ++t)
+        pool.add([&scan, &chunkStart, t]()
+            { scan(chunkStart(t), chunkStart(t + 1)); });
+    pool.await();
+}
+
+
 MetadataNode DeltaKernel::dump(PointViewPtr& srcView, PointViewPtr& candView,
     KD3Index& index, DimIndexMap& dims)
 {
     MetadataNode root;
 
-    for (PointId id = 0; id < srcView->size(); ++id)
+    // Accumulating serially from the parallel-computed deltas keeps the
+    // incremental mean identical to a serial run.
+    std::vector<double> deltas;
+    for (PointId begin = 0; begin < srcView->size(); begin += chunkSize)
     {
-        PointRef point = srcView->point(id);
-        PointId candId = index.neighbor(point);
+        PointId end = (std::min)(begin + chunkSize, (PointId)srcView->size());
+        computeChunk(srcView, candView, index, dims, begin, end, deltas);
 
-        // It may be faster to put in a special case to avoid having to
-        // fetch X, Y and Z, more than once but this is simpler and
-        // I'm thinking in most cases it will make no practical difference.
-        for (auto di = dims.begin(); di != dims.end(); ++di)
-        {
-            DimIndex& d = di->second;
-            double sv = srcView->getFieldAs<double>(d.m_srcId, id);
-            double cv = candView->getFieldAs<double>(d.m_candId, candId);
-            accumulate(d, sv - cv);
-        }
+        size_t k = 0;
+        for (PointId id = begin; id < end; ++id)
+            for (auto di = dims.begin(); di != dims.end(); ++di)
+                accumulate(di->second, deltas[k++]);
     }
 
     root.add("source", m_sourceFile);
@@ -191,23 +263,51 @@ MetadataNode DeltaKernel::dumpDetail(PointViewPtr& srcView,
 {
     MetadataNode root;
 
-    for (PointId id = 0; id < srcView->size(); ++id)
+    std::vector<double> deltas;
+    for (PointId begin = 0; begin < srcView->size(); begin += chunkSize)
     {
-        PointRef point = srcView->point(id);
-        PointId candId = index.neighbor(point);
+        PointId end = (std::min)(begin + chunkSize, (PointId)srcView->size());
+        computeChunk(srcView, candView, index, dims, begin, end, deltas);
 
-        MetadataNode delta = root.add("delta");
-        delta.add("i", id);
-        for (auto di = dims.begin(); di != dims.end(); ++di)
+        size_t k = 0;
+        for (PointId id = begin; id < end; ++id)
         {
-            DimIndex& d = di->second;
-            double sv = srcView->getFieldAs<double>(d.m_srcId, id);
-            double cv = candView->getFieldAs<double>(d.m_candId, candId);
-
-            delta.add(d.m_name, sv - cv);
+            MetadataNode delta = root.add("delta");
+            delta.add("i", id);
+            for (auto di = dims.begin(); di != dims.end(); ++di)
+                delta.add(di->second.m_name, deltas[k++]);
         }
     }
     return root;
 }
 
+
+// Stream per-point deltas as CSV rows rather than accumulating a
+// metadata node per point -- the JSON detail output doesn't scale to
+// hundred-million point comparisons.
+void DeltaKernel::dumpCsv(PointViewPtr& srcView, PointViewPtr& candView,
+    KD3Index& index, DimIndexMap& dims)
+{
+    std::cout << "\"ID\"";
+    for (auto di = dims.begin(); di != dims.end(); ++di)
+        std::cout << ",\"Delta" << di->second.m_name << "\"";
+    std::cout << "\n";
+
+    std::vector<double> deltas;
+    for (PointId begin = 0; begin < srcView->size(); begin += chunkSize)
+    {
+        PointId end = (std::min)(begin + chunkSize, (PointId)srcView->size());
+        computeChunk(srcView, candView, index, dims, begin, end, deltas);
+
+        size_t k = 0;
+        for (PointId id = begin; id < end; ++id)
+        {
+            std::cout << id;
+            for (size_t d = 0; d < dims.size(); ++d)
+                std::cout << ',' << Utils::toString(deltas[k++]);
+            std::cout << '\n';
+        }
+    }
+}
+
 } // pdal
@@ -71,11 +71,17 @@ public:
 
 private:
     void addSwitches(ProgramArgs& args);
+    void validateSwitches(ProgramArgs& args);
     PointViewPtr loadSet(const std::string& filename, PointTableRef table);
     MetadataNode dump(PointViewPtr& srcView, PointViewPtr& candView,
         KD3Index& index, DimIndexMap& dims);
     MetadataNode dumpDetail(PointViewPtr& srcView, PointViewPtr& candView,
         KD3Index& index, DimIndexMap& dims);
+    void dumpCsv(PointViewPtr& srcView, PointViewPtr& candView,
+        KD3Index& index, DimIndexMap& dims);
+    void computeChunk(PointViewPtr& srcView, PointViewPtr& candView,
+        KD3Index& index, DimIndexMap& dims, PointId begin, PointId end,
+        std::vector<double>& deltas);
     void accumulate(DimIndex& d, double v);
 
     std::string m_sourceFile;
@@ -83,6 +89,8 @@ private:
 
     bool m_detail;
     bool m_allDims;
+    bool m_csv;
+    int m_threads;
 };
 
 } // namespace pdal
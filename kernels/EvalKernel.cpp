@@ -38,12 +38,40 @@
 #include <pdal/PDALUtils.hpp>
 #include <pdal/pdal_config.hpp>
 #include <pdal/util/ProgramArgs.hpp>
+#include <pdal/util/ThreadPool.hpp>
+
+#include "../filters/StreamCallbackFilter.hpp"
 
 namespace pdal
 {
 
 using namespace Dimension;
 
+namespace
+{
+
+// The coordinates and predicted class of one point, held while a batch
+// accumulates for tallying.
+struct PredPoint
+{
+    double x;
+    double y;
+    double z;
+    int cls;
+};
+
+// Map a classification value to its confusion matrix row/column.  Values
+// not in the label list map to the trailing "other" slot.
+size_t labelIndex(const std::vector<int>& labelList, int val)
+{
+    auto it = std::find(labelList.begin(), labelList.end(), val);
+    if (it != labelList.end())
+        return std::distance(labelList.begin(), it);
+    return labelList.size();
+}
+
+} // unnamed namespace
+
 static StaticPluginInfo const s_info{
     "kernels.eval", "Eval Kernel", "http://pdal.io/kernels/kernels.eval.html"};
 
@@ -69,6 +97,10 @@ void EvalKernel::addSwitches(ProgramArgs& args)
              m_predictedDimName, "Classification");
     args.add("truth_dim", "Dimension containing truth labels", m_truthDimName,
              "Classification");
+    args.add("threads", "Number of threads used to tally points", m_threads,
+             1);
+    args.add("nostream", "Read the predicted cloud in standard mode",
+             m_noStream);
 }
 
 void EvalKernel::validateSwitches(ProgramArgs& args)
@@ -76,6 +108,8 @@ void EvalKernel::validateSwitches(ProgramArgs& args)
     if (m_labelStrList.empty())
         throw pdal_error(
             "Must specify comma-separated list of labels to evaluate.");
+    if (m_threads < 1)
+        throw pdal_error("Option 'threads' must be positive.");
 }
 
 PointViewPtr EvalKernel::loadSet(const std::string& filename,
@@ -90,14 +124,6 @@ PointViewPtr EvalKernel::loadSet(const std::string& filename,
 
 int EvalKernel::execute()
 {
-    ColumnPointTable predictedTable;
-    PointViewPtr predictedView = loadSet(m_predictedFile, predictedTable);
-    PointLayoutPtr predictedLayout(predictedTable.layout());
-    m_predictedDimId = predictedLayout->findDim(m_predictedDimName);
-    if (m_predictedDimId == Dimension::Id::Unknown)
-        throw pdal_error("Predicted dimension '" + m_predictedDimName +
-                         "' does not exist.");
-
     ColumnPointTable truthTable;
     PointViewPtr truthView = loadSet(m_truthFile, truthTable);
     PointLayoutPtr truthLayout(truthTable.layout());
@@ -106,8 +132,6 @@ int EvalKernel::execute()
         throw pdal_error("Truth dimension '" + m_truthDimName +
                          "' does not exist.");
 
-    assert(predictedView->size() == truthView->size());
-
     KD3Index& kdi = truthView->build3dIndex();
 
     int dim = m_labelStrList.size();
@@ -119,37 +143,110 @@ int EvalKernel::execute()
 
     LabelStats ls(dim);
 
-    for (PointRef p : *predictedView)
+    // Tally a batch of predicted points against the truth cloud.  The KD
+    // queries are read-only, so threads share the index; each thread fills
+    // its own matrix and the results merge when the batch completes.
+    //
+    // It would be nice if we could expect that the points are aligned in
+    // both the predicted and truth clouds, but this often cannot be
+    // guaranteed, so rather than using the same PointId, we search for the
+    // nearest neighbor.
+    //
+    // TODO (chambbj): We should perhaps look at the distance to the
+    // nearest point and reject or otherwise report distances greater than
+    // 0.0, indicating some sort of mismatch between files.
+    auto tally = [&](const std::vector<PredPoint>& batch)
+    {
+        auto scan = [&](LabelStats& stats, size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                const PredPoint& p = batch[i];
+                PointId qid = kdi.neighbor(p.x, p.y, p.z);
+                int qc = truthView->getFieldAs<int>(m_truthDimId, qid);
+                stats.insert((int)labelIndex(labelList, qc),
+                    (int)labelIndex(labelList, p.cls));
+            }
+        };
+
+        size_t threads = (std::min)((size_t)m_threads, batch.size());
+        if (threads <= 1)
+        {
+            scan(ls, 0, batch.size());
+            return;
+        }
+
+        size_t numPts = batch.size();
+        auto chunkStart = [numPts, threads](size_t t)
+            { return t * numPts / threads; };
+        std::vector<LabelStats> partials(threads, LabelStats(dim));
+        ThreadPool pool(threads);
+        for (size_t t = 0; t < threads; ++t)
+            pool.add([&scan, &partials, &chunkStart, t]()
+                { scan(partials[t], chunkStart(t), chunkStart(t + 1)); });
+        pool.await();
+        for (const LabelStats& partial : partials)
+            ls.merge(partial);
+    };
+
+    Stage& reader = makeReader(m_predictedFile, "");
+    if (!m_noStream && reader.pipelineStreamable())
     {
-        // It would be nice if we could expect that the points are aligned in
-        // both the predicted and truth views, but this often cannot be
-        // guaranteed, so rather than using the same PointId, we search for the
-        // nearest neighbor.
-        PointId qid = kdi.neighbor(p);
-        PointRef q = truthView->point(qid);
-
-        // TODO (chambbj): We should perhaps look at the distance to the
-        // nearest point and reject or otherwise report distances greater than
-        // 0.0, indicating some sort of mismatch between files.
-
-        int pc = p.getFieldAs<int>(m_predictedDimId);
-        int qc = q.getFieldAs<int>(m_truthDimId);
-
-        auto it = std::find(labelList.begin(), labelList.end(), qc);
-        size_t qci;
-        if (it != labelList.end())
-            qci = std::distance(labelList.begin(), it);
-        else
-            qci = dim;
-
-        it = std::find(labelList.begin(), labelList.end(), pc);
-        size_t pci;
-        if (it != labelList.end())
-            pci = std::distance(labelList.begin(), it);
-        else
-            pci = dim;
-
-        ls.insert(qci, pci);
+        // Stream the predicted cloud so it's never held in memory whole,
+        // collecting batches that are tallied in parallel.
+        FixedPointTable predictedTable;
+        StreamCallbackFilter collector;
+        collector.setInput(reader);
+        collector.prepare(predictedTable);
+
+        m_predictedDimId =
+            predictedTable.layout()->findDim(m_predictedDimName);
+        if (m_predictedDimId == Dimension::Id::Unknown)
+            throw pdal_error("Predicted dimension '" + m_predictedDimName +
+                             "' does not exist.");
+
+        const size_t batchPoints = 1024 * 1024;
+        std::vector<PredPoint> batch;
+        batch.reserve(batchPoints);
+        collector.setCallback([&](PointRef& point)
+        {
+            batch.push_back({ point.getFieldAs<double>(Dimension::Id::X),
+                point.getFieldAs<double>(Dimension::Id::Y),
+                point.getFieldAs<double>(Dimension::Id::Z),
+                point.getFieldAs<int>(m_predictedDimId) });
+            if (batch.size() == batchPoints)
+            {
+                tally(batch);
+                batch.clear();
+            }
+            return true;
+        });
+        collector.execute(predictedTable);
+        tally(batch);
+    }
+    else
+    {
+        ColumnPointTable predictedTable;
+        reader.prepare(predictedTable);
+        PointViewSet viewSet = reader.execute(predictedTable);
+        assert(viewSet.size() == 1);
+        PointViewPtr predictedView = *viewSet.begin();
+        m_predictedDimId =
+            predictedTable.layout()->findDim(m_predictedDimName);
+        if (m_predictedDimId == Dimension::Id::Unknown)
+            throw pdal_error("Predicted dimension '" + m_predictedDimName +
+                             "' does not exist.");
+
+        assert(predictedView->size() == truthView->size());
+
+        std::vector<PredPoint> batch;
+        batch.reserve(predictedView->size());
+        for (PointRef p : *predictedView)
+            batch.push_back({ p.getFieldAs<double>(Dimension::Id::X),
+                p.getFieldAs<double>(Dimension::Id::Y),
+                p.getFieldAs<double>(Dimension::Id::Z),
+                p.getFieldAs<int>(m_predictedDimId) });
+        tally(batch);
     }
 
     MetadataNode root;
@@ -168,6 +168,12 @@ public:
         m_confusionMatrix(qci, pci)++;
     }
 
+    // Add another set of tallies into this one.
+    void merge(const LabelStats& other)
+    {
+        m_confusionMatrix += other.m_confusionMatrix;
+    }
+
 private:
     MatrixXi m_confusionMatrix;
     int m_dim;
@@ -192,6 +198,8 @@ private:
     std::string m_truthDimName;
     Dimension::Id m_predictedDimId;
     Dimension::Id m_truthDimId;
+    int m_threads;
+    bool m_noStream;
 };
 
 } // namespace pdal
@@ -64,6 +64,15 @@ void HausdorffKernel::addSwitches(ProgramArgs& args)
     Arg& candidate = args.add("candidate", "Candidate filename",
                               m_candidateFile);
     candidate.setPositional();
+    args.add("threads", "Number of threads used to query the indices",
+        m_threads, 1);
+}
+
+
+void HausdorffKernel::validateSwitches(ProgramArgs& args)
+{
+    if (m_threads < 1)
+        throw pdal_error("Option 'threads' must be positive.");
 }
 
 
@@ -86,7 +95,8 @@ int HausdorffKernel::execute()
     ColumnPointTable candTable;
     PointViewPtr candView = loadSet(m_candidateFile, candTable);
 
-    std::pair<double, double> result = Utils::computeHausdorffPair(srcView, candView);
+    std::pair<double, double> result =
+        Utils::computeHausdorffPair(srcView, candView, m_threads);
 
     MetadataNode root;
     root.add("filenames", m_sourceFile);
@@ -0,0 +1,94 @@
+/******************************************************************************
+* Copyright (c) 2026, Hobu Inc.
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. nor the names of its contributors
+*       may be used to endorse or promote products derived from this
+*       software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#include "IndexKernel.hpp"
+
+#include <pdal/KDIndex.hpp>
+#include <pdal/Stage.hpp>
+
+namespace pdal
+{
+
+static StaticPluginInfo const s_info
+{
+    "kernels.index",
+    "Index Kernel",
+    "http://pdal.io/apps/index_command.html"
+};
+
+CREATE_STATIC_KERNEL(IndexKernel, s_info)
+
+std::string IndexKernel::getName() const
+{
+    return s_info.name;
+}
+
+
+void IndexKernel::addSwitches(ProgramArgs& args)
+{
+    args.add("input,i", "Input filename", m_inputFile).setPositional();
+    args.add("output,o", "Output index filename (defaults to the input "
+        "filename with '.kd3' appended)", m_outputFile).setOptionalPositional();
+}
+
+
+int IndexKernel::execute()
+{
+    Stage& readerStage = makeReader(m_inputFile, m_driverOverride);
+
+    ColumnPointTable table;
+    readerStage.prepare(table);
+    PointViewSet viewSet = readerStage.execute(table);
+    if (viewSet.empty())
+        throw pdal_error("Input file contains no points to index.");
+
+    // A sidecar describes a single tile; fold any extra views into the
+    // first so the index covers everything the reader produced.
+    PointViewPtr view = *viewSet.begin();
+    for (auto vi = std::next(viewSet.begin()); vi != viewSet.end(); ++vi)
+        view->append(**vi);
+
+    KD3Index index(*view);
+    index.build();
+
+    std::string outputFile = m_outputFile.size() ?
+        m_outputFile : KD3Index::indexFilename(m_inputFile);
+    index.save(outputFile);
+
+    m_log->get(LogLevel::Info) << "Wrote index of " << view->size() <<
+        " points to '" << outputFile << "'.\n";
+
+    return 0;
+}
+
+} // namespace pdal
@@ -40,6 +40,8 @@
 #include <pdal/pdal_features.hpp>
 
 #include <filters/InfoFilter.hpp>
+#include "private/QuickInfoCache.hpp"
+
 #include <pdal/KDIndex.hpp>
 #include <pdal/PipelineWriter.hpp>
 #include <pdal/PDALUtils.hpp>
@@ -61,8 +63,10 @@ std::string InfoKernel::getName() const { return s_info.name; }
 
 InfoKernel::InfoKernel() : m_showStats(false), m_showSchema(false),
     m_showAll(false), m_showMetadata(false), m_boundary(false),
-    m_showSummary(false), m_needPoints(false), m_statsStage(nullptr),
-    m_hexbinStage(nullptr), m_infoStage(nullptr), m_reader(nullptr)
+    m_showSummary(false), m_needPoints(false), m_stream(false),
+    m_noStream(false), m_execMode(ExecMode::PreferStream),
+    m_statsStage(nullptr), m_hexbinStage(nullptr), m_infoStage(nullptr),
+    m_reader(nullptr)
 {}
 
 
@@ -123,6 +127,21 @@ void InfoKernel::validateSwitches(ProgramArgs& args)
         throw pdal_error("'enumerate' option requires 'stats' option.");
     if (!m_showStats && m_dimensions.size())
         throw pdal_error("'dimensions' option requires 'stats' option.");
+
+    if (m_cacheDir.size() && !m_showSummary)
+        throw pdal_error("'cachedir' option requires 'summary' option.");
+    if (m_cacheDir.size())
+        m_qiCache.reset(new QuickInfoCache(m_cacheDir));
+
+    if (m_stream && m_noStream)
+        throw pdal_error("Can't execute with 'stream' and 'nostream' "
+            "options.");
+    if (m_stream)
+        m_execMode = ExecMode::Stream;
+    else if (m_noStream)
+        m_execMode = ExecMode::Standard;
+    else
+        m_execMode = ExecMode::PreferStream;
 }
 
 
@@ -149,8 +168,14 @@ void InfoKernel::addSwitches(ProgramArgs& args)
     args.add("pipeline-serialization", "Output filename for pipeline "
         "serialization", m_pipelineFile);
     args.add("summary", "Dump summary of the info", m_showSummary);
+    args.add("cachedir", "Directory of cached summary results.  Summaries "
+        "of files that haven't changed since their cache entry was written "
+        "are read from the cache instead of the file.", m_cacheDir);
     args.add("metadata", "Dump file metadata info", m_showMetadata);
     args.add("stdin,s", "Read a pipeline file from standard input", m_usestdin);
+    args.add("stream", "Run in stream mode with constant memory.  Error if "
+        "not streamable.", m_stream);
+    args.add("nostream", "Run in standard mode.", m_noStream);
 }
 
 
@@ -225,10 +250,18 @@ MetadataNode InfoKernel::run(const std::string& filename)
 {
     MetadataNode root;
 
-    makeReader(filename);
     if (m_showSummary)
     {
-        QuickInfo qi = m_manager.getStage()->preview();
+        // A cached summary lets catalog-wide crawls skip files that
+        // haven't changed.
+        QuickInfo qi;
+        if (!m_qiCache || !m_qiCache->fetch(filename, qi))
+        {
+            makeReader(filename);
+            qi = m_manager.getStage()->preview();
+            if (m_qiCache)
+                m_qiCache->store(filename, qi);
+        }
         if (!qi.valid())
             throw pdal_error("No summary data available for '" +
                 filename + "'.");
@@ -236,9 +269,18 @@ MetadataNode InfoKernel::run(const std::string& filename)
     }
     else
     {
+        makeReader(filename);
         makePipeline();
         if (m_needPoints || m_showMetadata)
-            m_manager.execute(ExecMode::PreferStream);
+        {
+            PipelineManager::ExecResult res = m_manager.execute(m_execMode);
+            if (res.m_mode == ExecMode::None)
+                throw pdal_error("Couldn't run pipeline in requested "
+                    "execution mode.");
+            m_log->get(LogLevel::Debug) << "Executed in " <<
+                (res.m_mode == ExecMode::Stream ? "stream" : "standard") <<
+                " mode.\n";
+        }
         else
             m_manager.prepare();
         dump(root);
@@ -40,6 +40,8 @@
 #include <pdal/Stage.hpp>
 #include <pdal/util/FileUtils.hpp>
 
+#include <memory>
+
 #ifdef __clang__
 #pragma GCC diagnostic ignored "-Wtautological-constant-out-of-range-compare"
 #endif
@@ -47,6 +49,8 @@
 namespace pdal
 {
 
+class QuickInfoCache;
+
 class PDAL_DLL InfoKernel : public Kernel
 {
 public:
@@ -84,6 +88,11 @@ private:
     bool m_showSummary;
     bool m_needPoints;
     bool m_usestdin;
+    bool m_stream;
+    bool m_noStream;
+    ExecMode m_execMode;
+    std::string m_cacheDir;
+    std::shared_ptr<QuickInfoCache> m_qiCache;
 
     Stage *m_statsStage;
     Stage *m_hexbinStage;
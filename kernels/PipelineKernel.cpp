@@ -36,10 +36,14 @@
 
 #include "PipelineKernel.hpp"
 
+#include <iomanip>
+
 #ifdef PDAL_HAVE_LIBXML2
 #include <pdal/XMLSchema.hpp>
 #endif
 
+#include <pdal/Stage.hpp>
+
 #include <pdal/PDALUtils.hpp>
 #include <nlohmann/json.hpp>
 
@@ -57,7 +61,8 @@ CREATE_STATIC_KERNEL(PipelineKernel, s_info)
 
 std::string PipelineKernel::getName() const { return s_info.name; }
 
-PipelineKernel::PipelineKernel() : m_validate(false), m_progressFd(-1)
+PipelineKernel::PipelineKernel() : m_validate(false), m_dryRun(false),
+    m_progressFd(-1)
 {}
 
 
@@ -94,6 +99,9 @@ void PipelineKernel::addSwitches(ProgramArgs& args)
         m_pipelineFile);
     args.add("validate", "Validate the pipeline (including serialization), "
         "but do not write points", m_validate);
+    args.add("dry-run", "Validate pipeline structure, stage names and "
+        "option names/types without initializing stages (no driver loads, "
+        "file opens or network access)", m_dryRun);
     args.add("progress",
         "Name of file or FIFO to which stages should write progress "
         "information.  The file/FIFO must exist.  PDAL will not create "
@@ -107,6 +115,16 @@ void PipelineKernel::addSwitches(ProgramArgs& args)
     args.add("nostream", "Run in standard mode.", m_noStream);
     args.add("metadata", "Metadata filename", m_metadataFile);
     args.add("dims", "Dimensions to be stored", m_dimNames);
+    args.add("profile", "Collect and report per-stage execution statistics "
+        "(wall time, CPU time, points/sec)", m_profile);
+    args.add("memory-limit", "Maximum point-storage megabytes allowed in "
+        "standard mode.  Stages raise an error when storage exceeds the "
+        "limit after they run.  Stream mode runs in fixed storage and "
+        "isn't affected.  0 means no limit.", m_memoryLimitMB);
+    args.add("cache-dir", "Directory in which stage results are cached "
+        "across runs.  Stages whose inputs and options are unchanged "
+        "reload their cached output instead of recomputing.  Standard "
+        "mode only.", m_cacheDir);
 }
 
 
@@ -120,17 +138,22 @@ int PipelineKernel::execute()
         m_manager.setProgressFd(m_progressFd);
     }
 
-    if (m_validate)
+    if (m_validate || m_dryRun)
     {
         NL::json root;
         // Validate the options of the pipeline we were
-        // given, and once we succeed, we're done
+        // given, and once we succeed, we're done.  A dry run stops after
+        // checking structure, stage names and option names/types, while
+        // a full validation prepares the stages.
         try
         {
             m_manager.readPipeline(m_inputFile);
             if (!m_manager.hasReader())
                 throw pdal_error("Pipeline does not start with a reader.");
-            m_manager.prepare();
+            if (m_dryRun)
+                m_manager.validate();
+            else
+                m_manager.prepare();
             root["valid"] = true;
             root["error_detail"] = "";
             root["streamable"] = m_manager.pipelineStreamable();
@@ -150,9 +173,56 @@ int PipelineKernel::execute()
     if (!m_manager.hasReader())
         throw pdal_error("Pipeline does not start with a reader.");
     m_manager.pointTable().layout()->setAllowedDims(m_dimNames);
+    if (m_profile)
+        for (Stage *s : m_manager.stages())
+            s->setProfiling(true);
+    if (m_memoryLimitMB)
+        for (Stage *s : m_manager.stages())
+            s->setMemoryLimit((size_t)m_memoryLimitMB * 1024 * 1024);
+    if (m_cacheDir.size())
+        m_manager.setCacheDir(m_cacheDir);
     if (m_manager.execute(m_mode).m_mode == ExecMode::None)
         throw pdal_error("Couldn't run pipeline in requested execution mode.");
 
+    if (m_profile)
+    {
+        // Attach the collected statistics to each stage's metadata and
+        // print a summary.  Stall time is time not spent computing --
+        // mostly I/O and lock waits.
+        std::cerr << std::left << std::setw(25) << "Stage" <<
+            std::right << std::setw(12) << "Wall(s)" <<
+            std::setw(12) << "CPU(s)" <<
+            std::setw(12) << "Stall(s)" <<
+            std::setw(14) << "Points" <<
+            std::setw(14) << "Points/s" <<
+            std::setw(12) << "Peak(MB)" << std::endl;
+        for (Stage *s : m_manager.stages())
+        {
+            const Stage::Profile& p = s->profile();
+            double stall = (std::max)(0.0, p.wallTime - p.cpuTime);
+            double rate = p.wallTime > 0 ? p.pointCount / p.wallTime : 0;
+
+            MetadataNode prof = s->getMetadata().add("profile");
+            prof.add("wall_time", p.wallTime);
+            prof.add("cpu_time", p.cpuTime);
+            prof.add("stall_time", stall);
+            prof.add("point_count", p.pointCount);
+            prof.add("points_per_second", rate);
+            prof.add("peak_memory", p.peakMemory);
+
+            std::cerr << std::left << std::setw(25) <<
+                (s->tag().size() ? s->tag() : s->getName()) <<
+                std::right << std::fixed << std::setprecision(3) <<
+                std::setw(12) << p.wallTime <<
+                std::setw(12) << p.cpuTime <<
+                std::setw(12) << stall <<
+                std::setw(14) << p.pointCount <<
+                std::setw(14) << std::setprecision(0) << rate <<
+                std::setw(12) << std::setprecision(1) <<
+                (p.peakMemory / (1024.0 * 1024.0)) << std::endl;
+        }
+    }
+
     if (m_metadataFile.size())
     {
         std::ostream *out = Utils::createFile(m_metadataFile, false);
@@ -58,12 +58,16 @@ private:
     std::string m_pipelineFile;
     std::string m_metadataFile;
     bool m_validate;
+    bool m_dryRun;
     std::string m_PointCloudSchemaOutput;
     std::string m_progressFile;
     int m_progressFd;
     bool m_usestdin;
     bool m_stream;
     bool m_noStream;
+    bool m_profile;
+    uint64_t m_memoryLimitMB;
+    std::string m_cacheDir;
     ExecMode m_mode;
     StringList m_dimNames;
 };
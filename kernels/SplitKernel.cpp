@@ -34,6 +34,11 @@
 
 #include "SplitKernel.hpp"
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 #include <io/BufferReader.hpp>
 #include <pdal/StageFactory.hpp>
 #include <pdal/util/Utils.hpp>
@@ -66,6 +71,8 @@ void SplitKernel::addSwitches(ProgramArgs& args)
         std::numeric_limits<double>::quiet_NaN());
     args.add("origin_y", "Origin in Y axis for splitter cells", m_yOrigin,
         std::numeric_limits<double>::quiet_NaN());
+    args.add("threads", "Number of threads used to write output files",
+        m_threads, 1);
 }
 
 
@@ -75,6 +82,8 @@ void SplitKernel::validateSwitches(ProgramArgs& args)
         throw pdal_error("Can't specify both length and capacity.");
     if (!m_length && !m_capacity)
         m_capacity = 100000;
+    if (m_threads < 1)
+        throw pdal_error("Option 'threads' must be positive.");
     if (m_outputFile.back() == Utils::dirSeparator)
         m_outputFile += m_inputFile;
 }
@@ -117,17 +126,70 @@ int SplitKernel::execute()
     PointViewSet pvSet = f.execute(table);
 
     int filenum = 1;
+    if (m_threads == 1)
+    {
+        for (auto& pvp : pvSet)
+        {
+            BufferReader reader;
+            reader.addView(pvp);
+
+            std::string filename = makeFilename(m_outputFile, filenum++);
+            Stage& writer = makeWriter(filename, reader, "");
+
+            writer.prepare(table);
+            writer.execute(table);
+        }
+        return 0;
+    }
+
+    // Stage creation isn't thread-safe, so build all the writers up front
+    // and only distribute the prepare/execute calls.  The views are
+    // disjoint, so each writer gets its own point table.
+    std::vector<std::unique_ptr<BufferReader>> readers;
+    std::vector<Stage *> writers;
     for (auto& pvp : pvSet)
     {
-        BufferReader reader;
-        reader.addView(pvp);
+        readers.push_back(std::unique_ptr<BufferReader>(new BufferReader));
+        readers.back()->addView(pvp);
 
         std::string filename = makeFilename(m_outputFile, filenum++);
-        Stage& writer = makeWriter(filename, reader, "");
-
-        writer.prepare(table);
-        writer.execute(table);
+        writers.push_back(&makeWriter(filename, *readers.back(), ""));
     }
+
+    std::atomic<size_t> next(0);
+    std::mutex mutex;
+    std::string error;
+
+    auto writeOne = [&]()
+    {
+        while (true)
+        {
+            size_t idx = next.fetch_add(1);
+            if (idx >= writers.size())
+                break;
+            try
+            {
+                ColumnPointTable outTable;
+                writers[idx]->prepare(outTable);
+                writers[idx]->execute(outTable);
+            }
+            catch (const pdal_error& err)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (error.empty())
+                    error = err.what();
+            }
+        }
+    };
+
+    size_t threads = (std::min)((size_t)m_threads, writers.size());
+    std::vector<std::thread> pool;
+    for (size_t t = 0; t < threads; ++t)
+        pool.emplace_back(writeOne);
+    for (auto& t : pool)
+        t.join();
+    if (error.size())
+        throw pdal_error(error);
     return 0;
 }
 
@@ -55,6 +55,7 @@ private:
     double m_length;
     double m_xOrigin;
     double m_yOrigin;
+    int m_threads;
 };
 
 } // namespace pdal
@@ -33,8 +33,12 @@
 ****************************************************************************/
 
 #include "TIndexKernel.hpp"
+#include "private/QuickInfoCache.hpp"
 
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 #include <ogr_api.h>
@@ -104,6 +108,9 @@ void TIndexKernel::addSubSwitches(ProgramArgs& args,
             m_filespec).setOptionalPositional();
         args.add("fast_boundary", "Use extent instead of exact boundary",
             m_fastBoundary);
+        args.add("cachedir", "Directory of cached preview results used "
+            "for fast boundaries.  Files unchanged since their cache "
+            "entry was written aren't reopened.", m_cacheDir);
         args.add("lyr_name", "OGR layer name to write into datasource",
             m_layerName);
         args.add("tindex_name", "Tile index column name", m_tileIndexColumnName,
@@ -118,6 +125,8 @@ void TIndexKernel::addSubSwitches(ProgramArgs& args,
             "Write absolute rather than relative file paths", m_absPath);
         args.add("stdin,s", "Read filespec pattern from standard input",
             m_usestdin);
+        args.add("threads", "Number of threads used to compute file "
+            "boundaries", m_threads, 1);
     }
     else if (subcommand == "merge")
     {
@@ -158,6 +167,11 @@ void TIndexKernel::validateSwitches(ProgramArgs& args)
                 "options.");
         if (args.set("a_srs"))
             m_overrideASrs = true;
+        if (m_cacheDir.size() && !m_fastBoundary)
+            throw pdal_error("'cachedir' option requires 'fast_boundary' "
+                "option.");
+        if (m_cacheDir.size())
+            m_qiCache.reset(new QuickInfoCache(m_cacheDir));
     }
 }
 
@@ -273,25 +287,69 @@ void TIndexKernel::createFile()
 
     FieldIndexes indexes = getFields();
 
-    size_t filecount(0);
+    //ABELL - Not sure why we need to get absolute path here.
+    StringList files = m_files;
+    for (auto& f : files)
+        f = FileUtils::toAbsolutePath(f);
+
+    // Compute the metadata/boundary of each file, farming the work out to
+    // a pool when more than one thread was requested.  Only the feature
+    // writes below touch the OGR dataset, so they stay serial.
     StageFactory factory(false);
-    for (auto f : m_files)
+    std::vector<FileInfo> infos(files.size());
+    std::vector<char> valid(files.size(), 0);
+    if (m_threads > 1)
     {
-        //ABELL - Not sure why we need to get absolute path here.
-        f = FileUtils::toAbsolutePath(f);
-        FileInfo info;
-        if (getFileInfo(factory, f, info))
-        {
-            filecount++;
-            if (!isFileIndexed(indexes, info))
+        std::atomic<size_t> next(0);
+        std::mutex mutex;
+        std::string error;
+        size_t threads = (std::min)((size_t)m_threads, files.size());
+        std::vector<std::thread> pool;
+        for (size_t t = 0; t < threads; ++t)
+            pool.emplace_back([&]()
             {
-                if (createFeature(indexes, info))
-                    m_log->get(LogLevel::Info) << "Indexed file " << f <<
-                    std::endl;
-                else
-                    m_log->get(LogLevel::Error) << "Failed to create feature "
-                        "for file '" << f << "'" << std::endl;
-            }
+                while (true)
+                {
+                    size_t i = next++;
+                    if (i >= files.size())
+                        break;
+                    try
+                    {
+                        valid[i] = getFileInfo(factory, files[i], infos[i]);
+                    }
+                    catch (pdal_error& err)
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        if (error.empty())
+                            error = err.what();
+                    }
+                }
+            });
+        for (auto& t : pool)
+            t.join();
+        if (error.size())
+            throw pdal_error(error);
+    }
+    else
+    {
+        for (size_t i = 0; i < files.size(); ++i)
+            valid[i] = getFileInfo(factory, files[i], infos[i]);
+    }
+
+    size_t filecount(0);
+    for (size_t i = 0; i < files.size(); ++i)
+    {
+        if (!valid[i])
+            continue;
+        filecount++;
+        if (!isFileIndexed(indexes, infos[i]))
+        {
+            if (createFeature(indexes, infos[i]))
+                m_log->get(LogLevel::Info) << "Indexed file " << files[i] <<
+                std::endl;
+            else
+                m_log->get(LogLevel::Error) << "Failed to create feature "
+                    "for file '" << files[i] << "'" << std::endl;
         }
     }
     if (!filecount)
@@ -460,9 +518,12 @@ bool TIndexKernel::createFeature(const FieldIndexes& indexes,
 bool TIndexKernel::fastBoundary(Stage& reader, FileInfo& fileInfo)
 {
     QuickInfo qi = reader.preview();
-    if (!qi.valid())
+    // Some formats can report their dimensions without knowing an extent.
+    if (!qi.valid() || !qi.m_bounds.valid())
         return false;
 
+    if (m_qiCache)
+        m_qiCache->store(fileInfo.m_filename, qi);
     fileInfo.m_boundary = qi.m_bounds.to2d().toWKT();
     if (!qi.m_srs.empty())
         fileInfo.m_srs = qi.m_srs.getWKT();
@@ -496,6 +557,24 @@ bool TIndexKernel::slowBoundary(Stage& hexer, FileInfo& fileInfo)
 bool TIndexKernel::getFileInfo(StageFactory& factory,
     const std::string& filename, FileInfo& fileInfo)
 {
+    fileInfo.m_filename = filename;
+
+    // A cached preview answers a fast-boundary query without opening
+    // the file.
+    if (m_fastBoundary && m_qiCache)
+    {
+        QuickInfo qi;
+        if (m_qiCache->fetch(filename, qi) && qi.m_bounds.valid())
+        {
+            fileInfo.m_boundary = qi.m_bounds.to2d().toWKT();
+            if (!qi.m_srs.empty())
+                fileInfo.m_srs = qi.m_srs.getWKT();
+            FileUtils::fileTimes(filename, &fileInfo.m_ctime,
+                &fileInfo.m_mtime);
+            return true;
+        }
+    }
+
     PipelineManager manager;
     manager.commonOptions() = m_manager.commonOptions();
     manager.stageOptions() = m_manager.stageOptions();
@@ -525,7 +604,6 @@ bool TIndexKernel::getFileInfo(StageFactory& factory,
         return false;
     }
     FileUtils::fileTimes(filename, &fileInfo.m_ctime, &fileInfo.m_mtime);
-    fileInfo.m_filename = filename;
 
     return true;
 }
@@ -38,6 +38,8 @@
 #include <pdal/SubcommandKernel.hpp>
 #include <pdal/util/FileUtils.hpp>
 
+#include <memory>
+
 namespace pdal
 {
     class Polygon;
@@ -47,6 +49,7 @@ namespace gdal
     class SpatialRef;
 }
 
+class QuickInfoCache;
 class StageFactory;
 
 class PDAL_DLL TIndexKernel : public SubcommandKernel
@@ -114,6 +117,9 @@ private:
     bool m_fastBoundary;
     bool m_usestdin;
     bool m_overrideASrs;
+    int m_threads;
+    std::string m_cacheDir;
+    std::shared_ptr<QuickInfoCache> m_qiCache;
 };
 
 } // namespace pdal
@@ -39,6 +39,13 @@
 #include <pdal/Writer.hpp>
 #include <pdal/util/FileUtils.hpp>
 
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <thread>
+
 namespace pdal
 {
 
@@ -75,6 +82,8 @@ void TileKernel::addSwitches(ProgramArgs& args)
         m_buffer);
     args.add("out_srs", "Output SRS to which points will be reprojected",
         m_outSrs);
+    args.add("threads", "Number of threads used to read input files",
+        m_threads, 1);
 }
 
 
@@ -84,6 +93,8 @@ void TileKernel::validateSwitches(ProgramArgs& args)
     if (m_hashPos == std::string::npos)
         throw pdal_error("Output filename must contain a single '#' "
             "template placeholder.");
+    if (m_threads < 1)
+        throw pdal_error("Option 'threads' must be positive.");
 }
 
 
@@ -107,7 +118,17 @@ int TileKernel::execute()
     m_splitter.prepare(m_table);
 
     m_table.finalize();
-    process(readers);
+    if (m_threads > 1)
+    {
+        // Reader threads start at unpredictable times, so the cell origin
+        // has to be fixed before they do.
+        if (std::isnan(m_xOrigin) || std::isnan(m_yOrigin))
+            peekOrigin(files);
+        m_splitter.setOrigin(m_xOrigin, m_yOrigin);
+        processParallel(files);
+    }
+    else
+        process(readers);
     StageWrapper::done(m_splitter, m_table);
     for (auto&& wp : m_writers)
         StageWrapper::done(*wp.second, m_table);
@@ -282,6 +303,269 @@ void TileKernel::process(const Readers& readers)
 }
 
 
+// Fetch the first point of the first non-empty file to establish the cell
+// origin, mirroring the serial origin capture.  Note that the origin comes
+// from the raw point, before any reprojection, as in the serial path.
+void TileKernel::peekOrigin(const StringList& files)
+{
+    for (const std::string& filename : files)
+    {
+        PipelineManager mgr;
+        mgr.commonOptions() = m_manager.commonOptions();
+        mgr.stageOptions() = m_manager.stageOptions();
+
+        Streamable *r =
+            dynamic_cast<Streamable *>(&mgr.makeReader(filename, ""));
+        if (!r)
+            continue;
+        FixedPointTable table(10);
+        r->prepare(table);
+        table.finalize();
+
+        PointRef point(table, 0);
+        StreamableWrapper::ready(*r, table);
+        bool found = StreamableWrapper::processOne(*r, point);
+        if (found)
+        {
+            if (std::isnan(m_xOrigin))
+                m_xOrigin = point.getFieldAs<double>(Dimension::Id::X);
+            if (std::isnan(m_yOrigin))
+                m_yOrigin = point.getFieldAs<double>(Dimension::Id::Y);
+        }
+        StreamableWrapper::done(*r, table);
+        if (found)
+            return;
+    }
+}
+
+
+// Run one reader (and reprojection) per thread, each against its own
+// table, handing packed batches of points to this (the consumer) thread,
+// which runs the splitter and the tile writers.  The queue is bounded by
+// buffered bytes, blocking readers when the writers fall behind.
+void TileKernel::processParallel(const StringList& files)
+{
+    using std::placeholders::_1;
+    using std::placeholders::_2;
+    using std::placeholders::_3;
+    SplitterFilter::PointAdder adder =
+        std::bind(&TileKernel::adder, this, _1, _2, _3);
+
+    // Batches are packed with the dimensions of the master table so that
+    // the consumer can apply them against it directly.
+    DimTypeList dims = m_table.layout()->dimTypes();
+    size_t pointSize = 0;
+    for (const DimType& dt : dims)
+        pointSize += Dimension::size(dt.m_type);
+
+    struct Batch
+    {
+        SpatialReference m_srs;
+        std::vector<char> m_data;
+        point_count_t m_count = 0;
+    };
+
+    static const size_t MaxQueueBytes = 256 * 1024 * 1024;
+
+    std::queue<Batch> queue;
+    std::mutex mutex;
+    std::condition_variable producerCv;
+    std::condition_variable consumerCv;
+    size_t queuedBytes = 0;
+    size_t threads = (std::min)((size_t)m_threads, files.size());
+    size_t activeReaders = threads;
+    std::atomic<size_t> nextFile(0);
+    std::string error;
+
+    StageWrapper::ready(m_splitter, m_table);
+
+    auto readFile = [&](const std::string& filename)
+    {
+        FixedPointTable table(m_table.capacity());
+        PipelineManager mgr;
+        mgr.commonOptions() = m_manager.commonOptions();
+        mgr.stageOptions() = m_manager.stageOptions();
+
+        Streamable *r =
+            dynamic_cast<Streamable *>(&mgr.makeReader(filename, ""));
+        if (!r)
+            throw pdal_error("Driver for input file '" + filename +
+                "' is not streamable.");
+        Streamable *repro = nullptr;
+        if (m_repro)
+        {
+            Options opts;
+            opts.add("out_srs", m_outSrs);
+            repro = dynamic_cast<Streamable *>(
+                &mgr.makeFilter("filters.reprojection", opts));
+        }
+        r->prepare(table);
+        if (repro)
+            repro->prepare(table);
+
+        // Register the dimensions of the master layout so every batch
+        // packs identically, whatever this file provides.
+        for (const DimType& dt : dims)
+            table.layout()->registerDim(dt.m_id, dt.m_type);
+        table.finalize();
+
+        std::vector<bool> skips(table.capacity());
+        PointId idx(0);
+        PointRef point(table, idx);
+
+        StreamableWrapper::ready(*r, table);
+        if (repro)
+            StreamableWrapper::spatialReferenceChanged(*repro,
+                r->getSpatialReference());
+
+        bool finished = !StreamableWrapper::processOne(*r, point);
+        idx++;
+        while (!finished)
+        {
+            while (true)
+            {
+                point.setPointId(idx);
+                finished = !StreamableWrapper::processOne(*r, point);
+                idx++;
+                if (idx == table.capacity() || finished)
+                    break;
+            }
+            PointId last = idx - 1;
+
+            if (repro)
+            {
+                for (idx = 0; idx < last; ++idx)
+                {
+                    point.setPointId(idx);
+                    if (!StreamableWrapper::processOne(*repro, point))
+                        skips[idx] = true;
+                }
+            }
+
+            Batch b;
+            b.m_srs = r->getSpatialReference();
+            b.m_data.reserve(last * pointSize);
+            for (idx = 0; idx < last; ++idx)
+            {
+                if (skips[idx])
+                    continue;
+                point.setPointId(idx);
+                size_t pos = b.m_data.size();
+                b.m_data.resize(pos + pointSize);
+                point.getPackedData(dims, b.m_data.data() + pos);
+                b.m_count++;
+            }
+            for (size_t i = 0; i < skips.size(); ++i)
+                skips[i] = false;
+            idx = 0;
+
+            bool abort = false;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                producerCv.wait(lock, [&]()
+                    { return queuedBytes < MaxQueueBytes || error.size(); });
+                if (error.size())
+                    abort = true;
+                else
+                {
+                    queuedBytes += b.m_data.size();
+                    queue.push(std::move(b));
+                }
+            }
+            consumerCv.notify_one();
+            if (abort)
+                break;
+        }
+        StreamableWrapper::done(*r, table);
+        if (repro)
+            StreamableWrapper::done(*repro, table);
+    };
+
+    std::vector<std::thread> pool;
+    for (size_t t = 0; t < threads; ++t)
+        pool.emplace_back([&]()
+        {
+            while (true)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (error.size())
+                        break;
+                }
+                size_t i = nextFile++;
+                if (i >= files.size())
+                    break;
+                try
+                {
+                    readFile(files[i]);
+                }
+                catch (pdal_error& err)
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (error.empty())
+                        error = err.what();
+                }
+            }
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                activeReaders--;
+            }
+            consumerCv.notify_one();
+        });
+
+    // Drain batches, running the splitter and writers serially.  A writer
+    // error is stashed like a reader error so blocked readers wake and
+    // drain before the rethrow below.
+    PointRef point(m_table, 0);
+    try
+    {
+        while (true)
+        {
+            Batch b;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                consumerCv.wait(lock, [&]()
+                    { return queue.size() || !activeReaders || error.size(); });
+                if (error.size())
+                    break;
+                if (queue.empty())
+                {
+                    if (!activeReaders)
+                        break;
+                    continue;
+                }
+                b = std::move(queue.front());
+                queue.pop();
+                queuedBytes -= b.m_data.size();
+            }
+            producerCv.notify_all();
+
+            if (!b.m_srs.empty())
+                m_table.setSpatialReference(b.m_srs);
+            const char *pos = b.m_data.data();
+            for (point_count_t i = 0; i < b.m_count; ++i)
+            {
+                point.setPointId(0);
+                point.setPackedData(dims, pos);
+                pos += pointSize;
+                m_splitter.processPoint(point, adder);
+            }
+        }
+    }
+    catch (pdal_error& err)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (error.empty())
+            error = err.what();
+    }
+    producerCv.notify_all();
+    for (auto& t : pool)
+        t.join();
+    if (error.size())
+        throw pdal_error(error);
+}
+
+
 void TileKernel::adder(PointRef& point, int xpos, int ypos)
 {
     Coord loc(xpos, ypos);
@@ -57,6 +57,8 @@ private:
     void validateSwitches(ProgramArgs& args);
     Streamable *prepareReader(const std::string& filename);
     void process(const Readers& readers);
+    void processParallel(const StringList& files);
+    void peekOrigin(const StringList& files);
     void checkReaders(const Readers& readers);
     void adder(PointRef& point, int xpos, int ypos);
 
@@ -66,6 +68,7 @@ private:
     double m_xOrigin;
     double m_yOrigin;
     double m_buffer;
+    int m_threads;
     std::map<Coord, Streamable *> m_writers;
     FixedPointTable m_table;
     SplitterFilter m_splitter;
@@ -41,10 +41,19 @@
 #include <pdal/Reader.hpp>
 #include <pdal/StageFactory.hpp>
 #include <pdal/PipelineReaderJSON.hpp>
+#include <pdal/Streamable.hpp>
 #include <pdal/Writer.hpp>
 #include <pdal/util/FileUtils.hpp>
+#include <pdal/util/IStream.hpp>
+#include <pdal/util/ThreadPool.hpp>
 
+#include "../filters/StreamCallbackFilter.hpp"
+#include "../io/BufferReader.hpp"
+#include "../io/LasHeader.hpp"
+
+#include <algorithm>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -90,6 +99,8 @@ void TranslateKernel::addSwitches(ProgramArgs& args)
     args.add("nostream", "Run in standard mode", m_noStream);
     args.add("stream", "Run in stream mode.  Error if not possible.", m_stream);
     args.add("dims", "Dimensions to store", m_dimNames);
+    args.add("jobs,j", "Number of files to translate in parallel when the "
+        "input is a glob", m_jobs, 1);
 }
 
 
@@ -98,6 +109,9 @@ void TranslateKernel::validateSwitches(ProgramArgs&)
     if (m_stream && m_noStream)
         throw pdal_error("Can't specify both 'stream' and 'nostream' options.");
 
+    if (m_jobs < 1)
+        throw pdal_error("Option 'jobs' must be positive.");
+
     if (m_stream)
         m_mode = ExecMode::Stream;
     else if (m_noStream)
@@ -110,7 +124,8 @@ void TranslateKernel::validateSwitches(ProgramArgs&)
 /*
   Build a pipeline from a JSON filter specification.
 */
-void TranslateKernel::makeJSONPipeline()
+void TranslateKernel::makeJSONPipeline(PipelineManager& manager,
+    const std::string& input, const std::string& output)
 {
     std::string json;
 
@@ -120,9 +135,9 @@ void TranslateKernel::makeJSONPipeline()
     if (json.empty())
         json = m_filterJSON;
     std::stringstream in(json);
-    m_manager.readPipeline(in);
+    manager.readPipeline(in);
 
-    std::vector<Stage *> roots = m_manager.roots();
+    std::vector<Stage *> roots = manager.roots();
     if (roots.size() > 1)
         throw pdal_error("Can't process pipeline with more than one root.");
 
@@ -131,31 +146,31 @@ void TranslateKernel::makeJSONPipeline()
         r = dynamic_cast<Reader *>(roots[0]);
     if (r)
     {
-        StageCreationOptions ops { m_inputFile, m_readerType, nullptr,
+        StageCreationOptions ops { input, m_readerType, nullptr,
             Options(), r->tag() };
-        m_manager.replace(r, &m_manager.makeReader(ops));
+        manager.replace(r, &manager.makeReader(ops));
     }
     else
     {
-        r = &m_manager.makeReader(m_inputFile, m_readerType);
+        r = &manager.makeReader(input, m_readerType);
         if (roots.size())
             roots[0]->setInput(*r);
     }
 
-    std::vector<Stage *> leaves = m_manager.leaves();
+    std::vector<Stage *> leaves = manager.leaves();
     if (leaves.size() != 1)
         throw pdal_error("Can't process pipeline with more than one "
             "terminal stage.");
 
     Stage *w = dynamic_cast<Writer *>(leaves[0]);
     if (w)
-        m_manager.replace(w, &m_manager.makeWriter(m_outputFile, m_writerType));
+        manager.replace(w, &manager.makeWriter(output, m_writerType));
     else
     {
         // We know we have a leaf because we added a reader.
-        StageCreationOptions ops { m_outputFile, m_writerType, leaves[0],
+        StageCreationOptions ops { output, m_writerType, leaves[0],
             Options(), "" };  // These last two args just keep compiler quiet.
-        m_manager.makeWriter(ops);
+        manager.makeWriter(ops);
     }
 }
 
@@ -163,12 +178,13 @@ void TranslateKernel::makeJSONPipeline()
 /*
   Build a pipeline from filters specified as command-line arguments.
 */
-void TranslateKernel::makeArgPipeline()
+void TranslateKernel::makeArgPipeline(PipelineManager& manager,
+    const std::string& input, const std::string& output)
 {
     std::string readerType(m_readerType);
     if (!readerType.empty() && !Utils::startsWith(readerType, "readers."))
         readerType.insert(0, "readers.");
-    Stage& reader = m_manager.makeReader(m_inputFile, readerType);
+    Stage& reader = manager.makeReader(input, readerType);
     Stage* stage = &reader;
 
     // add each filter provided on the command-line,
@@ -180,13 +196,324 @@ void TranslateKernel::makeArgPipeline()
         if (!Utils::startsWith(f, "filters."))
             filter_name.insert(0, "filters.");
 
-        Stage& filter = m_manager.makeFilter(filter_name, *stage);
+        Stage& filter = manager.makeFilter(filter_name, *stage);
         stage = &filter;
     }
     std::string writerType(m_writerType);
     if (!writerType.empty() && !Utils::startsWith(writerType, "writers."))
         writerType.insert(0, "writers.");
-    m_manager.makeWriter(m_outputFile, writerType, *stage);
+    manager.makeWriter(output, writerType, *stage);
+}
+
+
+// Run a non-streamable pipeline in segments: maximal streamable runs
+// execute in stream mode and points are materialized only at the
+// non-streamable stages.  Returns false, before altering the pipeline, if
+// its shape doesn't permit segmenting; the caller then runs it whole.
+bool TranslateKernel::executeHybrid()
+{
+    // Gather the linear chain of stages, reader first.
+    std::vector<Stage *> chain;
+    for (Stage *s = m_manager.getStage(); s;)
+    {
+        chain.insert(chain.begin(), s);
+        std::vector<Stage *>& inputs = s->getInputs();
+        if (inputs.size() > 1)
+            return false;
+        s = inputs.empty() ? nullptr : inputs.front();
+    }
+
+    auto streamable = [](Stage *s)
+        { return dynamic_cast<Streamable *>(s) != nullptr; };
+
+    // Segmenting only pays off when streamable and non-streamable stages
+    // are mixed.
+    size_t nstream = 0;
+    for (Stage *s : chain)
+        if (streamable(s))
+            nstream++;
+    if (nstream == 0 || nstream == chain.size())
+        return false;
+
+    m_log->get(LogLevel::Debug) << "Running translation pipeline in "
+        "hybrid stream/standard mode." << std::endl;
+
+    PointViewSet views;
+    std::vector<std::unique_ptr<BufferReader>> buffers;
+    std::vector<std::unique_ptr<PointTable>> tables;
+    std::vector<std::unique_ptr<FixedPointTable>> streamTables;
+    std::vector<std::unique_ptr<StreamCallbackFilter>> collectors;
+
+    size_t pos = 0;
+    while (pos < chain.size())
+    {
+        bool stream = streamable(chain[pos]);
+        size_t end = pos + 1;
+        while (end < chain.size() && streamable(chain[end]) == stream)
+            end++;
+
+        Stage *head = chain[pos];
+        Stage *tail = chain[end - 1];
+
+        // Segments after the first read the previous segment's product.
+        if (pos)
+        {
+            buffers.emplace_back(new BufferReader);
+            BufferReader *br = buffers.back().get();
+            for (const PointViewPtr& v : views)
+                br->addView(v);
+            head->getInputs().clear();
+            head->setInput(*br);
+        }
+
+        if (stream && end < chain.size())
+        {
+            // Stream into a callback that materializes the points for the
+            // non-streamable stage that follows.
+            streamTables.emplace_back(new FixedPointTable);
+            FixedPointTable& table = *streamTables.back();
+
+            collectors.emplace_back(new StreamCallbackFilter);
+            StreamCallbackFilter *collector = collectors.back().get();
+            collector->setInput(*tail);
+            collector->prepare(table);
+
+            // The collected view needs a table that outlives this
+            // segment.
+            tables.emplace_back(new PointTable);
+            PointTable& outTable = *tables.back();
+            DimTypeList dims = table.layout()->dimTypes();
+            for (const DimType& dt : dims)
+                outTable.layout()->registerDim(dt.m_id, dt.m_type);
+            PointViewPtr outView(new PointView(outTable));
+
+            std::vector<char> buf(table.layout()->pointSize());
+            collector->setCallback([&outView, &dims, &buf](PointRef& point)
+            {
+                point.getPackedData(dims, buf.data());
+                outView->setPackedPoint(dims, outView->size(), buf.data());
+                return true;
+            });
+            collector->execute(table);
+
+            if (!table.spatialReference().empty())
+                outTable.setSpatialReference(table.spatialReference());
+            views.clear();
+            views.insert(outView);
+        }
+        else if (stream)
+        {
+            // Final segment - the writer consumes the stream.
+            streamTables.emplace_back(new FixedPointTable);
+            FixedPointTable& table = *streamTables.back();
+            tail->prepare(table);
+            tail->execute(table);
+        }
+        else
+        {
+            tables.emplace_back(new PointTable);
+            PointTable& table = *tables.back();
+            tail->prepare(table);
+            views = tail->execute(table);
+        }
+        pos = end;
+    }
+    return true;
+}
+
+
+// Copy a LAZ file without running the codec.  When the translation is a
+// bare readers.las -> writers.las pair whose only writer options set
+// header fields, the compressed chunks, chunk table and VLRs can be
+// copied byte-for-byte and the header patched in place.  Returns false,
+// without touching the output, if the translation doesn't qualify.
+bool TranslateKernel::executePassthrough()
+{
+    auto isLaz = [](const std::string& path)
+        { return Utils::iequals(FileUtils::extension(path), ".laz"); };
+    auto isLas = [](const std::string& type)
+        { return type.empty() || type == "las" || Utils::endsWith(type, ".las"); };
+
+    if (!m_filterType.empty() || !m_filterJSON.empty() ||
+        !m_dimNames.empty() || m_mode != ExecMode::PreferStream)
+        return false;
+    if (!isLaz(m_inputFile) || !isLaz(m_outputFile) ||
+        m_inputFile == m_outputFile)
+        return false;
+    if (!isLas(m_readerType) || !isLas(m_writerType))
+        return false;
+
+    // Writer options that only rewrite header fields keep the chunk data
+    // valid.  'forward' is trivially satisfied - everything not overridden
+    // comes straight from the input.  Any other stage option disqualifies.
+    static const StringList headerOps { "filesource_id", "global_encoding",
+        "system_id", "software_id", "creation_doy", "creation_year",
+        "forward" };
+    Options writerOps;
+    for (auto& so : m_manager.stageOptions())
+    {
+        if (so.first == "writers.las")
+            writerOps = so.second;
+        else if (so.second.getOptions().size())
+            return false;
+    }
+    for (const Option& op : writerOps.getOptions())
+        if (std::find(headerOps.begin(), headerOps.end(), op.getName()) ==
+                headerOps.end())
+            return false;
+
+    ILeStream in(m_inputFile);
+    if (!in.good())
+        return false;
+    LasHeader header;
+    in >> header;
+    in.close();
+    if (!header.compressed())
+        return false;
+
+    m_log->get(LogLevel::Debug) << "Copying compressed chunks from '" <<
+        m_inputFile << "' without recompression.\n";
+
+    std::istream *src = FileUtils::openFile(m_inputFile);
+    std::ostream *dst = FileUtils::createFile(m_outputFile);
+    if (!src || !dst)
+        throw pdal_error("Couldn't copy '" + m_inputFile + "' to '" +
+            m_outputFile + "'.");
+
+    // All the header fields we allow rewriting live in the first 94
+    // bytes, ahead of any version-dependent layout.  Patch them in a
+    // buffered prefix and stream the rest of the file through untouched.
+    char prefix[94];
+    src->read(prefix, sizeof(prefix));
+    auto patch16 = [&prefix](size_t pos, const Option& op)
+    {
+        uint16_t v;
+        if (!Utils::fromString(op.getValue(), v))
+            throw pdal_error("writers.las: Can't convert option '" +
+                op.getName() + "' value '" + op.getValue() +
+                "' to unsigned integer.");
+        prefix[pos] = (char)(v & 0xFF);
+        prefix[pos + 1] = (char)(v >> 8);
+    };
+    auto patchStr = [&prefix](size_t pos, const Option& op)
+    {
+        std::string s = op.getValue();
+        s.resize(32, '\0');
+        std::copy(s.begin(), s.end(), prefix + pos);
+    };
+    for (const Option& op : writerOps.getOptions())
+    {
+        const std::string& name = op.getName();
+        if (name == "filesource_id")
+            patch16(4, op);
+        else if (name == "global_encoding")
+            patch16(6, op);
+        else if (name == "system_id")
+            patchStr(26, op);
+        else if (name == "software_id")
+            patchStr(58, op);
+        else if (name == "creation_doy")
+            patch16(90, op);
+        else if (name == "creation_year")
+            patch16(92, op);
+    }
+    dst->write(prefix, sizeof(prefix));
+    *dst << src->rdbuf();
+    FileUtils::closeFile(src);
+    FileUtils::closeFile(dst);
+    return true;
+}
+
+
+// Wildcards in the input name put the kernel in batch mode, unless they
+// name an actual file.
+bool TranslateKernel::batchInput() const
+{
+    return m_inputFile.find_first_of("*?[") != std::string::npos &&
+        !FileUtils::fileExists(m_inputFile);
+}
+
+
+// Build and run the pipeline for a single input file of a batch.
+void TranslateKernel::translateOne(const std::string& input,
+    const std::string& output)
+{
+    PipelineManager manager;
+    manager.setLog(m_log);
+    manager.stageOptions() = m_manager.stageOptions();
+
+    if (!m_filterJSON.empty())
+        makeJSONPipeline(manager, input, output);
+    else
+        makeArgPipeline(manager, input, output);
+    manager.pointTable().layout()->setAllowedDims(m_dimNames);
+    if (manager.execute(m_mode).m_mode == ExecMode::None)
+        throw pdal_error("Couldn't run translation pipeline in requested "
+            "execution mode.");
+}
+
+
+// Translate each file matching the input glob, running up to 'jobs'
+// independent pipelines at once in this process.  Plugin registration,
+// SRS parsing and GDAL setup are shared across all of them instead of
+// being repeated per file by an external driver.
+int TranslateKernel::executeBatch()
+{
+    StringList inputs = FileUtils::glob(m_inputFile);
+    if (inputs.empty())
+        throw pdal_error("No files match input pattern '" + m_inputFile +
+            "'.");
+    if (m_outputFile.find('#') == std::string::npos)
+        throw pdal_error("Output filename must contain a '#' template "
+            "character (replaced by each input filename stem) when the "
+            "input is a glob.");
+    if (m_metadataFile.size() || m_pipelineOutputFile.size())
+        throw pdal_error("Can't use 'metadata' or 'pipeline' options when "
+            "translating multiple files.");
+
+    auto outputName = [this](const std::string& input)
+    {
+        std::string out(m_outputFile);
+        out.replace(out.find('#'), 1,
+            FileUtils::stem(FileUtils::getFilename(input)));
+        return out;
+    };
+
+    m_log->get(LogLevel::Debug) << "Translating " << inputs.size() <<
+        " files, " << m_jobs << " at a time." << std::endl;
+
+    std::mutex mutex;
+    StringList errors;
+    auto translate = [&](const std::string& input)
+    {
+        try
+        {
+            translateOne(input, outputName(input));
+        }
+        catch (const std::exception& e)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            errors.push_back(input + ": " + e.what());
+        }
+    };
+
+    if (m_jobs > 1)
+    {
+        ThreadPool pool((std::size_t)m_jobs, -1, false);
+        for (const std::string& input : inputs)
+            pool.add([&translate, input]() { translate(input); });
+        pool.join();
+    }
+    else
+        for (const std::string& input : inputs)
+            translate(input);
+
+    for (const std::string& e : errors)
+        m_log->get(LogLevel::Error) << e << std::endl;
+    if (errors.size())
+        throw pdal_error(std::to_string(errors.size()) + " of " +
+            std::to_string(inputs.size()) + " translations failed.");
+    return 0;
 }
 
 
@@ -197,6 +524,9 @@ int TranslateKernel::execute()
     if (m_filterJSON.size() && m_filterType.size())
         throw pdal_error("Cannot set both --filter options and --json options");
 
+    if (batchInput())
+        return executeBatch();
+
     if (m_metadataFile.size())
     {
         if (m_pipelineOutputFile.size())
@@ -212,9 +542,9 @@ int TranslateKernel::execute()
     }
 
     if (!m_filterJSON.empty())
-        makeJSONPipeline();
+        makeJSONPipeline(m_manager, m_inputFile, m_outputFile);
     else
-        makeArgPipeline();
+        makeArgPipeline(m_manager, m_inputFile, m_outputFile);
 
     // If we write pipeline output, we don't run, and therefore don't write
     if (m_pipelineOutputFile.size() > 0)
@@ -224,15 +554,33 @@ int TranslateKernel::execute()
         return 0;
     }
 
+    // A bare LAZ-to-LAZ translation doesn't need the codec: copy the
+    // compressed chunks and patch the header instead.  Metadata output
+    // requires an execution pass, so it opts out.
+    if (m_metadataFile.empty() && executePassthrough())
+        return 0;
+
     m_manager.pointTable().layout()->setAllowedDims(m_dimNames);
-    if (m_manager.execute(m_mode).m_mode == ExecMode::None)
+
+    // When the pipeline can't stream end-to-end, try running it in
+    // segments so that points are only materialized at the non-streamable
+    // stages.  Dimension limits apply to the manager's table, so fall back
+    // to a single standard run when they're requested.
+    bool done = false;
+    if (m_mode == ExecMode::PreferStream && m_dimNames.empty())
+    {
+        Stage *s = m_manager.getStage();
+        if (s && !s->pipelineStreamable())
+            done = executeHybrid();
+    }
+    if (!done && m_manager.execute(m_mode).m_mode == ExecMode::None)
         throw pdal_error("Couldn't run translation pipeline in requested "
             "execution mode.");
 
     if (metaOut)
     {
         MetadataNode m = m_manager.getMetadata();
-        *metaOut << Utils::toJSON(m);
+        Utils::toJSON(m, *metaOut);
         FileUtils::closeFile(metaOut);
     }
 
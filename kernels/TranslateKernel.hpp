@@ -55,8 +55,15 @@ public:
 private:
     virtual void addSwitches(ProgramArgs& args);
     virtual void validateSwitches(ProgramArgs& args);
-    void makeJSONPipeline();
-    void makeArgPipeline();
+    void makeJSONPipeline(PipelineManager& manager, const std::string& input,
+        const std::string& output);
+    void makeArgPipeline(PipelineManager& manager, const std::string& input,
+        const std::string& output);
+    bool executeHybrid();
+    bool executePassthrough();
+    bool batchInput() const;
+    int executeBatch();
+    void translateOne(const std::string& input, const std::string& output);
 
     std::string m_inputFile;
     std::string m_outputFile;
@@ -70,6 +77,7 @@ private:
     bool m_stream;
     ExecMode m_mode;
     StringList m_dimNames;
+    int m_jobs;
 };
 
 } // namespace pdal
@@ -0,0 +1,161 @@
+/******************************************************************************
+* Copyright (c) 2021, Hobu Inc. (info@hobu.co)
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. nor the names of its
+*       contributors may be used to endorse or promote products derived
+*       from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#include "QuickInfoCache.hpp"
+
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+
+#include <nlohmann/json.hpp>
+
+#include <pdal/util/FileUtils.hpp>
+#include <pdal/util/Utils.hpp>
+
+namespace pdal
+{
+
+QuickInfoCache::QuickInfoCache(const std::string& dir) : m_dir(dir)
+{
+    if (!FileUtils::directoryExists(m_dir))
+        FileUtils::createDirectories(m_dir);
+}
+
+
+bool QuickInfoCache::signature(const std::string& filename, std::string& path,
+    uint64_t& size, int64_t& mtime) const
+{
+    if (!FileUtils::fileExists(filename))
+        return false;
+    path = FileUtils::toAbsolutePath(filename);
+    size = FileUtils::fileSize(filename);
+
+    struct tm mod;
+    FileUtils::fileTimes(filename, nullptr, &mod);
+#ifdef _WIN32
+    mtime = (int64_t)_mkgmtime(&mod);
+#else
+    mtime = (int64_t)timegm(&mod);
+#endif
+    return true;
+}
+
+
+std::string QuickInfoCache::entryPath(const std::string& path) const
+{
+    // FNV-1a of the absolute path names the sidecar.
+    uint64_t h = 14695981039346656037ULL;
+    for (char c : path)
+    {
+        h ^= (uint64_t)(unsigned char)c;
+        h *= 1099511628211ULL;
+    }
+    std::ostringstream name;
+    name << std::hex << std::setw(16) << std::setfill('0') << h;
+    return m_dir + "/" + name.str() + ".json";
+}
+
+
+bool QuickInfoCache::fetch(const std::string& filename, QuickInfo& qi) const
+{
+    std::string path;
+    uint64_t size;
+    int64_t mtime;
+    if (!signature(filename, path, size, mtime))
+        return false;
+
+    std::string entry = entryPath(path);
+    if (!FileUtils::fileExists(entry))
+        return false;
+
+    try
+    {
+        NL::json j = NL::json::parse(FileUtils::readFileIntoString(entry));
+        if (j.at("path").get<std::string>() != path ||
+            j.at("size").get<uint64_t>() != size ||
+            j.at("mtime").get<int64_t>() != mtime)
+            return false;
+
+        qi = QuickInfo();
+        qi.m_pointCount = j.at("num_points").get<point_count_t>();
+        std::string wkt = j.at("srs").get<std::string>();
+        if (wkt.size())
+            qi.m_srs.set(wkt);
+        std::string bounds = j.at("bounds").get<std::string>();
+        if (bounds.size() && !Utils::fromString(bounds, qi.m_bounds))
+            return false;
+        for (auto& d : j.at("dimensions"))
+            qi.m_dimNames.push_back(d.get<std::string>());
+        qi.m_valid = true;
+    }
+    catch (NL::json::exception&)
+    {
+        return false;
+    }
+    return true;
+}
+
+
+void QuickInfoCache::store(const std::string& filename,
+    const QuickInfo& qi) const
+{
+    std::string path;
+    uint64_t size;
+    int64_t mtime;
+    if (!qi.valid() || !signature(filename, path, size, mtime))
+        return;
+
+    NL::json j {
+        { "path", path },
+        { "size", size },
+        { "mtime", mtime },
+        { "num_points", qi.m_pointCount },
+        { "srs", qi.m_srs.getWKT() },
+        { "bounds", qi.m_bounds.valid() ? Utils::toString(qi.m_bounds) :
+            std::string() },
+        { "dimensions", qi.m_dimNames }
+    };
+
+    // Write-then-rename so that concurrent crawlers never see a torn
+    // entry.
+    std::string entry = entryPath(path);
+    std::string tmp = entry + ".tmp";
+    std::ostream *out = FileUtils::createFile(tmp);
+    if (!out)
+        return;
+    *out << j.dump();
+    FileUtils::closeFile(out);
+    FileUtils::renameFile(entry, tmp);
+}
+
+} // namespace pdal
@@ -0,0 +1,72 @@
+/******************************************************************************
+* Copyright (c) 2021, Hobu Inc. (info@hobu.co)
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. nor the names of its
+*       contributors may be used to endorse or promote products derived
+*       from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <pdal/QuickInfo.hpp>
+
+namespace pdal
+{
+
+// Cache of QuickInfo (preview) results for immutable source files, keyed
+// on absolute path plus file size and modification time.  Each entry is a
+// small JSON sidecar in a central cache directory, so repeated metadata
+// crawls over an unchanged catalog skip opening the source files.
+//
+// The cache holds no mutable state and entries are written to a temporary
+// file and renamed into place, so a single instance may be shared by
+// concurrent crawl threads.
+class QuickInfoCache
+{
+public:
+    QuickInfoCache(const std::string& dir);
+
+    // Fill 'qi' from the cache.  Returns false if there is no entry for
+    // 'filename' or the file changed since the entry was written.
+    bool fetch(const std::string& filename, QuickInfo& qi) const;
+
+    // Write a cache entry for 'filename'.  Invalid info isn't cached.
+    void store(const std::string& filename, const QuickInfo& qi) const;
+
+private:
+    bool signature(const std::string& filename, std::string& path,
+        uint64_t& size, int64_t& mtime) const;
+    std::string entryPath(const std::string& path) const;
+
+    std::string m_dir;
+};
+
+} // namespace pdal
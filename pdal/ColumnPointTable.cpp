@@ -64,6 +64,7 @@ PointId ColumnPointTable::addPoint()
             size_t size = m_blockPtCnt * Dimension::size(detail->type());
             char *buf = new char[size];
             memset(buf, 0, size);
+            accountAlloc(size);
             DimBlockList& dimBlocks = m_blocks[detail->order()];
             dimBlocks.push_back(buf);
         }
@@ -165,5 +166,25 @@ const char *ColumnPointTable::getDimension(const Dimension::Detail *d,
     return ncThis->getDimension(d, idx);
 }
 
+
+char *ColumnPointTable::getColumn(const Dimension::Detail *d, PointId first,
+    point_count_t& contiguous)
+{
+    if (first >= m_numPts)
+    {
+        contiguous = 0;
+        return nullptr;
+    }
+
+    // Values for a dimension are contiguous from 'first' to the end of its
+    // block, or to the end of the table if the block is the last.
+    PointId blockStart = first - (first % m_blockPtCnt);
+    contiguous = (std::min)(blockStart + m_blockPtCnt, m_numPts) - first;
+
+    const DimBlockList& dimBlocks = m_blocks[d->order()];
+    char *buf = dimBlocks[first / m_blockPtCnt];
+    return buf + (Dimension::size(d->type()) * (first % m_blockPtCnt));
+}
+
 } // namespace pdal
 
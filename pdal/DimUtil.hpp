@@ -35,6 +35,7 @@
 #pragma once
 
 #include <string>
+#include <type_traits>
 #include <vector>
 
 #include <pdal/util/Utils.hpp>
@@ -170,6 +171,20 @@ inline Type type(std::string s)
     return Type::None;
 }
 
+/// Get the type corresponding to a C++ arithmetic type.
+/// \return  Corresponding type enumeration value.
+template <typename T>
+inline Type type()
+{
+    static_assert(std::is_arithmetic<T>::value,
+        "Dimension storage types are arithmetic.");
+    if (std::is_floating_point<T>::value)
+        return static_cast<Type>((size_t)BaseType::Floating | sizeof(T));
+    if (std::is_signed<T>::value)
+        return static_cast<Type>((size_t)BaseType::Signed | sizeof(T));
+    return static_cast<Type>((size_t)BaseType::Unsigned | sizeof(T));
+}
+
 inline Type type(const std::string& baseType, size_t size)
 {
     BaseType base = fromName(baseType);
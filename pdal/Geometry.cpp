@@ -226,9 +226,11 @@ std::string Geometry::wkt(double precision, bool bOutputZ) const
     // number of places to the right of the decimal.  In g-formatting, it's
     // the minimum number of digits.  Yuck.
 
+    // Thread-local so concurrent exports don't race on the global
+    // config and see each other's precision.
     std::string p(std::to_string((int)precision));
-    CPLSetConfigOption("OGR_WKT_PRECISION", p.data());
-    CPLSetConfigOption("OGR_WKT_ROUND", "FALSE");
+    CPLSetThreadLocalConfigOption("OGR_WKT_PRECISION", p.data());
+    CPLSetThreadLocalConfigOption("OGR_WKT_ROUND", "FALSE");
 
     char *buf;
     OGRErr err = m_geom->exportToWkt(&buf);
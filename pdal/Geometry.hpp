@@ -48,6 +48,10 @@ namespace pdal
 
 class BOX3D;
 
+/// Wrapper around an OGR geometry.  Const member functions don't modify
+/// the underlying OGR geometry, so a geometry that's no longer being
+/// changed can be queried (bounds, predicates, WKT/JSON export) from
+/// several threads at once without locking.
 class PDAL_DLL Geometry
 {
 protected:
@@ -32,9 +32,52 @@
 * OF SUCH DAMAGE.
 ****************************************************************************/
 
+#include <cstring>
+#include <istream>
+#include <thread>
+
 #include "KDIndex.hpp"
 #include "private/KDImpl.hpp"
 
+#include <pdal/util/Charbuf.hpp>
+#include <pdal/util/FileUtils.hpp>
+#include <pdal/util/ThreadPool.hpp>
+
+namespace
+{
+
+const uint32_t kd3Magic = 0x33444B50;  // "PKD3"
+const uint32_t kd3Version = 1;
+
+// FNV-1a over the bit patterns of the view's coordinates.  Tying the
+// sidecar to the indexed data rather than to a source file means a load
+// against the wrong (or modified) view just fails the checksum.
+uint64_t viewChecksum(const pdal::PointView& view)
+{
+    using namespace pdal;
+
+    uint64_t h = 0xCBF29CE484222325ULL;
+    auto mix = [&h](double d)
+    {
+        uint64_t u;
+        std::memcpy(&u, &d, sizeof(u));
+        for (int i = 0; i < 8; ++i)
+        {
+            h ^= (u >> (i * 8)) & 0xFF;
+            h *= 0x100000001B3ULL;
+        }
+    };
+    for (PointId i = 0; i < view.size(); ++i)
+    {
+        mix(view.getFieldAs<double>(Dimension::Id::X, i));
+        mix(view.getFieldAs<double>(Dimension::Id::Y, i));
+        mix(view.getFieldAs<double>(Dimension::Id::Z, i));
+    }
+    return h;
+}
+
+} // unnamed namespace
+
 namespace pdal
 {
 
@@ -168,6 +211,46 @@ void KD3Index::build()
     m_impl->build();
 }
 
+std::string KD3Index::indexFilename(const std::string& source)
+{
+    return source + ".kd3";
+}
+
+void KD3Index::save(const std::string& filename) const
+{
+    OLeStream out(filename);
+    if (!out.isOpen())
+        throw pdal_error("KD3Index: can't open index file '" + filename +
+            "' for output.");
+    out << kd3Magic << kd3Version << viewChecksum(m_buf) <<
+        (uint64_t)m_buf.size();
+    m_impl->serialize(out);
+}
+
+bool KD3Index::load(const std::string& filename)
+{
+    if (!FileUtils::fileExists(filename))
+        return false;
+
+    FileUtils::MapContext ctx = FileUtils::mapFile(filename);
+    if (ctx.addr() == nullptr)
+        return false;
+
+    Charbuf charbuf((char *)ctx.addr(), (size_t)ctx.m_size);
+    std::istream stream(&charbuf);
+    ILeStream in(&stream);
+
+    uint32_t magic, version;
+    uint64_t checksum, count;
+    in >> magic >> version >> checksum >> count;
+
+    bool ok = in.good() && magic == kd3Magic && version == kd3Version &&
+        count == m_buf.size() && checksum == viewChecksum(m_buf) &&
+        m_impl->deserialize(in);
+    FileUtils::unmapFile(ctx);
+    return ok;
+}
+
 PointId KD3Index::neighbor(double x, double y, double z) const
 {
     PointIdList ids = neighbors(x, y, z, 1);
@@ -238,6 +321,47 @@ void KD3Index::knnSearch(PointRef &point, point_count_t k,
     knnSearch(x, y, z, k, indices, sqr_dists);
 }
 
+point_count_t KD3Index::knnSearchAll(point_count_t k, PointIdList& indices,
+    std::vector<double>& sqr_dists, size_t threads) const
+{
+    const point_count_t size = m_buf.size();
+
+    k = (std::min)(size, k);
+    indices.resize((size_t)k * size);
+    sqr_dists.resize((size_t)k * size);
+    if (!k)
+        return k;
+
+    if (threads == 0)
+        threads = (std::max)(std::thread::hardware_concurrency(), 1U);
+    threads = (std::min)((point_count_t)threads, size);
+
+    // Queries don't modify the tree, so they can run concurrently.  Each
+    // worker handles a contiguous range of points and writes into its own
+    // slice of the arenas.
+    ThreadPool pool(threads);
+    for (size_t t = 0; t < threads; ++t)
+    {
+        const PointId start = t * size / threads;
+        const PointId end =
+            (t + 1 == threads) ? size : (t + 1) * size / threads;
+        pool.add([this, k, start, end, &indices, &sqr_dists]()
+        {
+            for (PointId i = start; i < end; ++i)
+            {
+                double x = m_buf.getFieldAs<double>(Dimension::Id::X, i);
+                double y = m_buf.getFieldAs<double>(Dimension::Id::Y, i);
+                double z = m_buf.getFieldAs<double>(Dimension::Id::Z, i);
+                m_impl->knnSearch(x, y, z, k,
+                    indices.data() + (size_t)i * k,
+                    sqr_dists.data() + (size_t)i * k);
+            }
+        });
+    }
+    pool.join();
+    return k;
+}
+
 PointIdList KD3Index::radius(double x, double y, double z, double r) const
 {
     return m_impl->radius(x, y, z, r);
@@ -261,6 +385,24 @@ PointIdList KD3Index::radius(PointRef &point, double r) const
     return radius(x, y, z, r);
 }
 
+point_count_t KD3Index::radiusCount(PointRef& point, double r) const
+{
+    double x = point.getFieldAs<double>(Dimension::Id::X);
+    double y = point.getFieldAs<double>(Dimension::Id::Y);
+    double z = point.getFieldAs<double>(Dimension::Id::Z);
+
+    return m_impl->radiusCount(x, y, z, r);
+}
+
+double KD3Index::neighborDist2Bounded(PointRef& point, double bound2) const
+{
+    double x = point.getFieldAs<double>(Dimension::Id::X);
+    double y = point.getFieldAs<double>(Dimension::Id::Y);
+    double z = point.getFieldAs<double>(Dimension::Id::Z);
+
+    return m_impl->nearestDist2Bounded(x, y, z, bound2);
+}
+
 //
 // KDFlexIndex
 //
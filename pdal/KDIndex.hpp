@@ -79,6 +79,37 @@ public:
     ~KD3Index();
 
     void build();
+
+    /**
+      Name of the index sidecar file for a source file: the source name
+      with ".kd3" appended.
+
+      \param source  Source filename.
+      \return  Sidecar filename.
+    */
+    static std::string indexFilename(const std::string& source);
+
+    /**
+      Write the built index to a sidecar file.  The sidecar records a
+      checksum of the view's coordinates so that load() can verify it
+      describes the data it's asked to index.
+
+      \param filename  Sidecar filename to write.
+    */
+    void save(const std::string& filename) const;
+
+    /**
+      Load a previously saved index from a memory-mapped sidecar file in
+      place of building one.  The file is ignored (and false returned) if
+      it's missing, from a different format version or its checksum
+      doesn't match the view, in which case the caller should fall back
+      to build().
+
+      \param filename  Sidecar filename to read.
+      \return  Whether the index was loaded.
+    */
+    bool load(const std::string& filename);
+
     PointId neighbor(double x, double y, double z) const;
     PointId neighbor(PointId idx) const;
     PointId neighbor(PointRef &point) const;
@@ -94,10 +125,53 @@ public:
         std::vector<double> *sqr_dists) const;
     void knnSearch(PointRef &point, point_count_t k,
         PointIdList *indices, std::vector<double> *sqr_dists) const;
+
+    /**
+      Run a k-nearest-neighbor query for every point in the view across a
+      thread pool.  Results for point 'i' land in elements [i * k', (i + 1)
+      * k') of the caller-owned arenas, where k' is the returned effective
+      neighbor count (k clamped to the view size).  The arenas are resized
+      as necessary.
+
+      \param k  Number of neighbors to find for each point.
+      \param indices  Arena for neighbor point IDs.
+      \param sqr_dists  Arena for squared distances to the neighbors.
+      \param threads  Number of worker threads; 0 means one per hardware
+        thread.
+      \return  The effective neighbor count.
+    */
+    point_count_t knnSearchAll(point_count_t k, PointIdList& indices,
+        std::vector<double>& sqr_dists, size_t threads = 0) const;
+
     PointIdList radius(double x, double y, double z, double r) const;
     PointIdList radius(PointId idx, double r) const;
     PointIdList radius(PointRef &point, double r) const;
 
+    /**
+      Count the points within distance \c r of the given point without
+      materializing their ids.  The count matches the size of the list a
+      radius() query would return (including the query point itself when
+      it's in the view).
+
+      \param point  Point to search around.
+      \param r  Search radius.
+      \return  Number of points within the radius.
+    */
+    point_count_t radiusCount(PointRef& point, double r) const;
+
+    /**
+      Squared distance to the nearest neighbor, searched with an early
+      exit: once any point within squared distance \c bound2 is seen, the
+      search stops and returns that distance rather than the true
+      minimum.  Intended for max-of-min reductions, which ignore values
+      inside their current bound.
+
+      \param point  Point to search from.
+      \param bound2  Squared distance below which the search may stop.
+      \return  Squared distance to the nearest neighbor found.
+    */
+    double neighborDist2Bounded(PointRef& point, double bound2) const;
+
 private:
     const PointView& m_buf;
     std::unique_ptr<KD3Impl> m_impl;
@@ -117,28 +117,46 @@ void Log::clearFloat()
 
 std::ostream& Log::get(LogLevel level)
 {
-    const auto incoming(Utils::toNative(level));
-    const auto stored(Utils::toNative(m_level));
-    const auto nativeDebug(Utils::toNative(LogLevel::Debug));
-    if (incoming <= stored)
+    if (wouldLog(level))
     {
-        const std::string l = leader();
-
-        *m_log << "(" << l;
-         if (l.size())
-             *m_log << " ";
-         *m_log << getLevelString(level);
-         if (m_timing)
-             *m_log << " " << now();
-         *m_log <<") " <<
-         std::string(incoming < nativeDebug ? 0 : incoming - nativeDebug,
-             '\t');
+        writeHeader(*m_log, level);
         return *m_log;
     }
     return m_nullStream;
 }
 
 
+bool Log::wouldLog(LogLevel level) const
+{
+    return Utils::toNative(level) <= Utils::toNative(m_level);
+}
+
+
+void Log::writeHeader(std::ostream& out, LogLevel level)
+{
+    const auto incoming(Utils::toNative(level));
+    const auto nativeDebug(Utils::toNative(LogLevel::Debug));
+    const std::string l = leader();
+
+    out << "(" << l;
+    if (l.size())
+        out << " ";
+    out << getLevelString(level);
+    if (m_timing)
+        out << " " << now();
+    out << ") " <<
+        std::string(incoming < nativeDebug ? 0 : incoming - nativeDebug,
+            '\t');
+}
+
+
+void Log::append(const std::string& text)
+{
+    std::lock_guard<std::mutex> lock(m_streamMutex);
+    *m_log << text;
+}
+
+
 std::string Log::getLevelString(LogLevel level) const
 {
     switch (level)
@@ -36,6 +36,8 @@
 
 #include <cassert>
 #include <memory> // shared_ptr
+#include <mutex>
+#include <sstream>
 #include <stack>
 #include <chrono>
 
@@ -104,19 +106,27 @@ public:
     void setLeader(const std::string& leader)
         { pushLeader(leader); }
 
-    /// Push the leader string onto the stack.
+    /// Push the leader string onto the stack.  A log may be shared by
+    /// stages running on different threads, so the stack is locked.
     /// \param  leader  Leader string
     void pushLeader(const std::string& leader)
-        { m_leaders.push(leader); }
+    {
+        std::lock_guard<std::mutex> lock(m_leaderMutex);
+        m_leaders.push(leader);
+    }
 
     /// Get the leader string.
     /// \return  The current leader string.
     std::string leader() const
-        { return m_leaders.empty() ? std::string() : m_leaders.top(); }
+    {
+        std::lock_guard<std::mutex> lock(m_leaderMutex);
+        return m_leaders.empty() ? std::string() : m_leaders.top();
+    }
 
     /// Pop the current leader string.
     void popLeader()
     {
+        std::lock_guard<std::mutex> lock(m_leaderMutex);
         if (!m_leaders.empty())
             m_leaders.pop();
     }
@@ -139,6 +149,24 @@ public:
     /// pdal::Log::get is less than the logging level of the pdal::Log instance
     std::ostream& get(LogLevel level = LogLevel::Info);
 
+    /// Determine whether output at the given level would be logged.
+    /// @param level logging level to test
+    /// @return whether a get() at this level returns the real stream.
+    bool wouldLog(LogLevel level) const;
+
+    /// Write the standard message header (leader, level, timing) to the
+    /// given stream.  Exposed so that LogBuffer can format buffered
+    /// messages identically to direct ones.
+    /// @param out stream to receive the header
+    /// @param level logging level of the message
+    void writeHeader(std::ostream& out, LogLevel level);
+
+    /// Atomically append a block of preformatted output to the log
+    /// stream.  Blocks from different threads interleave whole, never as
+    /// fragments of each other's messages.
+    /// @param text preformatted log output
+    void append(const std::string& text);
+
     /// Sets the floating point precision
     void floatPrecision(int level);
 
@@ -156,11 +184,61 @@ private:
     LogLevel m_level;
     bool m_deleteStreamOnCleanup;
     std::stack<std::string> m_leaders;
+    mutable std::mutex m_leaderMutex;
+    std::mutex m_streamMutex;
     NullOStream m_nullStream;
     bool m_timing;
     std::chrono::steady_clock m_clock;
     std::chrono::steady_clock::time_point m_start;
 };
 
+/// A private log sink for one worker thread.  Output is formatted into
+/// an internal buffer through the usual get() interface and reaches the
+/// shared log as one atomic block - when the owner calls flush(), so a
+/// coordinating stage can flush its workers' buffers in chunk order, or
+/// on destruction.  This lets internally parallelized stages keep
+/// logging without interleaving fragments of each other's messages.
+class PDAL_DLL LogBuffer
+{
+public:
+    /// Construct a buffer sinking to the given log.
+    /// @param log Log that receives the buffered output.
+    LogBuffer(LogPtr log) : m_log(log)
+    {}
+
+    ~LogBuffer()
+    { flush(); }
+
+    /// Returns the buffer with the standard message header emitted, or
+    /// a null stream if the log wouldn't emit output at this level.
+    /// @param level logging level to request
+    std::ostream& get(LogLevel level = LogLevel::Info)
+    {
+        if (!m_log->wouldLog(level))
+            return m_nullStream;
+        m_log->writeHeader(m_buf, level);
+        return m_buf;
+    }
+
+    /// Append everything accumulated so far to the log as one block and
+    /// clear the buffer.
+    void flush()
+    {
+        std::string text = m_buf.str();
+        if (text.empty())
+            return;
+        m_buf.str(std::string());
+        m_log->append(text);
+    }
+
+private:
+    LogBuffer(const LogBuffer&) = delete;
+    LogBuffer& operator=(const LogBuffer&) = delete;
+
+    LogPtr m_log;
+    std::ostringstream m_buf;
+    NullOStream m_nullStream;
+};
+
 } // namespace pdal
 
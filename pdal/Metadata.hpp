@@ -40,8 +40,11 @@
 #include <pdal/util/Utils.hpp>
 #include <pdal/util/Uuid.hpp>
 
+#include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <unordered_set>
 #include <vector>
 #include <stdint.h>
 
@@ -64,6 +67,58 @@ typedef std::vector<MetadataNodeImplPtr> MetadataImplList;
 typedef std::map<std::string, MetadataImplList> MetadataSubnodes;
 typedef std::vector<MetadataNode> MetadataNodeList;
 
+namespace MetadataDetail
+{
+
+/**
+  A flyweight string for metadata names, types and descriptions.  These
+  fields repeat heavily across nodes -- every LAS VLR node carries the
+  same "user_id"/"record_id" names, type strings come from a small fixed
+  set and descriptions recur across files -- so each distinct value is
+  stored once in a process-wide pool and nodes hold only a pointer.
+  Pooled strings are never freed.
+*/
+class InternedString
+{
+public:
+    InternedString() : m_str(intern(std::string()))
+        {}
+    InternedString(const std::string& s) : m_str(intern(s))
+        {}
+    InternedString& operator=(const std::string& s)
+        { m_str = intern(s); return *this; }
+
+    operator const std::string&() const
+        { return *m_str; }
+    bool empty() const
+        { return m_str->empty(); }
+
+    // Separately loaded modules may each have their own pool, so fall
+    // back to content comparison when the pointers differ.
+    bool operator==(const InternedString& other) const
+        { return m_str == other.m_str || *m_str == *other.m_str; }
+    bool operator!=(const InternedString& other) const
+        { return !(*this == other); }
+    bool operator==(const std::string& s) const
+        { return *m_str == s; }
+    bool operator!=(const std::string& s) const
+        { return *m_str != s; }
+
+private:
+    const std::string *m_str;
+
+    static const std::string *intern(const std::string& s)
+    {
+        static std::mutex mutex;
+        static std::unordered_set<std::string> pool;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        return &*pool.insert(s).first;
+    }
+};
+
+} // namespace MetadataDetail
+
 class PDAL_DLL MetadataNodeImpl
 {
     friend class MetadataNode;
@@ -135,7 +190,7 @@ private:
     bool operator == (const MetadataNodeImpl& m) const
     {
         if (m_name != m.m_name || m_descrip != m.m_descrip ||
-            m_type != m.m_type || m_value != m.m_value)
+            m_type != m.m_type || value() != m.value())
             return false;
         if (m_subnodes.size() != m.m_subnodes.size())
             return false;
@@ -189,6 +244,19 @@ private:
         return nc_this->subnodes(name);
     }
 
+    // Run a deferred producer, if any, the first time the value is read.
+    // A value set directly after the producer was attached wins.
+    const std::string& value() const
+    {
+        if (m_producer)
+        {
+            if (m_value.empty())
+                m_value = m_producer();
+            m_producer = nullptr;
+        }
+        return m_value;
+    }
+
     MetadataType nodeType(const std::string& name) const
     {
         const MetadataImplList& l = subnodes(name);
@@ -200,10 +268,11 @@ private:
         return MetadataType::Instance;
     }
 
-    std::string m_name;
-    std::string m_descrip;
-    std::string m_type;
-    std::string m_value;
+    MetadataDetail::InternedString m_name;
+    MetadataDetail::InternedString m_descrip;
+    MetadataDetail::InternedString m_type;
+    mutable std::string m_value;
+    mutable std::function<std::string()> m_producer;
     MetadataType m_kind;
     MetadataSubnodes m_subnodes;
 };
@@ -425,6 +494,17 @@ public:
     MetadataNode addList(MetadataNode node)
         { return MetadataNode(m_impl->addList(node.m_impl)); }
 
+    /// Attach a prebuilt node while other threads may be attaching to the
+    /// same tree.  Appends are serialized through a process-wide lock, so
+    /// parallel workers can each build a subtree privately and attach it
+    /// with one call; readers must still wait for the workers to finish
+    /// before traversing the tree.
+    MetadataNode addAtomic(MetadataNode node)
+    {
+        std::lock_guard<std::mutex> lock(treeMutex());
+        return MetadataNode(m_impl->add(node.m_impl));
+    }
+
     MetadataNode addEncoded(const std::string& name,
         const unsigned char *buf, size_t size,
         const std::string& descrip = std::string())
@@ -447,6 +527,22 @@ public:
         return MetadataNode(impl);
     }
 
+    /**
+      Add a subnode whose value is computed by \c producer only if the
+      node is actually read or serialized.  Useful for large values
+      (e.g. base64-encoded VLR payloads) that are often never output.
+    */
+    MetadataNode addLazy(const std::string& name,
+        std::function<std::string()> producer, const std::string& type,
+        const std::string& descrip = std::string())
+    {
+        MetadataNodeImplPtr impl = m_impl->add(name);
+        impl->m_type = type;
+        impl->m_producer = producer;
+        impl->m_descrip = descrip;
+        return MetadataNode(impl);
+    }
+
     MetadataNode addWithType(const std::string& name, const std::string& value,
         const std::string& type, const std::string& descrip)
     {
@@ -554,14 +650,14 @@ public:
 
         try
         {
-            t = MetadataDetail::value<T>(m_impl->m_type, m_impl->m_value);
+            t = MetadataDetail::value<T>(m_impl->m_type, m_impl->value());
         }
         catch (MetadataDetail::value_error&)
         {
             // Reset in case the fromString conversion messed it up.
             t = T();
             std::cerr << "Error converting metadata [" << name() <<
-                "] = " << m_impl->m_value << " to type " <<
+                "] = " << m_impl->value() << " to type " <<
                 Utils::typeidName<T>() << " -- return default initialized.";
         }
         return t;
@@ -730,6 +826,12 @@ private:
     MetadataNode(MetadataNodeImplPtr node) : m_impl(node)
         {}
 
+    static std::mutex& treeMutex()
+    {
+        static std::mutex mutex;
+        return mutex;
+    }
+
     std::string escapeQuotes(const std::string& in) const
     {
         std::string out;
@@ -40,7 +40,11 @@
 #include <pdal/PDALUtils.hpp>
 #include <pdal/PointView.hpp>
 #include <pdal/Options.hpp>
+#include <pdal/private/RemoteCache.hpp>
 #include <pdal/util/FileUtils.hpp>
+#include <pdal/util/ThreadPool.hpp>
+
+#include <atomic>
 
 #ifndef _WIN32
 #include <dlfcn.h>
@@ -224,6 +228,19 @@ public:
     TempFile m_localFile;
 };
 
+// Download a remote object, going through the shared on-disk cache when
+// it's enabled.
+std::vector<char> fetchRemoteData(const std::string& path)
+{
+    RemoteCache& cache = RemoteCache::instance();
+    std::vector<char> data;
+    if (cache.get(path, 0, 0, data))
+        return data;
+    data = arbiter::Arbiter().getBinary(path);
+    cache.put(path, 0, 0, data);
+    return data;
+}
+
 class ArbiterInStream : public std::ifstream
 {
 public:
@@ -231,8 +248,7 @@ public:
             std::ios::openmode mode) :
         m_localFile(localPath)
     {
-        arbiter::Arbiter a;
-        a.put(localPath, a.getBinary(remotePath));
+        arbiter::Arbiter().put(localPath, fetchRemoteData(remotePath));
         open(localPath, mode);
     }
 
@@ -313,8 +329,7 @@ bool isRemote(const std::string& path)
 std::string fetchRemote(const std::string& path)
 {
     std::string temp = tempFilename(path);
-    arbiter::Arbiter a;
-    a.put(temp, a.getBinary(path));
+    arbiter::Arbiter().put(temp, fetchRemoteData(path));
     return temp;
 }
 
@@ -378,64 +393,123 @@ bool fileExists(const std::string& path)
     return FileUtils::fileExists(path);
 }
 
-double computeHausdorff(PointViewPtr srcView, PointViewPtr candView)
+double computeHausdorff(PointViewPtr srcView, PointViewPtr candView,
+    int threads)
 {
-    using namespace Dimension;
-
     KD3Index &srcIndex = srcView->build3dIndex();
     KD3Index &candIndex = candView->build3dIndex();
 
-    double maxDistSrcToCand = std::numeric_limits<double>::lowest();
-    double maxDistCandToSrc = std::numeric_limits<double>::lowest();
-
-    for (PointRef p : *srcView)
-    {
-        PointIdList indices(1);
-        std::vector<double> sqr_dists(1);
-        candIndex.knnSearch(p, 1, &indices, &sqr_dists);
-
-        if (sqr_dists[0] > maxDistSrcToCand)
-            maxDistSrcToCand = sqr_dists[0];
-    }
-
-    for (PointRef q : *candView)
+    // One direction of the max-of-min sweep.  All workers share the
+    // running maximum: a search can stop as soon as it finds any point
+    // within the current bound, since such a point's nearest neighbor
+    // can't raise the maximum.  A stale bound only costs extra search
+    // work, and the point holding the true maximum always runs its search
+    // to completion, so the result is exact.
+    auto sweep = [threads](PointViewPtr view, KD3Index& index)
     {
-        PointIdList indices(1);
-        std::vector<double> sqr_dists(1);
-        srcIndex.knnSearch(q, 1, &indices, &sqr_dists);
+        std::atomic<double> maxDist2(std::numeric_limits<double>::lowest());
+        auto raise = [&maxDist2](double v)
+        {
+            double cur = maxDist2.load();
+            while (v > cur && !maxDist2.compare_exchange_weak(cur, v))
+                ;
+        };
 
-        if (sqr_dists[0] > maxDistCandToSrc)
-            maxDistCandToSrc = sqr_dists[0];
-    }
+        auto scan = [&](PointId begin, PointId end)
+        {
+            PointRef point = view->point(0);
+            for (PointId id = begin; id < end; ++id)
+            {
+                point.setPointId(id);
+                double bound2 = maxDist2.load();
+                double d2 = index.neighborDist2Bounded(point, bound2);
+                if (d2 > bound2)
+                    raise(d2);
+            }
+        };
+
+        point_count_t numPts = view->size();
+        size_t nthreads = (size_t)(std::min)(
+            (point_count_t)(std::max)(threads, 1), numPts);
+        if (nthreads <= 1)
+            scan(0, numPts);
+        else
+        {
+            auto chunkStart = [numPts, nthreads](size_t t)
+                { return (PointId)(t * numPts / nthreads); };
+            ThreadPool pool(nthreads);
+            for (size_t t = 0; t < nthreads; ++t)
+                pool.add([&scan, &chunkStart, t]()
+                    { scan(chunkStart(t), chunkStart(t + 1)); });
+            pool.await();
+        }
+        return maxDist2.load();
+    };
 
-    maxDistSrcToCand = std::sqrt(maxDistSrcToCand);
-    maxDistCandToSrc = std::sqrt(maxDistCandToSrc);
+    double maxDistSrcToCand = std::sqrt(sweep(srcView, candIndex));
+    double maxDistCandToSrc = std::sqrt(sweep(candView, srcIndex));
 
     return (std::max)(maxDistSrcToCand, maxDistCandToSrc);
 }
 
 std::pair<double, double> computeHausdorffPair(PointViewPtr viewA,
-                                               PointViewPtr viewB)
+                                               PointViewPtr viewB,
+                                               int threads)
 {
     // Computes both the max and mean of all nearest neighbor distances from
-    // each point in the PointView to those in the KD3Index.
-    auto compute = [](PointViewPtr view, KD3Index& index) {
-        double max_distance = std::numeric_limits<double>::lowest();
-        double M1(0.0);
-        for (PointRef p : *view)
+    // each point in the PointView to those in the KD3Index.  The mean needs
+    // every exact distance, so there's no early exit here; the queries run
+    // on a pool of threads over disjoint point ranges, each accumulating
+    // its own partial max and sum.
+    auto compute = [threads](PointViewPtr view, KD3Index& index) {
+        point_count_t numPts = view->size();
+        size_t nthreads = (size_t)(std::min)(
+            (point_count_t)(std::max)(threads, 1), numPts);
+
+        std::vector<double> maxes(nthreads,
+            std::numeric_limits<double>::lowest());
+        std::vector<double> sums(nthreads, 0.0);
+
+        auto chunkStart = [numPts, nthreads](size_t t)
+            { return (PointId)(t * numPts / nthreads); };
+        auto scan = [&](size_t t)
         {
+            PointRef p = view->point(0);
             PointIdList indices(1);
             std::vector<double> sqr_dists(1);
-            index.knnSearch(p, 1, &indices, &sqr_dists);
-
-            if (sqr_dists[0] > max_distance)
-                max_distance = sqr_dists[0];
+            for (PointId id = chunkStart(t); id < chunkStart(t + 1); ++id)
+            {
+                p.setPointId(id);
+                index.knnSearch(p, 1, &indices, &sqr_dists);
+
+                if (sqr_dists[0] > maxes[t])
+                    maxes[t] = sqr_dists[0];
+                sums[t] += std::sqrt(sqr_dists[0]);
+            }
+        };
+
+        if (nthreads <= 1)
+        {
+            if (numPts)
+                scan(0);
+        }
+        else
+        {
+            ThreadPool pool(nthreads);
+            for (size_t t = 0; t < nthreads; ++t)
+                pool.add([&scan, t]() { scan(t); });
+            pool.await();
+        }
 
-            double delta = std::sqrt(sqr_dists[0]) - M1;
-            double delta_n = delta / (p.pointId() + 1);
-            M1 += delta_n;
+        double max_distance = std::numeric_limits<double>::lowest();
+        double sum(0.0);
+        for (size_t t = 0; t < nthreads; ++t)
+        {
+            max_distance = (std::max)(max_distance, maxes[t]);
+            sum += sums[t];
         }
         max_distance = std::sqrt(max_distance);
+        double M1 = numPts ? sum / numPts : 0.0;
         return std::pair<double, double>{max_distance, M1};
     };
 
@@ -485,30 +559,61 @@ std::string dllDir()
 }
 
 
-double computeChamfer(PointViewPtr srcView, PointViewPtr candView)
+double computeChamfer(PointViewPtr srcView, PointViewPtr candView,
+    int threads)
 {
     using namespace Dimension;
 
     KD3Index &srcIndex = srcView->build3dIndex();
     KD3Index &candIndex = candView->build3dIndex();
 
-    double sum1(0.0);
-    for (PointRef p : *srcView)
-    {
-        PointIdList indices(1);
-        std::vector<double> sqr_dists(1);
-        candIndex.knnSearch(p, 1, &indices, &sqr_dists);
-        sum1 += sqr_dists[0];
-    }
+    // Sum of squared nearest neighbor distances from each point in the
+    // view to the index.  A sum needs every exact distance, so the
+    // parallel path just splits the queries into per-thread ranges and
+    // merges the partial sums in thread order.
+    auto sweep = [threads](PointViewPtr view, KD3Index& index) {
+        point_count_t numPts = view->size();
+        size_t nthreads = (size_t)(std::min)(
+            (point_count_t)(std::max)(threads, 1), numPts);
 
-    double sum2(0.0);
-    for (PointRef q : *candView)
-    {
-        PointIdList indices(1);
-        std::vector<double> sqr_dists(1);
-        srcIndex.knnSearch(q, 1, &indices, &sqr_dists);
-        sum2 += sqr_dists[0];
-    }
+        std::vector<double> sums(nthreads, 0.0);
+
+        auto chunkStart = [numPts, nthreads](size_t t)
+            { return (PointId)(t * numPts / nthreads); };
+        auto scan = [&](size_t t)
+        {
+            PointRef p = view->point(0);
+            PointIdList indices(1);
+            std::vector<double> sqr_dists(1);
+            for (PointId id = chunkStart(t); id < chunkStart(t + 1); ++id)
+            {
+                p.setPointId(id);
+                index.knnSearch(p, 1, &indices, &sqr_dists);
+                sums[t] += sqr_dists[0];
+            }
+        };
+
+        if (nthreads <= 1)
+        {
+            if (numPts)
+                scan(0);
+        }
+        else
+        {
+            ThreadPool pool(nthreads);
+            for (size_t t = 0; t < nthreads; ++t)
+                pool.add([&scan, t]() { scan(t); });
+            pool.await();
+        }
+
+        double sum(0.0);
+        for (size_t t = 0; t < nthreads; ++t)
+            sum += sums[t];
+        return sum;
+    };
+
+    double sum1 = sweep(srcView, candIndex);
+    double sum2 = sweep(candView, srcIndex);
 
     return sum1 + sum2;
 }
@@ -34,6 +34,7 @@
 
 #include <pdal/PipelineExecutor.hpp>
 #include <pdal/PDALUtils.hpp>
+#include <pdal/Stage.hpp>
 
 namespace pdal
 {
@@ -41,12 +42,26 @@ namespace pdal
 
 PipelineExecutor::PipelineExecutor(std::string const& json)
     : m_json(json)
+    , m_pipelineRead(false)
+    , m_prepared(false)
     , m_executed(false)
     , m_logLevel(pdal::LogLevel::Error)
 {
 }
 
 
+void PipelineExecutor::readPipeline()
+{
+    if (m_pipelineRead)
+        return;
+
+    std::stringstream strm;
+    strm << m_json;
+    m_manager.readPipeline(strm);
+    m_pipelineRead = true;
+}
+
+
 std::string PipelineExecutor::getPipeline() const
 {
     if (!m_executed)
@@ -84,19 +99,56 @@ std::string PipelineExecutor::getSchema() const
 
 bool PipelineExecutor::validate()
 {
-    std::stringstream strm;
-    strm << m_json;
-    m_manager.readPipeline(strm);
+    readPipeline();
     m_manager.prepare();
+    m_prepared = true;
 
     return true;
 }
 
+
+void PipelineExecutor::prepare()
+{
+    if (m_prepared)
+        return;
+
+    readPipeline();
+    m_manager.prepare();
+    m_prepared = true;
+}
+
+
 int64_t PipelineExecutor::execute()
 {
-    std::stringstream strm;
-    strm << m_json;
-    m_manager.readPipeline(strm);
+    readPipeline();
+    point_count_t count = m_manager.execute();
+
+    m_executed = true;
+
+    return count;
+}
+
+
+int64_t PipelineExecutor::executeWith(
+    const std::map<std::string, Options>& overrides)
+{
+    prepare();
+
+    for (Stage *s : m_manager.stages())
+    {
+        auto it = overrides.find(s->tag());
+        if (it == overrides.end())
+            it = overrides.find(s->getName());
+        if (it == overrides.end())
+            continue;
+
+        // Replace any same-named options; the stage re-resolves its
+        // option values when execution prepares it, while the retained
+        // point table makes the layout pass a no-op.
+        s->removeOptions(it->second);
+        s->addOptions(it->second);
+    }
+
     point_count_t count = m_manager.execute();
 
     m_executed = true;
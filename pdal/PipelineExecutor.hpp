@@ -39,6 +39,7 @@
 #include <pdal/util/FileUtils.hpp>
 #include <pdal/pdal_export.hpp>
 
+#include <map>
 #include <string>
 
 namespace pdal
@@ -73,6 +74,30 @@ public:
     */
     int64_t execute();
 
+    /**
+      Read the pipeline JSON and prepare the stage graph without
+      executing it.  Later calls to execute() or executeWith() reuse
+      the constructed stages instead of parsing and validating the
+      pipeline again, which matters when the same pipeline runs over
+      many inputs.
+    */
+    void prepare();
+
+    /**
+      Execute the prepared pipeline, first overriding options on
+      selected stages.  Stages are matched by their pipeline 'tag', or
+      by stage type name (e.g. "readers.las") when no tag matches.
+      Overridden options replace any same-named options on the stage.
+      The stage graph and point table are retained across calls, so
+      repeated executions skip pipeline parsing and full layout
+      negotiation.
+
+      \param overrides  Map from stage tag or name to the options to
+        replace for this run.
+      \return total number of points produced by the pipeline.
+    */
+    int64_t executeWith(const std::map<std::string, Options>& overrides);
+
     /**
       Validate the pipeline
 
@@ -132,9 +157,12 @@ public:
 
 private:
     void setLogStream(std::ostream& strm);
+    void readPipeline();
 
     std::string m_json;
     pdal::PipelineManager m_manager;
+    bool m_pipelineRead;
+    bool m_prepared;
     bool m_executed;
     std::stringstream m_logStream;
     pdal::LogLevel m_logLevel;
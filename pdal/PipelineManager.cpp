@@ -40,6 +40,8 @@
 #include <pdal/util/Algorithm.hpp>
 #include <pdal/util/FileUtils.hpp>
 
+#include "private/ResultCache.hpp"
+
 #pragma GCC diagnostic ignored "-Wmissing-field-initializers"
 
 namespace pdal
@@ -215,6 +217,15 @@ void PipelineManager::prepare() const
 }
 
 
+void PipelineManager::validate() const
+{
+    validateStageOptions();
+    Stage *s = getStage();
+    if (s)
+       s->validateOptions();
+}
+
+
 PipelineManager::ExecResult PipelineManager::execute(ExecMode mode)
 {
     ExecResult result;
@@ -264,7 +275,13 @@ PipelineManager::ExecResult PipelineManager::execute(ExecMode mode)
     else if (mode == ExecMode::Standard)
     {
         s->prepare(m_table);
-        m_viewSet = s->execute(m_table);
+        if (m_cacheDir.size())
+        {
+            m_resultCache.reset(new ResultCache(m_cacheDir));
+            for (Stage *stage : m_stages)
+                stage->setResultCache(m_resultCache.get());
+        }
+        m_viewSet = s->execute(m_table, m_execThreads);
         point_count_t cnt = 0;
         for (auto pi = m_viewSet.begin(); pi != m_viewSet.end(); ++pi)
         {
@@ -46,6 +46,7 @@ namespace pdal
 {
 
 struct QuickInfo;
+class ResultCache;
 class Stage;
 class StageFactory;
 
@@ -74,7 +75,9 @@ public:
         point_count_t m_count;
     };
 
-    PipelineManager(point_count_t streamLimit = 10000);
+    // A stream limit of 0 lets the stream table pick a capacity from the
+    // point size once the layout is known.
+    PipelineManager(point_count_t streamLimit = 0);
     ~PipelineManager();
 
     void setProgressFd(int fd)
@@ -124,6 +127,9 @@ public:
 
     QuickInfo preview() const;
     void prepare() const;
+    // Check stage names and option names/types without initializing
+    // stages -- no driver loads, file opens or network access.
+    void validate() const;
     ExecResult execute(ExecMode mode);
     point_count_t execute();
     void executeStream(StreamPointTable& table);
@@ -139,6 +145,22 @@ public:
     PointTableRef pointTable() const
         { return m_table; }
 
+    // Set the number of threads on which independent leaf stages (readers)
+    // may execute in standard mode.  Usually set from a pipeline-level
+    // 'threads' entry in a JSON pipeline.
+    void setExecThreads(int threads)
+        { m_execThreads = threads; }
+    int execThreads() const
+        { return m_execThreads; }
+
+    // Name a directory in which stage results are cached across runs.
+    // In standard mode, stages whose cached output is found there are
+    // reloaded instead of recomputed, so re-running a pipeline after
+    // editing a late stage skips the unchanged upstream work.  An empty
+    // string (the default) disables caching.
+    void setCacheDir(const std::string& dir)
+        { m_cacheDir = dir; }
+
     MetadataNode getMetadata() const;
     Options& commonOptions()
         { return m_commonOptions; }
@@ -168,6 +190,9 @@ private:
     int m_progressFd;
     std::istream *m_input;
     LogPtr m_log;
+    int m_execThreads = 1;
+    std::string m_cacheDir;
+    std::unique_ptr<ResultCache> m_resultCache;
 
     PipelineManager& operator=(const PipelineManager&); // not implemented
     PipelineManager(const PipelineManager&); // not implemented
@@ -157,7 +157,18 @@ void PipelineReaderJSON::readPipeline(std::istream& input)
 
     auto it = root.find("pipeline");
     if (root.is_object() && it != root.end())
+    {
+        // Pipeline-level options ride alongside the stage array.
+        auto ti = root.find("threads");
+        if (ti != root.end())
+        {
+            if (!ti->is_number_integer() || ti->get<int>() < 1)
+                throw pdal_error("JSON pipeline: 'threads' must be a "
+                    "positive integer.");
+            m_manager.setExecThreads(ti->get<int>());
+        }
         parsePipeline(*it);
+    }
     else if (root.is_array())
         parsePipeline(root);
     else
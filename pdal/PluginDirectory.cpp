@@ -37,6 +37,9 @@
 #include <pdal/util/FileUtils.hpp>
 #include <pdal/pdal_config.hpp>
 
+#include <ctime>
+#include <fstream>
+
 namespace pdal
 {
 
@@ -113,12 +116,101 @@ std::string validPlugin(const std::string& path, const StringList& types)
     return type + "s." + file;
 }
 
+std::time_t modTime(const std::string& path)
+{
+    struct tm mod = {};
+    FileUtils::fileTimes(path, nullptr, &mod);
+    return std::mktime(&mod);
+}
+
+// The manifest is current if it's newer than every search directory it
+// was built from.  Adding, removing or renaming a plugin updates the
+// containing directory's modification time, invalidating the manifest.
+bool manifestCurrent(const std::string& manifest, const StringList& dirs)
+{
+    if (!FileUtils::fileExists(manifest))
+        return false;
+
+    std::time_t t = modTime(manifest);
+    for (const std::string& dir : dirs)
+        if (FileUtils::directoryExists(dir) && modTime(dir) > t)
+            return false;
+    return true;
+}
+
+// Manifest format is one tab-separated entry per line:
+//   <K|D> <stage name> <absolute path to shared object>
+bool loadManifest(const std::string& manifest,
+    std::map<std::string, std::string>& kernels,
+    std::map<std::string, std::string>& drivers)
+{
+    std::istream *in = FileUtils::openFile(manifest);
+    if (!in)
+        return false;
+
+    bool ok = true;
+    std::string line;
+    while (std::getline(*in, line))
+    {
+        StringList fields = Utils::split(line, '\t');
+        if (fields.size() != 3 || (fields[0] != "K" && fields[0] != "D"))
+        {
+            ok = false;
+            break;
+        }
+        if (fields[0] == "K")
+            kernels.insert(std::make_pair(fields[1], fields[2]));
+        else
+            drivers.insert(std::make_pair(fields[1], fields[2]));
+    }
+    FileUtils::closeFile(in);
+    if (!ok)
+    {
+        kernels.clear();
+        drivers.clear();
+    }
+    return ok;
+}
+
+void writeManifest(const std::string& manifest,
+    const std::map<std::string, std::string>& kernels,
+    const std::map<std::string, std::string>& drivers)
+{
+    // Write to a temporary and rename so that concurrent processes never
+    // see a partial manifest.
+    std::string tmp = manifest + ".tmp";
+    std::ostream *out = FileUtils::createFile(tmp);
+    if (!out)
+        return;
+    for (const auto& k : kernels)
+        *out << "K\t" << k.first << '\t' << k.second << '\n';
+    for (const auto& d : drivers)
+        *out << "D\t" << d.first << '\t' << d.second << '\n';
+    bool ok = !out->fail();
+    FileUtils::closeFile(out);
+    if (ok)
+        FileUtils::renameFile(manifest, tmp);
+    else
+        FileUtils::deleteFile(tmp);
+}
+
 } // unnamed namespace;
 
 
 PluginDirectory::PluginDirectory()
 {
-    for (const auto& dir : pluginSearchPaths())
+    const StringList dirs = pluginSearchPaths();
+
+    // When PDAL_PLUGIN_MANIFEST names a file, use it as a cache of the
+    // directory scan so that short-lived invocations don't pay for listing
+    // the search paths on every run.
+    std::string manifest;
+    Utils::getenv("PDAL_PLUGIN_MANIFEST", manifest);
+    if (manifest.size() && manifestCurrent(manifest, dirs) &&
+        loadManifest(manifest, m_kernels, m_drivers))
+        return;
+
+    for (const auto& dir : dirs)
     {
         StringList files = FileUtils::directoryList(dir);
         for (auto& file : files)
@@ -137,6 +229,9 @@ PluginDirectory::PluginDirectory()
                 m_drivers.insert(std::make_pair(plugin, file));
         }
     }
+
+    if (manifest.size())
+        writeManifest(manifest, m_kernels, m_drivers);
 }
 
 std::string PluginDirectory::test_validPlugin(const std::string& path,
@@ -45,6 +45,7 @@ class PDAL_DLL PointContainer
 {
     friend class PointView;
     friend class PointRef;
+    template <typename T> friend class TypedField;
 private:
     virtual void setFieldInternal(Dimension::Id dim, PointId idx,
         const void *val) = 0;
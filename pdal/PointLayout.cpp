@@ -222,6 +222,25 @@ size_t PointLayout::pointSize() const
 }
 
 
+bool PointLayout::compatible(const PointLayout& other) const
+{
+    if (m_pointSize != other.m_pointSize)
+        return false;
+
+    const Dimension::IdList& ids = dims();
+    if (ids != other.dims())
+        return false;
+    for (Dimension::Id id : ids)
+    {
+        const Dimension::Detail *d1 = dimDetail(id);
+        const Dimension::Detail *d2 = other.dimDetail(id);
+        if (d1->type() != d2->type() || d1->offset() != d2->offset())
+            return false;
+    }
+    return true;
+}
+
+
 // Update the point layout given dimension detail and the dimension's name.
 bool PointLayout::update(Dimension::Detail dd, const std::string& name)
 {
@@ -218,6 +218,17 @@ public:
     */
     PDAL_DLL size_t pointSize() const;
 
+    /**
+      Determine if another layout stores points identically to this one --
+      the same dimensions, each with the same type and byte offset.  Point
+      data can be copied between compatible layouts as a single block.
+
+      \param other  Layout to compare against.
+      \return \c true if point data of the layouts is interchangeable,
+        \c false otherwise.
+    */
+    PDAL_DLL bool compatible(const PointLayout& other) const;
+
     /**
       Get a pointer to a dimension's detail information.
 
@@ -34,6 +34,17 @@
 
 #include <pdal/ArtifactManager.hpp>
 #include <pdal/PointTable.hpp>
+#include <pdal/util/Utils.hpp>
+
+#include <climits>
+#include <fstream>
+#include <new>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 namespace pdal
 {
@@ -99,21 +110,121 @@ void SimplePointTable::getFieldInternal(Dimension::Id id, PointId idx,
 }
 
 
+namespace
+{
+
+#if defined(__linux__) && defined(SYS_mbind)
+// Build a node mask from the kernel's online-node list ("0", "0-3",
+// "0,2-3", ...).  Returns 0 when the list can't be read or names nodes
+// beyond what a single mask word covers.
+unsigned long onlineNodeMask()
+{
+    std::ifstream in("/sys/devices/system/node/online");
+    std::string s;
+    if (!(in >> s))
+        return 0;
+
+    unsigned long mask = 0;
+    for (const std::string& range : Utils::split2(s, ','))
+    {
+        StringList ends = Utils::split2(range, '-');
+        int lo, hi;
+        if (!Utils::fromString(ends.front(), lo) ||
+            !Utils::fromString(ends.back(), hi))
+            return 0;
+        if (lo < 0 || hi >= (int)(sizeof(mask) * CHAR_BIT) || hi < lo)
+            return 0;
+        for (int n = lo; n <= hi; ++n)
+            mask |= 1UL << n;
+    }
+    return mask;
+}
+#endif
+
+} // unnamed namespace
+
+RowPointTable::RowPointTable(AllocPolicy policy) :
+    SimplePointTable(m_layout), m_numPts(0), m_policy(policy)
+{
+    if (m_policy == AllocPolicy::Default)
+    {
+        std::string env;
+        if (Utils::getenv("PDAL_ALLOC_POLICY", env))
+        {
+            env = Utils::tolower(env);
+            if (env == "first-touch")
+                m_policy = AllocPolicy::FirstTouch;
+            else if (env == "interleave")
+                m_policy = AllocPolicy::Interleave;
+        }
+    }
+}
+
 RowPointTable::~RowPointTable()
 {
+    size_t size = pointsToBytes(m_blockPtCnt);
     for (auto vi = m_blocks.begin(); vi != m_blocks.end(); ++vi)
-        delete [] *vi;
+        freeBlock(*vi, size);
 }
 
-PointId RowPointTable::addPoint()
+char *RowPointTable::allocBlock(std::size_t size)
 {
-    if (m_numPts % m_blockPtCnt == 0)
+#ifdef __linux__
+    if (m_policy != AllocPolicy::Default)
+    {
+        // A fresh anonymous mapping hands out untouched zero pages, so
+        // each page is placed when a thread first writes it - unlike the
+        // zero-fill below, which drags every page onto the allocating
+        // thread's node.
+        void *addr = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (addr != MAP_FAILED)
+        {
+            accountAlloc(size);
+#ifdef SYS_mbind
+            if (m_policy == AllocPolicy::Interleave)
+            {
+                // MPOL_INTERLEAVE over the online nodes.  Failure just
+                // leaves the mapping with first-touch placement.
+                const int interleave = 3;
+                unsigned long mask = onlineNodeMask();
+                if (mask)
+                    syscall(SYS_mbind, addr, size, interleave, &mask,
+                        sizeof(mask) * CHAR_BIT, 0);
+            }
+#endif
+            return (char *)addr;
+        }
+        // Fall back to plain allocation, but only before any block has
+        // been mapped - the destructor frees all blocks one way.
+        if (!m_blocks.empty())
+            throw std::bad_alloc();
+        m_policy = AllocPolicy::Default;
+    }
+#endif
+    char *buf = new char[size];
+    memset(buf, 0, size);
+    accountAlloc(size);
+    return buf;
+}
+
+void RowPointTable::freeBlock(char *block, std::size_t size)
+{
+    accountFree(size);
+#ifdef __linux__
+    if (m_policy != AllocPolicy::Default)
     {
-        size_t size = pointsToBytes(m_blockPtCnt);
-        char *buf = new char[size];
-        memset(buf, 0, size);
-        m_blocks.push_back(buf);
+        munmap(block, size);
+        return;
     }
+#endif
+    delete [] block;
+}
+
+PointId RowPointTable::addPoint()
+{
+    if (m_numPts % m_blockPtCnt == 0)
+        m_blocks.push_back(allocBlock(pointsToBytes(m_blockPtCnt)));
     return m_numPts++;
 }
 
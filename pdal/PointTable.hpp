@@ -35,6 +35,8 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <list>
 #include <vector>
 
@@ -91,23 +93,77 @@ public:
     }
     virtual bool supportsView() const
         { return false; }
+
+    /// Returns true if each dimension is stored contiguously (SoA) and
+    /// column() provides direct access to dimension data.
+    virtual bool columnar() const
+        { return false; }
+
+    /// Return a typed pointer to contiguous storage for a dimension,
+    /// beginning at point \c first.  \c contiguous is set to the number of
+    /// points accessible from the returned pointer, which may be less than
+    /// the number of points in the table.  Call again with an advanced
+    /// \c first to walk the full column.  Returns nullptr (with
+    /// \c contiguous set to 0) if the table isn't columnar or the requested
+    /// type doesn't match the dimension's storage type.
+    template <typename T>
+    T *column(Dimension::Id id, PointId first, point_count_t& contiguous)
+    {
+        const Dimension::Detail *d = m_layoutRef.dimDetail(id);
+        if (!d || d->type() != Dimension::type<T>())
+        {
+            contiguous = 0;
+            return nullptr;
+        }
+        return reinterpret_cast<T *>(getColumn(d, first, contiguous));
+    }
+
+    template <typename T>
+    const T *column(Dimension::Id id, PointId first,
+        point_count_t& contiguous) const
+    {
+        BasePointTable *ncThis = const_cast<BasePointTable *>(this);
+        return ncThis->column<T>(id, first, contiguous);
+    }
+
     MetadataNode privateMetadata(const std::string& name);
     MetadataNode toMetadata() const;
     ArtifactManager& artifactManager();
 
+    /// Bytes of point storage currently allocated by this table.  Views
+    /// share the table's storage, so their index overhead isn't included.
+    virtual std::size_t allocatedBytes() const
+        { return m_allocBytes; }
+
 private:
     // Point data operations.
     virtual PointId addPoint() = 0;
     virtual char *getDimension(const Dimension::Detail *d, PointId idx) = 0;
+    virtual char *getColumn(const Dimension::Detail *d, PointId first,
+        point_count_t& contiguous)
+    {
+        contiguous = 0;
+        return nullptr;
+    }
 
 protected:
     virtual char *getPoint(PointId idx) = 0;
 
+protected:
+    void accountAlloc(std::size_t bytes)
+        { m_allocBytes += bytes; }
+    void accountFree(std::size_t bytes)
+        { m_allocBytes -= bytes; }
+
 protected:
     MetadataPtr m_metadata;
     std::list<SpatialReference> m_spatialRefs;
     PointLayout& m_layoutRef;
     std::unique_ptr<ArtifactManager> m_artifactManager;
+
+private:
+    // Updated from whatever thread happens to add points.
+    std::atomic<std::size_t> m_allocBytes { 0 };
 };
 typedef BasePointTable& PointTableRef;
 typedef BasePointTable const & ConstPointTableRef;
@@ -143,17 +199,35 @@ private:
 // to be used to process multiple point sets simultaneously.
 class PDAL_DLL RowPointTable : public SimplePointTable
 {
+public:
+    /// Placement policy for point block memory.  Default allocates with
+    /// operator new and zero-fills, which lands all pages on the NUMA node
+    /// of the allocating thread.  FirstTouch hands out untouched zero
+    /// pages, so each page is placed on the node of the thread that first
+    /// writes it.  Interleave spreads pages round-robin across memory
+    /// nodes, evening out bandwidth when many threads scan the table.
+    /// Both policies fall back to Default behavior on platforms without
+    /// NUMA memory-policy support.  The PDAL_ALLOC_POLICY environment
+    /// variable ("first-touch" or "interleave") supplies a policy for
+    /// tables that don't choose one explicitly.
+    enum class AllocPolicy
+    {
+        Default,
+        FirstTouch,
+        Interleave
+    };
+
 private:
     // Point storage.
     std::vector<char *> m_blocks;
     point_count_t m_numPts;
+    AllocPolicy m_policy;
 
     // Make sure this is power-of-2 to facilitate fast div and mod ops.
     static const point_count_t m_blockPtCnt = 65536;
 
 public:
-    RowPointTable() : SimplePointTable(m_layout), m_numPts(0)
-        {}
+    RowPointTable(AllocPolicy policy = AllocPolicy::Default);
     virtual ~RowPointTable();
     virtual bool supportsView() const
         { return true; }
@@ -164,6 +238,8 @@ protected:
 private:
     // Point data operations.
     virtual PointId addPoint();
+    char *allocBlock(std::size_t size);
+    void freeBlock(char *block, std::size_t size);
 
     PointLayout m_layout;
 };
@@ -191,6 +267,8 @@ public:
     virtual ~ColumnPointTable();
     virtual bool supportsView() const
         { return true; }
+    virtual bool columnar() const
+        { return true; }
     virtual void finalize();
     virtual char *getPoint(PointId idx)
         { return nullptr; }
@@ -206,6 +284,8 @@ private:
     // Hide base class calls for now.
     const char *getDimension(const Dimension::Detail *d, PointId idx) const;
     char *getDimension(const Dimension::Detail *d, PointId idx);
+    virtual char *getColumn(const Dimension::Detail *d, PointId first,
+        point_count_t& contiguous);
 
     PointLayout m_layout;
 };
@@ -253,6 +333,32 @@ public:
     void setSkip(PointId n)
         { m_skips[n] = true; }
 
+    /// Move unskipped points toward the front of the table, preserving
+    /// order, so that downstream stages see a dense batch with no dead
+    /// slots.  Clears the skip flags and returns the compacted count.
+    point_count_t compact(point_count_t count)
+    {
+        PointId dst = 0;
+        while (dst < count && !skip(dst))
+            dst++;
+        if (dst == count)
+            return count;
+
+        std::size_t size = pointsToBytes(1);
+        for (PointId src = dst + 1; src < count; ++src)
+        {
+            if (skip(src))
+                continue;
+            std::memcpy(getPoint(dst++), getPoint(src), size);
+        }
+        // A batch with no survivors is left alone so that the normal
+        // all-skipped path (and its reset) still runs.
+        if (dst == 0)
+            return count;
+        std::fill(m_skips.begin(), m_skips.begin() + count, false);
+        return dst;
+    }
+
     point_count_t capacity() const
         { return m_capacity; }
 
@@ -268,6 +374,15 @@ protected:
     virtual void reset()
     {}
 
+    /// Set the capacity of the table.  Only meaningful before point storage
+    /// is allocated -- used by finalize() implementations that size the
+    /// table from the layout.
+    void setCapacity(point_count_t capacity)
+    {
+        m_capacity = capacity;
+        m_skips.assign(m_capacity, false);
+    }
+
 private:
     point_count_t m_capacity;
     point_count_t m_numPoints;
@@ -277,7 +392,9 @@ private:
 class PDAL_DLL FixedPointTable : public StreamPointTable
 {
 public:
-    FixedPointTable(point_count_t capacity)
+    /// A capacity of 0 selects a capacity from the point size once the
+    /// layout is finalized.
+    FixedPointTable(point_count_t capacity = 0)
         : StreamPointTable(m_layout, capacity)
     {}
 
@@ -286,10 +403,15 @@ public:
         if (!m_layout.finalized())
         {
             BasePointTable::finalize();
+            if (!capacity())
+                setCapacity(chooseCapacity());
             m_buf.resize(pointsToBytes(capacity() + 1));
         }
     }
 
+    virtual std::size_t allocatedBytes() const
+        { return m_buf.capacity(); }
+
 protected:
     virtual void reset()
         { std::fill(m_buf.begin(), m_buf.end(), 0); }
@@ -298,6 +420,18 @@ protected:
         { return m_buf.data() + pointsToBytes(idx); }
 
 private:
+    // Target a batch buffer of about 2 MB -- large enough to amortize
+    // per-batch overhead, small enough to stay cache and bandwidth
+    // friendly -- bounded to keep degenerate layouts reasonable.
+    point_count_t chooseCapacity() const
+    {
+        const std::size_t targetBytes = 2 * 1024 * 1024;
+        std::size_t pointSize = (std::max)(pointsToBytes(1),
+            (std::size_t)1);
+        return (point_count_t)(std::min)((std::max)(
+            targetBytes / pointSize, (std::size_t)1024), (std::size_t)65536);
+    }
+
     std::vector<char> m_buf;
     PointLayout m_layout;
 };
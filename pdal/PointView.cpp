@@ -32,6 +32,9 @@
 * OF SUCH DAMAGE.
 ****************************************************************************/
 
+#include <algorithm>
+#include <cassert>
+#include <cstring>
 #include <iomanip>
 
 #include <pdal/KDIndex.hpp>
@@ -43,7 +46,7 @@
 namespace pdal
 {
 
-int PointView::m_lastId = 0;
+std::atomic<int> PointView::m_lastId(0);
 
 PointView::PointView(PointTableRef pointTable) : m_pointTable(pointTable),
     m_layout(pointTable.layout()), m_size(0), m_id(0)
@@ -115,27 +118,159 @@ void PointView::setFieldInternal(Dimension::Id dim, PointId idx,
 }
 
 
-void PointView::calculateBounds(BOX2D& output) const
+void PointView::copyPoints(const PointView& src, PointId begin,
+    point_count_t count)
 {
-    for (PointId idx = 0; idx < size(); idx++)
+    // Invalid positions are a programmer error.
+    assert(begin + count <= src.size());
+    assert(m_temps.empty());
+
+    if (&m_pointTable == &src.m_pointTable)
     {
-        double x = getFieldAs<double>(Dimension::Id::X, idx);
-        double y = getFieldAs<double>(Dimension::Id::Y, idx);
+        // Same table -- share the underlying points, as appendPoint() does.
+        m_index.reserve(m_index.size() + count);
+        for (point_count_t i = 0; i < count; ++i)
+            m_index.push_back(src.m_index[begin + i]);
+        m_size += count;
+        return;
+    }
+
+    const PointLayout& srcLayout = *src.m_pointTable.layout();
+    const PointLayout& dstLayout = *m_pointTable.layout();
+
+    // When the layouts match and both tables store whole points
+    // contiguously, each point copies as a single block.
+    bool wholePoints = dstLayout.compatible(srcLayout) &&
+        !m_pointTable.columnar() && !src.m_pointTable.columnar();
+    size_t size = dstLayout.pointSize();
 
-        output.grow(x, y);
+    m_index.reserve(m_index.size() + count);
+    for (point_count_t i = 0; i < count; ++i)
+    {
+        PointId srcId = src.m_index[begin + i];
+        PointId dstId = m_pointTable.addPoint();
+        m_index.push_back(dstId);
+        PointId dstIdx = m_size++;
+
+        if (wholePoints)
+        {
+            std::memcpy(m_pointTable.getPoint(dstId),
+                src.m_pointTable.getPoint(srcId), size);
+            continue;
+        }
+        for (Dimension::Id id : dstLayout.dims())
+        {
+            if (!srcLayout.hasDim(id))
+                continue;
+            if (srcLayout.dimType(id) == dstLayout.dimType(id))
+            {
+                Everything e;
+                src.m_pointTable.getFieldInternal(id, srcId, &e);
+                m_pointTable.setFieldInternal(id, dstId, &e);
+            }
+            else
+                setField(id, dstIdx,
+                    src.getFieldAs<double>(id, begin + i));
+        }
     }
 }
 
 
-void PointView::calculateBounds(BOX3D& output) const
+void PointView::reorderStorage()
 {
-    for (PointId idx = 0; idx < size(); idx++)
+    if (empty())
+        return;
+    assert(m_temps.empty());
+
+    // Table positions this view occupies, in ascending storage order.
+    PointIdList rows(m_index.begin(), m_index.begin() + size());
+    std::sort(rows.begin(), rows.end());
+    if (std::adjacent_find(rows.begin(), rows.end()) != rows.end())
+        throw pdal_error("PointView::reorderStorage: view references the "
+            "same table position more than once.");
+
+    if (!m_pointTable.columnar())
+    {
+        // Raw rows: stage the records in view order, then lay them back
+        // down over the occupied positions in storage order.
+        size_t recSize = m_pointTable.layout()->pointSize();
+        std::vector<char> buf(size() * recSize);
+        for (PointId i = 0; i < size(); ++i)
+            std::memcpy(buf.data() + i * recSize,
+                m_pointTable.getPoint(m_index[i]), recSize);
+        for (PointId i = 0; i < size(); ++i)
+        {
+            m_index[i] = rows[i];
+            std::memcpy(m_pointTable.getPoint(rows[i]),
+                buf.data() + i * recSize, recSize);
+        }
+    }
+    else
     {
-        double x = getFieldAs<double>(Dimension::Id::X, idx);
-        double y = getFieldAs<double>(Dimension::Id::Y, idx);
-        double z = getFieldAs<double>(Dimension::Id::Z, idx);
+        // Columnar storage exposes no whole-point memory; go through
+        // packed field copies instead.
+        DimTypeList dims = dimTypes();
+        size_t recSize = 0;
+        for (const DimType& d : dims)
+            recSize += Dimension::size(d.m_type);
+        std::vector<char> buf(size() * recSize);
+        for (PointId i = 0; i < size(); ++i)
+            getPackedPoint(dims, i, buf.data() + i * recSize);
+        for (PointId i = 0; i < size(); ++i)
+        {
+            m_index[i] = rows[i];
+            setPackedPoint(dims, i, buf.data() + i * recSize);
+        }
+    }
+    invalidateProducts();
+}
 
-        output.grow(x, y, z);
+
+namespace
+{
+// Block size for gathering coordinates when computing bounds.  The
+// batch grow() over plain arrays vectorizes where per-point grow()
+// branches.
+const size_t BoundsBlockSize = 1024;
+}
+
+
+void PointView::calculateBounds(BOX2D& output) const
+{
+    double x[BoundsBlockSize];
+    double y[BoundsBlockSize];
+
+    PointId idx = 0;
+    while (idx < size())
+    {
+        size_t n = (std::min)((size_t)(size() - idx), BoundsBlockSize);
+        for (size_t i = 0; i < n; ++i, ++idx)
+        {
+            x[i] = getFieldAs<double>(Dimension::Id::X, idx);
+            y[i] = getFieldAs<double>(Dimension::Id::Y, idx);
+        }
+        output.grow(x, y, n);
+    }
+}
+
+
+void PointView::calculateBounds(BOX3D& output) const
+{
+    double x[BoundsBlockSize];
+    double y[BoundsBlockSize];
+    double z[BoundsBlockSize];
+
+    PointId idx = 0;
+    while (idx < size())
+    {
+        size_t n = (std::min)((size_t)(size() - idx), BoundsBlockSize);
+        for (size_t i = 0; i < n; ++i, ++idx)
+        {
+            x[i] = getFieldAs<double>(Dimension::Id::X, idx);
+            y[i] = getFieldAs<double>(Dimension::Id::Y, idx);
+            z[i] = getFieldAs<double>(Dimension::Id::Z, idx);
+        }
+        output.grow(x, y, z, n);
     }
 }
 
@@ -222,7 +357,8 @@ KD3Index& PointView::build3dIndex()
     if (!m_index3)
     {
         m_index3.reset(new KD3Index(*this));
-        m_index3->build();
+        if (m_indexSidecar.empty() || !m_index3->load(m_indexSidecar))
+            m_index3->build();
     }
     return *m_index3.get();
 }
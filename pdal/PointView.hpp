@@ -42,10 +42,11 @@
 #include <pdal/PointTable.hpp>
 #include <pdal/PointRef.hpp>
 
+#include <atomic>
 #include <memory>
 #include <queue>
 #include <set>
-#include <deque>
+#include <vector>
 
 //#pragma warning(disable: 4244)  // conversion from 'type1' to 'type2', possible loss of data
 
@@ -59,6 +60,7 @@ namespace plang
 struct PointViewLess;
 class PointView;
 class PointViewIter;
+template <typename T> class TypedField;
 class KD2Index;
 class KD3Index;
 class BOX2D;
@@ -78,6 +80,7 @@ class PDAL_DLL PointView : public PointContainer
     friend class plang::Invocation;
     friend class PointIdxRef;
     friend struct PointViewLess;
+    template <typename T> friend class TypedField;
 public:
     PointView(const PointView&) = delete;
     PointView& operator=(const PointView&) = delete;
@@ -98,6 +101,30 @@ public:
         { return m_size == 0; }
 
     inline void appendPoint(const PointView& buffer, PointId id);
+    /// Append 'count' points of 'buffer', referenced by the positions in
+    /// 'ids'.  Storage for the points is allocated in a single shot, so
+    /// this is preferred over repeated appendPoint() calls when a stage
+    /// partitions a view into many pieces.
+    inline void appendPoints(const PointView& buffer, const PointId *ids,
+        point_count_t count);
+    /// Append 'count' points of 'src', starting at position 'begin'.
+    /// When 'src' is backed by this view's point table the points are
+    /// shared rather than copied.  Otherwise the point data is copied --
+    /// as whole points when the layouts are compatible, dimension-by-
+    /// dimension when they're not.
+    void copyPoints(const PointView& src, PointId begin, point_count_t count);
+    /// Rewrite the underlying table storage so this view's points are laid
+    /// out physically in view order.  After sorting a view spatially (e.g.
+    /// filters.mortonorder), this turns the sorted order into storage
+    /// locality, so table scans and KD construction walk memory
+    /// sequentially instead of chasing the view's indirection.  The view's
+    /// points must reference distinct table positions; other views sharing
+    /// those positions will see the reordered contents.
+    void reorderStorage();
+    /// Pre-allocate index storage for 'count' points.  Useful when a
+    /// stage knows how many points it will append to a view.
+    void reserve(point_count_t count)
+        { m_index.reserve(count); }
     void append(const PointView& buf)
     {
         // We use size() instead of the index end because temp points
@@ -109,6 +136,24 @@ public:
         m_size += buf.size();
         clearTemps();
     }
+    /// Move-append.  When this view is empty the source view's index is
+    /// stolen rather than copied, making the merge O(1).  'buf' is left
+    /// empty in either case, so only call this when the source view is
+    /// dead after the merge (e.g. where-clause skips).
+    void append(PointView&& buf)
+    {
+        if (m_index.empty())
+        {
+            m_index = std::move(buf.m_index);
+            // Ditch temp points, as in the copying append.
+            m_index.resize(buf.m_size);
+            m_size = buf.m_size;
+        }
+        else
+            append(buf);
+        buf.m_index.clear();
+        buf.m_size = 0;
+    }
 
     /// Return a new point view with the same point table as this
     /// point buffer.
@@ -312,10 +357,21 @@ public:
     KD3Index& build3dIndex();
     KD2Index& build2dIndex();
 
+    /**
+      Set the path of a serialized index sidecar (see 'pdal index') that
+      build3dIndex() should try to load before building from scratch.
+      The sidecar is checksum-verified against the view's contents, so a
+      stale or mismatched file just means a fresh build.
+
+      \param path  Sidecar filename.
+    */
+    void setIndexSidecar(const std::string& path)
+        { m_indexSidecar = path; }
+
 protected:
     PointTableRef m_pointTable;
     PointLayoutPtr m_layout;
-    std::deque<PointId> m_index;
+    std::vector<PointId> m_index;
     // The index might be larger than the size to support temporary point
     // references.
     point_count_t m_size;
@@ -326,9 +382,10 @@ protected:
     std::map<std::string, std::unique_ptr<Rasterd>> m_rasters;
     std::unique_ptr<KD3Index> m_index3;
     std::unique_ptr<KD2Index> m_index2;
+    std::string m_indexSidecar;
 
 private:
-    static int m_lastId;
+    static std::atomic<int> m_lastId;
 
     PointId tableId(PointId idx);
 
@@ -367,6 +424,114 @@ struct PointViewLess
         { return p1->m_id < p2->m_id; }
 };
 
+/**
+  Accessor for a single dimension of a view that resolves the stored type
+  once at construction, eliminating the per-access type switch in
+  getFieldAs()/setField().  Intended for hot loops that touch the same
+  dimension for many points:
+
+  \code
+  TypedField<double> z(view, Dimension::Id::Z);
+  for (PointId i = 0; i < view.size(); ++i)
+      sum += z.get(i);
+  \endcode
+*/
+template <typename T>
+class TypedField
+{
+public:
+    TypedField(PointView& view, Dimension::Id dim) : m_view(view), m_dim(dim)
+    {
+        switch (view.layout()->dimDetail(dim)->type())
+        {
+        case Dimension::Type::Float:
+            bind<float>();
+            break;
+        case Dimension::Type::Double:
+            bind<double>();
+            break;
+        case Dimension::Type::Signed8:
+            bind<int8_t>();
+            break;
+        case Dimension::Type::Signed16:
+            bind<int16_t>();
+            break;
+        case Dimension::Type::Signed32:
+            bind<int32_t>();
+            break;
+        case Dimension::Type::Signed64:
+            bind<int64_t>();
+            break;
+        case Dimension::Type::Unsigned8:
+            bind<uint8_t>();
+            break;
+        case Dimension::Type::Unsigned16:
+            bind<uint16_t>();
+            break;
+        case Dimension::Type::Unsigned32:
+            bind<uint32_t>();
+            break;
+        case Dimension::Type::Unsigned64:
+            bind<uint64_t>();
+            break;
+        case Dimension::Type::None:
+            throw pdal_error("TypedField: dimension '" +
+                Dimension::name(dim) + "' has no type.");
+        }
+    }
+
+    T get(PointId idx) const
+        { return m_get(m_view, m_dim, idx); }
+
+    void set(PointId idx, T val)
+        { m_set(m_view, m_dim, idx, val); }
+
+private:
+    // Instantiate get/set over the stored type so that conversion is
+    // resolved when the accessor is built rather than on each access.
+    template <typename Storage>
+    void bind()
+    {
+        m_get = [](const PointView& view, Dimension::Id dim,
+            PointId idx) -> T
+        {
+            assert(idx < view.m_size);
+            Storage s;
+            view.m_pointTable.getFieldInternal(dim, view.m_index[idx], &s);
+            T retval;
+            if (!Utils::numericCast(s, retval))
+            {
+                std::ostringstream oss;
+                oss << "Unable to fetch data and convert as requested: ";
+                oss << Dimension::name(dim) << ":" <<
+                    Utils::typeidName<Storage>() << "(" << (double)s <<
+                    ") -> " << Utils::typeidName<T>();
+                throw pdal_error(oss.str());
+            }
+            return retval;
+        };
+        m_set = [](PointView& view, Dimension::Id dim, PointId idx, T val)
+        {
+            Storage s;
+            if (!Utils::numericCast(val, s))
+            {
+                std::ostringstream oss;
+                oss << "Unable to set data and convert as requested: ";
+                oss << Dimension::name(dim) << ":" <<
+                    Utils::typeidName<T>() << "(" << (double)val <<
+                    ") -> " << Utils::typeidName<Storage>();
+                throw pdal_error(oss.str());
+            }
+            view.m_pointTable.setFieldInternal(dim, view.tableId(idx), &s);
+        };
+    }
+
+    PointView& m_view;
+    Dimension::Id m_dim;
+    T (*m_get)(const PointView& view, Dimension::Id dim, PointId idx);
+    void (*m_set)(PointView& view, Dimension::Id dim, PointId idx, T val);
+};
+
 template <class T>
 T PointView::getFieldInternal(Dimension::Id dim, PointId id) const
 {
@@ -606,6 +771,18 @@ inline void PointView::appendPoint(const PointView& buffer, PointId id)
 }
 
 
+inline void PointView::appendPoints(const PointView& buffer,
+    const PointId *ids, point_count_t count)
+{
+    // Invalid ids are a programmer error.
+    m_index.reserve(m_index.size() + count);
+    for (point_count_t i = 0; i < count; ++i)
+        m_index.push_back(buffer.m_index[ids[i]]);
+    m_size += count;
+    assert(m_temps.empty());
+}
+
+
 // Make a temporary copy of a point by adding an entry to the index.
 inline PointId PointView::getTemp(PointId id)
 {
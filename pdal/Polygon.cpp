@@ -38,6 +38,9 @@
 #include <ogr_geometry.h>
 #pragma warning(pop)
 
+#include <atomic>
+#include <mutex>
+
 #include <pdal/Polygon.hpp>
 #include <pdal/private/gdal/GDALUtils.hpp>
 
@@ -48,6 +51,8 @@ namespace pdal
 
 struct Polygon::PrivateData
 {
+    std::atomic<bool> m_gridsReady { false };
+    std::mutex m_gridMutex;
     std::vector<GridPnp> m_grids;
 };
 
@@ -147,6 +152,7 @@ Polygon& Polygon::operator=(const Polygon& src)
 
 void Polygon::modified()
 {
+    m_pd->m_gridsReady = false;
     m_pd->m_grids.clear();
 }
 
@@ -296,16 +302,32 @@ bool Polygon::intersects(const Polygon& p) const
 /// \return  Whether the polygon contains the point or not.
 bool Polygon::contains(double x, double y) const
 {
-    if (m_pd->m_grids.empty())
-        for (const Polygon& p : polygons())
-            m_pd->m_grids.emplace_back(p.exteriorRing(), p.interiorRings());
-    for (auto& g : m_pd->m_grids)
+    if (!m_pd->m_gridsReady.load(std::memory_order_acquire))
+        buildGrids();
+    for (const auto& g : m_pd->m_grids)
         if (g.inside(x, y))
             return true;
     return false;
 }
 
 
+// Build and retain the point-in-polygon grids.  Construction is guarded
+// so the first query may come from any thread, and the cell states are
+// precomputed so that later inside() queries are read-only and can run
+// from several threads at once.
+void Polygon::buildGrids() const
+{
+    std::lock_guard<std::mutex> lock(m_pd->m_gridMutex);
+    if (m_pd->m_gridsReady)
+        return;
+    for (const Polygon& p : polygons())
+        m_pd->m_grids.emplace_back(p.exteriorRing(), p.interiorRings());
+    for (auto& g : m_pd->m_grids)
+        g.precompute();
+    m_pd->m_gridsReady.store(true, std::memory_order_release);
+}
+
+
 bool Polygon::touches(const Polygon& p) const
 {
     throwNoGeos();
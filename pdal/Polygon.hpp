@@ -85,6 +85,7 @@ public:
 
 private:
     void init();
+    void buildGrids() const;
     void removeSmallRings(double tolerance);
     void removeSmallHoles(double tolerance);
 
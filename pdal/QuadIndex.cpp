@@ -32,8 +32,10 @@
 * OF SUCH DAMAGE.
 ****************************************************************************/
 
-#include <limits>
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <limits>
 #include <memory>
 
 #include <pdal/PointView.hpp>
@@ -73,19 +75,6 @@ namespace
                     halfHeight + other.halfHeight;
         }
 
-        bool overlaps(
-            const double xBegin,
-            const double xEnd,
-            const double yBegin,
-            const double yEnd) const
-        {
-            const BBox other(
-                    Point(xBegin, yBegin),
-                    Point(xEnd, yEnd));
-
-            return overlaps(other);
-        }
-
         // Returns true if the requested point is contained within this BBox.
         bool contains(const Point& p) const
         {
@@ -106,378 +95,63 @@ namespace
         BBox& operator=(const BBox&); // not implemented
     };
 
-} // anonymous namespace
+    // Number of grid subdivisions in each direction at the deepest level of
+    // the implicit tree - the tree stores a 32-bit cell position per axis.
+    const std::size_t maxLevel = 32;
 
-namespace pdal
-{
-
-// Recursive quadtree implementation.
-struct Tree
-{
-    Tree(BBox bbox, const QuadPointRef* data = 0)
-        : bbox(bbox)
-        , data(data)
-        , nw()
-        , ne()
-        , se()
-        , sw()
-    { }
-
-    void getFills(std::vector<std::size_t>& fills, std::size_t level = 0) const;
-
-    // Returns depth resulting from the insertion of this point.
-    std::size_t addPoint(const QuadPointRef* toAdd, std::size_t curDepth = 0);
-
-    void getPoints(
-            PointIdList& results,
-            std::size_t depthBegin,
-            std::size_t depthEnd,
-            std::size_t curDepth) const;
+    // Level assigned to points not yet claimed as a node representative
+    // during construction.
+    const uint32_t unsetLevel = (std::numeric_limits<uint32_t>::max)();
 
-    void getPoints(
-            PointIdList& results,
-            std::size_t rasterize,
-            double xBegin,
-            double xEnd,
-            double xStep,
-            double yBegin,
-            double yEnd,
-            double yStep,
-            std::size_t curDepth) const;
+    // Stop subdividing a range query once this few points remain - a linear
+    // scan beats further binary searches at this size.
+    const std::size_t queryLeafSize = 64;
 
-    void getPoints(
-            PointIdList& results,
-            double xBegin,
-            double xEnd,
-            double xStep,
-            double yBegin,
-            double yEnd,
-            double yStep) const;
-
-    void getPoints(
-            PointIdList& results,
-            const BBox& query,
-            std::size_t depthBegin,
-            std::size_t depthEnd,
-            std::size_t curDepth) const;
-
-    const BBox bbox;
-    const QuadPointRef* data;
-
-    std::unique_ptr<Tree> nw;
-    std::unique_ptr<Tree> ne;
-    std::unique_ptr<Tree> se;
-    std::unique_ptr<Tree> sw;
-};
-
-std::size_t Tree::addPoint(const QuadPointRef* toAdd, const std::size_t curDepth)
-{
-    if (data)
+    // Quantize a coordinate onto the 2^32 grid cells spanning [lo, hi).
+    uint32_t quantize(double v, double lo, double hi)
     {
-        const Point& center(bbox.center);
-
-        if (toAdd->point.sqDist(center) < data->point.sqDist(center))
-        {
-            std::swap(data, toAdd);
-        }
-
-        const std::size_t nextDepth(curDepth + 1);
-
-        if (toAdd->point.x < center.x)
-        {
-            if (toAdd->point.y < center.y)
-            {
-                if (sw)
-                {
-                    return sw->addPoint(toAdd, nextDepth);
-                }
-                else
-                {
-                    sw.reset(new Tree(
-                            BBox(
-                                Point(bbox.minimum.x, bbox.minimum.y),
-                                Point(center.x, center.y)),
-                            toAdd));
-
-                    return nextDepth;
-                }
-            }
-            else
-            {
-                if (nw)
-                {
-                    return nw->addPoint(toAdd, nextDepth);
-                }
-                else
-                {
-                    nw.reset(new Tree(
-                            BBox(
-                                Point(bbox.minimum.x, center.y),
-                                Point(center.x, bbox.maximum.y)),
-                            toAdd));
-
-                    return nextDepth;
-                }
-            }
-        }
-        else
-        {
-            if (toAdd->point.y < center.y)
-            {
-                if (se)
-                {
-                    return se->addPoint(toAdd, nextDepth);
-                }
-                else
-                {
-                    se.reset(new Tree(
-                            BBox(
-                                Point(center.x, bbox.minimum.y),
-                                Point(bbox.maximum.x, center.y)),
-                            toAdd));
-
-                    return nextDepth;
-                }
-            }
-            else
-            {
-                if (ne)
-                {
-                    return ne->addPoint(toAdd, nextDepth);
-                }
-                else
-                {
-                    ne.reset(new Tree(
-                            BBox(
-                                Point(center.x, center.y),
-                                Point(bbox.maximum.x, bbox.maximum.y)),
-                            toAdd));
-
-                    return nextDepth;
-                }
-            }
-        }
+        if (!(hi > lo))
+            return 0;
+        const double t = (v - lo) / (hi - lo) * 4294967296.0;
+        if (t <= 0)
+            return 0;
+        if (t >= 4294967295.0)
+            return 0xFFFFFFFFu;
+        return static_cast<uint32_t>(t);
     }
-    else
-    {
-        data = toAdd;
-        return curDepth;
-    }
-}
 
-// Fills are a count of the number of points at each level of the quad tree.
-void Tree::getFills(std::vector<std::size_t>& fills, std::size_t level) const
-{
-    if (data)
-    {
-        if (level >= fills.size())
-            fills.resize(level + 1);
-        (fills[level])++;
-    }
-
-    ++level;
-    if (nw) nw->getFills(fills, level);
-    if (ne) ne->getFills(fills, level);
-    if (sw) sw->getFills(fills, level);
-    if (se) se->getFills(fills, level);
-}
-
-
-void Tree::getPoints(
-        PointIdList& results,
-        const std::size_t depthBegin,
-        const std::size_t depthEnd,
-        std::size_t curDepth) const
-{
-    if (data && curDepth >= depthBegin)
-    {
-        results.push_back(data->pbIndex);
-    }
-
-    if (++curDepth < depthEnd || depthEnd == 0)
-    {
-        if (nw) nw->getPoints(results, depthBegin, depthEnd, curDepth);
-        if (ne) ne->getPoints(results, depthBegin, depthEnd, curDepth);
-        if (se) se->getPoints(results, depthBegin, depthEnd, curDepth);
-        if (sw) sw->getPoints(results, depthBegin, depthEnd, curDepth);
-    }
-}
-
-void Tree::getPoints(
-        PointIdList& results,
-        const std::size_t rasterize,
-        const double xBegin,
-        const double xEnd,
-        const double xStep,
-        const double yBegin,
-        const double yEnd,
-        const double yStep,
-        std::size_t curDepth) const
-{
-    if (curDepth == rasterize)
-    {
-        if (data)
-        {
-            double xOffset(Utils::sround((bbox.center.x - xBegin) / xStep));
-            double yOffset(Utils::sround((bbox.center.y - yBegin) / yStep));
-
-            const std::size_t index(
-                static_cast<size_t>(
-                    Utils::sround(yOffset * (xEnd - xBegin) / xStep +
-                        xOffset)));
-
-            results.at(index) = data->pbIndex;
-        }
-    }
-    else if (++curDepth <= rasterize)
+    // Spread the bits of a 32-bit value into the even bits of a 64-bit
+    // value.
+    uint64_t spreadBits(uint32_t v)
     {
-        if (nw) nw->getPoints(
-                results,
-                rasterize,
-                xBegin,
-                xEnd,
-                xStep,
-                yBegin,
-                yEnd,
-                yStep,
-                curDepth);
-
-        if (ne) ne->getPoints(
-                results,
-                rasterize,
-                xBegin,
-                xEnd,
-                xStep,
-                yBegin,
-                yEnd,
-                yStep,
-                curDepth);
-
-        if (se) se->getPoints(
-                results,
-                rasterize,
-                xBegin,
-                xEnd,
-                xStep,
-                yBegin,
-                yEnd,
-                yStep,
-                curDepth);
-
-        if (sw) sw->getPoints(
-                results,
-                rasterize,
-                xBegin,
-                xEnd,
-                xStep,
-                yBegin,
-                yEnd,
-                yStep,
-                curDepth);
+        uint64_t x = v;
+        x = (x | (x << 16)) & 0x0000FFFF0000FFFFULL;
+        x = (x | (x << 8))  & 0x00FF00FF00FF00FFULL;
+        x = (x | (x << 4))  & 0x0F0F0F0F0F0F0F0FULL;
+        x = (x | (x << 2))  & 0x3333333333333333ULL;
+        x = (x | (x << 1))  & 0x5555555555555555ULL;
+        return x;
     }
-}
 
-void Tree::getPoints(
-        PointIdList& results,
-        const double xBegin,
-        const double xEnd,
-        const double xStep,
-        const double yBegin,
-        const double yEnd,
-        const double yStep) const
-{
-    if (!bbox.overlaps(xBegin, xEnd, yBegin, yEnd))
+    // Interleave quantized coordinates into a Morton code.  Sorting points
+    // by this code groups every node of the implicit quadtree into a
+    // contiguous range.
+    uint64_t mortonCode(uint32_t qx, uint32_t qy)
     {
-        return;
+        return (spreadBits(qy) << 1) | spreadBits(qx);
     }
 
-    if (nw) nw->getPoints(
-            results,
-            xBegin,
-            xEnd,
-            xStep,
-            yBegin,
-            yEnd,
-            yStep);
-
-    if (ne) ne->getPoints(
-            results,
-            xBegin,
-            xEnd,
-            xStep,
-            yBegin,
-            yEnd,
-            yStep);
-
-    if (se) se->getPoints(
-            results,
-            xBegin,
-            xEnd,
-            xStep,
-            yBegin,
-            yEnd,
-            yStep);
-
-    if (sw) sw->getPoints(
-            results,
-            xBegin,
-            xEnd,
-            xStep,
-            yBegin,
-            yEnd,
-            yStep);
-
-    // Add data after calling child nodes so we prefer upper levels of the tree.
-    if (
-            data &&
-            data->point.x >= xBegin &&
-            data->point.y >= yBegin &&
-            data->point.x < xEnd - xStep &&
-            data->point.y < yEnd - yStep)
-    {
-        double xOffset(Utils::sround((data->point.x - xBegin) / xStep));
-        double yOffset(Utils::sround((data->point.y - yBegin) / yStep));
-
-        std::size_t index(
-            static_cast<size_t>(
-                Utils::sround(yOffset * (xEnd - xBegin) / xStep + xOffset)));
-
-        if (index < results.size())
-        {
-            results.at(index) = data->pbIndex;
-        }
-    }
-}
+} // anonymous namespace
 
-void Tree::getPoints(
-        PointIdList& results,
-        const BBox& query,
-        const std::size_t depthBegin,
-        const std::size_t depthEnd,
-        std::size_t curDepth) const
+namespace pdal
 {
-    if (!query.overlaps(bbox))
-    {
-        return;
-    }
-
-    if (data &&
-        query.contains(data->point) &&
-        curDepth >= depthBegin &&
-        (curDepth < depthEnd || depthEnd == 0))
-    {
-        results.push_back(data->pbIndex);
-    }
-
-    if (++curDepth < depthEnd || depthEnd == 0)
-    {
-        if (nw) nw->getPoints(results, query, depthBegin, depthEnd, curDepth);
-        if (ne) ne->getPoints(results, query, depthBegin, depthEnd, curDepth);
-        if (se) se->getPoints(results, query, depthBegin, depthEnd, curDepth);
-        if (sw) sw->getPoints(results, query, depthBegin, depthEnd, curDepth);
-    }
-}
 
+// Linear quadtree implementation.  Points are sorted by Morton code, so
+// every node of the conceptual tree corresponds to a contiguous range of
+// the sorted arrays and node boundaries are found by binary search - no
+// per-node structures are allocated.  Each point carries the level of the
+// node it represents: the point closest to a node's center represents that
+// node, as in the pointer-based tree this replaces.
 struct QuadIndex::QImpl
 {
     QImpl(const PointView& view, std::size_t topLevel);
@@ -535,49 +209,80 @@ struct QuadIndex::QImpl
             std::size_t depthBegin,
             std::size_t depthEnd) const;
 
+    // Sort the gathered points by Morton code and assign node levels.
+    void build();
+
+    // Choose the representative for the node covering the sorted range
+    // [begin, end) and recurse into its children.  Returns the deepest
+    // level assigned within the subtree.
+    std::size_t assignLevels(
+            std::size_t begin,
+            std::size_t end,
+            std::size_t level,
+            uint32_t cellX,
+            uint32_t cellY);
+
+    // Collect points within 'query' from the node covering [begin, end),
+    // pruning entire ranges whose node cells fall outside the query.
+    void queryRange(
+            PointIdList& results,
+            const BBox& query,
+            std::size_t begin,
+            std::size_t end,
+            std::size_t level,
+            uint32_t cellX,
+            uint32_t cellY,
+            std::size_t depthBegin,
+            std::size_t depthEnd) const;
+
     std::size_t m_topLevel;
-    std::vector<std::shared_ptr<QuadPointRef> > m_pointRefVec;
-    std::unique_ptr<Tree> m_tree;
+
+    double m_xMin;
+    double m_yMin;
+    double m_xMax;
+    double m_yMax;
+
+    // Parallel arrays in Morton-sorted order.
+    std::vector<uint64_t> m_codes;
+    std::vector<uint32_t> m_qx;
+    std::vector<uint32_t> m_qy;
+    std::vector<double> m_x;
+    std::vector<double> m_y;
+    PointIdList m_ids;
+    std::vector<uint32_t> m_levels;
+
     std::size_t m_depth;
     std::vector<std::size_t> m_fills;
 };
 
 QuadIndex::QImpl::QImpl(const PointView& view, std::size_t topLevel)
     : m_topLevel(topLevel)
-    , m_pointRefVec()
-    , m_tree()
+    , m_xMin((std::numeric_limits<double>::max)())
+    , m_yMin((std::numeric_limits<double>::max)())
+    , m_xMax((std::numeric_limits<double>::lowest)())
+    , m_yMax((std::numeric_limits<double>::lowest)())
     , m_depth(0)
-    , m_fills()
 {
-    m_pointRefVec.resize(view.size());
-
-    double xMin((std::numeric_limits<double>::max)());
-    double yMin((std::numeric_limits<double>::max)());
-    double xMax((std::numeric_limits<double>::min)());
-    double yMax((std::numeric_limits<double>::min)());
+    m_x.reserve(view.size());
+    m_y.reserve(view.size());
+    m_ids.reserve(view.size());
 
     for (PointId i(0); i < view.size(); ++i)
     {
-        m_pointRefVec[i].reset(
-                new QuadPointRef(
-                    Point(
-                        view.getFieldAs<double>(Dimension::Id::X, i),
-                        view.getFieldAs<double>(Dimension::Id::Y, i)),
-                i));
-
-        const QuadPointRef* pointRef(m_pointRefVec[i].get());
-        if (pointRef->point.x < xMin) xMin = pointRef->point.x;
-        if (pointRef->point.x > xMax) xMax = pointRef->point.x;
-        if (pointRef->point.y < yMin) yMin = pointRef->point.y;
-        if (pointRef->point.y > yMax) yMax = pointRef->point.y;
-    }
+        const double x(view.getFieldAs<double>(Dimension::Id::X, i));
+        const double y(view.getFieldAs<double>(Dimension::Id::Y, i));
 
-    m_tree.reset(new Tree(BBox(Point(xMin, yMin), Point(xMax, yMax))));
+        m_x.push_back(x);
+        m_y.push_back(y);
+        m_ids.push_back(i);
 
-    for (std::size_t i = 0; i < m_pointRefVec.size(); ++i)
-    {
-        m_depth = (std::max)(m_tree->addPoint(m_pointRefVec[i].get()), m_depth);
+        if (x < m_xMin) m_xMin = x;
+        if (x > m_xMax) m_xMax = x;
+        if (y < m_yMin) m_yMin = y;
+        if (y > m_yMax) m_yMax = y;
     }
+
+    build();
 }
 
 QuadIndex::QImpl::QImpl(
@@ -588,29 +293,24 @@ QuadIndex::QImpl::QImpl(
         double yMax,
         std::size_t topLevel)
     : m_topLevel(topLevel)
-    , m_pointRefVec()
-    , m_tree()
+    , m_xMin(xMin)
+    , m_yMin(yMin)
+    , m_xMax(xMax)
+    , m_yMax(yMax)
     , m_depth(0)
-    , m_fills()
 {
-    m_pointRefVec.resize(view.size());
+    m_x.reserve(view.size());
+    m_y.reserve(view.size());
+    m_ids.reserve(view.size());
 
     for (PointId i(0); i < view.size(); ++i)
     {
-        m_pointRefVec[i].reset(
-                new QuadPointRef(
-                    Point(
-                        view.getFieldAs<double>(Dimension::Id::X, i),
-                        view.getFieldAs<double>(Dimension::Id::Y, i)),
-                i));
+        m_x.push_back(view.getFieldAs<double>(Dimension::Id::X, i));
+        m_y.push_back(view.getFieldAs<double>(Dimension::Id::Y, i));
+        m_ids.push_back(i);
     }
 
-    m_tree.reset(new Tree(BBox(Point(xMin, yMin), Point(xMax, yMax))));
-
-    for (std::size_t i = 0; i < m_pointRefVec.size(); ++i)
-    {
-        m_depth = (std::max)(m_tree->addPoint(m_pointRefVec[i].get()), m_depth);
-    }
+    build();
 }
 
 QuadIndex::QImpl::QImpl(
@@ -621,18 +321,136 @@ QuadIndex::QImpl::QImpl(
         double yMax,
         std::size_t topLevel)
     : m_topLevel(topLevel)
-    , m_pointRefVec(points.size())
-    , m_tree()
+    , m_xMin(xMin)
+    , m_yMin(yMin)
+    , m_xMax(xMax)
+    , m_yMax(yMax)
     , m_depth(0)
-    , m_fills()
 {
-    m_tree.reset(new Tree(BBox(Point(xMin, yMin), Point(xMax, yMax))));
+    m_x.reserve(points.size());
+    m_y.reserve(points.size());
+    m_ids.reserve(points.size());
 
     for (std::size_t i = 0; i < points.size(); ++i)
     {
-        m_pointRefVec[i] = points[i];
-        m_depth = (std::max)(m_tree->addPoint(m_pointRefVec[i].get()), m_depth);
+        m_x.push_back(points[i]->point.x);
+        m_y.push_back(points[i]->point.y);
+        m_ids.push_back(points[i]->pbIndex);
     }
+
+    build();
+}
+
+void QuadIndex::QImpl::build()
+{
+    const std::size_t n(m_x.size());
+
+    m_qx.resize(n);
+    m_qy.resize(n);
+    m_codes.resize(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        m_qx[i] = quantize(m_x[i], m_xMin, m_xMax);
+        m_qy[i] = quantize(m_y[i], m_yMin, m_yMax);
+        m_codes[i] = mortonCode(m_qx[i], m_qy[i]);
+    }
+
+    // Stable, so coincident points keep their input order, as they did
+    // when inserted one at a time into the pointer-based tree.
+    std::vector<std::size_t> order(n);
+    for (std::size_t i = 0; i < n; ++i)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(),
+        [this](std::size_t a, std::size_t b)
+        { return m_codes[a] < m_codes[b]; });
+
+    auto permute = [&order, n](auto& v)
+    {
+        auto sorted(v);
+        for (std::size_t i = 0; i < n; ++i)
+            sorted[i] = v[order[i]];
+        v = std::move(sorted);
+    };
+    permute(m_codes);
+    permute(m_qx);
+    permute(m_qy);
+    permute(m_x);
+    permute(m_y);
+    permute(m_ids);
+
+    m_levels.assign(n, unsetLevel);
+    if (n)
+        m_depth = assignLevels(0, n, 0, 0, 0);
+}
+
+std::size_t QuadIndex::QImpl::assignLevels(
+        const std::size_t begin,
+        const std::size_t end,
+        const std::size_t level,
+        const uint32_t cellX,
+        const uint32_t cellY)
+{
+    const double xCell(std::ldexp(m_xMax - m_xMin, -(int)level));
+    const double yCell(std::ldexp(m_yMax - m_yMin, -(int)level));
+    const Point center(
+            m_xMin + (cellX + 0.5) * xCell,
+            m_yMin + (cellY + 0.5) * yCell);
+
+    // The point closest to the node center represents this node.  Points
+    // already claimed by an enclosing node are skipped.
+    std::size_t rep(end);
+    double best(0);
+    for (std::size_t i = begin; i < end; ++i)
+    {
+        if (m_levels[i] != unsetLevel)
+            continue;
+        const double d(center.sqDist(Point(m_x[i], m_y[i])));
+        if (rep == end || d < best)
+        {
+            rep = i;
+            best = d;
+        }
+    }
+    if (rep == end)
+        return 0;
+    m_levels[rep] = static_cast<uint32_t>(level);
+
+    if (level == maxLevel || m_codes[begin] == m_codes[end - 1])
+    {
+        // Can't subdivide any further.  Chain leftover points one per
+        // level, as repeated insertion of coincident points did in the
+        // pointer-based tree.
+        std::size_t l(level);
+        for (std::size_t i = begin; i < end; ++i)
+            if (m_levels[i] == unsetLevel)
+                m_levels[i] = static_cast<uint32_t>(++l);
+        return l;
+    }
+
+    std::size_t deepest(level);
+    const unsigned shift(static_cast<unsigned>(62 - 2 * level));
+    std::size_t childBegin(begin);
+    for (uint64_t digit = 0; digit < 4; ++digit)
+    {
+        const std::size_t childEnd((digit == 3) ? end :
+            static_cast<std::size_t>(std::lower_bound(
+                m_codes.begin() + childBegin,
+                m_codes.begin() + end,
+                digit + 1,
+                [shift](uint64_t code, uint64_t d)
+                { return ((code >> shift) & 3) < d; }) - m_codes.begin()));
+
+        if (childEnd != childBegin)
+            deepest = (std::max)(deepest, assignLevels(
+                    childBegin,
+                    childEnd,
+                    level + 1,
+                    2 * cellX + static_cast<uint32_t>(digit & 1),
+                    2 * cellY + static_cast<uint32_t>(digit >> 1)));
+
+        childBegin = childEnd;
+    }
+    return deepest;
 }
 
 void QuadIndex::QImpl::getBounds(
@@ -641,13 +459,10 @@ void QuadIndex::QImpl::getBounds(
         double& xMax,
         double& yMax) const
 {
-    if (m_tree)
-    {
-        xMin = m_tree->bbox.minimum.x;
-        yMin = m_tree->bbox.minimum.y;
-        xMax = m_tree->bbox.maximum.x;
-        yMax = m_tree->bbox.maximum.y;
-    }
+    xMin = m_xMin;
+    yMin = m_yMin;
+    xMax = m_xMax;
+    yMax = m_yMax;
 }
 
 std::size_t QuadIndex::QImpl::getDepth() const
@@ -657,9 +472,11 @@ std::size_t QuadIndex::QImpl::getDepth() const
 
 std::vector<std::size_t> QuadIndex::QImpl::getFills()
 {
-    if (m_tree && !m_fills.size())
+    if (m_levels.size() && !m_fills.size())
     {
-        m_tree->getFills(m_fills);
+        m_fills.resize(m_depth + 1);
+        for (std::size_t i = 0; i < m_levels.size(); ++i)
+            m_fills[m_levels[i]]++;
     }
 
     return m_fills;
@@ -671,9 +488,11 @@ PointIdList QuadIndex::QImpl::getPoints(
 {
     PointIdList results;
 
-    if (m_tree)
+    for (std::size_t i = 0; i < m_ids.size(); ++i)
     {
-        m_tree->getPoints(results, minDepth, maxDepth, m_topLevel);
+        const std::size_t depth(m_levels[i] + m_topLevel);
+        if (depth >= minDepth && (maxDepth == 0 || depth < maxDepth))
+            results.push_back(m_ids[i]);
     }
 
     return results;
@@ -690,32 +509,49 @@ PointIdList QuadIndex::QImpl::getPoints(
 {
     PointIdList results;
 
-    if (m_tree)
+    const size_t exp(static_cast<size_t>(std::pow(2, rasterize)));
+    const double xWidth(m_xMax - m_xMin);
+    const double yWidth(m_yMax - m_yMin);
+
+    xStep = xWidth / exp;
+    yStep = yWidth / exp;
+    xBegin =    m_xMin + (xStep / 2);
+    yBegin =    m_yMin + (yStep / 2);
+    // One tick past the end.
+    xEnd =      m_xMax + (xStep / 2);
+    yEnd =      m_yMax + (yStep / 2);
+
+    results.resize(exp * exp, (std::numeric_limits<PointId>::max)());
+
+    if (rasterize < m_topLevel)
+        return results;
+
+    const std::size_t lvl(rasterize - m_topLevel);
+    const std::size_t cellLevel((std::min)(lvl, maxLevel));
+    const double xCell(std::ldexp(xWidth, -(int)cellLevel));
+    const double yCell(std::ldexp(yWidth, -(int)cellLevel));
+
+    for (std::size_t i = 0; i < m_levels.size(); ++i)
     {
-        const size_t exp(static_cast<size_t>(std::pow(2, rasterize)));
-        const double xWidth(m_tree->bbox.maximum.x - m_tree->bbox.minimum.x);
-        const double yWidth(m_tree->bbox.maximum.y - m_tree->bbox.minimum.y);
-
-        xStep = xWidth / exp;
-        yStep = yWidth / exp;
-        xBegin =    m_tree->bbox.minimum.x + (xStep / 2);
-        yBegin =    m_tree->bbox.minimum.y + (yStep / 2);
-        // One tick past the end.
-        xEnd =      m_tree->bbox.maximum.x + (xStep / 2);
-        yEnd =      m_tree->bbox.maximum.y + (yStep / 2);
-
-        results.resize(exp * exp, (std::numeric_limits<PointId>::max)());
-
-        m_tree->getPoints(
-                results,
-                rasterize,
-                xBegin,
-                xEnd,
-                xStep,
-                yBegin,
-                yEnd,
-                yStep,
-                m_topLevel);
+        if (m_levels[i] != lvl)
+            continue;
+
+        // Rasterize from the center of this point's node cell.
+        const uint32_t cellX(cellLevel ?
+                m_qx[i] >> (32 - cellLevel) : 0);
+        const uint32_t cellY(cellLevel ?
+                m_qy[i] >> (32 - cellLevel) : 0);
+        const double centerX(m_xMin + (cellX + 0.5) * xCell);
+        const double centerY(m_yMin + (cellY + 0.5) * yCell);
+
+        const double xOffset(Utils::sround((centerX - xBegin) / xStep));
+        const double yOffset(Utils::sround((centerY - yBegin) / yStep));
+
+        const std::size_t index(
+            static_cast<size_t>(
+                Utils::sround(yOffset * (xEnd - xBegin) / xStep + xOffset)));
+
+        results.at(index) = m_ids[i];
     }
 
     return results;
@@ -731,22 +567,34 @@ PointIdList QuadIndex::QImpl::getPoints(
 {
     PointIdList results;
 
-    if (m_tree)
+    size_t width(
+        static_cast<size_t>(Utils::sround((xEnd - xBegin) / xStep)));
+    std::size_t height(
+        static_cast<size_t>(Utils::sround((yEnd - yBegin) / yStep)));
+    results.resize(width * height, (std::numeric_limits<PointId>::max)());
+
+    // Track the node level written to each cell so that upper levels of
+    // the tree are preferred when multiple points land in one cell.
+    std::vector<uint32_t> cellLevel(results.size(), unsetLevel);
+
+    for (std::size_t i = 0; i < m_ids.size(); ++i)
     {
-        size_t width(
-            static_cast<size_t>(Utils::sround((xEnd - xBegin) / xStep)));
-        std::size_t height(
-            static_cast<size_t>(Utils::sround((yEnd - yBegin) / yStep)));
-        results.resize(width * height, (std::numeric_limits<PointId>::max)());
-
-        m_tree->getPoints(
-                results,
-                xBegin,
-                xEnd,
-                xStep,
-                yBegin,
-                yEnd,
-                yStep);
+        if (m_x[i] < xBegin || m_x[i] >= xEnd - xStep ||
+            m_y[i] < yBegin || m_y[i] >= yEnd - yStep)
+            continue;
+
+        const double xOffset(Utils::sround((m_x[i] - xBegin) / xStep));
+        const double yOffset(Utils::sround((m_y[i] - yBegin) / yStep));
+
+        const std::size_t index(
+            static_cast<size_t>(
+                Utils::sround(yOffset * (xEnd - xBegin) / xStep + xOffset)));
+
+        if (index < results.size() && m_levels[i] < cellLevel[index])
+        {
+            results.at(index) = m_ids[i];
+            cellLevel[index] = m_levels[i];
+        }
     }
 
     return results;
@@ -763,19 +611,87 @@ PointIdList QuadIndex::QImpl::getPoints(
     PointIdList results;
 
     // Making BBox from external parameters here, so do some light validation.
-    if (m_tree)
+    const BBox query(
+            Point((std::min)(xMin, xMax), (std::min)(yMin, yMax)),
+            Point((std::max)(xMin, xMax), (std::max)(yMin, yMax)));
+
+    if (m_ids.size())
+        queryRange(results, query, 0, m_ids.size(), 0, 0, 0,
+                minDepth, maxDepth);
+
+    return results;
+}
+
+void QuadIndex::QImpl::queryRange(
+        PointIdList& results,
+        const BBox& query,
+        const std::size_t begin,
+        const std::size_t end,
+        const std::size_t level,
+        const uint32_t cellX,
+        const uint32_t cellY,
+        const std::size_t depthBegin,
+        const std::size_t depthEnd) const
+{
+    const double xCell(std::ldexp(m_xMax - m_xMin, -(int)level));
+    const double yCell(std::ldexp(m_yMax - m_yMin, -(int)level));
+    const double nodeXMin(m_xMin + cellX * xCell);
+    const double nodeYMin(m_yMin + cellY * yCell);
+    const BBox node(
+            Point(nodeXMin, nodeYMin),
+            Point(nodeXMin + xCell, nodeYMin + yCell));
+
+    if (!query.overlaps(node))
+        return;
+
+    const bool inside(
+            nodeXMin >= query.minimum.x &&
+            nodeYMin >= query.minimum.y &&
+            nodeXMin + xCell <= query.maximum.x &&
+            nodeYMin + yCell <= query.maximum.y);
+
+    // Scan small ranges and ranges wholly inside the query directly; only
+    // partially-overlapping nodes are worth subdividing.
+    if (inside || level == maxLevel || end - begin <= queryLeafSize ||
+        m_codes[begin] == m_codes[end - 1])
     {
-        m_tree->getPoints(
-                results,
-                BBox(
-                    Point((std::min)(xMin, xMax), (std::min)(yMin, yMax)),
-                    Point((std::max)(xMin, xMax), (std::max)(yMin, yMax))),
-                minDepth,
-                maxDepth,
-                m_topLevel);
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            const std::size_t depth(m_levels[i] + m_topLevel);
+            if (depth >= depthBegin &&
+                (depthEnd == 0 || depth < depthEnd) &&
+                query.contains(Point(m_x[i], m_y[i])))
+            {
+                results.push_back(m_ids[i]);
+            }
+        }
+        return;
     }
 
-    return results;
+    const unsigned shift(static_cast<unsigned>(62 - 2 * level));
+    std::size_t childBegin(begin);
+    for (uint64_t digit = 0; digit < 4; ++digit)
+    {
+        const std::size_t childEnd((digit == 3) ? end :
+            static_cast<std::size_t>(std::lower_bound(
+                m_codes.begin() + childBegin,
+                m_codes.begin() + end,
+                digit + 1,
+                [shift](uint64_t code, uint64_t d)
+                { return ((code >> shift) & 3) < d; }) - m_codes.begin()));
+
+        if (childEnd != childBegin)
+            queryRange(results, query,
+                    childBegin,
+                    childEnd,
+                    level + 1,
+                    2 * cellX + static_cast<uint32_t>(digit & 1),
+                    2 * cellY + static_cast<uint32_t>(digit >> 1),
+                    depthBegin,
+                    depthEnd);
+
+        childBegin = childEnd;
+    }
 }
 
 QuadIndex::QuadIndex(const PointView& view, std::size_t topLevel)
@@ -907,4 +823,3 @@ PointIdList QuadIndex::getPoints(
 }
 
 } // namespace pdal
-
@@ -32,12 +32,31 @@
 * OF SUCH DAMAGE.
 ****************************************************************************/
 
+#include <pdal/KDIndex.hpp>
 #include <pdal/Reader.hpp>
 #include <pdal/util/ProgramArgs.hpp>
 
 namespace pdal
 {
 
+PointViewSet Reader::run(PointViewPtr view)
+{
+    PointViewSet viewSet;
+
+    view->clearTemps();
+    read(view, m_count);
+
+    // Point the view at a prebuilt index sidecar (see 'pdal index') in
+    // case one was written next to the source file.  Loading is deferred
+    // and checksum-verified, so this costs nothing when no sidecar exists
+    // or no stage asks for an index.
+    if (m_filename.size())
+        view->setIndexSidecar(KD3Index::indexFilename(m_filename));
+
+    viewSet.insert(view);
+    return viewSet;
+}
+
 const expr::ConditionalExpression* Reader::whereExpr() const
 {
     return nullptr;
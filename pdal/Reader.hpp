@@ -78,15 +78,7 @@ protected:
             const SpatialReference& srs);
 
 private:
-    virtual PointViewSet run(PointViewPtr view)
-    {
-        PointViewSet viewSet;
-
-        view->clearTemps();
-        read(view, m_count);
-        viewSet.insert(view);
-        return viewSet;
-    }
+    virtual PointViewSet run(PointViewPtr view);
     virtual void l_initialize(PointTableRef table) final;
     virtual void l_addArgs(ProgramArgs& args) final;
     virtual void l_prepared(PointTableRef table) final;
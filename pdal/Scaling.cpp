@@ -122,4 +122,44 @@ void Scaling::setAutoXForm(const PointViewSet& pvSet)
 }
 
 
+void Scaling::toScaled(double *x, double *y, double *z,
+    point_count_t count) const
+{
+    const double xScale = m_xXform.m_scale.m_val;
+    const double yScale = m_yXform.m_scale.m_val;
+    const double zScale = m_zXform.m_scale.m_val;
+    const double xOffset = m_xXform.m_offset.m_val;
+    const double yOffset = m_yXform.m_offset.m_val;
+    const double zOffset = m_zXform.m_offset.m_val;
+
+    for (point_count_t i = 0; i < count; ++i)
+        x[i] = (x[i] - xOffset) / xScale;
+    for (point_count_t i = 0; i < count; ++i)
+        y[i] = (y[i] - yOffset) / yScale;
+    for (point_count_t i = 0; i < count; ++i)
+        z[i] = (z[i] - zOffset) / zScale;
+}
+
+
+void Scaling::fromScaled(double *x, double *y, double *z,
+    point_count_t count) const
+{
+    const double xScale = m_xXform.m_scale.m_val;
+    const double yScale = m_yXform.m_scale.m_val;
+    const double zScale = m_zXform.m_scale.m_val;
+    const double xOffset = m_xXform.m_offset.m_val;
+    const double yOffset = m_yXform.m_offset.m_val;
+    const double zOffset = m_zXform.m_offset.m_val;
+
+    // Multiply-add per element; contracts to FMA where the target
+    // supports it.
+    for (point_count_t i = 0; i < count; ++i)
+        x[i] = x[i] * xScale + xOffset;
+    for (point_count_t i = 0; i < count; ++i)
+        y[i] = y[i] * yScale + yOffset;
+    for (point_count_t i = 0; i < count; ++i)
+        z[i] = z[i] * zScale + zOffset;
+}
+
+
 } // namespace pdal
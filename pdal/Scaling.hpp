@@ -82,6 +82,33 @@ public:
       \param args  Argument set to add to.
     */
     void addArgs(ProgramArgs& args);
+
+    /**
+      Transform a batch of X/Y/Z values in place from spatial values to
+      scaled values ((v - offset) / scale).  The per-dimension transform
+      components are read once and the arrays are processed in plain
+      loops, so the compiler can vectorize the arithmetic instead of
+      repeating member lookups for every point.
+
+      \param x  X values to transform.
+      \param y  Y values to transform.
+      \param z  Z values to transform.
+      \param count  Number of values in each array.
+    */
+    void toScaled(double *x, double *y, double *z,
+        point_count_t count) const;
+
+    /**
+      Inverse batch transform (v * scale + offset), as applied when
+      expanding scaled integer coordinates to spatial values.
+
+      \param x  X values to transform.
+      \param y  Y values to transform.
+      \param z  Z values to transform.
+      \param count  Number of values in each array.
+    */
+    void fromScaled(double *x, double *y, double *z,
+        point_count_t count) const;
 };
 
 } // namespace pdal
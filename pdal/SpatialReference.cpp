@@ -32,7 +32,10 @@
  * OF SUCH DAMAGE.
  ****************************************************************************/
 
+#include <map>
 #include <memory>
+#include <mutex>
+#include <utility>
 
 #include <pdal/Metadata.hpp>
 #include <pdal/PDALUtils.hpp>
@@ -71,6 +74,26 @@ OGRScopedSpatialReference ogrCreateSrs(std::string s = "")
             OSRNewSpatialReference(s.size() ? s.c_str() : nullptr)));
 }
 
+// Interned SRS parse and comparison results.  Pipelines construct the
+// same few spatial references over and over (one per file in a tindex
+// run) and compare them per-view when merging, so each distinct
+// definition is run through OSR once and each distinct pair of WKT
+// strings is run through OSRIsSame once.
+struct SrsCache
+{
+    std::mutex m_mutex;
+    // Definition string (proj4, EPSG code, filename, ...) -> WKT.
+    std::map<std::string, std::string> m_wkt;
+    // Ordered WKT pair -> OSRIsSame result.
+    std::map<std::pair<std::string, std::string>, bool> m_same;
+};
+
+SrsCache& srsCache()
+{
+    static SrsCache cache;
+    return cache;
+}
+
 }
 
 namespace pdal
@@ -159,6 +182,17 @@ void SpatialReference::set(std::string v)
         return;
     }
 
+    {
+        SrsCache& cache = srsCache();
+        std::lock_guard<std::mutex> lock(cache.m_mutex);
+        auto it = cache.m_wkt.find(v);
+        if (it != cache.m_wkt.end())
+        {
+            m_wkt = it->second;
+            return;
+        }
+    }
+
     OGRSpatialReference srs(NULL);
 
     CPLErrorReset();
@@ -179,6 +213,11 @@ void SpatialReference::set(std::string v)
     srs.exportToWkt(&poWKT);
     m_wkt = poWKT;
     CPLFree(poWKT);
+
+    // Failed imports throw above, so only successful parses are interned.
+    SrsCache& cache = srsCache();
+    std::lock_guard<std::mutex> lock(cache.m_mutex);
+    cache.m_wkt.insert({std::move(v), m_wkt});
 }
 
 
@@ -294,15 +333,33 @@ bool SpatialReference::equals(const SpatialReference& input) const
     if (getWKT() == input.getWKT())
         return true;
 
+    // set() normalizes definitions to WKT, so distinct strings that
+    // describe the same SRS are uncommon but possible.  Memoize the
+    // OSRIsSame result for each pair we see, ordering the pair so both
+    // comparison directions hit the same entry.
+    std::pair<std::string, std::string> key(getWKT(), input.getWKT());
+    if (key.second < key.first)
+        std::swap(key.first, key.second);
+
+    SrsCache& cache = srsCache();
+    {
+        std::lock_guard<std::mutex> lock(cache.m_mutex);
+        auto it = cache.m_same.find(key);
+        if (it != cache.m_same.end())
+            return it->second;
+    }
+
     OGRScopedSpatialReference current = ogrCreateSrs(getWKT());
     OGRScopedSpatialReference other = ogrCreateSrs(input.getWKT());
 
     if (!current || !other)
         return false;
 
-    int output = OSRIsSame(current.get(), other.get());
+    bool same = (OSRIsSame(current.get(), other.get()) == 1);
 
-    return (output == 1);
+    std::lock_guard<std::mutex> lock(cache.m_mutex);
+    cache.m_same.insert({std::move(key), same});
+    return same;
 }
 
 
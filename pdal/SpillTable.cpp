@@ -0,0 +1,325 @@
+/******************************************************************************
+* Copyright (c) 2026, Hobu Inc.
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+*       names of its contributors may be used to endorse or promote
+*       products derived from this software without specific prior
+*       written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#include <pdal/SpillTable.hpp>
+
+#include <pdal/pdal_features.hpp>
+#include <pdal/util/IStream.hpp>
+#include <pdal/util/OStream.hpp>
+
+#ifdef PDAL_HAVE_ZSTD
+#include <pdal/compression/ZstdCompression.hpp>
+#endif
+
+#include <algorithm>
+#include <cstring>
+
+namespace pdal
+{
+
+namespace
+{
+
+const char *MAGIC = "PDALSPIL";
+const uint32_t VERSION = 1;
+const uint32_t COMPRESSION_NONE = 0;
+const uint32_t COMPRESSION_SHUFFLE_ZSTD = 1;
+
+// Offset of the numPoints header field, patched when a file is closed.
+const std::streampos NUM_POINTS_POS = 16;
+
+// Cached decompressed blocks per reader.
+const size_t CACHE_BLOCKS = 4;
+
+} // unnamed namespace
+
+SpillPointTable::SpillPointTable(const std::string& filename,
+    point_count_t pointsPerBlock, bool compress) :
+    SimplePointTable(m_layout), m_filename(filename),
+    m_pointsPerBlock((std::max)(pointsPerBlock, (point_count_t)1)),
+    m_compress(compress), m_numPts(0), m_blockStart(0)
+{
+#ifndef PDAL_HAVE_ZSTD
+    m_compress = false;
+#endif
+}
+
+
+SpillPointTable::~SpillPointTable()
+{
+    close();
+}
+
+
+void SpillPointTable::finalize()
+{
+    if (m_layout.finalized())
+        return;
+    BasePointTable::finalize();
+
+    m_buf.resize(pointsToBytes(m_pointsPerBlock));
+
+    m_out.reset(new OLeStream(m_filename));
+    if (!*m_out)
+        throw pdal_error("SpillPointTable: can't open '" + m_filename +
+            "' for output.");
+    m_out->put(MAGIC, 8);
+    *m_out << VERSION;
+    *m_out << (m_compress ? COMPRESSION_SHUFFLE_ZSTD : COMPRESSION_NONE);
+    *m_out << (uint64_t)0;  // numPoints - patched in close().
+    *m_out << (uint64_t)m_layout.pointSize();
+    *m_out << (uint64_t)m_pointsPerBlock;
+
+    const Dimension::IdList& dims = m_layout.dims();
+    *m_out << (uint32_t)dims.size();
+    for (Dimension::Id id : dims)
+    {
+        std::string name = m_layout.dimName(id);
+        std::string type = Dimension::interpretationName(m_layout.dimType(id));
+        *m_out << (uint32_t)name.size();
+        m_out->put(name);
+        *m_out << (uint32_t)type.size();
+        m_out->put(type);
+    }
+}
+
+
+PointId SpillPointTable::addPoint()
+{
+    if (m_numPts - m_blockStart == m_pointsPerBlock)
+        flushBlock();
+    return m_numPts++;
+}
+
+
+char *SpillPointTable::getPoint(PointId idx)
+{
+    if (idx < m_blockStart)
+        throw pdal_error("SpillPointTable: point " + std::to_string(idx) +
+            " has been spilled to disk and is no longer accessible.");
+    return m_buf.data() + pointsToBytes(idx - m_blockStart);
+}
+
+
+void SpillPointTable::flushBlock()
+{
+    point_count_t count = m_numPts - m_blockStart;
+    if (!count)
+        return;
+
+    size_t bytes = pointsToBytes(count);
+#ifdef PDAL_HAVE_ZSTD
+    if (m_compress)
+    {
+        std::vector<char> block;
+        auto cb = [&block](char *buf, size_t bufsize)
+        {
+            block.insert(block.end(), buf, buf + bufsize);
+        };
+        ShuffleZstdCompressor compressor(cb, m_layout.pointSize());
+        compressor.compress(m_buf.data(), bytes);
+        compressor.done();
+        *m_out << (uint32_t)block.size();
+        m_out->put(block.data(), block.size());
+    }
+    else
+#endif
+    {
+        *m_out << (uint32_t)bytes;
+        m_out->put(m_buf.data(), bytes);
+    }
+    m_blockStart = m_numPts;
+    std::fill(m_buf.begin(), m_buf.end(), 0);
+}
+
+
+void SpillPointTable::close()
+{
+    if (!m_out)
+        return;
+    flushBlock();
+    m_out->seek(NUM_POINTS_POS);
+    *m_out << (uint64_t)m_numPts;
+    if (!*m_out)
+        throw pdal_error("SpillPointTable: failure writing '" + m_filename +
+            "'.");
+    m_out->close();
+    m_out.reset();
+}
+
+
+MappedSpillTable::MappedSpillTable(const std::string& filename) :
+    SimplePointTable(m_layout), m_filename(filename)
+{
+    auto fail = [&filename](const std::string& why)
+    {
+        throw pdal_error("MappedSpillTable: '" + filename + "' " + why);
+    };
+
+    ILeStream in(filename);
+    if (!in.good())
+        fail("can't be opened.");
+
+    std::string magic;
+    in.get(magic, 8);
+    if (magic != MAGIC)
+        fail("isn't a PDAL spill file.");
+    uint32_t version;
+    in >> version;
+    if (version != VERSION)
+        fail("has unsupported version " + std::to_string(version) + ".");
+    in >> m_compression;
+    if (m_compression > COMPRESSION_SHUFFLE_ZSTD)
+        fail("has an unknown compression type.");
+#ifndef PDAL_HAVE_ZSTD
+    if (m_compression == COMPRESSION_SHUFFLE_ZSTD)
+        fail("is compressed but PDAL was built without Zstd support.");
+#endif
+
+    uint64_t numPts, pointSize, pointsPerBlock;
+    in >> numPts >> pointSize >> pointsPerBlock;
+    m_numPts = numPts;
+    m_pointSize = (size_t)pointSize;
+    m_pointsPerBlock = pointsPerBlock;
+    if (!m_pointSize || !m_pointsPerBlock)
+        fail("has a corrupt header.");
+
+    uint32_t numDims;
+    in >> numDims;
+    for (uint32_t i = 0; i < numDims; ++i)
+    {
+        uint32_t len;
+        std::string name, type;
+        in >> len;
+        in.get(name, len);
+        in >> len;
+        in.get(type, len);
+        m_layout.registerOrAssignDim(name, Dimension::type(type));
+    }
+    m_layout.finalize();
+    if (!in.good())
+        fail("ends mid-header.");
+    if (m_layout.pointSize() != m_pointSize)
+        fail("has a layout that doesn't reconstruct to the stored "
+            "point size.");
+
+    // Walk the block length prefixes to locate each payload.  This also
+    // catches files truncated by a crashed writer.
+    uint64_t numBlocks = m_numPts ?
+        (m_numPts + m_pointsPerBlock - 1) / m_pointsPerBlock : 0;
+    uint64_t fileSize = (uint64_t)FileUtils::fileSize(filename);
+    uint64_t pos = (uint64_t)in.position();
+    for (uint64_t b = 0; b < numBlocks; ++b)
+    {
+        if (pos + sizeof(uint32_t) > fileSize)
+            fail("is truncated.");
+        uint32_t len;
+        in.seek(pos);
+        in >> len;
+        pos += sizeof(uint32_t);
+        if (pos + len > fileSize)
+            fail("is truncated.");
+        m_blockOffsets.push_back(pos);
+        m_blockSizes.push_back(len);
+        pos += len;
+    }
+    in.close();
+
+    m_map = FileUtils::mapFile(filename);
+    if (!m_map.addr())
+        fail("can't be mapped: " + m_map.what());
+}
+
+
+MappedSpillTable::~MappedSpillTable()
+{
+    if (m_map.addr())
+        FileUtils::unmapFile(m_map);
+}
+
+
+PointId MappedSpillTable::addPoint()
+{
+    throw pdal_error("MappedSpillTable: table is read-only.");
+}
+
+
+void MappedSpillTable::setFieldInternal(Dimension::Id id, PointId idx,
+    const void *value)
+{
+    throw pdal_error("MappedSpillTable: table is read-only.");
+}
+
+
+char *MappedSpillTable::getPoint(PointId idx)
+{
+    if (idx >= m_numPts)
+        throw pdal_error("MappedSpillTable: point " + std::to_string(idx) +
+            " is out of range.");
+
+    uint64_t block = idx / m_pointsPerBlock;
+    size_t offset = (size_t)(idx % m_pointsPerBlock) * m_pointSize;
+    char *payload = (char *)m_map.addr() + m_blockOffsets[block];
+
+    if (m_compression == COMPRESSION_NONE)
+        return payload + offset;
+
+#ifdef PDAL_HAVE_ZSTD
+    auto it = m_cache.find(block);
+    if (it == m_cache.end())
+    {
+        if (m_cacheOrder.size() == CACHE_BLOCKS)
+        {
+            m_cache.erase(m_cacheOrder.front());
+            m_cacheOrder.erase(m_cacheOrder.begin());
+        }
+
+        std::vector<char>& points = m_cache[block];
+        auto cb = [&points](char *buf, size_t bufsize)
+        {
+            points.insert(points.end(), buf, buf + bufsize);
+        };
+        ShuffleZstdDecompressor decompressor(cb, m_pointSize);
+        decompressor.decompress(payload, m_blockSizes[block]);
+        decompressor.done();
+        m_cacheOrder.push_back(block);
+        it = m_cache.find(block);
+    }
+    return it->second.data() + offset;
+#else
+    throw pdal_error("MappedSpillTable: no Zstd support.");
+#endif
+}
+
+} // namespace pdal
@@ -0,0 +1,160 @@
+/******************************************************************************
+* Copyright (c) 2026, Hobu Inc.
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+*       names of its contributors may be used to endorse or promote
+*       products derived from this software without specific prior
+*       written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <pdal/PointTable.hpp>
+#include <pdal/util/FileUtils.hpp>
+
+namespace pdal
+{
+
+class OLeStream;
+
+/**
+  On-disk spill format for intermediate point data.
+
+  A spill file carries the raw layout of a point table followed by its
+  point records in fixed-size blocks, so non-streamable stage handoffs,
+  external sorts and resumable jobs can stage points on disk without
+  round-tripping through a full-blown point cloud format.  The layout is
+  little-endian:
+
+  \verbatim
+  "PDALSPIL"            magic (8 bytes)
+  version               uint32 (currently 1)
+  compression           uint32 (0 = none, 1 = byte-shuffled Zstd)
+  numPoints             uint64 (patched when the file is closed)
+  pointSize             uint64
+  pointsPerBlock        uint64
+  numDims               uint32
+  per dimension:        name length (uint32), name bytes,
+                        interpretation name length (uint32), name bytes
+  per block:            payload length (uint32), payload
+  \endverbatim
+
+  Blocks hold pointsPerBlock records (the last may be short) and are
+  individually compressed, so a reader can map the file and decompress
+  only the blocks it touches.  A truncated tail block - e.g. from a
+  crashed writer - is detected when the file is opened.
+
+  SpillPointTable writes the format.  Points are append-only: only the
+  block currently being filled is writable, and accessing a point from an
+  already-spilled block throws.  PointView-style sequential fills (each
+  point written completely before the next is added) fit this shape.
+*/
+class PDAL_DLL SpillPointTable : public SimplePointTable
+{
+public:
+    SpillPointTable(const std::string& filename,
+        point_count_t pointsPerBlock = 65536, bool compress = true);
+    virtual ~SpillPointTable();
+
+    virtual bool supportsView() const
+        { return true; }
+    virtual void finalize();
+
+    /// Flush buffered points and complete the file.  Called by the
+    /// destructor if not invoked explicitly.
+    void close();
+
+    point_count_t numPoints() const
+        { return m_numPts; }
+
+protected:
+    virtual char *getPoint(PointId idx);
+
+private:
+    virtual PointId addPoint();
+    void flushBlock();
+
+    std::string m_filename;
+    point_count_t m_pointsPerBlock;
+    bool m_compress;
+    point_count_t m_numPts;
+    point_count_t m_blockStart;
+    std::vector<char> m_buf;
+    std::unique_ptr<OLeStream> m_out;
+    PointLayout m_layout;
+};
+
+/**
+  Read-back table for spill files written by SpillPointTable.
+
+  The file is memory-mapped on open and blocks are decompressed on
+  demand into a small cache, so sequential and mostly-local access
+  patterns touch only a few blocks' worth of memory regardless of file
+  size.  Uncompressed files are served directly from the mapping.  The
+  table is read-only; adding points or setting fields throws.
+*/
+class PDAL_DLL MappedSpillTable : public SimplePointTable
+{
+public:
+    MappedSpillTable(const std::string& filename);
+    virtual ~MappedSpillTable();
+
+    virtual bool supportsView() const
+        { return true; }
+
+    point_count_t numPoints() const
+        { return m_numPts; }
+
+protected:
+    virtual char *getPoint(PointId idx);
+
+private:
+    virtual PointId addPoint();
+    virtual void setFieldInternal(Dimension::Id id, PointId idx,
+        const void *value);
+
+    std::string m_filename;
+    uint32_t m_compression;
+    point_count_t m_numPts;
+    size_t m_pointSize;
+    point_count_t m_pointsPerBlock;
+    std::vector<uint64_t> m_blockOffsets;  // Offsets of block payloads.
+    std::vector<uint32_t> m_blockSizes;
+    FileUtils::MapContext m_map;
+    // Decompressed blocks, evicted in rough insertion order.
+    std::map<uint64_t, std::vector<char>> m_cache;
+    std::vector<uint64_t> m_cacheOrder;
+    PointLayout m_layout;
+};
+
+} // namespace pdal
@@ -38,13 +38,18 @@
 #include <pdal/PDALUtils.hpp>
 #include <pdal/util/Algorithm.hpp>
 #include <pdal/util/ProgramArgs.hpp>
+#include <pdal/util/ThreadPool.hpp>
 #include <pdal/private/gdal/ErrorHandler.hpp>
 #include "../filters/private/expr/ConditionalExpression.hpp"
 
+#include "private/ResultCache.hpp"
 #include "private/StageRunner.hpp"
 
+#include <algorithm>
+#include <cstdint>
 #include <iterator>
 #include <memory>
+#include <set>
 
 namespace pdal
 {
@@ -63,13 +68,44 @@ void Stage::splitView(const PointViewPtr& view, PointViewPtr& keep, PointViewPtr
     const expr::ConditionalExpression *where = whereExpr();
     if (where)
     {
-        PointView *k = keep.get();
-        PointView *s = skip.get();
-        for (PointRef p : *view)
+        // Evaluate the expression over blocks of points - the compiled
+        // program amortizes its dispatch across a block.  The full mask
+        // is kept so that views that aren't actually split can share the
+        // input view instead of copying its index, and so that split
+        // views can reserve their exact sizes.
+        const point_count_t BlockSize = 1024;
+        std::vector<uint8_t> pass(view->size());
+
+        PointRef p(*view, 0);
+        PointId idx = 0;
+        while (idx < view->size())
+        {
+            point_count_t n =
+                (std::min)((point_count_t)(view->size() - idx), BlockSize);
+            where->evalBlock(p, idx, n, pass.data() + idx);
+            idx += n;
+        }
+
+        point_count_t npass = (point_count_t)
+            std::count_if(pass.begin(), pass.end(),
+                [](uint8_t v){ return v != 0; });
+        if (npass == view->size())
         {
-            PointView *active = where->eval(p) ? k : s;
-            active->appendPoint(*view, p.pointId());
+            keep = view;
+            return;
         }
+        if (npass == 0)
+        {
+            skip = view;
+            return;
+        }
+
+        keep->reserve(npass);
+        skip->reserve(view->size() - npass);
+        PointView *k = keep.get();
+        PointView *s = skip.get();
+        for (PointId i = 0; i < view->size(); ++i)
+            (pass[i] ? k : s)->appendPoint(*view, i);
     }
     else
         keep = view;
@@ -157,15 +193,37 @@ QuickInfo Stage::preview()
 }
 
 
+void Stage::validateOptions()
+{
+    m_args.reset(new ProgramArgs);
+    for (Stage *prev : m_inputs)
+        prev->validateOptions();
+    handleOptions();
+}
+
+
 void Stage::prepare(PointTableRef table)
 {
     m_args.reset(new ProgramArgs);
+
+    // Options are parsed before the inputs are prepared so that a
+    // spatial predicate this stage advertises can be pushed into input
+    // readers, which apply their 'bounds' pruning during preparation.
+    handleOptions();
+
+    Bounds predicate;
+    if (spatialPredicate(predicate))
+        for (Stage *prev : m_inputs)
+            if (prev->pushSpatialPredicate(predicate))
+                log()->get(LogLevel::Debug) << getName() <<
+                    ": pushed spatial predicate " << predicate << " to " <<
+                    prev->getName() << ".\n";
+
     for (size_t i = 0; i < m_inputs.size(); ++i)
     {
         Stage *prev = m_inputs[i];
         prev->prepare(table);
     }
-    handleOptions();
     startLogging();
     l_initialize(table);
     initialize(table);
@@ -176,7 +234,7 @@ void Stage::prepare(PointTableRef table)
 }
 
 
-PointViewSet Stage::execute(PointTableRef table)
+PointViewSet Stage::execute(PointTableRef table, int threads)
 {
     table.finalize();
 
@@ -206,14 +264,34 @@ PointViewSet Stage::execute(PointTableRef table)
     m_log->get(LogLevel::Debug) << "Executing pipeline in standard mode." <<
         std::endl;
 
+    // Stages whose results are staged in a result cache reload them
+    // instead of recomputing; a subtree whose root hits the cache isn't
+    // traversed (or executed) at all.  Writers always run - their
+    // product is the output file, not their views.
+    auto cacheable = [this](Stage *s)
+    {
+        return m_resultCache && !Utils::startsWith(s->getName(), "writers.");
+    };
+
+    std::set<int> cacheHits;
+
     pending.push(StageInstance(this, stageInstanceId++));
 
     // Linearize stage execution.
+    std::vector<StageInstance> leaves;
     while (pending.size())
     {
         StageInstance si = pending.top();
         pending.pop();
         stages.push(si);
+        if (cacheable(si.m_stage) &&
+            m_resultCache->has(m_resultCache->key(*si.m_stage)))
+        {
+            cacheHits.insert(si.m_id);
+            continue;
+        }
+        if (si.m_stage->m_inputs.empty())
+            leaves.push_back(si);
         for (Stage *in : si.m_stage->m_inputs)
         {
             StageInstance parent(in, stageInstanceId++);
@@ -222,6 +300,43 @@ PointViewSet Stage::execute(PointTableRef table)
         }
     }
 
+    // Leaf stages (readers) are independent of one another, so when
+    // multiple threads are requested we execute each against a private
+    // point table on a pool and merge the results into the shared table
+    // as they complete.  Everything downstream of the leaves still runs
+    // sequentially.
+    std::map<int, PointViewSet> leafViews;
+    if (threads > 1 && leaves.size() > 1)
+    {
+        std::mutex mergeLock;
+        std::vector<std::exception_ptr> errors(leaves.size());
+
+        ThreadPool pool((std::min)((size_t)threads, leaves.size()));
+        for (size_t i = 0; i < leaves.size(); ++i)
+        {
+            StageInstance leaf = leaves[i];
+            pool.add([leaf, i, &table, &mergeLock, &leafViews, &errors]()
+            {
+                try
+                {
+                    PointViewSet views =
+                        leaf.m_stage->executeIsolated(table, mergeLock);
+                    std::lock_guard<std::mutex> lock(mergeLock);
+                    leafViews[leaf.m_id] = std::move(views);
+                }
+                catch (...)
+                {
+                    errors[i] = std::current_exception();
+                }
+            });
+        }
+        pool.join();
+
+        for (std::exception_ptr& error : errors)
+            if (error)
+                std::rethrow_exception(error);
+    }
+
     // Go through the stages in order, executing
     PointViewSet outViews;
     std::map<StageInstance, PointViewSet> sets;
@@ -229,10 +344,26 @@ PointViewSet Stage::execute(PointTableRef table)
     {
         StageInstance si = stages.top();
         stages.pop();
-        PointViewSet& inViews = sets[si];
-        if (inViews.empty())
-            inViews.insert(PointViewPtr(new PointView(table)));
-        outViews = si.m_stage->execute(table, inViews);
+        auto li = leafViews.find(si.m_id);
+        if (li != leafViews.end())
+            outViews = std::move(li->second);
+        else if (cacheHits.count(si.m_id))
+        {
+            std::string key = m_resultCache->key(*si.m_stage);
+            m_log->get(LogLevel::Debug) << "Reloading cached result " <<
+                key << " for " << si.m_stage->getName() << "." << std::endl;
+            outViews = m_resultCache->load(key, table);
+        }
+        else
+        {
+            PointViewSet& inViews = sets[si];
+            if (inViews.empty())
+                inViews.insert(PointViewPtr(new PointView(table)));
+            outViews = si.m_stage->execute(table, inViews);
+            if (cacheable(si.m_stage))
+                m_resultCache->store(m_resultCache->key(*si.m_stage),
+                    outViews);
+        }
 
         StageInstance child = children[si];
 
@@ -245,6 +376,62 @@ PointViewSet Stage::execute(PointTableRef table)
     return outViews;
 }
 
+PointViewSet Stage::executeIsolated(PointTableRef table, std::mutex& mergeLock)
+{
+    // Build a private table whose layout replicates the shared one.
+    // Registering dimensions in id order makes assigned (proprietary)
+    // ids match those of the shared layout, so the ids stages resolved
+    // during prepare() remain valid.
+    ColumnPointTable sub;
+    PointLayoutPtr srcLayout = table.layout();
+    for (Dimension::Id id : srcLayout->dims())
+    {
+        Dimension::Id newId = sub.layout()->registerOrAssignDim(
+            srcLayout->dimName(id), srcLayout->dimType(id));
+        (void)newId;
+        assert(newId == id);
+    }
+    sub.finalize();
+
+    PointViewSet inViews;
+    inViews.insert(PointViewPtr(new PointView(sub)));
+    PointViewSet outViews = execute(sub, inViews);
+
+    // Merge the result into the shared table.  Point addition there
+    // isn't thread-safe, so the copy happens under the merge lock.
+    PointViewSet result;
+    std::lock_guard<std::mutex> lock(mergeLock);
+    for (PointViewPtr v : outViews)
+    {
+        PointViewPtr newView(new PointView(table, v->spatialReference()));
+        newView->copyPoints(*v, 0, v->size());
+        result.insert(newView);
+    }
+    return result;
+}
+
+
+void Stage::profileStart()
+{
+    if (!m_profiling)
+        return;
+    m_profWallStart = std::chrono::steady_clock::now();
+    m_profCpuStart = std::clock();
+}
+
+
+void Stage::profileEnd(point_count_t points)
+{
+    if (!m_profiling)
+        return;
+    m_profile.wallTime += std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - m_profWallStart).count();
+    m_profile.cpuTime +=
+        double(std::clock() - m_profCpuStart) / CLOCKS_PER_SEC;
+    m_profile.pointCount += points;
+}
+
+
 PointViewSet Stage::execute(PointTableRef table, PointViewSet& views)
 {
 
@@ -252,6 +439,7 @@ PointViewSet Stage::execute(PointTableRef table, PointViewSet& views)
     std::vector<StageRunnerPtr> runners;
 
     startLogging();
+    profileStart();
 
     // Put the spatial references from the views onto the table.
     // The table's spatial references are only valid as long as the stage
@@ -286,8 +474,42 @@ PointViewSet Stage::execute(PointTableRef table, PointViewSet& views)
         keeps.insert(r->keeps());
     prerun(keeps);
 
-    for (StageRunnerPtr r : runners)
-        r->run();
+    // Stages that declare their run() thread-safe have their views
+    // dispatched across a thread pool.  Otherwise views run sequentially,
+    // as before.
+    if (viewThreadSafe() && runners.size() > 1)
+    {
+        size_t numThreads = (std::min)(runners.size(),
+            (size_t)std::thread::hardware_concurrency());
+        std::vector<std::exception_ptr> errors(runners.size());
+
+        ThreadPool pool(numThreads);
+        for (size_t i = 0; i < runners.size(); ++i)
+        {
+            StageRunnerPtr r = runners[i];
+            pool.add([r, i, &errors]()
+            {
+                try
+                {
+                    r->run();
+                }
+                catch (...)
+                {
+                    errors[i] = std::current_exception();
+                }
+            });
+        }
+        pool.join();
+
+        for (std::exception_ptr& error : errors)
+            if (error)
+                std::rethrow_exception(error);
+    }
+    else
+    {
+        for (StageRunnerPtr r : runners)
+            r->run();
+    }
 
     // As the stages complete (synchronously at this time), propagate the
     // spatial reference and merge the output views.
@@ -305,6 +527,23 @@ PointViewSet Stage::execute(PointTableRef table, PointViewSet& views)
     }
 
     done(table);
+
+    // Account point storage owned by the table plus the output views'
+    // indexes, for profiling and memory-limit enforcement.
+    if (m_profiling || m_memoryLimit)
+    {
+        std::size_t mem = table.allocatedBytes();
+        for (const PointViewPtr& v : outViews)
+            mem += v->size() * sizeof(PointId);
+        m_profile.peakMemory = (std::max)(m_profile.peakMemory, mem);
+        if (m_memoryLimit && mem > m_memoryLimit)
+            throwError("Point storage (" + std::to_string(mem) + " bytes) "
+                "exceeded the memory limit of " +
+                std::to_string(m_memoryLimit) + " bytes.  Consider running "
+                "the pipeline in stream mode or reducing the input.");
+    }
+
+    profileEnd(m_pointCount);
     stopLogging();
     m_pointCount = 0;
     m_faceCount = 0;
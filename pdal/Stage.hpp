@@ -34,7 +34,10 @@
 
 #pragma once
 
+#include <chrono>
+#include <ctime>
 #include <list>
+#include <mutex>
 
 #include <pdal/Dimension.hpp>
 #include <pdal/DimType.hpp>
@@ -54,6 +57,7 @@ namespace pdal
 {
 
 class ProgramArgs;
+class ResultCache;
 class StageRunner;
 class StageWrapper;
 class Streamable;
@@ -81,6 +85,7 @@ class PDAL_DLL Stage
     friend class Reader;
     friend class Filter;
     friend class Writer;
+    friend class ResultCache;
 
 public:
     enum class WhereMergeMode
@@ -123,6 +128,16 @@ public:
     */
     void prepare(PointTableRef table);
 
+    /**
+      Check the stage's options against its declared arguments without
+      initializing the stage.  Unlike \ref prepare, this doesn't load
+      drivers, open files or make network connections, so it's cheap
+      enough to run as a pre-submission check.  Recurses through all
+      input stages.  Throws pdal_error if an option is unknown or its
+      value can't be converted to the declared type.
+    */
+    void validateOptions();
+
     /**
       Execute a prepared pipeline (linked set of stages).
 
@@ -132,8 +147,11 @@ public:
 
       \param table  Point table being used for stage pipeline.  This must be
         the same \ref table used in the \ref prepare function.
+      \param threads  Number of threads on which independent leaf stages
+        (readers) may be executed concurrently.  With the default of one,
+        stages execute sequentially as always.
     */
-    PointViewSet execute(PointTableRef table);
+    PointViewSet execute(PointTableRef table, int threads = 1);
 
     virtual void execute(StreamPointTable& table)
     {
@@ -159,6 +177,18 @@ public:
     virtual const Stage *findNonstreamable() const
     { return this; }
 
+    /**
+      Determine whether the stage can run independent point views
+      concurrently.  A stage that returns true promises that \ref run (and
+      any state it touches) is safe to invoke from multiple threads on
+      distinct views.  Stages that accumulate cross-view state in \ref run
+      must leave this false.
+
+      \return  Whether views may be processed in parallel through this stage.
+    */
+    virtual bool viewThreadSafe() const
+    { return false; }
+
     /**
       Set the spatial reference of a stage.
 
@@ -305,6 +335,72 @@ public:
     MetadataNode getMetadata() const
         { return m_metadata; }
 
+    /**
+      Execution statistics collected while a stage runs, when profiling
+      is enabled.  Stream-mode stages accumulate over batches.
+    */
+    struct Profile
+    {
+        double wallTime = 0;          ///< Elapsed seconds.
+        double cpuTime = 0;           ///< Process CPU seconds.
+        point_count_t pointCount = 0; ///< Points presented to the stage.
+        /// Peak bytes of point storage (table blocks plus view indexes)
+        /// observed after the stage ran in standard mode.
+        std::size_t peakMemory = 0;
+    };
+
+    /**
+      Enable or disable collection of execution statistics for this stage.
+
+      \param profile  Whether to collect statistics.
+    */
+    void setProfiling(bool profile)
+        { m_profiling = profile; }
+
+    /**
+      Return execution statistics collected for this stage.
+
+      \return  Collected statistics.
+    */
+    const Profile& profile() const
+        { return m_profile; }
+
+    /**
+      Set a limit on point-storage bytes.  After this stage runs in
+      standard mode, an error is raised if the table and view-index
+      storage exceeds the limit.  Stream-mode execution runs in fixed
+      storage and isn't affected.  Zero (the default) disables the check.
+
+      \param bytes  Storage limit in bytes.
+    */
+    void setMemoryLimit(std::size_t bytes)
+        { m_memoryLimit = bytes; }
+
+    /**
+      Set a result cache consulted when this stage executes in standard
+      mode.  Stages whose outputs are found in the cache are reloaded
+      instead of recomputed.  The pointer is an observer; the caller
+      keeps the cache alive for the duration of execution.
+
+      \param cache  Result cache, or nullptr to disable caching.
+    */
+    void setResultCache(ResultCache *cache)
+        { m_resultCache = cache; }
+
+    /**
+      Offer a spatial predicate pushed down from a subsequent stage.
+      Stages that can prune their input by bounds (typically readers)
+      accept the predicate and return true.  Pruning must retain every
+      point within the bounds; the advertising filter still applies its
+      exact test to whatever is read.  A user-supplied 'bounds' option
+      takes precedence over a pushed predicate.
+
+      \param bounds  Bounds outside of which points may be skipped.
+      \return  Whether the predicate was accepted.
+    */
+    virtual bool pushSpatialPredicate(const Bounds& bounds)
+        { return false; }
+
     /**
       Serialize a stage by inserting apporpritate data into the provided
       MetadataNode.  Used to dump a pipeline specification in a portable
@@ -343,6 +439,28 @@ protected:
 
     virtual void setSpatialReference(MetadataNode& m, SpatialReference const&);
     void throwError(const std::string& s) const;
+    /**
+      Bounds outside of which this stage emits no points.  Filters that
+      can state such a predicate advertise it here; prepare() offers the
+      bounds to this stage's inputs so readers can prune I/O.
+
+      \param bounds  Populated with the predicate bounds on success.
+      \return  Whether a predicate is available.
+    */
+    virtual bool spatialPredicate(Bounds& bounds) const
+        { return false; }
+    /**
+      Start a profiling interval for this stage.  A no-op unless profiling
+      is enabled.
+    */
+    void profileStart();
+    /**
+      End a profiling interval, accumulating elapsed wall and CPU time and
+      the number of points handled.  A no-op unless profiling is enabled.
+
+      \param points  Points handled during the interval.
+    */
+    void profileEnd(point_count_t points);
     /**
       Return the point count of all point views at the start of execution.
       Only valid during execute().
@@ -375,6 +493,12 @@ private:
     std::string m_userDataJSON;
     point_count_t m_pointCount;
     point_count_t m_faceCount;
+    bool m_profiling = false;
+    std::size_t m_memoryLimit = 0;
+    Profile m_profile;
+    ResultCache *m_resultCache = nullptr;
+    std::chrono::steady_clock::time_point m_profWallStart;
+    std::clock_t m_profCpuStart = 0;
     // This is never used, but we want something to bind to the argument
     // we stick in ProgramArgs so that it shows up in help and an options list.
     std::string m_optionFile;
@@ -388,6 +512,17 @@ private:
     void handleOptions();
     void countElements(const PointViewSet& views);
 
+    /**
+      Execute this (leaf) stage against a private point table and merge
+      the resulting views into 'table' under 'mergeLock'.  Used to run
+      independent readers concurrently.
+
+      \param table  The shared point table receiving the merged points.
+      \param mergeLock  Lock serializing point addition to 'table'.
+      \return  Views referencing 'table' with this stage's output.
+    */
+    PointViewSet executeIsolated(PointTableRef table, std::mutex& mergeLock);
+
     virtual void l_addArgs(ProgramArgs& args);
     virtual void l_initialize(PointTableRef table);
     virtual void l_prepared(PointTableRef table);
@@ -55,6 +55,8 @@ std::string StageFactory::inferReaderDriver(const std::string& filename)
 
     if (Utils::endsWith(filename, "ept.json") || Utils::startsWith(filename, "ept://"))
         return "readers.ept";
+    if (Utils::endsWith(filename, ".copc.laz"))
+        return "readers.copc";
     if (Utils::startsWith(filename, "i3s://"))
         return "readers.i3s";
 
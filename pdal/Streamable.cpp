@@ -69,6 +69,20 @@ const Stage *Streamable::findNonstreamable() const
 }
 
 
+void Streamable::processBatch(StreamPointTable& table, point_count_t count)
+{
+    PointRef point(table, 0);
+    for (PointId idx = 0; idx < count; idx++)
+    {
+        if (table.skip(idx))
+            continue;
+        point.setPointId(idx);
+        if (!processOne(point))
+            table.setSkip(idx);
+    }
+}
+
+
 // Streamed execution.
 void Streamable::execute(StreamPointTable& table)
 {
@@ -181,7 +195,6 @@ void Streamable::execute(StreamPointTable& table,
     std::list<Streamable *>& stages, SrsMap& srsMap)
 {
     std::list<Streamable *> filters;
-    SpatialReference srs;
 
     // Separate out the first stage.
     Streamable *reader = stages.front();
@@ -197,6 +210,38 @@ void Streamable::execute(StreamPointTable& table,
     begin++;
     std::copy(begin, stages.end(), std::back_inserter(filters));
 
+    runBatches(table, reader, false, filters, srsMap, count);
+
+    // Stages that withheld points while streaming (external sorts and the
+    // like) now act as the source for the stages downstream of them.
+    for (auto it = filters.begin(); it != filters.end(); ++it)
+    {
+        if (!(*it)->deferred())
+            continue;
+        std::list<Streamable *> downstream(std::next(it), filters.end());
+        runBatches(table, *it, true, downstream, srsMap,
+            (std::numeric_limits<point_count_t>::max)());
+    }
+}
+
+
+// Move batches of points from a source stage through the stages that
+// follow it until the source is exhausted.  The source produces points
+// through processOne when it's a reader and through drainOne when it's a
+// stage emitting withheld points.
+void Streamable::runBatches(StreamPointTable& table, Streamable *source,
+    bool drain, std::list<Streamable *>& filters, SrsMap& srsMap,
+    point_count_t count)
+{
+    SpatialReference srs;
+
+    // When the stage just downstream of the source discards whole runs
+    // of points (a strided decimation, for example), let the source seek
+    // over them instead of decoding them.
+    Streamable *skipper = nullptr;
+    if (!filters.empty() && !filters.front()->whereExpr())
+        skipper = filters.front();
+
     // Loop until we're finished.  We handle the number of points up to
     // the capacity of the StreamPointTable that we've been provided.
 
@@ -209,8 +254,9 @@ void Streamable::execute(StreamPointTable& table,
         PointRef point(table, idx);
         point_count_t pointLimit = (std::min)(count, table.capacity());
 
-        reader->startLogging();
-        // When we get false back from a reader, we're done, so set
+        source->startLogging();
+        source->profileStart();
+        // When we get false back from the source, we're done, so set
         // the point limit to the number of points processed in this loop
         // of the table.
         if (!pointLimit)
@@ -218,15 +264,29 @@ void Streamable::execute(StreamPointTable& table,
 
         for (PointId idx = 0; idx < pointLimit; idx++)
         {
+            if (skipper)
+            {
+                point_count_t skip = skipper->skipAhead();
+                while (skip)
+                {
+                    point_count_t skipped = source->streamSkip(skip);
+                    if (!skipped)
+                        break;
+                    skipper->skippedAhead(skipped);
+                    skip -= skipped;
+                }
+            }
             point.setPointId(idx);
-            finished = !reader->processOne(point);
+            finished = drain ? !source->drainOne(point) :
+                !source->processOne(point);
             if (finished)
                 pointLimit = idx;
         }
         count -= pointLimit;
 
-        reader->stopLogging();
-        srs = reader->getSpatialReference();
+        source->profileEnd(pointLimit);
+        source->stopLogging();
+        srs = source->getSpatialReference();
         if (!srs.empty())
             table.setSpatialReference(srs);
 
@@ -236,6 +296,11 @@ void Streamable::execute(StreamPointTable& table,
         // processed by subsequent filters.
         for (Streamable *s : filters)
         {
+            // Compact out points skipped by upstream stages so this stage
+            // never walks dead slots.  Heavy-skip pipelines otherwise spend
+            // most of the batch loop stepping over filtered points.
+            pointLimit = table.compact(pointLimit);
+
             auto si = srsMap.find(s);
             if (si == srsMap.end() || si->second != srs)
             {
@@ -243,17 +308,23 @@ void Streamable::execute(StreamPointTable& table,
                 srsMap[s] = srs;
             }
             s->startLogging();
+            s->profileStart();
 
             const expr::ConditionalExpression* where = s->whereExpr();
-            for (PointId idx = 0; idx < pointLimit; idx++)
+            if (pointLimit && !where && s->batchMode())
+                s->processBatch(table, pointLimit);
+            else
             {
-                point.setPointId(idx);
-                if (table.skip(idx))
-                    continue;
-                if (where && !where->eval(point))
-                    continue;
-                if (!s->processOne(point))
-                    table.setSkip(idx);
+                for (PointId idx = 0; idx < pointLimit; idx++)
+                {
+                    point.setPointId(idx);
+                    if (table.skip(idx))
+                        continue;
+                    if (where && !where->eval(point))
+                        continue;
+                    if (!s->processOne(point))
+                        table.setSkip(idx);
+                }
             }
             const SpatialReference& tempSrs = s->getSpatialReference();
             if (!tempSrs.empty())
@@ -261,9 +332,24 @@ void Streamable::execute(StreamPointTable& table,
                 srs = tempSrs;
                 table.setSpatialReference(srs);
             }
+            s->profileEnd(pointLimit);
             s->stopLogging();
         }
 
+        // Cooperative early termination: if the stage just downstream of
+        // the source reports that it will accept nothing further, there
+        // is no consumer left for the source's remaining points.  Only
+        // the first stage is consulted; a saturated stage further along
+        // can't speak for the stages ahead of it.  A 'where' clause
+        // disables the check since unmatched points bypass the stage.
+        if (!finished && !filters.empty() &&
+            !filters.front()->whereExpr() && filters.front()->saturated())
+        {
+            m_log->get(LogLevel::Debug) << filters.front()->getName() <<
+                " is saturated: terminating streaming early.\n";
+            finished = true;
+        }
+
         table.clear(pointLimit);
     }
 }
@@ -82,6 +82,9 @@ protected:
 
     void execute(StreamPointTable& table, std::list<Streamable *>& stages,
         SrsMap& srsMap);
+    void runBatches(StreamPointTable& table, Streamable *source, bool drain,
+        std::list<Streamable *>& filters, SrsMap& srsMap,
+        point_count_t count);
 
     /**
       Process a single point (streaming mode).  Implement in subclass.
@@ -99,6 +102,101 @@ protected:
     }
     **/
 
+    /**
+      Determine whether the stage implements \ref processBatch.  Stages
+      that can consume a table's worth of points in one call (avoiding
+      per-point virtual dispatch) should override this to return true.
+
+      \return  Whether batch processing is supported.
+    */
+    virtual bool batchMode() const
+    { return false; }
+
+    /**
+      Process all points resident in a stream point table (streaming mode).
+      Called in place of per-point \ref processOne calls when \ref batchMode
+      returns true and no 'where' clause is active on the stage.  The
+      implementation must ignore points for which table.skip() is set and
+      must call table.setSkip() for points to be filtered out.  The default
+      implementation simply loops \ref processOne.
+
+      \param table  Table holding the points to process.
+      \param count  Number of points populated in the table.
+    */
+    virtual void processBatch(StreamPointTable& table, point_count_t count);
+
+    /**
+      Determine whether the stage withholds points during streaming and
+      emits them once its input is exhausted (an external sort, for
+      example).  Stages that return true must implement \ref drainOne and
+      are drained, in pipeline order, after the reader has produced its
+      last point.
+
+      \return  Whether the stage defers points until input is exhausted.
+    */
+    virtual bool deferred() const
+    { return false; }
+
+    /**
+      Emit one withheld point (streaming mode).  Called repeatedly once
+      the stage's input is exhausted.  Emitted points are processed by the
+      stages downstream of this one.
+
+      \param point  Point to fill.
+      \return  False when no more points are to be emitted, in which case
+        the point is invalid.
+    */
+    virtual bool drainOne(PointRef& /*point*/)
+    { return false; }
+
+    /**
+      Report that this stage will pass no further points downstream
+      (streaming mode).  A count-limited stage like filters.head
+      overrides this once its count is exhausted.  When the stage
+      immediately downstream of the source is saturated, the executor
+      stops pulling from the source instead of reading to end of input.
+
+      \return  Whether all future points will be discarded.
+    */
+    virtual bool saturated() const
+    { return false; }
+
+    /**
+      Report the number of upcoming points this stage will certainly
+      discard (streaming mode).  A strided filter like filters.decimation
+      overrides this so that the source can seek past points instead of
+      decoding them.  Consulted only for the stage immediately downstream
+      of the source, and only when the stage has no 'where' clause.
+
+      \return  Number of upcoming points that are certain to be discarded.
+    */
+    virtual point_count_t skipAhead() const
+    { return 0; }
+
+    /**
+      Notification that the source skipped points reported through
+      \ref skipAhead.  Stages overriding \ref skipAhead must account for
+      the skipped points here, as they will never be presented to
+      \ref processOne.
+
+      \param count  Number of points the source skipped.
+    */
+    virtual void skippedAhead(point_count_t /*count*/)
+    {}
+
+    /**
+      Skip points without producing them (streaming mode).  Readers that
+      can seek over point records -- or whole compressed chunks -- should
+      override this to avoid decoding points that the downstream stage has
+      promised to discard.  The default implementation skips nothing, in
+      which case points are decoded and discarded as usual.
+
+      \param count  Number of points requested to be skipped.
+      \return  Number of points actually skipped.
+    */
+    virtual point_count_t streamSkip(point_count_t /*count*/)
+    { return 0; }
+
     /**
       Notification that the points that will follow in processing are from
       a spatial reference different than the previous spatial reference.
@@ -40,8 +40,14 @@
 #error "LAZperf version 2+ (supporting LAS version 1.4) not found"
 #endif
 
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+
 #include <pdal/util/IStream.hpp>
 #include <pdal/util/OStream.hpp>
+#include <pdal/util/ThreadPool.hpp>
 #include <pdal/pdal_types.hpp>
 
 #include "LazPerfVlrCompression.hpp"
@@ -90,10 +96,15 @@ size_t baseCount(int format)
 class LazPerfVlrCompressorImpl
 {
 public:
-    LazPerfVlrCompressorImpl(std::ostream& stream, int format, int ebCount) :
+    LazPerfVlrCompressorImpl(std::ostream& stream, int format, int ebCount,
+            size_t threads) :
         m_stream(stream), m_outputStream(stream), m_format(format), m_ebCount(ebCount),
-        m_chunksize(50000), m_chunkPointsWritten(0), m_chunkInfoPos(0), m_chunkOffset(0)
-    {}
+        m_chunksize(50000), m_chunkPointsWritten(0), m_chunkInfoPos(0), m_chunkOffset(0),
+        m_started(false), m_maxPending((std::max<size_t>)(threads, 1) * 2)
+    {
+        if (threads > 1)
+            m_pool.reset(new ThreadPool(threads));
+    }
 
     std::vector<char> vlrData() const
     {
@@ -104,30 +115,57 @@ public:
     void compress(const char *inbuf)
     {
         // First time through.
-        if (!m_compressor)
+        if (!m_started)
         {
             // Get the position
             m_chunkInfoPos = m_stream.tellp();
             // Seek over the chunk info offset value
             m_stream.seekp(sizeof(uint64_t), std::ios::cur);
             m_chunkOffset = m_stream.tellp();
-            resetCompressor();
+            m_started = true;
+            if (!m_pool)
+                resetCompressor();
         }
         else if (m_chunkPointsWritten == m_chunksize)
         {
-            resetCompressor();
-            newChunk();
+            if (!m_pool)
+            {
+                resetCompressor();
+                newChunk();
+            }
         }
+
+        if (m_pool)
+        {
+            // Chunks are independently coded, so buffer raw points and hand
+            // full chunks to the pool for compression.
+            size_t pointSize = baseCount(m_format) + m_ebCount;
+            m_chunkBuf.insert(m_chunkBuf.end(), inbuf, inbuf + pointSize);
+            m_chunkPointsWritten++;
+            if (m_chunkPointsWritten == m_chunksize)
+                submitChunk();
+            return;
+        }
+
         m_compressor->compress(inbuf);
         m_chunkPointsWritten++;
     }
 
     void done()
     {
-        // Close and clear the point encoder.
-        m_compressor->done();
-
-        newChunk();
+        if (m_pool)
+        {
+            if (m_chunkBuf.size())
+                submitChunk();
+            m_pool->join();
+            writeCompleted(false);
+        }
+        else
+        {
+            // Close and clear the point encoder.
+            m_compressor->done();
+            newChunk();
+        }
 
         // Save our current position.  Go to the location where we need
         // to write the chunk table offset at the beginning of the point data.
@@ -148,6 +186,13 @@ public:
     }
 
 private:
+    struct ChunkJob
+    {
+        std::vector<char> points;
+        std::vector<char> compressed;
+        bool done = false;
+    };
+
     void resetCompressor()
     {
         if (m_compressor)
@@ -163,6 +208,71 @@ private:
         m_chunkPointsWritten = 0;
     }
 
+    // Queue the buffered chunk for compression on the pool.
+    void submitChunk()
+    {
+        ChunkJob *job = new ChunkJob;
+        job->points.swap(m_chunkBuf);
+        m_chunkPointsWritten = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_jobs.emplace_back(job);
+        }
+
+        const size_t pointSize = baseCount(m_format) + m_ebCount;
+        const int format = m_format;
+        const int ebCount = m_ebCount;
+        m_pool->add([this, job, pointSize, format, ebCount]()
+        {
+            auto cb = [job](const unsigned char *buf, size_t len)
+            {
+                const char *p = reinterpret_cast<const char *>(buf);
+                job->compressed.insert(job->compressed.end(), p, p + len);
+            };
+            lazperf::las_compressor::ptr compressor =
+                lazperf::build_las_compressor(cb, format, ebCount);
+            const char *pos = job->points.data();
+            const char *end = pos + job->points.size();
+            while (pos != end)
+            {
+                compressor->compress(pos);
+                pos += pointSize;
+            }
+            compressor->done();
+            job->points.clear();
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                job->done = true;
+            }
+            m_cv.notify_one();
+        });
+
+        writeCompleted(true);
+    }
+
+    // Write finished chunks to the stream in submission order.  When
+    // 'block' is true, also wait until the number of outstanding chunks
+    // drops below the limit so that memory use stays bounded.
+    void writeCompleted(bool block)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true)
+        {
+            while (m_jobs.size() && m_jobs.front()->done)
+            {
+                std::unique_ptr<ChunkJob> job = std::move(m_jobs.front());
+                m_jobs.pop_front();
+                lock.unlock();
+                m_stream.write(job->compressed.data(), job->compressed.size());
+                m_chunkTable.push_back((uint32_t)job->compressed.size());
+                lock.lock();
+            }
+            if (!block || m_jobs.size() < m_maxPending)
+                break;
+            m_cv.wait(lock);
+        }
+    }
+
     std::ostream& m_stream;
     lazperf::OutFileStream m_outputStream;
     lazperf::las_compressor::ptr m_compressor;
@@ -173,11 +283,21 @@ private:
     std::streampos m_chunkInfoPos;
     std::streampos m_chunkOffset;
     std::vector<uint32_t> m_chunkTable;
+    bool m_started;
+    size_t m_maxPending;
+    std::vector<char> m_chunkBuf;
+    std::deque<std::unique_ptr<ChunkJob>> m_jobs;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    // Declared last so its destructor joins worker threads while the
+    // members they reference are still alive.
+    std::unique_ptr<ThreadPool> m_pool;
 };
 
 
-LazPerfVlrCompressor::LazPerfVlrCompressor(std::ostream& stream, int format, int ebCount) :
-    m_impl(new LazPerfVlrCompressorImpl(stream, format, ebCount))
+LazPerfVlrCompressor::LazPerfVlrCompressor(std::ostream& stream, int format, int ebCount,
+        size_t threads) :
+    m_impl(new LazPerfVlrCompressorImpl(stream, format, ebCount, threads))
 {}
 
 
@@ -209,7 +329,7 @@ public:
     LazPerfVlrDecompressorImpl(std::istream& stream, int format, int ebCount,
             std::streamoff pointOffset, const char *vlrdata) :
         m_stream(stream), m_fileStream(stream), m_format(format), m_ebCount(ebCount),
-        m_chunkPointsRead(0), m_vlr(vlrdata)
+        m_chunkPointsRead(0), m_chunk(0), m_vlr(vlrdata)
     {
         m_stream.seekg(pointOffset);
         ILeStream in(&stream);
@@ -251,6 +371,9 @@ public:
 
         m_stream.seekg(m_chunkOffsets[chunk]);
         m_fileStream.reset();
+        resetDecompressor();
+        m_chunkPointsRead = 0;
+        m_chunk = chunk;
         while (offset > 0)
         {
             decompress(buf.data());
@@ -265,11 +388,117 @@ public:
         {
             resetDecompressor();
             m_chunkPointsRead = 0;
+            m_chunk++;
         }
         m_decompressor->decompress(outbuf);
         m_chunkPointsRead++;
     }
 
+    uint32_t chunkSize() const
+    { return m_vlr.chunk_size; }
+
+    // Decompress 'count' points into 'outbuf', dispatching whole chunks
+    // across 'threads' worker threads.  Chunks are independently coded, so
+    // each task reads a chunk's compressed bytes and runs its own
+    // decompressor over the in-memory copy.  Points before and after the
+    // chunk-aligned region are decompressed sequentially.
+    void decompressBlock(char *outbuf, point_count_t count, size_t threads)
+    {
+        const size_t pointSize = baseCount(m_format) + m_ebCount;
+        point_count_t remaining = count;
+
+        // Finish out any chunk in progress so that the parallel portion
+        // starts on a chunk boundary.
+        while (remaining && (m_chunkPointsRead % m_vlr.chunk_size))
+        {
+            decompress(outbuf);
+            outbuf += pointSize;
+            remaining--;
+        }
+        if (m_chunkPointsRead == m_vlr.chunk_size)
+        {
+            // The stream sits at the start of the next chunk, so reset
+            // here.  With m_chunkPointsRead back at zero the tail loop's
+            // decompress() won't reset on its own, and it must not carry
+            // the finished chunk's coder state into the next one.
+            resetDecompressor();
+            m_chunkPointsRead = 0;
+            m_chunk++;
+        }
+
+        // A count of at least chunk_size implies the current chunk is full,
+        // since only the file's final chunk can be short.
+        uint64_t numChunks = remaining / m_vlr.chunk_size;
+        if (numChunks)
+        {
+            struct ChunkJob
+            {
+                std::vector<char> in;
+                char *out;
+            };
+            std::vector<ChunkJob> jobs(numChunks);
+
+            // Single-threaded sequential I/O; parallel decode.
+            m_stream.clear();
+            for (uint64_t i = 0; i < numChunks; ++i)
+            {
+                uint64_t start = m_chunkOffsets[m_chunk + i];
+                uint64_t end = m_chunkOffsets[m_chunk + i + 1];
+                jobs[i].in.resize(end - start);
+                m_stream.seekg(start);
+                m_stream.read(jobs[i].in.data(), end - start);
+                jobs[i].out = outbuf;
+                outbuf += (uint64_t)m_vlr.chunk_size * pointSize;
+            }
+
+            const uint32_t chunkPoints = m_vlr.chunk_size;
+            const int format = m_format;
+            const int ebCount = m_ebCount;
+            ThreadPool pool((std::max<size_t>)(1,
+                (std::min<size_t>)(threads, numChunks)));
+            for (ChunkJob& job : jobs)
+            {
+                pool.add([&job, chunkPoints, format, ebCount, pointSize]()
+                {
+                    const unsigned char *pos =
+                        reinterpret_cast<const unsigned char *>(job.in.data());
+                    auto cb = [&pos](unsigned char *buf, size_t len)
+                    {
+                        std::copy(pos, pos + len, buf);
+                        pos += len;
+                    };
+                    lazperf::las_decompressor::ptr decompressor =
+                        lazperf::build_las_decompressor(cb, format, ebCount);
+                    char *out = job.out;
+                    for (uint32_t i = 0; i < chunkPoints; ++i)
+                    {
+                        decompressor->decompress(out);
+                        out += pointSize;
+                    }
+                });
+            }
+            pool.join();
+
+            remaining -= numChunks * m_vlr.chunk_size;
+            m_chunk += numChunks;
+
+            // Re-sync the sequential decompressor past the parallel region.
+            m_stream.clear();
+            m_stream.seekg(m_chunkOffsets[m_chunk]);
+            m_fileStream.reset();
+            resetDecompressor();
+            m_chunkPointsRead = 0;
+        }
+
+        // Partial chunk at the tail.
+        while (remaining)
+        {
+            decompress(outbuf);
+            outbuf += pointSize;
+            remaining--;
+        }
+    }
+
 private:
     void resetDecompressor()
     {
@@ -282,6 +511,8 @@ private:
     int m_format;
     int m_ebCount;
     uint32_t m_chunkPointsRead;
+    // Index of the chunk from which the sequential decompressor is reading.
+    uint64_t m_chunk;
     lazperf::laz_vlr m_vlr;
     // Note that these offsets are actual file offsets. The values stored in the chunk table
     // are chunk sizes.
@@ -308,5 +539,16 @@ bool LazPerfVlrDecompressor::seek(int64_t record)
     return m_impl->seek(record);
 }
 
+uint32_t LazPerfVlrDecompressor::chunkSize() const
+{
+    return m_impl->chunkSize();
+}
+
+void LazPerfVlrDecompressor::decompressBlock(char *outbuf, point_count_t count,
+    size_t threads)
+{
+    m_impl->decompressBlock(outbuf, count, threads);
+}
+
 } // namespace pdal
 
@@ -36,6 +36,8 @@
 #include <memory>
 #include <vector>
 
+#include <pdal/pdal_types.hpp>
+
 namespace pdal
 {
     class LazPerfVlrCompressorImpl;
@@ -53,9 +55,11 @@ namespace pdal
 class LazPerfVlrCompressor
 {
 public:
-    LazPerfVlrCompressor(std::ostream& stream, int format, int ebCount);
+    // 'threads' is the number of threads used to compress chunks; with
+    // more than one, chunks are compressed in parallel and written in
+    // order.
     LazPerfVlrCompressor(std::ostream& stream, int format, int ebCount,
-        uint32_t chunksize);
+        size_t threads = 1);
     ~LazPerfVlrCompressor();
 
     std::vector<char> vlrData() const;
@@ -76,6 +80,8 @@ public:
 
     bool seek(int64_t record);
     void decompress(char *outbuf);
+    uint32_t chunkSize() const;
+    void decompressBlock(char *outbuf, point_count_t count, size_t threads);
 
 private:
     std::unique_ptr<LazPerfVlrDecompressorImpl> m_impl;
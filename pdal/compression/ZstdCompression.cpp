@@ -34,7 +34,11 @@
 
 #include "ZstdCompression.hpp"
 
+#include <algorithm>
+#include <cstring>
+
 #include <zstd.h>
+#include <zdict.h>
 
 namespace pdal
 {
@@ -172,4 +176,251 @@ void ZstdDecompressor::decompress(const char *buf, size_t bufsize)
     m_impl->decompress(buf, bufsize);
 }
 
+
+namespace
+{
+
+// Each block is framed with two little-endian uint32 values - the
+// compressed and the raw size - so the decompressor can reassemble
+// block boundaries from an arbitrarily chunked input stream.
+const size_t FrameHeaderSize = 2 * sizeof(uint32_t);
+
+void putU32(char *buf, uint32_t val)
+{
+    for (size_t i = 0; i < sizeof(val); ++i)
+        *buf++ = (char)((val >> (i * 8)) & 0xFF);
+}
+
+uint32_t getU32(const char *buf)
+{
+    uint32_t val = 0;
+    for (size_t i = 0; i < sizeof(val); ++i)
+        val |= (uint32_t)(unsigned char)buf[i] << (i * 8);
+    return val;
+}
+
+} // unnamed namespace
+
+
+class ShuffleZstdCompressorImpl
+{
+public:
+    ShuffleZstdCompressorImpl(BlockCb cb, size_t pointSize, int level,
+            const std::vector<char>& dict) :
+        m_cb(cb), m_pointSize((std::max)(pointSize, (size_t)1)),
+        m_level(level), m_dict(dict)
+    {
+        m_ctx = ZSTD_createCCtx();
+        m_blockPoints = (std::max)((size_t)1, CHUNKSIZE / m_pointSize);
+        m_block.reserve(m_blockPoints * m_pointSize);
+    }
+
+    ~ShuffleZstdCompressorImpl()
+    { ZSTD_freeCCtx(m_ctx); }
+
+    void compress(const char *buf, size_t bufsize)
+    {
+        while (bufsize)
+        {
+            size_t room = m_blockPoints * m_pointSize - m_block.size();
+            size_t sz = (std::min)(room, bufsize);
+            m_block.insert(m_block.end(), buf, buf + sz);
+            buf += sz;
+            bufsize -= sz;
+            if (m_block.size() == m_blockPoints * m_pointSize)
+                flushBlock();
+        }
+    }
+
+    void done()
+    {
+        if (m_block.size())
+            flushBlock();
+    }
+
+private:
+    void flushBlock()
+    {
+        // Transpose whole records into per-byte planes.  A trailing
+        // partial record (only possible on the final block) is copied
+        // through unshuffled.
+        size_t count = m_block.size() / m_pointSize;
+        m_shuffled.resize(m_block.size());
+        const char *src = m_block.data();
+        for (size_t i = 0; i < count; ++i)
+            for (size_t b = 0; b < m_pointSize; ++b)
+                m_shuffled[b * count + i] = *src++;
+        std::copy(src, (const char *)m_block.data() + m_block.size(),
+            m_shuffled.data() + count * m_pointSize);
+
+        size_t bound = ZSTD_compressBound(m_shuffled.size());
+        m_out.resize(FrameHeaderSize + bound);
+        size_t ret = ZSTD_compress_usingDict(m_ctx,
+            m_out.data() + FrameHeaderSize, bound,
+            m_shuffled.data(), m_shuffled.size(),
+            m_dict.data(), m_dict.size(), m_level);
+        if (ZSTD_isError(ret))
+            throw compression_error(ZSTD_getErrorName(ret));
+        putU32(m_out.data(), (uint32_t)ret);
+        putU32(m_out.data() + sizeof(uint32_t), (uint32_t)m_shuffled.size());
+        m_cb(m_out.data(), FrameHeaderSize + ret);
+        m_block.clear();
+    }
+
+    BlockCb m_cb;
+    size_t m_pointSize;
+    int m_level;
+    std::vector<char> m_dict;
+    size_t m_blockPoints;
+    std::vector<char> m_block;
+    std::vector<char> m_shuffled;
+    std::vector<char> m_out;
+    ZSTD_CCtx *m_ctx;
+};
+
+ShuffleZstdCompressor::ShuffleZstdCompressor(BlockCb cb, size_t pointSize) :
+    m_impl(new ShuffleZstdCompressorImpl(cb, pointSize, 15,
+        std::vector<char>()))
+{}
+
+
+ShuffleZstdCompressor::ShuffleZstdCompressor(BlockCb cb, size_t pointSize,
+        int compressionLevel, const std::vector<char>& dictionary) :
+    m_impl(new ShuffleZstdCompressorImpl(cb, pointSize, compressionLevel,
+        dictionary))
+{}
+
+
+ShuffleZstdCompressor::~ShuffleZstdCompressor()
+{}
+
+
+void ShuffleZstdCompressor::compress(const char *buf, size_t bufsize)
+{
+    m_impl->compress(buf, bufsize);
+}
+
+
+void ShuffleZstdCompressor::done()
+{
+    m_impl->done();
+}
+
+
+class ShuffleZstdDecompressorImpl
+{
+public:
+    ShuffleZstdDecompressorImpl(BlockCb cb, size_t pointSize,
+            const std::vector<char>& dict) :
+        m_cb(cb), m_pointSize((std::max)(pointSize, (size_t)1)), m_dict(dict)
+    {
+        m_ctx = ZSTD_createDCtx();
+    }
+
+    ~ShuffleZstdDecompressorImpl()
+    { ZSTD_freeDCtx(m_ctx); }
+
+    void decompress(const char *buf, size_t bufsize)
+    {
+        m_in.insert(m_in.end(), buf, buf + bufsize);
+
+        size_t pos = 0;
+        while (m_in.size() - pos >= FrameHeaderSize)
+        {
+            uint32_t compressedSize = getU32(m_in.data() + pos);
+            uint32_t rawSize = getU32(m_in.data() + pos + sizeof(uint32_t));
+            if (m_in.size() - pos - FrameHeaderSize < compressedSize)
+                break;
+            flushBlock(m_in.data() + pos + FrameHeaderSize, compressedSize,
+                rawSize);
+            pos += FrameHeaderSize + compressedSize;
+        }
+        m_in.erase(m_in.begin(), m_in.begin() + pos);
+    }
+
+    void done()
+    {
+        if (m_in.size())
+            throw compression_error("Truncated shuffled Zstd block.");
+    }
+
+private:
+    void flushBlock(const char *buf, size_t compressedSize, size_t rawSize)
+    {
+        m_shuffled.resize(rawSize);
+        size_t ret = ZSTD_decompress_usingDict(m_ctx,
+            m_shuffled.data(), rawSize, buf, compressedSize,
+            m_dict.data(), m_dict.size());
+        if (ZSTD_isError(ret))
+            throw compression_error(ZSTD_getErrorName(ret));
+        if (ret != rawSize)
+            throw compression_error("Shuffled Zstd block size mismatch.");
+
+        // Undo the byte shuffle.
+        size_t count = rawSize / m_pointSize;
+        m_block.resize(rawSize);
+        char *dst = m_block.data();
+        for (size_t i = 0; i < count; ++i)
+            for (size_t b = 0; b < m_pointSize; ++b)
+                *dst++ = m_shuffled[b * count + i];
+        std::copy(m_shuffled.data() + count * m_pointSize,
+            m_shuffled.data() + rawSize, dst);
+        m_cb(m_block.data(), m_block.size());
+    }
+
+    BlockCb m_cb;
+    size_t m_pointSize;
+    std::vector<char> m_dict;
+    std::vector<char> m_in;
+    std::vector<char> m_shuffled;
+    std::vector<char> m_block;
+    ZSTD_DCtx *m_ctx;
+};
+
+ShuffleZstdDecompressor::ShuffleZstdDecompressor(BlockCb cb,
+        size_t pointSize) :
+    m_impl(new ShuffleZstdDecompressorImpl(cb, pointSize,
+        std::vector<char>()))
+{}
+
+
+ShuffleZstdDecompressor::ShuffleZstdDecompressor(BlockCb cb, size_t pointSize,
+        const std::vector<char>& dictionary) :
+    m_impl(new ShuffleZstdDecompressorImpl(cb, pointSize, dictionary))
+{}
+
+
+ShuffleZstdDecompressor::~ShuffleZstdDecompressor()
+{}
+
+
+void ShuffleZstdDecompressor::decompress(const char *buf, size_t bufsize)
+{
+    m_impl->decompress(buf, bufsize);
+}
+
+
+void ShuffleZstdDecompressor::done()
+{
+    m_impl->done();
+}
+
+
+std::vector<char> trainZstdDictionary(const std::vector<char>& samples,
+    size_t sampleSize, size_t dictSize)
+{
+    if (!sampleSize || samples.size() < sampleSize || !dictSize)
+        return std::vector<char>();
+
+    size_t numSamples = samples.size() / sampleSize;
+    std::vector<size_t> sampleSizes(numSamples, sampleSize);
+    std::vector<char> dict(dictSize);
+    size_t ret = ZDICT_trainFromBuffer(dict.data(), dictSize,
+        samples.data(), sampleSizes.data(), (unsigned)numSamples);
+    if (ZDICT_isError(ret))
+        return std::vector<char>();
+    dict.resize(ret);
+    return dict;
+}
+
 } // namespace pdal
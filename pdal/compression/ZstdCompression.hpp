@@ -33,6 +33,8 @@
 ****************************************************************************/
 #pragma once
 
+#include <vector>
+
 #include "Compression.hpp"
 
 namespace pdal
@@ -70,5 +72,57 @@ private:
     std::unique_ptr<ZstdDecompressorImpl> m_impl;
 };
 
+class ShuffleZstdCompressorImpl;
+
+// Point-record codec.  Input is treated as a sequence of fixed-size
+// records (points); each block of records is transposed into per-byte
+// planes before Zstd compression, which groups the slowly-varying high
+// bytes of each field together and typically compresses point data much
+// better than a raw stream.  Output is a sequence of framed blocks that
+// only ShuffleZstdDecompressor understands - it is not a plain Zstd
+// stream.  An optional dictionary (see trainZstdDictionary()) improves
+// compression of small blocks; the same dictionary must be given to the
+// decompressor.
+class ShuffleZstdCompressor : public Compressor
+{
+public:
+    PDAL_DLL ShuffleZstdCompressor(BlockCb cb, size_t pointSize);
+    PDAL_DLL ShuffleZstdCompressor(BlockCb cb, size_t pointSize,
+        int compressionLevel, const std::vector<char>& dictionary);
+    PDAL_DLL ~ShuffleZstdCompressor();
+
+    PDAL_DLL void compress(const char *buf, size_t bufsize);
+    PDAL_DLL void done();
+
+private:
+    std::unique_ptr<ShuffleZstdCompressorImpl> m_impl;
+};
+
+class ShuffleZstdDecompressorImpl;
+
+class ShuffleZstdDecompressor : public Decompressor
+{
+public:
+    PDAL_DLL ShuffleZstdDecompressor(BlockCb cb, size_t pointSize);
+    PDAL_DLL ShuffleZstdDecompressor(BlockCb cb, size_t pointSize,
+        const std::vector<char>& dictionary);
+    PDAL_DLL ~ShuffleZstdDecompressor();
+
+    PDAL_DLL void decompress(const char *buf, size_t bufsize);
+    PDAL_DLL void done();
+
+private:
+    std::unique_ptr<ShuffleZstdDecompressorImpl> m_impl;
+};
+
+// Train a Zstd dictionary of at most 'dictSize' bytes from 'samples',
+// a concatenation of 'sampleSize'-byte byte-shuffled blocks.  Callers
+// are responsible for persisting the returned blob (for example,
+// base64-encoded in metadata) alongside the compressed data.  Returns
+// an empty vector if training fails - Zstd wants many samples - in
+// which case the codec should simply be used without a dictionary.
+PDAL_DLL std::vector<char> trainZstdDictionary(
+    const std::vector<char>& samples, size_t sampleSize, size_t dictSize);
+
 } // namespace pdal
 
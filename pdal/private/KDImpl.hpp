@@ -36,6 +36,9 @@
 
 #include <nanoflann/nanoflann.hpp>
 
+#include <pdal/util/IStream.hpp>
+#include <pdal/util/OStream.hpp>
+
 namespace pdal
 {
 
@@ -197,6 +200,64 @@ public:
         m_index.buildIndex();
     }
 
+    // The serialized form mirrors the live nanoflann index: the
+    // permutation array plus a preorder walk of the node tree.  Point
+    // data isn't stored; the caller ties the sidecar to the view with a
+    // checksum before asking for deserialization.
+    void serialize(OLeStream& out) const
+    {
+        out << (uint64_t)m_index.m_size;
+        out << (uint64_t)m_index.m_leaf_max_size;
+        if (m_index.m_size == 0)
+            return;
+        for (size_t i = 0; i < 3; ++i)
+        {
+            out << (double)m_index.root_bbox[i].low;
+            out << (double)m_index.root_bbox[i].high;
+        }
+        for (size_t i = 0; i < m_index.m_size; ++i)
+            out << (uint64_t)m_index.vind[i];
+        saveNode(out, m_index.root_node);
+    }
+
+    bool deserialize(ILeStream& in)
+    {
+        uint64_t size, leafMaxSize;
+        in >> size >> leafMaxSize;
+        if (!in.good() || size != m_buf.size() ||
+            leafMaxSize != m_index.m_leaf_max_size)
+            return false;
+
+        m_index.freeIndex(m_index);
+        m_index.m_size = size;
+        m_index.m_size_at_index_build = size;
+        if (size == 0)
+            return in.good();
+
+        m_index.root_bbox.resize(3);
+        for (size_t i = 0; i < 3; ++i)
+        {
+            double low, high;
+            in >> low >> high;
+            m_index.root_bbox[i] = { low, high };
+        }
+        m_index.vind.resize(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            uint64_t v;
+            in >> v;
+            if (v >= size)
+                return false;
+            m_index.vind[i] = v;
+        }
+
+        // A tree with leaves of at least one point has fewer than 2 * size
+        // nodes; anything more means a corrupt file.
+        size_t budget = 2 * size;
+        m_index.root_node = loadNode(in, budget);
+        return m_index.root_node && in.good();
+    }
+
     PointIdList neighbors(double x, double y, double z, point_count_t k,
         size_t stride) const
     {
@@ -244,6 +305,19 @@ public:
         m_index.findNeighbors(resultSet, &pt[0], nanoflann::SearchParams(10));
     }
 
+    // Raw-pointer variant for queries into a preallocated arena.  'k'
+    // must already be clamped to the point count.
+    void knnSearch(double x, double y, double z, point_count_t k,
+        PointId *indices, double *sqr_dists) const
+    {
+        nanoflann::KNNResultSet<double, PointId, point_count_t> resultSet(k);
+
+        resultSet.init(indices, sqr_dists);
+
+        std::array<double, 3> pt { x, y, z };
+        m_index.findNeighbors(resultSet, &pt[0], nanoflann::SearchParams(10));
+    }
+
     PointIdList radius(double x, double y, double z, double r) const
     {
         PointIdList output;
@@ -263,13 +337,153 @@ public:
         return output;
     }
 
+    double nearestDist2Bounded(double x, double y, double z,
+        double bound2) const
+    {
+        BoundedNNResultSet resultSet(bound2);
+        std::array<double, 3> pt { x, y, z };
+        m_index.findNeighbors(resultSet, &pt[0], nanoflann::SearchParams(10));
+        return resultSet.best();
+    }
+
+    point_count_t radiusCount(double x, double y, double z, double r) const
+    {
+        CountingRadiusResultSet resultSet(r * r);
+        std::array<double, 3> pt { x, y, z };
+
+        // Our distance metric is square distance, so we use the square of
+        // the radius.
+        m_index.radiusSearchCustomCallback(&pt[0], resultSet,
+            nanoflann::SearchParams());
+        return resultSet.count();
+    }
+
 private:
+    // Result set for radius queries that only need the number of matches;
+    // neighbors are counted without materializing ids or distances.  The
+    // match criterion (dist < r^2) is that of nanoflann's RadiusResultSet,
+    // so counts agree with those of a standard radius query.
+    class CountingRadiusResultSet
+    {
+    public:
+        CountingRadiusResultSet(double radius2) : m_radius2(radius2)
+        {}
+
+        std::size_t size() const
+            { return m_count; }
+        bool full() const
+            { return true; }
+        bool addPoint(double dist, PointId /*index*/)
+        {
+            if (dist < m_radius2)
+                m_count++;
+            return true;
+        }
+        double worstDist() const
+            { return m_radius2; }
+        point_count_t count() const
+            { return m_count; }
+
+    private:
+        double m_radius2;
+        point_count_t m_count = 0;
+    };
+
+    // Result set that tracks only the nearest squared distance and stops
+    // the search once that distance falls within 'bound2'.  For max-of-min
+    // reductions (Hausdorff), a point whose nearest neighbor is already
+    // inside the current bound can't raise it, so the exact distance
+    // doesn't matter.  worstDist() feeding back the best-so-far distance
+    // prunes subtrees exactly as a standard nearest-neighbor search does.
+    class BoundedNNResultSet
+    {
+    public:
+        BoundedNNResultSet(double bound2) : m_bound2(bound2)
+        {}
+
+        std::size_t size() const
+            { return 1; }
+        bool full() const
+            { return true; }
+        bool addPoint(double dist, PointId /*index*/)
+        {
+            if (dist < m_best)
+                m_best = dist;
+            return m_best > m_bound2;
+        }
+        double worstDist() const
+            { return m_best; }
+        double best() const
+            { return m_best; }
+
+    private:
+        double m_bound2;
+        double m_best = (std::numeric_limits<double>::max)();
+    };
+
     const PointView& m_buf;
 
     typedef nanoflann::KDTreeSingleIndexAdaptor<nanoflann::L2_Simple_Adaptor<
         double, KD3Impl, double>, KD3Impl, -1, std::size_t> KDTree;
 
     KDTree m_index;
+
+    void saveNode(OLeStream& out, const KDTree::Node *node) const
+    {
+        bool leaf = (node->child1 == NULL && node->child2 == NULL);
+        out << (uint8_t)(leaf ? 1 : 0);
+        if (leaf)
+        {
+            out << (uint64_t)node->node_type.lr.left;
+            out << (uint64_t)node->node_type.lr.right;
+        }
+        else
+        {
+            out << (int32_t)node->node_type.sub.divfeat;
+            out << (double)node->node_type.sub.divlow;
+            out << (double)node->node_type.sub.divhigh;
+            saveNode(out, node->child1);
+            saveNode(out, node->child2);
+        }
+    }
+
+    KDTree::Node *loadNode(ILeStream& in, size_t& budget)
+    {
+        if (!in.good() || budget == 0)
+            return NULL;
+        budget--;
+
+        KDTree::Node *node = m_index.pool.template allocate<KDTree::Node>();
+        uint8_t leaf;
+        in >> leaf;
+        if (leaf)
+        {
+            uint64_t left, right;
+            in >> left >> right;
+            if (left > right || right > m_index.m_size)
+                return NULL;
+            node->node_type.lr.left = left;
+            node->node_type.lr.right = right;
+            node->child1 = NULL;
+            node->child2 = NULL;
+        }
+        else
+        {
+            int32_t divfeat;
+            double divlow, divhigh;
+            in >> divfeat >> divlow >> divhigh;
+            if (divfeat < 0 || divfeat >= 3)
+                return NULL;
+            node->node_type.sub.divfeat = divfeat;
+            node->node_type.sub.divlow = divlow;
+            node->node_type.sub.divhigh = divhigh;
+            node->child1 = loadNode(in, budget);
+            node->child2 = loadNode(in, budget);
+            if (!node->child1 || !node->child2)
+                return NULL;
+        }
+        return node;
+    }
 };
 
 class KDFlexImpl
@@ -32,14 +32,17 @@
 * OF SUCH DAMAGE.
 ****************************************************************************/
 
+#include <algorithm>
 #include <array>
 #include <cfloat>
 #include <numeric>
+#include <thread>
 #include <vector>
 
 #include <pdal/PointView.hpp>
 #include <pdal/SpatialReference.hpp>
 #include <pdal/util/Bounds.hpp>
+#include <pdal/util/ThreadPool.hpp>
 #include <pdal/util/Utils.hpp>
 #include <pdal/private/gdal/Raster.hpp>
 
@@ -94,22 +97,70 @@ PointViewPtr demeanPointView(const PointView& view, double* centroid)
     return outView;
 }
 
+namespace
+{
+
+// Block size for staging coordinates through the transform kernel -
+// big enough to amortize the gather/scatter, small enough to stay in
+// cache.
+const size_t transformBlockSize = 1024;
+
+// Reorder a column-major 4x4 (Eigen layout) into the row-major 3x4
+// form transformCoords() consumes.
+void rowMajor3x4(const double* m, double* r)
+{
+    for (size_t row = 0; row < 3; ++row)
+        for (size_t col = 0; col < 4; ++col)
+            r[row * 4 + col] = m[col * 4 + row];
+}
+
+} // unnamed namespace
+
+void transformCoords(size_t count, double* x, double* y, double* z,
+    const double* matrix)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        double px = x[i];
+        double py = y[i];
+        double pz = z[i];
+        x[i] = px * matrix[0] + py * matrix[1] + pz * matrix[2] + matrix[3];
+        y[i] = px * matrix[4] + py * matrix[5] + pz * matrix[6] + matrix[7];
+        z[i] = px * matrix[8] + py * matrix[9] + pz * matrix[10] + matrix[11];
+    }
+}
+
+
 PointViewPtr transform(const PointView& view, double* matrix)
 {
     using namespace Dimension;
 
+    double r[12];
+    rowMajor3x4(matrix, r);
+    double x[transformBlockSize];
+    double y[transformBlockSize];
+    double z[transformBlockSize];
+
     PointViewPtr outView = view.makeNew();
-    for (PointId idx = 0; idx < view.size(); idx++)
+    PointId idx = 0;
+    while (idx < view.size())
     {
-        double x = view.getFieldAs<double>(Id::X, idx);
-        double y = view.getFieldAs<double>(Id::Y, idx);
-        double z = view.getFieldAs<double>(Id::Z, idx);
-        outView->setField(Id::X, idx,
-                          x * matrix[0] + y * matrix[4] + z * matrix[8] + matrix[12]);
-        outView->setField(Id::Y, idx,
-                          x * matrix[1] + y * matrix[5] + z * matrix[9] + matrix[13]);
-        outView->setField(Id::Z, idx,
-                          x * matrix[2] + y * matrix[6] + z * matrix[10] + matrix[14]);
+        size_t n = (std::min)((size_t)(view.size() - idx),
+            transformBlockSize);
+        for (size_t i = 0; i < n; ++i)
+        {
+            x[i] = view.getFieldAs<double>(Id::X, idx + i);
+            y[i] = view.getFieldAs<double>(Id::Y, idx + i);
+            z[i] = view.getFieldAs<double>(Id::Z, idx + i);
+        }
+        transformCoords(n, x, y, z, r);
+        for (size_t i = 0; i < n; ++i)
+        {
+            outView->setField(Id::X, idx + i, x[i]);
+            outView->setField(Id::Y, idx + i, y[i]);
+            outView->setField(Id::Z, idx + i, z[i]);
+        }
+        idx += n;
     }
     return outView;
 }
@@ -119,17 +170,31 @@ void transformInPlace(PointView& view, double* matrix)
 {
     using namespace Dimension;
 
-    for (PointId idx = 0; idx < view.size(); idx++)
+    double r[12];
+    rowMajor3x4(matrix, r);
+    double x[transformBlockSize];
+    double y[transformBlockSize];
+    double z[transformBlockSize];
+
+    PointId idx = 0;
+    while (idx < view.size())
     {
-        double x = view.getFieldAs<double>(Id::X, idx);
-        double y = view.getFieldAs<double>(Id::Y, idx);
-        double z = view.getFieldAs<double>(Id::Z, idx);
-        view.setField(Id::X, idx,
-                      x * matrix[0] + y * matrix[4] + z * matrix[8] + matrix[12]);
-        view.setField(Id::Y, idx,
-                      x * matrix[1] + y * matrix[5] + z * matrix[9] + matrix[13]);
-        view.setField(Id::Z, idx,
-                      x * matrix[2] + y * matrix[6] + z * matrix[10] + matrix[14]);
+        size_t n = (std::min)((size_t)(view.size() - idx),
+            transformBlockSize);
+        for (size_t i = 0; i < n; ++i)
+        {
+            x[i] = view.getFieldAs<double>(Id::X, idx + i);
+            y[i] = view.getFieldAs<double>(Id::Y, idx + i);
+            z[i] = view.getFieldAs<double>(Id::Z, idx + i);
+        }
+        transformCoords(n, x, y, z, r);
+        for (size_t i = 0; i < n; ++i)
+        {
+            view.setField(Id::X, idx + i, x[i]);
+            view.setField(Id::Y, idx + i, y[i]);
+            view.setField(Id::Z, idx + i, z[i]);
+        }
+        idx += n;
     }
 }
 
@@ -171,24 +236,35 @@ Eigen::Matrix3d computeCovariance(const PointView& view,
 
     Vector3d centroid = computeCentroid(view, ids);
 
-    // demean the neighborhood
-    MatrixXd A(3, n);
-    size_t k = 0;
+    // Accumulate the six unique products of the demeaned coordinates
+    // directly rather than materializing the neighborhood in a dynamic
+    // matrix - neighborhoods are queried per point, so for typical k the
+    // allocation would dominate the arithmetic.
+    double xx(0), xy(0), xz(0), yy(0), yz(0), zz(0);
     for (auto const& j : ids)
     {
-        A(0, k) =
+        double x =
             static_cast<float>(view.getFieldAs<double>(Dimension::Id::X, j) -
                 centroid[0]);
-        A(1, k) =
+        double y =
             static_cast<float>(view.getFieldAs<double>(Dimension::Id::Y, j) -
                 centroid[1]);
-        A(2, k) =
+        double z =
             static_cast<float>(view.getFieldAs<double>(Dimension::Id::Z, j) -
                 centroid[2]);
-        k++;
+        xx += x * x;
+        xy += x * y;
+        xz += x * z;
+        yy += y * y;
+        yz += y * z;
+        zz += z * z;
     }
 
-    return A * A.transpose() / (ids.size()-1);
+    Matrix3d B;
+    B << xx, xy, xz,
+         xy, yy, yz,
+         xz, yz, zz;
+    return B / (n - 1);
 }
 
 uint8_t computeRank(const PointView& view, const PointIdList& ids,
@@ -255,77 +331,137 @@ Eigen::MatrixXd extendedLocalMinimum(const PointView& view, int rows, int cols,
     return ZImin;
 }
 
-void dilateDiamond(std::vector<double>& data, size_t rows, size_t cols, int iterations)
+namespace
+{
+
+// One pass of the diamond dilation (max) or erosion (min) over a range of
+// columns.  Each output cell depends only on the input raster, so
+// disjoint column ranges can run concurrently.
+void diamondPass(const std::vector<double>& data, std::vector<double>& out,
+    size_t rows, size_t cols, size_t colStart, size_t colEnd, bool dilate)
 {
-    std::vector<double> out(data.size(), std::numeric_limits<double>::lowest());
     std::array<size_t, 5> idx;
 
-    for (int iter = 0; iter < iterations; ++iter)
+    for (size_t col = colStart; col < colEnd; ++col)
     {
-        for (size_t col = 0; col < cols; ++col)
+        size_t index = col*rows;
+        for (size_t row = 0; row < rows; ++row)
         {
-            size_t index = col*rows;
-            for (size_t row = 0; row < rows; ++row)
+            // Find the index into the vector of the current cell.  Then
+            // find the index of the cells to the right/left/above/below
+            // if they exist.
+            size_t j = 0;
+            idx[j++] = index+row;
+            if (row > 0)
+                idx[j++] = idx[0]-1;
+            if (row < rows-1)
+                idx[j++] = idx[0]+1;
+            if (col > 0)
+                idx[j++] = idx[0]-rows;
+            if (col < cols-1)
+                idx[j++] = idx[0]+rows;
+            // The output cell is the extreme of the cell and its
+            // neighbors.
+            double best = data[idx[0]];
+            for (size_t i = 1; i < j; ++i)
             {
-                // Find the index into the vector of the current cell.  Then
-                // find the index of the cells to the right/left/above/below
-                // if they exist.
-                size_t j = 0;
-                idx[j++] = index+row;
-                if (row > 0)
-                    idx[j++] = idx[0]-1;
-                if (row < rows-1)
-                    idx[j++] = idx[0]+1;
-                if (col > 0)
-                    idx[j++] = idx[0]-rows;
-                if (col < cols-1)
-                    idx[j++] = idx[0]+rows;
-                // If the data at the test cell pos is greater than that
-                // from the last iteration, set the value to the maximum of
-                // the value of those cells.
-                for (size_t i = 0; i < j; ++i)
-                {
-                    if (data[idx[i]] > out[index+row])
-                        out[index+row] = data[idx[i]];
-                }
+                double v = data[idx[i]];
+                if (dilate ? (v > best) : (v < best))
+                    best = v;
             }
+            out[index+row] = best;
         }
-        data.swap(out);
     }
 }
 
-void erodeDiamond(std::vector<double>& data, size_t rows, size_t cols,
-    int iterations)
+// Iterated diamond morphology, parallelized over column bands.  Each
+// worker copies its band plus a halo of 'iterations' columns and runs
+// every pass on the private copy: a cell's value after p passes depends
+// only on cells within diamond radius p, so the halo shrinks by one
+// column per pass and the band interior stays exact with a single
+// synchronization for the whole call.  When bands are narrow relative to
+// the radius the halo recomputation would dominate, so fall back to
+// synchronizing after each pass instead.
+void diamondMorph(std::vector<double>& data, size_t rows, size_t cols,
+    int iterations, bool dilate)
 {
-    std::vector<double> out(data.size(), (std::numeric_limits<double>::max)());
-    std::array<size_t, 5> idx;
+    if (data.empty() || iterations < 1)
+        return;
+
+    std::vector<double> out(data.size());
+    const size_t threads = (std::min)((size_t)(std::max)(
+        std::thread::hardware_concurrency(), 1U), cols);
+    const size_t halo = (size_t)iterations;
+    ThreadPool pool(threads);
 
-    for (int iter = 0; iter < iterations; ++iter)
+    if (threads == 1 || cols / threads < 4 * halo)
     {
-        for (size_t col = 0; col < cols; ++col)
+        for (int iter = 0; iter < iterations; ++iter)
         {
-            size_t index = col*rows;
-            for (size_t row = 0; row < rows; ++row)
+            for (size_t t = 0; t < threads; ++t)
             {
-                size_t j = 0;
-                idx[j++] = index+row;
-                if (row > 0)
-                    idx[j++] = idx[0]-1;
-                if (row < rows-1)
-                    idx[j++] = idx[0]+1;
-                if (col > 0)
-                    idx[j++] = idx[0]-rows;
-                if (col < cols-1)
-                    idx[j++] = idx[0]+rows;
-                for (size_t i = 0; i < j; ++i)
+                const size_t colStart = t * cols / threads;
+                const size_t colEnd =
+                    (t + 1 == threads) ? cols : (t + 1) * cols / threads;
+                pool.add([&data, &out, rows, cols, colStart, colEnd, dilate]()
                 {
-                    if (data[idx[i]] < out[index+row])
-                        out[index+row] = data[idx[i]];
-                }
+                    diamondPass(data, out, rows, cols, colStart, colEnd,
+                        dilate);
+                });
             }
+            pool.await();
+            data.swap(out);
         }
-        data.swap(out);
+        return;
+    }
+
+    for (size_t t = 0; t < threads; ++t)
+    {
+        const size_t colStart = t * cols / threads;
+        const size_t colEnd =
+            (t + 1 == threads) ? cols : (t + 1) * cols / threads;
+        pool.add([&data, &out, rows, cols, colStart, colEnd, halo,
+            iterations, dilate]()
+        {
+            const size_t lo = colStart > halo ? colStart - halo : 0;
+            const size_t hi = (std::min)(colEnd + halo, cols);
+            const size_t localCols = hi - lo;
+
+            std::vector<double> cur(data.begin() + lo * rows,
+                data.begin() + hi * rows);
+            std::vector<double> next(cur.size());
+
+            for (int p = 1; p <= iterations; ++p)
+            {
+                // Columns still exact after p passes: those whose
+                // radius-p diamond lies in the copied band or is clipped
+                // by the true raster edge.
+                const size_t vlo = (lo == 0) ? 0 : lo + p;
+                const size_t vhi = (hi == cols) ? cols : hi - p;
+                diamondPass(cur, next, rows, localCols, vlo - lo, vhi - lo,
+                    dilate);
+                cur.swap(next);
+            }
+            std::copy(cur.begin() + (colStart - lo) * rows,
+                cur.begin() + (colEnd - lo) * rows,
+                out.begin() + colStart * rows);
+        });
     }
+    pool.await();
+    data.swap(out);
+}
+
+} // unnamed namespace
+
+void dilateDiamond(std::vector<double>& data, size_t rows, size_t cols, int iterations)
+{
+    diamondMorph(data, rows, cols, iterations, true);
+}
+
+void erodeDiamond(std::vector<double>& data, size_t rows, size_t cols,
+    int iterations)
+{
+    diamondMorph(data, rows, cols, iterations, false);
 }
 
 Eigen::MatrixXd pointViewToEigen(const PointView& view)
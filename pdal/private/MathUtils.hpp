@@ -68,6 +68,23 @@ PointViewPtr demeanPointView(const PointView& view);
 PointViewPtr demeanPointView(const PointView& ,double* centroid);
 PointViewPtr transform(const PointView&, double* matrix);
 void transformInPlace(PointView&, double* matrix);
+
+/**
+  Apply an affine transform to a block of coordinates in place.
+
+  The matrix is the upper three rows of a 4x4 transform in row-major
+  order (12 entries).  Operating on contiguous arrays keeps the
+  multiply-add chain free of per-point field dispatch so the compiler
+  can vectorize it.
+
+  \param count  Number of coordinates in each array.
+  \param x  X values, overwritten with transformed values.
+  \param y  Y values, overwritten with transformed values.
+  \param z  Z values, overwritten with transformed values.
+  \param matrix  Row-major 3x4 affine matrix.
+*/
+void transformCoords(size_t count, double* x, double* y, double* z,
+    const double* matrix);
 double barycentricInterpolation(double x1, double y1, double z1,
     double x2, double y2, double z2, double x3, double y3, double z3,
     double x, double y);
@@ -197,6 +197,14 @@ public:
     const_iterator end() const
         { return m_data.end(); }
 
+    /// Release the cell data, leaving the limits intact.  Lets a consumer
+    /// drop a raster's memory once it's done with the contents.
+    void release()
+    {
+        m_data.clear();
+        m_data.shrink_to_fit();
+    }
+
     void expandToInclude(double x, double y);
 
     //ABELL - This should probably call expand().
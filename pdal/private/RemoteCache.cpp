@@ -0,0 +1,145 @@
+/******************************************************************************
+* Copyright (c) 2026, Hobu Inc.
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+*       names of its contributors may be used to endorse or promote
+*       products derived from this software without specific prior
+*       written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#include "RemoteCache.hpp"
+
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+
+#include <pdal/util/FileUtils.hpp>
+
+#include <arbiter/arbiter.hpp>
+
+namespace pdal
+{
+
+RemoteCache& RemoteCache::instance()
+{
+    static RemoteCache cache;
+    return cache;
+}
+
+
+RemoteCache::RemoteCache() : m_ttl(3600)
+{
+    const char *dir = std::getenv("PDAL_REMOTE_CACHE_DIR");
+    if (!dir || !*dir)
+        return;
+
+    const char *ttl = std::getenv("PDAL_REMOTE_CACHE_TTL");
+    if (ttl && *ttl)
+        m_ttl = std::atoll(ttl);
+
+    // A directory we can't create just leaves the cache disabled.
+    if (FileUtils::directoryExists(dir) || FileUtils::createDirectories(dir))
+        m_dir = dir;
+}
+
+
+// Entries are addressed by the MD5 of the path and the byte range, so the
+// same object requested by concurrent or subsequent pipelines maps to the
+// same file.
+std::string RemoteCache::entryPath(const std::string& path, uint64_t offset,
+    uint64_t size) const
+{
+    std::string key = path + "\n" + std::to_string(offset) + "-" +
+        std::to_string(size);
+    return m_dir + "/" + arbiter::crypto::encodeAsHex(
+        arbiter::crypto::md5(key));
+}
+
+
+bool RemoteCache::expired(const std::string& filename) const
+{
+    if (m_ttl <= 0)
+        return false;
+
+    struct tm mod;
+    FileUtils::fileTimes(filename, nullptr, &mod);
+#ifdef _WIN32
+    time_t modTime = _mkgmtime(&mod);
+#else
+    time_t modTime = timegm(&mod);
+#endif
+    return std::difftime(std::time(nullptr), modTime) > (double)m_ttl;
+}
+
+
+bool RemoteCache::get(const std::string& path, uint64_t offset, uint64_t size,
+    std::vector<char>& data)
+{
+    if (!enabled())
+        return false;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::string filename = entryPath(path, offset, size);
+    if (!FileUtils::fileExists(filename) || expired(filename))
+        return false;
+
+    std::ifstream in(filename, std::ios::binary | std::ios::ate);
+    if (!in)
+        return false;
+    data.resize((size_t)in.tellg());
+    in.seekg(0);
+    in.read(data.data(), data.size());
+    return (bool)in;
+}
+
+
+void RemoteCache::put(const std::string& path, uint64_t offset, uint64_t size,
+    const std::vector<char>& data)
+{
+    if (!enabled())
+        return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Write to a temporary and rename so readers never see a partial
+    // entry.
+    std::string filename = entryPath(path, offset, size);
+    std::string temp = filename + ".tmp";
+    std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+    if (!out)
+        return;
+    out.write(data.data(), data.size());
+    out.close();
+    if (out)
+        FileUtils::renameFile(filename, temp);
+    else
+        FileUtils::deleteFile(temp);
+}
+
+} // namespace pdal
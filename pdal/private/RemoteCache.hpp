@@ -0,0 +1,82 @@
+/******************************************************************************
+* Copyright (c) 2026, Hobu Inc.
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+*       names of its contributors may be used to endorse or promote
+*       products derived from this software without specific prior
+*       written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <pdal/pdal_internal.hpp>
+
+namespace pdal
+{
+
+// Content-addressed on-disk cache for remote objects (whole files and byte
+// ranges), shared by the remote access paths.  Disabled unless the
+// environment variable PDAL_REMOTE_CACHE_DIR names a directory to cache
+// into.  Entries older than PDAL_REMOTE_CACHE_TTL seconds (default one
+// hour; 0 means entries never expire) are treated as misses so they get
+// refetched.
+class PDAL_DLL RemoteCache
+{
+public:
+    static RemoteCache& instance();
+
+    bool enabled() const
+        { return !m_dir.empty(); }
+
+    // Fetch the cached contents of a remote object or byte range.  A size
+    // of 0 refers to the whole object.  Returns false on a miss or an
+    // expired entry.
+    bool get(const std::string& path, uint64_t offset, uint64_t size,
+        std::vector<char>& data);
+
+    // Store the contents of a remote object or byte range.
+    void put(const std::string& path, uint64_t offset, uint64_t size,
+        const std::vector<char>& data);
+
+private:
+    RemoteCache();
+
+    std::string entryPath(const std::string& path, uint64_t offset,
+        uint64_t size) const;
+    bool expired(const std::string& filename) const;
+
+    std::string m_dir;
+    int64_t m_ttl;
+    std::mutex m_mutex;
+};
+
+} // namespace pdal
@@ -0,0 +1,282 @@
+/******************************************************************************
+* Copyright (c) 2026, Hobu Inc.
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+*       names of its contributors may be used to endorse or promote
+*       products derived from this software without specific prior
+*       written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#include "ResultCache.hpp"
+
+#include <ctime>
+#include <fstream>
+
+#include <pdal/PointRef.hpp>
+#include <pdal/SpillTable.hpp>
+#include <pdal/Stage.hpp>
+#include <pdal/util/FileUtils.hpp>
+
+namespace pdal
+{
+
+namespace
+{
+
+// FNV-1a, rendered as hex for use in filenames.
+std::string hashKey(const std::string& text)
+{
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (char c : text)
+    {
+        h ^= (unsigned char)c;
+        h *= 0x100000001b3ULL;
+    }
+
+    const char *digits = "0123456789abcdef";
+    std::string hex;
+    for (int i = 60; i >= 0; i -= 4)
+        hex += digits[(h >> i) & 0xf];
+    return hex;
+}
+
+
+// Copy one field, switching on the destination type.  Conversion only
+// kicks in if a cached layout doesn't match the current one exactly.
+void copyField(PointRef& src, PointView& dst, PointId dstId,
+    Dimension::Id dim, Dimension::Type type)
+{
+    using Type = Dimension::Type;
+
+    switch (type)
+    {
+    case Type::Unsigned8:
+        dst.setField(dim, dstId, src.getFieldAs<uint8_t>(dim));
+        break;
+    case Type::Unsigned16:
+        dst.setField(dim, dstId, src.getFieldAs<uint16_t>(dim));
+        break;
+    case Type::Unsigned32:
+        dst.setField(dim, dstId, src.getFieldAs<uint32_t>(dim));
+        break;
+    case Type::Unsigned64:
+        dst.setField(dim, dstId, src.getFieldAs<uint64_t>(dim));
+        break;
+    case Type::Signed8:
+        dst.setField(dim, dstId, src.getFieldAs<int8_t>(dim));
+        break;
+    case Type::Signed16:
+        dst.setField(dim, dstId, src.getFieldAs<int16_t>(dim));
+        break;
+    case Type::Signed32:
+        dst.setField(dim, dstId, src.getFieldAs<int32_t>(dim));
+        break;
+    case Type::Signed64:
+        dst.setField(dim, dstId, src.getFieldAs<int64_t>(dim));
+        break;
+    case Type::Float:
+        dst.setField(dim, dstId, src.getFieldAs<float>(dim));
+        break;
+    case Type::Double:
+        dst.setField(dim, dstId, src.getFieldAs<double>(dim));
+        break;
+    case Type::None:
+        break;
+    }
+}
+
+} // unnamed namespace
+
+
+ResultCache::ResultCache(const std::string& dir) : m_dir(dir)
+{
+    if (!FileUtils::directoryExists(m_dir))
+        FileUtils::createDirectory(m_dir);
+}
+
+
+std::string ResultCache::key(Stage& s)
+{
+    auto it = m_keys.find(&s);
+    if (it != m_keys.end())
+        return it->second;
+
+    std::string text = s.getName();
+    for (const Option& o : s.getOptions().getOptions())
+    {
+        text += '\0' + o.getName() + '\0' + o.getValue();
+
+        // If an option value names a file, fold in its identity so that
+        // replacing the file invalidates the entry even though the
+        // option text is unchanged.
+        const std::string& v = o.getValue();
+        if (FileUtils::fileExists(v) && !FileUtils::isDirectory(v))
+        {
+            struct tm mod;
+            FileUtils::fileTimes(v, nullptr, &mod);
+#ifdef _WIN32
+            time_t modTime = _mkgmtime(&mod);
+#else
+            time_t modTime = timegm(&mod);
+#endif
+            text += '\0' + std::to_string(FileUtils::fileSize(v)) + '\0' +
+                std::to_string(modTime);
+        }
+    }
+    for (Stage *in : s.getInputs())
+        text += '\0' + key(*in);
+
+    std::string k = hashKey(text);
+    m_keys[&s] = k;
+    return k;
+}
+
+
+std::string ResultCache::manifestPath(const std::string& key) const
+{
+    return m_dir + "/" + key + ".manifest";
+}
+
+
+std::string ResultCache::viewPath(const std::string& key, size_t view) const
+{
+    return m_dir + "/" + key + "-" + std::to_string(view) + ".spill";
+}
+
+
+bool ResultCache::has(const std::string& key) const
+{
+    std::istream *in = FileUtils::openFile(manifestPath(key), false);
+    if (!in)
+        return false;
+
+    // The manifest is written last, so its presence implies the spill
+    // files exist; still check in case someone pruned the directory by
+    // hand.
+    size_t numViews;
+    *in >> numViews;
+    bool ok = in->good();
+    FileUtils::closeFile(in);
+    for (size_t i = 0; ok && i < numViews; ++i)
+        ok = FileUtils::fileExists(viewPath(key, i));
+    return ok;
+}
+
+
+PointViewSet ResultCache::load(const std::string& key, PointTableRef table)
+{
+    std::istream *in = FileUtils::openFile(manifestPath(key), false);
+    if (!in)
+        throw pdal_error("ResultCache: can't open manifest for entry '" +
+            key + "'.");
+
+    size_t numViews;
+    *in >> numViews;
+    in->ignore(1);  // Trailing newline.
+
+    PointViewSet views;
+    for (size_t i = 0; i < numViews; ++i)
+    {
+        std::string srsWkt;
+        std::getline(*in, srsWkt);
+
+        MappedSpillTable spill(viewPath(key, i));
+        PointLayoutPtr srcLayout = spill.layout();
+        PointLayoutPtr dstLayout = table.layout();
+
+        // Map the cached dimensions onto the current layout by name.
+        // Dimensions the current layout doesn't know are dropped.
+        std::vector<std::pair<Dimension::Id, Dimension::Type>> dims;
+        for (Dimension::Id id : srcLayout->dims())
+        {
+            Dimension::Id dstId = dstLayout->findDim(srcLayout->dimName(id));
+            if (dstId != Dimension::Id::Unknown)
+                dims.push_back({dstId, dstLayout->dimType(dstId)});
+        }
+
+        PointViewPtr view(new PointView(table, SpatialReference(srsWkt)));
+        PointRef src(spill, 0);
+        for (PointId idx = 0; idx < spill.numPoints(); ++idx)
+        {
+            src.setPointId(idx);
+            for (auto& d : dims)
+                copyField(src, *view, idx, d.first, d.second);
+        }
+        views.insert(view);
+    }
+    bool ok = in->good();
+    FileUtils::closeFile(in);
+    if (!ok)
+        throw pdal_error("ResultCache: entry '" + key +
+            "' has a corrupt manifest.");
+    return views;
+}
+
+
+void ResultCache::store(const std::string& key, const PointViewSet& views)
+{
+    size_t viewNum = 0;
+    for (const PointViewPtr& v : views)
+    {
+        SpillPointTable spill(viewPath(key, viewNum++));
+
+        // Register the view's dimensions in layout order so the ids in
+        // the spill view match those of the source.
+        PointLayoutPtr srcLayout = v->layout();
+        for (Dimension::Id id : srcLayout->dims())
+            spill.layout()->registerOrAssignDim(srcLayout->dimName(id),
+                srcLayout->dimType(id));
+        spill.finalize();
+
+        PointView out(spill);
+        PointRef src(*v, 0);
+        for (PointId idx = 0; idx < v->size(); ++idx)
+        {
+            src.setPointId(idx);
+            for (Dimension::Id id : srcLayout->dims())
+                copyField(src, out, idx, id, srcLayout->dimType(id));
+        }
+        spill.close();
+    }
+
+    // Write the manifest last; it marks the entry complete.
+    std::ostream *out = FileUtils::createFile(manifestPath(key), false);
+    if (!out)
+        throw pdal_error("ResultCache: can't write manifest for entry '" +
+            key + "'.");
+    *out << views.size() << "\n";
+    for (const PointViewPtr& v : views)
+        *out << v->spatialReference().getWKT() << "\n";
+    bool ok = out->good();
+    FileUtils::closeFile(out);
+    if (!ok)
+        throw pdal_error("ResultCache: failure writing manifest for entry '" +
+            key + "'.");
+}
+
+} // namespace pdal
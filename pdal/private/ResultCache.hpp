@@ -0,0 +1,88 @@
+/******************************************************************************
+* Copyright (c) 2026, Hobu Inc.
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+*       names of its contributors may be used to endorse or promote
+*       products derived from this software without specific prior
+*       written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#pragma once
+
+#include <map>
+#include <string>
+
+#include <pdal/PointTable.hpp>
+#include <pdal/PointView.hpp>
+
+namespace pdal
+{
+
+class Stage;
+
+// On-disk cache of stage outputs, used to re-run a pipeline after an
+// options edit without recomputing stages whose inputs didn't change.
+// Entries are addressed by a key hashed from a stage's driver name, its
+// options and the keys of its inputs, so editing a late stage leaves the
+// keys (and cached results) of everything upstream intact.  Option values
+// that name existing files fold in the file's size and modification time,
+// so edited input data misses.
+//
+// Each entry is a spill file per point view plus a small manifest
+// recording the view order and spatial references.  Only point data and
+// spatial references are captured: meshes, rasters and stage metadata are
+// not, so pipelines that pass those between stages shouldn't use the
+// cache.
+class PDAL_DLL ResultCache
+{
+public:
+    ResultCache(const std::string& dir);
+
+    // Cache key for a stage.  Keys are memoized per stage for the life
+    // of the cache object.
+    std::string key(Stage& s);
+
+    // Whether a complete entry exists for the key.
+    bool has(const std::string& key) const;
+
+    // Rebuild the cached point views in the given table.
+    PointViewSet load(const std::string& key, PointTableRef table);
+
+    // Stage the point views under the key.  An entry that can't be
+    // written (e.g. an unwritable cache directory) throws.
+    void store(const std::string& key, const PointViewSet& views);
+
+private:
+    std::string manifestPath(const std::string& key) const;
+    std::string viewPath(const std::string& key, size_t view) const;
+
+    std::string m_dir;
+    std::map<Stage *, std::string> m_keys;
+};
+
+} // namespace pdal
@@ -28,14 +28,73 @@
  * OF SUCH DAMAGE.
  ****************************************************************************/
 
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <vector>
+
 #include "SrsTransform.hpp"
 #include <pdal/SpatialReference.hpp>
 
+#include <cpl_conv.h>
 #include <ogr_spatialref.h>
 
 namespace pdal
 {
 
+namespace
+{
+
+std::string exportWkt(const OGRSpatialReference& ref)
+{
+    char *wkt = nullptr;
+    ref.exportToWkt(&wkt);
+    std::string result(wkt ? wkt : "");
+    CPLFree(wkt);
+    return result;
+}
+
+// Transformation objects are expensive to construct - PROJ has to
+// analyze the CRS pair and build a pipeline - but they can't be used
+// concurrently, so retired objects are pooled by WKT pair and handed
+// back out to later SrsTransform instances instead of being rebuilt.
+// Intentionally leaked so that transforms released during static
+// destruction have somewhere to go.
+struct TransformPool
+{
+    std::mutex mutex;
+    std::map<std::pair<std::string, std::string>,
+        std::vector<std::unique_ptr<OGRCoordinateTransformation>>> entries;
+
+    static TransformPool& get()
+    {
+        static TransformPool *pool = new TransformPool;
+        return *pool;
+    }
+
+    std::unique_ptr<OGRCoordinateTransformation> fetch(
+        const std::pair<std::string, std::string>& key)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = entries.find(key);
+        if (it == entries.end() || it->second.empty())
+            return nullptr;
+        auto transform = std::move(it->second.back());
+        it->second.pop_back();
+        return transform;
+    }
+
+    void put(const std::pair<std::string, std::string>& key,
+        std::unique_ptr<OGRCoordinateTransformation> transform)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        entries[key].push_back(std::move(transform));
+    }
+};
+
+} // unnamed namespace
+
 SrsTransform::SrsTransform()
 {}
 
@@ -45,20 +104,43 @@ SrsTransform::SrsTransform(const SrsTransform& src)
 }    
 
 
-SrsTransform::SrsTransform(SrsTransform&& src) : m_transform(std::move(src.m_transform))
-{}
+SrsTransform::SrsTransform(SrsTransform&& src) :
+    m_transform(std::move(src.m_transform)), m_key(std::move(src.m_key)),
+    m_fast(src.m_fast)
+{
+    std::copy(std::begin(src.m_aff), std::end(src.m_aff), std::begin(m_aff));
+    src.m_key = {};
+    src.m_fast = false;
+}
 
 
 SrsTransform::~SrsTransform()
-{}
+{
+    release();
+}
 
 
 SrsTransform& SrsTransform::operator=(SrsTransform&& src)
 {
+    release();
     m_transform = std::move(src.m_transform);
+    m_key = std::move(src.m_key);
+    m_fast = src.m_fast;
+    std::copy(std::begin(src.m_aff), std::end(src.m_aff), std::begin(m_aff));
+    src.m_key = {};
+    src.m_fast = false;
     return *this;
 }
 
+
+void SrsTransform::release()
+{
+    if (m_transform && m_key.first.size())
+        TransformPool::get().put(m_key, std::move(m_transform));
+    m_transform.reset();
+    m_fast = false;
+}
+
 SrsTransform::SrsTransform(const SpatialReference& src, const SpatialReference& dst)
 {
     set(src, dst);
@@ -92,6 +174,7 @@ SrsTransform::SrsTransform(const SpatialReference& src,
     if (dstOrder.size())
         dstRef.SetDataAxisToSRSAxisMapping(dstOrder);
     m_transform.reset(OGRCreateCoordinateTransformation(&srcRef, &dstRef));
+    checkFast();
 }
 
 void SrsTransform::set(const SpatialReference& src, const SpatialReference& dst)
@@ -112,7 +195,78 @@ void SrsTransform::set(OGRSpatialReference src, OGRSpatialReference dst)
 //
     src.SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
     dst.SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
-    m_transform.reset(OGRCreateCoordinateTransformation(&src, &dst));
+
+    release();
+    m_key = { exportWkt(src), exportWkt(dst) };
+    m_transform = TransformPool::get().fetch(m_key);
+    if (!m_transform)
+        m_transform.reset(OGRCreateCoordinateTransformation(&src, &dst));
+    checkFast();
+}
+
+
+// Fit an affine matrix to the transformation from probe points and keep
+// it if it reproduces the transformation at distant check points.  That
+// catches identity transforms and same-datum transforms that only
+// rescale units, shift offsets or shuffle axes - the per-point work then
+// stays out of PROJ entirely.  Anything involving an actual datum shift
+// or projection change deviates at the check points by far more than
+// the tolerance and keeps the full transformation.
+void SrsTransform::checkFast()
+{
+    m_fast = false;
+    if (!m_transform)
+        return;
+
+    OGRSpatialReference *src = m_transform->GetSourceCS();
+    OGRSpatialReference *dst = m_transform->GetTargetCS();
+    if (!src || !dst)
+        return;
+
+    // Only consider CRS pairs on the same datum - anything else can't
+    // be affine in projected or geographic coordinates.
+    if (!src->IsSame(dst) && !(src->IsSameGeogCS(dst) &&
+            src->IsProjected() && dst->IsProjected()))
+        return;
+
+    // Transform the origin and unit offsets along each axis to fit the
+    // matrix, then verify it at distant points - distant in the source
+    // units, so degrees probe a much smaller range than meters.
+    double big = src->IsProjected() ? 100000.0 : 10.0;
+    double px[6] { 0, 1, 0, 0, big, -3 * big };
+    double py[6] { 0, 0, 1, 0, -2 * big, 1.5 * big };
+    double pz[6] { 0, 0, 0, 1, 100, -50 };
+    double vx[2] { px[4], px[5] };
+    double vy[2] { py[4], py[5] };
+    double vz[2] { pz[4], pz[5] };
+    if (!m_transform->Transform(6, px, py, pz))
+        return;
+
+    double *aff = m_aff;
+    for (int row = 0; row < 3; ++row)
+    {
+        double *p = (row == 0 ? px : (row == 1 ? py : pz));
+        aff[0] = p[1] - p[0];
+        aff[1] = p[2] - p[0];
+        aff[2] = p[3] - p[0];
+        aff[3] = p[0];
+        aff += 4;
+    }
+
+    for (int i = 0; i < 2; ++i)
+    {
+        double ex = m_aff[0] * vx[i] + m_aff[1] * vy[i] + m_aff[2] * vz[i] +
+            m_aff[3];
+        double ey = m_aff[4] * vx[i] + m_aff[5] * vy[i] + m_aff[6] * vz[i] +
+            m_aff[7];
+        double ez = m_aff[8] * vx[i] + m_aff[9] * vy[i] + m_aff[10] * vz[i] +
+            m_aff[11];
+        if (std::abs(ex - px[4 + i]) > 1e-7 * (std::abs(px[4 + i]) + 1) ||
+            std::abs(ey - py[4 + i]) > 1e-7 * (std::abs(py[4 + i]) + 1) ||
+            std::abs(ez - pz[4 + i]) > 1e-7 * (std::abs(pz[4 + i]) + 1))
+            return;
+    }
+    m_fast = true;
 }
 
 
@@ -124,6 +278,16 @@ OGRCoordinateTransformation *SrsTransform::get() const
 
 bool SrsTransform::transform(double& x, double& y, double& z) const
 {
+    if (m_fast)
+    {
+        double nx = m_aff[0] * x + m_aff[1] * y + m_aff[2] * z + m_aff[3];
+        double ny = m_aff[4] * x + m_aff[5] * y + m_aff[6] * z + m_aff[7];
+        double nz = m_aff[8] * x + m_aff[9] * y + m_aff[10] * z + m_aff[11];
+        x = nx;
+        y = ny;
+        z = nz;
+        return true;
+    }
     return m_transform && m_transform->Transform(1, &x, &y, &z);
 }
 
@@ -134,8 +298,36 @@ bool SrsTransform::transform(std::vector<double>& x, std::vector<double>& y,
     if (x.size() != y.size() && y.size() != z.size())
         throw pdal_error("SrsTransform::called with vectors of different "
             "sizes.");
+    if (m_fast)
+    {
+        for (std::size_t i = 0; i < x.size(); ++i)
+            transform(x[i], y[i], z[i]);
+        return true;
+    }
     int err = m_transform->Transform(x.size(), x.data(), y.data(), z.data());
     return (err == OGRERR_NONE);
 }
 
+
+bool SrsTransform::transform(std::size_t count, double *x, double *y,
+    double *z, int *ok) const
+{
+    if (m_fast)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            transform(x[i], y[i], z[i]);
+        std::fill(ok, ok + count, 1);
+        return true;
+    }
+    if (!m_transform)
+    {
+        std::fill(ok, ok + count, 0);
+        return false;
+    }
+
+    // Transform() returns TRUE only if all points succeeded; per-point
+    // status lands in 'ok'.
+    return m_transform->Transform((int)count, x, y, z, ok) != 0;
+}
+
 } // namespace pdal
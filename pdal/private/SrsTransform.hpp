@@ -29,6 +29,9 @@
  ****************************************************************************/
 #pragma once
 
+#include <string>
+#include <utility>
+
 #include <pdal/pdal_internal.hpp>
 
 class OGRCoordinateTransformation;
@@ -76,13 +79,34 @@ public:
     bool transform(std::vector<double>& x, std::vector<double>& y,
         std::vector<double>& z) const;
 
+    /// Transform a batch of points in place with per-point status.
+    /// \param count  Number of points.
+    /// \param x  X coordinates
+    /// \param y  Y coordinates
+    /// \param z  Z coordinates
+    /// \param ok  Array of \c count entries set nonzero for each point
+    ///   transformed successfully.
+    /// \return  True if all points were transformed successfully
+    bool transform(std::size_t count, double *x, double *y, double *z,
+        int *ok) const;
+
     /// Determine if this represents a valid transform.
     /// \return  Whether the transform is valid or not.
     bool valid() const
     { return (bool)m_transform.get(); }
 
 private:
+    // Probe the transformation and capture it as an inline affine matrix
+    // when it is one (identity, or unit/offset/axis changes on the same
+    // datum), so per-point work avoids PROJ entirely.
+    void checkFast();
+    // Hand the transformation object back to the process-wide pool.
+    void release();
+
     std::unique_ptr<OGRCoordinateTransformation> m_transform;
+    std::pair<std::string, std::string> m_key;
+    bool m_fast = false;
+    double m_aff[12];
 };
 
 } // namespace pdal
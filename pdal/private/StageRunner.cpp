@@ -62,9 +62,11 @@ void StageRunner::run()
 
     if (m_stage->mergeMode() == Filter::WhereMergeMode::True)
     {
+        // The skips view is dead after the merge, so its index can be
+        // stolen rather than copied.
         if (m_viewSet.size())
-            (*m_viewSet.begin())->append(*m_skips);
-                return;
+            (*m_viewSet.begin())->append(std::move(*m_skips));
+        return;
     }
     else if (m_stage->mergeMode() == Filter::WhereMergeMode::Auto)
     {
@@ -73,7 +75,7 @@ void StageRunner::run()
             PointViewPtr keeps = *m_viewSet.begin();
             if (keeps.get() == m_keeps.get() && keepSize == keeps->size())
             {
-                keeps->append(*m_skips);
+                keeps->append(std::move(*m_skips));
                 return;
             }
         }
@@ -0,0 +1,173 @@
+/******************************************************************************
+* Copyright (c) 2026, Hobu Inc.
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+*       names of its contributors may be used to endorse or promote
+*       products derived from this software without specific prior
+*       written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#include "DatasetPool.hpp"
+#include "GDALUtils.hpp"
+#include "Raster.hpp"
+
+#include <pdal/util/FileUtils.hpp>
+
+#include <ogr_api.h>
+
+namespace pdal
+{
+namespace gdal
+{
+
+DatasetPool::DatasetPool()
+{}
+
+
+DatasetPool::~DatasetPool()
+{}
+
+
+DatasetPool& DatasetPool::instance()
+{
+    // Deliberately leaked so that handles released during static
+    // destruction don't touch a destroyed pool.  The OS reclaims the
+    // handles at process exit.
+    static DatasetPool *pool = new DatasetPool;
+    return *pool;
+}
+
+
+DatasetPool::Stamp DatasetPool::stamp(const std::string& path)
+{
+    Stamp s;
+
+    // Remote and VSI paths aren't validated - their handles are reused
+    // as-is.
+    if (!FileUtils::fileExists(path))
+        return s;
+
+    struct tm mod;
+    FileUtils::fileTimes(path, nullptr, &mod);
+#ifdef _WIN32
+    s.m_mtime = _mkgmtime(&mod);
+#else
+    s.m_mtime = timegm(&mod);
+#endif
+    s.m_size = FileUtils::fileSize(path);
+    s.m_valid = true;
+    return s;
+}
+
+
+std::shared_ptr<Raster> DatasetPool::raster(const std::string& filename,
+    const std::string& drivername)
+{
+    std::string key = filename + "\n" + drivername;
+
+    Raster *raster = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto& idle = m_rasters[key];
+        Stamp current = stamp(filename);
+        while (idle.size() && !raster)
+        {
+            IdleRaster ir = std::move(idle.back());
+            idle.pop_back();
+            // Stale handles close when 'ir' goes out of scope.
+            if (ir.m_stamp.changed(current))
+                continue;
+            raster = ir.m_raster.release();
+        }
+    }
+    if (!raster)
+        raster = new Raster(filename, drivername);
+
+    return std::shared_ptr<Raster>(raster,
+        [this, key, filename](Raster *r)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            IdleRaster ir;
+            ir.m_raster.reset(r);
+            ir.m_stamp = stamp(filename);
+            m_rasters[key].push_back(std::move(ir));
+        });
+}
+
+
+std::shared_ptr<void> DatasetPool::vector(const std::string& datasource)
+{
+    void *handle = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto& idle = m_vectors[datasource];
+        Stamp current = stamp(datasource);
+        while (idle.size() && !handle)
+        {
+            IdleVector iv = idle.back();
+            idle.pop_back();
+            if (iv.m_stamp.changed(current))
+            {
+                ::OGR_DS_Destroy(iv.m_handle);
+                continue;
+            }
+            handle = iv.m_handle;
+        }
+    }
+    if (!handle)
+    {
+        registerDrivers();
+        handle = OGROpen(datasource.c_str(), 0, 0);
+        if (!handle)
+            return std::shared_ptr<void>();
+    }
+
+    return std::shared_ptr<void>(handle,
+        [this, datasource](void *h)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            IdleVector iv;
+            iv.m_handle = h;
+            iv.m_stamp = stamp(datasource);
+            m_vectors[datasource].push_back(iv);
+        });
+}
+
+
+void DatasetPool::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_rasters.clear();
+    for (auto& kv : m_vectors)
+        for (IdleVector& iv : kv.second)
+            ::OGR_DS_Destroy(iv.m_handle);
+    m_vectors.clear();
+}
+
+} // namespace gdal
+} // namespace pdal
@@ -0,0 +1,138 @@
+/******************************************************************************
+* Copyright (c) 2026, Hobu Inc.
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+*       names of its contributors may be used to endorse or promote
+*       products derived from this software without specific prior
+*       written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <ctime>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <pdal/pdal_internal.hpp>
+
+namespace pdal
+{
+namespace gdal
+{
+
+class Raster;
+
+/**
+  Process-wide pool of open dataset handles, keyed by path and driver.
+  Stages that read the same source check a handle out of the pool instead
+  of opening their own, so a pipeline that touches one DEM in several
+  stages - or a pipeline executed repeatedly in the same process - pays
+  GDAL's open/SRS/overview setup cost once.
+
+  Checkout is exclusive: a handle is used by one stage at a time and
+  returns to the pool when the last reference to it is released, staying
+  open for the next checkout.  Concurrent requests for the same source
+  are satisfied with additional handles.  Idle handles for local files
+  are discarded when the file's size or modification time has changed
+  since the handle was returned.
+*/
+class PDAL_DLL DatasetPool
+{
+public:
+    static DatasetPool& instance();
+
+    /**
+      Check out a raster for the given file.  The raster is returned
+      unopened on first checkout - callers open it as they would a
+      raster of their own - and stays open across checkouts afterwards.
+
+      \param filename  Filename of raster file.
+      \param drivername  Optional name of driver to use to open the file.
+      \return  Raster handle; returns to the pool on release.
+    */
+    std::shared_ptr<Raster> raster(const std::string& filename,
+        const std::string& drivername = "");
+
+    /**
+      Check out an open OGR datasource handle (OGROpen semantics).
+
+      \param datasource  OGR-readable datasource path.
+      \return  Datasource handle, or a null pointer if the source can't
+        be opened.  Returns to the pool on release.
+    */
+    std::shared_ptr<void> vector(const std::string& datasource);
+
+    /**
+      Close all idle handles.  Handles currently checked out are
+      unaffected.
+    */
+    void clear();
+
+private:
+    // Out-of-line so includers don't need a complete Raster type.
+    DatasetPool();
+    ~DatasetPool();
+
+    struct Stamp
+    {
+        uintmax_t m_size = 0;
+        std::time_t m_mtime = 0;
+        bool m_valid = false;
+
+        bool changed(const Stamp& other) const
+        {
+            return m_valid && other.m_valid &&
+                (m_size != other.m_size || m_mtime != other.m_mtime);
+        }
+    };
+
+    struct IdleRaster
+    {
+        std::unique_ptr<Raster> m_raster;
+        Stamp m_stamp;
+    };
+
+    struct IdleVector
+    {
+        void *m_handle = nullptr;
+        Stamp m_stamp;
+    };
+
+    static Stamp stamp(const std::string& path);
+
+    std::mutex m_mutex;
+    std::map<std::string, std::vector<IdleRaster>> m_rasters;
+    std::map<std::string, std::vector<IdleVector>> m_vectors;
+};
+
+} // namespace gdal
+} // namespace pdal
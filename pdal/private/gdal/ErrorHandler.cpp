@@ -53,6 +53,8 @@ ErrorHandler& ErrorHandler::getGlobalErrorHandler()
     return s_gdalErrorHandler;
 }
 
+thread_local int ErrorHandler::m_errorNum(0);
+
 namespace {
 
 //ABELL - No idea why this is __stdcall
@@ -70,7 +72,7 @@ void trampoline(::CPLErr code, int num, char const* msg)
 /**
   Constructor for a GDAL error handler.
 */
-ErrorHandler::ErrorHandler() : m_errorNum(0), m_prevHandler(nullptr)
+ErrorHandler::ErrorHandler() : m_prevHandler(nullptr)
 {
     std::string value;
 
@@ -140,12 +142,12 @@ void ErrorHandler::setDebug(bool debug)
 
 
 /**
-  Get the number of the last GDAL error.
+  Get the number of the last GDAL error raised on the calling thread.
   \return  Last GDAL error number.
 */
 int ErrorHandler::errorNum()
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    // Thread-local, so no lock.
     return m_errorNum;
 }
 
@@ -157,10 +159,14 @@ int ErrorHandler::errorNum()
 */
 void ErrorHandler::handle(int level, int num, char const* msg)
 {
+    // GDAL calls the handler on the thread that raised the error, so
+    // the error number lands in that thread's slot before we take the
+    // lock protecting the shared log.
+    m_errorNum = num;
+
     std::lock_guard<std::mutex> lock(m_mutex);
     std::ostringstream oss;
 
-    m_errorNum = num;
     if (level == CE_Failure || level == CE_Fatal)
     {
         oss << "GDAL failure (" << num << ") " << msg;
@@ -47,7 +47,10 @@ namespace gdal
 // were taking advantage of GDAL's thread-specific error handing.
 //
 // We lock the log/debug so that it doesn't
-// get changed while another thread is using or setting.
+// get changed while another thread is using or setting.  The last error
+// number is thread-local - GDAL invokes the handler on the thread that
+// raised the error - so threads doing geometry or raster work in
+// parallel see their own errors rather than each other's.
 class PDAL_DLL ErrorHandler
 {
 public:
@@ -93,7 +96,7 @@ public:
     void setDebug(bool doDebug);
 
     /**
-      Get the last error and clear the error last error value.
+      Get the last error raised on the calling thread.
 
       \return  The last error number.
     */
@@ -108,7 +111,7 @@ private:
     std::mutex m_mutex;
     bool m_debug;
     pdal::LogPtr m_log;
-    mutable int m_errorNum;
+    static thread_local int m_errorNum;
     bool m_cplSet;
     CPLErrorHandler m_prevHandler;
 };
@@ -551,6 +551,140 @@ GDALError Raster::read(double x, double y, std::vector<double>& data)
 }
 
 
+/**
+  Get the number of the cache tile covering a position.
+  \param x  X position.
+  \param y  Y position.
+  \param[out] num  Number of the covering tile.
+  \return  Whether the position is in the raster.
+*/
+bool Raster::tileNum(double x, double y, uint64_t& num)
+{
+    int32_t pixel(0);
+    int32_t line(0);
+
+    if (!getPixelAndLinePosition(x, y, pixel, line))
+        return false;
+    num = ((uint64_t)(line / TileSize) << 32) | (uint64_t)(pixel / TileSize);
+    return true;
+}
+
+
+/**
+  Read a tile's worth of data for all bands into band-interleaved form.
+  Tiles at the X and Y margins are clipped to the raster.
+  \param num  Tile number.
+  \param[out] tile  Tile into which the data should be read.
+  \return  Error code or GDALError::None.
+*/
+GDALError Raster::readTile(uint64_t num, Tile& tile)
+{
+    int32_t x0 = (int32_t)(num & 0xffffffff) * TileSize;
+    int32_t y0 = (int32_t)(num >> 32) * TileSize;
+    int32_t w = (std::min)(TileSize, m_width - x0);
+    int32_t h = (std::min)(TileSize, m_height - y0);
+
+    return readWindow(x0, y0, w, h, tile.m_data);
+}
+
+
+/**
+  Read a window of cells for all bands into band-interleaved form.
+  \param x  Raster (pixel) X position of the window origin.
+  \param y  Raster (line) Y position of the window origin.
+  \param width  Width of the window in cells.
+  \param height  Height of the window in cells.
+  \param[out] data  Vector into which the data should be read.
+  \return  Error code or GDALError::None.
+*/
+GDALError Raster::readWindow(int x, int y, int width, int height,
+    std::vector<double>& data)
+{
+    if (!m_ds)
+    {
+        m_errorMsg = "Raster not open.";
+        return GDALError::NotOpen;
+    }
+
+    data.resize((size_t)width * height * m_numBands);
+    for (int i = 0; i < m_numBands; ++i)
+    {
+        GDALRasterBandH b = GDALGetRasterBand(m_ds, i + 1);
+        if (GDALRasterIO(b, GF_Read, x, y, width, height, data.data() + i,
+            width, height, GDT_Float64, (int)(m_numBands * sizeof(double)),
+            (int)(m_numBands * sizeof(double) * width)) != CE_None)
+        {
+            m_errorMsg = "Unable to read window for raster '" +
+                m_filename + "'.";
+            return GDALError::CantReadBlock;
+        }
+    }
+    return GDALError::None;
+}
+
+
+/**
+  Fetch the raster data associated with the point at a position through
+  the tile cache.  The tile covering the position is read on first use
+  and the least recently used tile is evicted when the cache is full.
+  \param x  X position of point to fetch raster data for.
+  \param y  Y position of point to fetch raster data for.
+  \param[out] data  Vector of raster data associated with the provided point.
+  \return  Error code or GDALError::None.
+*/
+GDALError Raster::readCached(double x, double y, std::vector<double>& data)
+{
+    if (!m_ds)
+    {
+        m_errorMsg = "Raster not open.";
+        return GDALError::NotOpen;
+    }
+
+    int32_t pixel(0);
+    int32_t line(0);
+
+    // No data at this x,y if we can't compute a pixel/line location
+    // for it.
+    if (!getPixelAndLinePosition(x, y, pixel, line))
+    {
+        m_errorMsg = "Requested location is not in the raster.";
+        return GDALError::NoData;
+    }
+
+    uint64_t num = ((uint64_t)(line / TileSize) << 32) |
+        (uint64_t)(pixel / TileSize);
+    auto it = m_tiles.find(num);
+    if (it == m_tiles.end())
+    {
+        if (m_tiles.size() >= MaxTiles)
+        {
+            m_tiles.erase(m_tileLru.back());
+            m_tileLru.pop_back();
+        }
+        it = m_tiles.insert({num, Tile()}).first;
+        GDALError error = readTile(num, it->second);
+        if (error != GDALError::None)
+        {
+            m_tiles.erase(it);
+            return error;
+        }
+        m_tileLru.push_front(num);
+        it->second.m_lruPos = m_tileLru.begin();
+    }
+    else if (it->second.m_lruPos != m_tileLru.begin())
+        m_tileLru.splice(m_tileLru.begin(), m_tileLru, it->second.m_lruPos);
+
+    const Tile& tile = it->second;
+    int32_t w = (std::min)(TileSize, m_width - (pixel / TileSize) * TileSize);
+    size_t pos = ((size_t)(line % TileSize) * w + (pixel % TileSize)) *
+        m_numBands;
+    data.resize(m_numBands);
+    std::copy(tile.m_data.begin() + pos, tile.m_data.begin() + pos + m_numBands,
+        data.begin());
+    return GDALError::None;
+}
+
+
 /**
   Get the spatial reference associated with a raster.
   \return  Associated spatial reference.
@@ -582,6 +716,8 @@ void Raster::close()
     GDALClose(m_ds);
     m_ds = nullptr;
     m_types.clear();
+    m_tiles.clear();
+    m_tileLru.clear();
 }
 
 
@@ -35,6 +35,8 @@
 #pragma once
 
 #include <array>
+#include <list>
+#include <map>
 
 #include <pdal/DimUtil.hpp>
 #include <pdal/pdal_types.hpp>
@@ -469,6 +471,43 @@ public:
     */
     GDALError read(double x, double y, std::vector<double>& data);
 
+    /**
+      Read the data for each band at x/y into a vector of doubles, fetching
+      raster data a tile at a time through an LRU tile cache.  Nearby
+      positions hit the same cached tile, avoiding a GDAL I/O round trip
+      per position.
+
+      \param x  X position to read
+      \param y  Y position to read
+      \param data  Vector in which to store data.
+    */
+    GDALError readCached(double x, double y, std::vector<double>& data);
+
+    /**
+      Read a window of cells for all bands into band-interleaved form.
+      One GDAL read is issued per band for the whole window.
+
+      \param x  Raster (pixel) X position of the window origin.
+      \param y  Raster (line) Y position of the window origin.
+      \param width  Width of the window in cells.
+      \param height  Height of the window in cells.
+      \param[out] data  Vector into which the data should be read.  The
+        vector is resized as necessary.
+    */
+    GDALError readWindow(int x, int y, int width, int height,
+        std::vector<double>& data);
+
+    /**
+      Get the number of the cache tile covering a position.  Batching
+      readCached() lookups in tile order maximizes cache hits.
+
+      \param x  X position
+      \param y  Y position
+      \param[out] num  Number of the covering tile.
+      \return  Whether the position is in the raster.
+    */
+    bool tileNum(double x, double y, uint64_t& num);
+
     /**
       Get a vector of dimensions that map to the bands of a raster.
     */
@@ -529,6 +568,17 @@ public:
     BOX3D bounds(int nBand) const;
 
 private:
+    struct Tile
+    {
+        std::vector<double> m_data;  /// Band-interleaved pixel data.
+        std::list<uint64_t>::iterator m_lruPos;  /// Position in LRU list.
+    };
+
+    // Tiles are TileSize x TileSize pixels.  The cache holds at most
+    // MaxTiles of them -- about 200MB of doubles for a 3-band raster.
+    static const int32_t TileSize = 128;
+    static const size_t MaxTiles = 512;
+
     std::string m_filename;
 
     int m_width;
@@ -547,7 +597,10 @@ private:
     mutable std::string m_errorMsg;
     mutable std::vector<pdal::Dimension::Type> m_types;
     std::vector<std::array<double, 2>> m_block_sizes;
+    std::map<uint64_t, Tile> m_tiles;  /// Cached tiles by tile number.
+    std::list<uint64_t> m_tileLru;     /// Most recently used tile at front.
 
+    GDALError readTile(uint64_t num, Tile& tile);
     GDALError validateType(Dimension::Type& type, GDALDriver *driver);
     bool getPixelAndLinePosition(double x, double y,
         int32_t& pixel, int32_t& line);
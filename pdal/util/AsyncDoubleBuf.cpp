@@ -0,0 +1,185 @@
+/******************************************************************************
+* Copyright (c) 2021, Hobu Inc.
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+*       names of its contributors may be used to endorse or promote
+*       products derived from this software without specific prior
+*       written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#include <algorithm>
+#include <cstring>
+
+#include "AsyncDoubleBuf.hpp"
+
+namespace pdal
+{
+
+AsyncDoubleBuf::AsyncDoubleBuf(std::ostream& out, size_t bufSize) :
+    m_out(out), m_bufSize((std::max)(bufSize, (size_t)1)), m_cur(0),
+    m_pendingData(nullptr), m_pendingSize(0), m_stop(false), m_failed(false)
+{
+    m_bufs[0].resize(m_bufSize);
+    m_bufs[1].resize(m_bufSize);
+    setp(m_bufs[0].data(), m_bufs[0].data() + m_bufSize);
+    m_writer = std::thread([this](){ writerLoop(); });
+}
+
+
+AsyncDoubleBuf::~AsyncDoubleBuf()
+{
+    drain();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    m_writer.join();
+}
+
+
+void AsyncDoubleBuf::writerLoop()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_cv.wait(lock, [this](){ return m_pendingData || m_stop; });
+        if (m_pendingData)
+        {
+            char *data = m_pendingData;
+            size_t size = m_pendingSize;
+            lock.unlock();
+            m_out.write(data, size);
+            lock.lock();
+            if (!m_out)
+                m_failed = true;
+            m_pendingData = nullptr;
+            m_pendingSize = 0;
+            m_cv.notify_all();
+        }
+        else if (m_stop)
+            break;
+    }
+}
+
+
+bool AsyncDoubleBuf::swapBuffers()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    // Wait for any write of the other buffer to finish.
+    m_cv.wait(lock, [this](){ return !m_pendingData; });
+    if (m_failed)
+        return false;
+    m_pendingData = pbase();
+    m_pendingSize = pptr() - pbase();
+    m_cur ^= 1;
+    setp(m_bufs[m_cur].data(), m_bufs[m_cur].data() + m_bufSize);
+    lock.unlock();
+    m_cv.notify_all();
+    return true;
+}
+
+
+bool AsyncDoubleBuf::drain()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cv.wait(lock, [this](){ return !m_pendingData; });
+    // Write out the current partial buffer directly -- the writer thread
+    // is idle and nothing can be gained by handing it off.
+    if (pptr() != pbase())
+    {
+        m_out.write(pbase(), pptr() - pbase());
+        if (!m_out)
+            m_failed = true;
+        setp(m_bufs[m_cur].data(), m_bufs[m_cur].data() + m_bufSize);
+    }
+    return !m_failed;
+}
+
+
+AsyncDoubleBuf::int_type AsyncDoubleBuf::overflow(int_type c)
+{
+    if (!swapBuffers())
+        return traits_type::eof();
+    if (c != traits_type::eof())
+    {
+        *pptr() = traits_type::to_char_type(c);
+        pbump(1);
+    }
+    return traits_type::not_eof(c);
+}
+
+
+std::streamsize AsyncDoubleBuf::xsputn(const char *s, std::streamsize count)
+{
+    std::streamsize written = 0;
+    while (written < count)
+    {
+        std::streamsize room = epptr() - pptr();
+        if (!room)
+        {
+            if (!swapBuffers())
+                break;
+            room = epptr() - pptr();
+        }
+        std::streamsize amt = (std::min)(room, count - written);
+        std::memcpy(pptr(), s + written, amt);
+        pbump((int)amt);
+        written += amt;
+    }
+    return written;
+}
+
+
+int AsyncDoubleBuf::sync()
+{
+    if (!drain())
+        return -1;
+    m_out.flush();
+    return m_out ? 0 : -1;
+}
+
+
+AsyncDoubleBuf::pos_type AsyncDoubleBuf::seekpos(pos_type pos,
+    std::ios_base::openmode which)
+{
+    if (!drain())
+        return pos_type(off_type(-1));
+    return m_out.rdbuf()->pubseekpos(pos, which);
+}
+
+
+AsyncDoubleBuf::pos_type AsyncDoubleBuf::seekoff(off_type off,
+    std::ios_base::seekdir dir, std::ios_base::openmode which)
+{
+    if (!drain())
+        return pos_type(off_type(-1));
+    return m_out.rdbuf()->pubseekoff(off, dir, which);
+}
+
+} // namespace pdal
@@ -0,0 +1,101 @@
+/******************************************************************************
+* Copyright (c) 2021, Hobu Inc.
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+*       names of its contributors may be used to endorse or promote
+*       products derived from this software without specific prior
+*       written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <thread>
+#include <vector>
+
+#include "pdal_util_export.hpp"
+
+namespace pdal
+{
+
+/**
+  A double-buffered streambuf that flushes to an underlying stream on a
+  background thread.  Output fills one buffer while the previously filled
+  buffer is being written, so a writer isn't stalled by the latency of the
+  underlying device.  Seeks and explicit flushes drain pending output
+  first, keeping stream positions consistent with a plain buffer.
+*/
+class AsyncDoubleBuf : public std::streambuf
+{
+public:
+    /**
+      Construct an AsyncDoubleBuf that writes to a stream.
+
+      \param out  Stream to which buffered output is written.
+      \param bufSize  Size of each of the two buffers.
+    */
+    PDAL_DLL AsyncDoubleBuf(std::ostream& out, size_t bufSize = 1 << 20);
+
+    /**
+      Flush pending output and stop the writer thread.
+    */
+    PDAL_DLL ~AsyncDoubleBuf();
+
+protected:
+    virtual int_type overflow(int_type c);
+    virtual std::streamsize xsputn(const char *s, std::streamsize count);
+    virtual int sync();
+    virtual pos_type seekpos(pos_type pos, std::ios_base::openmode which);
+    virtual pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+        std::ios_base::openmode which);
+
+private:
+    // Hand the filled buffer to the writer thread and make the other
+    // buffer current, waiting for its previous write to complete.
+    bool swapBuffers();
+    // Synchronously write buffered output, leaving nothing pending.
+    bool drain();
+    void writerLoop();
+
+    std::ostream& m_out;
+    size_t m_bufSize;
+    std::vector<char> m_bufs[2];
+    int m_cur;
+    char *m_pendingData;
+    size_t m_pendingSize;
+    bool m_stop;
+    bool m_failed;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::thread m_writer;
+};
+
+} // namespace pdal
@@ -107,6 +107,32 @@ BOX2D& BOX2D::grow(double x, double y)
     return *this;
 }
 
+BOX2D& BOX2D::grow(const double *x, const double *y, size_t count)
+{
+    // Accumulate into locals in simple per-coordinate loops so the
+    // compiler can use SIMD min/max.
+    double mnx = minx;
+    double mxx = maxx;
+    for (size_t i = 0; i < count; ++i)
+    {
+        mnx = (std::min)(mnx, x[i]);
+        mxx = (std::max)(mxx, x[i]);
+    }
+    minx = mnx;
+    maxx = mxx;
+
+    double mny = miny;
+    double mxy = maxy;
+    for (size_t i = 0; i < count; ++i)
+    {
+        mny = (std::min)(mny, y[i]);
+        mxy = (std::max)(mxy, y[i]);
+    }
+    miny = mny;
+    maxy = mxy;
+    return *this;
+}
+
 BOX3D& BOX3D::grow(double x, double y, double z)
 {
     BOX2D::grow(x, y);
@@ -115,6 +141,23 @@ BOX3D& BOX3D::grow(double x, double y, double z)
     return *this;
 }
 
+BOX3D& BOX3D::grow(const double *x, const double *y, const double *z,
+    size_t count)
+{
+    BOX2D::grow(x, y, count);
+
+    double mnz = minz;
+    double mxz = maxz;
+    for (size_t i = 0; i < count; ++i)
+    {
+        mnz = (std::min)(mnz, z[i]);
+        mxz = (std::max)(mxz, z[i]);
+    }
+    minz = mnz;
+    maxz = mxz;
+    return *this;
+}
+
 const BOX2D& BOX2D::getDefaultSpatialExtent()
 {
     static BOX2D v(LOWEST, LOWEST, HIGHEST, HIGHEST);
@@ -106,6 +106,18 @@ public:
     */
     BOX2D& grow(double x, double y);
 
+    /**
+      Expand the bounds of the box to include a batch of points.  The
+      minimum/maximum of each coordinate array is computed in a plain
+      loop that the compiler can vectorize, which is much faster than
+      growing point by point.
+
+      \param x  Array of X point locations.
+      \param y  Array of Y point locations.
+      \param count  Number of locations in each array.
+    */
+    BOX2D& grow(const double *x, const double *y, size_t count);
+
     /**
       Expand the bounds of the box in all directions by a specified amount.
 
@@ -380,6 +392,20 @@ public:
     */
     BOX3D& grow(double x, double y, double z);
 
+    /**
+      Expand the bounds of the box to include a batch of points.  The
+      minimum/maximum of each coordinate array is computed in a plain
+      loop that the compiler can vectorize, which is much faster than
+      growing point by point.
+
+      \param x  Array of X dimension values.
+      \param y  Array of Y dimension values.
+      \param z  Array of Z dimension values.
+      \param count  Number of values in each array.
+    */
+    BOX3D& grow(const double *x, const double *y, const double *z,
+        size_t count);
+
     /**
       Clear the bounds box to an empty state.
     */
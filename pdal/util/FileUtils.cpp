@@ -40,6 +40,7 @@
 #ifndef _WIN32
 #include <glob.h>
 #include <sys/mman.h>
+#include <unistd.h>
 #else
 #include <io.h>
 #include <codecvt>
@@ -474,12 +475,6 @@ MapContext mapFile(const std::string& filename, bool readOnly, uintmax_t pos, ui
 {
     MapContext ctx;
 
-    if (!readOnly)
-    {
-        ctx.m_error = "readOnly must be true.";
-        return ctx;
-    }
-
     if (size == 0)
     {
         size = FileUtils::fileSize(filename);
@@ -504,19 +499,34 @@ MapContext mapFile(const std::string& filename, bool readOnly, uintmax_t pos, ui
     ctx.m_size = size;
 
 #ifndef _WIN32
-    ctx.m_addr = ::mmap(0, size, PROT_READ, MAP_SHARED, ctx.m_fd, (off_t)pos);
+    // Writable mappings can't grow a file on their own, so extend it if
+    // the requested range runs past EOF.
+    if (!readOnly && pos + size > fileSize(filename) &&
+        ::ftruncate(ctx.m_fd, (off_t)(pos + size)) == -1)
+    {
+        ::close(ctx.m_fd);
+        ctx.m_fd = -1;
+        ctx.m_error = "Couldn't extend file for writable mapping.";
+        return ctx;
+    }
+    ctx.m_addr = ::mmap(0, size, readOnly ? PROT_READ : PROT_READ | PROT_WRITE,
+        MAP_SHARED, ctx.m_fd, (off_t)pos);
     if (ctx.m_addr == MAP_FAILED)
     {
         ctx.m_addr = nullptr;
         ctx.m_error = "Couldn't map file";
     }
 #else
+    // For a writable mapping, passing the end of the requested range as
+    // the mapping size extends the file as necessary.
+    uint64_t end = readOnly ? 0 : pos + size;
     ctx.m_handle = CreateFileMapping((HANDLE)_get_osfhandle(ctx.m_fd),
-        NULL, PAGE_READONLY, 0, 0, NULL);
+        NULL, readOnly ? PAGE_READONLY : PAGE_READWRITE,
+        (uint32_t)(end >> 32), (uint32_t)(end & 0xFFFFFFFF), NULL);
     uint32_t low = pos & 0xFFFFFFFF;
     uint32_t high = (uint32_t)(pos >> 8);
-    ctx.m_addr = MapViewOfFile(ctx.m_handle, FILE_MAP_READ, high, low,
-        ctx.m_size);
+    ctx.m_addr = MapViewOfFile(ctx.m_handle,
+        readOnly ? FILE_MAP_READ : FILE_MAP_WRITE, high, low, ctx.m_size);
     if (ctx.m_addr == nullptr)
         ctx.m_error = "Couldn't map file";
 #endif
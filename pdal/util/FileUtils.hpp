@@ -307,7 +307,9 @@ namespace FileUtils
     /**
       Map a file to memory.
       \param filename  Filename to map.
-      \param readOnly  Must be true at this time.
+      \param readOnly  If false, the mapping is writable and shared -
+        stores land in the page cache and the file is extended when the
+        mapped range runs past its end.
       \param pos       Starting position of file to map.
       \param size      Number of bytes in file to map.
       \return  MapContext.  addr() gets the mapped address.  what() gets
@@ -77,6 +77,17 @@ public:
         m_stream(NULL), m_fstream(NULL)
     { open(filename); }
 
+    /**
+      Construct an IStream from a filename, using a stream buffer of
+      the given size.
+
+      \param filename  File from which to read.
+      \param bufSize  Size in bytes of the stream buffer.
+    */
+    PDAL_DLL IStream(const std::string& filename, size_t bufSize) :
+        m_stream(NULL), m_fstream(NULL)
+    { open(filename, bufSize); }
+
     /**
       Construct an IStream from an input stream pointer.
 
@@ -103,6 +114,48 @@ public:
         return 0;
     }
 
+    /**
+      Open a file to extract, replacing the default stream buffer with
+      one of the given size.  A large buffer cuts the number of read
+      syscalls made when extracting small fields, which matters when
+      scanning big files on fast storage.
+
+      \param filename  Filename.
+      \param bufSize  Size in bytes of the stream buffer.  When 0, the
+        implementation's default buffer is kept.
+      \return  -1 if a stream is already assigned, 0 otherwise.
+    */
+    PDAL_DLL int open(const std::string& filename, size_t bufSize)
+    {
+        if (m_stream)
+             return -1;
+        m_fstream = new std::ifstream;
+        if (bufSize)
+        {
+            // The buffer must be installed before the file is opened
+            // in order to take effect.
+            m_buf.resize(bufSize);
+            m_fstream->rdbuf()->pubsetbuf(m_buf.data(),
+                (std::streamsize)m_buf.size());
+        }
+        m_fstream->open(filename,
+            std::ios_base::in | std::ios_base::binary);
+        m_stream = m_fstream;
+        return 0;
+    }
+
+    /**
+      Advise the operating system to start reading a region of a file
+      into its cache in anticipation of sequential access.  Purely a
+      hint -- a no-op on platforms without posix_fadvise().
+
+      \param filename  File about to be read.
+      \param offset  Start of the region that will be read.
+      \param length  Length of the region.  0 means to the end of file.
+    */
+    PDAL_DLL static void readAhead(const std::string& filename,
+        uint64_t offset = 0, uint64_t length = 0);
+
     /**
       Close the underlying stream.
     */
@@ -265,6 +318,7 @@ protected:
 
 private:
     std::stack<std::istream *> m_streams;
+    std::vector<char> m_buf; // Replacement stream buffer, when requested.
 };
 
 /**
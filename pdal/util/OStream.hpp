@@ -38,8 +38,10 @@
 
 #include <fstream>
 #include <cstring>
+#include <memory>
 #include <stack>
 
+#include "AsyncDoubleBuf.hpp"
 #include "portable_endian.hpp"
 #include "pdal_util_export.hpp"
 
@@ -57,19 +59,37 @@ public:
     PDAL_DLL OStream(std::ostream *stream) : m_stream(stream), m_fstream(NULL)
         {}
     PDAL_DLL ~OStream()
-        { delete m_fstream; }
+    {
+        // Drain async output before the file stream goes away.
+        m_asyncStream.reset();
+        m_asyncBuf.reset();
+        delete m_fstream;
+    }
 
-    PDAL_DLL int open(const std::string& filename)
+    // Open a file for output.  When 'async' is set, output is staged
+    // through a double buffer and written to the file on a background
+    // thread so the caller isn't stalled by device latency.
+    PDAL_DLL int open(const std::string& filename, bool async = false)
     {
         if (m_stream)
             return -1;
-        m_stream = m_fstream = new std::ofstream(filename,
+        m_fstream = new std::ofstream(filename,
             std::ios_base::out | std::ios_base::binary);
+        if (async)
+        {
+            m_asyncBuf.reset(new AsyncDoubleBuf(*m_fstream));
+            m_asyncStream.reset(new std::ostream(m_asyncBuf.get()));
+            m_stream = m_asyncStream.get();
+        }
+        else
+            m_stream = m_fstream;
         return 0;
     }
     PDAL_DLL void close()
     {
         flush();
+        m_asyncStream.reset();
+        m_asyncBuf.reset();
         delete m_fstream;
         m_fstream = NULL;
         m_stream = NULL;
@@ -118,6 +138,8 @@ protected:
 
 private:
     std::stack<std::ostream *> m_streams;
+    std::unique_ptr<AsyncDoubleBuf> m_asyncBuf;
+    std::unique_ptr<std::ostream> m_asyncStream;
     OStream(const OStream&);
 };
 
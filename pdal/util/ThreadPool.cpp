@@ -34,9 +34,44 @@
 
 #include "ThreadPool.hpp"
 
+#include <algorithm>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 namespace pdal
 {
 
+namespace
+{
+
+// Set while the thread is executing a pool task.
+thread_local bool t_inWorker = false;
+
+} // unnamed namespace
+
+
+ThreadPool& ThreadPool::shared()
+{
+    // Sized above the core count since I/O-bound tasks (remote tile
+    // fetches, for instance) block without using CPU.  Deliberately
+    // leaked so tasks released during static destruction don't touch a
+    // destroyed pool.
+    static ThreadPool *pool = new ThreadPool((std::max)(
+        (std::size_t)std::thread::hardware_concurrency(),
+        (std::size_t)8));
+    return *pool;
+}
+
+
+bool ThreadPool::inWorker()
+{
+    return t_inWorker;
+}
+
+
 PDAL_DLL void ThreadPool::go()
 {
     std::lock_guard<std::mutex> lock(m_mutex);
@@ -48,24 +83,87 @@ PDAL_DLL void ThreadPool::go()
     for (std::size_t i(0); i < m_numThreads; ++i)
     {
         m_threads.emplace_back([this]() { work(); });
+        if (m_cpus.size())
+            pinThread(m_threads.back(), m_cpus[i % m_cpus.size()]);
     }
 }
 
+void ThreadPool::pinThread(std::thread& t, int cpu)
+{
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(t.native_handle(), sizeof(set), &set);
+#else
+    (void)t;
+    (void)cpu;
+#endif
+}
+
+// Pop the next task, high-priority queue first.  The pool lock must be
+// held by the caller.
+bool ThreadPool::popTask(std::function<void()>& task)
+{
+    if (m_highTasks.size())
+    {
+        task = std::move(m_highTasks.front());
+        m_highTasks.pop();
+        return true;
+    }
+    if (m_tasks.size())
+    {
+        task = std::move(m_tasks.front());
+        m_tasks.pop();
+        return true;
+    }
+    return false;
+}
+
+
+bool ThreadPool::runOne()
+{
+    std::function<void()> task;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!popTask(task))
+        return false;
+    ++m_outstanding;
+    lock.unlock();
+
+    // Notify add(), which may be waiting for a spot in the queue.
+    m_produceCv.notify_all();
+
+    bool wasWorker = t_inWorker;
+    t_inWorker = true;
+    task();
+    t_inWorker = wasWorker;
+
+    lock.lock();
+    --m_outstanding;
+    lock.unlock();
+
+    // Notify await(), which may be waiting for a running task.
+    m_produceCv.notify_all();
+    return true;
+}
+
+
 void ThreadPool::work()
 {
+    t_inWorker = true;
     while (true)
     {
         std::unique_lock<std::mutex> lock(m_mutex);
         m_consumeCv.wait(lock, [this]()
         {
-            return m_tasks.size() || !m_running;
+            return m_tasks.size() || m_highTasks.size() || !m_running;
         });
 
-        if (m_tasks.size())
+        std::function<void()> task;
+        if (popTask(task))
         {
             ++m_outstanding;
-            auto task(std::move(m_tasks.front()));
-            m_tasks.pop();
 
             lock.unlock();
 
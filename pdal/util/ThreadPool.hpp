@@ -34,7 +34,9 @@
 
 #pragma once
 
+#include <atomic>
 #include <cassert>
+#include <chrono>
 #include <condition_variable>
 #include <functional>
 #include <queue>
@@ -48,6 +50,15 @@ namespace pdal
 class ThreadPool
 {
 public:
+    // High-priority tasks run before normal ones.  Use High for short,
+    // latency-sensitive work (e.g. remote metadata fetches that gate a
+    // query) and Normal for bulk compute.
+    enum class Priority
+    {
+        High,
+        Normal
+    };
+
     // After numThreads tasks are actively running, and queueSize tasks have
     // been enqueued to wait for an available worker thread, subsequent calls
     // to Pool::add will block until an enqueued task has been popped from the
@@ -67,6 +78,15 @@ public:
     ThreadPool(const ThreadPool& other) = delete;
     ThreadPool& operator=(const ThreadPool& other) = delete;
 
+    // Process-global pool, shared by stages through TaskGroup handles so
+    // concurrent stages don't oversubscribe the machine with competing
+    // pools.  Sized above the core count since I/O-bound tasks block
+    // without using CPU.
+    PDAL_DLL static ThreadPool& shared();
+
+    // Whether the calling thread is currently running a pool task.
+    PDAL_DLL static bool inWorker();
+
     // Start worker threads.
     PDAL_DLL void go();
 
@@ -90,9 +110,11 @@ public:
     {
         join();
 
-        // Effectively clear the queue.
+        // Effectively clear the queues.
         std::queue<std::function<void()>> q;
         m_tasks.swap(q);
+        std::queue<std::function<void()>> hq;
+        m_highTasks.swap(hq);
     }
 
     // Wait for all current tasks to complete.  As opposed to join, tasks may
@@ -118,13 +140,22 @@ public:
         go();
     }
 
+    // Pin worker threads to the given CPUs, worker i to cpus[i % size].
+    // Takes effect when workers are next started, so call before go() or
+    // follow with cycle().  A no-op on platforms without thread affinity
+    // support.  Pinning keeps workers on the memory node that holds the
+    // data they first touched.
+    PDAL_DLL void setAffinity(const std::vector<int>& cpus)
+    { m_cpus = cpus; }
+
     // Not thread-safe, pool should be joined before calling.
     const std::vector<std::string>& errors() const
     { return m_errors; }
 
     // Add a threaded task, blocking until a thread is available.  If join() is
     // called, add() may not be called again until go() is called and completes.
-    PDAL_DLL void add(std::function<void()> task)
+    PDAL_DLL void add(std::function<void()> task,
+        Priority priority = Priority::Normal)
     {
         std::unique_lock<std::mutex> lock(m_mutex);
         if (!m_running)
@@ -134,16 +165,25 @@ public:
 
         m_produceCv.wait(lock, [this]()
         {
-            return m_queueSize < 0 || m_tasks.size() < (size_t)m_queueSize;
+            return m_queueSize < 0 ||
+                m_tasks.size() + m_highTasks.size() < (size_t)m_queueSize;
         });
 
-        m_tasks.emplace(task);
+        if (priority == Priority::High)
+            m_highTasks.emplace(task);
+        else
+            m_tasks.emplace(task);
 
         // Notify worker that a task is available.
         lock.unlock();
         m_consumeCv.notify_all();
     }
 
+    // Run one queued task on the calling thread, if any is available.
+    // Lets threads waiting on the pool help instead of blocking - see
+    // TaskGroup::await().
+    PDAL_DLL bool runOne();
+
     PDAL_DLL std::size_t size() const
     { return m_numThreads; }
 
@@ -154,11 +194,18 @@ private:
     // Worker thread function.  Wait for a task and run it.
     void work();
 
+    // Pop the next task, high-priority queue first.  Lock must be held.
+    bool popTask(std::function<void()>& task);
+
+    static void pinThread(std::thread& t, int cpu);
+
     int64_t m_queueSize;
     std::size_t m_numThreads;
     bool m_verbose;
+    std::vector<int> m_cpus;
     std::vector<std::thread> m_threads;
     std::queue<std::function<void()>> m_tasks;
+    std::queue<std::function<void()>> m_highTasks;
 
     std::vector<std::string> m_errors;
     std::mutex m_errorMutex;
@@ -171,5 +218,96 @@ private:
     std::condition_variable m_consumeCv;
 };
 
+
+// Handle for sharing a pool - typically ThreadPool::shared() - among
+// independent clients.  A group tracks only its own tasks, so await()
+// and cancel() don't interfere with other users of the pool, and
+// 'maxPending' bounds this client's tasks in flight so one stage can't
+// swamp the workers.
+class TaskGroup
+{
+public:
+    PDAL_DLL TaskGroup(ThreadPool& pool, std::size_t maxPending = 0) :
+        m_pool(pool), m_maxPending(maxPending)
+    {}
+
+    PDAL_DLL ~TaskGroup()
+    { cancel(); }
+
+    TaskGroup(const TaskGroup& other) = delete;
+    TaskGroup& operator=(const TaskGroup& other) = delete;
+
+    PDAL_DLL std::size_t maxPending() const
+    { return m_maxPending; }
+
+    // Submit a task, blocking while this group has maxPending tasks
+    // queued or running.  Submissions from pool workers are exempt from
+    // the cap: a task spawning subtasks (a hierarchy page loading its
+    // children, say) counts its own still-running self against
+    // m_pending, so blocking it would wait on capacity that only its
+    // own completion can free.
+    PDAL_DLL void add(std::function<void()> task,
+        ThreadPool::Priority priority = ThreadPool::Priority::Normal)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (!ThreadPool::inWorker())
+            m_cv.wait(lock, [this]()
+            {
+                return !m_maxPending || m_pending < m_maxPending;
+            });
+        m_pending++;
+        lock.unlock();
+
+        m_pool.add([this, task]()
+        {
+            if (!m_canceled)
+                task();
+            std::lock_guard<std::mutex> l(m_mutex);
+            m_pending--;
+            m_cv.notify_all();
+        }, priority);
+    }
+
+    // Wait for this group's tasks to finish.  Pool workers help run
+    // queued tasks instead of blocking, so a task that submits and
+    // awaits subtasks on the same pool can't deadlock the workers.
+    PDAL_DLL void await()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (m_pending)
+        {
+            if (ThreadPool::inWorker())
+            {
+                lock.unlock();
+                bool ran = m_pool.runOne();
+                lock.lock();
+                // Nothing to help with; our tasks are running on other
+                // workers.  Wait briefly and re-check.
+                if (!ran && m_pending)
+                    m_cv.wait_for(lock, std::chrono::milliseconds(1));
+            }
+            else
+                m_cv.wait(lock, [this]() { return m_pending == 0; });
+        }
+    }
+
+    // Skip this group's queued tasks and wait for running ones to
+    // finish.  The group is reusable afterwards.
+    PDAL_DLL void cancel()
+    {
+        m_canceled = true;
+        await();
+        m_canceled = false;
+    }
+
+private:
+    ThreadPool& m_pool;
+    std::size_t m_maxPending;
+    std::size_t m_pending = 0;
+    std::atomic<bool> m_canceled { false };
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+};
+
 } // namespace pdal
 
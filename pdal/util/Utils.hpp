@@ -37,7 +37,10 @@
 #include <algorithm>
 #include <cassert>
 #include <cctype>
+#include <cerrno>
+#include <charconv>
 #include <cmath>
+#include <cstdlib>
 #include <cstdint>
 #include <cstring>
 #include <fstream>
@@ -821,13 +824,22 @@ namespace Utils
     */
     inline std::string toString(double from, size_t precision = 10)
     {
-        std::ostringstream oss;
         // Standardize nan/inf output to the JAVA property names because
         // when we convert to a string, we usually convert to JSON.
         if (std::isnan(from))
             return "NaN";
         if (std::isinf(from))
             return (from < 0 ? "-Infinity" : "Infinity");
+#if defined(__cpp_lib_to_chars)
+        // General format with an explicit precision matches the output of
+        // a default-formatted stream, without the stream setup cost.
+        char buf[64];
+        std::to_chars_result result = std::to_chars(buf, buf + sizeof(buf),
+            from, std::chars_format::general, (int)precision);
+        if (result.ec == std::errc())
+            return std::string(buf, result.ptr);
+#endif
+        std::ostringstream oss;
         oss << std::setprecision(precision) << from;
         return oss.str();
     }
@@ -840,6 +852,13 @@ namespace Utils
     */
     inline std::string toString(float from)
     {
+#if defined(__cpp_lib_to_chars)
+        char buf[64];
+        std::to_chars_result result = std::to_chars(buf, buf + sizeof(buf),
+            from, std::chars_format::general, 8);
+        if (result.ec == std::errc())
+            return std::string(buf, result.ptr);
+#endif
         std::ostringstream oss;
         oss << std::setprecision(8) << from;
         return oss.str();
@@ -936,6 +955,74 @@ namespace Utils
         { return std::to_string((int)from); }
 
 
+    /**
+      Convert a numeric string to an integral value with std::from_chars,
+      avoiding stringstream and locale machinery.
+
+      \param s  String to convert.
+      \param to  Converted value.
+      \return  \c true if the conversion was successful, \c false otherwise.
+    */
+    template<typename T>
+    StatusWithReason intFromChars(const std::string& s, T& to)
+    {
+        const char *first = s.c_str();
+        const char *last = first + s.size();
+
+        // Match operator>>, which skips leading whitespace and accepts a
+        // leading '+'.  std::from_chars does neither.
+        while (first != last && std::isspace((unsigned char)*first))
+            ++first;
+        if (last - first > 1 && *first == '+' &&
+                std::isdigit((unsigned char)first[1]))
+            ++first;
+
+        T t;
+        std::from_chars_result result = std::from_chars(first, last, t);
+        if (result.ec != std::errc())
+            return false;
+        to = t;
+        return true;
+    }
+
+    /**
+      Convert a numeric string to a floating point value without
+      stringstream or locale machinery.  Falls back to strtof()/strtod()
+      when the standard library lacks floating point std::from_chars.
+
+      \param s  String to convert.
+      \param to  Converted value.
+      \return  \c true if the conversion was successful, \c false otherwise.
+    */
+    template<typename T>
+    StatusWithReason floatFromChars(const std::string& s, T& to)
+    {
+        const char *first = s.c_str();
+        const char *last = first + s.size();
+
+        while (first != last && std::isspace((unsigned char)*first))
+            ++first;
+        if (last - first > 1 && *first == '+' && first[1] != '-')
+            ++first;
+#if defined(__cpp_lib_to_chars)
+        T t;
+        std::from_chars_result result = std::from_chars(first, last, t);
+        if (result.ec != std::errc())
+            return false;
+        to = t;
+        return true;
+#else
+        char *end;
+        errno = 0;
+        T t = std::is_same<T, float>::value ? (T)std::strtof(first, &end) :
+            (T)std::strtod(first, &end);
+        if (end == first || errno == ERANGE)
+            return false;
+        to = t;
+        return true;
+#endif
+    }
+
     template<typename T>
     StatusWithReason fromString(const std::string& from, T* & to)
     {
@@ -952,7 +1039,8 @@ namespace Utils
     }
 
     /**
-      Convert a string to a value by reading from a string stream.
+      Convert a string to a value.  Numeric types convert with
+      std::from_chars; other types read from a string stream.
 
       \param from  String to convert.
       \param to  Converted value.
@@ -961,10 +1049,22 @@ namespace Utils
     template<typename T>
     StatusWithReason fromString(const std::string& from, T& to)
     {
-        std::istringstream iss(from);
+        if constexpr (std::is_integral<T>::value &&
+            !std::is_same<T, bool>::value)
+        {
+            return intFromChars(from, to);
+        }
+        else if constexpr (std::is_floating_point<T>::value)
+        {
+            return floatFromChars(from, to);
+        }
+        else
+        {
+            std::istringstream iss(from);
 
-        iss >> to;
-        return !iss.fail();
+            iss >> to;
+            return !iss.fail();
+        }
     }
 
     // Optimization of above.
@@ -1085,10 +1185,33 @@ namespace Utils
             return true;
         }
 
-        std::istringstream iss(s);
+        return floatFromChars(s, d);
+    }
+
+    /**
+      Convert a list of strings to values of a single type.  Conversion
+      stops at the first failure, leaving \ref to with the values converted
+      to that point.
 
-        iss >> d;
-        return !iss.fail();
+      \param from  Strings to convert.
+      \param to  Vector filled with converted values.
+      \return  \c true if every conversion succeeded, \c false otherwise.
+    */
+    template<typename T>
+    StatusWithReason fromStrings(const std::vector<std::string>& from,
+        std::vector<T>& to)
+    {
+        to.clear();
+        to.reserve(from.size());
+
+        T t;
+        for (const std::string& s : from)
+        {
+            if (!fromString(s, t))
+                return false;
+            to.push_back(t);
+        }
+        return true;
     }
 
     /**
@@ -35,9 +35,18 @@
 #include <cpd/affine.hpp>
 #include <cpd/nonrigid.hpp>
 #include <cpd/rigid.hpp>
+
+#if defined(__has_include)
+#if __has_include(<cpd/gauss_transform_fgt.hpp>)
+#include <cpd/gauss_transform_fgt.hpp>
+#define PDAL_CPD_HAVE_FGT
+#endif
+#endif
 #include <filters/CpdFilter.hpp>
 #include <pdal/private/MathUtils.hpp>
 
+#include <memory>
+
 namespace pdal
 {
 namespace
@@ -60,6 +69,29 @@ void addMetadata(CpdFilter* filter, const cpd::Result& result)
     root.add("runtime", double(result.runtime.count()) / 1e6);
     root.add("iterations", result.iterations);
 }
+
+// Apply the filter's convergence options and, when requested, swap the
+// quadratic direct Gauss transform for the fast Gauss transform so the
+// E-step runs in roughly linear time (and in parallel when fgt was built
+// with OpenMP).
+template <typename Transform>
+void configure(Transform& xform, double tolerance, int maxIterations,
+    double outliers, bool fgt)
+{
+    xform.tolerance(tolerance);
+    xform.max_iterations(maxIterations);
+    xform.outliers(outliers);
+    if (fgt)
+    {
+#ifdef PDAL_CPD_HAVE_FGT
+        xform.gauss_transform(std::unique_ptr<cpd::GaussTransform>(
+            new cpd::GaussTransformFgt()));
+#else
+        throw pdal_error("filters.cpd: 'fgt' requested, but the cpd "
+            "library was built without fast Gauss transform support.");
+#endif
+    }
+}
 }
 
 static PluginInfo const s_info
@@ -80,6 +112,14 @@ void CpdFilter::addArgs(ProgramArgs& args)
 {
     args.add("method", "CPD method (rigid, nonrigid, or affine)", m_method,
              "rigid");
+    args.add("tolerance", "Registration is converged when the change in "
+        "the objective function drops below this", m_tolerance, 1e-5);
+    args.add("max_iterations", "Maximum number of EM iterations",
+        m_maxIterations, 150);
+    args.add("outliers", "Weight of the uniform outlier distribution",
+        m_outliers, 0.1);
+    args.add("fgt", "Use the fast Gauss transform for the E-step",
+        m_fgt);
 }
 
 std::string CpdFilter::defaultMethod()
@@ -151,7 +191,9 @@ void CpdFilter::cpd_rigid(PointViewPtr fixed, PointViewPtr moving)
 {
     cpd::Matrix fixedMatrix = math::pointViewToEigen(*fixed);
     cpd::Matrix movingMatrix = math::pointViewToEigen(*moving);
-    cpd::RigidResult result = cpd::rigid(fixedMatrix, movingMatrix);
+    cpd::Rigid rigid;
+    configure(rigid, m_tolerance, m_maxIterations, m_outliers, m_fgt);
+    cpd::RigidResult result = rigid.run(fixedMatrix, movingMatrix);
     movePoints(moving, result.points);
     addMetadata(this, static_cast<cpd::Result>(result));
     MetadataNode root = getMetadata();
@@ -162,7 +204,9 @@ void CpdFilter::cpd_affine(PointViewPtr fixed, PointViewPtr moving)
 {
     cpd::Matrix fixedMatrix = math::pointViewToEigen(*fixed);
     cpd::Matrix movingMatrix = math::pointViewToEigen(*moving);
-    cpd::AffineResult result = cpd::affine(fixedMatrix, movingMatrix);
+    cpd::Affine affine;
+    configure(affine, m_tolerance, m_maxIterations, m_outliers, m_fgt);
+    cpd::AffineResult result = affine.run(fixedMatrix, movingMatrix);
     movePoints(moving, result.points);
     MetadataNode root = getMetadata();
     root.add("transform", result.matrix());
@@ -172,7 +216,9 @@ void CpdFilter::cpd_nonrigid(PointViewPtr fixed, PointViewPtr moving)
 {
     cpd::Matrix fixedMatrix = math::pointViewToEigen(*fixed);
     cpd::Matrix movingMatrix = math::pointViewToEigen(*moving);
-    cpd::NonrigidResult result = cpd::nonrigid(fixedMatrix, movingMatrix);
+    cpd::Nonrigid nonrigid;
+    configure(nonrigid, m_tolerance, m_maxIterations, m_outliers, m_fgt);
+    cpd::NonrigidResult result = nonrigid.run(fixedMatrix, movingMatrix);
     movePoints(moving, result.points);
 }
 }
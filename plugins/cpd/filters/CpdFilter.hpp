@@ -62,6 +62,10 @@ class PDAL_DLL CpdFilter : public Filter
 
     PointViewPtr m_fixed;
     std::string m_method;
+    double m_tolerance;
+    int m_maxIterations;
+    double m_outliers;
+    bool m_fgt;
     bool m_complete;
 
     CpdFilter& operator=(const CpdFilter&); // not implemented
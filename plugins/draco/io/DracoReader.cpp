@@ -34,6 +34,7 @@
 
 #include <algorithm>
 #include <pdal/util/FileUtils.hpp>
+#include <pdal/util/ThreadPool.hpp>
 
 #include "DracoReader.hpp"
 
@@ -86,6 +87,8 @@ Dimension::Type getPdalType(draco::DataType t)
 
 void DracoReader::addArgs(ProgramArgs& args)
 {
+    args.add("threads", "Number of threads used to copy decoded attributes",
+        m_threads, 1);
 }
 
 void DracoReader::prepared(PointTableRef table)
@@ -235,22 +238,60 @@ void DracoReader::ready(PointTableRef)
 
 point_count_t DracoReader::read(PointViewPtr view, point_count_t count)
 {
-    PointId id = view->size();
-    point_count_t numRead = 0;
+    PointId startId = view->size();
 
     count = (std::min)(count, (point_count_t)m_pc->num_points());
-    while (numRead < count)
+    if (count == 0 || m_dimensions.empty())
+        return startId;
+
+    //copy one attribute component for all points.  Draco stores attributes
+    //in separate buffers, so walking a whole column at a time turns the copy
+    //into a sequential scan of a single buffer.  When the point-to-value
+    //mapping is the identity the source address advances at a fixed stride
+    //without a mapping lookup per point.
+    auto copyDim = [this, view, startId, count](const DimensionInfo& dim)
     {
-        for (auto& dim: m_dimensions)
+        size_t offset = draco::DataTypeLength(dim.attr->data_type()) *
+            dim.attNum;
+        PointId id = startId;
+        if (dim.attr->is_mapping_identity())
+        {
+            const uint8_t *src =
+                dim.attr->GetAddress(draco::AttributeValueIndex(0)) + offset;
+            size_t stride = dim.attr->byte_stride();
+            for (point_count_t i = 0; i < count; ++i, src += stride)
+                view->setField(dim.pdalId, dim.pdalType, id++, src);
+        }
+        else
         {
-            const uint8_t *src = dim.attr->GetAddressOfMappedIndex(draco::PointIndex((uint32_t)numRead)) +
-                draco::DataTypeLength(dim.attr->data_type()) * dim.attNum;
-            view->setField(dim.pdalId, dim.pdalType, id, src);
+            for (point_count_t i = 0; i < count; ++i)
+            {
+                const uint8_t *src = dim.attr->GetAddressOfMappedIndex(
+                    draco::PointIndex((uint32_t)i)) + offset;
+                view->setField(dim.pdalId, dim.pdalType, id++, src);
+            }
         }
-        ++id;
-        ++numRead;
+    };
+
+    //the first column is copied serially so that every point exists in the
+    //view before the remaining columns are filled in; the other columns
+    //write to disjoint dimensions and can run concurrently.
+    copyDim(m_dimensions.front());
+    size_t threads = (std::min)((size_t)(std::max)(m_threads, 1),
+        m_dimensions.size() - 1);
+    if (threads <= 1)
+    {
+        for (size_t d = 1; d < m_dimensions.size(); ++d)
+            copyDim(m_dimensions[d]);
+    }
+    else
+    {
+        ThreadPool pool(threads);
+        for (size_t d = 1; d < m_dimensions.size(); ++d)
+            pool.add([this, &copyDim, d]() { copyDim(m_dimensions[d]); });
+        pool.await();
     }
-    return id;
+    return startId + count;
 }
 
 void DracoReader::done(pdal::BasePointTable &table)
@@ -66,6 +66,7 @@ private:
         int attNum;//eg POSITION = [ X, Y, Z ], Y's attNum would be 1
     };
     std::vector<DimensionInfo> m_dimensions;
+    int m_threads;
     DracoReader(const DracoReader&) = delete;
     DracoReader& operator=(const DracoReader&) = delete;
 
@@ -59,10 +59,16 @@ E57Reader::E57Reader()
 {
 }
 
+E57Reader::~E57Reader()
+{
+}
+
 void E57Reader::addArgs(ProgramArgs& args)
 {
     args.add("extra_dims", "Extra dimensions to read from E57 point cloud.",
              m_extraDimsSpec);
+    args.add("threads", "Number of scans decoded in parallel "
+             "(standard mode only)", m_threads, (size_t)1);
 }
 
 void E57Reader::initializeBuffers()
@@ -168,8 +174,10 @@ void E57Reader::initialize()
     try
     {
         arbiter::Arbiter arb;
-        arbiter::LocalHandle fileHandle = arb.getLocalHandle(m_filename);
-        m_imf.reset(new ImageFile(fileHandle.localPath(), "r"));
+        m_fileHandle.reset(
+            new arbiter::LocalHandle(arb.getLocalHandle(m_filename)));
+        m_localPath = m_fileHandle->localPath();
+        m_imf.reset(new ImageFile(m_localPath, "r"));
         StructureNode root = m_imf->root();
 
         if (!root.isDefined("/data3D"))
@@ -324,8 +332,193 @@ bool E57Reader::fillPoint(PointRef& point)
     return true;
 }
 
+/// Decode an entire scan through a private ImageFile, applying
+/// rescaling and the scan's pose, then queue it for the main thread.
+/// Runs on a pool thread.
+void E57Reader::decodeScan(int scanIndex)
+{
+    try
+    {
+        ImageFile imf(m_localPath, "r");
+        StructureNode root = imf.root();
+        VectorNode data3D(root.get("/data3D"));
+        Scan scan((StructureNode)data3D.get(scanIndex));
+        StructureNode proto(scan.getPointPrototype());
+
+        DecodedScan decoded;
+        decoded.numPoints = scan.getNumPoints();
+
+        for (auto& dimension : e57plugin::supportedE57Types())
+        {
+            if (proto.isDefined(dimension))
+                decoded.buffers[dimension] =
+                    std::vector<double>(decoded.numPoints);
+        }
+        for (auto i = m_extraDims->begin(); i != m_extraDims->end(); ++i)
+        {
+            if (proto.isDefined(i->m_name))
+                decoded.buffers[i->m_name] =
+                    std::vector<double>(decoded.numPoints);
+        }
+
+        // Read large batches straight into the scan-sized buffers.
+        const point_count_t batchSize = 1 << 20;
+        point_count_t offset = 0;
+        std::unique_ptr<CompressedVectorReader> reader;
+        while (offset < decoded.numPoints)
+        {
+            point_count_t batch =
+                (std::min)(batchSize, decoded.numPoints - offset);
+            std::vector<SourceDestBuffer> dbufs;
+            for (auto& keyValue : decoded.buffers)
+                dbufs.emplace_back(imf, keyValue.first,
+                    keyValue.second.data() + offset, batch, true,
+                    (proto.get(keyValue.first).type() ==
+                     e57::E57_SCALED_INTEGER));
+            if (!reader)
+                reader.reset(new CompressedVectorReader(
+                    scan.getPoints().reader(dbufs)));
+            point_count_t got = reader->read(dbufs);
+            if (!got)
+                break;
+            offset += got;
+        }
+        if (reader)
+            reader->close();
+        decoded.numPoints = offset;
+
+        // Rescale known dimensions and apply the pose to whichever
+        // buffers provide X, Y and Z, mirroring fillPoint().
+        std::vector<double> *x = nullptr;
+        std::vector<double> *y = nullptr;
+        std::vector<double> *z = nullptr;
+        for (auto& keyValue : decoded.buffers)
+        {
+            auto dim = e57plugin::e57ToPdal(keyValue.first);
+            if (dim == Dimension::Id::Unknown)
+                continue;
+            for (double& value : keyValue.second)
+                value = scan.rescale(dim, value);
+            if (dim == Dimension::Id::X)
+                x = &keyValue.second;
+            else if (dim == Dimension::Id::Y)
+                y = &keyValue.second;
+            else if (dim == Dimension::Id::Z)
+                z = &keyValue.second;
+        }
+        if (scan.hasPose() && x && y && z)
+        {
+            for (point_count_t i = 0; i < decoded.numPoints; ++i)
+                scan.transformPoint((*x)[i], (*y)[i], (*z)[i]);
+        }
+
+        std::unique_lock<std::mutex> l(m_mutex);
+        m_decoded.emplace(scanIndex, std::move(decoded));
+        l.unlock();
+        m_cv.notify_one();
+    }
+    catch (E57Exception& e)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_decodeError.empty())
+            m_decodeError =
+                std::to_string(e.errorCode()) + " : " + e.context();
+        m_cv.notify_one();
+    }
+    catch (std::exception& e)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_decodeError.empty())
+            m_decodeError = e.what();
+        m_cv.notify_one();
+    }
+}
+
+/// Submit scans for decoding until one more than the number of workers
+/// is in flight, so the next scan is always being decoded while the
+/// current one is stored.
+void E57Reader::fillDecodeQueue()
+{
+    int numScans = m_data3D->childCount();
+    int budget = (int)m_pool->numThreads() + 1;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    while (m_nextSubmit < numScans && m_nextSubmit - m_nextConsume < budget)
+    {
+        int scanIndex = m_nextSubmit++;
+        m_pool->add([this, scanIndex]()
+            { decodeScan(scanIndex); });
+    }
+}
+
+/// Block until the next scan in file order has been decoded and hand
+/// it to the caller.
+E57Reader::DecodedScan E57Reader::nextDecodedScan()
+{
+    std::unique_lock<std::mutex> l(m_mutex);
+    m_cv.wait(l, [this]()
+    {
+        return m_decodeError.size() ||
+            m_decoded.find(m_nextConsume) != m_decoded.end();
+    });
+    if (m_decodeError.size())
+    {
+        std::string error = m_decodeError;
+        l.unlock();
+        m_pool->join();
+        throwError(error);
+    }
+    auto it = m_decoded.find(m_nextConsume);
+    DecodedScan scan = std::move(it->second);
+    m_decoded.erase(it);
+    m_nextConsume++;
+    return scan;
+}
+
+/// Decode scans on a thread pool - scans are independent - and store
+/// each one as its turn comes so output order matches the serial path.
+point_count_t E57Reader::readParallel(PointViewPtr view)
+{
+    int numScans = m_data3D->childCount();
+
+    m_nextSubmit = 0;
+    m_nextConsume = 0;
+    m_decoded.clear();
+    m_decodeError.clear();
+    m_pool.reset(new ThreadPool((std::min)(m_threads, (size_t)numScans)));
+
+    fillDecodeQueue();
+    PointRef point(*view);
+    for (int scanIndex = 0; scanIndex < numScans; ++scanIndex)
+    {
+        DecodedScan scan = nextDecodedScan();
+        fillDecodeQueue();
+        for (point_count_t i = 0; i < scan.numPoints; ++i)
+        {
+            point.setPointId(view->size());
+            for (auto& keyValue : scan.buffers)
+            {
+                auto dim = e57plugin::e57ToPdal(keyValue.first);
+                if (dim != Dimension::Id::Unknown)
+                    point.setField(dim, keyValue.second[i]);
+                else
+                {
+                    auto extra = m_extraDims->findDim(keyValue.first);
+                    if (extra != m_extraDims->end())
+                        point.setField(extra->m_id, keyValue.second[i]);
+                }
+            }
+        }
+    }
+    m_pool->join();
+    return view->size();
+}
+
 point_count_t E57Reader::read(PointViewPtr view, point_count_t count)
 {
+    if (m_threads > 1)
+        return readParallel(view);
+
     point_count_t numPoints = e57plugin::numPoints(*m_data3D);
     PointRef point(*view);
     for (PointId counter = 0, nextId = view->size(); counter < numPoints;
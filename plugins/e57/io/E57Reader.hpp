@@ -34,17 +34,28 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <mutex>
+
 #include <pdal/Reader.hpp>
 #include <pdal/Streamable.hpp>
+#include <pdal/util/ThreadPool.hpp>
 #include "Scan.hpp"
 #include "Utils.hpp"
 
 namespace pdal
 {
+
+namespace arbiter
+{
+class LocalHandle;
+}
+
 class PDAL_DLL E57Reader : public Reader, public Streamable
 {
 public:
     E57Reader();
+    ~E57Reader();
     std::string getName() const override;
 
 private:
@@ -64,6 +75,19 @@ private:
     void setupReader();
     void initializeBuffers();
 
+    /// Decoded output of one scan: per-dimension values with rescaling
+    /// and the scan's pose already applied.
+    struct DecodedScan
+    {
+        point_count_t numPoints = 0;
+        std::map<std::string, std::vector<double>> buffers;
+    };
+
+    point_count_t readParallel(PointViewPtr view);
+    void decodeScan(int scanIndex);
+    void fillDecodeQueue();
+    DecodedScan nextDecodedScan();
+
     std::unique_ptr<e57::ImageFile> m_imf;
     std::unique_ptr<e57::VectorNode> m_data3D;
     std::unique_ptr<e57::CompressedVectorReader> m_reader;
@@ -80,6 +104,20 @@ private:
 
     pdal::StringList m_extraDimsSpec;
     std::unique_ptr<e57plugin::ExtraDims> m_extraDims;
+
+    // Parallel scan decoding.  Each worker opens its own ImageFile on
+    // m_localPath and decodes whole scans; the main thread consumes
+    // them in scan order.
+    std::unique_ptr<arbiter::LocalHandle> m_fileHandle;
+    std::string m_localPath;
+    size_t m_threads;
+    std::unique_ptr<ThreadPool> m_pool;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::map<int, DecodedScan> m_decoded;
+    std::string m_decodeError;
+    int m_nextSubmit;
+    int m_nextConsume;
 };
 
 } // namespace pdal
@@ -52,9 +52,10 @@ CREATE_SHARED_STAGE(E57Writer, s_info)
 
 E57Writer::ChunkWriter::ChunkWriter
 (const std::vector<std::string>& dimensionsToWrite,
- e57::CompressedVectorNode& vectorNode)
+ e57::CompressedVectorNode& vectorNode,
+ e57plugin::ExtraDims *extraDims, int threads)
     : m_defaultChunkSize(1 << 20), m_currentIndex(0), m_colorLimit(256),
-      m_intensityLimit(1)
+      m_intensityLimit(1), m_flushPool(1)
 {
     // Initialise the write buffers
     for (auto& e57dim: dimensionsToWrite)
@@ -69,51 +70,174 @@ E57Writer::ChunkWriter::ChunkWriter
     m_dataWriter.reset(
         new e57::CompressedVectorWriter(vectorNode.writer(m_e57buffers)));
 
+    // Resolve each field's dimension once up front.  Points are staged
+    // in the fields' stage buffers and copied into the buffers registered
+    // with libE57 at flush time, so the next chunk can be packed while
+    // the flush pool runs the (compressing) CompressedVectorWriter write.
+    using DimId = pdal::Dimension::Id;
+    for (auto& keyValue : m_doubleBuffers)
+    {
+        Field f;
+        f.m_dest = &keyValue.second;
+        f.m_extra = nullptr;
+        f.m_limit = 0;
+        auto pdaldim = pdal::e57plugin::e57ToPdal(keyValue.first);
+        if (pdaldim != DimId::Unknown)
+        {
+            f.m_id = pdaldim;
+            if (pdaldim == DimId::Red || pdaldim == DimId::Green ||
+                    pdaldim == DimId::Blue)
+                f.m_kind = FieldKind::Color;
+            else if (pdaldim == DimId::Intensity)
+                f.m_kind = FieldKind::Intensity;
+            else
+                f.m_kind = FieldKind::Plain;
+        }
+        else
+        {
+            auto dim = extraDims->findDim(keyValue.first);
+            // Fields without a source dimension stay zero-filled.
+            if (dim == extraDims->end())
+                continue;
+            f.m_id = dim->m_id;
+            f.m_kind = FieldKind::Extra;
+            f.m_extra = &*dim;
+        }
+        f.m_stage.resize(m_defaultChunkSize);
+        m_fields.push_back(std::move(f));
+    }
+
+    if (threads > 1)
+        m_packPool.reset(new ThreadPool(threads));
 }
 
-void E57Writer::ChunkWriter::write(pdal::PointRef& pt, std::unique_ptr<e57plugin::ExtraDims>& extraDims)
+void E57Writer::ChunkWriter::write(pdal::PointRef& pt)
 {
-// If buffer full, write to disk and reinitialise buffer
-
-    if (m_currentIndex == m_defaultChunkSize)
+    for (Field& f : m_fields)
     {
-        m_dataWriter->write(m_defaultChunkSize);
-        m_currentIndex = 0;
+        double val = pt.getFieldAs<double>(f.m_id);
+        switch (f.m_kind)
+        {
+        case FieldKind::Color:
+            while (val > m_colorLimit)
+                m_colorLimit = m_colorLimit << 8;  // Increase color bytes.
+            break;
+        case FieldKind::Intensity:
+            while (val > m_intensityLimit)
+                m_intensityLimit = m_intensityLimit << 8;
+            break;
+        case FieldKind::Extra:
+            f.m_extra->grow(val);
+            break;
+        default:
+            break;
+        }
+        f.m_stage[m_currentIndex] = val;
     }
+    m_currentIndex++;
 
-    // Add point to buffer and increase index
-    using DimId = pdal::Dimension::Id;
-    for (auto& keyValue: m_doubleBuffers)
+    if (m_currentIndex == m_defaultChunkSize)
+        flush(m_defaultChunkSize);
+}
+
+void E57Writer::ChunkWriter::write(const PointViewPtr view)
+{
+    PointId idx = 0;
+    while (idx < view->size())
     {
-        auto pdaldim = pdal::e57plugin::e57ToPdal(keyValue.first);
-        if (pdaldim != DimId::Unknown)
+        point_count_t n = (std::min)((point_count_t)(view->size() - idx),
+            m_defaultChunkSize - m_currentIndex);
+
+        // One strided pass per field over the block.  Color/intensity
+        // limits grow against a per-field copy that's folded back below,
+        // so packing passes are independent and can run on the pool.
+        auto pack = [this, view, idx, n](Field& f)
         {
-            auto val = pt.getFieldAs<double>(pdaldim);
-            if ((pdaldim == DimId::Red || pdaldim == DimId::Green ||
-                    pdaldim == DimId::Blue) &&
-                    val > m_colorLimit)
+            uint64_t limit =
+                (f.m_kind == FieldKind::Color) ? m_colorLimit :
+                m_intensityLimit;
+            double *out = f.m_stage.data() + m_currentIndex;
+            for (point_count_t i = 0; i < n; ++i)
             {
-                m_colorLimit = m_colorLimit << 8;  // Increase color bytes.
+                double val = view->getFieldAs<double>(f.m_id, idx + i);
+                switch (f.m_kind)
+                {
+                case FieldKind::Color:
+                case FieldKind::Intensity:
+                    while (val > limit)
+                        limit = limit << 8;
+                    break;
+                case FieldKind::Extra:
+                    f.m_extra->grow(val);
+                    break;
+                default:
+                    break;
+                }
+                out[i] = val;
             }
+            f.m_limit = limit;
+        };
 
-            if (pdaldim == DimId::Intensity && val > m_intensityLimit)
-            {
-                m_intensityLimit = m_intensityLimit << 8;
-            }
-            keyValue.second[m_currentIndex] = val;
+        if (m_packPool)
+        {
+            for (Field& f : m_fields)
+                m_packPool->add([&pack, &f]() { pack(f); });
+            m_packPool->await();
         }
         else
+            for (Field& f : m_fields)
+                pack(f);
+
+        for (const Field& f : m_fields)
         {
-            auto dim = extraDims->findDim(keyValue.first);
-            if (dim!=extraDims->end())
-            {
-                auto val = pt.getFieldAs<double>(dim->m_id);
-                keyValue.second[m_currentIndex] = val;
-                dim->grow(val);
-            }
+            if (f.m_kind == FieldKind::Color)
+                m_colorLimit = (std::max)(m_colorLimit, f.m_limit);
+            else if (f.m_kind == FieldKind::Intensity)
+                m_intensityLimit = (std::max)(m_intensityLimit, f.m_limit);
         }
+
+        m_currentIndex += n;
+        idx += n;
+        if (m_currentIndex == m_defaultChunkSize)
+            flush(m_defaultChunkSize);
+    }
+}
+
+void E57Writer::ChunkWriter::flush(pdal::point_count_t count)
+{
+    // The staged chunk can't be copied into the registered buffers while
+    // libE57 is still reading them.
+    m_flushPool.await();
+    rethrowFlushError();
+    if (count == 0)
+        return;
+
+    for (Field& f : m_fields)
+        std::copy(f.m_stage.begin(), f.m_stage.begin() + count,
+            f.m_dest->begin());
+
+    m_flushPool.add([this, count]()
+    {
+        try
+        {
+            m_dataWriter->write(count);
+        }
+        catch (...)
+        {
+            m_flushError = std::current_exception();
+        }
+    });
+    m_currentIndex = 0;
+}
+
+void E57Writer::ChunkWriter::rethrowFlushError()
+{
+    if (m_flushError)
+    {
+        std::exception_ptr e = m_flushError;
+        m_flushError = nullptr;
+        std::rethrow_exception(e);
     }
-    m_currentIndex++;
 }
 
 void E57Writer::ChunkWriter::finalise()
@@ -121,8 +245,9 @@ void E57Writer::ChunkWriter::finalise()
     if (m_dataWriter)
     {
         //  Write whatever remains and closes
-        m_dataWriter->write(m_currentIndex);
-        m_currentIndex = 0;
+        flush(m_currentIndex);
+        m_flushPool.await();
+        rethrowFlushError();
         m_dataWriter->close();
     }
 }
@@ -150,6 +275,8 @@ void E57Writer::addArgs(ProgramArgs& args)
              "Double precision for storage (false by default)", m_doublePrecision);
     args.add("extra_dims", "Extra dimensions to write to E57 data",
              m_extraDimsSpec);
+    args.add("threads", "Number of threads used to pack chunk buffers",
+             m_threads, 1);
 }
 
 void E57Writer::initialize()
@@ -221,10 +348,10 @@ void E57Writer::ready(PointTableRef table)
 void E57Writer::write(const PointViewPtr view)
 {
     for (PointId id = 0; id < view->size(); ++id)
-    {
-        PointRef point = view->point(id);
-        processOne(point);
-    }
+        m_bbox.grow(view->getFieldAs<double>(Dimension::Id::X, id),
+                    view->getFieldAs<double>(Dimension::Id::Y, id),
+                    view->getFieldAs<double>(Dimension::Id::Z, id));
+    m_chunkWriter->write(view);
 }
 
 bool E57Writer::processOne(PointRef& point)
@@ -235,7 +362,7 @@ bool E57Writer::processOne(PointRef& point)
                 point.getFieldAs<double>(Dimension::Id::Z));
 
     // Write point
-    m_chunkWriter->write(point, m_extraDims);
+    m_chunkWriter->write(point);
 
     return true;
 }
@@ -404,7 +531,8 @@ void E57Writer::setupWriter()
     // Instantiate writer
     try
     {
-        m_chunkWriter.reset(new ChunkWriter(m_dimensionsToWrite, points));
+        m_chunkWriter.reset(new ChunkWriter(m_dimensionsToWrite, points,
+            m_extraDims.get(), m_threads));
     }
     catch (e57::E57Exception &e)
     {
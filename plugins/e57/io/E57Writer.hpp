@@ -37,6 +37,7 @@
 #include <pdal/Streamable.hpp>
 #include <pdal/Writer.hpp>
 #include <pdal/pdal_types.hpp>
+#include <pdal/util/ThreadPool.hpp>
 #include "Utils.hpp"
 
 namespace pdal
@@ -48,10 +49,12 @@ class PDAL_DLL E57Writer : public pdal::Writer, public pdal::Streamable
     {
     public:
         ChunkWriter(const std::vector<std::string>& dimensionsToWrite,
-                    e57::CompressedVectorNode& vectorNode);
+                    e57::CompressedVectorNode& vectorNode,
+                    e57plugin::ExtraDims *extraDims, int threads);
 
-        void write(pdal::PointRef& point,
-                   std::unique_ptr<e57plugin::ExtraDims>& extraDims);
+        void write(pdal::PointRef& point);
+
+        void write(const PointViewPtr view);
 
         void finalise();
 
@@ -70,6 +73,31 @@ class PDAL_DLL E57Writer : public pdal::Writer, public pdal::Streamable
         }
 
     private:
+        enum class FieldKind
+        {
+            Plain,
+            Color,
+            Intensity,
+            Extra
+        };
+
+        // Per-field extraction plan, resolved once at construction so the
+        // per-point path doesn't repeat the name-to-dimension lookups.
+        // Values are staged in m_stage and copied into the buffer
+        // registered with libE57 (m_dest) when a chunk is flushed.
+        struct Field
+        {
+            pdal::Dimension::Id m_id;
+            FieldKind m_kind;
+            e57plugin::Dim *m_extra;
+            std::vector<double> m_stage;
+            std::vector<double> *m_dest;
+            uint64_t m_limit;
+        };
+
+        void flush(pdal::point_count_t count);
+        void rethrowFlushError();
+
         const pdal::point_count_t m_defaultChunkSize;
         pdal::point_count_t m_currentIndex;
         std::map<std::string, std::vector<double>> m_doubleBuffers;
@@ -77,6 +105,10 @@ class PDAL_DLL E57Writer : public pdal::Writer, public pdal::Streamable
         std::unique_ptr<e57::CompressedVectorWriter> m_dataWriter;
         uint64_t m_colorLimit;
         uint64_t m_intensityLimit;
+        std::vector<Field> m_fields;
+        std::unique_ptr<pdal::ThreadPool> m_packPool;
+        pdal::ThreadPool m_flushPool;
+        std::exception_ptr m_flushError;
     };
 
 public:
@@ -103,6 +135,7 @@ private:
     // Writer parameters
     std::string m_filename;
     bool m_doublePrecision;
+    int m_threads;
 
     // e57 file objects
     std::unique_ptr<e57::ImageFile> m_imageFile;
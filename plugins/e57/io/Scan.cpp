@@ -76,6 +76,16 @@ void Scan::transformPoint(pdal::PointRef& pt) const
     pt.setField(pdal::Dimension::Id::Z,  x*m_rotation[2][0] + y*m_rotation[2][1] + z*m_rotation[2][2]  + m_translation[2]);
 }
 
+void Scan::transformPoint(double& x, double& y, double& z) const
+{
+    double tx = x*m_rotation[0][0] + y*m_rotation[0][1] + z*m_rotation[0][2] + m_translation[0];
+    double ty = x*m_rotation[1][0] + y*m_rotation[1][1] + z*m_rotation[1][2] + m_translation[1];
+    double tz = x*m_rotation[2][0] + y*m_rotation[2][1] + z*m_rotation[2][2] + m_translation[2];
+    x = tx;
+    y = ty;
+    z = tz;
+}
+
 std::array<double,3>
 Scan::transformPoint(const std::array<double,3> &originalPoint) const
 {
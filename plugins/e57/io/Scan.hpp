@@ -54,6 +54,7 @@ public:
     e57::CompressedVectorNode getPoints() const;
     bool hasPose() const;
     void transformPoint(pdal::PointRef& pt) const;
+    void transformPoint(double& x, double& y, double& z) const;
     pdal::BOX3D getBoundingBox() const;
     double rescale(pdal::Dimension::Id dim, double value);
     StructureNode getPointPrototype();
@@ -165,6 +165,39 @@ TEST(E57Reader, testMultipleClouds)
     }
 }
 
+TEST(E57Reader, testParallelRead)
+{
+    PointTable serialTable;
+    PointViewSet serialSet =
+        readertest_readE57(Support::datapath("e57/A_B.e57"), serialTable);
+    auto serialCloud = *serialSet.begin();
+
+    Options ops;
+    ops.add("filename", Support::datapath("e57/A_B.e57"));
+    ops.add("threads", 4);
+    E57Reader reader;
+    reader.setOptions(ops);
+    PointTable table;
+    reader.prepare(table);
+    PointViewSet viewSet = reader.execute(table);
+    ASSERT_EQ(viewSet.size(), 1u);
+    auto cloud = *viewSet.begin();
+    ASSERT_EQ(cloud->size(), serialCloud->size());
+
+    auto expectedDimensions = {pdal::Dimension::Id::X,pdal::Dimension::Id::Y,
+                               pdal::Dimension::Id::Z,pdal::Dimension::Id::Red,
+                               pdal::Dimension::Id::Green,pdal::Dimension::Id::Blue
+                              };
+    for (PointId i = 0; i < cloud->size(); ++i)
+    {
+        auto pt = cloud->point(i);
+        auto serialPt = serialCloud->point(i);
+        for (auto& dim: expectedDimensions)
+            ASSERT_FLOAT_EQ(pt.getFieldAs<float>(dim),
+                            serialPt.getFieldAs<float>(dim));
+    }
+}
+
 TEST(E57Reader, testTransformMerge)
 {
     PointTable table;
@@ -42,6 +42,21 @@ namespace pdal
 
 using namespace hdf5;
 
+namespace
+{
+
+// Open a dataset with a chunk cache large enough to hold the chunks
+// spanned by one batched hyperslab read, so a chunk crossing a batch
+// boundary is not decompressed twice.
+H5::DataSet openDataset(H5::H5File *file, const std::string& datasetName)
+{
+    H5::DSetAccPropList dapl;
+    dapl.setChunkCache(12421, (size_t)16 << 20, H5D_CHUNK_CACHE_W0_DEFAULT);
+    return file->openDataSet(datasetName, dapl);
+}
+
+} // unnamed namespace
+
 void Handler::setLog(pdal::LogPtr log) {
     m_logger = log;
 }
@@ -88,9 +103,9 @@ uint8_t *DimInfo::getValue(pdal::point_count_t pointIndex) {
         // load new chunk
         H5::DataSpace dspace = m_dset.getSpace();
 
-        chunkLowerBound = (pointIndex / m_chunkSize) * m_chunkSize;
+        chunkLowerBound = (pointIndex / m_batchSize) * m_batchSize;
         chunkUpperBound =
-            (std::min)(chunkLowerBound + m_chunkSize, m_numPoints);
+            (std::min)(chunkLowerBound + m_batchSize, m_numPoints);
 
         hsize_t selectionSize = chunkUpperBound - chunkLowerBound;
 
@@ -118,7 +133,7 @@ DimInfo::DimInfo(
     H5::H5File *file
     )
     : m_name(dimName)
-    , m_dset(file->openDataSet(datasetName))
+    , m_dset(openDataset(file, datasetName))
     {
         // Will throw if dataset doesn't exists. Gives adequate error message
         H5::DataSpace dspace = m_dset.getSpace();
@@ -162,8 +177,15 @@ DimInfo::DimInfo(
                 "unsupported type. Only integer and float types are supported.");
         }
 
+        // Batch several chunks into each read.  The hyperslab selections
+        // stay aligned to chunk boundaries, but one H5Dread call now
+        // replaces many per-chunk requests.
+        hsize_t batchBytes = (hsize_t)16 << 20;
+        m_batchSize = m_chunkSize *
+            (std::max)((hsize_t)1, batchBytes / (m_chunkSize * m_size));
+
         //allocate buffer for getValue() to write into
-        m_buffer.resize(m_chunkSize*m_size);
+        m_buffer.resize(m_batchSize*m_size);
     }
 
 
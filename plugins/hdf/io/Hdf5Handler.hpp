@@ -76,7 +76,8 @@ private:
     hsize_t chunkUpperBound = 0,
             chunkLowerBound = 0,
             m_numPoints = 0,
-            m_chunkSize;
+            m_chunkSize,
+            m_batchSize;
     H5::DataSet m_dset;
     size_t m_size;
 };
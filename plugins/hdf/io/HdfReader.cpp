@@ -37,6 +37,7 @@
 #include <pdal/pdal_types.hpp>
 #include <pdal/PointView.hpp>
 #include <pdal/util/ProgramArgs.hpp>
+#include <pdal/util/ThreadPool.hpp>
 #include "Hdf5Handler.hpp"
 
 #include <map>
@@ -83,18 +84,45 @@ void HdfReader::ready(PointTableRef table)
 point_count_t HdfReader::read(PointViewPtr view, point_count_t count)
 {
     PointId startId = view->size();
-    point_count_t remaining = m_hdf5Handler->getNumPoints() - m_index;
+    uint64_t numPoints = m_hdf5Handler->getNumPoints();
+    point_count_t remaining = numPoints - m_index;
     count = (std::min)(count, remaining);
-    PointId nextId = startId;
 
-    for(uint64_t pi = 0; pi < m_hdf5Handler->getNumPoints(); pi++) {
-        for(hdf5::DimInfo& dim : m_hdf5Handler->getDimensions()) {
+    std::vector<hdf5::DimInfo>& dims = m_hdf5Handler->getDimensions();
+    if (dims.empty() || numPoints == 0)
+        return count;
+
+    // Copy dimension-major so each dataset is scanned once, sequentially,
+    // through its batched reads instead of interleaving batch loads
+    // across every dataset.
+    auto copyDim = [this, view, startId, numPoints](hdf5::DimInfo& dim)
+    {
+        PointId nextId = startId;
+        for(uint64_t pi = 0; pi < numPoints; pi++) {
             uint8_t *p = dim.getValue(pi);
-            view->setField(dim.getId(), dim.getPdalType(), nextId, (void*) p);
+            view->setField(dim.getId(), dim.getPdalType(), nextId++, (void*) p);
         }
-        m_index++;
-        nextId++;
+    };
+
+    // The first dataset is copied serially so every point exists in the
+    // view before the remaining datasets, which write to disjoint
+    // dimensions, are filled concurrently.
+    copyDim(dims.front());
+    size_t threads = (std::min)((size_t)(std::max)(m_threads, 1),
+        dims.size() - 1);
+    if (threads <= 1)
+    {
+        for (size_t d = 1; d < dims.size(); ++d)
+            copyDim(dims[d]);
+    }
+    else
+    {
+        ThreadPool pool(threads);
+        for (size_t d = 1; d < dims.size(); ++d)
+            pool.add([&copyDim, &dims, d]() { copyDim(dims[d]); });
+        pool.await();
     }
+    m_index += numPoints;
 
     return count;
 }
@@ -114,6 +142,8 @@ bool HdfReader::processOne(PointRef& point)
 void HdfReader::addArgs(ProgramArgs& args)
 {
     args.add("dimensions", "Map of HDF path to PDAL dimension", m_pathDimJson);
+    args.add("threads", "Number of threads used to read datasets "
+        "(requires a thread-safe HDF5 build)", m_threads, 1);
 }
 
 void HdfReader::initialize()
@@ -72,6 +72,7 @@ private:
     virtual void done(PointTableRef table) override;
 
     NL::json m_pathDimJson;
+    int m_threads;
     std::map<std::string,std::string> m_pathDimMap;
     Dimension::IdList m_idlist;
     void parseDimensions();
@@ -349,7 +349,8 @@ void EsriReader::ready(PointTableRef table)
     // index to get the proper filename for a page.
     int indexFactor = m_version >= Version("2.0") ? 1 : m_nodeCap;
     i3s::FetchFunction fetch = std::bind(&EsriReader::fetchJson, this, std::placeholders::_1);
-    m_pageManager.reset(new PageManager(100, 4, indexFactor, fetch));
+    m_pageManager.reset(
+        new PageManager(100, m_args->threads, indexFactor, fetch));
     PagePtr p = m_pageManager->getPage(0);
     traverseTree(p, 0);
     m_pool->await();
@@ -367,7 +368,9 @@ void EsriReader::ready(PointTableRef table)
     }
     else
     {
-        int count = 4;
+        // Keep enough tiles in flight that the fetch/decode workers
+        // stay busy while points are handed out one at a time.
+        int count = (std::max)(4, m_args->threads);
         m_curNodeIdx = 0;
         while (m_curNodeIdx < m_nodes.size() && count)
         {
@@ -598,6 +601,12 @@ void EsriReader::traverseTree(PagePtr page, int node)
     if (cCount == 0)
         return;
 
+    // Density grows with depth, so once a node is at or past the density
+    // ceiling none of its descendants can be selected and their node
+    // pages don't need to be fetched.
+    if (m_args->max_density >= 0 && density >= m_args->max_density)
+        return;
+
     for (int i = 0; i < cCount; ++i)
     {
         int node = firstChild + i;
@@ -221,7 +221,7 @@ double timeconvert(int time_i[7])
 
 } // namespace
 
-bool MbReader::loadData()
+bool MbReader::loadData(point_count_t target)
 {
     int verbose = 0;
     int kind;
@@ -241,7 +241,20 @@ bool MbReader::loadData()
     char comment[MB_COMMENT_MAXLINE];
     int error;
 
-    while (true)
+    // Restart the buffer once everything's been consumed.
+    if (m_pos == m_bufX.size())
+    {
+        m_pos = 0;
+        m_bufX.clear();
+        m_bufY.clear();
+        m_bufZ.clear();
+        m_bufVal.clear();
+        m_bufTime.clear();
+    }
+
+    // Read pings until 'target' soundings are buffered (or EOF) so
+    // consumers work on batches rather than single pings.
+    while (m_bufX.size() - m_pos < target)
     {
         int status = mb_read(verbose, m_ctx, &kind, &pings, pingTime,
             &pingTimeT, &lon, &lat, &speed, &heading, &distance, &altitude,
@@ -255,82 +268,85 @@ bool MbReader::loadData()
         {
             if (error > 0 && error != MB_ERROR_EOF)
                 throwError("Error reading data: " + MbError::text(error));
-            return false;
+            break;
         }
 
         if (kind == 1)
         {
-            bool ok(false);
             if (m_dataType == DataType::Multibeam)
-                ok = extractMultibeam(numBath, numAmp, gpsTime);
+                extractMultibeam(numBath, numAmp, gpsTime);
             else
-                ok = extractSidescan(numSs, gpsTime);
-            if (ok)
-                break;
+                extractSidescan(numSs, gpsTime);
         }
     }
-    return true;
+    return m_bufX.size() > m_pos;
 }
 
 
-bool MbReader::extractMultibeam(int numBath, int numAmp, double gpsTime)
+void MbReader::extractMultibeam(int numBath, int numAmp, double gpsTime)
 {
-    for (size_t i = 0; i < (size_t)numBath; ++i)
-    {
-        if (m_bathflag[i] & 1)
-            continue;
-        m_bathQueue.emplace(m_bathlon[i], m_bathlat[i], -m_bath[i],
-                m_amp[i], gpsTime);
-    }
+    // Gather the unflagged beam positions once, then copy each of the
+    // ping's arrays column-wise.
+    m_valid.clear();
+    for (int i = 0; i < numBath; ++i)
+        if (!(m_bathflag[i] & 1))
+            m_valid.push_back(i);
+
+    size_t pos = m_bufX.size();
+    m_bufX.resize(pos + m_valid.size());
+    m_bufY.resize(pos + m_valid.size());
+    m_bufZ.resize(pos + m_valid.size());
+    m_bufVal.resize(pos + m_valid.size());
+    for (size_t i = 0; i < m_valid.size(); ++i)
+        m_bufX[pos + i] = m_bathlon[m_valid[i]];
+    for (size_t i = 0; i < m_valid.size(); ++i)
+        m_bufY[pos + i] = m_bathlat[m_valid[i]];
+    for (size_t i = 0; i < m_valid.size(); ++i)
+        m_bufZ[pos + i] = -m_bath[m_valid[i]];
+    for (size_t i = 0; i < m_valid.size(); ++i)
+        m_bufVal[pos + i] = m_amp[m_valid[i]];
+    m_bufTime.resize(pos + m_valid.size(), gpsTime);
+
     if (numBath != numAmp)
         log()->get(LogLevel::Warning) << getName() << ": Number of "
             "bathymetry values doesn't match number of amplitude "
             "values." << std::endl;
-    return m_bathQueue.size();
 }
 
 
-bool MbReader::extractSidescan(int numSs, double gpsTime)
+void MbReader::extractSidescan(int numSs, double gpsTime)
 {
-    for (size_t i = 0; i < (size_t)numSs; ++i)
-        m_ssQueue.emplace(m_sslon[i], m_sslat[i], m_ss[i], gpsTime);
-    return m_ssQueue.size();
+    size_t pos = m_bufX.size();
+    m_bufX.resize(pos + numSs);
+    m_bufY.resize(pos + numSs);
+    m_bufVal.resize(pos + numSs);
+    for (int i = 0; i < numSs; ++i)
+        m_bufX[pos + i] = m_sslon[i];
+    for (int i = 0; i < numSs; ++i)
+        m_bufY[pos + i] = m_sslat[i];
+    for (int i = 0; i < numSs; ++i)
+        m_bufVal[pos + i] = m_ss[i];
+    m_bufTime.resize(pos + numSs, gpsTime);
 }
 
 
 bool MbReader::processOne(PointRef& point)
 {
+    if (m_pos == m_bufX.size())
+        if (!loadData(1))
+            return false;
+
+    point.setField(Dimension::Id::X, m_bufX[m_pos]);
+    point.setField(Dimension::Id::Y, m_bufY[m_pos]);
+    point.setField(Dimension::Id::GpsTime, m_bufTime[m_pos]);
     if (m_dataType == DataType::Multibeam)
     {
-        if (m_bathQueue.empty())
-            if (!loadData())
-            {
-                return false;
-            }
-
-        BathData& bd = m_bathQueue.front();
-
-        point.setField(Dimension::Id::X, bd.m_bathlon);
-        point.setField(Dimension::Id::Y, bd.m_bathlat);
-        point.setField(Dimension::Id::Z, bd.m_bath);
-        point.setField(Dimension::Id::GpsTime, bd.m_time);
-        point.setField(Dimension::Id::Amplitude, bd.m_amp);
-        m_bathQueue.pop();
+        point.setField(Dimension::Id::Z, m_bufZ[m_pos]);
+        point.setField(Dimension::Id::Amplitude, m_bufVal[m_pos]);
     }
     else // Sidescan
-    {
-        if (m_ssQueue.empty())
-            if (!loadData())
-                return false;
-
-        SidescanData& ss = m_ssQueue.front();
-
-        point.setField(Dimension::Id::X, ss.m_sslon);
-        point.setField(Dimension::Id::Y, ss.m_sslat);
-        point.setField(Dimension::Id::GpsTime, ss.m_time);
-        point.setField(Dimension::Id::Intensity, ss.m_ss);
-        m_ssQueue.pop();
-    }
+        point.setField(Dimension::Id::Intensity, m_bufVal[m_pos]);
+    m_pos++;
     return true;
 }
 
@@ -354,15 +370,42 @@ point_count_t MbReader::read(PointViewPtr view, point_count_t count)
 {
     using namespace pdal::Dimension;
 
-    PointRef point = view->point(0);
-    PointId id;
-    for (id = 0; id < count; ++id)
+    // Batch points, one drain per loaded buffer and one pass per
+    // dimension over each drain.
+    const point_count_t BatchPoints = 16384;
+
+    PointId startId = view->size();
+    point_count_t numRead = 0;
+    while (numRead < count)
     {
-        point.setPointId(id);
-        if (!processOne(point))
-            break;
+        if (m_pos == m_bufX.size())
+            if (!loadData((std::min)(count - numRead, BatchPoints)))
+                break;
+        point_count_t n = (std::min)(count - numRead,
+            (point_count_t)(m_bufX.size() - m_pos));
+
+        PointId id = startId + numRead;
+        for (point_count_t i = 0; i < n; ++i)
+            view->setField(Id::X, id + i, m_bufX[m_pos + i]);
+        for (point_count_t i = 0; i < n; ++i)
+            view->setField(Id::Y, id + i, m_bufY[m_pos + i]);
+        for (point_count_t i = 0; i < n; ++i)
+            view->setField(Id::GpsTime, id + i, m_bufTime[m_pos + i]);
+        if (m_dataType == DataType::Multibeam)
+        {
+            for (point_count_t i = 0; i < n; ++i)
+                view->setField(Id::Z, id + i, m_bufZ[m_pos + i]);
+            for (point_count_t i = 0; i < n; ++i)
+                view->setField(Id::Amplitude, id + i, m_bufVal[m_pos + i]);
+        }
+        else // Sidescan
+            for (point_count_t i = 0; i < n; ++i)
+                view->setField(Id::Intensity, id + i, m_bufVal[m_pos + i]);
+
+        m_pos += n;
+        numRead += n;
     }
-    return id;
+    return numRead;
 }
 
 
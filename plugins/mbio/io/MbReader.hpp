@@ -34,7 +34,7 @@
 
 #pragma once
 
-#include <queue>
+#include <vector>
 
 #include <pdal/Reader.hpp>
 #include <pdal/Streamable.hpp>
@@ -52,37 +52,8 @@ extern "C"
 namespace pdal
 {
 
-struct BathData;
-
 class PDAL_DLL MbReader : public Reader, public Streamable
 {
-    struct BathData
-    {
-        double m_bathlon;
-        double m_bathlat;
-        double m_bath;
-        double m_amp;
-        double m_time;
-
-        BathData(double bathlon, double bathlat, double bath, double amp,
-                double time) :
-            m_bathlon(bathlon), m_bathlat(bathlat), m_bath(bath), m_amp(amp),
-            m_time(time)
-        {}
-    };
-
-    struct SidescanData
-    {
-        double m_sslon;
-        double m_sslat;
-        double m_ss;
-        double m_time;
-
-        SidescanData(double sslon, double sslat, double ss, double time) :
-            m_sslon(sslon), m_sslat(sslat), m_ss(ss), m_time(time)
-        {}
-    };
-
     enum class DataType
     {
         Multibeam,
@@ -104,9 +75,9 @@ private:
     virtual void ready(PointTableRef table);
     virtual point_count_t read(PointViewPtr view, point_count_t count);
     virtual void done(PointTableRef table);
-    bool loadData();
-    bool extractMultibeam(int numBath, int numAmp, double time);
-    bool extractSidescan(int numSs, double time);
+    bool loadData(point_count_t target);
+    void extractMultibeam(int numBath, int numAmp, double time);
+    void extractSidescan(int numSs, double time);
 
     friend std::istream& operator>>(std::istream& in,
         MbReader::DataType& mode);
@@ -122,8 +93,15 @@ private:
     double *m_ss;
     double *m_sslon;
     double *m_sslat;
-    std::queue<BathData> m_bathQueue;
-    std::queue<SidescanData> m_ssQueue;
+    // Buffered soundings, one column per dimension.  Pings are decoded
+    // into these column-wise; m_pos is the read cursor.
+    std::vector<double> m_bufX;
+    std::vector<double> m_bufY;
+    std::vector<double> m_bufZ;
+    std::vector<double> m_bufVal;
+    std::vector<double> m_bufTime;
+    std::vector<int> m_valid;
+    point_count_t m_pos = 0;
     MbFormat m_format;
     double m_timegap;
     double m_speedmin;
@@ -156,6 +156,11 @@ protected:
         m_streamIf.reset(new NitfStreamIf(m_filename, m_offset));
     }
 
+    // The LAS data is embedded in a DES segment, so the container file
+    // is mapped in place and point reads are shifted to the segment.
+    virtual uintmax_t mapOffset() const
+    { return m_offset; }
+
 private:
     uint64_t m_offset;
     uint64_t m_length;
@@ -73,6 +73,8 @@ PgWriter::PgWriter()
     , m_srid(0)
     , m_pcid(0)
     , m_overwrite(true)
+    , m_patchesInCopy(0)
+    , m_copyActive(false)
     , m_schema_is_initialized(false)
 {}
 
@@ -98,6 +100,9 @@ void PgWriter::addArgs(ProgramArgs& args)
     args.add("pcid", "PCID", m_pcid);
     args.add("pre_sql", "SQL to execute before query", m_pre_sql);
     args.add("post_sql", "SQL to execute after query", m_post_sql);
+    args.add("copy_batch_size", "Number of patches streamed per COPY "
+        "command (0 inserts each patch with its own statement)",
+        m_copyBatchSize, 1000U);
 }
 
 
@@ -163,6 +168,8 @@ void PgWriter::done(PointTableRef /*table*/)
 {
     //CreateIndex(m_schema_name, m_table_name, m_column_name);
 
+    endCopy();
+
     if (m_post_sql.size())
     {
         std::string sql = FileUtils::readFileIntoString(m_post_sql);
@@ -419,9 +426,6 @@ void PgWriter::writeTile(const PointViewPtr view)
     size_t maxHexrepSize = packedPointSize() * view->size() * 2;
     hexrep.reserve(maxHexrepSize);
 
-    m_insert.clear();
-    m_insert.reserve(maxHexrepSize + 3000);
-
     for (PointId idx = 0; idx < view->size(); ++idx)
     {
         size_t size = readPoint(*view.get(), idx, storage.data());
@@ -437,21 +441,6 @@ void PgWriter::writeTile(const PointViewPtr view)
         }
     }
 
-    std::string insert_into("INSERT INTO ");
-    std::string values(" (" + pg_quote_identifier(m_column_name) +
-                       ") VALUES ('");
-
-    m_insert.append(insert_into);
-
-    if (m_schema_name.size())
-    {
-        m_insert.append(pg_quote_identifier(m_schema_name));
-        m_insert.append(".");
-    }
-
-    m_insert.append(pg_quote_identifier(m_table_name));
-    m_insert.append(values);
-
     std::ostringstream options;
 
     if (view->size() > (std::numeric_limits<uint32_t>::max)())
@@ -474,6 +463,40 @@ void PgWriter::writeTile(const PointViewPtr view)
     // needs to be 4 bytes
     options << std::hex << std::setfill('0') << std::setw(8) << num_points;
 
+    if (m_copyBatchSize)
+    {
+        // Stream the patch as one COPY row instead of parsing a
+        // statement per patch.
+        if (!m_copyActive)
+            startCopy();
+
+        m_insert.clear();
+        m_insert.reserve(maxHexrepSize + 100);
+        m_insert.append(options.str());
+        m_insert.append(hexrep);
+        m_insert.push_back('\n');
+
+        if (PQputCopyData(m_session, m_insert.data(),
+                (int)m_insert.size()) != 1)
+            throwError(PQerrorMessage(m_session));
+        if (++m_patchesInCopy >= m_copyBatchSize)
+            endCopy();
+        return;
+    }
+
+    m_insert.clear();
+    m_insert.reserve(maxHexrepSize + 3000);
+    m_insert.append("INSERT INTO ");
+
+    if (m_schema_name.size())
+    {
+        m_insert.append(pg_quote_identifier(m_schema_name));
+        m_insert.append(".");
+    }
+
+    m_insert.append(pg_quote_identifier(m_table_name));
+    m_insert.append(" (" + pg_quote_identifier(m_column_name) +
+        ") VALUES ('");
     m_insert.append(options.str());
     m_insert.append(hexrep);
     m_insert.append("')");
@@ -481,4 +504,53 @@ void PgWriter::writeTile(const PointViewPtr view)
     pg_execute(m_session, m_insert);
 }
 
+
+/// Issue a COPY ... FROM STDIN so patches can be streamed as rows of
+/// hex-encoded WKB.  The COPY is ended and restarted every
+/// copy_batch_size patches so errors surface as the load progresses.
+void PgWriter::startCopy()
+{
+    std::ostringstream oss;
+    oss << "COPY ";
+    if (m_schema_name.size())
+        oss << pg_quote_identifier(m_schema_name) << ".";
+    oss << pg_quote_identifier(m_table_name) << " (" <<
+        pg_quote_identifier(m_column_name) << ") FROM STDIN";
+
+    PGresult *result = PQexec(m_session, oss.str().c_str());
+    if (!result || PQresultStatus(result) != PGRES_COPY_IN)
+    {
+        std::string errmsg = PQerrorMessage(m_session);
+        PQclear(result);
+        throwError(errmsg);
+    }
+    PQclear(result);
+    m_copyActive = true;
+    m_patchesInCopy = 0;
+}
+
+
+void PgWriter::endCopy()
+{
+    if (!m_copyActive)
+        return;
+
+    if (PQputCopyEnd(m_session, NULL) != 1)
+        throwError(PQerrorMessage(m_session));
+
+    PGresult *result;
+    while ((result = PQgetResult(m_session)))
+    {
+        if (PQresultStatus(result) != PGRES_COMMAND_OK)
+        {
+            std::string errmsg = PQresultErrorMessage(result);
+            PQclear(result);
+            throwError(errmsg);
+        }
+        PQclear(result);
+    }
+    m_copyActive = false;
+    m_patchesInCopy = 0;
+}
+
 } // namespace pdal
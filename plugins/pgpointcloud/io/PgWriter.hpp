@@ -60,6 +60,8 @@ private:
 
     void writeInit();
     void writeTile(const PointViewPtr view);
+    void startCopy();
+    void endCopy();
 
     bool CheckTableExists(std::string const& name);
     bool CheckPointCloudExists();
@@ -92,6 +94,9 @@ private:
     uint32_t m_srid;
     uint32_t m_pcid;
     bool m_overwrite;
+    uint32_t m_copyBatchSize;
+    uint32_t m_patchesInCopy;
+    bool m_copyActive;
     std::string m_insert;
     Orientation m_orientation;
     std::string m_pre_sql;
@@ -36,6 +36,9 @@
 
 #include <nlohmann/json.hpp>
 
+#include <pdal/PointView.hpp>
+#include <pdal/util/Utils.hpp>
+
 #include "TileDBReader.hpp"
 
 
@@ -105,6 +108,9 @@ void TileDBReader::addArgs(ProgramArgs& args)
     args.add("stats", "Dump TileDB query stats to stdout", m_stats, false);
     args.add("bbox3d", "Bounding box subarray to read from TileDB in format "
         "([minx, maxx], [miny, maxy], [minz, maxz])", m_bbox);
+    args.add("query_condition", "Attribute predicates pushed into the "
+        "TileDB query, e.g. \"Classification = 2 AND Intensity >= 10\"",
+        m_queryConditionSpec);
 }
 
 void TileDBReader::prepared(PointTableRef table)
@@ -306,6 +312,11 @@ void TileDBReader::localReady()
         m_query->set_subarray(subarray);
     }
 
+    // Push attribute predicates into the query so TileDB filters cells
+    // before they're materialized.
+    if (m_queryConditionSpec.size())
+        setQueryCondition();
+
     // read spatial reference
     NL::json meta = nullptr;
 
@@ -350,6 +361,128 @@ void TileDBReader::localReady()
     m_complete = false;
 }
 
+
+// Translate the query_condition option - comparisons of the form
+// "<attribute> <op> <value>" joined with AND - into a TileDB query
+// condition so cells are filtered before they're materialized.
+void TileDBReader::setQueryCondition()
+{
+#if TILEDB_VERSION_MAJOR > 2 || \
+    (TILEDB_VERSION_MAJOR == 2 && TILEDB_VERSION_MINOR >= 3)
+    std::unique_ptr<tiledb::QueryCondition> condition;
+
+    StringList clauses;
+    std::string spec = m_queryConditionSpec;
+    size_t pos;
+    while ((pos = spec.find(" AND ")) != std::string::npos)
+    {
+        clauses.push_back(spec.substr(0, pos));
+        spec = spec.substr(pos + 5);
+    }
+    clauses.push_back(spec);
+
+    for (std::string clause : clauses)
+    {
+        Utils::trim(clause);
+        size_t opPos = clause.find_first_of("<>!=");
+        if (opPos == std::string::npos || opPos == 0)
+            throwError("Invalid clause '" + clause +
+                "' in 'query_condition'.");
+
+        std::string name = clause.substr(0, opPos);
+        Utils::trim(name);
+        std::string op;
+        while (opPos < clause.size() &&
+                std::string("<>!=").find(clause[opPos]) != std::string::npos)
+            op += clause[opPos++];
+        std::string value = clause.substr(opPos);
+        Utils::trim(value);
+
+        tiledb_query_condition_op_t tileOp;
+        if (op == "=" || op == "==")
+            tileOp = TILEDB_EQ;
+        else if (op == "!=")
+            tileOp = TILEDB_NE;
+        else if (op == "<")
+            tileOp = TILEDB_LT;
+        else if (op == "<=")
+            tileOp = TILEDB_LE;
+        else if (op == ">")
+            tileOp = TILEDB_GT;
+        else if (op == ">=")
+            tileOp = TILEDB_GE;
+        else
+            throwError("Invalid operator '" + op +
+                "' in 'query_condition'.");
+
+        auto it = std::find_if(m_dims.begin(), m_dims.end(),
+            [&name](const DimInfo& di){ return di.m_name == name; });
+        if (it == m_dims.end() ||
+            it->m_dimCategory != DimCategory::Attribute)
+            throwError("'query_condition' field '" + name +
+                "' isn't a TileDB attribute.");
+
+        double d;
+        if (!Utils::fromString(value, d))
+            throwError("Invalid value '" + value +
+                "' for 'query_condition' field '" + name + "'.");
+
+        std::unique_ptr<tiledb::QueryCondition> qc;
+        auto make = [&](auto v)
+        {
+            v = (decltype(v))d;
+            qc.reset(new tiledb::QueryCondition(
+                tiledb::QueryCondition::create(*m_ctx, name, v, tileOp)));
+        };
+        switch (it->m_tileType)
+        {
+        case TILEDB_INT8:
+            make(int8_t(0));
+            break;
+        case TILEDB_UINT8:
+            make(uint8_t(0));
+            break;
+        case TILEDB_INT16:
+            make(int16_t(0));
+            break;
+        case TILEDB_UINT16:
+            make(uint16_t(0));
+            break;
+        case TILEDB_INT32:
+            make(int32_t(0));
+            break;
+        case TILEDB_UINT32:
+            make(uint32_t(0));
+            break;
+        case TILEDB_INT64:
+            make(int64_t(0));
+            break;
+        case TILEDB_UINT64:
+            make(uint64_t(0));
+            break;
+        case TILEDB_FLOAT32:
+            make(float(0));
+            break;
+        case TILEDB_FLOAT64:
+            make(double(0));
+            break;
+        default:
+            throwError("'query_condition' field '" + name +
+                "' has an unsupported type.");
+        }
+
+        if (condition)
+            condition.reset(new tiledb::QueryCondition(
+                condition->combine(*qc, TILEDB_AND)));
+        else
+            condition = std::move(qc);
+    }
+    m_query->set_condition(*condition);
+#else
+    throwError("'query_condition' requires TileDB 2.3 or later.");
+#endif
+}
+
 namespace
 {
 
@@ -415,49 +548,52 @@ bool TileDBReader::processOne(PointRef& point)
 }
 
 
-bool TileDBReader::processPoint(PointRef& point)
+// Submit the query for the next batch of results.  Returns false when
+// no batches remain.
+bool TileDBReader::nextBatch()
 {
-    if (m_offset == m_resultSize)
-    {
-        if (m_complete)
-        {
-            return false;
-        }
-        else
-        {
-            tiledb::Query::Status status;
+    if (m_complete)
+        return false;
 
-            m_query->submit();
+    tiledb::Query::Status status;
 
-            if (m_stats)
-            {
-                tiledb::Stats::dump(stdout);
-                tiledb::Stats::reset();
-            }
+    m_query->submit();
+
+    if (m_stats)
+    {
+        tiledb::Stats::dump(stdout);
+        tiledb::Stats::reset();
+    }
 
-            status = m_query->query_status();
+    status = m_query->query_status();
 
-            // The result buffer count represents the total number of items
-            // returned by the query for dimensions.  So if there are three
-            // dimensions, the number of points returned is the buffer count
-            // divided by the number of dimensions.
+    // The result buffer count represents the total number of items
+    // returned by the query for dimensions.  So if there are three
+    // dimensions, the number of points returned is the buffer count
+    // divided by the number of dimensions.
 #if TILEDB_VERSION_MAJOR == 1
-            m_resultSize =
-                (int)m_query->result_buffer_elements()[TILEDB_COORDS].second /
-                m_array->schema().domain().dimensions().size();
+    m_resultSize =
+        (int)m_query->result_buffer_elements()[TILEDB_COORDS].second /
+        m_array->schema().domain().dimensions().size();
 #else
-            m_resultSize = (int)m_query->result_buffer_elements()["X"].second;
+    m_resultSize = (int)m_query->result_buffer_elements()["X"].second;
 #endif
-            if (status == tiledb::Query::Status::INCOMPLETE &&
-                    m_resultSize == 0)
-                throwError("Need to increase chunk_size for reader.");
+    if (status == tiledb::Query::Status::INCOMPLETE && m_resultSize == 0)
+        throwError("Need to increase chunk_size for reader.");
 
-            if (status == tiledb::Query::Status::COMPLETE)
-                m_complete = true;
+    if (status == tiledb::Query::Status::COMPLETE)
+        m_complete = true;
 
-            m_offset = 0;
-        }     
-    }
+    m_offset = 0;
+    return true;
+}
+
+
+bool TileDBReader::processPoint(PointRef& point)
+{
+    if (m_offset == m_resultSize)
+        if (!nextBatch())
+            return false;
 
     if (m_resultSize > 0)
     {
@@ -474,17 +610,100 @@ bool TileDBReader::processPoint(PointRef& point)
     }
 }
 
-point_count_t TileDBReader::read(PointViewPtr view, point_count_t count)
+template <typename T>
+void TileDBReader::copyDim(PointView& view, const DimInfo& di, PointId begin,
+    point_count_t count)
+{
+    TypedField<T> field(view, di.m_id);
+    const T *src = di.m_buffer->get<T>() + m_offset * di.m_span + di.m_offset;
+    for (point_count_t i = 0; i < count; ++i)
+    {
+        field.set(begin + i, *src);
+        src += di.m_span;
+    }
+}
+
+
+// Store a run of batch results column by column, so the type dispatch
+// happens once per dimension instead of once per field.
+void TileDBReader::copyBatch(PointView& view, PointId begin,
+    point_count_t count)
 {
-    PointRef point = view->point(0);
-    PointId id;
-    for (id = 0; id < count; ++id)
+    for (const DimInfo& di : m_dims)
     {
-        point.setPointId(id);
-        if (!processOne(point))
+        switch (di.m_type)
+        {
+        case Dimension::Type::Signed8:
+            copyDim<int8_t>(view, di, begin, count);
+            break;
+        case Dimension::Type::Unsigned8:
+            copyDim<uint8_t>(view, di, begin, count);
+            break;
+        case Dimension::Type::Signed16:
+            copyDim<int16_t>(view, di, begin, count);
+            break;
+        case Dimension::Type::Unsigned16:
+            copyDim<uint16_t>(view, di, begin, count);
+            break;
+        case Dimension::Type::Signed32:
+            copyDim<int32_t>(view, di, begin, count);
+            break;
+        case Dimension::Type::Unsigned32:
+            copyDim<uint32_t>(view, di, begin, count);
+            break;
+        case Dimension::Type::Signed64:
+            copyDim<int64_t>(view, di, begin, count);
+            break;
+        case Dimension::Type::Unsigned64:
+            copyDim<uint64_t>(view, di, begin, count);
             break;
+        case Dimension::Type::Float:
+            copyDim<float>(view, di, begin, count);
+            break;
+        case Dimension::Type::Double:
+            copyDim<double>(view, di, begin, count);
+            break;
+        default:
+            throwError("Invalid dimension type when setting data.");
+        }
+    }
+}
+
+
+point_count_t TileDBReader::readBatches(PointViewPtr view,
+    point_count_t count)
+{
+    point_count_t numRead = 0;
+
+    while (numRead < count)
+    {
+        if (m_offset == m_resultSize)
+            if (!nextBatch())
+                break;
+        if (!m_resultSize)
+            break;
+
+        point_count_t n =
+            (std::min)(m_resultSize - m_offset, count - numRead);
+        copyBatch(*view, view->size(), n);
+        m_offset += n;
+        numRead += n;
+    }
+    return numRead;
+}
+
+
+point_count_t TileDBReader::read(PointViewPtr view, point_count_t count)
+{
+    try
+    {
+        return readBatches(view, count);
+    }
+    catch (const tiledb::TileDBError& err)
+    {
+        throwError(std::string("TileDB Error: ") + err.what());
     }
-    return id;   
+    return 0;
 }
 
 void TileDBReader::done(pdal::BasePointTable &table)
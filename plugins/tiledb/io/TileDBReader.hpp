@@ -95,8 +95,16 @@ private:
     virtual void done(PointTableRef table);
     void localReady();
     bool processPoint(PointRef& point);
+    bool nextBatch();
+    point_count_t readBatches(PointViewPtr view, point_count_t count);
+    void copyBatch(PointView& view, PointId begin, point_count_t count);
+    template <typename T>
+    void copyDim(PointView& view, const DimInfo& di, PointId begin,
+        point_count_t count);
+    void setQueryCondition();
 
     std::string m_cfgFileName;
+    std::string m_queryConditionSpec;
     point_count_t m_chunkSize;
     point_count_t m_offset;
     point_count_t m_resultSize;
@@ -0,0 +1,172 @@
+/******************************************************************************
+* Copyright (c) 2021, Hobu Inc. (info@hobu.co)
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+*       names of its contributors may be used to endorse or promote
+*       products derived from this software without specific prior
+*       written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+// Benchmarks for codec throughput.  LAZ benchmarks run only when PDAL is
+// built with lazperf.
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+#include <pdal/pdal_features.hpp>
+#include <pdal/compression/DeflateCompression.hpp>
+#ifdef PDAL_HAVE_LAZPERF
+#include <pdal/compression/LazPerfVlrCompression.hpp>
+#endif
+
+using namespace pdal;
+
+namespace
+{
+
+// Point-format-0 records (20 bytes) with slowly varying positions, the
+// sort of data the LAZ predictors are built for.
+const size_t PointSize = 20;
+
+std::vector<char> makePointBuf(size_t count)
+{
+    std::vector<char> buf(count * PointSize, 0);
+
+    char *p = buf.data();
+    for (size_t i = 0; i < count; ++i)
+    {
+        int32_t x = (int32_t)(i * 3);
+        int32_t y = (int32_t)(i * 5);
+        int32_t z = (int32_t)(1000 + (i % 50));
+        memcpy(p, &x, sizeof(x));
+        memcpy(p + 4, &y, sizeof(y));
+        memcpy(p + 8, &z, sizeof(z));
+        p += PointSize;
+    }
+    return buf;
+}
+
+} // unnamed namespace
+
+
+static void deflateCompress(benchmark::State& state)
+{
+    std::vector<char> buf = makePointBuf((size_t)state.range(0));
+
+    for (auto _ : state)
+    {
+        std::vector<char> compressed;
+        auto cb = [&compressed](char *b, size_t size)
+            { compressed.insert(compressed.end(), b, b + size); };
+        DeflateCompressor compressor(cb);
+        compressor.compress(buf.data(), buf.size());
+        compressor.done();
+        benchmark::DoNotOptimize(compressed);
+    }
+    state.SetBytesProcessed(state.iterations() * buf.size());
+}
+BENCHMARK(deflateCompress)->Arg(1 << 16);
+
+
+static void deflateDecompress(benchmark::State& state)
+{
+    std::vector<char> buf = makePointBuf((size_t)state.range(0));
+
+    std::vector<char> compressed;
+    auto cb = [&compressed](char *b, size_t size)
+        { compressed.insert(compressed.end(), b, b + size); };
+    DeflateCompressor compressor(cb);
+    compressor.compress(buf.data(), buf.size());
+    compressor.done();
+
+    for (auto _ : state)
+    {
+        std::vector<char> out;
+        auto dcb = [&out](char *b, size_t size)
+            { out.insert(out.end(), b, b + size); };
+        DeflateDecompressor decompressor(dcb);
+        decompressor.decompress(compressed.data(), compressed.size());
+        decompressor.done();
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetBytesProcessed(state.iterations() * buf.size());
+}
+BENCHMARK(deflateDecompress)->Arg(1 << 16);
+
+
+#ifdef PDAL_HAVE_LAZPERF
+
+static void lazCompress(benchmark::State& state)
+{
+    const size_t count = (size_t)state.range(0);
+    std::vector<char> buf = makePointBuf(count);
+
+    for (auto _ : state)
+    {
+        std::ostringstream out;
+        LazPerfVlrCompressor compressor(out, 0, 0);
+        for (size_t i = 0; i < count; ++i)
+            compressor.compress(buf.data() + i * PointSize);
+        compressor.done();
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetBytesProcessed(state.iterations() * buf.size());
+}
+BENCHMARK(lazCompress)->Arg(1 << 16);
+
+
+static void lazDecompress(benchmark::State& state)
+{
+    const size_t count = (size_t)state.range(0);
+    std::vector<char> buf = makePointBuf(count);
+
+    std::ostringstream out;
+    LazPerfVlrCompressor compressor(out, 0, 0);
+    for (size_t i = 0; i < count; ++i)
+        compressor.compress(buf.data() + i * PointSize);
+    compressor.done();
+    std::vector<char> vlr = compressor.vlrData();
+    std::string compressed = out.str();
+
+    std::vector<char> point(PointSize);
+    for (auto _ : state)
+    {
+        std::istringstream in(compressed);
+        LazPerfVlrDecompressor decompressor(in, 0, 0, 0, vlr.data());
+        for (size_t i = 0; i < count; ++i)
+            decompressor.decompress(point.data());
+        benchmark::DoNotOptimize(point);
+    }
+    state.SetBytesProcessed(state.iterations() * buf.size());
+}
+BENCHMARK(lazDecompress)->Arg(1 << 16);
+
+#endif // PDAL_HAVE_LAZPERF
@@ -0,0 +1,131 @@
+/******************************************************************************
+* Copyright (c) 2021, Hobu Inc. (info@hobu.co)
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+*       names of its contributors may be used to endorse or promote
+*       products derived from this software without specific prior
+*       written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+// Benchmarks for KD-tree construction and queries, which dominate many
+// neighborhood-based filters.
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include <pdal/KDIndex.hpp>
+#include <pdal/PointTable.hpp>
+#include <pdal/PointView.hpp>
+
+using namespace pdal;
+
+namespace
+{
+
+void fillRandom(PointView& view, point_count_t count)
+{
+    std::mt19937 gen(12345);
+    std::uniform_real_distribution<double> dist(0, 1000);
+
+    for (PointId i = 0; i < count; ++i)
+    {
+        view.setField(Dimension::Id::X, i, dist(gen));
+        view.setField(Dimension::Id::Y, i, dist(gen));
+        view.setField(Dimension::Id::Z, i, dist(gen));
+    }
+}
+
+} // unnamed namespace
+
+
+static void kd3Build(benchmark::State& state)
+{
+    PointTable table;
+    table.layout()->registerDims({Dimension::Id::X, Dimension::Id::Y,
+        Dimension::Id::Z});
+    table.layout()->finalize();
+    PointView view(table);
+    const point_count_t count = (point_count_t)state.range(0);
+    fillRandom(view, count);
+
+    for (auto _ : state)
+    {
+        KD3Index index(view);
+        index.build();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(kd3Build)->Arg(1 << 16);
+
+
+static void kd3Neighbors(benchmark::State& state)
+{
+    PointTable table;
+    table.layout()->registerDims({Dimension::Id::X, Dimension::Id::Y,
+        Dimension::Id::Z});
+    table.layout()->finalize();
+    PointView view(table);
+    const point_count_t count = (point_count_t)state.range(0);
+    fillRandom(view, count);
+    KD3Index index(view);
+    index.build();
+
+    for (auto _ : state)
+        for (PointId i = 0; i < count; ++i)
+        {
+            PointIdList ids = index.neighbors(i, 10);
+            benchmark::DoNotOptimize(ids);
+        }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(kd3Neighbors)->Arg(1 << 14);
+
+
+static void kd3Radius(benchmark::State& state)
+{
+    PointTable table;
+    table.layout()->registerDims({Dimension::Id::X, Dimension::Id::Y,
+        Dimension::Id::Z});
+    table.layout()->finalize();
+    PointView view(table);
+    const point_count_t count = (point_count_t)state.range(0);
+    fillRandom(view, count);
+    KD3Index index(view);
+    index.build();
+
+    // A radius chosen to return a handful of points at this density.
+    for (auto _ : state)
+        for (PointId i = 0; i < count; ++i)
+        {
+            PointIdList ids = index.radius(i, 25.0);
+            benchmark::DoNotOptimize(ids);
+        }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(kd3Radius)->Arg(1 << 14);
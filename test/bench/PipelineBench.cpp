@@ -0,0 +1,108 @@
+/******************************************************************************
+* Copyright (c) 2021, Hobu Inc. (info@hobu.co)
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+*       names of its contributors may be used to endorse or promote
+*       products derived from this software without specific prior
+*       written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+// End-to-end pipeline benchmarks comparing standard and stream execution
+// and exercising a typical filter kernel.
+
+#include <benchmark/benchmark.h>
+
+#include <pdal/PointTable.hpp>
+#include <filters/RangeFilter.hpp>
+#include <filters/StreamCallbackFilter.hpp>
+#include <io/FauxReader.hpp>
+
+using namespace pdal;
+
+
+static void standardExecute(benchmark::State& state)
+{
+    const point_count_t count = (point_count_t)state.range(0);
+
+    for (auto _ : state)
+    {
+        Options ro;
+        ro.add("bounds", BOX3D(0, 0, 0, 1000, 1000, 1000));
+        ro.add("mode", "ramp");
+        ro.add("count", count);
+        FauxReader r;
+        r.setOptions(ro);
+
+        Options fo;
+        fo.add("limits", "Z[250:750]");
+        RangeFilter f;
+        f.setOptions(fo);
+        f.setInput(r);
+
+        PointTable table;
+        f.prepare(table);
+        PointViewSet viewSet = f.execute(table);
+        benchmark::DoNotOptimize(viewSet);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(standardExecute)->Arg(1 << 18);
+
+
+static void streamExecute(benchmark::State& state)
+{
+    const point_count_t count = (point_count_t)state.range(0);
+
+    for (auto _ : state)
+    {
+        Options ro;
+        ro.add("bounds", BOX3D(0, 0, 0, 1000, 1000, 1000));
+        ro.add("mode", "ramp");
+        ro.add("count", count);
+        FauxReader r;
+        r.setOptions(ro);
+
+        Options fo;
+        fo.add("limits", "Z[250:750]");
+        RangeFilter f;
+        f.setOptions(fo);
+        f.setInput(r);
+
+        uint64_t cnt = 0;
+        StreamCallbackFilter cb;
+        cb.setCallback([&cnt](PointRef&){ cnt++; return true; });
+        cb.setInput(f);
+
+        FixedPointTable table(10000);
+        cb.prepare(table);
+        cb.execute(table);
+        benchmark::DoNotOptimize(cnt);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(streamExecute)->Arg(1 << 18);
@@ -0,0 +1,140 @@
+/******************************************************************************
+* Copyright (c) 2021, Hobu Inc. (info@hobu.co)
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+*       names of its contributors may be used to endorse or promote
+*       products derived from this software without specific prior
+*       written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+// Benchmarks for per-point field access, the hottest interface in PDAL.
+
+#include <benchmark/benchmark.h>
+
+#include <pdal/PointTable.hpp>
+#include <pdal/PointView.hpp>
+#include <pdal/PointRef.hpp>
+
+using namespace pdal;
+
+namespace
+{
+
+void registerDims(PointTableRef table)
+{
+    table.layout()->registerDims({Dimension::Id::X, Dimension::Id::Y,
+        Dimension::Id::Z, Dimension::Id::Intensity});
+    table.layout()->finalize();
+}
+
+} // unnamed namespace
+
+
+static void setFieldDouble(benchmark::State& state)
+{
+    PointTable table;
+    registerDims(table);
+    PointView view(table);
+    const point_count_t count = (point_count_t)state.range(0);
+
+    for (auto _ : state)
+        for (PointId i = 0; i < count; ++i)
+            view.setField(Dimension::Id::X, i, (double)i);
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(setFieldDouble)->Arg(1 << 16);
+
+
+// Source and destination types match, so no conversion is involved.
+static void getFieldDouble(benchmark::State& state)
+{
+    PointTable table;
+    registerDims(table);
+    PointView view(table);
+    const point_count_t count = (point_count_t)state.range(0);
+    for (PointId i = 0; i < count; ++i)
+        view.setField(Dimension::Id::X, i, (double)i);
+
+    for (auto _ : state)
+    {
+        double sum = 0;
+        for (PointId i = 0; i < count; ++i)
+            sum += view.getFieldAs<double>(Dimension::Id::X, i);
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(getFieldDouble)->Arg(1 << 16);
+
+
+// Intensity is stored as uint16, so each access converts.
+static void getFieldConverted(benchmark::State& state)
+{
+    PointTable table;
+    registerDims(table);
+    PointView view(table);
+    const point_count_t count = (point_count_t)state.range(0);
+    for (PointId i = 0; i < count; ++i)
+        view.setField(Dimension::Id::Intensity, i, (uint16_t)(i & 0xFFFF));
+
+    for (auto _ : state)
+    {
+        double sum = 0;
+        for (PointId i = 0; i < count; ++i)
+            sum += view.getFieldAs<double>(Dimension::Id::Intensity, i);
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(getFieldConverted)->Arg(1 << 16);
+
+
+// Access through PointRef, as filters see points in stream mode.
+static void pointRefAccess(benchmark::State& state)
+{
+    PointTable table;
+    registerDims(table);
+    PointView view(table);
+    const point_count_t count = (point_count_t)state.range(0);
+    for (PointId i = 0; i < count; ++i)
+        view.setField(Dimension::Id::X, i, (double)i);
+
+    for (auto _ : state)
+    {
+        double sum = 0;
+        PointRef point(view, 0);
+        for (PointId i = 0; i < count; ++i)
+        {
+            point.setPointId(i);
+            sum += point.getFieldAs<double>(Dimension::Id::X);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(pointRefAccess)->Arg(1 << 16);
@@ -0,0 +1,370 @@
+/******************************************************************************
+* Copyright (c) 2026, Hobu Inc. (info@hobu.co)
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+*       names of its contributors may be used to endorse or promote
+*       products derived from this software without specific prior
+*       written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+// End-to-end pipeline performance regression tests.  Each scenario runs
+// a representative pipeline over FauxReader-generated data, measures
+// wall time, CPU time and peak RSS, and compares against a locally
+// recorded baseline so that 'ctest -L perf' fails on regression.
+//
+// Workflow:
+//   1. On a quiet machine at a known-good revision, record a baseline:
+//        PDAL_PERF_WRITE_BASELINE=1 pdal_perf_tests
+//      This writes baselines.json next to this file (override the
+//      location with PDAL_PERF_BASELINE=<path>).
+//   2. Later runs compare against the recorded numbers and fail when a
+//      scenario exceeds baseline * (1 + tolerance).  The tolerance
+//      defaults to 0.25 and can be changed in the baseline file.
+// Without a baseline file the suite only reports measurements, so a
+// fresh checkout doesn't fail on machine differences.
+
+#include <pdal/pdal_test_main.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <map>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+#include <nlohmann/json.hpp>
+
+#include <pdal/PointTable.hpp>
+#include <pdal/PointView.hpp>
+#include <pdal/StageFactory.hpp>
+#include <pdal/pdal_features.hpp>
+#include <pdal/util/FileUtils.hpp>
+#include <filters/StreamCallbackFilter.hpp>
+
+#include "Support.hpp"
+
+using namespace pdal;
+
+namespace
+{
+
+struct Sample
+{
+    double wallMs = 0;
+    double cpuMs = 0;
+    double rssMb = 0;
+};
+
+
+double cpuNowMs()
+{
+#ifndef _WIN32
+    struct rusage u;
+    getrusage(RUSAGE_SELF, &u);
+    auto ms = [](const struct timeval& tv)
+        { return tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0; };
+    return ms(u.ru_utime) + ms(u.ru_stime);
+#else
+    return 0;
+#endif
+}
+
+
+double rssPeakMb()
+{
+#ifndef _WIN32
+    struct rusage u;
+    getrusage(RUSAGE_SELF, &u);
+#ifdef __APPLE__
+    return u.ru_maxrss / (1024.0 * 1024.0);
+#else
+    return u.ru_maxrss / 1024.0;
+#endif
+#else
+    return 0;
+#endif
+}
+
+
+// Run a scenario 'runs' times and keep the best wall/CPU pair - the
+// minimum is the least noisy estimator for a fixed workload.  Peak RSS
+// is process-wide and monotonic, so it's comparable across runs only
+// because the scenarios always execute in the same order.
+Sample measure(int runs, const std::function<void()>& f)
+{
+    Sample best;
+
+    for (int i = 0; i < runs; ++i)
+    {
+        double cpuStart = cpuNowMs();
+        auto wallStart = std::chrono::steady_clock::now();
+        f();
+        std::chrono::duration<double, std::milli> wall =
+            std::chrono::steady_clock::now() - wallStart;
+        double cpu = cpuNowMs() - cpuStart;
+        if (i == 0 || wall.count() < best.wallMs)
+        {
+            best.wallMs = wall.count();
+            best.cpuMs = cpu;
+        }
+    }
+    best.rssMb = rssPeakMb();
+    return best;
+}
+
+
+class Baselines
+{
+public:
+    static Baselines& get()
+    {
+        static Baselines b;
+        return b;
+    }
+
+    void check(const std::string& name, const Sample& s)
+    {
+        m_measured[name] = s;
+        std::cerr << "[perf] " << name << ": wall " << s.wallMs <<
+            " ms, cpu " << s.cpuMs << " ms, peak rss " << s.rssMb <<
+            " MB" << std::endl;
+
+        auto it = m_scenarios.find(name);
+        if (it == m_scenarios.end())
+            return;
+        const NL::json& base = it->second;
+
+        EXPECT_LE(s.wallMs, base.value("wall_ms", 0.0) * (1 + m_tolerance))
+            << name << ": wall time regressed past baseline + tolerance.";
+        EXPECT_LE(s.cpuMs, base.value("cpu_ms", 0.0) * (1 + m_tolerance))
+            << name << ": CPU time regressed past baseline + tolerance.";
+        EXPECT_LE(s.rssMb, base.value("rss_mb", 0.0) * (1 + m_tolerance))
+            << name << ": peak RSS regressed past baseline + tolerance.";
+    }
+
+    void save()
+    {
+        if (!std::getenv("PDAL_PERF_WRITE_BASELINE"))
+            return;
+
+        NL::json out;
+        out["tolerance"] = m_tolerance;
+        for (const auto& kv : m_measured)
+            out["scenarios"][kv.first] = {
+                { "wall_ms", kv.second.wallMs },
+                { "cpu_ms", kv.second.cpuMs },
+                { "rss_mb", kv.second.rssMb }
+            };
+        std::ofstream f(m_path);
+        f << out.dump(4) << "\n";
+        std::cerr << "[perf] baseline written to " << m_path << std::endl;
+    }
+
+private:
+    Baselines()
+    {
+        const char *env = std::getenv("PDAL_PERF_BASELINE");
+        m_path = env ? env : std::string(PDAL_PERF_DIR) + "/baselines.json";
+
+        std::ifstream f(m_path);
+        if (!f)
+            return;
+        NL::json base = NL::json::parse(f, nullptr, false);
+        if (base.is_discarded())
+            return;
+        m_tolerance = base.value("tolerance", m_tolerance);
+        if (base.contains("scenarios"))
+            for (auto it = base["scenarios"].begin();
+                    it != base["scenarios"].end(); ++it)
+                m_scenarios[it.key()] = it.value();
+    }
+
+    std::string m_path;
+    double m_tolerance = 0.25;
+    std::map<std::string, NL::json> m_scenarios;
+    std::map<std::string, Sample> m_measured;
+};
+
+
+class PerfEnvironment : public ::testing::Environment
+{
+public:
+    void TearDown() override
+        { Baselines::get().save(); }
+};
+
+::testing::Environment *s_perfEnv =
+    ::testing::AddGlobalTestEnvironment(new PerfEnvironment);
+
+
+Stage& fauxReader(StageFactory& f, point_count_t count, const BOX3D& bounds)
+{
+    Stage& r = *f.createStage("readers.faux");
+    Options o;
+    o.add("bounds", bounds);
+    o.add("mode", "uniform");
+    o.add("count", count);
+    o.add("seed", 17);
+    r.setOptions(o);
+    return r;
+}
+
+
+point_count_t streamCount(Stage& input)
+{
+    point_count_t cnt = 0;
+    StreamCallbackFilter cb;
+    cb.setCallback([&cnt](PointRef&)
+        { cnt++; return true; });
+    cb.setInput(input);
+
+    FixedPointTable table(10000);
+    cb.prepare(table);
+    cb.execute(table);
+    return cnt;
+}
+
+} // unnamed namespace
+
+
+// Write generated points to LAS (LAZ when a compressor is built in) and
+// stream them back.
+TEST(PerfTest, translate_las)
+{
+    const point_count_t count = 1000000;
+#if defined(PDAL_HAVE_LAZPERF) || defined(PDAL_HAVE_LASZIP)
+    std::string file = Support::temppath("perf_translate.laz");
+#else
+    std::string file = Support::temppath("perf_translate.las");
+#endif
+
+    Baselines::get().check("translate_las", measure(2, [count, &file]()
+    {
+        StageFactory f;
+        Stage& r = fauxReader(f, count, BOX3D(0, 0, 0, 1000, 1000, 100));
+
+        Stage& w = *f.createStage("writers.las");
+        Options wo;
+        wo.add("filename", file);
+        w.setOptions(wo);
+        w.setInput(r);
+
+        PointTable table;
+        w.prepare(table);
+        w.execute(table);
+
+        Stage& rb = *f.createStage("readers.las");
+        Options ro;
+        ro.add("filename", file);
+        rb.setOptions(ro);
+        EXPECT_EQ(streamCount(rb), count);
+    }));
+    FileUtils::deleteFile(file);
+}
+
+
+// Ground classification and nearest-neighbor height-above-ground over a
+// synthetic cloud.
+TEST(PerfTest, ground_hag)
+{
+    const point_count_t count = 300000;
+
+    Baselines::get().check("ground_hag", measure(2, [count]()
+    {
+        StageFactory f;
+        Stage& r = fauxReader(f, count, BOX3D(0, 0, 0, 500, 500, 30));
+
+        Stage& ground = *f.createStage("filters.smrf");
+        ground.setInput(r);
+
+        Stage& hag = *f.createStage("filters.hag_nn");
+        hag.setInput(ground);
+
+        PointTable table;
+        hag.prepare(table);
+        PointViewSet viewSet = hag.execute(table);
+        EXPECT_EQ((*viewSet.begin())->size(), count);
+    }));
+}
+
+
+// Streamed spatial query: crop to a window and accumulate statistics,
+// standing in for a bounded EPT/COPC query, which needs external data.
+TEST(PerfTest, crop_stats)
+{
+    const point_count_t count = 1000000;
+
+    Baselines::get().check("crop_stats", measure(2, [count]()
+    {
+        StageFactory f;
+        Stage& r = fauxReader(f, count, BOX3D(0, 0, 0, 1000, 1000, 100));
+
+        Stage& crop = *f.createStage("filters.crop");
+        Options co;
+        co.add("bounds", "([200, 600], [200, 600])");
+        crop.setOptions(co);
+        crop.setInput(r);
+
+        Stage& stats = *f.createStage("filters.stats");
+        stats.setInput(crop);
+
+        point_count_t cnt = streamCount(stats);
+        EXPECT_GT(cnt, 0u);
+        EXPECT_LT(cnt, count);
+    }));
+}
+
+
+// Rasterize generated points to a mean-Z GeoTIFF.
+TEST(PerfTest, rasterize)
+{
+    const point_count_t count = 500000;
+    std::string file = Support::temppath("perf_raster.tif");
+
+    Baselines::get().check("rasterize", measure(2, [count, &file]()
+    {
+        StageFactory f;
+        Stage& r = fauxReader(f, count, BOX3D(0, 0, 0, 1000, 1000, 100));
+
+        Stage& w = *f.createStage("writers.gdal");
+        Options wo;
+        wo.add("filename", file);
+        wo.add("resolution", 2.0);
+        wo.add("output_type", "mean");
+        w.setOptions(wo);
+        w.setInput(r);
+
+        PointTable table;
+        w.prepare(table);
+        w.execute(table);
+    }));
+    FileUtils::deleteFile(file);
+}
@@ -163,6 +163,32 @@ TEST(BoundsTest, test_grow)
 //ABELL - Need BOX3D example.
 }
 
+TEST(BoundsTest, test_grow_batch)
+{
+    // 1003 points - not a multiple of any likely SIMD width.
+    std::vector<double> x, y, z;
+    BOX3D serial;
+    for (size_t i = 0; i < 1003; ++i)
+    {
+        x.push_back(100.0 + ((i * 7919) % 1000));
+        y.push_back(-50.0 + ((i * 104729) % 500));
+        z.push_back(3.0 + ((i * 31) % 100) * .25);
+        serial.grow(x.back(), y.back(), z.back());
+    }
+
+    BOX3D batch;
+    batch.grow(x.data(), y.data(), z.data(), x.size());
+    EXPECT_TRUE(batch == serial);
+
+    // Growing an already-valid box with more points.
+    batch.grow(x.data(), y.data(), z.data(), 10);
+    EXPECT_TRUE(batch == serial);
+
+    BOX2D batch2d;
+    batch2d.grow(x.data(), y.data(), x.size());
+    EXPECT_TRUE(batch2d == serial.to2d());
+}
+
 TEST(BoundsTest, test_static)
 {
     BOX2D t(BOX2D::getDefaultSpatialExtent());
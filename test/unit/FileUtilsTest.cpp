@@ -35,10 +35,13 @@
 #include <pdal/pdal_test_main.hpp>
 
 #include <pdal/util/FileUtils.hpp>
+#include <pdal/util/IStream.hpp>
+#include <pdal/util/OStream.hpp>
 #include <pdal/util/Utils.hpp>
 
 #include "Support.hpp"
 
+#include <algorithm>
 #include <iostream>
 
 using namespace pdal;
@@ -319,3 +322,58 @@ TEST(FileUtilsTest, test_file_ops_with_unicode_paths)
         EXPECT_FALSE(FileUtils::directoryExists(japanese_dir));
     }
 }
+
+TEST(FileUtilsTest, asyncStream)
+{
+    std::string tmp(Support::temppath("async.tmp"));
+    FileUtils::deleteFile(tmp);
+
+    // Write more than one buffer's worth through the async double buffer,
+    // with a seek in the middle, and verify the file contents.
+    {
+        OLeStream out;
+        out.open(tmp, true);
+        for (uint32_t i = 0; i < 100000; ++i)
+            out << i;
+        out.seek(0);
+        out << (uint32_t)12345;
+        out.close();
+    }
+
+    ILeStream in(tmp);
+    uint32_t val;
+    in >> val;
+    EXPECT_EQ(val, 12345u);
+    for (uint32_t i = 1; i < 100000; ++i)
+    {
+        in >> val;
+        EXPECT_EQ(val, i);
+    }
+    FileUtils::deleteFile(tmp);
+}
+
+TEST(FileUtilsTest, writableMap)
+{
+    std::string tmp(Support::temppath("map.tmp"));
+    FileUtils::deleteFile(tmp);
+
+    std::ostream *out = FileUtils::createFile(tmp);
+    *out << "head";
+    FileUtils::closeFile(out);
+
+    // Map writable past EOF - the file should be extended - and fill in
+    // the tail through the mapping.
+    auto ctx = FileUtils::mapFile(tmp, false, 0, 8);
+    ASSERT_TRUE(ctx.addr() != nullptr) << ctx.what();
+    std::copy_n("tail", 4, reinterpret_cast<char *>(ctx.addr()) + 4);
+    ctx = FileUtils::unmapFile(ctx);
+    EXPECT_EQ(ctx.what(), "");
+
+    EXPECT_EQ(FileUtils::fileSize(tmp), 8U);
+    std::istream *in = FileUtils::openFile(tmp);
+    std::string contents;
+    *in >> contents;
+    FileUtils::closeFile(in);
+    EXPECT_EQ(contents, "headtail");
+    FileUtils::deleteFile(tmp);
+}
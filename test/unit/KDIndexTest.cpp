@@ -34,6 +34,9 @@
 #include <pdal/pdal_test_main.hpp>
 
 #include <pdal/KDIndex.hpp>
+#include <pdal/util/FileUtils.hpp>
+
+#include "Support.hpp"
 
 using namespace pdal;
 
@@ -378,3 +381,60 @@ TEST(KDIndex, radius3D)
     EXPECT_EQ(ids[2], 2u);
 }
 
+
+TEST(KDIndex, sidecarRoundTrip)
+{
+    PointTable table;
+    PointLayoutPtr layout = table.layout();
+    PointView view(table);
+
+    layout->registerDim(Dimension::Id::X);
+    layout->registerDim(Dimension::Id::Y);
+    layout->registerDim(Dimension::Id::Z);
+
+    // Scatter points with a simple LCG so the tree has some depth.
+    uint32_t state = 12345;
+    auto next = [&state]()
+    {
+        state = state * 1103515245 + 12345;
+        return (state >> 8) % 1000;
+    };
+    for (PointId i = 0; i < 1000; ++i)
+    {
+        view.setField(Dimension::Id::X, i, next());
+        view.setField(Dimension::Id::Y, i, next());
+        view.setField(Dimension::Id::Z, i, next());
+    }
+
+    KD3Index index(view);
+    index.build();
+
+    std::string filename = Support::temppath("view.kd3");
+    FileUtils::deleteFile(filename);
+    index.save(filename);
+
+    // A loaded index answers queries exactly as the one it was built from.
+    KD3Index loaded(view);
+    EXPECT_TRUE(loaded.load(filename));
+    for (PointId i = 0; i < 100; ++i)
+    {
+        EXPECT_EQ(index.neighbors(i, 10), loaded.neighbors(i, 10));
+        EXPECT_EQ(index.radius(i, 50.0), loaded.radius(i, 50.0));
+    }
+
+    // A sidecar built from different data fails the checksum.
+    PointTable otherTable;
+    otherTable.layout()->registerDims({ Dimension::Id::X, Dimension::Id::Y,
+        Dimension::Id::Z });
+    PointView otherView(otherTable);
+    for (PointId i = 0; i < 1000; ++i)
+    {
+        otherView.setField(Dimension::Id::X, i, i);
+        otherView.setField(Dimension::Id::Y, i, i);
+        otherView.setField(Dimension::Id::Z, i, i);
+    }
+    KD3Index mismatched(otherView);
+    EXPECT_FALSE(mismatched.load(filename));
+
+    FileUtils::deleteFile(filename);
+}
@@ -62,6 +62,30 @@ TEST(Log, t1)
         Support::datapath("logs/t1")));
 }
 
+// Buffered sinks format through the same header path but emit whole
+// blocks in flush order, so workers can share a log without interleaving
+// fragments of each other's messages.
+TEST(Log, buffered)
+{
+    std::ostringstream out;
+    LogPtr l(Log::makeLog("lead", &out));
+    l->setLevel(LogLevel::Info);
+
+    LogBuffer b1(l);
+    LogBuffer b2(l);
+
+    b1.get(LogLevel::Info) << "one\n";
+    b2.get(LogLevel::Info) << "two\n";
+    b1.get(LogLevel::Info) << "three\n";
+    b2.get(LogLevel::Debug) << "dropped\n";
+
+    EXPECT_TRUE(out.str().empty());
+    b1.flush();
+    b2.flush();
+    EXPECT_EQ(out.str(),
+        "(lead Info) one\n(lead Info) three\n(lead Info) two\n");
+}
+
 // Make sure that devnull thing works.
 TEST(Log, t2)
 {
@@ -34,6 +34,9 @@
 
 #include <pdal/pdal_test_main.hpp>
 
+#include <thread>
+#include <vector>
+
 #include <pdal/Metadata.hpp>
 #include <pdal/SpatialReference.hpp>
 #include <pdal/PDALUtils.hpp>
@@ -260,6 +263,28 @@ TEST(MetadataTest, test_vlr_metadata)
     EXPECT_EQ(found.description(), "VLR2DESC");
 }
 
+TEST(MetadataTest, lazy_value)
+{
+    MetadataNode m;
+
+    int calls = 0;
+    MetadataNode lazy = m.addLazy("lazy",
+        [&calls]()
+        {
+            calls++;
+            return std::string("LAZYVALUE");
+        },
+        "string", "LAZYDESC");
+
+    // The producer only runs when the value is read, and only once.
+    EXPECT_EQ(calls, 0);
+    EXPECT_EQ(lazy.value(), "LAZYVALUE");
+    EXPECT_EQ(lazy.value(), "LAZYVALUE");
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(lazy.type(), "string");
+    EXPECT_EQ(lazy.description(), "LAZYDESC");
+}
+
 TEST(MetadataTest, find_child_string)
 {
     MetadataNode top;
@@ -359,3 +384,25 @@ TEST(MetadataTest, update)
     root2.add(c);
     EXPECT_THROW(root2.addOrUpdate(c), pdal_error);
 }
+
+TEST(MetadataTest, atomicAppend)
+{
+    MetadataNode root("root");
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+        threads.emplace_back([&root, t]()
+        {
+            for (int i = 0; i < 100; ++i)
+            {
+                MetadataNode n("entry");
+                n.add("worker", t);
+                n.add("item", i);
+                root.addAtomic(n);
+            }
+        });
+    for (auto& t : threads)
+        t.join();
+
+    EXPECT_EQ(root.children("entry").size(), 400U);
+}
@@ -37,6 +37,8 @@
 #include <pdal/StageFactory.hpp>
 #include <pdal/pdal_test_main.hpp>
 
+#include <filters/StreamCallbackFilter.hpp>
+
 #include "Support.hpp"
 
 using namespace pdal;
@@ -244,3 +246,50 @@ TEST(OldPCLBlockTests, PMF)
     PointViewPtr view = *viewSet.begin();
     EXPECT_EQ(79u, view->size());
 }
+
+// Radius-method outlier removal in stream mode.  Points one unit apart
+// along X: interior points have two neighbors within the radius, the two
+// endpoints only one, so exactly the endpoints are labeled noise.
+TEST(OldPCLBlockTests, RadiusOutliersStream)
+{
+    StageFactory f;
+
+    Options ro;
+    ro.add("mode", "ramp");
+    ro.add("bounds", "([0, 49],[0, 0],[0, 0])");
+    ro.add("count", 50);
+
+    Stage* r(f.createStage("readers.faux"));
+    EXPECT_TRUE(r);
+    r->setOptions(ro);
+
+    Options fo;
+    fo.add("method", "radius");
+    fo.add("radius", 1.5);
+    fo.add("min_k", 2);
+
+    Stage* outlier(f.createStage("filters.outlier"));
+    EXPECT_TRUE(outlier);
+    outlier->setOptions(fo);
+    outlier->setInput(*r);
+
+    point_count_t noise = 0;
+    point_count_t total = 0;
+    auto cb = [&noise, &total](PointRef& point)
+    {
+        if (point.getFieldAs<uint8_t>(Dimension::Id::Classification) == 7)
+            noise++;
+        total++;
+        return true;
+    };
+    StreamCallbackFilter stream;
+    stream.setCallback(cb);
+    stream.setInput(*outlier);
+
+    FixedPointTable table(20);
+    stream.prepare(table);
+    stream.execute(table);
+
+    EXPECT_EQ(50u, total);
+    EXPECT_EQ(2u, noise);
+}
@@ -34,6 +34,9 @@
 
 #include <pdal/pdal_test_main.hpp>
 
+#include <set>
+#include <sstream>
+
 #include "Support.hpp"
 
 #include <pdal/Stage.hpp>
@@ -68,6 +71,63 @@ TEST(PipelineManagerTest, basic)
     FileUtils::deleteFile(outfile);
 }
 
+// Dry-run validation should catch bad option names without touching the
+// input file, and pass pipelines whose options parse.
+TEST(PipelineManagerTest, validate)
+{
+    {
+        PipelineManager mgr;
+
+        Options optsR;
+        // Note that the referenced file doesn't exist -- validation
+        // shouldn't try to open it.
+        optsR.add("filename", Support::temppath("nonexistent.las"));
+        Stage& reader = mgr.addReader("readers.las");
+        reader.setOptions(optsR);
+
+        EXPECT_NO_THROW(mgr.validate());
+    }
+
+    {
+        PipelineManager mgr;
+
+        Options optsR;
+        optsR.add("filename", Support::temppath("nonexistent.las"));
+        optsR.add("not_an_option", true);
+        Stage& reader = mgr.addReader("readers.las");
+        reader.setOptions(optsR);
+
+        EXPECT_THROW(mgr.validate(), pdal_error);
+    }
+}
+
+// The first run against a cache directory stages the reader's output;
+// the second reloads it and should see the same points.
+TEST(PipelineManagerTest, resultCache)
+{
+    std::string cacheDir = Support::temppath("result_cache");
+    FileUtils::deleteDirectory(cacheDir);
+
+    auto run = [&cacheDir]()
+    {
+        PipelineManager mgr;
+
+        Options optsR;
+        optsR.add("filename", Support::datapath("las/1.2-with-color.las"));
+        Stage& reader = mgr.addReader("readers.las");
+        reader.setOptions(optsR);
+
+        mgr.setCacheDir(cacheDir);
+        return mgr.execute();
+    };
+
+    EXPECT_EQ(run(), 1065U);
+    EXPECT_FALSE(FileUtils::glob(cacheDir + "/*.manifest").empty());
+    EXPECT_EQ(run(), 1065U);
+
+    FileUtils::deleteDirectory(cacheDir);
+}
+
 // Make sure that when we add an option at the command line, it overrides
 // a pipeline option.
 TEST(PipelineManagerTest, OptionOrder)
@@ -197,6 +257,61 @@ TEST(PipelineManagerTest, arrayPipeline)
     FileUtils::deleteFile(Support::temppath("array-pipeline.las"));
 }
 
+TEST(PipelineManagerTest, parallelLeaves)
+{
+    // A pipeline-level 'threads' entry runs the leaf readers
+    // concurrently in standard mode.  The result should match a serial
+    // run.
+    std::string json = R"PDAL(
+    {
+        "threads": 4,
+        "pipeline": [
+            {
+                "type": "readers.faux",
+                "tag": "r1",
+                "mode": "ramp",
+                "count": 1000,
+                "bounds": "([0,999],[0,999],[0,999])"
+            },
+            {
+                "type": "readers.faux",
+                "tag": "r2",
+                "mode": "ramp",
+                "count": 1000,
+                "bounds": "([1000,1999],[1000,1999],[1000,1999])"
+            },
+            {
+                "type": "readers.faux",
+                "tag": "r3",
+                "mode": "ramp",
+                "count": 1000,
+                "bounds": "([2000,2999],[2000,2999],[2000,2999])"
+            },
+            {
+                "type": "filters.merge",
+                "inputs": [ "r1", "r2", "r3" ]
+            }
+        ]
+    }
+    )PDAL";
+
+    PipelineManager mgr;
+    std::istringstream in(json);
+    mgr.readPipeline(in);
+    EXPECT_EQ(mgr.execute(), 3000u);
+
+    // Each reader's ramp should have made it into the merged output
+    // intact.
+    std::multiset<int> xs;
+    for (PointViewPtr v : mgr.views())
+        for (PointId i = 0; i < v->size(); ++i)
+            xs.insert(v->getFieldAs<int>(Dimension::Id::X, i));
+    EXPECT_EQ(xs.size(), 3000u);
+    EXPECT_EQ(*xs.begin(), 0);
+    EXPECT_EQ(*xs.rbegin(), 2999);
+    EXPECT_EQ(xs.count(1500), 1u);
+}
+
 TEST(PipelineManagerTest, replace)
 {
     PipelineManager mgr;
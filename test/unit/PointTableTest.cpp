@@ -254,6 +254,56 @@ TEST(PointTable, simple)
     simpleTest(t);
 }
 
+TEST(PointTable, column)
+{
+    ColumnPointTable t;
+    PointLayoutPtr layout = t.layout();
+
+    layout->registerDim(Dimension::Id::X);
+    layout->registerDim(Dimension::Id::Intensity);
+    t.finalize();
+
+    EXPECT_TRUE(t.columnar());
+
+    // Span more than one 16K-point block so we exercise the contiguous
+    // chunk walk.
+    const point_count_t count = 40000;
+    PointView v(t);
+    for (PointId id = 0; id < count; id++)
+    {
+        v.setField(Dimension::Id::X, id, id * 1.5);
+        v.setField(Dimension::Id::Intensity, id, id % 100);
+    }
+
+    PointId id = 0;
+    while (id < count)
+    {
+        point_count_t contiguous;
+        const double *x = t.column<double>(Dimension::Id::X, id, contiguous);
+        ASSERT_TRUE(x != nullptr);
+        ASSERT_GT(contiguous, 0U);
+        for (point_count_t i = 0; i < contiguous; ++i)
+            EXPECT_DOUBLE_EQ((id + i) * 1.5, x[i]);
+        id += contiguous;
+    }
+    EXPECT_EQ(count, id);
+
+    // Type mismatch and out-of-range requests fail cleanly.
+    point_count_t contiguous;
+    EXPECT_EQ(nullptr, t.column<float>(Dimension::Id::X, 0, contiguous));
+    EXPECT_EQ(0U, contiguous);
+    EXPECT_EQ(nullptr, t.column<double>(Dimension::Id::X, count, contiguous));
+    EXPECT_EQ(0U, contiguous);
+
+    // Row tables aren't columnar.
+    PointTable rowTable;
+    rowTable.layout()->registerDim(Dimension::Id::X);
+    rowTable.finalize();
+    EXPECT_FALSE(rowTable.columnar());
+    EXPECT_EQ(nullptr,
+        rowTable.column<double>(Dimension::Id::X, 0, contiguous));
+}
+
 TEST(PointTable, layoutLimit)
 {
     PointTable t;
@@ -303,4 +353,58 @@ TEST(PointTable, layoutLimit)
     }
 }
 
+TEST(PointTable, allocPolicy)
+{
+    // Each placement policy must hand out zeroed, writable block memory.
+    for (RowPointTable::AllocPolicy policy :
+        { RowPointTable::AllocPolicy::Default,
+          RowPointTable::AllocPolicy::FirstTouch,
+          RowPointTable::AllocPolicy::Interleave })
+    {
+        RowPointTable table(policy);
+        table.layout()->registerDim(Dimension::Id::X);
+        table.layout()->registerDim(Dimension::Id::Y);
+        table.finalize();
+
+        PointView v(table);
+        // Span a block boundary, leaving Y untouched.
+        for (PointId id = 0; id < 70000; ++id)
+            v.setField(Dimension::Id::X, id, id);
+        for (PointId id = 0; id < 70000; ++id)
+        {
+            EXPECT_EQ(id, v.getFieldAs<PointId>(Dimension::Id::X, id));
+            EXPECT_EQ(0U, v.getFieldAs<PointId>(Dimension::Id::Y, id));
+        }
+    }
+}
+
+TEST(PointTable, allocatedBytes)
+{
+    PointTable table;
+    table.layout()->registerDim(Dimension::Id::X);
+    table.layout()->registerDim(Dimension::Id::Y);
+    table.layout()->finalize();
+
+    EXPECT_EQ(table.allocatedBytes(), 0u);
+
+    PointView view(table);
+    view.setField(Dimension::Id::X, 0, 1.0);
+
+    // Adding the first point allocates a whole block.
+    size_t oneBlock = table.allocatedBytes();
+    EXPECT_GE(oneBlock, table.layout()->pointSize());
+
+    // Points within the same block don't allocate.
+    view.setField(Dimension::Id::X, 1, 2.0);
+    EXPECT_EQ(table.allocatedBytes(), oneBlock);
+
+    ColumnPointTable ctable;
+    ctable.layout()->registerDim(Dimension::Id::X);
+    ctable.finalize();
+    EXPECT_EQ(ctable.allocatedBytes(), 0u);
+    PointView cview(ctable);
+    cview.setField(Dimension::Id::X, 0, 1.0);
+    EXPECT_GE(ctable.allocatedBytes(), sizeof(double));
+}
+
 } // namespace
@@ -123,6 +123,93 @@ TEST(PointViewTest, getAsUint8)
     }
 }
 
+TEST(PointViewTest, typedField)
+{
+    PointTable table;
+    PointViewPtr view = makeTestView(table);
+
+    // Reads convert from the stored type just as getFieldAs() does.
+    TypedField<double> cls(*view, Dimension::Id::Classification);
+    TypedField<double> x(*view, Dimension::Id::X);
+    for (int i = 0; i < 17; i++)
+    {
+        EXPECT_DOUBLE_EQ(cls.get(i), i + 1);
+        EXPECT_DOUBLE_EQ(x.get(i), i * 10);
+    }
+
+    // Writes convert to the stored type and round-trip.
+    for (int i = 0; i < 17; i++)
+        x.set(i, i * 20.0);
+    for (int i = 0; i < 17; i++)
+        EXPECT_DOUBLE_EQ(view->getFieldAs<double>(Dimension::Id::X, i),
+            i * 20);
+
+    // Conversions that don't fit the requested or stored type throw,
+    // as with getFieldAs()/setField().
+    TypedField<uint8_t> y8(*view, Dimension::Id::Y);
+    EXPECT_EQ(y8.get(1), 100u);
+    EXPECT_THROW(y8.get(3), pdal_error);
+    EXPECT_THROW(cls.set(0, 300.0), pdal_error);
+}
+
+TEST(PointViewTest, copyPoints)
+{
+    PointTable table;
+    PointViewPtr view = makeTestView(table);
+
+    // Same table: points are shared, not copied.
+    PointViewPtr same = view->makeNew();
+    same->copyPoints(*view, 0, view->size());
+    verifyTestView(*same);
+
+    // Compatible layout in another table: whole-point copies.
+    PointTable rowTable;
+    PointViewPtr rowView = makeTestView(rowTable, 0);
+    EXPECT_TRUE(rowTable.layout()->compatible(*table.layout()));
+    rowView->copyPoints(*view, 0, view->size());
+    verifyTestView(*rowView);
+
+    // Columnar table: falls back to per-dimension copies.
+    ColumnPointTable colTable;
+    PointViewPtr colView = makeTestView(colTable, 0);
+    colTable.finalize();
+    colView->copyPoints(*view, 0, view->size());
+    verifyTestView(*colView);
+
+    // Partial range.
+    PointTable partTable;
+    PointViewPtr partView = makeTestView(partTable, 0);
+    partView->copyPoints(*view, 5, 3);
+    EXPECT_EQ(partView->size(), 3u);
+    EXPECT_EQ(partView->getFieldAs<int>(Dimension::Id::X, 0), 50);
+    EXPECT_EQ(partView->getFieldAs<int>(Dimension::Id::X, 2), 70);
+}
+
+TEST(PointViewTest, moveAppend)
+{
+    PointTable table;
+    PointViewPtr view = makeTestView(table);
+
+    // Move-append into an empty view steals the index and empties the
+    // source.
+    PointViewPtr dest = view->makeNew();
+    dest->append(std::move(*view));
+    verifyTestView(*dest);
+    EXPECT_EQ(view->size(), 0u);
+
+    // Move-append into a non-empty view falls back to copying; the
+    // source is still emptied.
+    PointTable table2;
+    PointViewPtr head = makeTestView(table2);
+    PointViewPtr tail = head->makeNew();
+    tail->copyPoints(*head, 0, head->size());
+    head->append(std::move(*tail));
+    EXPECT_EQ(head->size(), 34u);
+    EXPECT_EQ(tail->size(), 0u);
+    EXPECT_EQ(head->getFieldAs<int>(Dimension::Id::X, 17), 0);
+    EXPECT_EQ(head->getFieldAs<int>(Dimension::Id::X, 33), 160);
+}
+
 TEST(PointViewTest, getAsInt32)
 {
     PointTable table;
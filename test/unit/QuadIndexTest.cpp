@@ -0,0 +1,208 @@
+/******************************************************************************
+* Copyright (c) 2026, Hobu Inc. (info@hobu.co)
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. nor the names of its contributors
+*       may be used to endorse or promote products derived from this
+*       software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+#include <pdal/pdal_test_main.hpp>
+
+#include <pdal/PointView.hpp>
+#include <pdal/QuadIndex.hpp>
+
+using namespace pdal;
+
+namespace
+{
+
+// Deterministically scatter points over [0, 100) x [0, 100).
+void fillView(PointView& view, point_count_t count)
+{
+    uint64_t state = 12345;
+    auto next = [&state]()
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return (double)(state >> 40) / (double)(1 << 24);
+    };
+
+    for (PointId i = 0; i < count; ++i)
+    {
+        view.setField(Dimension::Id::X, i, next() * 100.0);
+        view.setField(Dimension::Id::Y, i, next() * 100.0);
+    }
+}
+
+} // unnamed namespace
+
+TEST(QuadIndex, bounds)
+{
+    PointTable table;
+    PointLayoutPtr layout = table.layout();
+    PointView view(table);
+
+    layout->registerDim(Dimension::Id::X);
+    layout->registerDim(Dimension::Id::Y);
+    fillView(view, 1000);
+
+    QuadIndex index(view);
+
+    double xMin, yMin, xMax, yMax;
+    index.getBounds(xMin, yMin, xMax, yMax);
+    EXPECT_GE(xMin, 0.0);
+    EXPECT_GE(yMin, 0.0);
+    EXPECT_LT(xMax, 100.0);
+    EXPECT_LT(yMax, 100.0);
+    EXPECT_LT(xMin, xMax);
+    EXPECT_LT(yMin, yMax);
+}
+
+TEST(QuadIndex, depthLevels)
+{
+    PointTable table;
+    PointLayoutPtr layout = table.layout();
+    PointView view(table);
+
+    layout->registerDim(Dimension::Id::X);
+    layout->registerDim(Dimension::Id::Y);
+    fillView(view, 1000);
+
+    QuadIndex index(view);
+
+    // Every point lives at exactly one level.
+    PointIdList all = index.getPoints();
+    EXPECT_EQ(all.size(), 1000u);
+
+    std::vector<std::size_t> fills = index.getFills();
+    EXPECT_EQ(fills.size(), index.getDepth() + 1);
+    ASSERT_GE(fills.size(), 3u);
+    EXPECT_EQ(fills[0], 1u);
+    EXPECT_EQ(std::accumulate(fills.begin(), fills.end(), (std::size_t)0),
+        1000u);
+
+    // A depth range selects exactly the points counted by the fills.
+    PointIdList shallow = index.getPoints(3);
+    EXPECT_EQ(shallow.size(),
+        std::accumulate(fills.begin(), fills.begin() + 3, (std::size_t)0));
+
+    PointIdList deep = index.getPoints(3, 0);
+    EXPECT_EQ(shallow.size() + deep.size(), 1000u);
+}
+
+TEST(QuadIndex, queryBox)
+{
+    PointTable table;
+    PointLayoutPtr layout = table.layout();
+    PointView view(table);
+
+    layout->registerDim(Dimension::Id::X);
+    layout->registerDim(Dimension::Id::Y);
+    fillView(view, 1000);
+
+    QuadIndex index(view);
+
+    auto check = [&view, &index](double xMin, double yMin,
+        double xMax, double yMax)
+    {
+        PointIdList expected;
+        for (PointId i = 0; i < view.size(); ++i)
+        {
+            double x = view.getFieldAs<double>(Dimension::Id::X, i);
+            double y = view.getFieldAs<double>(Dimension::Id::Y, i);
+            if (x >= xMin && x < xMax && y >= yMin && y < yMax)
+                expected.push_back(i);
+        }
+
+        PointIdList actual = index.getPoints(xMin, yMin, xMax, yMax);
+        std::sort(expected.begin(), expected.end());
+        std::sort(actual.begin(), actual.end());
+        EXPECT_EQ(expected, actual);
+    };
+
+    check(0, 0, 100, 100);
+    check(25, 25, 75, 75);
+    check(10, 60, 20, 90);
+    check(-50, -50, 50, 50);
+    check(200, 200, 300, 300);
+}
+
+TEST(QuadIndex, coincident)
+{
+    PointTable table;
+    PointLayoutPtr layout = table.layout();
+    PointView view(table);
+
+    layout->registerDim(Dimension::Id::X);
+    layout->registerDim(Dimension::Id::Y);
+
+    for (PointId i = 0; i < 10; ++i)
+    {
+        view.setField(Dimension::Id::X, i, i < 5 ? 25.0 : 75.0);
+        view.setField(Dimension::Id::Y, i, 50.0);
+    }
+
+    QuadIndex index(view, 0, 0, 100, 100);
+    EXPECT_EQ(index.getPoints().size(), 10u);
+    EXPECT_EQ(index.getPoints(0.0, 0.0, 50.0, 100.0).size(), 5u);
+}
+
+TEST(QuadIndex, rasterize)
+{
+    PointTable table;
+    PointLayoutPtr layout = table.layout();
+    PointView view(table);
+
+    layout->registerDim(Dimension::Id::X);
+    layout->registerDim(Dimension::Id::Y);
+    fillView(view, 1000);
+
+    QuadIndex index(view);
+
+    const std::size_t rasterize = 3;
+    double xBegin, xEnd, xStep, yBegin, yEnd, yStep;
+    PointIdList grid = index.getPoints(rasterize,
+        xBegin, xEnd, xStep, yBegin, yEnd, yStep);
+
+    EXPECT_EQ(grid.size(), 64u);
+    EXPECT_GT(xStep, 0.0);
+    EXPECT_GT(yStep, 0.0);
+
+    // Each filled cell holds a valid point id.
+    std::size_t filled = 0;
+    for (PointId id : grid)
+        if (id != (std::numeric_limits<PointId>::max)())
+        {
+            EXPECT_LT(id, 1000u);
+            filled++;
+        }
+    EXPECT_GT(filled, 0u);
+}
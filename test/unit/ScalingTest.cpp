@@ -0,0 +1,78 @@
+/******************************************************************************
+* Copyright (c) 2016, Hobu Inc. (info@hobu.co)
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. nor the names of its contributors
+*       may be used to endorse or promote products derived from this
+*       software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#include <pdal/pdal_test_main.hpp>
+
+#include <pdal/Scaling.hpp>
+
+using namespace pdal;
+
+TEST(ScalingTest, batch)
+{
+    Scaling scaling;
+    scaling.m_xXform = XForm(.01, 635700.0);
+    scaling.m_yXform = XForm(.001, 848900.0);
+    scaling.m_zXform = XForm(.1, 420.0);
+
+    const size_t count = 1001;
+    std::vector<double> x(count);
+    std::vector<double> y(count);
+    std::vector<double> z(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        x[i] = 635700.0 + i * .25;
+        y[i] = 848900.0 + i * .125;
+        z[i] = 420.0 + (i % 100);
+    }
+    std::vector<double> origX(x);
+    std::vector<double> origY(y);
+    std::vector<double> origZ(z);
+
+    // The batch transform matches the scalar one exactly.
+    scaling.toScaled(x.data(), y.data(), z.data(), count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        EXPECT_DOUBLE_EQ(x[i], scaling.m_xXform.toScaled(origX[i]));
+        EXPECT_DOUBLE_EQ(y[i], scaling.m_yXform.toScaled(origY[i]));
+        EXPECT_DOUBLE_EQ(z[i], scaling.m_zXform.toScaled(origZ[i]));
+    }
+
+    // And the inverse takes the values back to where they started.
+    scaling.fromScaled(x.data(), y.data(), z.data(), count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        EXPECT_NEAR(x[i], origX[i], 1e-9);
+        EXPECT_NEAR(y[i], origY[i], 1e-9);
+        EXPECT_NEAR(z[i], origZ[i], 1e-9);
+    }
+}
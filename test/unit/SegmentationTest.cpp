@@ -155,6 +155,42 @@ TEST(SegmentationTest, Clustering2D)
     EXPECT_EQ(1u, clusters[0].size());
 }
 
+TEST(SegmentationTest, FarthestPointSamplingGrid)
+{
+    using namespace Segmentation;
+
+    PointTable table;
+    PointLayoutPtr layout(table.layout());
+
+    layout->registerDim(Dimension::Id::X);
+    layout->registerDim(Dimension::Id::Y);
+    layout->registerDim(Dimension::Id::Z);
+
+    PointViewPtr src(new PointView(table));
+
+    // Scattered points from a simple LCG so distances are distinct.
+    uint32_t state = 12345;
+    auto next = [&state]()
+    {
+        state = state * 1103515245 + 12345;
+        return (state >> 8) % 1000 / 10.0;
+    };
+    for (PointId i = 0; i < 500; ++i)
+    {
+        src->setField(Dimension::Id::X, i, next());
+        src->setField(Dimension::Id::Y, i, next());
+        src->setField(Dimension::Id::Z, i, next());
+    }
+
+    // The grid version selects the same sequence as the serial version,
+    // regardless of thread count.
+    PointIdList serial = farthestPointSampling(*src, 50);
+    PointIdList grid = farthestPointSamplingGrid(*src, 50, 1);
+    PointIdList gridMt = farthestPointSamplingGrid(*src, 50, 4);
+    EXPECT_EQ(serial, grid);
+    EXPECT_EQ(serial, gridMt);
+}
+
 TEST(SegmentationTest, SegmentReturns)
 {
     using namespace Segmentation;
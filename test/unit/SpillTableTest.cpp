@@ -0,0 +1,120 @@
+/******************************************************************************
+* Copyright (c) 2026, Hobu Inc.
+*
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following
+* conditions are met:
+*
+*     * Redistributions of source code must retain the above copyright
+*       notice, this list of conditions and the following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright
+*       notice, this list of conditions and the following disclaimer in
+*       the documentation and/or other materials provided
+*       with the distribution.
+*     * Neither the name of Hobu, Inc. or Flaxen Geo Consulting nor the
+*       names of its contributors may be used to endorse or promote
+*       products derived from this software without specific prior
+*       written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+* OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+* AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+* OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+* OF SUCH DAMAGE.
+****************************************************************************/
+
+#include <pdal/pdal_test_main.hpp>
+
+#include <pdal/PointView.hpp>
+#include <pdal/SpillTable.hpp>
+#include <pdal/util/FileUtils.hpp>
+
+#include "Support.hpp"
+
+namespace pdal
+{
+
+TEST(SpillTableTest, roundtrip)
+{
+    std::string filename(Support::temppath("spill.bin"));
+    FileUtils::deleteFile(filename);
+
+    point_count_t numPts = 2500;
+
+    // Write with a small block size so several blocks get spilled,
+    // the last of them short.
+    {
+        SpillPointTable table(filename, 1000);
+        table.layout()->registerDim(Dimension::Id::X);
+        table.layout()->registerDim(Dimension::Id::Y);
+        table.layout()->registerDim(Dimension::Id::Z);
+        table.layout()->registerDim(Dimension::Id::Intensity);
+        table.finalize();
+
+        PointView view(table);
+        for (PointId i = 0; i < numPts; ++i)
+        {
+            view.setField(Dimension::Id::X, i, i * 1.5);
+            view.setField(Dimension::Id::Y, i, i * 2.5);
+            view.setField(Dimension::Id::Z, i, i * 3.5);
+            view.setField(Dimension::Id::Intensity, i, i % 100);
+        }
+        EXPECT_EQ(numPts, table.numPoints());
+        table.close();
+    }
+
+    MappedSpillTable table(filename);
+    EXPECT_EQ(numPts, table.numPoints());
+    EXPECT_EQ(4u, table.layout()->dims().size());
+
+    for (PointId i = 0; i < numPts; ++i)
+    {
+        PointRef point(table, i);
+        EXPECT_DOUBLE_EQ(i * 1.5, point.getFieldAs<double>(Dimension::Id::X));
+        EXPECT_DOUBLE_EQ(i * 2.5, point.getFieldAs<double>(Dimension::Id::Y));
+        EXPECT_DOUBLE_EQ(i * 3.5, point.getFieldAs<double>(Dimension::Id::Z));
+        EXPECT_EQ(i % 100,
+            point.getFieldAs<uint16_t>(Dimension::Id::Intensity));
+    }
+
+    EXPECT_THROW(PointRef(table, 0).setField(Dimension::Id::X, 0.0),
+        pdal_error);
+
+    FileUtils::deleteFile(filename);
+}
+
+TEST(SpillTableTest, uncompressed)
+{
+    std::string filename(Support::temppath("spill_raw.bin"));
+    FileUtils::deleteFile(filename);
+
+    {
+        SpillPointTable table(filename, 100, false);
+        table.layout()->registerDim(Dimension::Id::X);
+        table.finalize();
+
+        PointView view(table);
+        for (PointId i = 0; i < 250; ++i)
+            view.setField(Dimension::Id::X, i, i * 0.5);
+        table.close();
+    }
+
+    MappedSpillTable table(filename);
+    EXPECT_EQ(250u, table.numPoints());
+    for (PointId i = 0; i < 250; ++i)
+        EXPECT_DOUBLE_EQ(i * 0.5,
+            PointRef(table, i).getFieldAs<double>(Dimension::Id::X));
+
+    FileUtils::deleteFile(filename);
+}
+
+} // namespace pdal
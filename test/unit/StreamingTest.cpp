@@ -37,6 +37,7 @@
 #include <pdal/PointTable.hpp>
 #include <io/FauxReader.hpp>
 #include <pdal/StageFactory.hpp>
+#include <filters/HeadFilter.hpp>
 #include <filters/MergeFilter.hpp>
 #include <filters/StreamCallbackFilter.hpp>
 #include "Support.hpp"
@@ -107,6 +108,52 @@ TEST(Streaming, filter)
     EXPECT_EQ(cnt, 400);
 }
 
+TEST(Streaming, batchCallback)
+{
+    Options ro;
+    ro.add("bounds", BOX3D(0, 0, 0, 99, 99, 99));
+    ro.add("mode", "ramp");
+    ro.add("count", 100);
+    FauxReader r;
+    r.setOptions(ro);
+
+    StreamCallbackFilter f;
+    int cnt = 0;
+    int batches = 0;
+    int x = 0;
+    auto cb = [&](StreamPointTable& table, point_count_t count)
+    {
+        batches++;
+        PointRef point(table, 0);
+        for (PointId idx = 0; idx < count; ++idx)
+        {
+            if (table.skip(idx))
+                continue;
+            point.setPointId(idx);
+            EXPECT_EQ(point.getFieldAs<int>(Dimension::Id::X), x++);
+            // Drop every fourth point to make sure setSkip() propagates.
+            if (idx % 4 == 3)
+                table.setSkip(idx);
+            else
+                cnt++;
+        }
+    };
+    f.setBatchCallback(cb);
+    f.setInput(r);
+
+    StreamCallbackFilter f2;
+    int cnt2 = 0;
+    f2.setCallback([&cnt2](PointRef&){ cnt2++; return true; });
+    f2.setInput(f);
+
+    FixedPointTable t(20);
+    f2.prepare(t);
+    f2.execute(t);
+    EXPECT_EQ(batches, 5);
+    EXPECT_EQ(cnt, 75);
+    EXPECT_EQ(cnt2, 75);
+}
+
 namespace
 {
 
@@ -528,3 +575,73 @@ R"(
         EXPECT_NE(output.find("DBDCA"), std::string::npos);
     }
 }
+
+
+// Points filtered out by one stage are compacted away before the next
+// stage runs, so downstream stages see a dense batch in original order.
+TEST(Streaming, compaction)
+{
+    Options ro;
+    ro.add("bounds", BOX3D(0, 0, 0, 999, 999, 999));
+    ro.add("mode", "ramp");
+    ro.add("count", 1000);
+    FauxReader r;
+    r.setOptions(ro);
+
+    // Drop everything but each 10th point.
+    StreamCallbackFilter f1;
+    f1.setCallback([](PointRef& point)
+        { return point.getFieldAs<int>(Dimension::Id::X) % 10 == 0; });
+    f1.setInput(r);
+
+    int cnt = 0;
+    StreamCallbackFilter f2;
+    f2.setCallback([&cnt](PointRef& point)
+    {
+        EXPECT_EQ(point.getFieldAs<int>(Dimension::Id::X), cnt * 10);
+        cnt++;
+        return true;
+    });
+    f2.setInput(f1);
+
+    FixedPointTable t(25);
+    f2.prepare(t);
+    f2.execute(t);
+    EXPECT_EQ(cnt, 100);
+}
+
+// A saturated filters.head directly downstream of the reader should stop
+// the reader instead of letting it run to end of input.
+TEST(Streaming, earlyTermination)
+{
+    Options ro;
+    ro.add("bounds", BOX3D(0, 0, 0, 999, 999, 999));
+    ro.add("mode", "ramp");
+    ro.add("count", 1000);
+    FauxReader r;
+    r.setOptions(ro);
+
+    Options ho;
+    ho.add("count", 5);
+    HeadFilter h;
+    h.setOptions(ho);
+    h.setInput(r);
+
+    int cnt = 0;
+    StreamCallbackFilter f;
+    f.setCallback([&cnt](PointRef&)
+    {
+        cnt++;
+        return true;
+    });
+    f.setInput(h);
+
+    FixedPointTable t(10);
+    f.prepare(t);
+    r.setProfiling(true);
+    f.execute(t);
+    EXPECT_EQ(cnt, 5);
+    // The head filter saturates within the first batch of 10, so the
+    // reader should never produce a second batch.
+    EXPECT_LE(r.profile().pointCount, 10u);
+}
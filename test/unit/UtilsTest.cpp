@@ -448,6 +448,33 @@ TEST(UtilsTest, naninf)
 }
 
 
+TEST(UtilsTest, fromString)
+{
+    int i;
+    EXPECT_TRUE(Utils::fromString("42", i));
+    EXPECT_EQ(i, 42);
+    EXPECT_TRUE(Utils::fromString("+42", i));
+    EXPECT_EQ(i, 42);
+    EXPECT_TRUE(Utils::fromString("  -7", i));
+    EXPECT_EQ(i, -7);
+    EXPECT_FALSE(Utils::fromString("forty-two", i));
+    EXPECT_FALSE(Utils::fromString("99999999999999999999", i));
+
+    double d;
+    EXPECT_TRUE(Utils::fromString("-1.25e2", d));
+    EXPECT_EQ(d, -125.0);
+    EXPECT_TRUE(Utils::fromString("NaN", d));
+    EXPECT_TRUE(std::isnan(d));
+    EXPECT_FALSE(Utils::fromString("", d));
+
+    std::vector<int> vals;
+    EXPECT_TRUE(Utils::fromStrings({ "1", "2", "3" }, vals));
+    EXPECT_EQ(vals.size(), 3u);
+    EXPECT_EQ(vals[2], 3);
+    EXPECT_FALSE(Utils::fromStrings({ "1", "two" }, vals));
+}
+
+
 TEST(UtilsTest, numeric_cast)
 {
     bool ok;
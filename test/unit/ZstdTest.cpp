@@ -81,3 +81,99 @@ TEST(Compression, zstd)
     decompressor.done();
 }
 
+
+
+TEST(Compression, shuffleZstd)
+{
+    // Synthesize point-like records: slowly increasing coordinates so the
+    // byte shuffle has structure to expose.
+    const size_t pointSize = 3 * sizeof(double);
+    const size_t count = 100123;
+
+    std::vector<double> orig(3 * count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        orig[3 * i] = 635700.0 + i * .01;
+        orig[3 * i + 1] = 848900.0 + i * .005;
+        orig[3 * i + 2] = 420.0 + (i % 100) * .1;
+    }
+    size_t s = orig.size() * sizeof(double);
+    char *sp = reinterpret_cast<char *>(orig.data());
+
+    std::vector<char> compressed;
+    auto cb = [&compressed](char *buf, size_t bufsize)
+    {
+        compressed.insert(compressed.end(), buf, buf + bufsize);
+    };
+
+    ShuffleZstdCompressor compressor(cb, pointSize);
+    compressor.compress(sp, s);
+    compressor.done();
+    EXPECT_LT(compressed.size(), s);
+
+    std::vector<char> out;
+    auto acc = [&out](char *buf, size_t bufsize)
+    {
+        out.insert(out.end(), buf, buf + bufsize);
+    };
+
+    // Feed the decompressor odd-sized chunks to exercise the framing.
+    ShuffleZstdDecompressor decompressor(acc, pointSize);
+    size_t pos = 0;
+    while (pos < compressed.size())
+    {
+        size_t sz = (std::min)((size_t)65537, compressed.size() - pos);
+        decompressor.decompress(compressed.data() + pos, sz);
+        pos += sz;
+    }
+    decompressor.done();
+
+    EXPECT_EQ(out.size(), s);
+    EXPECT_EQ(memcmp(out.data(), sp, s), 0);
+}
+
+
+TEST(Compression, shuffleZstdDictionary)
+{
+    const size_t pointSize = 4 * sizeof(float);
+    const size_t count = 50000;
+
+    std::vector<float> orig(4 * count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        orig[4 * i] = 100.0f + (i % 1000) * .25f;
+        orig[4 * i + 1] = 200.0f + (i % 500) * .5f;
+        orig[4 * i + 2] = 50.0f;
+        orig[4 * i + 3] = (float)(i % 7);
+    }
+    size_t s = orig.size() * sizeof(float);
+    char *sp = reinterpret_cast<char *>(orig.data());
+
+    // Train on a prefix of the data.  Training can fail if Zstd decides
+    // there aren't enough samples; the codec must work either way.
+    std::vector<char> samples(sp, sp + s / 4);
+    std::vector<char> dict = trainZstdDictionary(samples, 1024, 16384);
+
+    std::vector<char> compressed;
+    auto cb = [&compressed](char *buf, size_t bufsize)
+    {
+        compressed.insert(compressed.end(), buf, buf + bufsize);
+    };
+
+    ShuffleZstdCompressor compressor(cb, pointSize, 9, dict);
+    compressor.compress(sp, s);
+    compressor.done();
+
+    std::vector<char> out;
+    auto acc = [&out](char *buf, size_t bufsize)
+    {
+        out.insert(out.end(), buf, buf + bufsize);
+    };
+
+    ShuffleZstdDecompressor decompressor(acc, pointSize, dict);
+    decompressor.decompress(compressed.data(), compressed.size());
+    decompressor.done();
+
+    EXPECT_EQ(out.size(), s);
+    EXPECT_EQ(memcmp(out.data(), sp, s), 0);
+}
@@ -203,3 +203,16 @@ std::string r = R"foo(
 )foo";
     test("--all", r);
 }
+
+TEST(Info, stream)
+{
+    // The full stats surface, including the hexbin boundary, runs in
+    // strict streaming mode.
+    test("--stats --stream", "\"average\"");
+    test("--stats --boundary --stream", "\"boundary\"");
+
+    std::string output;
+    std::string cmd = appName() + " --stream --nostream " +
+        Support::datapath("las/autzen_trim.las") + " 2>&1";
+    EXPECT_NE(Utils::run_shell_command(cmd, output), 0);
+}
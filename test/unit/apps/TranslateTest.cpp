@@ -244,3 +244,48 @@ TEST(TranslateTest, issue2835)
     EXPECT_EQ(runTranslate(in + " " + "devnull", output), 0);
     EXPECT_FALSE(FileUtils::fileExists("devnull"));
 }
+
+// Test batch translation over an input glob.
+TEST(TranslateTest, batch)
+{
+    std::string output;
+
+    auto copyFile = [](const std::string& src, const std::string& dst)
+    {
+        std::istream *in = FileUtils::openFile(src);
+        std::ostream *out = FileUtils::createFile(dst);
+        *out << in->rdbuf();
+        FileUtils::closeFile(in);
+        FileUtils::closeFile(out);
+    };
+
+    std::string in = Support::datapath("las/autzen_trim.las");
+    for (std::string n : { "1", "2", "3" })
+    {
+        copyFile(in, Support::temppath("batch_" + n + ".las"));
+        FileUtils::deleteFile(Support::temppath("batch_" + n + "_out.las"));
+    }
+
+    // Quoted so that the kernel, not the shell, expands the glob.
+    std::string glob = "\"" + Support::temppath("batch_?.las") + "\"";
+    std::string out = Support::temppath("#_out.las");
+
+    EXPECT_EQ(runTranslate(glob + " " + out + " -j 2", output), 0);
+    for (std::string n : { "1", "2", "3" })
+        EXPECT_TRUE(FileUtils::fileExists(
+            Support::temppath("batch_" + n + "_out.las")));
+
+    // The output name needs a '#' template in batch mode.
+    EXPECT_NE(runTranslate(glob + " " + Support::temppath("batch_out.las"),
+        output), 0);
+
+    // A glob matching nothing is an error.
+    EXPECT_NE(runTranslate("\"" + Support::temppath("nothing_?.las") + "\" " +
+        out, output), 0);
+
+    for (std::string n : { "1", "2", "3" })
+    {
+        FileUtils::deleteFile(Support::temppath("batch_" + n + ".las"));
+        FileUtils::deleteFile(Support::temppath("batch_" + n + "_out.las"));
+    }
+}
@@ -319,6 +319,63 @@ TEST(CropFilterTest, multibounds)
 }
 
 
+TEST(CropFilterTest, parallel_polygons)
+{
+    using namespace Dimension;
+
+    // Run the same multi-polygon crop serially and on several threads
+    // and make sure the outputs match exactly.
+    auto run = [](int threads)
+    {
+        PointTable table;
+        table.layout()->registerDim(Id::X);
+        table.layout()->registerDim(Id::Y);
+        table.layout()->registerDim(Id::Z);
+
+        PointViewPtr view(new PointView(table));
+        for (int i = 0; i < 1000; ++i)
+        {
+            view->setField(Id::X, i, i % 20);
+            view->setField(Id::Y, i, (i / 20) % 20);
+        }
+
+        BufferReader r;
+        r.addView(view);
+
+        CropFilter crop;
+        Options o;
+        o.add("polygon", "POLYGON ((1 1, 6 1, 6 6, 1 6, 1 1))");
+        o.add("polygon", "POLYGON ((8 8, 14 8, 14 14, 8 14, 8 8))");
+        o.add("polygon", "POLYGON ((0 15, 19 15, 19 19, 0 19, 0 15))");
+        o.add("polygon", "MULTIPOLYGON (((2 2, 4 2, 4 4, 2 4, 2 2)),"
+            "((10 10, 12 10, 12 12, 10 12, 10 10)))");
+        o.add("threads", threads);
+        crop.setInput(r);
+        crop.setOptions(o);
+
+        crop.prepare(table);
+        PointViewSet s = crop.execute(table);
+
+        std::vector<std::vector<double>> result;
+        for (PointViewPtr v : s)
+        {
+            std::vector<double> coords;
+            for (PointId i = 0; i < v->size(); ++i)
+            {
+                coords.push_back(v->getFieldAs<double>(Id::X, i));
+                coords.push_back(v->getFieldAs<double>(Id::Y, i));
+            }
+            result.push_back(coords);
+        }
+        return result;
+    };
+
+    auto serial = run(1);
+    auto parallel = run(3);
+    EXPECT_EQ(serial.size(), 4u);
+    EXPECT_EQ(serial, parallel);
+}
+
 TEST(CropFilterTest, stream)
 {
     using namespace Dimension;
@@ -36,6 +36,7 @@
 
 #include <pdal/PointView.hpp>
 #include <pdal/StageFactory.hpp>
+#include <io/BufferReader.hpp>
 #include <io/FauxReader.hpp>
 #include <filters/DecimationFilter.hpp>
 #include <filters/StreamCallbackFilter.hpp>
@@ -126,3 +127,197 @@ TEST(DecimationFilterTest, stream)
     filter.execute(t);
 }
 
+namespace
+{
+
+// Reader that counts how many points it decodes and how many it's asked
+// to skip, to verify that the streaming engine lets a strided filter
+// seek the source past points it would discard.
+class CountingReader : public Reader, public Streamable
+{
+public:
+    std::string getName() const
+        { return "readers.counting"; }
+
+    point_count_t m_decoded = 0;
+    point_count_t m_skipped = 0;
+
+private:
+    PointId m_index;
+
+    virtual void addDimensions(PointLayoutPtr layout)
+        { layout->registerDim(Dimension::Id::X); }
+
+    virtual void ready(PointTableRef)
+        { m_index = 0; }
+
+    virtual bool processOne(PointRef& point)
+    {
+        if (m_index >= 1000)
+            return false;
+        point.setField(Dimension::Id::X, m_index++);
+        m_decoded++;
+        return true;
+    }
+
+    virtual point_count_t streamSkip(point_count_t count)
+    {
+        count = (std::min)(count, (point_count_t)(1000 - m_index));
+        m_index += count;
+        m_skipped += count;
+        return count;
+    }
+};
+
+} // unnamed namespace
+
+TEST(DecimationFilterTest, streamSkip)
+{
+    CountingReader reader;
+
+    Options decimationOps;
+    decimationOps.add("step", 100);
+
+    DecimationFilter dec;
+    dec.setOptions(decimationOps);
+    dec.setInput(reader);
+
+    StreamCallbackFilter filter;
+    int cnt = 0;
+    filter.setCallback([&cnt](PointRef& point)
+    {
+        EXPECT_EQ(point.getFieldAs<int>(Dimension::Id::X), cnt * 100);
+        cnt++;
+        return true;
+    });
+    filter.setInput(dec);
+
+    FixedPointTable t(20);
+    filter.prepare(t);
+    filter.execute(t);
+
+    EXPECT_EQ(cnt, 10);
+    EXPECT_EQ(reader.m_decoded, 10u);
+    EXPECT_EQ(reader.m_skipped, 990u);
+}
+
+
+TEST(DecimationFilterTest, reservoir)
+{
+    BOX3D srcBounds(0.0, 0.0, 0.0, 99.0, 99.0, 99.0);
+
+    Options ops;
+    ops.add("bounds", srcBounds);
+    ops.add("mode", "ramp");
+    ops.add("count", 100);
+    FauxReader reader;
+    reader.setOptions(ops);
+
+    Options decimationOps;
+    decimationOps.add("mode", "reservoir");
+    decimationOps.add("count", 10);
+    decimationOps.add("seed", 42);
+
+    DecimationFilter filter;
+    filter.setOptions(decimationOps);
+    filter.setInput(reader);
+
+    PointTable table;
+    filter.prepare(table);
+    PointViewSet viewSet = filter.execute(table);
+    EXPECT_EQ(viewSet.size(), 1u);
+    PointViewPtr view = *viewSet.begin();
+    EXPECT_EQ(view->size(), 10u);
+
+    // Sampled points come out in input order without duplicates.
+    double last = -1.0;
+    for (PointId i = 0; i < view->size(); ++i)
+    {
+        double x = view->getFieldAs<double>(Dimension::Id::X, i);
+        EXPECT_GT(x, last);
+        last = x;
+    }
+}
+
+TEST(DecimationFilterTest, reservoirStream)
+{
+    BOX3D srcBounds(0.0, 0.0, 0.0, 99.0, 99.0, 99.0);
+
+    Options ops;
+    ops.add("bounds", srcBounds);
+    ops.add("mode", "ramp");
+    ops.add("count", 100);
+    FauxReader reader;
+    reader.setOptions(ops);
+
+    Options decimationOps;
+    decimationOps.add("mode", "reservoir");
+    decimationOps.add("count", 10);
+    decimationOps.add("seed", 42);
+
+    DecimationFilter dec;
+    dec.setOptions(decimationOps);
+    dec.setInput(reader);
+
+    StreamCallbackFilter filter;
+    int cnt = 0;
+    filter.setCallback([&cnt](PointRef&)
+    {
+        cnt++;
+        return true;
+    });
+    filter.setInput(dec);
+
+    FixedPointTable t(20);
+    filter.prepare(t);
+    filter.execute(t);
+
+    EXPECT_EQ(cnt, 10);
+}
+
+TEST(DecimationFilterTest, stratified)
+{
+    // 90 points of class 2 and 10 of class 6: a 10-point stratified
+    // sample should keep the 9:1 proportion.
+    PointTable table;
+    table.layout()->registerDim(Dimension::Id::X);
+    table.layout()->registerDim(Dimension::Id::Classification);
+
+    PointViewPtr view(new PointView(table));
+    for (PointId i = 0; i < 100; ++i)
+    {
+        view->setField(Dimension::Id::X, i, i);
+        view->setField(Dimension::Id::Classification, i, i < 90 ? 2 : 6);
+    }
+
+    BufferReader reader;
+    reader.addView(view);
+
+    Options decimationOps;
+    decimationOps.add("mode", "stratified");
+    decimationOps.add("count", 10);
+    decimationOps.add("seed", 42);
+
+    DecimationFilter filter;
+    filter.setOptions(decimationOps);
+    filter.setInput(reader);
+
+    filter.prepare(table);
+    PointViewSet viewSet = filter.execute(table);
+    EXPECT_EQ(viewSet.size(), 1u);
+    PointViewPtr outView = *viewSet.begin();
+    EXPECT_EQ(outView->size(), 10u);
+
+    point_count_t ground = 0;
+    point_count_t building = 0;
+    for (PointId i = 0; i < outView->size(); ++i)
+    {
+        int cl = outView->getFieldAs<int>(Dimension::Id::Classification, i);
+        if (cl == 2)
+            ground++;
+        else if (cl == 6)
+            building++;
+    }
+    EXPECT_EQ(ground, 9u);
+    EXPECT_EQ(building, 1u);
+}
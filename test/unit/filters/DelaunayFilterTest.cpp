@@ -99,3 +99,51 @@ TEST(DelaunayFilterTest, test1)
     EXPECT_EQ(expectedTriangles.size(), (size_t)0);
 }
 
+
+// The threaded path must produce the same triangulation.
+TEST(DelaunayFilterTest, parallel)
+{
+    std::vector<Triangle> expectedTriangles =
+    {
+        {5, 2, 0},
+        {2, 5, 4},
+        {3, 2, 4},
+        {2, 1, 0},
+        {3, 1, 2}
+    };
+
+    Options readerOps;
+    readerOps.add("filename",
+        Support::datapath("filters/delaunaytest.txt"));
+
+    TextReader reader;
+    reader.setOptions(readerOps);
+
+    Options filterOps;
+    filterOps.add("threads", 4);
+
+    DelaunayFilter filter;
+    filter.setOptions(filterOps);
+    filter.setInput(reader);
+
+    PointTable table;
+
+    filter.prepare(table);
+    PointViewSet viewSet = filter.execute(table);
+    PointViewPtr view = *viewSet.begin();
+    TriangularMesh *mesh = view->mesh("delaunay2d");
+    EXPECT_EQ(mesh->size(), expectedTriangles.size());
+
+    for (size_t i = 0; i < mesh->size(); i++)
+    {
+        Triangle triangle = (*mesh)[i];
+
+        auto it = std::find(expectedTriangles.begin(), expectedTriangles.end(),
+            triangle);
+        bool found = (it != expectedTriangles.end());
+        EXPECT_TRUE(found);
+        if (found)
+            expectedTriangles.erase(it);
+    }
+    EXPECT_EQ(expectedTriangles.size(), (size_t)0);
+}
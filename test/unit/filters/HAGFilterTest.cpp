@@ -35,6 +35,7 @@
 #include <pdal/pdal_test_main.hpp>
 
 #include <pdal/StageFactory.hpp>
+#include "io/BufferReader.hpp"
 
 #include "Support.hpp"
 
@@ -194,4 +195,64 @@ TEST(HAGFilterTest, closest)
 // Should add tests for exact match in neighbors case and for
 // max_distance in neighbors case.
 
+// Raster mode: over a flat, fully-populated ground grid the bilinear
+// lookup is exact.
+TEST(HAGFilterTest, raster)
+{
+    PointTable t;
+    t.layout()->registerDims({Dimension::Id::X, Dimension::Id::Y,
+        Dimension::Id::Z, Dimension::Id::Classification});
+    PointViewPtr v(new PointView(t));
+
+    // Ground plane at Z = 10, one point per cell at resolution 1.
+    PointId id = 0;
+    for (int x = 0; x <= 10; ++x)
+        for (int y = 0; y <= 10; ++y)
+        {
+            v->setField(Dimension::Id::X, id, x);
+            v->setField(Dimension::Id::Y, id, y);
+            v->setField(Dimension::Id::Z, id, 10);
+            v->setField(Dimension::Id::Classification, id,
+                ClassLabel::Ground);
+            id++;
+        }
+
+    PointId first = id;
+    v->setField(Dimension::Id::X, id, 5.3);
+    v->setField(Dimension::Id::Y, id, 5.7);
+    v->setField(Dimension::Id::Z, id, 25);
+    v->setField(Dimension::Id::Classification, id++, ClassLabel::Unclassified);
+
+    v->setField(Dimension::Id::X, id, 0.2);
+    v->setField(Dimension::Id::Y, id, 0.4);
+    v->setField(Dimension::Id::Z, id, 12);
+    v->setField(Dimension::Id::Classification, id++, ClassLabel::Unclassified);
+
+    BufferReader r;
+    r.addView(v);
+
+    StageFactory factory;
+    Stage& f = *(factory.createStage("filters.hag_nn"));
+    Options fo;
+    fo.add("resolution", 1.0);
+    f.setInput(r);
+    f.setOptions(fo);
+
+    f.prepare(t);
+    PointViewSet s = f.execute(t);
+    PointViewPtr out = *s.begin();
+
+    for (PointId i = 0; i < out->size(); ++i)
+    {
+        double hag = out->getFieldAs<double>(
+            Dimension::Id::HeightAboveGround, i);
+        double z = out->getFieldAs<double>(Dimension::Id::Z, i);
+        if (z == 10)
+            EXPECT_EQ(hag, 0);
+        else
+            EXPECT_DOUBLE_EQ(hag, z - 10);
+    }
+    EXPECT_EQ(out->size(), first + 2);
+}
+
 } // namespace pdal
@@ -96,6 +96,42 @@ TEST(HexbinFilterTest, HexbinFilterTest_test_1)
     FileUtils::deleteFile(filename);
 }
 
+// Threaded binning must produce the same boundary as a serial run.
+TEST(HexbinFilterTest, parallel)
+{
+    auto run = [](int threads)
+    {
+        StageFactory f;
+
+        Options options;
+        options.add("filename", Support::datapath("las/hextest.las"));
+
+        Stage* reader(f.createStage("readers.las"));
+        reader->setOptions(options);
+
+        Stage* hexbin(f.createStage("filters.hexbin"));
+
+        Options hexOptions;
+        hexOptions.add("threshold", 1);
+        hexOptions.add("edge_length", 0.666666666);
+        hexOptions.add("threads", threads);
+        hexbin->setOptions(hexOptions);
+        hexbin->setInput(*reader);
+
+        PointTable table;
+        hexbin->prepare(table);
+        hexbin->execute(table);
+
+        MetadataNode m = table.metadata();
+        m = m.findChild(hexbin->getName());
+        return m.findChild("boundary").value();
+    };
+
+    std::string serial = run(1);
+    EXPECT_TRUE(serial.size());
+    EXPECT_EQ(serial, run(4));
+}
+
 // Test that we create proper WKT for geometry with islands.
 TEST(HexbinFilterTest, issue_2507)
 {
@@ -35,6 +35,7 @@
 #include <pdal/pdal_test_main.hpp>
 
 #include <pdal/PipelineManager.hpp>
+#include <pdal/StageFactory.hpp>
 
 #include "Support.hpp"
 
@@ -94,3 +95,44 @@ TEST(MergeTest, test6)
     PointViewPtr view = *viewSet.begin();
     EXPECT_EQ(2130u, view->size());
 }
+
+// Merge two X-sorted inputs with a sort dimension and make sure the
+// output is a single ordered view.
+TEST(MergeTest, sorted)
+{
+    using namespace pdal;
+
+    StageFactory f;
+
+    Stage& r1 = *f.createStage("readers.faux");
+    Options o1;
+    o1.add("bounds", BOX3D(0, 0, 0, 99, 99, 99));
+    o1.add("count", 100);
+    o1.add("mode", "ramp");
+    r1.setOptions(o1);
+
+    Stage& r2 = *f.createStage("readers.faux");
+    Options o2;
+    o2.add("bounds", BOX3D(0.5, 0.5, 0.5, 99.5, 99.5, 99.5));
+    o2.add("count", 100);
+    o2.add("mode", "ramp");
+    r2.setOptions(o2);
+
+    Stage& merge = *f.createStage("filters.merge");
+    Options mo;
+    mo.add("sort_dimension", "X");
+    merge.setOptions(mo);
+    merge.setInput(r1);
+    merge.setInput(r2);
+
+    PointTable table;
+    merge.prepare(table);
+    PointViewSet viewSet = merge.execute(table);
+
+    EXPECT_EQ(1u, viewSet.size());
+    PointViewPtr view = *viewSet.begin();
+    EXPECT_EQ(200u, view->size());
+    for (PointId i = 1; i < view->size(); ++i)
+        EXPECT_LE(view->getFieldAs<double>(Dimension::Id::X, i - 1),
+            view->getFieldAs<double>(Dimension::Id::X, i));
+}
@@ -113,3 +113,54 @@ TEST(MortonOrderTest, test_code)
     EXPECT_EQ(outView->getFieldAs<double>(Dimension::Id::X, 5), 3);
     EXPECT_EQ(outView->getFieldAs<double>(Dimension::Id::Y, 5), 2);
 }
+
+TEST(MortonOrderTest, cluster)
+{
+    // Clustering must not change the output ordering, only the physical
+    // storage behind it, so a clustered run reads exactly like a plain one.
+    auto runFilter = [](PointTable& table, bool cluster)
+    {
+        table.layout()->registerDim(Dimension::Id::X);
+        table.layout()->registerDim(Dimension::Id::Y);
+
+        PointViewPtr view(new PointView(table));
+        int n = 0;
+        for ( int i = 0; i < 8; i++ )
+        {
+            for ( int j = 0; j < 8; j++ )
+            {
+                view->setField(Dimension::Id::X, n, (i * 5) % 8);
+                view->setField(Dimension::Id::Y, n, (j * 3) % 8);
+                n += 1;
+            }
+        }
+
+        BufferReader r;
+        r.addView(view);
+
+        MortonOrderFilter filter;
+        Options o;
+        o.add("cluster", cluster);
+        filter.setInput(r);
+        filter.setOptions(o);
+
+        filter.prepare(table);
+        PointViewSet s = filter.execute(table);
+        return *s.begin();
+    };
+
+    PointTable plainTable;
+    PointTable clusteredTable;
+    PointViewPtr plain = runFilter(plainTable, false);
+    PointViewPtr clustered = runFilter(clusteredTable, true);
+
+    EXPECT_EQ(64u, plain->size());
+    ASSERT_EQ(plain->size(), clustered->size());
+    for (PointId i = 0; i < plain->size(); ++i)
+    {
+        EXPECT_EQ(plain->getFieldAs<double>(Dimension::Id::X, i),
+            clustered->getFieldAs<double>(Dimension::Id::X, i));
+        EXPECT_EQ(plain->getFieldAs<double>(Dimension::Id::Y, i),
+            clustered->getFieldAs<double>(Dimension::Id::Y, i));
+    }
+}
@@ -33,6 +33,7 @@
 ****************************************************************************/
 
 #include <filters/NNDistanceFilter.hpp>
+#include <filters/StreamCallbackFilter.hpp>
 #include <pdal/pdal_test_main.hpp>
 #include <pdal/StageFactory.hpp>
 
@@ -122,3 +123,44 @@ TEST(NNDistanceTest, kdist)
     }
 }
 
+
+// Streamed distances computed against the sliding window should match the
+// full-view result when the input is sorted on the window dimension.
+TEST(NNDistanceTest, stream)
+{
+    StageFactory f;
+    Stage *reader(f.createStage("readers.faux"));
+
+    // Points ascending in X, one unit apart.
+    Options rOpts;
+    rOpts.add("mode", "ramp");
+    rOpts.add("bounds", "([0, 99],[0, 0],[0, 0])");
+    rOpts.add("count", 100);
+    reader->setOptions(rOpts);
+
+    Stage *filter(f.createStage("filters.nndistance"));
+    Options fOpts;
+    fOpts.add("mode", "kth");
+    fOpts.add("k", 1);
+    fOpts.add("window", 2.5);
+    filter->setOptions(fOpts);
+    filter->setInput(*reader);
+
+    std::vector<double> dists;
+    auto cb = [&dists](PointRef& point)
+    {
+        dists.push_back(point.getFieldAs<double>(Dimension::Id::NNDistance));
+        return true;
+    };
+    StreamCallbackFilter stream;
+    stream.setCallback(cb);
+    stream.setInput(*filter);
+
+    FixedPointTable t(20);
+    stream.prepare(t);
+    stream.execute(t);
+
+    EXPECT_EQ(dists.size(), 100u);
+    for (double d : dists)
+        EXPECT_DOUBLE_EQ(d, 1.0);
+}
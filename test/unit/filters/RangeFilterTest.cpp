@@ -36,6 +36,7 @@
 
 #include <pdal/PointView.hpp>
 #include <pdal/StageFactory.hpp>
+#include <io/BufferReader.hpp>
 #include <io/FauxReader.hpp>
 #include <io/LasReader.hpp>
 #include <io/TextReader.hpp>
@@ -454,3 +455,88 @@ TEST(RangeFilterTest, nan)
     EXPECT_EQ(0u, view->size());
 }
 
+
+// With several input views and a view-thread-safe filter, Stage::execute()
+// dispatches the views across a thread pool.  Verify the results match
+// what the sequential path would produce.
+TEST(RangeFilterTest, multipleViews)
+{
+    const int numViews = 16;
+    const int numPoints = 100;
+
+    PointTable table;
+    table.layout()->registerDim(Dimension::Id::Z);
+
+    BufferReader reader;
+    for (int v = 0; v < numViews; ++v)
+    {
+        PointViewPtr view(new PointView(table));
+        for (int i = 0; i < numPoints; ++i)
+            view->setField(Dimension::Id::Z, i, i);
+        reader.addView(view);
+    }
+
+    Options rangeOps;
+    rangeOps.add("limits", "Z[25:74]");
+
+    RangeFilter filter;
+    filter.setOptions(rangeOps);
+    filter.setInput(reader);
+
+    filter.prepare(table);
+    PointViewSet viewSet = filter.execute(table);
+
+    EXPECT_EQ(viewSet.size(), (size_t)numViews);
+    for (const PointViewPtr& view : viewSet)
+    {
+        EXPECT_EQ(view->size(), (size_t)50);
+        for (PointId i = 0; i < view->size(); ++i)
+        {
+            double z = view->getFieldAs<double>(Dimension::Id::Z, i);
+            EXPECT_GE(z, 25.0);
+            EXPECT_LE(z, 74.0);
+        }
+    }
+}
+
+namespace
+{
+
+// Minimal view-thread-safe filter whose run() always throws, for checking
+// that worker exceptions surface on the executing thread.
+class ThrowingFilter : public Filter
+{
+public:
+    std::string getName() const
+    { return "filters.throwtest"; }
+
+private:
+    virtual PointViewSet run(PointViewPtr view)
+    { throw pdal_error("thrown from worker"); }
+    virtual bool viewThreadSafe() const
+    { return true; }
+};
+
+} // unnamed namespace
+
+// An exception thrown while views run on pool threads is rethrown by
+// Stage::execute().
+TEST(RangeFilterTest, multipleViewsThrow)
+{
+    PointTable table;
+    table.layout()->registerDim(Dimension::Id::Z);
+
+    BufferReader reader;
+    for (int v = 0; v < 4; ++v)
+    {
+        PointViewPtr view(new PointView(table));
+        view->setField(Dimension::Id::Z, 0, 0);
+        reader.addView(view);
+    }
+
+    ThrowingFilter filter;
+    filter.setInput(reader);
+
+    filter.prepare(table);
+    EXPECT_THROW(filter.execute(table), pdal_error);
+}
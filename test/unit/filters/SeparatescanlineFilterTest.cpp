@@ -63,4 +63,36 @@ TEST(SeparateScanLineFilter, partition_count)
         PointViewSet viewSet = separator.execute(table);
         EXPECT_EQ(viewSet.size(), 5u);
     }
-}
\ No newline at end of file
+}
+
+TEST(SeparateScanLineFilter, scan_line_tag)
+{
+    PointTable table;
+
+    Options ops1;
+    std::string filename(Support::datapath("text/with_edgeofflightline.txt"));
+    ops1.add("filename", filename);
+    TextReader reader;
+    reader.setOptions(ops1);
+
+    Options options;
+    options.add("groupby", 2);
+
+    SeparateScanLineFilter separator;
+    separator.setInput(reader);
+    separator.setOptions(options);
+    separator.prepare(table);
+    PointViewSet viewSet = separator.execute(table);
+
+    // Every point carries its 1-based group number in the ScanLine
+    // dimension, constant within a view.
+    Dimension::Id scanLine = table.layout()->findDim("ScanLine");
+    EXPECT_NE(scanLine, Dimension::Id::Unknown);
+    uint64_t group = 1;
+    for (PointViewPtr view : viewSet)
+    {
+        for (PointId i = 0; i < view->size(); ++i)
+            EXPECT_EQ(view->getFieldAs<uint64_t>(scanLine, i), group);
+        group++;
+    }
+}
@@ -38,9 +38,11 @@
 
 #include <pdal/PipelineManager.hpp>
 #include <pdal/StageWrapper.hpp>
+#include <io/FauxReader.hpp>
 #include <io/LasReader.hpp>
 #include <io/LasWriter.hpp>
 #include <filters/SortFilter.hpp>
+#include <filters/StreamCallbackFilter.hpp>
 #include "Support.hpp"
 
 using namespace pdal;
@@ -159,6 +161,45 @@ TEST(SortFilterTest, issue1382)
     }
 }
 
+// In stream mode the filter spills sorted runs to temp storage and
+// merge-streams them downstream once the reader is done.
+TEST(SortFilterTest, stream)
+{
+    FauxReader r;
+    Options ro;
+
+    ro.add("mode", "random");
+    ro.add("count", 1000);
+    ro.add("bounds", BOX3D(0, 0, 0, 1000, 1000, 1000));
+    r.setOptions(ro);
+
+    SortFilter f;
+    Options fo;
+
+    fo.add("dimension", "X");
+    // Force several spilled runs.
+    fo.add("run_points", 100);
+    f.setOptions(fo);
+    f.setInput(r);
+
+    StreamCallbackFilter c;
+    std::vector<double> values;
+    c.setCallback([&values](PointRef& point)
+    {
+        values.push_back(point.getFieldAs<double>(Dimension::Id::X));
+        return true;
+    });
+    c.setInput(f);
+
+    FixedPointTable t(50);
+    c.prepare(t);
+    c.execute(t);
+
+    EXPECT_EQ(values.size(), 1000u);
+    for (size_t i = 1; i < values.size(); ++i)
+        EXPECT_TRUE(values[i - 1] <= values[i]);
+}
+
 TEST(SortFilterTest, issue1121_simpleSortOrderDesc)
 {
     point_count_t inc = 1;
@@ -504,3 +504,39 @@ TEST(Stats, merge)
             EXPECT_EQ(wm[(double)i], pm[(double)i]);
     }
 }
+
+// Large views are accumulated in parallel chunks and combined with
+// Summary::merge; the result should agree with the known distribution.
+TEST(Stats, parallel)
+{
+    StageFactory f;
+    Stage *reader(f.createStage("readers.faux"));
+
+    Options rOpts;
+    rOpts.add("mode", "ramp");
+    rOpts.add("bounds", "([0, 1000],[0, 2000],[0, 4000])");
+    rOpts.add("count", 300000);
+    reader->setOptions(rOpts);
+
+    StatsFilter filter;
+    Options fOpts;
+    fOpts.add("advanced", true);
+    filter.setOptions(fOpts);
+    filter.setInput(*reader);
+
+    PointTable table;
+    filter.prepare(table);
+    filter.execute(table);
+
+    const stats::Summary& xstats = filter.getStats(Dimension::Id::X);
+    EXPECT_EQ(xstats.count(), 300000u);
+    EXPECT_DOUBLE_EQ(xstats.minimum(), 0.0);
+    EXPECT_DOUBLE_EQ(xstats.maximum(), 1000.0);
+    EXPECT_NEAR(xstats.average(), 500.0, 1e-6);
+    // Uniform ramp on [0, 1000].
+    EXPECT_NEAR(xstats.sampleStddev(), 1000.0 / std::sqrt(12.0), 0.01);
+    EXPECT_NEAR(xstats.sampleSkewness(), 0.0, 0.001);
+
+    const stats::Summary& ystats = filter.getStats(Dimension::Id::Y);
+    EXPECT_NEAR(ystats.average(), 1000.0, 1e-6);
+}
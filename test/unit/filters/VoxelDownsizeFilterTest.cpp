@@ -251,6 +251,58 @@ void stream_test(std::string mode)
     f.execute(table);
 }
 
+// The parallel path must produce exactly the serial output.
+void parallel_test(std::string mode)
+{
+    auto run = [&mode](int threads)
+    {
+        StageFactory fac;
+
+        Stage* reader = fac.createStage("readers.las");
+        Options ro;
+        ro.add("filename", Support::datapath("las/autzen_trim.las"));
+        reader->setOptions(ro);
+
+        Stage* filter = fac.createStage("filters.voxeldownsize");
+        Options fo;
+        fo.add("cell", 10);
+        fo.add("mode", mode);
+        fo.add("threads", threads);
+        filter->setOptions(fo);
+        filter->setInput(*reader);
+
+        PointTable t;
+        filter->prepare(t);
+        return filter->execute(t);
+    };
+
+    PointViewSet serialSet = run(1);
+    PointViewSet parallelSet = run(4);
+    PointViewPtr serial = *serialSet.begin();
+    PointViewPtr parallel = *parallelSet.begin();
+
+    ASSERT_EQ(serial->size(), parallel->size());
+    for (PointId i = 0; i < serial->size(); ++i)
+    {
+        EXPECT_EQ(serial->getFieldAs<double>(Id::X, i),
+            parallel->getFieldAs<double>(Id::X, i));
+        EXPECT_EQ(serial->getFieldAs<double>(Id::Y, i),
+            parallel->getFieldAs<double>(Id::Y, i));
+        EXPECT_EQ(serial->getFieldAs<double>(Id::Z, i),
+            parallel->getFieldAs<double>(Id::Z, i));
+    }
+}
+
+TEST(VoxelDownsizeFilter, firstinvoxel_parallel)
+{
+    parallel_test("first");
+}
+
+TEST(VoxelDownsizeFilter, voxelcenter_parallel)
+{
+    parallel_test("center");
+}
+
 TEST(VoxelDownsizeFilter, firstinvoxel_origin)
 {
     origin_test("first");
@@ -34,7 +34,13 @@
 
 #include <pdal/pdal_test_main.hpp>
 
+#include <pdal/PointTable.hpp>
 #include <pdal/StageFactory.hpp>
+#include <filters/StreamCallbackFilter.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
 
 #include "Support.hpp"
 
@@ -117,4 +123,50 @@ TEST(VoxelTest, center_value)
     }
 }
 
+// Stream mode of the centroid variant: voxels finalize once the input
+// moves past them and each emits one representative near its centroid.
+TEST(VoxelTest, centroidStream)
+{
+    StageFactory fac;
+
+    Stage *reader = fac.createStage("readers.faux");
+    Options ro;
+    ro.add("bounds", "([0, 8.9], [0, 8.9], [0, 8.9])");
+    ro.add("count", 4500);
+    ro.add("mode", "ramp");
+    reader->setOptions(ro);
+
+    Stage *filter = fac.createStage("filters.voxelcentroidnearestneighbor");
+    Options fo;
+    fo.add("cell", 1.0);
+    // Small enough that early voxels finalize while the stream is still
+    // running rather than in the drain phase.
+    fo.add("stream_window", 16);
+    filter->setOptions(fo);
+    filter->setInput(*reader);
+
+    std::vector<double> xs;
+    StreamCallbackFilter cb;
+    cb.setCallback([&xs](PointRef& p)
+    {
+        xs.push_back(p.getFieldAs<double>(Dimension::Id::X));
+        return true;
+    });
+    cb.setInput(*filter);
+
+    FixedPointTable t(100);
+    cb.prepare(t);
+    cb.execute(t);
+
+    // One representative per voxel, each close to its voxel's centroid
+    // (the ramp fills each voxel uniformly).
+    std::sort(xs.begin(), xs.end());
+    EXPECT_EQ(xs.size(), 9U);
+    for (size_t k = 0; k < xs.size(); ++k)
+    {
+        double centroid = (k == 8) ? 8.45 : k + 0.5;
+        EXPECT_LT(std::fabs(xs[k] - centroid), 0.01);
+    }
+}
+
 } // namespace
@@ -60,6 +60,46 @@ TEST(BpfTestZlib, test_byte_major_zlib)
             "autzen-utm-chipped-25-v3-deflate-segregated.bpf"));
 }
 
+TEST(BpfTestZlib, test_parallel_decompression)
+{
+    std::string filename(
+        Support::datapath("bpf/autzen-utm-chipped-25-v3-deflate.bpf"));
+
+    Options ops1;
+    ops1.add("filename", filename);
+    BpfReader r1;
+    r1.setOptions(ops1);
+
+    PointTable t1;
+    r1.prepare(t1);
+    PointViewSet s1 = r1.execute(t1);
+    EXPECT_EQ(s1.size(), 1u);
+    PointViewPtr v1 = *s1.begin();
+
+    Options ops2;
+    ops2.add("filename", filename);
+    ops2.add("threads", 4);
+    BpfReader r2;
+    r2.setOptions(ops2);
+
+    PointTable t2;
+    r2.prepare(t2);
+    PointViewSet s2 = r2.execute(t2);
+    EXPECT_EQ(s2.size(), 1u);
+    PointViewPtr v2 = *s2.begin();
+
+    EXPECT_EQ(v1->size(), v2->size());
+    for (PointId i = 0; i < v1->size(); ++i)
+    {
+        EXPECT_FLOAT_EQ(v1->getFieldAs<float>(Dimension::Id::X, i),
+            v2->getFieldAs<float>(Dimension::Id::X, i));
+        EXPECT_FLOAT_EQ(v1->getFieldAs<float>(Dimension::Id::Y, i),
+            v2->getFieldAs<float>(Dimension::Id::Y, i));
+        EXPECT_FLOAT_EQ(v1->getFieldAs<float>(Dimension::Id::Z, i),
+            v2->getFieldAs<float>(Dimension::Id::Z, i));
+    }
+}
+
 TEST(BpfTestZlib, roundtrip_byte_compression)
 {
     Options ops;
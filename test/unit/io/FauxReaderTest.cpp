@@ -414,3 +414,83 @@ TEST(FauxReaderTest, grid)
     testGrid(0, 3, 0);
     testGrid(0, 3, 4);
 }
+
+
+TEST(FauxReaderTest, morton)
+{
+    auto run = [](PointViewPtr& view)
+    {
+        BOX3D bounds(1.0, 2.0, 3.0, 101.0, 102.0, 103.0);
+        Options ops;
+        ops.add("bounds", bounds);
+        ops.add("count", 1000);
+        ops.add("mode", "morton");
+        FauxReader reader;
+        reader.setOptions(ops);
+
+        PointTable table;
+        reader.prepare(table);
+        PointViewSet viewSet = reader.execute(table);
+        EXPECT_EQ(viewSet.size(), 1u);
+        view = *viewSet.begin();
+        EXPECT_EQ(view->size(), 1000u);
+    };
+
+    PointViewPtr v1;
+    PointViewPtr v2;
+    run(v1);
+    run(v2);
+    for (point_count_t i = 0; i < v1->size(); ++i)
+    {
+        double x = v1->getFieldAs<double>(Dimension::Id::X, i);
+        double y = v1->getFieldAs<double>(Dimension::Id::Y, i);
+        double z = v1->getFieldAs<double>(Dimension::Id::Z, i);
+
+        EXPECT_GE(x, 1.0);
+        EXPECT_LE(x, 101.0);
+        EXPECT_GE(y, 2.0);
+        EXPECT_LE(y, 102.0);
+        EXPECT_GE(z, 3.0);
+        EXPECT_LE(z, 103.0);
+
+        // Unseeded output is deterministic.
+        EXPECT_DOUBLE_EQ(x, v2->getFieldAs<double>(Dimension::Id::X, i));
+        EXPECT_DOUBLE_EQ(y, v2->getFieldAs<double>(Dimension::Id::Y, i));
+        EXPECT_DOUBLE_EQ(z, v2->getFieldAs<double>(Dimension::Id::Z, i));
+    }
+}
+
+
+TEST(FauxReaderTest, flightline)
+{
+    BOX3D bounds(1.0, 2.0, 3.0, 101.0, 102.0, 103.0);
+    Options ops;
+    ops.add("bounds", bounds);
+    ops.add("count", 1000);
+    ops.add("mode", "flightline");
+    FauxReader reader;
+    reader.setOptions(ops);
+
+    PointTable table;
+    reader.prepare(table);
+    PointViewSet viewSet = reader.execute(table);
+    EXPECT_EQ(viewSet.size(), 1u);
+    PointViewPtr view = *viewSet.begin();
+    EXPECT_EQ(view->size(), 1000u);
+
+    for (point_count_t i = 0; i < view->size(); ++i)
+    {
+        double x = view->getFieldAs<double>(Dimension::Id::X, i);
+        double y = view->getFieldAs<double>(Dimension::Id::Y, i);
+        double z = view->getFieldAs<double>(Dimension::Id::Z, i);
+
+        EXPECT_GE(x, 1.0);
+        EXPECT_LE(x, 101.0);
+        // The swath overlaps the line spacing, so Y can push a bit past
+        // the bounds on the edge lines.
+        EXPECT_GE(y, 2.0 - 100.0);
+        EXPECT_LE(y, 102.0 + 100.0);
+        EXPECT_GE(z, 3.0);
+        EXPECT_LE(z, 103.0);
+    }
+}
@@ -96,6 +96,34 @@ TEST(GDALReaderTest, simple)
     verify(715154, 734.5, 972.5, 0, 0, 0);
 }
 
+TEST(GDALReaderTest, bounds)
+{
+    Options ro;
+    ro.add("filename", Support::datapath("png/autzen-height.png"));
+    ro.add("bounds", "([100, 110], [200, 220])");
+
+    GDALReader gr;
+    gr.setOptions(ro);
+
+    PointTable t;
+    gr.prepare(t);
+    PointViewSet s = gr.execute(t);
+    PointViewPtr v = *s.begin();
+
+    // Cell centers fall at N + .5, so 10 columns and 20 rows are inside.
+    EXPECT_EQ(v->size(), (size_t)(10 * 20));
+    for (PointId i = 0; i < v->size(); ++i)
+    {
+        double x = v->getFieldAs<double>(Dimension::Id::X, i);
+        double y = v->getFieldAs<double>(Dimension::Id::Y, i);
+        EXPECT_GE(x, 100);
+        EXPECT_LE(x, 110);
+        EXPECT_GE(y, 200);
+        EXPECT_LE(y, 220);
+    }
+}
+
+
 struct Point
 {
     double m_x;
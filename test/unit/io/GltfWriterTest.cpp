@@ -46,7 +46,8 @@ namespace pdal
 {
 
 
-void testWrite(bool writeNormals, bool writeColors, std::string path)
+void testWrite(bool writeNormals, bool writeColors, std::string path,
+    bool quantize = false)
 {
     PointTable t;
 
@@ -137,6 +138,9 @@ void testWrite(bool writeNormals, bool writeColors, std::string path)
     if (writeColors) {
         writerOptions.add("color_vertices", true);
     }
+    if (quantize) {
+        writerOptions.add("quantize", true);
+    }
     writer->setOptions(writerOptions);
     writer->setInput(r);
     writer->prepare(t);
@@ -152,6 +156,15 @@ TEST(GltfWriter, Write)
 }
 
 
+TEST(GltfWriter, WriteQuantized)
+{
+    std::string path = Support::temppath("out_quantized.glb");
+    testWrite(false, false, path, true);
+    // Four vertices at 8 bytes each rather than 12.
+    ASSERT_EQ(FileUtils::fileSize(path), 5084);
+}
+
+
 /**
 TEST(GltfWriter, WriteWithNormals)
 {
@@ -624,11 +624,43 @@ TEST(LasReaderTest, Start)
         EXPECT_EQ(v->getFieldAs<int>(Dimension::Id::Y, 0), 2625);
         EXPECT_EQ(v->getFieldAs<int>(Dimension::Id::Z, 0), 3025);
     };
+    // A threaded read starting mid-chunk: the sequential prologue decodes
+    // to the chunk boundary, and the remaining points are fewer than a
+    // chunk, so they all decode through the sequential tail.
+    auto test3 = [source, &f]()
+    {
+        Stage *las = f.createStage("readers.las");
+        Options opts;
+        opts.add("filename", source);
+        opts.add("start", 45000);
+        opts.add("compression", "lazperf");
+        opts.add("threads", 2);
+        las->setOptions(opts);
+
+        PointTable t;
+        las->prepare(t);
+        PointViewSet s = las->execute(t);
+        PointViewPtr v = *s.begin();
+        EXPECT_EQ(v->size(), (point_count_t)25000);
+        // Check points before and after the 50,000-point chunk boundary.
+        for (PointId i : { (PointId)0, (PointId)4999, (PointId)5000,
+            (PointId)5001, (PointId)24999 })
+        {
+            EXPECT_EQ(v->getFieldAs<int>(Dimension::Id::X, i),
+                45000 + (int)i);
+            EXPECT_EQ(v->getFieldAs<int>(Dimension::Id::Y, i),
+                45100 + (int)i);
+            EXPECT_EQ(v->getFieldAs<int>(Dimension::Id::Z, i),
+                45500 + (int)i);
+        }
+    };
+
     test1("laszip");
     test2("laszip");
 #ifdef PDAL_HAVE_LAZPERF
     test1("lazperf");
     test2("lazperf");
+    test3();
 #endif
 
     // Delete the created file.
@@ -159,6 +159,24 @@ TEST(PcdReaderTest, compateTabSeparated)
                   Support::datapath("las/utm17.las"));
 }
 
+TEST(PcdReaderTest, compareBinary)
+{
+    comparePcdLas(Support::datapath("pcd/utm17_binary.pcd"),
+                  Support::datapath("las/utm17.las"));
+}
+
+TEST(PcdReaderTest, compareBinaryCompressed)
+{
+    comparePcdLas(Support::datapath("pcd/utm17_compressed.pcd"),
+                  Support::datapath("las/utm17.las"));
+}
+
+TEST(PcdReaderTest, compareBinaryStreaming)
+{
+    comparePcdLasStreaming(Support::datapath("pcd/utm17_binary.pcd"),
+                           Support::datapath("las/utm17.las"));
+}
+
 TEST(PcdReaderTest, throwCommaSeparated)
 {
     PcdReader t;
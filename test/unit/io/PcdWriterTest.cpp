@@ -333,3 +333,57 @@ TEST(PcdWriterTest, binaryPdalTypes)
     EXPECT_NEAR(3.33, v->getFieldAs<float>(Dimension::Id::Z, 2), 0.0001);
     EXPECT_EQ(3, v->getFieldAs<int>(Dimension::Id::Intensity, 2));
 }
+
+TEST(PcdWriterTest, compressedPdalTypes)
+{
+    using namespace Dimension;
+
+    PointTable table;
+    table.layout()->registerDims({Id::X, Id::Y, Id::Z, Id::Intensity});
+
+    PointViewPtr view(new PointView(table));
+    for (PointId i = 0; i < 100; ++i)
+    {
+        view->setField(Id::X, i, i * 1.25);
+        view->setField(Id::Y, i, i * 2.5);
+        view->setField(Id::Z, i, i * 3.75);
+        view->setField(Id::Intensity, i, i % 16);
+    }
+
+    BufferReader r;
+    r.addView(view);
+
+    std::string outfile(Support::temppath("compressed-test.pcd"));
+
+    PcdWriter w;
+
+    Options o;
+    o.add("order", "X=Float,Y=Float,Z=Float,Intensity=Unsigned32");
+    o.add("compression", "compressed");
+    o.add("filename", outfile);
+
+    w.setInput(r);
+    w.setOptions(o);
+
+    w.prepare(table);
+    w.execute(table);
+
+    PcdReader pr;
+    Options po;
+    po.add("filename", outfile);
+    pr.setOptions(po);
+    PointTable t;
+    pr.prepare(t);
+    PointViewSet pvs = pr.execute(t);
+
+    PointViewPtr v = *pvs.begin();
+    EXPECT_EQ(100U, v->size());
+
+    for (PointId i = 0; i < v->size(); ++i)
+    {
+        EXPECT_NEAR(i * 1.25, v->getFieldAs<float>(Id::X, i), 0.0001);
+        EXPECT_NEAR(i * 2.5, v->getFieldAs<float>(Id::Y, i), 0.0001);
+        EXPECT_NEAR(i * 3.75, v->getFieldAs<float>(Id::Z, i), 0.0001);
+        EXPECT_EQ((int)(i % 16), v->getFieldAs<int>(Id::Intensity, i));
+    }
+}
@@ -35,6 +35,7 @@
 #include <pdal/Filter.hpp>
 #include <pdal/pdal_test_main.hpp>
 
+#include <pdal/util/Algorithm.hpp>
 #include <io/PlyReader.hpp>
 #include "Support.hpp"
 
@@ -61,6 +62,23 @@ TEST(PlyReader, Constructor)
 }
 
 
+TEST(PlyReader, Inspect)
+{
+    PlyReader reader;
+    Options options;
+    options.add("filename", Support::datapath("ply/simple_text.ply"));
+    reader.setOptions(options);
+
+    QuickInfo qi = reader.preview();
+
+    EXPECT_TRUE(qi.valid());
+    EXPECT_EQ(qi.m_pointCount, 3u);
+    EXPECT_TRUE(Utils::contains(qi.m_dimNames, "x"));
+    EXPECT_TRUE(Utils::contains(qi.m_dimNames, "y"));
+    EXPECT_TRUE(Utils::contains(qi.m_dimNames, "z"));
+}
+
+
 TEST(PlyReader, ReadText)
 {
     PlyReader reader;
@@ -115,6 +115,41 @@ TEST(SbetReaderTest, testRead)
                4.113280);
 }
 
+TEST(SbetReaderTest, testTimeWindow)
+{
+    auto countPoints = [](Options options)
+    {
+        options.add("filename", Support::datapath("sbet/2-points.sbet"));
+
+        SbetReader reader;
+        reader.setOptions(options);
+
+        PointTable table;
+        reader.prepare(table);
+        PointViewSet viewSet = reader.execute(table);
+        EXPECT_EQ(viewSet.size(), 1u);
+        return (*viewSet.begin())->size();
+    };
+
+    // The two records have times of roughly 151631.003 and 151631.008.
+    Options startOpts;
+    startOpts.add("start_time", 151631.005);
+    EXPECT_EQ(countPoints(startOpts), 1u);
+
+    Options endOpts;
+    endOpts.add("end_time", 151631.005);
+    EXPECT_EQ(countPoints(endOpts), 1u);
+
+    Options bothOpts;
+    bothOpts.add("start_time", 151631.0);
+    bothOpts.add("end_time", 151632.0);
+    EXPECT_EQ(countPoints(bothOpts), 2u);
+
+    Options emptyOpts;
+    emptyOpts.add("start_time", 151632.0);
+    EXPECT_EQ(countPoints(emptyOpts), 0u);
+}
+
 TEST(SbetReaderTest, testBadFile)
 {
     Options options;